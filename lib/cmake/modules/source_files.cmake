@@ -23,14 +23,53 @@ list(APPEND EYA_TARGET_SOURCE_FILES
         ${EYA_LIB_SOURCE_DIR}/eya/array.c
         ${EYA_LIB_SOURCE_DIR}/eya/memory.c
         ${EYA_LIB_SOURCE_DIR}/eya/memory_std.c
+        ${EYA_LIB_SOURCE_DIR}/eya/memory_crc32c.c
         ${EYA_LIB_SOURCE_DIR}/eya/memory_raw.c
         ${EYA_LIB_SOURCE_DIR}/eya/memory_range.c
         ${EYA_LIB_SOURCE_DIR}/eya/memory_typed.c
+        ${EYA_LIB_SOURCE_DIR}/eya/memory_strided.c
+        ${EYA_LIB_SOURCE_DIR}/eya/memory_grid.c
         ${EYA_LIB_SOURCE_DIR}/eya/allocated_array.c
         ${EYA_LIB_SOURCE_DIR}/eya/allocated_range.c
+        ${EYA_LIB_SOURCE_DIR}/eya/shared_range.c
         ${EYA_LIB_SOURCE_DIR}/eya/memory_allocator.c
+        ${EYA_LIB_SOURCE_DIR}/eya/memory_parallel.c
+
+        # Thread
+        ${EYA_LIB_SOURCE_DIR}/eya/thread.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_barrier.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_cond.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_event.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_futex.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_latch.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_lock.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_mutex.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_pool.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_rwlock.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_seqlock.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_spinlock.c
+        ${EYA_LIB_SOURCE_DIR}/eya/thread_topology.c
+        ${EYA_LIB_SOURCE_DIR}/eya/spsc_queue.c
+        ${EYA_LIB_SOURCE_DIR}/eya/mpmc_queue.c
+        ${EYA_LIB_SOURCE_DIR}/eya/ebr.c
+        ${EYA_LIB_SOURCE_DIR}/eya/hash_map.c
+        ${EYA_LIB_SOURCE_DIR}/eya/counter.c
+        ${EYA_LIB_SOURCE_DIR}/eya/task_graph.c
+
+        # IO
+        ${EYA_LIB_SOURCE_DIR}/eya/io_async.c
+        ${EYA_LIB_SOURCE_DIR}/eya/io_copy.c
+        ${EYA_LIB_SOURCE_DIR}/eya/io_direct.c
 
         # Other
+        ${EYA_LIB_SOURCE_DIR}/eya/base64.c
+        ${EYA_LIB_SOURCE_DIR}/eya/bit_range.c
+        ${EYA_LIB_SOURCE_DIR}/eya/cpu.c
+        ${EYA_LIB_SOURCE_DIR}/eya/decimal.c
+        ${EYA_LIB_SOURCE_DIR}/eya/divider.c
         ${EYA_LIB_SOURCE_DIR}/eya/eya.c
+        ${EYA_LIB_SOURCE_DIR}/eya/hash.c
+        ${EYA_LIB_SOURCE_DIR}/eya/hex.c
+        ${EYA_LIB_SOURCE_DIR}/eya/utf8.c
         ${EYA_LIB_SOURCE_DIR}/eya/version.c
         )
\ No newline at end of file
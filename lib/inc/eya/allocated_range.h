@@ -151,6 +151,54 @@ EYA_ATTRIBUTE(SYMBOL)
 void
 eya_allocated_range_resize(eya_allocated_range_t *self, eya_usize_t size);
 
+/**
+ * @brief Allocates a memory range whose begin address has the given alignment.
+ *
+ * This function allocates a block with the runtime allocator and
+ * returns a range covering exactly `size` bytes starting at an address
+ * that is a multiple of `align`. Such ranges satisfy
+ * eya_memory_range_is_aligned() and are suitable for direct I/O and SIMD access.
+ *
+ * @warning The range must be released with eya_allocated_range_clear_aligned(),
+ *          not with eya_allocated_range_clear() or eya_allocated_range_resize().
+ *
+ * @param[in] size Size of the range in bytes (must be non-zero).
+ * @param[in] align Alignment of the begin address (must be a power of two).
+ * @return New aligned range owning its memory.
+ *
+ * @throws EYA_RUNTIME_ERROR_ZERO_MEMORY_ALLOCATE
+ *         If size is zero
+ * @throws EYA_RUNTIME_ERROR_NOT_POWER_OF_TWO
+ *         If align is not a power of two
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If size plus the alignment padding does not fit in eya_usize_t
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If memory allocation fails
+ *
+ * @see eya_memory_allocator_alloc_aligned()
+ * @see eya_allocated_range_clear_aligned()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_allocated_range_t
+eya_allocated_range_make_aligned(eya_usize_t size, eya_usize_t align);
+
+/**
+ * @brief Clears and deallocates the memory of an aligned allocated range.
+ *
+ * @param[in,out] self Pointer to a range created by eya_allocated_range_make_aligned().
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the memory range is invalid
+ *
+ * @see eya_memory_allocator_free_aligned()
+ * @see eya_allocated_range_make_aligned()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_allocated_range_clear_aligned(eya_allocated_range_t *self);
+
 EYA_COMPILER(EXTERN_C_END)
 
 #endif // EYA_ALLOCATED_RANGE_H
\ No newline at end of file
@@ -0,0 +1,271 @@
+/**
+ * @file atomic.h
+ * @brief Atomic operations on size-wide integers, 32-bit words and pointers
+ *
+ * This header maps a small set of atomic operations to the backend
+ * selected in `atomic_type.h`:
+ * - GCC/Clang: `__atomic` built-ins with explicit memory orders
+ * - MSVC: `Interlocked` intrinsics and `__iso_volatile` accesses with barriers
+ * - C11: `<stdatomic.h>` explicit operations on `_Atomic` objects
+ *
+ * The memory order arguments follow the C11 model (see `atomic_order.h`).
+ * On MSVC every read-modify-write operation is a full barrier,
+ * so stronger ordering than requested may be provided.
+ *
+ * It also brings in the fences, the spin-wait hint and the cache line size.
+ *
+ * @warning Compilers without a backend stop the build with an error.
+ */
+
+#ifndef EYA_ATOMIC_H
+#define EYA_ATOMIC_H
+
+#include "atomic_cache_line.h"
+#include "numeric_types.h"
+#include "atomic_order.h"
+#include "atomic_fence.h"
+#include "atomic_pause.h"
+#include "size.h"
+
+#if (EYA_ATOMIC_TYPE == EYA_ATOMIC_C11)
+/**
+ * @def EYA_ATOMIC_QUALIFIER
+ * @brief Qualifier of the objects accessed through the atomic operations
+ */
+#    define EYA_ATOMIC_QUALIFIER _Atomic
+#else
+#    define EYA_ATOMIC_QUALIFIER volatile
+#endif
+
+/**
+ * @typedef eya_atomic_usize_t
+ * @brief Unsigned size-wide integer accessed only through the macros below
+ */
+typedef EYA_ATOMIC_QUALIFIER eya_usize_t eya_atomic_usize_t;
+
+/**
+ * @typedef eya_atomic_ssize_t
+ * @brief Signed size-wide integer accessed only through the macros below
+ */
+typedef EYA_ATOMIC_QUALIFIER eya_ssize_t eya_atomic_ssize_t;
+
+/**
+ * @typedef eya_atomic_uint_t
+ * @brief 32-bit word accessed only through the macros below, suitable for futex waits
+ */
+typedef EYA_ATOMIC_QUALIFIER eya_uint_t eya_atomic_uint_t;
+
+/**
+ * @typedef eya_atomic_ptr_t
+ * @brief Pointer accessed only through the macros below
+ */
+typedef void *EYA_ATOMIC_QUALIFIER eya_atomic_ptr_t;
+
+#if (EYA_ATOMIC_TYPE == EYA_ATOMIC_GCC)
+/**
+ * @def eya_atomic_load(ptr, order)
+ * @brief Atomically reads the value
+ */
+#    define eya_atomic_load(ptr, order) __atomic_load_n(ptr, order)
+
+/**
+ * @def eya_atomic_store(ptr, value, order)
+ * @brief Atomically writes the value
+ */
+#    define eya_atomic_store(ptr, value, order) __atomic_store_n(ptr, value, order)
+
+/**
+ * @def eya_atomic_fetch_add(ptr, value, order)
+ * @brief Atomically adds the value and returns the previous one
+ */
+#    define eya_atomic_fetch_add(ptr, value, order) __atomic_fetch_add(ptr, value, order)
+
+/**
+ * @def eya_atomic_fetch_sub(ptr, value, order)
+ * @brief Atomically subtracts the value and returns the previous one
+ */
+#    define eya_atomic_fetch_sub(ptr, value, order) __atomic_fetch_sub(ptr, value, order)
+
+/**
+ * @def eya_atomic_fetch_or(ptr, value, order)
+ * @brief Atomically sets the bits of the value and returns the previous one
+ */
+#    define eya_atomic_fetch_or(ptr, value, order) __atomic_fetch_or(ptr, value, order)
+
+/**
+ * @def eya_atomic_fetch_and(ptr, value, order)
+ * @brief Atomically keeps only the bits of the value and returns the previous one
+ */
+#    define eya_atomic_fetch_and(ptr, value, order) __atomic_fetch_and(ptr, value, order)
+
+/**
+ * @def eya_atomic_exchange(ptr, value, order)
+ * @brief Atomically replaces the value and returns the previous one
+ */
+#    define eya_atomic_exchange(ptr, value, order) __atomic_exchange_n(ptr, value, order)
+
+/**
+ * @def eya_atomic_compare_exchange(ptr, expected, desired, success, failure)
+ * @brief Replaces the value with `desired` if it equals `*expected`
+ *
+ * On failure the current value is stored into `*expected`.
+ * Evaluates to true if the value was replaced.
+ */
+#    define eya_atomic_compare_exchange(ptr, expected, desired, success, failure)                  \
+        __atomic_compare_exchange_n(ptr, expected, desired, 0, success, failure)
+
+/**
+ * @def eya_atomic_compare_exchange_weak(ptr, expected, desired, success, failure)
+ * @brief Same as `eya_atomic_compare_exchange`, but may fail spuriously
+ *
+ * Cheaper on LL/SC architectures when the operation is retried in a loop anyway.
+ */
+#    define eya_atomic_compare_exchange_weak(ptr, expected, desired, success, failure)             \
+        __atomic_compare_exchange_n(ptr, expected, desired, 1, success, failure)
+
+#elif (EYA_ATOMIC_TYPE == EYA_ATOMIC_C11)
+#    define eya_atomic_load(ptr, order) atomic_load_explicit(ptr, order)
+#    define eya_atomic_store(ptr, value, order) atomic_store_explicit(ptr, value, order)
+#    define eya_atomic_fetch_add(ptr, value, order) atomic_fetch_add_explicit(ptr, value, order)
+#    define eya_atomic_fetch_sub(ptr, value, order) atomic_fetch_sub_explicit(ptr, value, order)
+#    define eya_atomic_fetch_or(ptr, value, order) atomic_fetch_or_explicit(ptr, value, order)
+#    define eya_atomic_fetch_and(ptr, value, order) atomic_fetch_and_explicit(ptr, value, order)
+#    define eya_atomic_exchange(ptr, value, order) atomic_exchange_explicit(ptr, value, order)
+
+#    define eya_atomic_compare_exchange(ptr, expected, desired, success, failure)                  \
+        atomic_compare_exchange_strong_explicit(ptr, expected, desired, success, failure)
+
+#    define eya_atomic_compare_exchange_weak(ptr, expected, desired, success, failure)             \
+        atomic_compare_exchange_weak_explicit(ptr, expected, desired, success, failure)
+
+#elif (EYA_ATOMIC_TYPE == EYA_ATOMIC_MSVC)
+#    include <intrin.h>
+
+/*
+ * Loads and stores use the `__iso_volatile` intrinsics, which add no ordering
+ * whatever the `/volatile` mode, with the barrier the order needs around them:
+ * a compiler barrier on x86, which already orders them, and `dmb ish` on ARM.
+ * Sequentially consistent stores are exchanges, so later loads wait for them.
+ */
+#    if defined(_M_ARM64) || defined(_M_ARM)
+#        define eya_atomic_msvc_barrier(order)                                                     \
+            ((order) == EYA_ATOMIC_RELAXED ? (void)0 : __dmb(_ARM64_BARRIER_ISH))
+#    else
+#        define eya_atomic_msvc_barrier(order) _ReadWriteBarrier()
+#    endif
+
+/**
+ * @brief Reads a 32-bit or 64-bit location
+ */
+static __inline eya_ullong_t
+eya_atomic_msvc_load(const volatile void *ptr, eya_usize_t size, int order)
+{
+    eya_ullong_t value;
+
+    if (size == 4)
+        value = (unsigned long)__iso_volatile_load32((const volatile __int32 *)ptr);
+    else
+        value = (eya_ullong_t)__iso_volatile_load64((const volatile __int64 *)ptr);
+
+    eya_atomic_msvc_barrier(order);
+    return value;
+}
+
+/**
+ * @brief Writes a 32-bit or 64-bit location
+ */
+static __inline void
+eya_atomic_msvc_store(volatile void *ptr, eya_ullong_t value, eya_usize_t size, int order)
+{
+    if (order == EYA_ATOMIC_SEQ_CST)
+    {
+        if (size == 4)
+            _InterlockedExchange((volatile long *)ptr, (long)value);
+        else
+            _InterlockedExchange64((volatile __int64 *)ptr, (__int64)value);
+        return;
+    }
+
+    eya_atomic_msvc_barrier(order);
+
+    if (size == 4)
+        __iso_volatile_store32((volatile __int32 *)ptr, (__int32)value);
+    else
+        __iso_volatile_store64((volatile __int64 *)ptr, (__int64)value);
+}
+
+/*
+ * Converts a loaded value back to the type of the object,
+ * which matters for pointers.
+ */
+#    ifdef __cplusplus
+#        define eya_atomic_msvc_cast(ptr, value) ((decltype(+*(ptr)))(eya_usize_t)(value))
+#    else
+#        define eya_atomic_msvc_cast(ptr, value)                                                   \
+            _Generic(*(ptr), void *: (void *)(eya_usize_t)(value), default: (value))
+#    endif
+
+#    define eya_atomic_load(ptr, order)                                                            \
+        eya_atomic_msvc_cast(ptr, eya_atomic_msvc_load(ptr, sizeof(*(ptr)), order))
+
+#    define eya_atomic_store(ptr, value, order)                                                    \
+        eya_atomic_msvc_store(ptr, (eya_ullong_t)(eya_usize_t)(value), sizeof(*(ptr)), order)
+
+/*
+ * Read-modify-write operations dispatch on the object size,
+ * so they serve both size-wide and 32-bit words.
+ */
+#    define eya_atomic_msvc_rmw(op, ptr, value)                                                    \
+        (sizeof(*(ptr)) == 4                                                                       \
+             ? (eya_usize_t)(unsigned long)op((volatile long *)(ptr), (long)(value))               \
+             : (eya_usize_t)op##64((volatile __int64 *)(ptr), (__int64)(value)))
+
+#    define eya_atomic_fetch_add(ptr, value, order)                                                \
+        eya_atomic_msvc_rmw(_InterlockedExchangeAdd, ptr, value)
+
+#    define eya_atomic_fetch_sub(ptr, value, order)                                                \
+        eya_atomic_msvc_rmw(_InterlockedExchangeAdd, ptr, (eya_usize_t)0 - (eya_usize_t)(value))
+
+#    define eya_atomic_fetch_or(ptr, value, order) eya_atomic_msvc_rmw(_InterlockedOr, ptr, value)
+#    define eya_atomic_fetch_and(ptr, value, order) eya_atomic_msvc_rmw(_InterlockedAnd, ptr, value)
+
+#    define eya_atomic_exchange(ptr, value, order)                                                 \
+        eya_atomic_msvc_rmw(_InterlockedExchange, ptr, value)
+
+/**
+ * @brief Strong compare-and-exchange on a 32-bit or 64-bit location
+ */
+static __inline int
+eya_atomic_msvc_compare_exchange(volatile void *ptr,
+                                 void          *expected,
+                                 eya_ullong_t   desired,
+                                 eya_usize_t    size)
+{
+    if (size == 4)
+    {
+        const long old = *(long *)expected;
+        const long cur = _InterlockedCompareExchange((volatile long *)ptr, (long)desired, old);
+
+        *(long *)expected = cur;
+        return cur == old;
+    }
+
+    const __int64 old = *(__int64 *)expected;
+    const __int64 cur =
+        _InterlockedCompareExchange64((volatile __int64 *)ptr, (__int64)desired, old);
+
+    *(__int64 *)expected = cur;
+    return cur == old;
+}
+
+#    define eya_atomic_compare_exchange(ptr, expected, desired, success, failure)                  \
+        eya_atomic_msvc_compare_exchange(ptr, expected, (eya_ullong_t)(desired), sizeof(*(ptr)))
+
+#    define eya_atomic_compare_exchange_weak(ptr, expected, desired, success, failure)             \
+        eya_atomic_compare_exchange(ptr, expected, desired, success, failure)
+
+#else
+#    error "Atomic operations are not supported by this compiler"
+#endif
+
+#endif // EYA_ATOMIC_H
\ No newline at end of file
@@ -0,0 +1,35 @@
+/**
+ * @file atomic_cache_line.h
+ * @brief Assumed size of a cache line
+ *
+ * Fields written by different threads are kept at least this far apart,
+ * so a write by one thread does not invalidate the line the other works on
+ * (false sharing).
+ *
+ * Apple silicon and 64-bit POWER use 128-byte lines, x86 and most ARM cores
+ * use 64-byte lines.
+ *
+ * @note `EYA_ATOMIC_CACHE_LINE_SIZE` can be defined before inclusion
+ *       to match a specific target.
+ */
+
+#ifndef EYA_ATOMIC_CACHE_LINE_H
+#define EYA_ATOMIC_CACHE_LINE_H
+
+#ifndef EYA_ATOMIC_CACHE_LINE_SIZE
+#    if (defined(__APPLE__) && defined(__aarch64__)) || defined(__powerpc64__)
+/**
+ * @def EYA_ATOMIC_CACHE_LINE_SIZE
+ * @brief Cache line size of Apple silicon and 64-bit POWER
+ */
+#        define EYA_ATOMIC_CACHE_LINE_SIZE 128
+#    else
+/**
+ * @def EYA_ATOMIC_CACHE_LINE_SIZE
+ * @brief Cache line size of x86 and most ARM cores
+ */
+#        define EYA_ATOMIC_CACHE_LINE_SIZE 64
+#    endif
+#endif // EYA_ATOMIC_CACHE_LINE_SIZE
+
+#endif // EYA_ATOMIC_CACHE_LINE_H
\ No newline at end of file
@@ -0,0 +1,47 @@
+/**
+ * @file atomic_fence.h
+ * @brief Memory fences that are not attached to an atomic variable
+ *
+ * - `eya_atomic_thread_fence` orders accesses against other threads
+ * - `eya_atomic_signal_fence` only stops the compiler from reordering,
+ *   which is enough against a signal handler running on the same thread
+ */
+
+#ifndef EYA_ATOMIC_FENCE_H
+#define EYA_ATOMIC_FENCE_H
+
+#include "atomic_order.h"
+
+#if (EYA_ATOMIC_TYPE == EYA_ATOMIC_GCC)
+/**
+ * @def eya_atomic_thread_fence(order)
+ * @brief Orders memory accesses around the fence without an associated variable
+ */
+#    define eya_atomic_thread_fence(order) __atomic_thread_fence(order)
+
+/**
+ * @def eya_atomic_signal_fence(order)
+ * @brief Orders memory accesses around the fence for the compiler only
+ */
+#    define eya_atomic_signal_fence(order) __atomic_signal_fence(order)
+#elif (EYA_ATOMIC_TYPE == EYA_ATOMIC_C11)
+#    define eya_atomic_thread_fence(order) atomic_thread_fence(order)
+#    define eya_atomic_signal_fence(order) atomic_signal_fence(order)
+#elif (EYA_ATOMIC_TYPE == EYA_ATOMIC_MSVC)
+#    include <intrin.h>
+
+/*
+ * Only a sequentially consistent fence needs a hardware barrier on x86:
+ * the other orders are provided by the processor for plain accesses.
+ */
+#    if defined(_M_ARM64) || defined(_M_ARM)
+#        define eya_atomic_thread_fence(order)                                                     \
+            ((order) == EYA_ATOMIC_RELAXED ? _ReadWriteBarrier() : __dmb(_ARM64_BARRIER_ISH))
+#    else
+#        define eya_atomic_thread_fence(order)                                                     \
+            ((order) == EYA_ATOMIC_SEQ_CST ? _mm_mfence() : _ReadWriteBarrier())
+#    endif
+#    define eya_atomic_signal_fence(order) _ReadWriteBarrier()
+#endif
+
+#endif // EYA_ATOMIC_FENCE_H
\ No newline at end of file
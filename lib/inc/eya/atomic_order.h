@@ -0,0 +1,48 @@
+/**
+ * @file atomic_order.h
+ * @brief Memory orders accepted by the atomic operations
+ *
+ * The orders follow the C11 memory model. Each backend maps them
+ * to its native constants; the MSVC backend only tells a full barrier
+ * apart from a compiler barrier, so it may order more than requested.
+ */
+
+#ifndef EYA_ATOMIC_ORDER_H
+#define EYA_ATOMIC_ORDER_H
+
+#include "atomic_type.h"
+
+#if (EYA_ATOMIC_TYPE == EYA_ATOMIC_C11)
+#    include <stdatomic.h>
+#endif
+
+#if (EYA_ATOMIC_TYPE == EYA_ATOMIC_GCC)
+/** @brief No ordering constraints, only atomicity */
+#    define EYA_ATOMIC_RELAXED __ATOMIC_RELAXED
+
+/** @brief Later accesses can not move before the operation */
+#    define EYA_ATOMIC_ACQUIRE __ATOMIC_ACQUIRE
+
+/** @brief Earlier accesses can not move after the operation */
+#    define EYA_ATOMIC_RELEASE __ATOMIC_RELEASE
+
+/** @brief Both acquire and release ordering */
+#    define EYA_ATOMIC_ACQ_REL __ATOMIC_ACQ_REL
+
+/** @brief Single total order of all sequentially consistent operations */
+#    define EYA_ATOMIC_SEQ_CST __ATOMIC_SEQ_CST
+#elif (EYA_ATOMIC_TYPE == EYA_ATOMIC_C11)
+#    define EYA_ATOMIC_RELAXED memory_order_relaxed
+#    define EYA_ATOMIC_ACQUIRE memory_order_acquire
+#    define EYA_ATOMIC_RELEASE memory_order_release
+#    define EYA_ATOMIC_ACQ_REL memory_order_acq_rel
+#    define EYA_ATOMIC_SEQ_CST memory_order_seq_cst
+#elif (EYA_ATOMIC_TYPE == EYA_ATOMIC_MSVC)
+#    define EYA_ATOMIC_RELAXED 0
+#    define EYA_ATOMIC_ACQUIRE 2
+#    define EYA_ATOMIC_RELEASE 3
+#    define EYA_ATOMIC_ACQ_REL 4
+#    define EYA_ATOMIC_SEQ_CST 5
+#endif
+
+#endif // EYA_ATOMIC_ORDER_H
\ No newline at end of file
@@ -0,0 +1,50 @@
+/**
+ * @file atomic_pause.h
+ * @brief Processor hint for the body of a spin-wait loop
+ *
+ * `eya_atomic_pause()` tells the processor that the thread is spinning:
+ * - x86: `pause` lowers the power draw and avoids the memory order
+ *   violation that otherwise flushes the pipeline when the loop exits
+ * - ARM: `yield` lets a sibling hardware thread run
+ *
+ * On other targets it is a compiler barrier only, so the loop
+ * still reloads the variables it waits for.
+ */
+
+#ifndef EYA_ATOMIC_PAUSE_H
+#define EYA_ATOMIC_PAUSE_H
+
+#include "compiler_type.h"
+
+#if (EYA_COMPILER_GCC_LIKE)
+#    if defined(__x86_64__) || defined(__i386__)
+/**
+ * @def eya_atomic_pause()
+ * @brief Executes the `pause` instruction
+ */
+#        define eya_atomic_pause() __builtin_ia32_pause()
+#    elif defined(__aarch64__) || defined(__arm__)
+/**
+ * @def eya_atomic_pause()
+ * @brief Executes the `yield` instruction
+ */
+#        define eya_atomic_pause() __asm__ __volatile__("yield" ::: "memory")
+#    else
+/**
+ * @def eya_atomic_pause()
+ * @brief Compiler barrier on targets without a spin hint
+ */
+#        define eya_atomic_pause() __asm__ __volatile__("" ::: "memory")
+#    endif
+#elif (EYA_COMPILER_TYPE == EYA_COMPILER_MSVC)
+#    include <intrin.h>
+#    if defined(_M_ARM64) || defined(_M_ARM)
+#        define eya_atomic_pause() __yield()
+#    else
+#        define eya_atomic_pause() _mm_pause()
+#    endif
+#else
+#    define eya_atomic_pause() ((void)0)
+#endif
+
+#endif // EYA_ATOMIC_PAUSE_H
\ No newline at end of file
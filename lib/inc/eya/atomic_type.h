@@ -0,0 +1,85 @@
+/**
+ * @file atomic_type.h
+ * @brief Selection of the backend that implements atomic operations
+ *
+ * The backend is chosen in the following order:
+ * 1. GCC/Clang `__atomic` built-ins (`EYA_ATOMIC_GCC`)
+ * 2. MSVC `Interlocked` intrinsics (`EYA_ATOMIC_MSVC`)
+ * 3. C11 `<stdatomic.h>` (`EYA_ATOMIC_C11`) for other C11 compilers
+ *
+ * The built-ins are preferred over `<stdatomic.h>`, because they operate
+ * on plain integers, so the same structures can be shared with C++ code.
+ * The C11 backend qualifies the atomic types with `_Atomic`
+ * and is therefore only available to C translation units.
+ *
+ * @note `EYA_ATOMIC_TYPE` can be defined before inclusion to force a backend.
+ */
+
+#ifndef EYA_ATOMIC_TYPE_H
+#define EYA_ATOMIC_TYPE_H
+
+#include "compiler_std_version.h"
+#include "compiler_type.h"
+
+/**
+ * @def EYA_ATOMIC_UNKNOWN
+ * @brief Identifier for a missing atomic backend
+ */
+#ifndef EYA_ATOMIC_UNKNOWN
+#    define EYA_ATOMIC_UNKNOWN 0
+#endif // EYA_ATOMIC_UNKNOWN
+
+/**
+ * @def EYA_ATOMIC_GCC
+ * @brief Identifier for the GCC/Clang `__atomic` built-ins
+ */
+#ifndef EYA_ATOMIC_GCC
+#    define EYA_ATOMIC_GCC 1
+#endif // EYA_ATOMIC_GCC
+
+/**
+ * @def EYA_ATOMIC_MSVC
+ * @brief Identifier for the MSVC `Interlocked` intrinsics
+ */
+#ifndef EYA_ATOMIC_MSVC
+#    define EYA_ATOMIC_MSVC 2
+#endif // EYA_ATOMIC_MSVC
+
+/**
+ * @def EYA_ATOMIC_C11
+ * @brief Identifier for the C11 `<stdatomic.h>` operations
+ */
+#ifndef EYA_ATOMIC_C11
+#    define EYA_ATOMIC_C11 3
+#endif // EYA_ATOMIC_C11
+
+#ifndef EYA_ATOMIC_TYPE
+#    if (EYA_COMPILER_GCC_LIKE)
+/**
+ * @def EYA_ATOMIC_TYPE
+ * @brief Uses the `__atomic` built-ins of GCC and Clang
+ */
+#        define EYA_ATOMIC_TYPE EYA_ATOMIC_GCC
+#    elif (EYA_COMPILER_TYPE == EYA_COMPILER_MSVC)
+/**
+ * @def EYA_ATOMIC_TYPE
+ * @brief Uses the `Interlocked` intrinsics of MSVC
+ */
+#        define EYA_ATOMIC_TYPE EYA_ATOMIC_MSVC
+#    elif !defined(__cplusplus) && defined(__STDC_VERSION__) && !defined(__STDC_NO_ATOMICS__) &&  \
+        (EYA_COMPILER_STD_VERSION_C >= EYA_COMPILER_STD_VERSION_C11)
+/**
+ * @def EYA_ATOMIC_TYPE
+ * @brief Uses the C11 `<stdatomic.h>` operations
+ */
+#        define EYA_ATOMIC_TYPE EYA_ATOMIC_C11
+#    else
+/**
+ * @def EYA_ATOMIC_TYPE
+ * @brief No atomic backend is available
+ */
+#        define EYA_ATOMIC_TYPE EYA_ATOMIC_UNKNOWN
+#    endif
+#endif // EYA_ATOMIC_TYPE
+
+#endif // EYA_ATOMIC_TYPE_H
\ No newline at end of file
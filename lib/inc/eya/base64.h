@@ -0,0 +1,186 @@
+/**
+ * @file base64.h
+ * @brief Base64 encoding and decoding of memory ranges (RFC 4648)
+ *
+ * Three bytes are encoded as four characters of the alphabet given by
+ * @ref eya_base64_alphabet_t. Decoding accepts the text with or without
+ * padding in both alphabets and rejects:
+ * - Characters outside the alphabet, including whitespace
+ * - `=` anywhere but at the end of a multiple of four characters
+ * - A single character left after the last group of four
+ * - Set bits in the unused low bits of the last character,
+ *   so that every byte sequence has exactly one accepted encoding
+ *
+ * The output goes either into a caller-provided range, which must be at
+ * least as large as the size helpers report, or is appended to a byte
+ * array, which grows as needed.
+ *
+ * With AVX2, 24 bytes are encoded or 32 characters decoded per step,
+ * with byte shuffles and multiplications doing the bit packing.
+ * Other CPUs process a group of three bytes at a time.
+ * @ref eya_base64_set_cpu_features() can force the latter, e.g. in tests.
+ *
+ * @code
+ * eya_array_t token = eya_array_make(1, 0);
+ * eya_base64_encode_append(&token, &claims, EYA_BASE64_ALPHABET_URL);
+ * @endcode
+ */
+
+#ifndef EYA_BASE64_H
+#define EYA_BASE64_H
+
+#include "base64_alphabet.h"
+#include "memory_range.h"
+#include "array.h"
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Returns the number of characters encoding a number of bytes
+ * @param[in] size Number of bytes
+ * @param[in] alphabet Alphabet, which decides the padding
+ * @return `4 * ceil(size / 3)` with padding, `ceil(4 * size / 3)` without
+ *
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the alphabet is unknown
+ * @throws EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE
+ *         If the result does not fit in @ref eya_usize_t
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_base64_encode_size(eya_usize_t size, eya_base64_alphabet_t alphabet);
+
+/**
+ * @brief Returns the number of bytes decoded from a text
+ * @param[in] src Encoded text
+ * @return Exact number of bytes, padding taken into account
+ *
+ * Only the length and the padding are checked, not the characters.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If no text of this length and padding is a valid encoding
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_base64_decode_size(const eya_memory_range_t *src);
+
+/**
+ * @brief Encodes a range into a destination range
+ * @param[in] dst Destination, at least @ref eya_base64_encode_size() bytes
+ * @param[in] src Bytes to encode
+ * @param[in] alphabet Alphabet of the output
+ * @return Number of characters written
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If a range is invalid
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the alphabet is unknown
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_base64_encode(const eya_memory_range_t *dst,
+                  const eya_memory_range_t *src,
+                  eya_base64_alphabet_t     alphabet);
+
+/**
+ * @brief Decodes a text into a destination range
+ * @param[in] dst Destination, at least @ref eya_base64_decode_size() bytes
+ * @param[in] src Encoded text
+ * @param[in] alphabet Alphabet of the text
+ * @return Number of bytes written
+ *
+ * The destination may be modified even if the text is invalid.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If a range is invalid
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the alphabet is unknown or the text is not a valid encoding
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_base64_decode(const eya_memory_range_t *dst,
+                  const eya_memory_range_t *src,
+                  eya_base64_alphabet_t     alphabet);
+
+/**
+ * @brief Encodes a range and appends the text to a byte array
+ * @param[in,out] dst Array with an element size of 1
+ * @param[in] src Bytes to encode
+ * @param[in] alphabet Alphabet of the output
+ * @return Number of characters appended
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the source range is invalid
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the alphabet is unknown
+ * @throws EYA_RUNTIME_ERROR_DIFFERENT_ELEMENT_SIZE
+ *         If the elements of the array are not bytes
+ * @throws EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE
+ *         If the array would exceed its maximum size
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the array cannot grow
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_base64_encode_append(eya_array_t              *dst,
+                         const eya_memory_range_t *src,
+                         eya_base64_alphabet_t     alphabet);
+
+/**
+ * @brief Decodes a text and appends the bytes to a byte array
+ * @param[in,out] dst Array with an element size of 1
+ * @param[in] src Encoded text
+ * @param[in] alphabet Alphabet of the text
+ * @return Number of bytes appended
+ *
+ * If the text is invalid, the size of the array is left unchanged.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the source range is invalid
+ * @throws EYA_RUNTIME_ERROR_DIFFERENT_ELEMENT_SIZE
+ *         If the elements of the array are not bytes
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the alphabet is unknown or the text is not a valid encoding
+ * @throws EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE
+ *         If the array would exceed its maximum size
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the array cannot grow
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_base64_decode_append(eya_array_t              *dst,
+                         const eya_memory_range_t *src,
+                         eya_base64_alphabet_t     alphabet);
+
+/**
+ * @brief Selects the implementation allowed by a set of CPU features
+ * @param[in] features Bitwise OR of @ref eya_cpu_feature_t flags,
+ *                     those the CPU does not support are ignored
+ *
+ * The library calls it with every feature when it is loaded.
+ *
+ * @warning Must not run concurrently with the other functions of this header.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_base64_set_cpu_features(eya_uint_t features);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_BASE64_H
\ No newline at end of file
@@ -0,0 +1,34 @@
+/**
+ * @file base64_alphabet.h
+ * @brief Alphabets of the base64 encoding
+ *
+ * @see base64.h
+ */
+
+#ifndef EYA_BASE64_ALPHABET_H
+#define EYA_BASE64_ALPHABET_H
+
+/**
+ * @typedef eya_base64_alphabet_t
+ * @brief Characters of the values 62 and 63, and whether the output is padded
+ *
+ * Both alphabets share `A-Z`, `a-z` and `0-9` for the values 0 to 61.
+ */
+typedef enum eya_base64_alphabet
+{
+    /**
+     * @brief `+` and `/`, padded with `=` to a multiple of four characters
+     *
+     * RFC 4648, section 4, as used by MIME and PEM.
+     */
+    EYA_BASE64_ALPHABET_STANDARD,
+
+    /**
+     * @brief `-` and `_`, without padding
+     *
+     * RFC 4648, section 5, safe in URLs and file names, as used by JWT.
+     */
+    EYA_BASE64_ALPHABET_URL
+} eya_base64_alphabet_t;
+
+#endif // EYA_BASE64_ALPHABET_H
\ No newline at end of file
@@ -0,0 +1,166 @@
+/**
+ * @file bit_range.h
+ * @brief Bulk bit operations over byte buffers
+ *
+ * A buffer of `size` bytes is treated as a bitmap of `8 * size` bits,
+ * bit `i` being bit `i % 8` of byte `i / 8`. The functions complement the
+ * single-word macros of bit_util.h with kernels for bitmap indexes:
+ * - Population count of a buffer
+ * - AND, OR, XOR and AND-NOT of two buffers into a destination,
+ *   returning the population count of the result in the same pass
+ * - Gathering the bits selected by a mask into a dense bit stream and
+ *   scattering a stream back to the selected positions (`pext`/`pdep`)
+ *
+ * The implementation is selected once, when the library is loaded:
+ * - Population counts use `vpopcntq` with AVX-512 VPOPCNTDQ, the
+ *   Harley–Seal carry-save adder network with AVX2, otherwise the same
+ *   network over 64-bit words
+ * - Gather and scatter use the BMI2 instructions, otherwise a loop over
+ *   the set bits of the mask
+ *
+ * @ref eya_bit_range_set_cpu_features() selects them again from fewer features,
+ * so that tests and benchmarks can run every implementation on one CPU.
+ *
+ * @see cpu.h
+ *
+ * @code
+ * // Rows matching both predicates, and how many there are.
+ * eya_usize_t matches = eya_bit_range_and(result, color_red, size_large, bytes);
+ * @endcode
+ */
+
+#ifndef EYA_BIT_RANGE_H
+#define EYA_BIT_RANGE_H
+
+#include "numeric_types.h"
+#include "attribute.h"
+#include "size.h"
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Counts the set bits of a buffer
+ * @param[in] data Pointer to the buffer (may be nullptr if size is 0)
+ * @param[in] size Size of the buffer in bytes
+ * @return Number of set bits
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If data is nullptr and size is not zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_bit_range_popcount(const void *data, eya_usize_t size);
+
+/**
+ * @brief Stores `a & b` into a destination and counts its set bits
+ * @param[out] dst Destination buffer, may be the same as a or b
+ * @param[in] a First operand
+ * @param[in] b Second operand
+ * @param[in] size Size of every buffer in bytes
+ * @return Number of set bits of the result
+ *
+ * The pointers may be nullptr if size is 0.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If a pointer is nullptr and size is not zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_bit_range_and(void *dst, const void *a, const void *b, eya_usize_t size);
+
+/**
+ * @brief Stores `a | b` into a destination and counts its set bits
+ * @copydetails eya_bit_range_and
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_bit_range_or(void *dst, const void *a, const void *b, eya_usize_t size);
+
+/**
+ * @brief Stores `a ^ b` into a destination and counts its set bits
+ * @copydetails eya_bit_range_and
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_bit_range_xor(void *dst, const void *a, const void *b, eya_usize_t size);
+
+/**
+ * @brief Stores `a & ~b` into a destination and counts its set bits
+ * @copydetails eya_bit_range_and
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_bit_range_andnot(void *dst, const void *a, const void *b, eya_usize_t size);
+
+/**
+ * @brief Extracts the bits of a value selected by a mask (`pext`)
+ * @param[in] value Source bits
+ * @param[in] mask Positions to extract
+ * @return The selected bits packed into the low bits, in order
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_ullong_t
+eya_bit_pext64(eya_ullong_t value, eya_ullong_t mask);
+
+/**
+ * @brief Deposits the low bits of a value at the positions of a mask (`pdep`)
+ * @param[in] value Source bits, the lowest first
+ * @param[in] mask Positions to fill
+ * @return Value with the bits of the mask filled and all others clear
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_ullong_t
+eya_bit_pdep64(eya_ullong_t value, eya_ullong_t mask);
+
+/**
+ * @brief Packs the bits of a buffer selected by a mask into a bit stream
+ * @param[out] dst Destination stream of at least `(popcount(mask) + 7) / 8` bytes
+ * @param[in] src Source buffer
+ * @param[in] mask Mask buffer, of the size of the source
+ * @param[in] size Size of the source and the mask in bytes
+ * @return Number of bits written, the population count of the mask
+ *
+ * Unused bits of the last destination byte are cleared.
+ * The pointers may be nullptr if size is 0.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If a pointer is nullptr and size is not zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_bit_range_gather(void *dst, const void *src, const void *mask, eya_usize_t size);
+
+/**
+ * @brief Unpacks a bit stream to the positions selected by a mask
+ * @param[out] dst Destination buffer, of the size of the mask
+ * @param[in] src Source stream of at least `(popcount(mask) + 7) / 8` bytes
+ * @param[in] mask Mask buffer
+ * @param[in] size Size of the destination and the mask in bytes
+ * @return Number of bits read, the population count of the mask
+ *
+ * Bits of the destination outside the mask are cleared.
+ * The pointers may be nullptr if size is 0.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If a pointer is nullptr and size is not zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_bit_range_scatter(void *dst, const void *src, const void *mask, eya_usize_t size);
+
+/**
+ * @brief Selects the implementations allowed by a set of CPU features
+ * @param[in] features Bitwise OR of @ref eya_cpu_feature_t flags,
+ *                     those the CPU does not support are ignored
+ *
+ * The library calls it with every feature when it is loaded.
+ *
+ * @warning Must not run concurrently with the other functions of this header.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_bit_range_set_cpu_features(eya_uint_t features);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_BIT_RANGE_H
\ No newline at end of file
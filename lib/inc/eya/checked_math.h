@@ -0,0 +1,103 @@
+/**
+ * @file checked_math.h
+ * @brief Size arithmetic that detects wraparound
+ *
+ * Every function computes its result into an output argument and returns
+ * whether the exact value did not fit in @ref eya_usize_t, in the manner of
+ * the GCC `__builtin_*_overflow` family:
+ * - GCC and Clang use those builtins, which compile to the carry or overflow flag
+ * - MSVC on 64-bit targets uses `_umul128` for the multiplication
+ * - Other compilers use portable comparisons
+ *
+ * None of them divides, so allocation paths can check `count * element_size`
+ * on every call without paying for a division.
+ *
+ * @code
+ * eya_usize_t size_in_bytes;
+ * eya_runtime_check_if(eya_checked_mul(count, element_size, &size_in_bytes),
+ *                      EYA_RUNTIME_ERROR_OVERFLOW);
+ * @endcode
+ */
+
+#ifndef EYA_CHECKED_MATH_H
+#define EYA_CHECKED_MATH_H
+
+#include "attribute.h"
+#include "size.h"
+#include "bool.h"
+
+#if (EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && (EYA_COMPILER_BIT_DEPTH == 64)
+#    include <intrin.h>
+#endif
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Adds two sizes
+ * @param[in] a First addend
+ * @param[in] b Second addend
+ * @param[out] result Sum, wrapped modulo the range of the type on overflow
+ * @return true if the sum does not fit in @ref eya_usize_t
+ */
+EYA_ATTRIBUTE(FORCE_INLINE)
+bool
+eya_checked_add(eya_usize_t a, eya_usize_t b, eya_usize_t *result)
+{
+#if EYA_COMPILER_GCC_LIKE
+    return __builtin_add_overflow(a, b, result);
+#else
+    *result = a + b;
+    return *result < a;
+#endif
+}
+
+/**
+ * @brief Multiplies two sizes
+ * @param[in] a First factor
+ * @param[in] b Second factor
+ * @param[out] result Product, wrapped modulo the range of the type on overflow
+ * @return true if the product does not fit in @ref eya_usize_t
+ */
+EYA_ATTRIBUTE(FORCE_INLINE)
+bool
+eya_checked_mul(eya_usize_t a, eya_usize_t b, eya_usize_t *result)
+{
+#if EYA_COMPILER_GCC_LIKE
+    return __builtin_mul_overflow(a, b, result);
+#elif (EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && (EYA_COMPILER_BIT_DEPTH == 64)
+    unsigned __int64 high;
+    *result = _umul128(a, b, &high);
+    return high != 0;
+#else
+    // Both factors below the square root of the range cannot overflow.
+    const eya_usize_t half = (eya_usize_t)1 << (sizeof(eya_usize_t) * 4);
+
+    *result = a * b;
+    return (a >= half || b >= half) && a && *result / a != b;
+#endif
+}
+
+/**
+ * @brief Shifts a size to the left
+ * @param[in] a Value to shift
+ * @param[in] shift Number of bit positions
+ * @param[out] result Shifted value, unspecified on overflow
+ * @return true if a set bit is shifted out of @ref eya_usize_t
+ */
+EYA_ATTRIBUTE(FORCE_INLINE)
+bool
+eya_checked_shl(eya_usize_t a, eya_usize_t shift, eya_usize_t *result)
+{
+    if (shift >= sizeof(eya_usize_t) * 8)
+    {
+        *result = 0;
+        return a != 0;
+    }
+
+    *result = a << shift;
+    return (*result >> shift) != a;
+}
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_CHECKED_MATH_H
\ No newline at end of file
@@ -0,0 +1,137 @@
+/**
+ * @file counter.h
+ * @brief Statistics counter sharded into per-thread slots
+ *
+ * A single atomic counter updated by many threads moves its cache line
+ * between cores on every increment. This counter keeps one slot per thread
+ * instead, each a cache line apart from the others:
+ * - A thread gets a slot index on its first update of any counter,
+ *   kept in thread-local storage and shared by all counters,
+ *   and gives it back when it exits
+ * - An update by the owner of a slot is a plain load and store on a line
+ *   that no other thread writes
+ * - Reading the counter sums the slots, so reads are slower than updates
+ *   and only see a value that was current at some moment during the sum
+ *
+ * Up to @ref EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT running threads own slots.
+ * A slot keeps its value when its thread exits, and the next thread to own it
+ * keeps adding to it. Threads that start while every slot is held, and every thread
+ * when `EYA_LIBRARY_OPTION_THREAD_LOCAL` is off, update a shared overflow slot atomically.
+ *
+ * Updates are modular, so a counter may also track a value that goes up
+ * and down, such as bytes in use.
+ *
+ * Typical usage:
+ * @code
+ * static eya_counter_t requests = EYA_COUNTER_INITIALIZER;
+ *
+ * eya_counter_increment(&requests);       // hot path, any thread
+ * eya_usize_t n = eya_counter_get(&requests); // reporting
+ * @endcode
+ */
+
+#ifndef EYA_COUNTER_H
+#define EYA_COUNTER_H
+
+#include "attribute.h"
+#include "atomic.h"
+
+/**
+ * @def EYA_COUNTER_INITIALIZER
+ * @brief Static initializer of a zero counter
+ */
+#define EYA_COUNTER_INITIALIZER {{{0}}}
+
+/**
+ * @struct eya_counter_slot
+ * @brief Part of a counter updated by one thread
+ *
+ * Slots are one cache line long, so values of neighbouring slots
+ * never share a line whatever the alignment of the counter.
+ */
+typedef struct eya_counter_slot
+{
+    eya_atomic_usize_t value;                                                  /**< Partial sum */
+    eya_uchar_t        pad[EYA_ATOMIC_CACHE_LINE_SIZE - sizeof(eya_usize_t)]; /**< Padding */
+} eya_counter_slot_t;
+
+/**
+ * @struct eya_counter
+ * @brief Sharded counter
+ *
+ * @note The fields are managed by the counter functions
+ *       and must not be modified directly.
+ */
+typedef struct eya_counter
+{
+    eya_counter_slot_t slots[EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT]; /**< Slots owned by threads */
+    eya_counter_slot_t overflow; /**< Slot shared by threads without one, updated atomically */
+} eya_counter_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Sets a counter to zero
+ * @param[out] self Pointer to the counter
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ *
+ * @warning No thread may update the counter during the call.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_counter_init(eya_counter_t *self);
+
+/**
+ * @brief Adds a value to the calling thread's slot
+ * @param[in,out] self Pointer to the counter
+ * @param[in] value Value to add
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_counter_add(eya_counter_t *self, eya_usize_t value);
+
+/**
+ * @brief Subtracts a value from the calling thread's slot
+ * @param[in,out] self Pointer to the counter
+ * @param[in] value Value to subtract
+ *
+ * A slot may go below zero, only the sum of all slots is meaningful.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_counter_sub(eya_counter_t *self, eya_usize_t value);
+
+/**
+ * @brief Adds one to the calling thread's slot
+ * @param[in,out] self Pointer to the counter
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_counter_increment(eya_counter_t *self);
+
+/**
+ * @brief Returns the sum of all slots
+ * @param[in] self Pointer to the counter
+ * @return Value of the counter, modulo the range of eya_usize_t
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_counter_get(const eya_counter_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_COUNTER_H
\ No newline at end of file
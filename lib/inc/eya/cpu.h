@@ -0,0 +1,51 @@
+/**
+ * @file cpu.h
+ * @brief Detection of the instruction set extensions of the CPU
+ *
+ * Kernels with several implementations query the features once, usually
+ * from a load-time constructor, and keep the choice in a static variable.
+ * Each implementation is compiled for its extension with
+ * `EYA_ATTRIBUTE(TARGET(...))`, so the library runs on any CPU of its
+ * architecture without `-m` flags.
+ *
+ * @code
+ * if (eya_cpu_has(EYA_CPU_FEATURE_AVX2 | EYA_CPU_FEATURE_BMI2))
+ *     kernel = kernel_avx2;
+ * @endcode
+ *
+ * @note Only x86-64 extensions are detected, other targets report none.
+ */
+
+#ifndef EYA_CPU_H
+#define EYA_CPU_H
+
+#include "numeric_types.h"
+#include "cpu_feature.h"
+#include "attribute.h"
+#include "bool.h"
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Returns the features supported by the CPU and the operating system
+ * @return Bitwise OR of @ref eya_cpu_feature_t flags
+ *
+ * Every call executes `cpuid`, which takes hundreds of cycles,
+ * so callers are expected to keep the result.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_uint_t
+eya_cpu_get_features(void);
+
+/**
+ * @brief Checks whether all of the given features are supported
+ * @param[in] features Bitwise OR of @ref eya_cpu_feature_t flags
+ * @return true if every flag is reported by @ref eya_cpu_get_features()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_cpu_has(eya_uint_t features);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_CPU_H
\ No newline at end of file
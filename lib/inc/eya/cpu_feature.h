@@ -0,0 +1,69 @@
+/**
+ * @file cpu_feature.h
+ * @brief Instruction set extensions detected at run time
+ *
+ * @see cpu.h
+ */
+
+#ifndef EYA_CPU_FEATURE_H
+#define EYA_CPU_FEATURE_H
+
+/**
+ * @typedef eya_cpu_feature_t
+ * @brief Bit flag of an instruction set extension
+ *
+ * A feature is reported only if both the CPU and the operating system
+ * support it, the latter by saving the registers it uses on context switches.
+ */
+typedef enum eya_cpu_feature
+{
+    /**
+     * @brief SSE4.2, including the `crc32` instruction
+     */
+    EYA_CPU_FEATURE_SSE4_2 = 1 << 0,
+
+    /**
+     * @brief Carry-less multiplication (`pclmulqdq`)
+     */
+    EYA_CPU_FEATURE_PCLMUL = 1 << 1,
+
+    /**
+     * @brief Population count of a general purpose register (`popcnt`)
+     */
+    EYA_CPU_FEATURE_POPCNT = 1 << 2,
+
+    /**
+     * @brief 256-bit integer vectors
+     */
+    EYA_CPU_FEATURE_AVX2 = 1 << 3,
+
+    /**
+     * @brief Bit deposit and extract (`pdep`, `pext`)
+     *
+     * @note AMD processors before Zen 3 microcode both instructions
+     *       and run them slower than a software loop.
+     */
+    EYA_CPU_FEATURE_BMI2 = 1 << 4,
+
+    /**
+     * @brief 512-bit vectors with 32-bit and 64-bit elements
+     */
+    EYA_CPU_FEATURE_AVX512F = 1 << 5,
+
+    /**
+     * @brief 512-bit vectors with 8-bit and 16-bit elements
+     */
+    EYA_CPU_FEATURE_AVX512BW = 1 << 6,
+
+    /**
+     * @brief Population count of 32-bit and 64-bit vector elements
+     */
+    EYA_CPU_FEATURE_AVX512VPOPCNTDQ = 1 << 7,
+
+    /**
+     * @brief Byte permutations across 512-bit vectors (`vpermb`)
+     */
+    EYA_CPU_FEATURE_AVX512VBMI = 1 << 8
+} eya_cpu_feature_t;
+
+#endif // EYA_CPU_FEATURE_H
\ No newline at end of file
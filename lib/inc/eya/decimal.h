@@ -0,0 +1,246 @@
+/**
+ * @file decimal.h
+ * @brief Parsing and formatting of decimal integers and doubles
+ *
+ * Parsing reads a number at the start of a range and returns the number of
+ * bytes it used, so a caller can check that a field holds nothing else or
+ * keep reading after the number. Integers are an optional minus sign
+ * followed by digits; leading zeros are allowed and a value outside the
+ * limits of the type is reported rather than wrapped. Doubles are an
+ * optional minus sign, digits with an optional fraction and an optional
+ * exponent, or `inf`, `infinity` or `nan` in any case. They are rounded to
+ * the nearest double, ties to even, however many digits they have.
+ *
+ * Formatting writes the digits into a caller-provided range, which must be
+ * large enough, or appends them to a byte array, which grows as needed.
+ * Doubles are written with the fewest significant digits that parse back
+ * to the same value, in fixed notation when the decimal point falls within
+ * 21 digits of the first one and 6 of the start of the fraction, and
+ * as `1.5e-7` otherwise. Negative zero keeps its sign.
+ *
+ * Digits are parsed eight at a time with SWAR arithmetic on 64-bit words.
+ * Doubles with up to 19 significant digits are converted with the
+ * algorithm of Eisel and Lemire, a 128-bit product with a table of powers
+ * of five; longer inputs that it cannot round are converted exactly with
+ * decimal arithmetic. Shortest digits come from the Schubfach algorithm of
+ * Giulietti, which shares the table. Integers are formatted from the end,
+ * two digits per step, after counting the digits.
+ *
+ * @code
+ * eya_ullong_t      id;
+ * const eya_usize_t used = eya_decimal_parse_ullong(&field, &id);
+ *
+ * eya_decimal_format_double_append(&line, ratio);
+ * @endcode
+ */
+
+#ifndef EYA_DECIMAL_H
+#define EYA_DECIMAL_H
+
+#include "memory_range.h"
+#include "array.h"
+
+/**
+ * @def EYA_DECIMAL_ULLONG_MAX_SIZE
+ * @brief Largest number of bytes written for an @ref eya_ullong_t
+ */
+#define EYA_DECIMAL_ULLONG_MAX_SIZE 20
+
+/**
+ * @def EYA_DECIMAL_SLLONG_MAX_SIZE
+ * @brief Largest number of bytes written for an @ref eya_sllong_t
+ */
+#define EYA_DECIMAL_SLLONG_MAX_SIZE 20
+
+/**
+ * @def EYA_DECIMAL_DOUBLE_MAX_SIZE
+ * @brief Largest number of bytes written for a double
+ */
+#define EYA_DECIMAL_DOUBLE_MAX_SIZE 25
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Returns the number of digits of an unsigned value
+ * @param[in] value Value to measure
+ * @return Number of bytes @ref eya_decimal_format_ullong() writes
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_ullong_size(eya_ullong_t value);
+
+/**
+ * @brief Returns the number of digits of a signed value and its sign
+ * @param[in] value Value to measure
+ * @return Number of bytes @ref eya_decimal_format_sllong() writes
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_sllong_size(eya_sllong_t value);
+
+/**
+ * @brief Parses an unsigned integer at the start of a range
+ * @param[in] src Text to parse
+ * @param[out] value Parsed value
+ * @return Number of bytes used
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If src or value is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the range does not start with a digit
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If the value exceeds the maximum of @ref eya_ullong_t
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_parse_ullong(const eya_memory_range_t *src, eya_ullong_t *value);
+
+/**
+ * @brief Parses a signed integer at the start of a range
+ * @param[in] src Text to parse
+ * @param[out] value Parsed value
+ * @return Number of bytes used
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If src or value is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the range does not start with a digit or a minus sign and a digit
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If the value is outside the limits of @ref eya_sllong_t
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_parse_sllong(const eya_memory_range_t *src, eya_sllong_t *value);
+
+/**
+ * @brief Parses a double at the start of a range
+ * @param[in] src Text to parse
+ * @param[out] value Nearest double, infinite or zero if the value is out of its range
+ * @return Number of bytes used
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If src or value is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the range does not start with a number
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_parse_double(const eya_memory_range_t *src, double *value);
+
+/**
+ * @brief Writes an unsigned integer at the start of a range
+ * @param[in] dst Destination of at least @ref eya_decimal_ullong_size() bytes
+ * @param[in] value Value to write
+ * @return Number of bytes written
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_format_ullong(const eya_memory_range_t *dst, eya_ullong_t value);
+
+/**
+ * @brief Writes a signed integer at the start of a range
+ * @param[in] dst Destination of at least @ref eya_decimal_sllong_size() bytes
+ * @param[in] value Value to write
+ * @return Number of bytes written
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_format_sllong(const eya_memory_range_t *dst, eya_sllong_t value);
+
+/**
+ * @brief Writes the shortest text of a double at the start of a range
+ * @param[in] dst Destination, @ref EYA_DECIMAL_DOUBLE_MAX_SIZE bytes are always enough
+ * @param[in] value Value to write
+ * @return Number of bytes written
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small, in which case it is left unchanged
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_format_double(const eya_memory_range_t *dst, double value);
+
+/**
+ * @brief Appends an unsigned integer to a byte array
+ * @param[in,out] dst Array with an element size of 1
+ * @param[in] value Value to write
+ * @return Number of bytes appended
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst is nullptr
+ * @throws EYA_RUNTIME_ERROR_DIFFERENT_ELEMENT_SIZE
+ *         If the elements of the array are not bytes
+ * @throws EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE
+ *         If the array would exceed its maximum size
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the array cannot grow
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_format_ullong_append(eya_array_t *dst, eya_ullong_t value);
+
+/**
+ * @brief Appends a signed integer to a byte array
+ * @param[in,out] dst Array with an element size of 1
+ * @param[in] value Value to write
+ * @return Number of bytes appended
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst is nullptr
+ * @throws EYA_RUNTIME_ERROR_DIFFERENT_ELEMENT_SIZE
+ *         If the elements of the array are not bytes
+ * @throws EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE
+ *         If the array would exceed its maximum size
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the array cannot grow
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_format_sllong_append(eya_array_t *dst, eya_sllong_t value);
+
+/**
+ * @brief Appends the shortest text of a double to a byte array
+ * @param[in,out] dst Array with an element size of 1
+ * @param[in] value Value to write
+ * @return Number of bytes appended
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst is nullptr
+ * @throws EYA_RUNTIME_ERROR_DIFFERENT_ELEMENT_SIZE
+ *         If the elements of the array are not bytes
+ * @throws EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE
+ *         If the array would exceed its maximum size
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the array cannot grow
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_decimal_format_double_append(eya_array_t *dst, double value);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_DECIMAL_H
\ No newline at end of file
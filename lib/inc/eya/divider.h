@@ -0,0 +1,117 @@
+/**
+ * @file divider.h
+ * @brief Division by an invariant divisor through a precomputed reciprocal
+ *
+ * Dividing by a value known only at run time costs a hardware divide of
+ * 20–90 cycles. When the same divisor is used many times, such as the element
+ * size of a typed range, a reciprocal can be computed once and every later
+ * quotient obtained with a multiplication and a shift:
+ * - Powers of two reduce to a shift
+ * - Other divisors use a "magic" multiplier of the width of @ref eya_usize_t,
+ *   with an extra add-and-halve step for divisors whose multiplier would need
+ *   one more bit (the round-up method of Granlund–Montgomery and libdivide)
+ *
+ * The quotient is exact for every numerator.
+ *
+ * @code
+ * eya_divider_t divider;
+ * eya_divider_init(&divider, element_size);
+ *
+ * for (...)
+ *     count = eya_divider_div(&divider, size_in_bytes);
+ * @endcode
+ */
+
+#ifndef EYA_DIVIDER_H
+#define EYA_DIVIDER_H
+
+#include "attribute.h"
+#include "size.h"
+#include "bool.h"
+
+#if (EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && (EYA_COMPILER_BIT_DEPTH == 64)
+#    include <intrin.h>
+#endif
+
+/**
+ * @struct eya_divider
+ * @brief Reciprocal of a divisor
+ *
+ * @note The fields are managed by @ref eya_divider_init().
+ *       A zero-filled divider has a divisor of 0 and holds no reciprocal.
+ */
+typedef struct eya_divider
+{
+    eya_usize_t divisor; /**< Divisor the reciprocal was computed for */
+    eya_usize_t magic;   /**< Multiplier, 0 if the divisor is a power of two */
+    eya_usize_t shift;   /**< Final right shift */
+    bool        add;     /**< Whether the multiplier needs the add-and-halve step */
+} eya_divider_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Computes the reciprocal of a divisor
+ * @param[out] self Pointer to the divider
+ * @param[in] divisor Divisor, nonzero
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If divisor is zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_divider_init(eya_divider_t *self, eya_usize_t divisor);
+
+/**
+ * @brief Returns the high half of the double-width product of two sizes
+ * @param[in] a First factor
+ * @param[in] b Second factor
+ * @return Product shifted right by the width of @ref eya_usize_t
+ */
+EYA_ATTRIBUTE(FORCE_INLINE)
+eya_usize_t
+eya_divider_mulhi(eya_usize_t a, eya_usize_t b)
+{
+    if (sizeof(eya_usize_t) == 4)
+        return (eya_usize_t)(((eya_ullong_t)a * b) >> 32);
+
+#if defined(__SIZEOF_INT128__)
+    return (eya_usize_t)(((unsigned __int128)a * b) >> 64);
+#elif (EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && (EYA_COMPILER_BIT_DEPTH == 64)
+    return __umulh(a, b);
+#else
+    const eya_usize_t half = sizeof(eya_usize_t) * 4;
+    const eya_usize_t mask = ((eya_usize_t)1 << half) - 1;
+
+    const eya_usize_t lo_lo = (a & mask) * (b & mask);
+    const eya_usize_t hi_lo = (a >> half) * (b & mask);
+    const eya_usize_t lo_hi = (a & mask) * (b >> half);
+    const eya_usize_t hi_hi = (a >> half) * (b >> half);
+    const eya_usize_t cross = (lo_lo >> half) + (hi_lo & mask) + lo_hi;
+
+    return hi_hi + (hi_lo >> half) + (cross >> half);
+#endif
+}
+
+/**
+ * @brief Divides by the divisor of a divider
+ * @param[in] self Pointer to an initialized divider
+ * @param[in] numerator Value to divide
+ * @return `numerator / self->divisor`
+ */
+EYA_ATTRIBUTE(FORCE_INLINE)
+eya_usize_t
+eya_divider_div(const eya_divider_t *self, eya_usize_t numerator)
+{
+    if (!self->magic)
+        return numerator >> self->shift;
+
+    const eya_usize_t q = eya_divider_mulhi(self->magic, numerator);
+    return (self->add ? ((numerator - q) >> 1) + q : q) >> self->shift;
+}
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_DIVIDER_H
\ No newline at end of file
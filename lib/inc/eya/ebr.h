@@ -0,0 +1,164 @@
+/**
+ * @file ebr.h
+ * @brief Epoch-based reclamation of memory shared by lock-free structures
+ *
+ * A lock-free structure cannot free a node as soon as it unlinks it,
+ * because readers that loaded the pointer earlier may still use the node.
+ * Epoch-based reclamation defers the free until every such reader is gone:
+ * - The domain keeps a global epoch that only moves forward
+ * - A thread enters a critical section before it loads shared pointers
+ *   and announces the epoch it saw in its own record
+ * - The epoch advances only when every thread inside a critical section
+ *   has announced the current one
+ * - A pointer retired in epoch `e` is unreachable for every section that starts
+ *   after the retire, so it is freed once the global epoch reaches `e + 2`
+ *
+ * Entering costs one compare-and-swap and a fence, exiting one store, on a record
+ * that is normally reused by the same thread, so readers do not share cache lines.
+ * Records are claimed per critical section and a thread-local hint
+ * remembers the last one, so threads need no registration and may exit at any time.
+ *
+ * Retired pointers are collected in batches of @ref EYA_LIBRARY_OPTION_EBR_BATCH_SIZE
+ * per record. Scanning the records to advance the epoch and freeing expired
+ * batches happen once per full batch or on an explicit flush, which also
+ * frees the expired batches of the records no section is using, so memory
+ * retired by threads that went idle does not pile up.
+ * All memory is freed with `eya_memory_allocator_free` through the allocator
+ * of the domain, so retired pointers must come from that allocator.
+ *
+ * Typical usage:
+ * @code
+ * eya_ebr_guard_t *guard = eya_ebr_enter(&ebr);
+ *
+ * node_t *node = eya_atomic_load(&head, EYA_ATOMIC_ACQUIRE); // safe until the exit
+ * if (eya_atomic_compare_exchange(&head, &node, node->next, ...))
+ *     eya_ebr_retire(guard, node);
+ *
+ * eya_ebr_exit(guard);
+ * @endcode
+ *
+ * @see memory_allocator.h
+ */
+
+#ifndef EYA_EBR_H
+#define EYA_EBR_H
+
+#include "memory_allocator.h"
+#include "atomic.h"
+
+/**
+ * @typedef eya_ebr_guard_t
+ * @brief Opaque handle of a critical section
+ */
+typedef struct eya_ebr_record eya_ebr_guard_t;
+
+/**
+ * @struct eya_ebr
+ * @brief Reclamation domain
+ *
+ * @note The fields are managed by the EBR functions
+ *       and must not be modified directly.
+ */
+typedef struct eya_ebr
+{
+    eya_memory_allocator_t allocator; /**< Source of the records, frees retired memory */
+    eya_usize_t            id;        /**< Unique number that validates thread-local hints */
+    eya_atomic_ptr_t       records;   /**< Singly-linked list of records, only grows */
+    eya_uchar_t            pad0[EYA_ATOMIC_CACHE_LINE_SIZE];
+
+    eya_atomic_usize_t epoch; /**< Global epoch */
+    eya_uchar_t        pad1[EYA_ATOMIC_CACHE_LINE_SIZE];
+} eya_ebr_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes a domain without records
+ * @param[out] self Pointer to the domain
+ * @param[in] allocator Allocator of the domain (nullptr to use the calling thread's one)
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ *
+ * @see eya_ebr_destroy()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_ebr_init(eya_ebr_t *self, const eya_memory_allocator_t *allocator);
+
+/**
+ * @brief Frees every retired pointer and the records of a domain
+ * @param[in,out] self Pointer to the domain
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ *
+ * @warning No thread may be inside a critical section of the domain during or after the call.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_ebr_destroy(eya_ebr_t *self);
+
+/**
+ * @brief Enters a critical section
+ * @param[in,out] self Pointer to the domain
+ * @return Guard of the section, valid until eya_ebr_exit()
+ *
+ * Pointers loaded from the protected structure after the call stay valid
+ * until the section is exited. Sections may be nested, each gets its own guard.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If every record is in use and a new one could not be allocated
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_ebr_guard_t *
+eya_ebr_enter(eya_ebr_t *self);
+
+/**
+ * @brief Exits a critical section
+ * @param[in] guard Guard returned by eya_ebr_enter()
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If guard is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_ebr_exit(eya_ebr_guard_t *guard);
+
+/**
+ * @brief Defers freeing of a pointer until no critical section can reach it
+ * @param[in] guard Guard of the calling thread's critical section
+ * @param[in] ptr Pointer allocated with the domain allocator, already unreachable
+ *                for sections that start after the call (nullptr is ignored)
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If guard is nullptr
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the batch was full and a new one could not be allocated,
+ *         the pointer is then not retired
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_ebr_retire(eya_ebr_guard_t *guard, void *ptr);
+
+/**
+ * @brief Closes the pending batches of a record and of the unused ones, frees the expired ones
+ * @param[in] guard Guard of the calling thread's critical section
+ *
+ * Meant for structures that retire rarely but large blocks,
+ * which would otherwise wait for a batch to fill.
+ * Pointers retired during the calling section are freed by a later flush or retire,
+ * since the section itself keeps the epoch from advancing twice.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If guard is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_ebr_flush(eya_ebr_guard_t *guard);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_EBR_H
\ No newline at end of file
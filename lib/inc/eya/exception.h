@@ -5,33 +5,28 @@
  * Defines the `eya_exception_t` structure
  * that represents an exception within the system.
  *
- * Contains error information and, in debug mode,
- * additional stack trace context.
+ * Contains error information and stack trace context,
+ * which is filled in debug mode only.
  */
 
 #ifndef EYA_EXCEPTION_H
 #define EYA_EXCEPTION_H
 
 #include "error.h"
-
-#ifdef EYA_COMPILE_OPTION_DEBUG
-#    include "exception_trace.h"
-#endif // EYA_COMPILE_OPTION_DEBUG
+#include "exception_trace.h"
 
 /**
  * @brief Structure representing an exception
  *
- * Contains error context information and,
- * in debug builds, additional call stack trace details.
+ * Contains error context information and call stack trace details.
+ * The trace is always present, so that the library and its users agree
+ * on the layout whatever debug option either was compiled with; it is
+ * filled only in debug builds and zero otherwise.
  */
 typedef struct eya_exception
 {
-    eya_error_t err; /**< Error code and associated message */
-
-#ifdef EYA_COMPILE_OPTION_DEBUG
+    eya_error_t           err;   /**< Error code and associated message */
     eya_exception_trace_t trace; /**< Exception tracing information */
-#endif
-
 } eya_exception_t;
 
 #endif // EYA_EXCEPTION_H
\ No newline at end of file
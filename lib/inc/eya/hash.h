@@ -0,0 +1,184 @@
+/**
+ * @file hash.h
+ * @brief Fast non-cryptographic 64-bit and 128-bit hashing
+ *
+ * The functions implement XXH3 (xxHash 0.8) and produce the same values as
+ * `XXH3_64bits_withSeed()` and `XXH3_128bits_withSeed()` of the reference
+ * library, so hashes may be stored or exchanged with other implementations:
+ * - Inputs up to 240 bytes are mixed with a few 64x64→128-bit multiplications
+ * - Longer inputs are accumulated in 64-byte stripes over eight 64-bit lanes,
+ *   using SSE2 when the target has it
+ *
+ * The streaming functions accept the data in pieces of any size and return
+ * the same values as the one-shot functions over the concatenated data.
+ *
+ * @warning The hashes are not cryptographic, they must not be used where
+ *          an attacker chooses the input and profits from collisions
+ *          unless the seed is secret.
+ *
+ * @code
+ * eya_ullong_t key_hash = eya_hash64(key, key_size, 0);
+ *
+ * eya_hash_state_t state;
+ * eya_hash_init(&state, seed);
+ * while (read_block(&block))
+ *     eya_hash_update(&state, block.data, block.size);
+ * eya_hash128_t file_hash = eya_hash_digest128(&state);
+ * @endcode
+ */
+
+#ifndef EYA_HASH_H
+#define EYA_HASH_H
+
+#include "memory_range.h"
+#include "numeric_types.h"
+
+/**
+ * @brief Size of the streaming buffer in bytes
+ */
+#define EYA_HASH_BUFFER_SIZE 256
+
+/**
+ * @brief Size of the key material derived from the seed in bytes
+ */
+#define EYA_HASH_SECRET_SIZE 192
+
+/**
+ * @struct eya_hash128
+ * @brief 128-bit hash value
+ */
+typedef struct eya_hash128
+{
+    eya_ullong_t low;  /**< Lower 64 bits */
+    eya_ullong_t high; /**< Upper 64 bits */
+} eya_hash128_t;
+
+/**
+ * @struct eya_hash_state
+ * @brief State of a streaming hash
+ *
+ * @note The fields are managed by the eya_hash_*() functions.
+ */
+typedef struct eya_hash_state
+{
+    eya_ullong_t acc[8];                         /**< Accumulator lanes */
+    eya_uchar_t  secret[EYA_HASH_SECRET_SIZE];   /**< Key material derived from the seed */
+    eya_uchar_t  buffer[EYA_HASH_BUFFER_SIZE];   /**< Bytes not yet accumulated */
+    eya_usize_t  buffered;                       /**< Number of bytes in the buffer */
+    eya_usize_t  stripes;                        /**< Stripes accumulated in the current block */
+    eya_ullong_t total;                          /**< Number of bytes hashed so far */
+    eya_ullong_t seed;                           /**< Seed of the hash */
+} eya_hash_state_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Computes the 64-bit hash of a byte sequence
+ * @param[in] data Pointer to the bytes (may be nullptr if size is 0)
+ * @param[in] size Number of bytes
+ * @param[in] seed Seed selecting one of 2^64 hash functions
+ * @return Hash value
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If data is nullptr and size is not zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_ullong_t
+eya_hash64(const void *data, eya_usize_t size, eya_ullong_t seed);
+
+/**
+ * @brief Computes the 128-bit hash of a byte sequence
+ * @param[in] data Pointer to the bytes (may be nullptr if size is 0)
+ * @param[in] size Number of bytes
+ * @param[in] seed Seed selecting one of 2^64 hash functions
+ * @return Hash value
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If data is nullptr and size is not zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_hash128_t
+eya_hash128(const void *data, eya_usize_t size, eya_ullong_t seed);
+
+/**
+ * @brief Computes the 64-bit hash of the bytes of a memory range
+ * @param[in] range Pointer to the range
+ * @param[in] seed Seed selecting one of 2^64 hash functions
+ * @return Hash value
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If range is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_ullong_t
+eya_hash64_range(const eya_memory_range_t *range, eya_ullong_t seed);
+
+/**
+ * @brief Computes the 128-bit hash of the bytes of a memory range
+ * @param[in] range Pointer to the range
+ * @param[in] seed Seed selecting one of 2^64 hash functions
+ * @return Hash value
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If range is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_hash128_t
+eya_hash128_range(const eya_memory_range_t *range, eya_ullong_t seed);
+
+/**
+ * @brief Starts a streaming hash
+ * @param[out] self Pointer to the state
+ * @param[in] seed Seed selecting one of 2^64 hash functions
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_hash_init(eya_hash_state_t *self, eya_ullong_t seed);
+
+/**
+ * @brief Appends bytes to a streaming hash
+ * @param[in,out] self Pointer to the state
+ * @param[in] data Pointer to the bytes (may be nullptr if size is 0)
+ * @param[in] size Number of bytes
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr, or data is nullptr and size is not zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_hash_update(eya_hash_state_t *self, const void *data, eya_usize_t size);
+
+/**
+ * @brief Returns the 64-bit hash of the bytes appended so far
+ * @param[in] self Pointer to the state
+ * @return Same value as @ref eya_hash64() over all appended bytes
+ *
+ * The state is not modified, so more bytes may be appended afterwards.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_ullong_t
+eya_hash_digest64(const eya_hash_state_t *self);
+
+/**
+ * @brief Returns the 128-bit hash of the bytes appended so far
+ * @param[in] self Pointer to the state
+ * @return Same value as @ref eya_hash128() over all appended bytes
+ *
+ * The state is not modified, so more bytes may be appended afterwards.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_hash128_t
+eya_hash_digest128(const eya_hash_state_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_HASH_H
\ No newline at end of file
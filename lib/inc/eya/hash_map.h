@@ -0,0 +1,141 @@
+/**
+ * @file hash_map.h
+ * @brief Concurrent hash map with lock-free reads
+ *
+ * The map stores fixed-size keys and values inline in open-addressing tables:
+ * - The hash selects one of @ref EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT segments,
+ *   every segment owns a table, a writer lock and a sequence counter
+ * - Readers take no locks: they probe the table and validate the copy
+ *   against the sequence counter, retrying if a writer changed the segment meanwhile
+ * - Writers of different segments do not contend with each other
+ * - A segment grows on its own when it gets too full, so resizing never stops
+ *   the whole map; its keys then move to the new table a few slots per insert,
+ *   so no writer waits for a whole table to be copied, and lookups probe
+ *   both tables until the old one is drained
+ *
+ * Drained tables are freed through epoch-based reclamation
+ * once no reader can still probe them.
+ *
+ * Keys are compared bytewise, so padding bytes of key structures must be initialized.
+ * Memory comes from the allocator given at creation.
+ *
+ * @code
+ * eya_hash_map_t *map = eya_hash_map_make(sizeof(id_t), sizeof(item_t), nullptr, nullptr);
+ *
+ * eya_hash_map_insert(map, &id, &item);   // any thread
+ * if (eya_hash_map_find(map, &id, &copy)) // any thread, lock-free
+ *     use(&copy);
+ *
+ * eya_hash_map_free(map);
+ * @endcode
+ *
+ * @see hash_map_hash_fn.h
+ * @see ebr.h
+ */
+
+#ifndef EYA_HASH_MAP_H
+#define EYA_HASH_MAP_H
+
+#include "hash_map_hash_fn.h"
+#include "memory_allocator.h"
+#include "bool.h"
+
+/**
+ * @typedef eya_hash_map_t
+ * @brief Opaque concurrent hash map
+ */
+typedef struct eya_hash_map eya_hash_map_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Creates an empty map
+ * @param[in] key_size Size of every key in bytes
+ * @param[in] value_size Size of every value in bytes (0 for a set)
+ * @param[in] hash_fn Hash function of the keys (nullptr for @ref eya_hash64() with seed 0)
+ * @param[in] allocator Allocator of the map memory (nullptr to use the calling thread's one)
+ * @return Pointer to the new map
+ *
+ * @throws EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE
+ *         If key_size is zero
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If a slot of the given sizes does not fit in eya_usize_t
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the map could not be allocated
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_hash_map_t *
+eya_hash_map_make(eya_usize_t                   key_size,
+                  eya_usize_t                   value_size,
+                  eya_hash_map_hash_fn         *hash_fn,
+                  const eya_memory_allocator_t *allocator);
+
+/**
+ * @brief Frees a map and all its tables
+ * @param[in] self Pointer to the map, not used by any other thread
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_hash_map_free(eya_hash_map_t *self);
+
+/**
+ * @brief Returns the number of entries
+ * @param[in] self Pointer to the map
+ * @return Number of entries, approximate while writers are active
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_hash_map_get_size(const eya_hash_map_t *self);
+
+/**
+ * @brief Looks up a key without taking locks
+ * @param[in] self Pointer to the map
+ * @param[in] key Pointer to the key
+ * @param[out] value Receives a copy of the value if the key is present (may be nullptr)
+ * @return true if the key is present
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or key is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_hash_map_find(eya_hash_map_t *self, const void *key, void *value);
+
+/**
+ * @brief Inserts a key or replaces the value of a present one
+ * @param[in] self Pointer to the map
+ * @param[in] key Pointer to the key
+ * @param[in] value Pointer to the value (may be nullptr if the value size is 0)
+ * @return true if the key was inserted, false if its value was replaced
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self, key or a required value is nullptr
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the segment had to grow and its new table could not be allocated
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_hash_map_insert(eya_hash_map_t *self, const void *key, const void *value);
+
+/**
+ * @brief Removes a key
+ * @param[in] self Pointer to the map
+ * @param[in] key Pointer to the key
+ * @return true if the key was present
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or key is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_hash_map_erase(eya_hash_map_t *self, const void *key);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_HASH_MAP_H
\ No newline at end of file
@@ -0,0 +1,36 @@
+/**
+ * @file hash_map_hash_fn.h
+ * @brief Header file defining the hash map hash function type.
+ *
+ * This file declares the `eya_hash_map_hash_fn` type — a function
+ * mapping a key of a concurrent hash map to a size-wide hash value.
+ *
+ * @see eya_hash_map_make()
+ */
+
+#ifndef EYA_HASH_MAP_HASH_FN_H
+#define EYA_HASH_MAP_HASH_FN_H
+
+#include "size.h"
+
+/**
+ * @typedef eya_hash_map_hash_fn
+ * @brief Function type for hashing hash map keys.
+ *
+ * The function receives the key bytes and the key size given to `eya_hash_map_make()`.
+ * Equal keys must produce equal values. The map mixes the result once more,
+ * so a function with weak high bits still spreads keys over all segments.
+ *
+ * Usage example:
+ * @code
+ * eya_usize_t hash_id(const void *key, eya_usize_t size) {
+ *     return *(const eya_uint_t *)key;
+ * }
+ * eya_hash_map_t *map = eya_hash_map_make(sizeof(eya_uint_t), sizeof(item_t), hash_id, nullptr);
+ * @endcode
+ *
+ * @see eya_hash_map_make()
+ */
+typedef eya_usize_t(eya_hash_map_hash_fn)(const void *key, eya_usize_t size);
+
+#endif // EYA_HASH_MAP_HASH_FN_H
\ No newline at end of file
@@ -0,0 +1,153 @@
+/**
+ * @file hex.h
+ * @brief Hexadecimal encoding and decoding of memory ranges
+ *
+ * Each byte is written as two lowercase digits, the high nibble first.
+ * Decoding accepts both cases and rejects any other character.
+ *
+ * The output goes either into a caller-provided range, which must be at
+ * least as large as the size helpers report, or is appended to a byte
+ * array, which grows as needed.
+ *
+ * With AVX2, 32 bytes are encoded or 64 digits decoded per step, using
+ * byte shuffles as lookup tables. Other CPUs process one byte at a time.
+ * @ref eya_hex_set_cpu_features() can force the latter, e.g. in tests.
+ *
+ * @code
+ * eya_array_t text = eya_array_make(1, 0);
+ * eya_hex_encode_append(&text, &payload);
+ * @endcode
+ */
+
+#ifndef EYA_HEX_H
+#define EYA_HEX_H
+
+#include "memory_range.h"
+#include "array.h"
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Returns the number of digits encoding a number of bytes
+ * @param[in] size Number of bytes
+ * @return Twice the size
+ *
+ * @throws EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE
+ *         If the result does not fit in @ref eya_usize_t
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_hex_encode_size(eya_usize_t size);
+
+/**
+ * @brief Returns the number of bytes decoded from a number of digits
+ * @param[in] size Number of digits
+ * @return Half the size
+ *
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the size is odd
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_hex_decode_size(eya_usize_t size);
+
+/**
+ * @brief Encodes a range into a destination range
+ * @param[in] dst Destination, at least @ref eya_hex_encode_size() bytes
+ * @param[in] src Bytes to encode
+ * @return Number of digits written
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If a range is invalid
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_hex_encode(const eya_memory_range_t *dst, const eya_memory_range_t *src);
+
+/**
+ * @brief Decodes a range of digits into a destination range
+ * @param[in] dst Destination, at least @ref eya_hex_decode_size() bytes
+ * @param[in] src Digits to decode
+ * @return Number of bytes written
+ *
+ * The destination may be modified even if an invalid digit is found.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If a range is invalid
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the number of digits is odd or a character is not a hexadecimal digit
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_hex_decode(const eya_memory_range_t *dst, const eya_memory_range_t *src);
+
+/**
+ * @brief Encodes a range and appends the digits to a byte array
+ * @param[in,out] dst Array with an element size of 1
+ * @param[in] src Bytes to encode
+ * @return Number of digits appended
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the source range is invalid
+ * @throws EYA_RUNTIME_ERROR_DIFFERENT_ELEMENT_SIZE
+ *         If the elements of the array are not bytes
+ * @throws EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE
+ *         If the array would exceed its maximum size
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the array cannot grow
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_hex_encode_append(eya_array_t *dst, const eya_memory_range_t *src);
+
+/**
+ * @brief Decodes a range of digits and appends the bytes to a byte array
+ * @param[in,out] dst Array with an element size of 1
+ * @param[in] src Digits to decode
+ * @return Number of bytes appended
+ *
+ * If the digits are invalid, the size of the array is left unchanged.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the source range is invalid
+ * @throws EYA_RUNTIME_ERROR_DIFFERENT_ELEMENT_SIZE
+ *         If the elements of the array are not bytes
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the number of digits is odd or a character is not a hexadecimal digit
+ * @throws EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE
+ *         If the array would exceed its maximum size
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the array cannot grow
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_hex_decode_append(eya_array_t *dst, const eya_memory_range_t *src);
+
+/**
+ * @brief Selects the implementation allowed by a set of CPU features
+ * @param[in] features Bitwise OR of @ref eya_cpu_feature_t flags,
+ *                     those the CPU does not support are ignored
+ *
+ * The library calls it with every feature when it is loaded.
+ *
+ * @warning Must not run concurrently with the other functions of this header.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_hex_set_cpu_features(eya_uint_t features);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_HEX_H
\ No newline at end of file
@@ -0,0 +1,272 @@
+/**
+ * @file io_async.h
+ * @brief Asynchronous positional file reads and writes
+ *
+ * This header provides an engine that moves file data into and out of
+ * allocated ranges without blocking the calling thread:
+ * - io_uring on Linux, with batched submission and registered buffers
+ * - A pool of worker threads issuing `pread()`/`pwrite()` everywhere else
+ *
+ * Typical usage:
+ * @code
+ * eya_io_async_t *io = eya_io_async_make(64, EYA_IO_ASYNC_BACKEND_AUTO);
+ *
+ * eya_io_async_read(io, fd, 0, &range, tag);   // queue
+ * eya_io_async_submit(io);                     // hand the batch to the backend
+ *
+ * eya_io_async_completion_t done[16];
+ * eya_usize_t n = eya_io_async_wait(io, done, 16, 1);
+ *
+ * eya_io_async_free(io);
+ * @endcode
+ *
+ * The number of queued and unfinished operations never exceeds the depth
+ * given at creation, so completions can not be lost and no request allocates memory.
+ *
+ * @note An engine object is owned by a single thread.
+ *       Its functions must not be called concurrently on the same object.
+ * @note The ranges passed to read and write requests must stay alive
+ *       and untouched until the matching completion is reaped.
+ *
+ * @see io_async_backend.h
+ * @see io_async_completion.h
+ */
+
+#ifndef EYA_IO_ASYNC_H
+#define EYA_IO_ASYNC_H
+
+#include "io_async_completion.h"
+#include "io_async_backend.h"
+#include "allocated_range.h"
+
+/**
+ * @typedef eya_io_async_t
+ * @brief Opaque asynchronous I/O engine
+ *
+ * The object is created by `eya_io_async_make()`
+ * with the runtime allocator and released by `eya_io_async_free()`.
+ */
+typedef struct eya_io_async eya_io_async_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Creates an asynchronous I/O engine
+ * @param[in] depth Maximum number of operations queued or in flight at once
+ * @param[in] backend Requested backend (@ref EYA_IO_ASYNC_BACKEND_AUTO to detect)
+ * @return Pointer to the new engine
+ *
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If depth is zero
+ * @throws EYA_RUNTIME_ERROR_NOT_SUPPORTED
+ *         If the requested backend is not available on this system
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the engine state could not be allocated
+ * @throws EYA_RUNTIME_ERROR_THREAD_NOT_CREATED
+ *         If a worker thread of the fallback backend could not be started
+ *
+ * @see eya_io_async_free()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_io_async_t *
+eya_io_async_make(eya_usize_t depth, eya_io_async_backend_t backend);
+
+/**
+ * @brief Destroys an asynchronous I/O engine
+ *
+ * Queued operations are submitted if they were not yet, and
+ * every operation is allowed to finish before the resources are released,
+ * so the memory ranges may be freed once this function returns.
+ *
+ * @param[in,out] self Pointer to the engine (nullptr is ignored)
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_io_async_free(eya_io_async_t *self);
+
+/**
+ * @brief Returns the backend actually used by the engine
+ * @param[in] self Pointer to the engine
+ * @return Backend that was selected at creation
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_io_async_backend_t
+eya_io_async_get_backend(const eya_io_async_t *self);
+
+/**
+ * @brief Returns the maximum number of operations the engine can hold
+ * @param[in] self Pointer to the engine
+ * @return Depth of the engine
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_io_async_get_depth(const eya_io_async_t *self);
+
+/**
+ * @brief Returns the number of operations whose completion has not been reaped yet
+ * @param[in] self Pointer to the engine
+ * @return Number of queued and in-flight operations
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_io_async_get_inflight(const eya_io_async_t *self);
+
+/**
+ * @brief Registers long-lived buffers with the engine
+ *
+ * With io_uring the buffers are pinned by the kernel once,
+ * and reads or writes whose range lies inside one of them
+ * skip the per-request page mapping (`IORING_OP_READ_FIXED`).
+ * The thread pool backend only records the ranges.
+ *
+ * Previously registered buffers are replaced.
+ *
+ * @param[in,out] self Pointer to the engine
+ * @param[in] ranges Array of non-empty ranges to register
+ * @param[in] count Number of ranges in the array
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or ranges is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If count is zero or operations are still in flight
+ * @throws EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED
+ *         If the kernel rejected the buffers
+ *
+ * @see eya_io_async_unregister_buffers()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_io_async_register_buffers(eya_io_async_t              *self,
+                              const eya_allocated_range_t *ranges,
+                              eya_usize_t                  count);
+
+/**
+ * @brief Forgets the buffers registered with `eya_io_async_register_buffers()`
+ * @param[in,out] self Pointer to the engine
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If operations are still in flight
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_io_async_unregister_buffers(eya_io_async_t *self);
+
+/**
+ * @brief Queues a read of the whole range from a file position
+ * @param[in,out] self Pointer to the engine
+ * @param[in] fd Open file descriptor
+ * @param[in] offset Position in the file to read from
+ * @param[out] range Destination range (must have data)
+ * @param[in] user_data Value reported in the completion
+ * @return true if the request was queued, false if the engine is full
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or range is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid or empty
+ *
+ * @note The request is not visible to the backend until `eya_io_async_submit()`
+ *       or `eya_io_async_wait()` is called.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_io_async_read(eya_io_async_t        *self,
+                  int                    fd,
+                  eya_uoffset_t          offset,
+                  eya_allocated_range_t *range,
+                  void                  *user_data);
+
+/**
+ * @brief Queues a write of the whole range to a file position
+ * @param[in,out] self Pointer to the engine
+ * @param[in] fd Open file descriptor
+ * @param[in] offset Position in the file to write to
+ * @param[in] range Source range (must have data)
+ * @param[in] user_data Value reported in the completion
+ * @return true if the request was queued, false if the engine is full
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or range is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid or empty
+ *
+ * @see eya_io_async_read()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_io_async_write(eya_io_async_t              *self,
+                   int                          fd,
+                   eya_uoffset_t                offset,
+                   const eya_allocated_range_t *range,
+                   void                        *user_data);
+
+/**
+ * @brief Hands all queued requests to the backend as one batch
+ * @param[in,out] self Pointer to the engine
+ * @return Number of requests accepted by the backend
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED
+ *         If the kernel refused the submission
+ *
+ * @note Requests that the kernel could not take right now stay queued
+ *       and are retried by the next submit or wait.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_io_async_submit(eya_io_async_t *self);
+
+/**
+ * @brief Collects finished operations without blocking
+ * @param[in,out] self Pointer to the engine
+ * @param[out] completions Array receiving the completion records
+ * @param[in] max Capacity of the completions array
+ * @return Number of records written
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or completions is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_io_async_poll(eya_io_async_t *self, eya_io_async_completion_t *completions, eya_usize_t max);
+
+/**
+ * @brief Submits queued requests and blocks until enough of them finish
+ *
+ * The call returns once at least `min` completions are available
+ * (clamped to `max` and to the number of operations in flight)
+ * and collects up to `max` of them.
+ *
+ * @param[in,out] self Pointer to the engine
+ * @param[out] completions Array receiving the completion records
+ * @param[in] max Capacity of the completions array
+ * @param[in] min Minimum number of completions to wait for
+ * @return Number of records written
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or completions is nullptr
+ * @throws EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED
+ *         If waiting on the kernel failed
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_io_async_wait(eya_io_async_t            *self,
+                  eya_io_async_completion_t *completions,
+                  eya_usize_t                max,
+                  eya_usize_t                min);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_IO_ASYNC_H
\ No newline at end of file
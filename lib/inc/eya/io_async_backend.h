@@ -0,0 +1,44 @@
+/**
+ * @file io_async_backend.h
+ * @brief Backend selection for the asynchronous file I/O engine
+ *
+ * This header defines the `eya_io_async_backend_t` enumeration
+ * which names the mechanism used to carry out asynchronous reads and writes.
+ *
+ * @see io_async.h
+ */
+
+#ifndef EYA_IO_ASYNC_BACKEND_H
+#define EYA_IO_ASYNC_BACKEND_H
+
+/**
+ * @typedef eya_io_async_backend_t
+ * @brief Mechanism used by an asynchronous I/O engine
+ */
+typedef enum eya_io_async_backend
+{
+    /**
+     * @brief Choose the best backend available at runtime
+     *
+     * io_uring is tried first; when the kernel refuses to create a ring
+     * (old kernel, seccomp filter, disabled by sysctl) the thread pool is used.
+     */
+    EYA_IO_ASYNC_BACKEND_AUTO,
+
+    /**
+     * @brief Linux io_uring submission and completion rings
+     *
+     * Requests are batched into the submission ring
+     * and handed to the kernel with a single system call.
+     */
+    EYA_IO_ASYNC_BACKEND_IO_URING,
+
+    /**
+     * @brief Pool of worker threads issuing positional reads and writes
+     *
+     * Portable fallback built on `pread()`/`pwrite()`.
+     */
+    EYA_IO_ASYNC_BACKEND_THREAD_POOL
+} eya_io_async_backend_t;
+
+#endif // EYA_IO_ASYNC_BACKEND_H
\ No newline at end of file
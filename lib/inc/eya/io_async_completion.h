@@ -0,0 +1,30 @@
+/**
+ * @file io_async_completion.h
+ * @brief Completion record of an asynchronous I/O operation
+ *
+ * @see io_async.h
+ */
+
+#ifndef EYA_IO_ASYNC_COMPLETION_H
+#define EYA_IO_ASYNC_COMPLETION_H
+
+#include "size.h"
+
+/**
+ * @struct eya_io_async_completion
+ * @brief Result of a finished read or write request
+ *
+ * The result follows the kernel convention:
+ * a non-negative value is the number of transferred bytes,
+ * a negative value is the negated `errno` of the failed operation.
+ *
+ * @note A short transfer is not an error.
+ *       The caller decides whether to resubmit the remainder.
+ */
+typedef struct eya_io_async_completion
+{
+    void       *user_data; /**< Value passed when the request was queued */
+    eya_ssize_t result;    /**< Transferred bytes or negated error number */
+} eya_io_async_completion_t;
+
+#endif // EYA_IO_ASYNC_COMPLETION_H
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ * @file io_copy.h
+ * @brief Copying data between file descriptors without a user-space round trip
+ *
+ * Copying a file region with `read()` and `write()` moves every byte
+ * through user space twice. `eya_io_copy_range()` asks the kernel
+ * to do the transfer instead and picks the first mechanism that works:
+ * 1. `copy_file_range()` between regular files
+ * 2. `sendfile()` when the output uses its own file position
+ * 3. `splice()` through an internal pipe
+ * 4. Reads and writes through a bounce buffer allocated for the call
+ *
+ * The first three mechanisms are Linux specific,
+ * other systems always use the bounce buffer.
+ *
+ * @see io_copy_path.h
+ */
+
+#ifndef EYA_IO_COPY_H
+#define EYA_IO_COPY_H
+
+#include "io_copy_path.h"
+#include "attribute.h"
+#include "offset.h"
+#include "size.h"
+
+/**
+ * @def EYA_IO_COPY_OFFSET_CURRENT
+ * @brief Offset value meaning "use and advance the descriptor's own position"
+ *
+ * Required for descriptors without positional access, such as pipes and sockets.
+ * Explicit offsets leave the descriptor position untouched.
+ */
+#define EYA_IO_COPY_OFFSET_CURRENT EYA_USIZE_T_MAX
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Copies a region from one descriptor to another
+ * @param[in] fd_in Descriptor to read from
+ * @param[in] off_in Position to read from or @ref EYA_IO_COPY_OFFSET_CURRENT
+ * @param[in] fd_out Descriptor to write to
+ * @param[in] off_out Position to write to or @ref EYA_IO_COPY_OFFSET_CURRENT
+ * @param[in] size Number of bytes to copy
+ * @param[out] path Receives the mechanism that performed the copy (can be nullptr)
+ * @return Number of copied bytes, less than size only if the input ended
+ *
+ * @throws EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED
+ *         If reading or writing failed with an error
+ *         that no fallback mechanism can avoid
+ *
+ * @note When the output is not a regular file with an explicit offset,
+ *       the same file must not be used as input and output.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_io_copy_range(int                 fd_in,
+                  eya_uoffset_t       off_in,
+                  int                 fd_out,
+                  eya_uoffset_t       off_out,
+                  eya_usize_t         size,
+                  eya_io_copy_path_t *path);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_IO_COPY_H
\ No newline at end of file
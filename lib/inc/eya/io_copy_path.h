@@ -0,0 +1,55 @@
+/**
+ * @file io_copy_path.h
+ * @brief Transfer mechanisms used by the descriptor-to-descriptor copy
+ *
+ * @see io_copy.h
+ */
+
+#ifndef EYA_IO_COPY_PATH_H
+#define EYA_IO_COPY_PATH_H
+
+/**
+ * @typedef eya_io_copy_path_t
+ * @brief Mechanism that carried out an `eya_io_copy_range()` call
+ *
+ * The values are listed in the order in which they are tried.
+ */
+typedef enum eya_io_copy_path
+{
+    /**
+     * @brief Nothing was transferred
+     *
+     * Reported for zero-length requests.
+     */
+    EYA_IO_COPY_PATH_NONE,
+
+    /**
+     * @brief In-kernel copy between regular files (`copy_file_range()`)
+     *
+     * The file system may share extents instead of copying
+     * data (reflink), so no page is touched at all.
+     */
+    EYA_IO_COPY_PATH_COPY_FILE_RANGE,
+
+    /**
+     * @brief In-kernel copy from a file into any descriptor (`sendfile()`)
+     *
+     * Only used when the output position is @ref EYA_IO_COPY_OFFSET_CURRENT,
+     * e.g. when the output is a socket or a pipe.
+     */
+    EYA_IO_COPY_PATH_SENDFILE,
+
+    /**
+     * @brief Page moves through an internal pipe (`splice()`)
+     */
+    EYA_IO_COPY_PATH_SPLICE,
+
+    /**
+     * @brief Reads and writes through a bounce buffer
+     *
+     * Portable fallback used when no in-kernel mechanism applies.
+     */
+    EYA_IO_COPY_PATH_BUFFER
+} eya_io_copy_path_t;
+
+#endif // EYA_IO_COPY_PATH_H
\ No newline at end of file
@@ -0,0 +1,207 @@
+/**
+ * @file io_direct.h
+ * @brief Aligned buffers and reads for direct (page-cache bypassing) I/O
+ *
+ * Files opened with `O_DIRECT` only accept transfers whose memory address,
+ * file offset and length are multiples of the device block size.
+ * This header provides:
+ * - A pool of equally sized aligned buffers carved out of one aligned allocation
+ * - A reader that serves arbitrary (unaligned) logical requests
+ *   by reading whole aligned superblocks and copying the requested bytes out
+ *
+ * Example:
+ * @code
+ * eya_io_direct_pool_t pool;
+ * eya_io_direct_pool_init(&pool, 64 * 1024, 8, EYA_IO_DIRECT_DEFAULT_ALIGNMENT);
+ *
+ * eya_io_direct_reader_t reader;
+ * eya_io_direct_reader_init(&reader, fd, &pool);
+ * eya_usize_t got = eya_io_direct_reader_read(&reader, 1234, &range);
+ * eya_io_direct_reader_destroy(&reader);
+ *
+ * eya_io_direct_pool_destroy(&pool);
+ * @endcode
+ *
+ * @note The objects are not thread-safe.
+ *       Use one pool and reader per thread or synchronize externally.
+ *
+ * @see allocated_range.h
+ */
+
+#ifndef EYA_IO_DIRECT_H
+#define EYA_IO_DIRECT_H
+
+#include "allocated_range.h"
+
+/**
+ * @def EYA_IO_DIRECT_DEFAULT_ALIGNMENT
+ * @brief Alignment accepted by direct I/O on common devices and file systems
+ *
+ * Equal to the usual page size, which is a multiple of every logical block size
+ * in practical use (512 and 4096 bytes).
+ */
+#define EYA_IO_DIRECT_DEFAULT_ALIGNMENT 4096
+
+/**
+ * @struct eya_io_direct_pool
+ * @brief Fixed set of aligned buffers of equal size
+ *
+ * Free buffers are chained through their first bytes,
+ * so acquiring and releasing a buffer never allocates.
+ */
+typedef struct eya_io_direct_pool
+{
+    eya_allocated_range_t slab;         /**< Aligned memory holding all buffers */
+    void                 *free_head;    /**< First free buffer or nullptr */
+    eya_usize_t           free_count;   /**< Number of free buffers */
+    eya_usize_t           buffer_size;  /**< Size of every buffer in bytes */
+    eya_usize_t           buffer_count; /**< Total number of buffers */
+    eya_usize_t           align;        /**< Alignment of buffers, offsets and lengths */
+} eya_io_direct_pool_t;
+
+/**
+ * @struct eya_io_direct_reader
+ * @brief Reader of arbitrary file regions through direct I/O
+ *
+ * The reader keeps one pool buffer as its superblock for the whole lifetime.
+ */
+typedef struct eya_io_direct_reader
+{
+    int                   fd;         /**< File descriptor, usually opened with `O_DIRECT` */
+    eya_io_direct_pool_t *pool;       /**< Pool the superblock was taken from */
+    eya_allocated_range_t superblock; /**< Aligned bounce buffer */
+} eya_io_direct_reader_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Allocates the buffers of a pool
+ * @param[out] self Pointer to the pool to initialize
+ * @param[in] buffer_size Size of every buffer (non-zero multiple of align)
+ * @param[in] buffer_count Number of buffers (non-zero)
+ * @param[in] align Alignment (power of two, at least the size of a pointer)
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_NOT_POWER_OF_TWO
+ *         If align is not a power of two
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If buffer_size, buffer_count or align violate the requirements
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If the total size does not fit in eya_usize_t
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the buffers could not be allocated
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_io_direct_pool_init(eya_io_direct_pool_t *self,
+                        eya_usize_t           buffer_size,
+                        eya_usize_t           buffer_count,
+                        eya_usize_t           align);
+
+/**
+ * @brief Releases the memory of a pool
+ * @param[in,out] self Pointer to the pool
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ *
+ * @warning All acquired buffers become dangling.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_io_direct_pool_destroy(eya_io_direct_pool_t *self);
+
+/**
+ * @brief Returns the number of buffers that can still be acquired
+ * @param[in] self Pointer to the pool
+ * @return Number of free buffers
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_io_direct_pool_get_available(const eya_io_direct_pool_t *self);
+
+/**
+ * @brief Takes a free buffer from the pool
+ * @param[in,out] self Pointer to the pool
+ * @param[out] buffer Receives the aligned range of the buffer
+ * @return true on success, false if all buffers are in use
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or buffer is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_io_direct_pool_acquire(eya_io_direct_pool_t *self, eya_allocated_range_t *buffer);
+
+/**
+ * @brief Returns a buffer to the pool and clears the range
+ * @param[in,out] self Pointer to the pool
+ * @param[in,out] buffer Range obtained from eya_io_direct_pool_acquire()
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or buffer is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the range is not a whole, aligned buffer of this pool
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_io_direct_pool_release(eya_io_direct_pool_t *self, eya_allocated_range_t *buffer);
+
+/**
+ * @brief Prepares a reader and reserves its superblock
+ * @param[out] self Pointer to the reader to initialize
+ * @param[in] fd File descriptor to read from
+ * @param[in,out] pool Pool providing the superblock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or pool is nullptr
+ * @throws EYA_RUNTIME_ERROR_RESOURCE_EXHAUSTED
+ *         If the pool has no free buffer
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_io_direct_reader_init(eya_io_direct_reader_t *self, int fd, eya_io_direct_pool_t *pool);
+
+/**
+ * @brief Returns the superblock of a reader to its pool
+ * @param[in,out] self Pointer to the reader
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_io_direct_reader_destroy(eya_io_direct_reader_t *self);
+
+/**
+ * @brief Reads an arbitrary file region into a range
+ *
+ * Parts of the request whose offset, length and destination address are aligned
+ * go straight into the destination. Unaligned head and tail are read
+ * as whole aligned superblocks and the requested bytes are copied out.
+ *
+ * @param[in,out] self Pointer to the reader
+ * @param[in] offset Position in the file to read from (any value)
+ * @param[out] range Destination range (any address and size)
+ * @return Number of bytes read, less than the range size only at end of file
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or range is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ * @throws EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED
+ *         If reading from the file failed
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_io_direct_reader_read(eya_io_direct_reader_t *self,
+                          eya_uoffset_t           offset,
+                          eya_memory_range_t     *range);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_IO_DIRECT_H
\ No newline at end of file
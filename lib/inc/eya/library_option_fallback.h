@@ -258,4 +258,184 @@
 #    define EYA_LIBRARY_OPTION_RUNTIME_TERMINATE_USE_STDLIB EYA_LIBRARY_OPTION_OFF
 #endif // EYA_LIBRARY_OPTION_RUNTIME_TERMINATE_USE_STDLIB
 
+// --------------------------------------------------------------------------------------------- //
+//                                              IO                                               //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @def EYA_LIBRARY_OPTION_IO_ASYNC_FALLBACK_THREADS
+ * @brief Number of worker threads of the asynchronous I/O thread pool backend
+ *
+ * Used by eya_io_async_make() when io_uring is unavailable or not requested.
+ * The actual number of workers never exceeds the depth of the engine.
+ * Default value is 4.
+ *
+ * @see eya_io_async_make()
+ */
+#ifndef EYA_LIBRARY_OPTION_IO_ASYNC_FALLBACK_THREADS
+#    define EYA_LIBRARY_OPTION_IO_ASYNC_FALLBACK_THREADS 4
+#endif // EYA_LIBRARY_OPTION_IO_ASYNC_FALLBACK_THREADS
+
+/**
+ * @def EYA_LIBRARY_OPTION_IO_COPY_BUFFER_SIZE
+ * @brief Largest size in bytes of the bounce buffer of eya_io_copy_range()
+ *
+ * The buffer is allocated from the runtime allocator only when the kernel
+ * can not copy the data itself, and released when the copy returns.
+ * Default value is 65536.
+ */
+#ifndef EYA_LIBRARY_OPTION_IO_COPY_BUFFER_SIZE
+#    define EYA_LIBRARY_OPTION_IO_COPY_BUFFER_SIZE 65536
+#endif // EYA_LIBRARY_OPTION_IO_COPY_BUFFER_SIZE
+
+// --------------------------------------------------------------------------------------------- //
+//                                            THREAD                                             //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @def EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY
+ * @brief Number of task slots in the deque of every thread pool worker
+ *
+ * When the deque of a worker is full, eya_thread_pool_spawn() runs the task immediately.
+ * Must be a power of two.
+ * Default value is 1024.
+ *
+ * @see eya_thread_pool_spawn()
+ */
+#ifndef EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY
+#    define EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY 1024
+#endif // EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY
+
+/**
+ * @def EYA_LIBRARY_OPTION_THREAD_POOL_TASK_CACHE
+ * @brief Number of finished task records every thread pool worker keeps for reuse
+ *
+ * Cached records let spawning from workers avoid the allocator.
+ * Default value is 256.
+ */
+#ifndef EYA_LIBRARY_OPTION_THREAD_POOL_TASK_CACHE
+#    define EYA_LIBRARY_OPTION_THREAD_POOL_TASK_CACHE 256
+#endif // EYA_LIBRARY_OPTION_THREAD_POOL_TASK_CACHE
+
+/**
+ * @def EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT
+ * @brief Number of spin iterations before a contended lock puts the thread to sleep
+ *
+ * Short critical sections usually end while the waiter spins,
+ * which saves the two system calls of a sleep and a wakeup.
+ * Default value is 128.
+ *
+ * @see eya_thread_lock_lock()
+ * @see eya_thread_rwlock_read_lock()
+ */
+#ifndef EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT
+#    define EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT 128
+#endif // EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT
+
+/**
+ * @def EYA_LIBRARY_OPTION_THREAD_WAIT_SPIN_COUNT
+ * @brief Number of spin iterations before a barrier, latch or event wait puts the thread to sleep
+ *
+ * Phases of data-parallel loops are usually balanced, so the last thread
+ * tends to arrive while the others still spin. Waits are longer than
+ * lock hand-overs, hence the larger budget.
+ * Default value is 1024.
+ *
+ * @see eya_thread_barrier_wait()
+ * @see eya_thread_latch_wait()
+ * @see eya_thread_event_wait()
+ */
+#ifndef EYA_LIBRARY_OPTION_THREAD_WAIT_SPIN_COUNT
+#    define EYA_LIBRARY_OPTION_THREAD_WAIT_SPIN_COUNT 1024
+#endif // EYA_LIBRARY_OPTION_THREAD_WAIT_SPIN_COUNT
+
+// --------------------------------------------------------------------------------------------- //
+//                                        MEMORY PARALLEL                                        //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @def EYA_LIBRARY_OPTION_MEMORY_PARALLEL_THRESHOLD
+ * @brief Smallest buffer in bytes that the parallel memory functions split across a pool
+ *
+ * Smaller buffers are processed by the calling thread, where waking the workers
+ * would cost more than it saves. Streaming stores are only used above this size,
+ * so it should exceed the last-level cache.
+ * Default value is 32 MiB.
+ *
+ * @see eya_memory_parallel_copy()
+ */
+#ifndef EYA_LIBRARY_OPTION_MEMORY_PARALLEL_THRESHOLD
+#    define EYA_LIBRARY_OPTION_MEMORY_PARALLEL_THRESHOLD (32 * 1024 * 1024)
+#endif // EYA_LIBRARY_OPTION_MEMORY_PARALLEL_THRESHOLD
+
+/**
+ * @def EYA_LIBRARY_OPTION_MEMORY_PARALLEL_CHUNK_SIZE
+ * @brief Number of bytes of a chunk processed by one worker at a time
+ *
+ * Must be a multiple of the 4 KiB page size, so that no two workers write to one page.
+ * Default value is 2 MiB.
+ *
+ * @see eya_memory_parallel_copy()
+ */
+#ifndef EYA_LIBRARY_OPTION_MEMORY_PARALLEL_CHUNK_SIZE
+#    define EYA_LIBRARY_OPTION_MEMORY_PARALLEL_CHUNK_SIZE (2 * 1024 * 1024)
+#endif // EYA_LIBRARY_OPTION_MEMORY_PARALLEL_CHUNK_SIZE
+
+// --------------------------------------------------------------------------------------------- //
+//                                          RECLAMATION                                          //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @def EYA_LIBRARY_OPTION_EBR_BATCH_SIZE
+ * @brief Number of retired pointers collected per batch by epoch-based reclamation
+ *
+ * A full batch triggers an attempt to advance the epoch, which scans every record,
+ * and frees the batches that expired. Larger batches make the scan rarer
+ * but keep more memory waiting for reclamation.
+ * Default value is 64.
+ *
+ * @see eya_ebr_retire()
+ */
+#ifndef EYA_LIBRARY_OPTION_EBR_BATCH_SIZE
+#    define EYA_LIBRARY_OPTION_EBR_BATCH_SIZE 64
+#endif // EYA_LIBRARY_OPTION_EBR_BATCH_SIZE
+
+// --------------------------------------------------------------------------------------------- //
+//                                           HASH MAP                                            //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @def EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT
+ * @brief Number of independently locked and resized segments of a concurrent hash map
+ *
+ * More segments let more writers proceed in parallel and make every
+ * resize smaller, at the cost of a fixed amount of memory per map.
+ * Must be a power of two.
+ * Default value is 64.
+ *
+ * @see eya_hash_map_make()
+ */
+#ifndef EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT
+#    define EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT 64
+#endif // EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT
+
+// --------------------------------------------------------------------------------------------- //
+//                                            COUNTER                                            //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @def EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT
+ * @brief Number of per-thread slots of a sharded counter
+ *
+ * Every slot takes one cache line, so a counter takes this many lines plus one.
+ * Slots are given back when their threads exit; threads that start
+ * while all of them are held share an atomically updated slot.
+ * Default value is 64.
+ *
+ * @see eya_counter_add()
+ */
+#ifndef EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT
+#    define EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT 64
+#endif // EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT
+
 #endif // EYA_LIBRARY_OPTION_FALLBACK_H
\ No newline at end of file
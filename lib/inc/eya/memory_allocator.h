@@ -127,6 +127,55 @@ eya_memory_allocator_realloc(const eya_memory_allocator_t *self,
                              eya_usize_t                   old_size,
                              eya_usize_t                   new_size);
 
+/**
+ * @brief Allocates memory whose address is a multiple of the given alignment
+ *
+ * The block is carved out of a larger allocation made with alloc_fn.
+ * The address of that allocation is stored right before the returned pointer,
+ * so the block must be released with eya_memory_allocator_free_aligned().
+ *
+ * @param[in] self Pointer to the memory allocator structure
+ * @param[in] size Size of memory to allocate in bytes
+ * @param[in] align Required alignment in bytes (power of two)
+ * @return Pointer to aligned allocated memory
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is NULL
+ * @throws EYA_RUNTIME_ERROR_ZERO_MEMORY_ALLOCATE
+ *         If size is zero
+ * @throws EYA_RUNTIME_ERROR_NOT_POWER_OF_TWO
+ *         If align is not a power of two
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If size plus the alignment padding does not fit in eya_usize_t
+ * @throws EYA_RUNTIME_ERROR_ALLOCATOR_FUNCTION_NOT_INITIALIZED
+ *         If alloc_fn is NULL
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If allocation fails
+ *
+ * @see eya_memory_allocator_free_aligned()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void *
+eya_memory_allocator_alloc_aligned(const eya_memory_allocator_t *self,
+                                   eya_usize_t                   size,
+                                   eya_usize_t                   align);
+
+/**
+ * @brief Frees memory allocated with eya_memory_allocator_alloc_aligned()
+ * @param[in] self Pointer to the memory allocator structure
+ * @param[in] ptr Pointer returned by eya_memory_allocator_alloc_aligned()
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is NULL
+ * @throws EYA_RUNTIME_ERROR_DEALLOCATOR_FUNCTION_NOT_INITIALIZED
+ *         If dealloc_fn is NULL
+ *
+ * @note Does nothing if ptr is NULL
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_memory_allocator_free_aligned(const eya_memory_allocator_t *self, void *ptr);
+
 EYA_COMPILER(EXTERN_C_END)
 
 #endif // EYA_MEMORY_ALLOCATOR_H
\ No newline at end of file
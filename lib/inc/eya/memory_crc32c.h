@@ -0,0 +1,73 @@
+/**
+ * @file memory_crc32c.h
+ * @brief CRC-32C (Castagnoli) checksums of memory blocks
+ *
+ * The checksum is the one of iSCSI, SCTP, ext4 and most storage formats
+ * (reflected polynomial 0x82F63B78, initial and final value inverted),
+ * so `eya_memory_crc32c(0, "123456789", 9)` returns 0xE3069283.
+ *
+ * The implementation is selected once, when the library is loaded,
+ * from the instruction sets of the CPU:
+ * - x86-64 with SSE4.2 and PCLMULQDQ folds large blocks 64 bytes at a time
+ *   with carry-less multiplications
+ * - x86-64 with SSE4.2 runs the `crc32` instruction over three interleaved
+ *   streams, which hides its latency
+ * - Other CPUs use slicing-by-8 tables
+ *
+ * All of them produce the same values.
+ *
+ * @code
+ * eya_uint_t crc = 0;
+ * while (read_block(&block))
+ *     crc = eya_memory_crc32c(crc, block.data, block.size);
+ * @endcode
+ */
+
+#ifndef EYA_MEMORY_CRC32C_H
+#define EYA_MEMORY_CRC32C_H
+
+#include "numeric_types.h"
+#include "attribute.h"
+#include "size.h"
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Extends a CRC-32C checksum with a block of bytes
+ * @param[in] crc Checksum of the preceding bytes (0 for the first block)
+ * @param[in] data Pointer to the bytes (may be nullptr if size is 0)
+ * @param[in] size Number of bytes
+ * @return Checksum of the preceding bytes followed by the block
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If data is nullptr and size is not zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_uint_t
+eya_memory_crc32c(eya_uint_t crc, const void *data, eya_usize_t size);
+
+/**
+ * @brief Computes the checksum of two concatenated blocks from their checksums
+ * @param[in] crc1 Checksum of the first block
+ * @param[in] crc2 Checksum of the second block
+ * @param[in] size2 Size of the second block in bytes
+ * @return Checksum of the first block followed by the second one
+ *
+ * Blocks checksummed in parallel are combined in O(log size2) time,
+ * without reading them again.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_uint_t
+eya_memory_crc32c_combine(eya_uint_t crc1, eya_uint_t crc2, eya_ullong_t size2);
+
+/**
+ * @brief Returns the name of the implementation selected for this CPU
+ * @return "pclmul", "sse4.2" or "slice8"
+ */
+EYA_ATTRIBUTE(SYMBOL)
+const char *
+eya_memory_crc32c_get_impl(void);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_MEMORY_CRC32C_H
\ No newline at end of file
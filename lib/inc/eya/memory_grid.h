@@ -0,0 +1,154 @@
+/**
+ * @file memory_grid.h
+ * @brief Two-dimensional views with row pitch, copy and transpose
+ *
+ * A grid view describes `rows * cols` elements of `element_size` bytes
+ * stored row by row, where the start of each row is `row_pitch` bytes
+ * after the start of the previous one. Padding between rows is allowed,
+ * so sub-rectangles of larger grids and aligned image-like buffers can be described.
+ *
+ * The header provides:
+ * - Element access and row or column extraction as strided views
+ * - Row-wise copy between grids of the same shape
+ * - Cache-blocked transpose, which turns row-major records into columns
+ *
+ * The transpose walks the grids in square tiles so that both the source rows
+ * and the destination rows of a tile stay in the cache.
+ * On x86 targets with SSE2, tiles of 4 and 8 byte elements
+ * are transposed in 4x4 and 2x2 register blocks.
+ *
+ * @note The view does not own the memory it describes.
+ *
+ * @see memory_strided.h
+ */
+
+#ifndef EYA_MEMORY_GRID_H
+#define EYA_MEMORY_GRID_H
+
+#include "memory_strided.h"
+
+/**
+ * @struct eya_memory_grid
+ * @brief Description of a row-major matrix of equally sized elements
+ */
+typedef struct eya_memory_grid
+{
+    void       *base;         /**< Address of the element in row 0, column 0 */
+    eya_usize_t element_size; /**< Size of every element in bytes */
+    eya_usize_t rows;         /**< Number of rows */
+    eya_usize_t cols;         /**< Number of elements in every row */
+    eya_usize_t row_pitch;    /**< Distance between the starts of neighbouring rows in bytes */
+} eya_memory_grid_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Creates a grid view
+ * @param[in] base Address of the first element
+ * @param[in] element_size Size of every element in bytes
+ * @param[in] rows Number of rows
+ * @param[in] cols Number of columns
+ * @param[in] row_pitch Distance between rows in bytes (at least `cols * element_size`)
+ * @return Grid view
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If base is nullptr
+ * @throws EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE
+ *         If element_size is zero
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If row_pitch is smaller than a row
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If the spanned bytes do not fit in eya_usize_t
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_memory_grid_t
+eya_memory_grid_make(void       *base,
+                     eya_usize_t element_size,
+                     eya_usize_t rows,
+                     eya_usize_t cols,
+                     eya_usize_t row_pitch);
+
+/**
+ * @brief Returns the address of an element
+ * @param[in] self Pointer to the grid
+ * @param[in] row Row index
+ * @param[in] col Column index
+ * @return Address of the element
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If row or col is outside the grid
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void *
+eya_memory_grid_at(const eya_memory_grid_t *self, eya_usize_t row, eya_usize_t col);
+
+/**
+ * @brief Returns one row as a dense strided view
+ * @param[in] self Pointer to the grid
+ * @param[in] row Row index
+ * @return View of the row
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If row is outside the grid
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_memory_strided_t
+eya_memory_grid_row(const eya_memory_grid_t *self, eya_usize_t row);
+
+/**
+ * @brief Returns one column as a strided view with the row pitch as stride
+ * @param[in] self Pointer to the grid
+ * @param[in] col Column index
+ * @return View of the column
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If col is outside the grid
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_memory_strided_t
+eya_memory_grid_column(const eya_memory_grid_t *self, eya_usize_t col);
+
+/**
+ * @brief Copies all elements of a grid into a grid of the same shape
+ * @param[in] self Pointer to the destination grid
+ * @param[in] other Pointer to the source grid
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or other is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the grids differ in element size, rows or columns
+ *
+ * @warning The grids must not overlap.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_memory_grid_copy(const eya_memory_grid_t *self, const eya_memory_grid_t *other);
+
+/**
+ * @brief Writes the transpose of a grid
+ *
+ * Element (r, c) of the source becomes element (c, r) of the destination.
+ *
+ * @param[in] self Pointer to the destination grid (`other->cols` rows, `other->rows` columns)
+ * @param[in] other Pointer to the source grid
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or other is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the element sizes differ or the shapes do not match
+ *
+ * @warning The grids must not overlap; in-place transposition is not supported.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_memory_grid_transpose(const eya_memory_grid_t *self, const eya_memory_grid_t *other);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_MEMORY_GRID_H
\ No newline at end of file
@@ -0,0 +1,86 @@
+/**
+ * @file memory_parallel.h
+ * @brief Copy, fill and comparison of huge buffers on a thread pool
+ *
+ * A single core cannot saturate the memory bandwidth of a large machine,
+ * so buffers of at least @ref EYA_LIBRARY_OPTION_MEMORY_PARALLEL_THRESHOLD bytes
+ * are split into chunks that the pool workers process in parallel:
+ * - Chunk boundaries fall on page boundaries of the destination (of `lhs` for
+ *   comparisons), so no two workers write to the same page
+ * - Copies and fills use non-temporal stores on SSE2 targets, which bypass
+ *   the caches instead of evicting the working set of other threads
+ *   with data that will not be read again soon
+ *
+ * Smaller buffers are processed by the calling thread with the `memory_std.h` functions,
+ * where the cost of waking workers would outweigh the gain.
+ *
+ * Typical usage:
+ * @code
+ * eya_memory_parallel_copy(pool, snapshot, table, table_size);
+ * eya_memory_parallel_set(pool, arena, 0, arena_size);
+ * @endcode
+ *
+ * @see memory_std.h
+ * @see thread_pool.h
+ */
+
+#ifndef EYA_MEMORY_PARALLEL_H
+#define EYA_MEMORY_PARALLEL_H
+
+#include "thread_pool.h"
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Copies a buffer, in parallel if it is large
+ * @param[in] pool Pool whose workers process the chunks
+ * @param[out] dst Destination buffer
+ * @param[in] src Source buffer, not overlapping the destination
+ * @param[in] n Number of bytes
+ * @return Pointer past the last written byte of `dst`
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If pool, dst or src is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void *
+eya_memory_parallel_copy(eya_thread_pool_t *pool, void *dst, const void *src, eya_usize_t n);
+
+/**
+ * @brief Fills a buffer with a byte, in parallel if it is large
+ * @param[in] pool Pool whose workers process the chunks
+ * @param[out] dst Destination buffer
+ * @param[in] val Byte to store
+ * @param[in] n Number of bytes
+ * @return Pointer past the last written byte of `dst`
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If pool or dst is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void *
+eya_memory_parallel_set(eya_thread_pool_t *pool, void *dst, eya_uchar_t val, eya_usize_t n);
+
+/**
+ * @brief Compares two buffers, in parallel if they are large
+ * @param[in] pool Pool whose workers process the chunks
+ * @param[in] lhs First buffer
+ * @param[in] rhs Second buffer
+ * @param[in] n Number of bytes
+ * @return Pointer to the first byte of `lhs` that differs, or nullptr if the buffers are equal
+ *
+ * Chunks past a difference that was already found are skipped.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If pool, lhs or rhs is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+const void *
+eya_memory_parallel_compare(eya_thread_pool_t *pool,
+                            const void        *lhs,
+                            const void        *rhs,
+                            eya_usize_t        n);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_MEMORY_PARALLEL_H
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+ * @file memory_strided.h
+ * @brief Strided views over equally sized elements
+ *
+ * A strided view describes `count` elements of `element_size` bytes
+ * whose starts are `stride` bytes apart, for example one field of an array of records
+ * or one column of a row-major matrix.
+ *
+ * The header provides:
+ * - Element access with bounds checking
+ * - Gather: copying a strided view into a dense range
+ * - Scatter: copying a dense range into a strided view
+ * - Copying between two strided views
+ *
+ * Copies of 1, 2, 4, 8 and 16 byte elements use fixed-size moves,
+ * and dense views fall back to a single block copy.
+ *
+ * @note The view does not own the memory it describes.
+ *
+ * @see memory_grid.h
+ * @see memory_typed.h
+ */
+
+#ifndef EYA_MEMORY_STRIDED_H
+#define EYA_MEMORY_STRIDED_H
+
+#include "memory_range.h"
+
+/**
+ * @struct eya_memory_strided
+ * @brief Description of equally spaced elements
+ *
+ * The view spans `(count - 1) * stride + element_size` bytes starting at `base`.
+ * The stride is at least the element size, so elements never overlap.
+ */
+typedef struct eya_memory_strided
+{
+    void       *base;         /**< Address of the first element */
+    eya_usize_t element_size; /**< Size of every element in bytes */
+    eya_usize_t stride;       /**< Distance between the starts of neighbouring elements */
+    eya_usize_t count;        /**< Number of elements */
+} eya_memory_strided_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Creates a strided view
+ * @param[in] base Address of the first element
+ * @param[in] element_size Size of every element in bytes
+ * @param[in] stride Distance between neighbouring elements in bytes
+ * @param[in] count Number of elements
+ * @return Strided view
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If base is nullptr
+ * @throws EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE
+ *         If element_size is zero
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If stride is smaller than element_size
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If the spanned bytes do not fit in eya_usize_t
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_memory_strided_t
+eya_memory_strided_make(void       *base,
+                        eya_usize_t element_size,
+                        eya_usize_t stride,
+                        eya_usize_t count);
+
+/**
+ * @brief Creates a dense strided view of a range
+ * @param[in] range Range whose size is a multiple of element_size
+ * @param[in] element_size Size of every element in bytes
+ * @return View with the stride equal to the element size
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If range is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If range is invalid or empty
+ * @throws EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE
+ *         If element_size is zero
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the range size is not a multiple of element_size
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_memory_strided_t
+eya_memory_strided_make_dense(const eya_memory_range_t *range, eya_usize_t element_size);
+
+/**
+ * @brief Tells whether the elements follow each other without gaps
+ * @param[in] self Pointer to the view
+ * @return true if the stride equals the element size
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_memory_strided_is_dense(const eya_memory_strided_t *self);
+
+/**
+ * @brief Returns the number of bytes the elements occupy without gaps
+ * @param[in] self Pointer to the view
+ * @return `count * element_size`
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_memory_strided_get_packed_size(const eya_memory_strided_t *self);
+
+/**
+ * @brief Returns the address of an element
+ * @param[in] self Pointer to the view
+ * @param[in] index Index of the element
+ * @return Address of the element
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If index is not less than the element count
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void *
+eya_memory_strided_at(const eya_memory_strided_t *self, eya_usize_t index);
+
+/**
+ * @brief Copies the elements of a view into a dense range
+ * @param[in] self Pointer to the source view
+ * @param[out] dst Destination range of at least the packed size
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or dst is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If dst is invalid
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If dst is smaller than the packed size
+ *
+ * @see eya_memory_strided_get_packed_size()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_memory_strided_gather(const eya_memory_strided_t *self, eya_memory_range_t *dst);
+
+/**
+ * @brief Copies a dense range into the elements of a view
+ * @param[in] self Pointer to the destination view
+ * @param[in] src Source range of at least the packed size
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If src is invalid
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If src is smaller than the packed size
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_memory_strided_scatter(const eya_memory_strided_t *self, const eya_memory_range_t *src);
+
+/**
+ * @brief Copies the elements of one view into another
+ * @param[in] self Pointer to the destination view
+ * @param[in] other Pointer to the source view
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or other is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the views differ in element size or count
+ *
+ * @warning The views must not overlap.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_memory_strided_copy(const eya_memory_strided_t *self, const eya_memory_strided_t *other);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_MEMORY_STRIDED_H
\ No newline at end of file
@@ -77,6 +77,24 @@ EYA_ATTRIBUTE(SYMBOL)
 eya_usize_t
 eya_memory_typed_get_element_size(const eya_memory_typed_t *self);
 
+/**
+ * @brief Precomputes the reciprocal of the element size
+ *
+ * Element counts of the range are then obtained with a multiplication
+ * and a shift instead of a division. Does nothing if the reciprocal
+ * already matches the element size or the element size is zero.
+ *
+ * @param[in,out] self Pointer to typed memory range structure
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         if self is nullptr
+ *
+ * @see divider.h
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_memory_typed_update_divider(eya_memory_typed_t *self);
+
 /**
  * @brief Check if a typed memory range is valid
  * @param[in] self Pointer to typed memory range structure
@@ -17,15 +17,18 @@
 #ifndef EYA_MEMORY_TYPED_FIELDS_H
 #define EYA_MEMORY_TYPED_FIELDS_H
 
+#include "divider.h"
 #include "size.h"
 
 /**
  * @def eya_memory_typed_fields(T)
  * @brief Generates typed memory range fields with element size information
  *
- * This macro expands to two fields representing a typed memory range structure:
+ * This macro expands to three fields representing a typed memory range structure:
  * - A range field containing begin/end pointers of specified type
  * - An element size field indicating the size of individual elements
+ * - A divider holding the reciprocal of the element size, so element counts
+ *   are computed without a hardware divide
  *
  * @tparam T Type of elements in the memory range (must match range pointer types)
  *
@@ -43,10 +46,15 @@
  *       - (range.end - range.begin) must be divisible by element_size
  *       - Type T must match the pointer types of the range
  *
+ * @note The divider is used only while its divisor equals element_size,
+ *       so initializers may leave it zero-filled and code that assigns
+ *       element_size directly stays correct, falling back to a division.
+ *
  * @see eya_memory_range_fields() for untyped version
  */
 #define eya_memory_typed_fields(T)                                                                 \
-    T           range; /**< Memory range structure (type: @c T) containing begin/end pointers */   \
-    eya_usize_t element_size /**< Size in bytes of each element (type: @c eya_usize_t) */
+    T             range;          /**< Memory range structure (type: @c T) with begin/end */       \
+    eya_usize_t   element_size;   /**< Size in bytes of each element (type: @c eya_usize_t) */     \
+    eya_divider_t element_divider /**< Reciprocal of element_size (see eya_divider_t) */
 
-#endif // EYA_MEMORY_TYPED_FIELDS_H
+#endif // EYA_MEMORY_TYPED_FIELDS_H
\ No newline at end of file
@@ -0,0 +1,248 @@
+/**
+ * @file mpmc_queue.h
+ * @brief Bounded queue for many producers and many consumers
+ *
+ * The queue is an array of cells of power-of-two length, each holding
+ * a sequence number followed by one element of a fixed size stored inline.
+ * The sequence number tells whether the cell is free for the producer
+ * of a given position or holds the element for the consumer of that position,
+ * so producers and consumers claim positions with a single compare-and-swap
+ * on their own counter and never lock.
+ *
+ * The header provides:
+ * - Non-blocking `try` operations that fail on a full or empty queue
+ * - Blocking operations that sleep on a futex until room or elements appear
+ * - Batch operations that claim several consecutive positions at once
+ *
+ * The cells are allocated with the runtime allocator.
+ *
+ * Typical usage:
+ * @code
+ * eya_mpmc_queue_t queue;
+ * eya_mpmc_queue_init(&queue, 256, sizeof(job_t));
+ *
+ * eya_mpmc_queue_push(&queue, &job); // any producer thread
+ * eya_mpmc_queue_pop(&queue, &job);  // any consumer thread
+ *
+ * eya_mpmc_queue_destroy(&queue);
+ * @endcode
+ *
+ * @see spsc_queue.h
+ * @see thread_futex.h
+ */
+
+#ifndef EYA_MPMC_QUEUE_H
+#define EYA_MPMC_QUEUE_H
+
+#include "allocated_range.h"
+#include "atomic.h"
+
+/**
+ * @struct eya_mpmc_queue
+ * @brief Multi-producer multi-consumer bounded queue
+ *
+ * @note The fields are managed by the queue functions
+ *       and must not be modified directly.
+ */
+typedef struct eya_mpmc_queue
+{
+    eya_allocated_range_t cells;        /**< Cells aligned to a cache line */
+    eya_usize_t           mask;         /**< Capacity minus one */
+    eya_usize_t           cell_size;    /**< Distance between neighbouring cells in bytes */
+    eya_usize_t           element_size; /**< Size of every element in bytes */
+    eya_uchar_t           pad0[EYA_ATOMIC_CACHE_LINE_SIZE];
+
+    eya_atomic_usize_t enqueue_pos; /**< Next position claimed by a producer */
+    eya_uchar_t        pad1[EYA_ATOMIC_CACHE_LINE_SIZE];
+
+    eya_atomic_usize_t dequeue_pos; /**< Next position claimed by a consumer */
+    eya_uchar_t        pad2[EYA_ATOMIC_CACHE_LINE_SIZE];
+
+    eya_atomic_uint_t not_full;     /**< Futex word of producers, bumped when cells are freed */
+    eya_atomic_uint_t not_empty;    /**< Futex word of consumers, bumped on new elements */
+    eya_atomic_uint_t push_waiters; /**< Number of producers sleeping on `not_full` */
+    eya_atomic_uint_t pop_waiters;  /**< Number of consumers sleeping on `not_empty` */
+} eya_mpmc_queue_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes an empty queue
+ * @param[out] self Pointer to the queue
+ * @param[in] capacity Number of cells (must be a power of two, at least 2)
+ * @param[in] element_size Size of every element in bytes
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_NOT_POWER_OF_TWO
+ *         If capacity is not a power of two
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If capacity is less than 2
+ * @throws EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE
+ *         If element_size is zero
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If the cells in bytes do not fit in eya_usize_t
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the cells could not be allocated
+ *
+ * @see eya_mpmc_queue_destroy()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_mpmc_queue_init(eya_mpmc_queue_t *self, eya_usize_t capacity, eya_usize_t element_size);
+
+/**
+ * @brief Releases the cells of a queue
+ * @param[in,out] self Pointer to the queue
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ *
+ * @warning No thread may use or wait on the queue during or after the call.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_mpmc_queue_destroy(eya_mpmc_queue_t *self);
+
+/**
+ * @brief Returns the number of cells
+ * @param[in] self Pointer to the queue
+ * @return Capacity given at initialization
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_mpmc_queue_get_capacity(const eya_mpmc_queue_t *self);
+
+/**
+ * @brief Returns the approximate number of queued elements
+ * @param[in] self Pointer to the queue
+ * @return Number of claimed positions not yet consumed, at most the capacity
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_mpmc_queue_get_size(const eya_mpmc_queue_t *self);
+
+/**
+ * @brief Appends one element if there is a free cell
+ * @param[in,out] self Pointer to the queue
+ * @param[in] element Pointer to `element_size` bytes to copy
+ * @return true if the element was queued, false if the queue is full
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or element is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_mpmc_queue_try_push(eya_mpmc_queue_t *self, const void *element);
+
+/**
+ * @brief Removes the oldest element if there is any
+ * @param[in,out] self Pointer to the queue
+ * @param[out] element Pointer to `element_size` bytes receiving the element
+ * @return true if an element was removed, false if the queue is empty
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or element is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_mpmc_queue_try_pop(eya_mpmc_queue_t *self, void *element);
+
+/**
+ * @brief Appends one element, sleeping while the queue is full
+ * @param[in,out] self Pointer to the queue
+ * @param[in] element Pointer to `element_size` bytes to copy
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or element is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_mpmc_queue_push(eya_mpmc_queue_t *self, const void *element);
+
+/**
+ * @brief Removes the oldest element, sleeping while the queue is empty
+ * @param[in,out] self Pointer to the queue
+ * @param[out] element Pointer to `element_size` bytes receiving the element
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or element is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_mpmc_queue_pop(eya_mpmc_queue_t *self, void *element);
+
+/**
+ * @brief Appends as many of the given elements as there are free consecutive cells
+ *
+ * The elements occupy consecutive positions, so consumers see them in order
+ * and not interleaved with elements of other producers.
+ *
+ * @param[in,out] self Pointer to the queue
+ * @param[in] elements Pointer to `count` packed elements
+ * @param[in] count Number of elements to append
+ * @return Number of elements appended, from 0 to count
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr, or elements is nullptr with a nonzero count
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_mpmc_queue_try_push_batch(eya_mpmc_queue_t *self, const void *elements, eya_usize_t count);
+
+/**
+ * @brief Removes up to the given number of the oldest elements
+ * @param[in,out] self Pointer to the queue
+ * @param[out] elements Pointer to room for `count` packed elements
+ * @param[in] count Largest number of elements to remove
+ * @return Number of elements removed, from 0 to count
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr, or elements is nullptr with a nonzero count
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_mpmc_queue_try_pop_batch(eya_mpmc_queue_t *self, void *elements, eya_usize_t count);
+
+/**
+ * @brief Appends all given elements, sleeping whenever the queue is full
+ *
+ * The elements are appended in order, in one or more batches.
+ *
+ * @param[in,out] self Pointer to the queue
+ * @param[in] elements Pointer to `count` packed elements
+ * @param[in] count Number of elements to append
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr, or elements is nullptr with a nonzero count
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_mpmc_queue_push_batch(eya_mpmc_queue_t *self, const void *elements, eya_usize_t count);
+
+/**
+ * @brief Removes at least one and up to the given number of elements,
+ *        sleeping while the queue is empty
+ * @param[in,out] self Pointer to the queue
+ * @param[out] elements Pointer to room for `count` packed elements
+ * @param[in] count Largest number of elements to remove (must be nonzero)
+ * @return Number of elements removed, from 1 to count
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or elements is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If count is zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_mpmc_queue_pop_batch(eya_mpmc_queue_t *self, void *elements, eya_usize_t count);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_MPMC_QUEUE_H
\ No newline at end of file
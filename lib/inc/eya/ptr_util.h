@@ -258,7 +258,7 @@
  * @see eya_addr_align_up()
  */
 #define eya_ptr_align_up(T, ptr, align)                                                            \
-    eya_add_to_ptr(T, eya_addr_align_up(eya_ptr_to_uaddr(ptr), align))
+    eya_addr_to_ptr(T, eya_addr_align_up(eya_ptr_to_uaddr(ptr), align))
 
 /**
  * @def eya_ptr_align_down(ptr, align)
@@ -270,6 +270,6 @@
  * @see eya_addr_align_down()
  */
 #define eya_ptr_align_down(ptr, align)                                                             \
-    eya_add_to_ptr(T, eya_addr_align_down(eya_ptr_to_uaddr(ptr), align))
+    eya_addr_to_ptr(void, eya_addr_align_down(eya_ptr_to_uaddr(ptr), align))
 
 #endif // EYA_PTR_UTIL_H
@@ -168,7 +168,42 @@ enum
      * Indicates that the memory deallocator function
      * has not been initialized before use.
      */
-    EYA_RUNTIME_ERROR_DEALLOCATOR_FUNCTION_NOT_INITIALIZED
+    EYA_RUNTIME_ERROR_DEALLOCATOR_FUNCTION_NOT_INITIALIZED,
+
+    /**
+     * @var EYA_RUNTIME_ERROR_THREAD_NOT_CREATED
+     * @brief Thread creation failure error.
+     *
+     * Indicates that the operating system refused
+     * to start a new thread of execution.
+     */
+    EYA_RUNTIME_ERROR_THREAD_NOT_CREATED,
+
+    /**
+     * @var EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED
+     * @brief Operating system call failure error.
+     *
+     * Indicates that a request to the operating system
+     * (file, memory mapping or I/O interface) was rejected.
+     */
+    EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED,
+
+    /**
+     * @var EYA_RUNTIME_ERROR_NOT_SUPPORTED
+     * @brief Unsupported operation error.
+     *
+     * Indicates that the requested facility is not available
+     * on the target platform or was not enabled by the running kernel.
+     */
+    EYA_RUNTIME_ERROR_NOT_SUPPORTED,
+
+    /**
+     * @var EYA_RUNTIME_ERROR_RESOURCE_EXHAUSTED
+     * @brief Resource exhaustion error.
+     *
+     * Indicates that a fixed-capacity pool has no free element left.
+     */
+    EYA_RUNTIME_ERROR_RESOURCE_EXHAUSTED
 };
 
 /**
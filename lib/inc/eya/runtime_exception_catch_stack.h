@@ -140,6 +140,22 @@ eya_runtime_exception_catch_stack_prev(void);
 eya_exception_catch_t *
 eya_runtime_exception_catch_stack_push(eya_exception_catch_t *e);
 
+/**
+ * @brief Resets handler stack of the calling thread to its initial state
+ *
+ * Points the current exception pointer (`m_runtime_exception`)
+ * at the start of the thread's frame array (`m_runtime_exceptions`).
+ *
+ * @note Invoked automatically for the main thread before `main()`.
+ *       Every other thread must call it once before its first try block,
+ *       which `eya_thread_create()` does on behalf of the new thread.
+ * @warning Discards all registered handlers of the calling thread
+ *
+ * @see eya_thread_create()
+ */
+void
+eya_runtime_exception_catch_stack_reset(void);
+
 /**
  * @brief Throws exception and transfers control to nearest handler
  *
@@ -0,0 +1,199 @@
+/**
+ * @file shared_range.h
+ * @brief Reference-counted memory ranges with copy-on-write semantics
+ *
+ * A shared range is a handle to a heap block that can be owned by many handles at once:
+ * - Sharing a handle only increments an atomic reference counter
+ * - Slicing produces a handle that views a part of the same block
+ * - Requesting write access copies the viewed bytes into a private block
+ *   if, and only if, other handles still reference the current one
+ *
+ * Example:
+ * @code
+ * eya_shared_range_t payload = eya_shared_range_make_copy(&source);
+ * eya_shared_range_t header  = eya_shared_range_slice(&payload, 0, 64);  // no copy
+ *
+ * eya_memory_range_t *dst = eya_shared_range_make_writable(&header);     // copies 64 bytes
+ * eya_memory_range_set(dst, 0);
+ *
+ * eya_shared_range_release(&header);
+ * eya_shared_range_release(&payload);
+ * @endcode
+ *
+ * @note Different handles to the same block can be used and released
+ *       from different threads concurrently.
+ *       A single handle object must not be modified concurrently.
+ *
+ * @see memory_range.h
+ * @see runtime_allocator.h
+ */
+
+#ifndef EYA_SHARED_RANGE_H
+#define EYA_SHARED_RANGE_H
+
+#include "memory_range.h"
+
+/**
+ * @struct eya_shared_range_block
+ * @brief Opaque heap block holding the reference counter and the bytes
+ */
+struct eya_shared_range_block;
+
+/**
+ * @struct eya_shared_range
+ * @brief Handle to a shared block and the part of it this handle views
+ */
+typedef struct eya_shared_range
+{
+    struct eya_shared_range_block *block; /**< Referenced block or nullptr */
+    eya_memory_range_t             range; /**< Viewed bytes inside the block */
+} eya_shared_range_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Allocates a new block with one owner
+ * @param[in] size Number of bytes (must be non-zero)
+ * @return Handle viewing the whole uninitialized block
+ *
+ * @throws EYA_RUNTIME_ERROR_ZERO_MEMORY_ALLOCATE
+ *         If size is zero
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If size plus the block header does not fit in eya_usize_t
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If memory allocation fails
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_shared_range_t
+eya_shared_range_make(eya_usize_t size);
+
+/**
+ * @brief Allocates a new block with one owner and fills it from a range
+ * @param[in] source Range with the initial content (must have data)
+ * @return Handle viewing the whole block
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If source is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If source is invalid or empty
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If memory allocation fails
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_shared_range_t
+eya_shared_range_make_copy(const eya_memory_range_t *source);
+
+/**
+ * @brief Creates another owner of the same block
+ * @param[in] self Pointer to the handle
+ * @return Handle viewing the same bytes
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or its block is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_shared_range_t
+eya_shared_range_share(const eya_shared_range_t *self);
+
+/**
+ * @brief Creates an owner of the same block that views a part of this handle's bytes
+ * @param[in] self Pointer to the handle
+ * @param[in] offset Start of the slice relative to the viewed bytes
+ * @param[in] size Size of the slice (non-zero, may reach the end of the view)
+ * @return Handle viewing the slice
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or its block is nullptr
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the slice is empty or exceeds the viewed bytes
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_shared_range_t
+eya_shared_range_slice(const eya_shared_range_t *self, eya_uoffset_t offset, eya_usize_t size);
+
+/**
+ * @brief Drops this owner and frees the block after the last one
+ * @param[in,out] self Pointer to the handle (a released handle is ignored)
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_shared_range_release(eya_shared_range_t *self);
+
+/**
+ * @brief Returns the bytes viewed by the handle for reading
+ * @param[in] self Pointer to the handle
+ * @return Pointer to the viewed range
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ *
+ * @warning The bytes must not be modified through this range.
+ *          Use eya_shared_range_make_writable() instead.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+const eya_memory_range_t *
+eya_shared_range_get_range(const eya_shared_range_t *self);
+
+/**
+ * @brief Returns the number of bytes viewed by the handle
+ * @param[in] self Pointer to the handle
+ * @return Size of the viewed range
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_shared_range_get_size(const eya_shared_range_t *self);
+
+/**
+ * @brief Returns the number of handles referencing the block
+ * @param[in] self Pointer to the handle
+ * @return Reference count, or zero for a released handle
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ *
+ * @note With concurrent owners the value may be outdated when it is returned.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_shared_range_get_use_count(const eya_shared_range_t *self);
+
+/**
+ * @brief Tells whether the handle is the only owner of its block
+ * @param[in] self Pointer to the handle
+ * @return true if no other handle references the block
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_shared_range_is_unique(const eya_shared_range_t *self);
+
+/**
+ * @brief Returns the viewed bytes for writing, detaching from other owners first
+ *
+ * If other handles reference the block, the viewed bytes are copied
+ * into a new block owned only by this handle and the old block is released.
+ * Otherwise the bytes are returned in place.
+ *
+ * @param[in,out] self Pointer to the handle
+ * @return Pointer to the writable range, valid until the handle is modified
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or its block is nullptr
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the private copy could not be allocated
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_memory_range_t *
+eya_shared_range_make_writable(eya_shared_range_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_SHARED_RANGE_H
\ No newline at end of file
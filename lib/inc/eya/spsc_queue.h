@@ -0,0 +1,193 @@
+/**
+ * @file spsc_queue.h
+ * @brief Lock-free bounded queue for one producer and one consumer
+ *
+ * The queue stores elements of a fixed size inline in a ring of
+ * power-of-two capacity, allocated on a cache line boundary.
+ *
+ * The producer owns the tail index and the consumer owns the head index.
+ * Each side keeps a private copy of the other side's index and rereads
+ * the shared one only when the copy says the ring is full or empty,
+ * so in steady state a handoff touches no cache line written by the other side.
+ * The indices and their copies are placed on separate cache lines.
+ *
+ * Bulk operations move up to N elements and publish them with one index store.
+ *
+ * Typical usage:
+ * @code
+ * eya_spsc_queue_t queue;
+ * eya_spsc_queue_init(&queue, 1024, sizeof(packet_t));
+ *
+ * // producer thread
+ * while (!eya_spsc_queue_try_push(&queue, &packet)) {}
+ *
+ * // consumer thread
+ * if (eya_spsc_queue_try_pop(&queue, &packet)) process(&packet);
+ *
+ * eya_spsc_queue_destroy(&queue);
+ * @endcode
+ *
+ * @warning At most one thread may push and at most one thread may pop at a time.
+ */
+
+#ifndef EYA_SPSC_QUEUE_H
+#define EYA_SPSC_QUEUE_H
+
+#include "allocated_array.h"
+#include "atomic.h"
+
+/**
+ * @struct eya_spsc_queue
+ * @brief Single-producer single-consumer ring queue
+ *
+ * @note The fields are managed by the queue functions
+ *       and must not be modified directly.
+ */
+typedef struct eya_spsc_queue
+{
+    eya_allocated_array_t buffer; /**< Ring slots aligned to a cache line */
+    eya_usize_t           mask;   /**< Capacity minus one */
+    eya_uchar_t           pad0[EYA_ATOMIC_CACHE_LINE_SIZE];
+
+    eya_atomic_usize_t tail;       /**< Next slot to write, published by the producer */
+    eya_usize_t        head_cache; /**< Producer's last seen head */
+    eya_uchar_t        pad1[EYA_ATOMIC_CACHE_LINE_SIZE];
+
+    eya_atomic_usize_t head;       /**< Next slot to read, published by the consumer */
+    eya_usize_t        tail_cache; /**< Consumer's last seen tail */
+    eya_uchar_t        pad2[EYA_ATOMIC_CACHE_LINE_SIZE];
+} eya_spsc_queue_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes an empty queue
+ * @param[out] self Pointer to the queue
+ * @param[in] capacity Number of slots (must be a power of two)
+ * @param[in] element_size Size of every element in bytes
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_NOT_POWER_OF_TWO
+ *         If capacity is not a power of two
+ * @throws EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE
+ *         If element_size is zero
+ * @throws EYA_RUNTIME_ERROR_OVERFLOW
+ *         If the ring size in bytes does not fit in eya_usize_t
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the ring could not be allocated
+ *
+ * @see eya_spsc_queue_destroy()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_spsc_queue_init(eya_spsc_queue_t *self, eya_usize_t capacity, eya_usize_t element_size);
+
+/**
+ * @brief Releases the ring of a queue
+ * @param[in,out] self Pointer to the queue
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ *
+ * @warning Neither side may use the queue during or after the call.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_spsc_queue_destroy(eya_spsc_queue_t *self);
+
+/**
+ * @brief Returns the number of slots
+ * @param[in] self Pointer to the queue
+ * @return Capacity given at initialization
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_spsc_queue_get_capacity(const eya_spsc_queue_t *self);
+
+/**
+ * @brief Returns the number of queued elements
+ * @param[in] self Pointer to the queue
+ * @return Number of elements; may be stale when called while the other side is active
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_spsc_queue_get_size(const eya_spsc_queue_t *self);
+
+/**
+ * @brief Appends one element if there is a free slot
+ * @param[in,out] self Pointer to the queue
+ * @param[in] element Pointer to `element_size` bytes to copy
+ * @return true if the element was queued, false if the queue is full
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or element is nullptr
+ *
+ * @note Must be called only by the producer.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_spsc_queue_try_push(eya_spsc_queue_t *self, const void *element);
+
+/**
+ * @brief Removes the oldest element if there is any
+ * @param[in,out] self Pointer to the queue
+ * @param[out] element Pointer to `element_size` bytes receiving the element
+ * @return true if an element was removed, false if the queue is empty
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or element is nullptr
+ *
+ * @note Must be called only by the consumer.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_spsc_queue_try_pop(eya_spsc_queue_t *self, void *element);
+
+/**
+ * @brief Appends as many of the given elements as fit
+ *
+ * All appended elements become visible to the consumer at once.
+ *
+ * @param[in,out] self Pointer to the queue
+ * @param[in] elements Pointer to `count` packed elements
+ * @param[in] count Number of elements to append
+ * @return Number of elements appended, from 0 to count
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr, or elements is nullptr with a nonzero count
+ *
+ * @note Must be called only by the producer.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_spsc_queue_push_bulk(eya_spsc_queue_t *self, const void *elements, eya_usize_t count);
+
+/**
+ * @brief Removes up to the given number of the oldest elements
+ *
+ * All removed slots are handed back to the producer at once.
+ *
+ * @param[in,out] self Pointer to the queue
+ * @param[out] elements Pointer to room for `count` packed elements
+ * @param[in] count Largest number of elements to remove
+ * @return Number of elements removed, from 0 to count
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr, or elements is nullptr with a nonzero count
+ *
+ * @note Must be called only by the consumer.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_spsc_queue_pop_bulk(eya_spsc_queue_t *self, void *elements, eya_usize_t count);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_SPSC_QUEUE_H
\ No newline at end of file
@@ -0,0 +1,189 @@
+/**
+ * @file task_graph.h
+ * @brief Dependency graph of tasks run over a batch of chunks
+ *
+ * A batch job such as parse → transform → aggregate is described once as a graph:
+ * - Every node is a function called for each chunk of the batch
+ * - A dependency makes a node wait until the same chunk has passed through another node
+ * - A serial node additionally processes the chunks in order, one at a time,
+ *   for stages that keep state between chunks
+ *
+ * Running the graph pipelines the chunks through it on a thread pool:
+ * every node instance whose dependencies are done is spawned right away,
+ * so different stages work on different chunks at the same time.
+ * At most `in_flight` chunks are started and not yet finished,
+ * which bounds the memory held by intermediate results.
+ *
+ * Every node accumulates the number of its calls and the time spent in them
+ * during the last run, so slow stages of a pipeline are easy to spot.
+ *
+ * @code
+ * eya_task_graph_t *graph = eya_task_graph_make(nullptr);
+ *
+ * eya_usize_t parse     = eya_task_graph_add(graph, parse_fn, &batch);
+ * eya_usize_t transform = eya_task_graph_add(graph, transform_fn, &batch);
+ * eya_usize_t aggregate = eya_task_graph_add(graph, aggregate_fn, &batch);
+ *
+ * eya_task_graph_depend(graph, transform, parse);
+ * eya_task_graph_depend(graph, aggregate, transform);
+ * eya_task_graph_set_serial(graph, aggregate);
+ *
+ * eya_task_graph_run(graph, pool, chunk_count, 4);
+ * eya_task_graph_free(graph);
+ * @endcode
+ *
+ * @see task_graph_node_fn.h
+ * @see thread_pool.h
+ */
+
+#ifndef EYA_TASK_GRAPH_H
+#define EYA_TASK_GRAPH_H
+
+#include "task_graph_node_fn.h"
+#include "memory_allocator.h"
+#include "thread_pool.h"
+
+/**
+ * @typedef eya_task_graph_t
+ * @brief Opaque task graph
+ */
+typedef struct eya_task_graph eya_task_graph_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Creates an empty graph
+ * @param[in] allocator Allocator of the graph memory (nullptr to use the calling thread's one)
+ * @return Pointer to the new graph
+ *
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the graph could not be allocated
+ *
+ * @see eya_task_graph_free()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_task_graph_t *
+eya_task_graph_make(const eya_memory_allocator_t *allocator);
+
+/**
+ * @brief Frees a graph
+ * @param[in] self Pointer to the graph (nullptr is ignored)
+ *
+ * @warning The graph must not be running.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_task_graph_free(eya_task_graph_t *self);
+
+/**
+ * @brief Adds a node to a graph
+ * @param[in,out] self Pointer to the graph
+ * @param[in] fn Function called for every chunk
+ * @param[in] context User pointer passed to `fn`
+ * @return Index of the node, nodes are numbered from 0 in the order they are added
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or fn is nullptr
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the node could not be stored
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_task_graph_add(eya_task_graph_t *self, eya_task_graph_node_fn *fn, void *context);
+
+/**
+ * @brief Makes a node wait for another one on every chunk
+ * @param[in,out] self Pointer to the graph
+ * @param[in] node Index of the waiting node
+ * @param[in] dependency Index of the node that must finish a chunk first
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If an index does not name a node, or both indices are equal
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the dependency could not be stored
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_task_graph_depend(eya_task_graph_t *self, eya_usize_t node, eya_usize_t dependency);
+
+/**
+ * @brief Makes a node process the chunks in order, one at a time
+ * @param[in,out] self Pointer to the graph
+ * @param[in] node Index of the node
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If node does not name a node
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_task_graph_set_serial(eya_task_graph_t *self, eya_usize_t node);
+
+/**
+ * @brief Runs every node of a graph on every chunk of a batch
+ *
+ * Chunks are started in order as earlier ones finish,
+ * so at most `in_flight` of them are being processed at any time.
+ * Returns when all chunks have passed through all nodes.
+ *
+ * If a node throws, no further chunks are started and nodes of the started ones
+ * are skipped; the first exception is rethrown once the running nodes have returned.
+ *
+ * @param[in,out] self Pointer to the graph
+ * @param[in] pool Pool executing the nodes
+ * @param[in] chunk_count Number of chunks of the batch
+ * @param[in] in_flight Largest number of chunks processed at the same time
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or pool is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If in_flight is zero, or the dependencies form a cycle
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the run state could not be allocated
+ * @throws Any exception thrown by a node function
+ *
+ * @warning The graph must not be modified or run again until the call returns.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_task_graph_run(eya_task_graph_t  *self,
+                   eya_thread_pool_t *pool,
+                   eya_usize_t        chunk_count,
+                   eya_usize_t        in_flight);
+
+/**
+ * @brief Returns the time a node spent in its function during the last run
+ * @param[in] self Pointer to the graph
+ * @param[in] node Index of the node
+ * @return Sum of the durations of all calls in nanoseconds
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If node does not name a node
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_task_graph_get_node_time(const eya_task_graph_t *self, eya_usize_t node);
+
+/**
+ * @brief Returns the number of calls of a node during the last run
+ * @param[in] self Pointer to the graph
+ * @param[in] node Index of the node
+ * @return Number of chunks the node function was called for
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If node does not name a node
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_task_graph_get_node_runs(const eya_task_graph_t *self, eya_usize_t node);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_TASK_GRAPH_H
\ No newline at end of file
@@ -0,0 +1,38 @@
+/**
+ * @file task_graph_node_fn.h
+ * @brief Header file defining the task graph node function type.
+ *
+ * This file declares the `eya_task_graph_node_fn` type — a function
+ * executed by a worker of a thread pool for one chunk of a node
+ * added with `eya_task_graph_add()`.
+ *
+ * @see eya_task_graph_add()
+ */
+
+#ifndef EYA_TASK_GRAPH_NODE_FN_H
+#define EYA_TASK_GRAPH_NODE_FN_H
+
+#include "size.h"
+
+/**
+ * @typedef eya_task_graph_node_fn
+ * @brief Function type for task graph nodes.
+ *
+ * The function processes chunk number `chunk` of the batch.
+ * It runs after the same chunk has passed through all dependencies of the node,
+ * while other nodes may work on the same or on other chunks concurrently.
+ *
+ * Usage example:
+ * @code
+ * void parse(void *context, eya_usize_t chunk) {
+ *     batch_t *batch = (batch_t *)context;
+ *     parse_records(&batch->input[chunk], &batch->records[chunk]);
+ * }
+ * eya_usize_t node = eya_task_graph_add(graph, parse, &batch);
+ * @endcode
+ *
+ * @see eya_task_graph_add()
+ */
+typedef void(eya_task_graph_node_fn)(void *context, eya_usize_t chunk);
+
+#endif // EYA_TASK_GRAPH_NODE_FN_H
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+ * @file thread.h
+ * @brief Portable thread creation and management
+ *
+ * This header provides a thin layer over the native threading interface
+ * of the target operating system:
+ * - POSIX threads on Linux and macOS
+ * - Win32 threads on Windows
+ *
+ * Threads started through this interface are prepared for the library runtime
+ * before the user function runs:
+ * - The exception handler stack of the new thread is reset
+ * - The runtime allocator of the creating thread is inherited
+ *
+ * @note The `eya_thread_t` object must stay alive until `eya_thread_join()` returns.
+ *
+ * @see thread_fn.h
+ * @see runtime_allocator.h
+ */
+
+#ifndef EYA_THREAD_H
+#define EYA_THREAD_H
+
+#include "memory_allocator.h"
+#include "thread_fn.h"
+
+#if (EYA_COMPILER_OS_TYPE != EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <pthread.h>
+#endif
+
+/**
+ * @typedef eya_thread_handle_t
+ * @brief Native thread handle of the target operating system
+ *
+ * - Windows: `HANDLE` returned by `_beginthreadex()`
+ * - Other systems: `pthread_t`
+ */
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+typedef void *eya_thread_handle_t;
+#else
+typedef pthread_t eya_thread_handle_t;
+#endif
+
+/**
+ * @struct eya_thread
+ * @brief Thread object with its entry point and inherited runtime state
+ *
+ * The structure keeps everything the new thread needs
+ * to initialize itself before calling the user function.
+ */
+typedef struct eya_thread
+{
+    eya_thread_handle_t    handle;    /**< Native thread handle */
+    eya_thread_fn         *fn;        /**< User entry function */
+    void                  *arg;       /**< User argument passed to the entry function */
+    eya_memory_allocator_t allocator; /**< Runtime allocator inherited from the creator */
+} eya_thread_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Starts a new thread executing the given function
+ *
+ * The new thread resets its exception handler stack,
+ * installs a copy of the creator's runtime allocator
+ * and then calls `fn(arg)`.
+ *
+ * @param[out] self Pointer to the thread object to initialize
+ * @param[in] fn Entry function of the new thread
+ * @param[in] arg User argument passed to `fn`
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or fn is nullptr
+ * @throws EYA_RUNTIME_ERROR_THREAD_NOT_CREATED
+ *         If the operating system failed to start the thread
+ *
+ * @see eya_thread_join()
+ * @see eya_runtime_exception_catch_stack_reset()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_create(eya_thread_t *self, eya_thread_fn *fn, void *arg);
+
+/**
+ * @brief Waits for a thread to finish and releases its native resources
+ * @param[in,out] self Pointer to the thread object started with `eya_thread_create()`
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED
+ *         If the thread could not be joined
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_join(eya_thread_t *self);
+
+/**
+ * @brief Yields the processor to another ready thread
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_yield(void);
+
+/**
+ * @brief Returns the number of processors available to the process
+ * @return Number of online logical processors, at least 1
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_thread_hardware_concurrency(void);
+
+/**
+ * @brief Binds the calling thread to one logical processor
+ * @param[in] cpu Number of the processor, as in @ref eya_thread_topology_cpu_t::id
+ *
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If cpu does not fit in the native affinity mask
+ * @throws EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED
+ *         If the system refused the binding, e.g. the processor is offline
+ *         or outside the set allowed to the process
+ * @throws EYA_RUNTIME_ERROR_NOT_SUPPORTED
+ *         If the system has no thread affinity interface
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_set_affinity(eya_usize_t cpu);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_H
\ No newline at end of file
@@ -0,0 +1,85 @@
+/**
+ * @file thread_barrier.h
+ * @brief Reusable barrier for a fixed number of threads
+ *
+ * Every thread of a phase calls `eya_thread_barrier_wait()`; the call returns
+ * once all of them have arrived, and the barrier is ready for the next phase.
+ * - Arrivals decrement a counter; the last thread resets it and advances
+ *   a generation word, which plays the role of the sense flag of a
+ *   sense-reversing barrier, so no thread can mix up two phases
+ * - The counter and the generation live on separate cache lines:
+ *   arriving threads write one, waiting threads only read the other
+ * - Waiters spin for @ref EYA_LIBRARY_OPTION_THREAD_WAIT_SPIN_COUNT iterations
+ *   and then sleep on the generation word, the last thread only issues
+ *   a wakeup when somebody sleeps
+ *
+ * @code
+ * for (eya_usize_t step = 0; step < steps; ++step)
+ * {
+ *     compute(part, step);
+ *     if (eya_thread_barrier_wait(&barrier))
+ *         swap_buffers(); // one thread, still before anybody starts the next step
+ *     eya_thread_barrier_wait(&barrier);
+ * }
+ * @endcode
+ *
+ * @see thread_latch.h
+ * @see thread_event.h
+ */
+
+#ifndef EYA_THREAD_BARRIER_H
+#define EYA_THREAD_BARRIER_H
+
+#include "attribute.h"
+#include "atomic.h"
+#include "bool.h"
+
+/**
+ * @struct eya_thread_barrier
+ * @brief Barrier with a fixed number of threads
+ *
+ * @note The fields are managed by the barrier functions
+ *       and must not be modified directly.
+ */
+typedef struct eya_thread_barrier
+{
+    eya_atomic_uint_t left;       /**< Threads that have not arrived in the current phase */
+    eya_uint_t        count;      /**< Threads taking part in every phase */
+    eya_uchar_t       left_pad[EYA_ATOMIC_CACHE_LINE_SIZE - 2 * sizeof(eya_uint_t)];
+    eya_atomic_uint_t generation; /**< Number of completed phases */
+    eya_atomic_uint_t sleepers;   /**< Threads that may sleep on the generation word */
+} eya_thread_barrier_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes a barrier
+ * @param[out] self Pointer to the barrier
+ * @param[in] count Number of threads taking part in every phase
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If count is zero
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_barrier_init(eya_thread_barrier_t *self, eya_uint_t count);
+
+/**
+ * @brief Waits until all threads have arrived at the barrier
+ * @param[in,out] self Pointer to the barrier
+ * @return true in exactly one thread of every phase, the last one to arrive
+ *
+ * Writes made by any thread before the call are visible to all threads after it.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_thread_barrier_wait(eya_thread_barrier_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_BARRIER_H
\ No newline at end of file
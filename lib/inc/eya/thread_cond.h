@@ -0,0 +1,102 @@
+/**
+ * @file thread_cond.h
+ * @brief Portable operating system condition variable
+ *
+ * This header wraps the native condition variable of the target system:
+ * - `pthread_cond_t` on POSIX systems
+ * - `CONDITION_VARIABLE` on Windows
+ *
+ * A condition variable is always used together with @ref eya_thread_mutex_t.
+ * As with the native primitives, waits may wake up spuriously,
+ * so the awaited predicate must be re-checked in a loop.
+ *
+ * @see thread_mutex.h
+ */
+
+#ifndef EYA_THREAD_COND_H
+#define EYA_THREAD_COND_H
+
+#include "thread_mutex.h"
+
+/**
+ * @struct eya_thread_cond
+ * @brief Native condition variable object
+ *
+ * On Windows the structure has the size and alignment of `CONDITION_VARIABLE`,
+ * so that `<windows.h>` is not required by the library headers.
+ */
+typedef struct eya_thread_cond
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    void *handle; /**< Storage of the native `CONDITION_VARIABLE` */
+#else
+    pthread_cond_t handle; /**< Native POSIX condition variable */
+#endif
+} eya_thread_cond_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes a condition variable
+ * @param[out] self Pointer to the condition variable to initialize
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED
+ *         If the native condition variable could not be created
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_cond_init(eya_thread_cond_t *self);
+
+/**
+ * @brief Releases native resources of a condition variable without waiters
+ * @param[in,out] self Pointer to the condition variable to destroy
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_cond_destroy(eya_thread_cond_t *self);
+
+/**
+ * @brief Atomically releases the mutex and blocks until signaled
+ *
+ * The mutex is re-acquired before the function returns.
+ *
+ * @param[in,out] self Pointer to the condition variable
+ * @param[in,out] mutex Pointer to the mutex held by the calling thread
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or mutex is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_cond_wait(eya_thread_cond_t *self, eya_thread_mutex_t *mutex);
+
+/**
+ * @brief Wakes up one thread waiting on the condition variable
+ * @param[in,out] self Pointer to the condition variable
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_cond_signal(eya_thread_cond_t *self);
+
+/**
+ * @brief Wakes up all threads waiting on the condition variable
+ * @param[in,out] self Pointer to the condition variable
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_cond_broadcast(eya_thread_cond_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_COND_H
\ No newline at end of file
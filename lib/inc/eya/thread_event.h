@@ -0,0 +1,97 @@
+/**
+ * @file thread_event.h
+ * @brief One-shot event
+ *
+ * An event starts unset; setting it releases all current and future waiters,
+ * and it stays set until it is initialized again. It suits a single
+ * "ready" signal, such as a result published by one thread for many others.
+ *
+ * The whole state is one word: waiters spin for
+ * @ref EYA_LIBRARY_OPTION_THREAD_WAIT_SPIN_COUNT iterations, then mark the
+ * word as waited on and sleep on it, so setting an event nobody sleeps on
+ * is a single atomic exchange.
+ *
+ * @see thread_latch.h
+ * @see thread_barrier.h
+ */
+
+#ifndef EYA_THREAD_EVENT_H
+#define EYA_THREAD_EVENT_H
+
+#include "attribute.h"
+#include "atomic.h"
+#include "bool.h"
+
+/**
+ * @def EYA_THREAD_EVENT_INITIALIZER
+ * @brief Static initializer of an unset event
+ */
+#define EYA_THREAD_EVENT_INITIALIZER {0}
+
+/**
+ * @struct eya_thread_event
+ * @brief One-shot event
+ *
+ * @note The fields are managed by the event functions
+ *       and must not be modified directly.
+ */
+typedef struct eya_thread_event
+{
+    eya_atomic_uint_t state; /**< Event state, see the file description */
+} eya_thread_event_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes an event in the unset state
+ * @param[out] self Pointer to the event
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ *
+ * @warning No thread may wait on the event during the call.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_event_init(eya_thread_event_t *self);
+
+/**
+ * @brief Sets an event and wakes all its waiters
+ * @param[in,out] self Pointer to the event
+ *
+ * Writes made before the call are visible to the threads returning from a wait.
+ * Setting an event that is already set does nothing.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_event_set(eya_thread_event_t *self);
+
+/**
+ * @brief Checks whether an event is set without waiting
+ * @param[in] self Pointer to the event
+ * @return true if the event is set
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_thread_event_is_set(eya_thread_event_t *self);
+
+/**
+ * @brief Waits until an event is set
+ * @param[in,out] self Pointer to the event
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_event_wait(eya_thread_event_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_EVENT_H
\ No newline at end of file
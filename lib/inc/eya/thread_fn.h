@@ -0,0 +1,34 @@
+/**
+ * @file thread_fn.h
+ * @brief Header file defining the thread entry function type.
+ *
+ * This file declares the `eya_thread_fn` type — a function
+ * executed by a thread started with `eya_thread_create()`.
+ *
+ * @see eya_thread_create()
+ */
+
+#ifndef EYA_THREAD_FN_H
+#define EYA_THREAD_FN_H
+
+/**
+ * @typedef eya_thread_fn
+ * @brief Function type for thread entry points.
+ *
+ * The function receives the user argument passed to `eya_thread_create()`.
+ * When it returns, the thread finishes and can be joined.
+ *
+ * Usage example:
+ * @code
+ * void worker(void *arg) {
+ *     process((job_t *)arg);
+ * }
+ * eya_thread_create(&thread, worker, &job);
+ * @endcode
+ *
+ * @see eya_thread_create()
+ * @see eya_thread_join()
+ */
+typedef void(eya_thread_fn)(void *arg);
+
+#endif // EYA_THREAD_FN_H
\ No newline at end of file
@@ -0,0 +1,79 @@
+/**
+ * @file thread_futex.h
+ * @brief Waiting on the value of a 32-bit word
+ *
+ * This header exposes the address-based wait primitive of the target system:
+ * - `futex()` on Linux
+ * - `WaitOnAddress()` on Windows
+ * - Yielding the processor everywhere else
+ *
+ * A waiter sleeps only while the word still holds the value it expects,
+ * so a change made before the wait starts is never missed.
+ * Wakeups may be spurious: callers recheck their condition in a loop.
+ *
+ * Typical usage:
+ * @code
+ * eya_uint_t seen = eya_atomic_load(&epoch, EYA_ATOMIC_ACQUIRE);
+ * while (!condition())
+ * {
+ *     eya_thread_futex_wait(&epoch, seen);
+ *     seen = eya_atomic_load(&epoch, EYA_ATOMIC_ACQUIRE);
+ * }
+ *
+ * // other thread
+ * make_condition_true();
+ * eya_atomic_fetch_add(&epoch, 1, EYA_ATOMIC_RELEASE);
+ * eya_thread_futex_wake_all(&epoch);
+ * @endcode
+ *
+ * @see atomic.h
+ */
+
+#ifndef EYA_THREAD_FUTEX_H
+#define EYA_THREAD_FUTEX_H
+
+#include "attribute.h"
+#include "atomic.h"
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Blocks the calling thread while a word holds the expected value
+ * @param[in] word Pointer to the word
+ * @param[in] expected Value that keeps the thread waiting
+ *
+ * Returns immediately if the word differs from `expected`,
+ * and may return spuriously.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If word is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_futex_wait(eya_atomic_uint_t *word, eya_uint_t expected);
+
+/**
+ * @brief Wakes at most one thread waiting on a word
+ * @param[in] word Pointer to the word
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If word is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_futex_wake_one(eya_atomic_uint_t *word);
+
+/**
+ * @brief Wakes all threads waiting on a word
+ * @param[in] word Pointer to the word
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If word is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_futex_wake_all(eya_atomic_uint_t *word);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_FUTEX_H
\ No newline at end of file
@@ -0,0 +1,99 @@
+/**
+ * @file thread_latch.h
+ * @brief Single-use count-down latch
+ *
+ * A latch starts with a count of pending operations. Threads finishing an
+ * operation count it down, any number of threads wait until the count reaches zero.
+ * Unlike a barrier, the threads that count down do not wait, and the latch
+ * cannot be reused once it has opened.
+ *
+ * Waiters spin for @ref EYA_LIBRARY_OPTION_THREAD_WAIT_SPIN_COUNT iterations
+ * and then sleep on the count; only the final count down issues a wakeup,
+ * and only when somebody sleeps.
+ *
+ * @code
+ * eya_thread_latch_init(&loaded, file_count);
+ * // every loader: load(file); eya_thread_latch_count_down(&loaded, 1);
+ * eya_thread_latch_wait(&loaded); // all files are loaded
+ * @endcode
+ *
+ * @see thread_barrier.h
+ * @see thread_event.h
+ */
+
+#ifndef EYA_THREAD_LATCH_H
+#define EYA_THREAD_LATCH_H
+
+#include "attribute.h"
+#include "atomic.h"
+#include "bool.h"
+
+/**
+ * @struct eya_thread_latch
+ * @brief Count-down latch
+ *
+ * @note The fields are managed by the latch functions
+ *       and must not be modified directly.
+ */
+typedef struct eya_thread_latch
+{
+    eya_atomic_uint_t count;    /**< Pending count downs */
+    eya_atomic_uint_t sleepers; /**< Threads that may sleep on the count */
+} eya_thread_latch_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes a latch
+ * @param[out] self Pointer to the latch
+ * @param[in] count Number of count downs that open the latch (0 for an open latch)
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_latch_init(eya_thread_latch_t *self, eya_uint_t count);
+
+/**
+ * @brief Decrements the count of a latch, opening it when the count reaches zero
+ * @param[in,out] self Pointer to the latch
+ * @param[in] n Value to subtract from the count
+ *
+ * Writes made before the call are visible to the threads returning from a wait.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If n is greater than the current count
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_latch_count_down(eya_thread_latch_t *self, eya_uint_t n);
+
+/**
+ * @brief Checks whether a latch is open without waiting
+ * @param[in] self Pointer to the latch
+ * @return true if the count has reached zero
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_thread_latch_try_wait(eya_thread_latch_t *self);
+
+/**
+ * @brief Waits until the count of a latch reaches zero
+ * @param[in,out] self Pointer to the latch
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_latch_wait(eya_thread_latch_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_LATCH_H
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+ * @file thread_lock.h
+ * @brief Four-byte mutex built on a futex word
+ *
+ * Unlike @ref eya_thread_mutex_t, the lock never enters the kernel
+ * while it is not contended: locking and unlocking are a single atomic
+ * operation each. A contended lock spins for a while
+ * (@ref EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT) and then sleeps on the word.
+ *
+ * The word holds one of three states:
+ * - 0: unlocked
+ * - 1: locked, nobody sleeps
+ * - 2: locked, threads may sleep, so the unlock has to wake one
+ *
+ * The lock is not recursive and holds no system resources,
+ * so it does not need to be destroyed.
+ *
+ * @see thread_futex.h
+ */
+
+#ifndef EYA_THREAD_LOCK_H
+#define EYA_THREAD_LOCK_H
+
+#include "attribute.h"
+#include "atomic.h"
+#include "bool.h"
+
+/**
+ * @def EYA_THREAD_LOCK_INITIALIZER
+ * @brief Static initializer of an unlocked lock
+ */
+#define EYA_THREAD_LOCK_INITIALIZER {0}
+
+/**
+ * @struct eya_thread_lock
+ * @brief Futex-based mutex
+ */
+typedef struct eya_thread_lock
+{
+    eya_atomic_uint_t state; /**< Lock state, see the file description */
+} eya_thread_lock_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes a lock in the unlocked state
+ * @param[out] self Pointer to the lock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_lock_init(eya_thread_lock_t *self);
+
+/**
+ * @brief Acquires the lock, blocking until it becomes available
+ * @param[in,out] self Pointer to the lock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_lock_lock(eya_thread_lock_t *self);
+
+/**
+ * @brief Acquires the lock if it is free
+ * @param[in,out] self Pointer to the lock
+ * @return true if the lock was acquired
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_thread_lock_try_lock(eya_thread_lock_t *self);
+
+/**
+ * @brief Releases a lock held by the calling thread
+ * @param[in,out] self Pointer to the lock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_lock_unlock(eya_thread_lock_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_LOCK_H
\ No newline at end of file
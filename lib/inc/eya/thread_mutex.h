@@ -0,0 +1,90 @@
+/**
+ * @file thread_mutex.h
+ * @brief Portable operating system mutex
+ *
+ * This header wraps the native blocking mutex of the target system:
+ * - `pthread_mutex_t` on POSIX systems
+ * - `SRWLOCK` (exclusive mode) on Windows
+ *
+ * The mutex is meant for long or blocking critical sections
+ * and as the companion of @ref eya_thread_cond_t.
+ *
+ * @see thread_cond.h
+ */
+
+#ifndef EYA_THREAD_MUTEX_H
+#define EYA_THREAD_MUTEX_H
+
+#include "attribute.h"
+
+#if (EYA_COMPILER_OS_TYPE != EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <pthread.h>
+#endif
+
+/**
+ * @struct eya_thread_mutex
+ * @brief Native mutex object
+ *
+ * On Windows the structure has the size and alignment of `SRWLOCK`,
+ * so that `<windows.h>` is not required by the library headers.
+ */
+typedef struct eya_thread_mutex
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    void *handle; /**< Storage of the native `SRWLOCK` */
+#else
+    pthread_mutex_t handle; /**< Native POSIX mutex */
+#endif
+} eya_thread_mutex_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes a mutex in the unlocked state
+ * @param[out] self Pointer to the mutex to initialize
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED
+ *         If the native mutex could not be created
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_mutex_init(eya_thread_mutex_t *self);
+
+/**
+ * @brief Releases native resources of an unlocked mutex
+ * @param[in,out] self Pointer to the mutex to destroy
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_mutex_destroy(eya_thread_mutex_t *self);
+
+/**
+ * @brief Acquires the mutex, blocking until it becomes available
+ * @param[in,out] self Pointer to the mutex
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_mutex_lock(eya_thread_mutex_t *self);
+
+/**
+ * @brief Releases a mutex held by the calling thread
+ * @param[in,out] self Pointer to the mutex
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_mutex_unlock(eya_thread_mutex_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_MUTEX_H
\ No newline at end of file
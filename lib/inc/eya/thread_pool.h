@@ -0,0 +1,276 @@
+/**
+ * @file thread_pool.h
+ * @brief Work-stealing thread pool with fork-join tasks
+ *
+ * The pool runs small tasks on a fixed set of worker threads:
+ * - Every worker owns a Chase–Lev deque; it pushes and pops its own tasks
+ *   at the bottom without locking, idle workers steal from the top
+ * - Victims are chosen at random, so stealing spreads evenly over the workers
+ * - Tasks spawned from threads outside the pool go through a shared injection queue
+ * - Idle workers spin briefly and then sleep until new work is spawned
+ *
+ * A task is a function with a closure of at most @ref EYA_THREAD_POOL_CLOSURE_SIZE bytes.
+ * The closure is copied into the task record, so spawning does not allocate
+ * once the per-worker record cache is warm.
+ *
+ * Tasks are joined through a group:
+ * @code
+ * eya_thread_pool_group_t group;
+ * eya_thread_pool_group_init(&group, pool);
+ *
+ * eya_thread_pool_spawn(&group, left_half, &args, sizeof(args));
+ * eya_thread_pool_spawn(&group, right_half, &args, sizeof(args));
+ *
+ * eya_thread_pool_sync(&group); // waits for both, rethrows the first exception
+ * @endcode
+ *
+ * Workers install the allocator given at creation as their runtime allocator,
+ * so memory allocated inside tasks comes from the same source as in the creating thread.
+ *
+ * @see thread_pool_group.h
+ * @see thread_pool_task_fn.h
+ * @see thread_pool_range_fn.h
+ * @see thread_pool_phase_fn.h
+ */
+
+#ifndef EYA_THREAD_POOL_H
+#define EYA_THREAD_POOL_H
+
+#include "thread_pool_range_fn.h"
+#include "thread_pool_phase_fn.h"
+#include "thread_pool_task_fn.h"
+#include "thread_pool_group.h"
+#include "memory_allocator.h"
+#include "thread_topology.h"
+
+/**
+ * @def EYA_THREAD_POOL_CLOSURE_SIZE
+ * @brief Largest closure in bytes that can be passed to `eya_thread_pool_spawn()`
+ */
+#define EYA_THREAD_POOL_CLOSURE_SIZE 64
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Creates a thread pool and starts its workers
+ * @param[in] worker_count Number of worker threads (0 to use the hardware concurrency)
+ * @param[in] allocator Runtime allocator of the workers (nullptr to use the calling thread's one)
+ * @return Pointer to the new pool
+ *
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the pool state could not be allocated
+ * @throws EYA_RUNTIME_ERROR_THREAD_NOT_CREATED
+ *         If a worker thread could not be started
+ *
+ * @see eya_thread_pool_free()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_thread_pool_t *
+eya_thread_pool_make(eya_usize_t worker_count, const eya_memory_allocator_t *allocator);
+
+/**
+ * @brief Creates a thread pool whose workers are pinned to CPUs
+ *
+ * Worker `i` is bound to CPU `i` of the topology in placement order,
+ * wrapping around when there are more workers than CPUs,
+ * so the first workers land on distinct cores of the same package.
+ * Every worker allocates its own state, including its task deque, after it
+ * has been pinned; with the first-touch policy of the system that memory
+ * is placed on the NUMA node of the worker.
+ *
+ * Binding is best effort: a worker whose CPU cannot be used,
+ * for example because it lies outside the set allowed to the process, runs unpinned.
+ *
+ * @param[in] worker_count Number of worker threads (0 for one per CPU of the topology)
+ * @param[in] topology Topology to place the workers on (nullptr to read the system one)
+ * @param[in] allocator Runtime allocator of the workers (nullptr to use the calling thread's one)
+ * @return Pointer to the new pool
+ *
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the pool state could not be allocated
+ * @throws EYA_RUNTIME_ERROR_THREAD_NOT_CREATED
+ *         If a worker thread could not be started
+ *
+ * @see thread_topology.h
+ * @see eya_thread_pool_get_worker_cpu()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_thread_pool_t *
+eya_thread_pool_make_pinned(eya_usize_t                   worker_count,
+                            const eya_thread_topology_t  *topology,
+                            const eya_memory_allocator_t *allocator);
+
+/**
+ * @brief Stops the workers and releases the pool
+ * @param[in] self Pointer to the pool (nullptr is ignored)
+ *
+ * @warning All groups of the pool must be synchronized before the call.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_pool_free(eya_thread_pool_t *self);
+
+/**
+ * @brief Returns the number of worker threads
+ * @param[in] self Pointer to the pool
+ * @return Number of workers
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_thread_pool_get_worker_count(const eya_thread_pool_t *self);
+
+/**
+ * @brief Returns the CPU a worker is bound to
+ * @param[in] self Pointer to the pool
+ * @param[in] index Index of the worker
+ * @return Number of the CPU, or `EYA_USIZE_T_MAX` if the worker is not pinned
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If index is not less than the worker count
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_thread_pool_get_worker_cpu(const eya_thread_pool_t *self, eya_usize_t index);
+
+/**
+ * @brief Returns the index of the calling worker
+ * @param[in] self Pointer to the pool
+ * @return Index in `[0, worker_count)`, or `EYA_USIZE_T_MAX`
+ *         if the calling thread is not a worker of this pool
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_thread_pool_get_worker_index(const eya_thread_pool_t *self);
+
+/**
+ * @brief Initializes an empty group of tasks
+ * @param[out] group Pointer to the group
+ * @param[in] pool Pool that will execute the tasks of the group
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If group or pool is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_pool_group_init(eya_thread_pool_group_t *group, eya_thread_pool_t *pool);
+
+/**
+ * @brief Spawns a task into a group
+ *
+ * The closure is copied, so it may live on the stack of the caller.
+ * When called from a worker, the task is pushed onto the worker's own deque;
+ * if the deque is full, the task runs immediately in the calling thread.
+ *
+ * @param[in] group Pointer to the group
+ * @param[in] fn Task function
+ * @param[in] closure Closure passed to the function (may be nullptr if closure_size is 0)
+ * @param[in] closure_size Size of the closure in bytes
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If group or fn is nullptr, or closure is nullptr with a nonzero size
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If closure_size is greater than @ref EYA_THREAD_POOL_CLOSURE_SIZE
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the task record could not be allocated
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_pool_spawn(eya_thread_pool_group_t *group,
+                      eya_thread_pool_task_fn *fn,
+                      const void              *closure,
+                      eya_usize_t              closure_size);
+
+/**
+ * @brief Waits until all tasks of a group have finished
+ *
+ * A worker of the pool executes pending tasks while it waits,
+ * a thread outside the pool blocks until the last task of the group finishes.
+ * If any task threw, the first exception is rethrown here
+ * after all other tasks of the group have finished.
+ * The group is empty afterwards and can be reused.
+ *
+ * @param[in,out] group Pointer to the group
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If group is nullptr
+ * @throws Any exception thrown by a task of the group
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_pool_sync(eya_thread_pool_group_t *group);
+
+/**
+ * @brief Calls a function on chunks of an index range in parallel
+ *
+ * The range is split in halves recursively until a part is not larger than `grain`,
+ * so idle workers steal large parts first. Returns when all chunks are done.
+ *
+ * @param[in] self Pointer to the pool
+ * @param[in] begin First index
+ * @param[in] end Index past the last one
+ * @param[in] grain Largest chunk passed to `fn` (0 to pick one from the worker count)
+ * @param[in] fn Loop body
+ * @param[in] context User pointer passed to `fn`
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or fn is nullptr
+ * @throws Any exception thrown by `fn`
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_pool_parallel_for(eya_thread_pool_t        *self,
+                             eya_usize_t               begin,
+                             eya_usize_t               end,
+                             eya_usize_t               grain,
+                             eya_thread_pool_range_fn *fn,
+                             void                     *context);
+
+/**
+ * @brief Runs a team of tasks through a sequence of phases separated by a barrier
+ *
+ * Every member calls `fn` once per phase; a phase starts only after all members
+ * have finished the previous one. The team is started once, so a phase boundary
+ * costs one barrier wait instead of a spawn and a sync of every task.
+ *
+ * If a member throws, the members skip the remaining phases
+ * and the first exception is rethrown once all of them have returned.
+ *
+ * @param[in] self Pointer to the pool
+ * @param[in] member_count Number of members (0 to use the worker count)
+ * @param[in] phase_count Number of phases
+ * @param[in] fn Phase body
+ * @param[in] context User pointer passed to `fn`
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self or fn is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If member_count is greater than the worker count
+ * @throws EYA_RUNTIME_ERROR_RESOURCE_EXHAUSTED
+ *         If a team is already running on the pool,
+ *         including when the call is made from one of its phase bodies
+ * @throws Any exception thrown by `fn`
+ *
+ * @warning Members wait for each other, so the call needs `member_count` workers
+ *          free at the same time. A pool runs one team at a time, and no phase
+ *          starts until every member has a worker: tasks that keep workers
+ *          blocked without the team delay it for as long as they block.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_pool_parallel_phases(eya_thread_pool_t        *self,
+                                eya_usize_t               member_count,
+                                eya_usize_t               phase_count,
+                                eya_thread_pool_phase_fn *fn,
+                                void                     *context);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_POOL_H
\ No newline at end of file
@@ -0,0 +1,44 @@
+/**
+ * @file thread_pool_group.h
+ * @brief Join point of tasks spawned on a thread pool
+ *
+ * A group counts the tasks spawned into it that have not finished yet
+ * and keeps the first exception thrown by any of them.
+ * `eya_thread_pool_sync()` waits until the count drops to zero
+ * and rethrows that exception in the waiting thread.
+ *
+ * Groups are plain structures, so they are usually placed on the stack
+ * of the function that spawns and joins the tasks. The exception itself is
+ * kept in a record owned by the pool, which the group only points to, so the
+ * structure does not depend on how exceptions are laid out.
+ *
+ * @see thread_pool.h
+ */
+
+#ifndef EYA_THREAD_POOL_GROUP_H
+#define EYA_THREAD_POOL_GROUP_H
+
+#include "atomic.h"
+
+/**
+ * @typedef eya_thread_pool_t
+ * @brief Opaque work-stealing thread pool
+ */
+typedef struct eya_thread_pool eya_thread_pool_t;
+
+/**
+ * @struct eya_thread_pool_group
+ * @brief Set of tasks joined together
+ *
+ * @note The fields are managed by the thread pool functions
+ *       and must not be modified directly.
+ */
+typedef struct eya_thread_pool_group
+{
+    eya_thread_pool_t *pool;    /**< Pool executing the tasks */
+    eya_atomic_usize_t pending; /**< Number of spawned tasks that have not finished */
+    eya_atomic_usize_t failed;  /**< Nonzero once a task has thrown */
+    void              *failure; /**< Pool record holding the first exception thrown by a task */
+} eya_thread_pool_group_t;
+
+#endif // EYA_THREAD_POOL_GROUP_H
\ No newline at end of file
@@ -0,0 +1,39 @@
+/**
+ * @file thread_pool_phase_fn.h
+ * @brief Header file defining the parallel phase body function type.
+ *
+ * This file declares the `eya_thread_pool_phase_fn` type — a function
+ * executed by one member of a team started with `eya_thread_pool_parallel_phases()`.
+ *
+ * @see eya_thread_pool_parallel_phases()
+ */
+
+#ifndef EYA_THREAD_POOL_PHASE_FN_H
+#define EYA_THREAD_POOL_PHASE_FN_H
+
+#include "size.h"
+
+/**
+ * @typedef eya_thread_pool_phase_fn
+ * @brief Function type for parallel phase bodies.
+ *
+ * The function does the share of member `member` out of `member_count` in phase `phase`.
+ * All members finish a phase before any of them starts the next one.
+ *
+ * Usage example:
+ * @code
+ * void relax(void *context, eya_usize_t phase, eya_usize_t member, eya_usize_t member_count) {
+ *     grid_t *grid = (grid_t *)context;
+ *     smooth_rows(grid, phase % 2, member, member_count);
+ * }
+ * eya_thread_pool_parallel_phases(pool, 0, 100, relax, &grid);
+ * @endcode
+ *
+ * @see eya_thread_pool_parallel_phases()
+ */
+typedef void(eya_thread_pool_phase_fn)(void       *context,
+                                       eya_usize_t phase,
+                                       eya_usize_t member,
+                                       eya_usize_t member_count);
+
+#endif // EYA_THREAD_POOL_PHASE_FN_H
\ No newline at end of file
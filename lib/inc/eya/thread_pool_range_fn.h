@@ -0,0 +1,37 @@
+/**
+ * @file thread_pool_range_fn.h
+ * @brief Header file defining the parallel loop body function type.
+ *
+ * This file declares the `eya_thread_pool_range_fn` type — a function
+ * processing one chunk of an index range split by `eya_thread_pool_parallel_for()`.
+ *
+ * @see eya_thread_pool_parallel_for()
+ */
+
+#ifndef EYA_THREAD_POOL_RANGE_FN_H
+#define EYA_THREAD_POOL_RANGE_FN_H
+
+#include "size.h"
+
+/**
+ * @typedef eya_thread_pool_range_fn
+ * @brief Function type for parallel loop bodies.
+ *
+ * The function processes the indices `[begin, end)`.
+ * Chunks of one loop are disjoint and may run concurrently.
+ *
+ * Usage example:
+ * @code
+ * void scale(void *context, eya_usize_t begin, eya_usize_t end) {
+ *     float *data = (float *)context;
+ *     for (eya_usize_t i = begin; i < end; ++i)
+ *         data[i] *= 2.0f;
+ * }
+ * eya_thread_pool_parallel_for(pool, 0, count, 4096, scale, data);
+ * @endcode
+ *
+ * @see eya_thread_pool_parallel_for()
+ */
+typedef void(eya_thread_pool_range_fn)(void *context, eya_usize_t begin, eya_usize_t end);
+
+#endif // EYA_THREAD_POOL_RANGE_FN_H
\ No newline at end of file
@@ -0,0 +1,37 @@
+/**
+ * @file thread_pool_task_fn.h
+ * @brief Header file defining the thread pool task function type.
+ *
+ * This file declares the `eya_thread_pool_task_fn` type — a function
+ * executed by a worker of a thread pool for a task started with `eya_thread_pool_spawn()`.
+ *
+ * @see eya_thread_pool_spawn()
+ */
+
+#ifndef EYA_THREAD_POOL_TASK_FN_H
+#define EYA_THREAD_POOL_TASK_FN_H
+
+/**
+ * @typedef eya_thread_pool_task_fn
+ * @brief Function type for thread pool tasks.
+ *
+ * The function receives a pointer to the task's own copy of the closure
+ * passed to `eya_thread_pool_spawn()`. The copy lives until the function returns.
+ *
+ * Usage example:
+ * @code
+ * typedef struct { int *out; int value; } job_t;
+ *
+ * void run(void *closure) {
+ *     job_t *job = (job_t *)closure;
+ *     *job->out = job->value * 2;
+ * }
+ * job_t job = {&result, 21};
+ * eya_thread_pool_spawn(&group, run, &job, sizeof(job));
+ * @endcode
+ *
+ * @see eya_thread_pool_spawn()
+ */
+typedef void(eya_thread_pool_task_fn)(void *closure);
+
+#endif // EYA_THREAD_POOL_TASK_FN_H
\ No newline at end of file
@@ -0,0 +1,129 @@
+/**
+ * @file thread_rwlock.h
+ * @brief Reader-writer lock biased towards readers
+ *
+ * The lock is a single 32-bit futex word holding the number of readers,
+ * a writer bit and a bit telling that threads sleep on the word.
+ * A reader enters with one compare-and-exchange whenever no writer
+ * holds the lock, even if writers are waiting, which keeps read-mostly
+ * tables fast at the cost of possible writer starvation under
+ * a never-ending stream of readers.
+ *
+ * Contended threads spin for @ref EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT
+ * iterations before they sleep on the word.
+ *
+ * The lock holds no system resources, so it does not need to be destroyed.
+ *
+ * @see thread_lock.h
+ */
+
+#ifndef EYA_THREAD_RWLOCK_H
+#define EYA_THREAD_RWLOCK_H
+
+#include "attribute.h"
+#include "atomic.h"
+#include "bool.h"
+
+/**
+ * @def EYA_THREAD_RWLOCK_INITIALIZER
+ * @brief Static initializer of an unlocked reader-writer lock
+ */
+#define EYA_THREAD_RWLOCK_INITIALIZER {0}
+
+/**
+ * @struct eya_thread_rwlock
+ * @brief Reader-writer lock
+ */
+typedef struct eya_thread_rwlock
+{
+    eya_atomic_uint_t state; /**< Reader count, writer bit and sleeper bit */
+} eya_thread_rwlock_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes a reader-writer lock in the unlocked state
+ * @param[out] self Pointer to the lock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_rwlock_init(eya_thread_rwlock_t *self);
+
+/**
+ * @brief Acquires the lock in shared mode
+ * @param[in,out] self Pointer to the lock
+ *
+ * Blocks only while a writer holds the lock.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_rwlock_read_lock(eya_thread_rwlock_t *self);
+
+/**
+ * @brief Acquires the lock in shared mode if no writer holds it
+ * @param[in,out] self Pointer to the lock
+ * @return true if the lock was acquired
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_thread_rwlock_try_read_lock(eya_thread_rwlock_t *self);
+
+/**
+ * @brief Releases the shared mode held by the calling thread
+ * @param[in,out] self Pointer to the lock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_rwlock_read_unlock(eya_thread_rwlock_t *self);
+
+/**
+ * @brief Acquires the lock in exclusive mode
+ * @param[in,out] self Pointer to the lock
+ *
+ * Blocks until neither readers nor another writer hold the lock.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_rwlock_write_lock(eya_thread_rwlock_t *self);
+
+/**
+ * @brief Acquires the lock in exclusive mode if nobody holds it
+ * @param[in,out] self Pointer to the lock
+ * @return true if the lock was acquired
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_thread_rwlock_try_write_lock(eya_thread_rwlock_t *self);
+
+/**
+ * @brief Releases the exclusive mode held by the calling thread
+ * @param[in,out] self Pointer to the lock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_rwlock_write_unlock(eya_thread_rwlock_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_RWLOCK_H
\ No newline at end of file
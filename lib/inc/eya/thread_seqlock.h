@@ -0,0 +1,145 @@
+/**
+ * @file thread_seqlock.h
+ * @brief Sequence lock for small, frequently read structures
+ *
+ * Readers never write shared memory: they copy the data and check that
+ * the sequence number did not change meanwhile, retrying otherwise.
+ * Writers make the number odd for the duration of the update,
+ * and are serialized with each other by the same word.
+ *
+ * Typical usage:
+ * @code
+ * // reader
+ * eya_uint_t seq;
+ * do
+ * {
+ *     seq  = eya_thread_seqlock_read_begin(&lock);
+ *     copy = shared;
+ * } while (eya_thread_seqlock_read_retry(&lock, seq));
+ *
+ * // writer
+ * eya_thread_seqlock_write_lock(&lock);
+ * shared = value;
+ * eya_thread_seqlock_write_unlock(&lock);
+ * @endcode
+ *
+ * @warning A reader may observe a torn copy before the retry check rejects it,
+ *          so the copy must not be used (for example dereferenced) until then.
+ *
+ * @note The data itself is accessed without atomics, so race detectors
+ *       report the overlapping copies that the sequence check discards.
+ */
+
+#ifndef EYA_THREAD_SEQLOCK_H
+#define EYA_THREAD_SEQLOCK_H
+
+#include "attribute.h"
+#include "atomic.h"
+#include "bool.h"
+
+/**
+ * @def EYA_THREAD_SEQLOCK_INITIALIZER
+ * @brief Static initializer of an unlocked sequence lock
+ */
+#define EYA_THREAD_SEQLOCK_INITIALIZER {0}
+
+/**
+ * @struct eya_thread_seqlock
+ * @brief Sequence lock
+ */
+typedef struct eya_thread_seqlock
+{
+    eya_atomic_uint_t sequence; /**< Even while idle, odd while a writer updates the data */
+} eya_thread_seqlock_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes a sequence lock
+ * @param[out] self Pointer to the lock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_seqlock_init(eya_thread_seqlock_t *self);
+
+/**
+ * @brief Starts a read, waiting for a writer in progress to finish
+ * @param[in] self Pointer to the lock
+ * @return Sequence number to pass to eya_thread_seqlock_read_retry()
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_uint_t
+eya_thread_seqlock_read_begin(eya_thread_seqlock_t *self);
+
+/**
+ * @brief Checks whether a read has to be repeated
+ * @param[in] self Pointer to the lock
+ * @param[in] sequence Value returned by eya_thread_seqlock_read_begin()
+ * @return true if a writer changed the data since the read began
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_thread_seqlock_read_retry(eya_thread_seqlock_t *self, eya_uint_t sequence);
+
+/**
+ * @brief Starts an update, waiting for other writers
+ * @param[in,out] self Pointer to the lock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_seqlock_write_lock(eya_thread_seqlock_t *self);
+
+/**
+ * @brief Finishes an update and publishes it to readers
+ * @param[in,out] self Pointer to the lock held by the calling thread
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_seqlock_write_unlock(eya_thread_seqlock_t *self);
+
+/**
+ * @brief Copies a consistent snapshot of the protected data
+ * @param[in] self Pointer to the lock
+ * @param[out] dst Destination of the copy
+ * @param[in] src Protected data
+ * @param[in] size Size of the data in bytes
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self, dst or src is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_seqlock_read(eya_thread_seqlock_t *self, void *dst, const void *src, eya_usize_t size);
+
+/**
+ * @brief Replaces the protected data under the write lock
+ * @param[in,out] self Pointer to the lock
+ * @param[out] dst Protected data
+ * @param[in] src New value of the data
+ * @param[in] size Size of the data in bytes
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self, dst or src is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_seqlock_write(eya_thread_seqlock_t *self, void *dst, const void *src, eya_usize_t size);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_SEQLOCK_H
\ No newline at end of file
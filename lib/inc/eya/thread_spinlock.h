@@ -0,0 +1,90 @@
+/**
+ * @file thread_spinlock.h
+ * @brief Ticket spinlock for very short critical sections
+ *
+ * Every thread takes a ticket and spins until the lock serves its number,
+ * so the lock is granted in arrival order and no waiter starves.
+ * The waiters only read the `owner` word while they spin.
+ *
+ * A waiter never sleeps: the lock is meant for a handful of instructions
+ * under the lock and at most as many contending threads as there are cores.
+ * After @ref EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT iterations it yields
+ * the processor between checks, so a preempted holder can still finish.
+ * For anything longer use @ref eya_thread_lock_t.
+ *
+ * @see thread_lock.h
+ */
+
+#ifndef EYA_THREAD_SPINLOCK_H
+#define EYA_THREAD_SPINLOCK_H
+
+#include "attribute.h"
+#include "atomic.h"
+#include "bool.h"
+
+/**
+ * @def EYA_THREAD_SPINLOCK_INITIALIZER
+ * @brief Static initializer of an unlocked spinlock
+ */
+#define EYA_THREAD_SPINLOCK_INITIALIZER {0, 0}
+
+/**
+ * @struct eya_thread_spinlock
+ * @brief Ticket spinlock
+ */
+typedef struct eya_thread_spinlock
+{
+    eya_atomic_uint_t next;  /**< Next ticket to hand out */
+    eya_atomic_uint_t owner; /**< Ticket currently holding the lock */
+} eya_thread_spinlock_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Initializes a spinlock in the unlocked state
+ * @param[out] self Pointer to the spinlock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_spinlock_init(eya_thread_spinlock_t *self);
+
+/**
+ * @brief Takes a ticket and spins until it is served
+ * @param[in,out] self Pointer to the spinlock
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_spinlock_lock(eya_thread_spinlock_t *self);
+
+/**
+ * @brief Acquires the spinlock if nobody holds or waits for it
+ * @param[in,out] self Pointer to the spinlock
+ * @return true if the spinlock was acquired
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_thread_spinlock_try_lock(eya_thread_spinlock_t *self);
+
+/**
+ * @brief Serves the next ticket
+ * @param[in,out] self Pointer to the spinlock held by the calling thread
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_spinlock_unlock(eya_thread_spinlock_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_SPINLOCK_H
\ No newline at end of file
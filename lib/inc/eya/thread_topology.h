@@ -0,0 +1,152 @@
+/**
+ * @file thread_topology.h
+ * @brief Processor layout of the machine: logical CPUs, cores, packages and NUMA nodes
+ *
+ * On Linux the layout is read from sysfs:
+ * - `cpu/online` lists the logical CPUs
+ * - `cpu/cpuN/topology/core_id` and `physical_package_id` place every CPU
+ *   on a core of a package
+ * - `node/online` and `node/nodeN/cpulist` assign the CPUs to NUMA nodes
+ *
+ * The root of these paths can be given explicitly, so tests can read
+ * a fixture directory instead of `/sys/devices/system`. Missing files are not
+ * an error: a CPU without topology files is its own core of package 0,
+ * and a machine without NUMA information is a single node. If the CPU list itself
+ * cannot be read, as on systems without sysfs, the topology is
+ * @ref eya_thread_hardware_concurrency() CPUs with one core each.
+ *
+ * The CPUs are kept in placement order: one CPU of every physical core first,
+ * grouped by node and package, then the remaining hardware threads
+ * in the same order. Taking the first N entries therefore spreads N threads
+ * over distinct cores while keeping neighbours on the same package.
+ *
+ * @code
+ * eya_thread_topology_t *topology = eya_thread_topology_make(nullptr, nullptr);
+ *
+ * for (eya_usize_t i = 0; i < eya_thread_topology_get_cpu_count(topology); ++i)
+ *     print_cpu(eya_thread_topology_get_cpu(topology, i));
+ *
+ * eya_thread_topology_free(topology);
+ * @endcode
+ *
+ * @see eya_thread_set_affinity()
+ * @see eya_thread_pool_make_pinned()
+ */
+
+#ifndef EYA_THREAD_TOPOLOGY_H
+#define EYA_THREAD_TOPOLOGY_H
+
+#include "memory_allocator.h"
+
+/**
+ * @typedef eya_thread_topology_t
+ * @brief Opaque processor topology
+ */
+typedef struct eya_thread_topology eya_thread_topology_t;
+
+/**
+ * @struct eya_thread_topology_cpu
+ * @brief Position of one logical CPU
+ */
+typedef struct eya_thread_topology_cpu
+{
+    eya_usize_t id;      /**< Number of the logical CPU, as used for affinity */
+    eya_usize_t core;    /**< Core identifier, unique within the package */
+    eya_usize_t package; /**< Physical package (socket) identifier */
+    eya_usize_t node;    /**< NUMA node identifier */
+} eya_thread_topology_cpu_t;
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Reads the processor topology
+ * @param[in] root Directory holding the `cpu` and `node` trees
+ *                 (nullptr for `/sys/devices/system`)
+ * @param[in] allocator Allocator of the topology (nullptr to use the calling thread's one)
+ * @return Pointer to the new topology
+ *
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If a path built from root is too long
+ * @throws EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED
+ *         If the topology could not be allocated
+ *
+ * @see eya_thread_topology_free()
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_thread_topology_t *
+eya_thread_topology_make(const char *root, const eya_memory_allocator_t *allocator);
+
+/**
+ * @brief Frees a topology
+ * @param[in] self Pointer to the topology (nullptr is ignored)
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_thread_topology_free(eya_thread_topology_t *self);
+
+/**
+ * @brief Returns the number of logical CPUs
+ * @param[in] self Pointer to the topology
+ * @return Number of CPUs, at least 1
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_thread_topology_get_cpu_count(const eya_thread_topology_t *self);
+
+/**
+ * @brief Returns a logical CPU in placement order
+ * @param[in] self Pointer to the topology
+ * @param[in] index Position in placement order
+ * @return Pointer to the CPU, valid until the topology is freed
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If index is not less than the CPU count
+ */
+EYA_ATTRIBUTE(SYMBOL)
+const eya_thread_topology_cpu_t *
+eya_thread_topology_get_cpu(const eya_thread_topology_t *self, eya_usize_t index);
+
+/**
+ * @brief Returns the number of physical cores
+ * @param[in] self Pointer to the topology
+ * @return Number of distinct cores over all packages
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_thread_topology_get_core_count(const eya_thread_topology_t *self);
+
+/**
+ * @brief Returns the number of physical packages
+ * @param[in] self Pointer to the topology
+ * @return Number of distinct packages
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_thread_topology_get_package_count(const eya_thread_topology_t *self);
+
+/**
+ * @brief Returns the number of NUMA nodes
+ * @param[in] self Pointer to the topology
+ * @return Number of distinct nodes holding at least one CPU
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If self is nullptr
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_thread_topology_get_node_count(const eya_thread_topology_t *self);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_THREAD_TOPOLOGY_H
\ No newline at end of file
@@ -0,0 +1,230 @@
+/**
+ * @file utf8.h
+ * @brief UTF-8 validation and transcoding to and from UTF-16 and UTF-32
+ *
+ * Valid UTF-8 follows RFC 3629: no overlong forms, no surrogates
+ * (U+D800 to U+DFFF) and nothing above U+10FFFF. Valid UTF-16 pairs every
+ * surrogate, valid UTF-32 holds only scalar values.
+ *
+ * UTF-16 and UTF-32 ranges hold units of @ref eya_ushort_t and
+ * @ref eya_uint_t in the byte order of the host, aligned to their size.
+ * Sizes are in bytes for ranges and in units for the results.
+ *
+ * With AVX2, validation checks 32 bytes per step with the lookup algorithm
+ * of Keiser and Lemire: three 16-entry tables indexed by the nibbles of
+ * each byte and of its predecessor flag every invalid two-byte pattern,
+ * and saturating subtractions check the continuation bytes of three- and
+ * four-byte sequences. Transcoding converts 32 units of ASCII per step;
+ * otherwise UTF-8 is validated first and then decoded up to 16 bytes at a
+ * time, and code points below U+0800 are encoded 16 at a time, with
+ * shuffles from small tables gathering the units of each character.
+ * Four-byte characters and, when encoding, code points from U+0800 up are
+ * converted one at a time. Other CPUs handle one character at a time,
+ * skipping words of ASCII; @ref eya_utf8_set_cpu_features() can force
+ * that path, e.g. in tests.
+ *
+ * @code
+ * if (!eya_utf8_is_valid(&field))
+ *     return reject(request);
+ * @endcode
+ */
+
+#ifndef EYA_UTF8_H
+#define EYA_UTF8_H
+
+#include "memory_range.h"
+
+EYA_COMPILER(EXTERN_C_BEGIN)
+
+/**
+ * @brief Checks whether a range is valid UTF-8
+ * @param[in] src Range to check
+ * @return true if the range is valid UTF-8
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_utf8_is_valid(const eya_memory_range_t *src);
+
+/**
+ * @brief Checks whether a range holds only ASCII characters
+ * @param[in] src Range to check
+ * @return true if no byte has its high bit set
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ */
+EYA_ATTRIBUTE(SYMBOL)
+bool
+eya_utf8_is_ascii(const eya_memory_range_t *src);
+
+/**
+ * @brief Returns the number of UTF-16 units encoding a UTF-8 range
+ * @param[in] src Valid UTF-8
+ * @return Number of units, meaningless if the range is not valid UTF-8
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_utf8_utf16_size(const eya_memory_range_t *src);
+
+/**
+ * @brief Returns the number of code points of a UTF-8 range
+ * @param[in] src Valid UTF-8
+ * @return Number of code points, meaningless if the range is not valid UTF-8
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_utf8_utf32_size(const eya_memory_range_t *src);
+
+/**
+ * @brief Converts UTF-8 to UTF-16
+ * @param[in] dst Destination of at least @ref eya_utf8_utf16_size() units
+ * @param[in] src UTF-8 to convert
+ * @return Number of units written
+ *
+ * The destination may be modified even if the source is invalid.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If a range is invalid
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the destination is misaligned or the source is not valid UTF-8
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_utf8_to_utf16(const eya_memory_range_t *dst, const eya_memory_range_t *src);
+
+/**
+ * @brief Converts UTF-8 to UTF-32
+ * @param[in] dst Destination of at least @ref eya_utf8_utf32_size() units
+ * @param[in] src UTF-8 to convert
+ * @return Number of units written
+ *
+ * The destination may be modified even if the source is invalid.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If a range is invalid
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the destination is misaligned or the source is not valid UTF-8
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_utf8_to_utf32(const eya_memory_range_t *dst, const eya_memory_range_t *src);
+
+/**
+ * @brief Returns the number of UTF-8 bytes encoding a UTF-16 range
+ * @param[in] src Valid UTF-16
+ * @return Number of bytes, meaningless if the range is not valid UTF-16
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ * @throws EYA_RUNTIME_ERROR_SIZE_NOT_MULTIPLE_OF_ELEMENT_SIZE
+ *         If the size of the range is odd
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_utf16_utf8_size(const eya_memory_range_t *src);
+
+/**
+ * @brief Converts UTF-16 to UTF-8
+ * @param[in] dst Destination of at least @ref eya_utf16_utf8_size() bytes
+ * @param[in] src UTF-16 to convert
+ * @return Number of bytes written
+ *
+ * The destination may be modified even if the source is invalid.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If a range is invalid
+ * @throws EYA_RUNTIME_ERROR_SIZE_NOT_MULTIPLE_OF_ELEMENT_SIZE
+ *         If the size of the source is odd
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the source is misaligned or holds an unpaired surrogate
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_utf16_to_utf8(const eya_memory_range_t *dst, const eya_memory_range_t *src);
+
+/**
+ * @brief Returns the number of UTF-8 bytes encoding a UTF-32 range
+ * @param[in] src Valid UTF-32
+ * @return Number of bytes, meaningless if the range is not valid UTF-32
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If the range is invalid
+ * @throws EYA_RUNTIME_ERROR_SIZE_NOT_MULTIPLE_OF_ELEMENT_SIZE
+ *         If the size of the range is not a multiple of 4
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_utf32_utf8_size(const eya_memory_range_t *src);
+
+/**
+ * @brief Converts UTF-32 to UTF-8
+ * @param[in] dst Destination of at least @ref eya_utf32_utf8_size() bytes
+ * @param[in] src UTF-32 to convert
+ * @return Number of bytes written
+ *
+ * The destination may be modified even if the source is invalid.
+ *
+ * @throws EYA_RUNTIME_ERROR_NULL_POINTER
+ *         If dst or src is nullptr
+ * @throws EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE
+ *         If a range is invalid
+ * @throws EYA_RUNTIME_ERROR_SIZE_NOT_MULTIPLE_OF_ELEMENT_SIZE
+ *         If the size of the source is not a multiple of 4
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the source is misaligned or holds a surrogate or a value above U+10FFFF
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the destination is too small
+ */
+EYA_ATTRIBUTE(SYMBOL)
+eya_usize_t
+eya_utf32_to_utf8(const eya_memory_range_t *dst, const eya_memory_range_t *src);
+
+/**
+ * @brief Selects the implementation allowed by a set of CPU features
+ * @param[in] features Bitwise OR of @ref eya_cpu_feature_t flags,
+ *                     those the CPU does not support are ignored
+ *
+ * The library calls it with every feature when it is loaded.
+ *
+ * @warning Must not run concurrently with the other functions of this header.
+ */
+EYA_ATTRIBUTE(SYMBOL)
+void
+eya_utf8_set_cpu_features(eya_uint_t features);
+
+EYA_COMPILER(EXTERN_C_END)
+
+#endif // EYA_UTF8_H
\ No newline at end of file
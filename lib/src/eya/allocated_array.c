@@ -2,6 +2,7 @@
 
 #include <eya/runtime_error_code.h>
 #include <eya/runtime_check.h>
+#include <eya/checked_math.h>
 #include <eya/memory_typed.h>
 #include <eya/ptr_util.h>
 
@@ -35,22 +36,40 @@ eya_allocated_array_get_max_size(const eya_allocated_array_t *self)
     return EYA_USIZE_T_MAX / element_size;
 }
 
+/**
+ * @brief Computes the byte size of a number of elements
+ * @param[in] self Pointer to the array
+ * @param[in] size Number of elements
+ * @param[out] size_in_bytes Byte size, unspecified if it does not fit
+ * @return true if the byte size does not fit in @ref eya_usize_t
+ */
+static bool
+eya_allocated_array_get_size_in_bytes(const eya_allocated_array_t *self,
+                                      eya_usize_t                  size,
+                                      eya_usize_t                 *size_in_bytes)
+{
+    const eya_usize_t element_size =
+        eya_memory_typed_get_element_size(eya_ptr_rcast(const eya_memory_typed_t, self));
+
+    eya_runtime_check(element_size, EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE);
+    return eya_checked_mul(size, element_size, size_in_bytes);
+}
+
 bool
 eya_allocated_array_is_max_size_exceeds(const eya_allocated_array_t *self, eya_usize_t size)
 {
-    const eya_usize_t max_size = eya_allocated_array_get_max_size(self);
-    return size > max_size;
+    eya_usize_t size_in_bytes;
+    return eya_allocated_array_get_size_in_bytes(self, size, &size_in_bytes);
 }
 
 void
 eya_allocated_array_resize(eya_allocated_array_t *self, eya_usize_t size)
 {
-    eya_runtime_check_if(eya_allocated_array_is_max_size_exceeds(self, size),
+    eya_usize_t size_in_bytes;
+    eya_runtime_check_if(eya_allocated_array_get_size_in_bytes(self, size, &size_in_bytes),
                          EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE);
 
-    const eya_usize_t element_size =
-        eya_memory_typed_get_element_size(eya_ptr_rcast(eya_memory_typed_t, self));
+    eya_memory_typed_update_divider(eya_ptr_rcast(eya_memory_typed_t, self));
 
-    const eya_usize_t size_in_bytes = size * element_size;
     eya_allocated_range_resize(eya_ptr_rcast(eya_allocated_range_t, self), size_in_bytes);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <eya/runtime_allocator.h>
 #include <eya/memory_range.h>
+#include <eya/ptr_util.h>
 
 eya_usize_t
 eya_allocated_range_get_size(const eya_allocated_range_t *self)
@@ -35,4 +36,23 @@ eya_allocated_range_resize(eya_allocated_range_t *self, eya_usize_t size)
 
     void *new_ptr = eya_memory_allocator_realloc(allocator, old_ptr, cur_size, size);
     eya_memory_range_reset_f(self, new_ptr, size);
+}
+
+eya_allocated_range_t
+eya_allocated_range_make_aligned(eya_usize_t size, eya_usize_t align)
+{
+    eya_memory_allocator_t *allocator = eya_runtime_allocator();
+
+    void *ptr = eya_memory_allocator_alloc_aligned(allocator, size, align);
+    return eya_memory_range_make(ptr, eya_ptr_add_by_offset_unsafe(void, ptr, size));
+}
+
+void
+eya_allocated_range_clear_aligned(eya_allocated_range_t *self)
+{
+    eya_memory_allocator_t *allocator = eya_runtime_allocator();
+
+    void *ptr = eya_memory_range_get_begin(self);
+    eya_memory_allocator_free_aligned(allocator, ptr);
+    eya_memory_range_clear(self);
 }
\ No newline at end of file
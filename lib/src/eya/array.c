@@ -3,6 +3,7 @@
 #include <eya/allocated_array_initializer.h>
 #include <eya/array_initializer.h>
 #include <eya/runtime_check_ref.h>
+#include <eya/checked_math.h>
 #include <eya/memory_typed.h>
 #include <eya/memory_std.h>
 #include <eya/ptr_util.h>
@@ -145,18 +146,28 @@ eya_array_shrink(eya_array_t *self)
 void
 eya_array_reserve(eya_array_t *self, eya_usize_t size)
 {
-    const eya_usize_t cur_size     = eya_array_get_size(self);
-    const eya_usize_t capacity     = eya_array_capacity(self);
-    eya_usize_t       reserve_size = cur_size + size;
+    const eya_usize_t cur_size = eya_array_get_size(self);
+    const eya_usize_t capacity = eya_array_capacity(self);
+    eya_usize_t       reserve_size;
+
+    eya_runtime_check_if(eya_checked_add(cur_size, size, &reserve_size),
+                         EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE);
 
     if (capacity < reserve_size)
     {
 #if (EYA_LIBRARY_OPTION_ARRAY_RESERVE_OPTIMIZE == EYA_LIBRARY_OPTION_ON)
         /* Standard mode: smart growth with coefficient */
-        reserve_size = capacity == 0
-                           ? reserve_size
-                           : (reserve_size * EYA_LIBRARY_OPTION_ARRAY_DEFAULT_GROWTH_RATIO) / 1000;
-
+        eya_usize_t grown_size;
+
+        /* Near the maximum size the growth is dropped, the exact size may still fit */
+        if (capacity != 0 &&
+            !eya_checked_mul(reserve_size, EYA_LIBRARY_OPTION_ARRAY_DEFAULT_GROWTH_RATIO,
+                             &grown_size) &&
+            !eya_allocated_array_is_max_size_exceeds(
+                eya_ptr_rcast(const eya_allocated_array_t, self), grown_size / 1000))
+        {
+            reserve_size = grown_size / 1000;
+        }
 #endif
         eya_allocated_array_resize(eya_ptr_rcast(eya_allocated_array_t, self), reserve_size);
     }
@@ -182,6 +193,7 @@ eya_array_make(eya_usize_t element_size, eya_usize_t size)
 {
     eya_runtime_check(element_size, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
     eya_array_t _t = eya_array_initializer(eya_allocated_array_initializer(element_size));
+    eya_memory_typed_update_divider(eya_ptr_rcast(eya_memory_typed_t, &_t));
     if (size)
     {
         eya_array_resize(&_t, size);
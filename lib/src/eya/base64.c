@@ -0,0 +1,455 @@
+#include <eya/base64.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/numeric_limits.h>
+#include <eya/checked_math.h>
+#include <eya/nullptr.h>
+#include <eya/cpu.h>
+
+#if ((EYA_COMPILER_GCC_LIKE) && defined(__x86_64__)) ||                                            \
+    ((EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && defined(_M_X64))
+#    include <immintrin.h>
+#    define EYA_BASE64_X86 1
+#endif
+
+/**
+ * @brief Number of alphabets, the index of a table
+ */
+#define EYA_BASE64_ALPHABET_COUNT 2
+
+/**
+ * @brief Characters of the values 0 to 63 of each alphabet
+ */
+static const char eya_base64_chars[EYA_BASE64_ALPHABET_COUNT][65] = {
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+};
+
+/**
+ * @brief Value of each character of each alphabet, 0xFF for characters outside it
+ */
+static eya_uchar_t eya_base64_values[EYA_BASE64_ALPHABET_COUNT][256];
+
+#if (EYA_BASE64_X86)
+static bool eya_base64_has_avx2;
+#endif
+
+/**
+ * @brief Checks that an alphabet is known, so that it can index the tables
+ */
+static void
+eya_base64_check_alphabet(eya_base64_alphabet_t alphabet)
+{
+    eya_runtime_check((eya_uint_t)alphabet < EYA_BASE64_ALPHABET_COUNT,
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+}
+
+/**
+ * @brief Encodes groups of three bytes, then the padded tail
+ */
+static void
+eya_base64_encode_scalar(eya_uchar_t          *dst,
+                         const eya_uchar_t    *src,
+                         eya_usize_t           size,
+                         eya_base64_alphabet_t alphabet)
+{
+    const char *chars = eya_base64_chars[alphabet];
+
+    for (; size >= 3; size -= 3, src += 3, dst += 4)
+    {
+        const eya_uint_t v = (eya_uint_t)src[0] << 16 | (eya_uint_t)src[1] << 8 | src[2];
+
+        dst[0] = (eya_uchar_t)chars[v >> 18];
+        dst[1] = (eya_uchar_t)chars[v >> 12 & 63];
+        dst[2] = (eya_uchar_t)chars[v >> 6 & 63];
+        dst[3] = (eya_uchar_t)chars[v & 63];
+    }
+
+    if (!size)
+        return;
+
+    const eya_uint_t v = (eya_uint_t)src[0] << 16 | (size == 2 ? (eya_uint_t)src[1] << 8 : 0);
+
+    dst[0] = (eya_uchar_t)chars[v >> 18];
+    dst[1] = (eya_uchar_t)chars[v >> 12 & 63];
+
+    if (size == 2)
+        dst[2] = (eya_uchar_t)chars[v >> 6 & 63];
+
+    if (alphabet == EYA_BASE64_ALPHABET_STANDARD)
+    {
+        if (size == 1)
+            dst[2] = '=';
+        dst[3] = '=';
+    }
+}
+
+/**
+ * @brief Decodes groups of four characters, then the unpadded tail
+ * @param[in] size Number of characters without the padding, not 1 modulo 4
+ */
+static void
+eya_base64_decode_scalar(eya_uchar_t          *dst,
+                         const eya_uchar_t    *src,
+                         eya_usize_t           size,
+                         eya_base64_alphabet_t alphabet)
+{
+    const eya_uchar_t *values = eya_base64_values[alphabet];
+
+    for (; size >= 4; size -= 4, src += 4, dst += 3)
+    {
+        const eya_uint_t a = values[src[0]], b = values[src[1]];
+        const eya_uint_t c = values[src[2]], d = values[src[3]];
+
+        eya_runtime_check(!((a | b | c | d) & 0x80), EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+        const eya_uint_t v = a << 18 | b << 12 | c << 6 | d;
+
+        dst[0] = (eya_uchar_t)(v >> 16);
+        dst[1] = (eya_uchar_t)(v >> 8);
+        dst[2] = (eya_uchar_t)v;
+    }
+
+    if (!size)
+        return;
+
+    const eya_uint_t a = values[src[0]], b = values[src[1]];
+    const eya_uint_t c = size == 3 ? values[src[2]] : 0;
+    const eya_uint_t v = a << 18 | b << 12 | c << 6;
+
+    // The bits below the last whole byte must be clear.
+    eya_runtime_check(!((a | b | c) & 0x80) && !(v & (size == 2 ? 0xFFFF : 0xFF)),
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    dst[0] = (eya_uchar_t)(v >> 16);
+    if (size == 3)
+        dst[1] = (eya_uchar_t)(v >> 8);
+}
+
+#if (EYA_BASE64_X86)
+/**
+ * @brief Encodes 24 bytes per step
+ *
+ * Each 128-bit lane takes 12 bytes, which a shuffle spreads so that every
+ * 32-bit element holds three of them. Two multiplications move the four
+ * 6-bit fields into separate bytes, and a shuffle of per-range offsets
+ * turns the values into characters.
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static void
+eya_base64_encode_avx2(eya_uchar_t          *dst,
+                       const eya_uchar_t    *src,
+                       eya_usize_t           size,
+                       eya_base64_alphabet_t alphabet)
+{
+    const char    c62    = eya_base64_chars[alphabet][62];
+    const char    c63    = eya_base64_chars[alphabet][63];
+    const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+    // Indexed by the value ranges: 26-51, 52-61 (ten entries), 62, 63, then 0-25 at 13.
+    const __m256i offsets = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, (char)(c62 - 62), (char)(c63 - 63), 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, (char)(c62 - 62), (char)(c63 - 63), 'A', 0, 0);
+
+    // Loads read 4 bytes past the 24 they use.
+    for (; size >= 28; size -= 24, src += 24, dst += 32)
+    {
+        __m256i in = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)src)),
+            _mm_loadu_si128((const __m128i *)(src + 12)), 1);
+
+        in = _mm256_shuffle_epi8(in, spread);
+
+        const __m256i high = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)),
+                                                _mm256_set1_epi32(0x04000040));
+        const __m256i low  = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)),
+                                                _mm256_set1_epi32(0x01000010));
+        const __m256i values = _mm256_or_si256(high, low);
+
+        // 52-63 map to 1-12, 26-51 to 0, and 0-25 to 13.
+        const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), values);
+        const __m256i range = _mm256_or_si256(_mm256_subs_epu8(values, _mm256_set1_epi8(51)),
+                                              _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+
+        _mm256_storeu_si256((__m256i *)dst,
+                            _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, range)));
+    }
+
+    eya_base64_encode_scalar(dst, src, size, alphabet);
+}
+
+/**
+ * @brief Returns all ones in the bytes within [low, high]
+ *
+ * The comparison is signed, bytes from 0x80 up are never within an ASCII range.
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static __m256i
+eya_base64_within256(__m256i in, char low, char high)
+{
+    return _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8((char)(low - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(high + 1)), in));
+}
+
+/**
+ * @brief Decodes 32 characters per step
+ *
+ * Range checks select the offset that turns each character into its
+ * value, two multiply-adds pack four values into 24 bits, and shuffles
+ * gather the bytes. Blocks holding an invalid character are left to the
+ * scalar loop, which reports the error.
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static void
+eya_base64_decode_avx2(eya_uchar_t          *dst,
+                       const eya_uchar_t    *src,
+                       eya_usize_t           size,
+                       eya_base64_alphabet_t alphabet)
+{
+    const char    c62      = eya_base64_chars[alphabet][62];
+    const char    c63      = eya_base64_chars[alphabet][63];
+    const __m256i offset62 = _mm256_set1_epi8((char)(62 - c62));
+    const __m256i offset63 = _mm256_set1_epi8((char)(63 - c63));
+    const __m256i order    = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    const __m256i lanes    = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+    for (; size >= 32; size -= 32, src += 32, dst += 24)
+    {
+        const __m256i in = _mm256_loadu_si256((const __m256i *)src);
+
+        const __m256i upper = eya_base64_within256(in, 'A', 'Z');
+        const __m256i lower = eya_base64_within256(in, 'a', 'z');
+        const __m256i digit = eya_base64_within256(in, '0', '9');
+        const __m256i is62  = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(c62));
+        const __m256i is63  = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(c63));
+
+        const __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower),
+                                              _mm256_or_si256(digit, _mm256_or_si256(is62, is63)));
+
+        if (_mm256_movemask_epi8(valid) != -1)
+            break;
+
+        __m256i offset = _mm256_and_si256(upper, _mm256_set1_epi8(-'A'));
+        offset = _mm256_or_si256(offset, _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+        offset = _mm256_or_si256(offset, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+        offset = _mm256_or_si256(offset, _mm256_and_si256(is62, offset62));
+        offset = _mm256_or_si256(offset, _mm256_and_si256(is63, offset63));
+
+        const __m256i values = _mm256_add_epi8(in, offset);
+        const __m256i pairs  = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        const __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        const __m256i bytes =
+            _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(groups, order), lanes);
+
+        _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(bytes));
+        _mm_storel_epi64((__m128i *)(dst + 16), _mm256_extracti128_si256(bytes, 1));
+    }
+
+    eya_base64_decode_scalar(dst, src, size, alphabet);
+}
+#endif
+
+/**
+ * @brief Fills the tables and selects the implementation when the library is loaded
+ */
+eya_compiler_constructor(eya_base64_init)
+{
+    for (eya_usize_t alphabet = 0; alphabet < EYA_BASE64_ALPHABET_COUNT; ++alphabet)
+    {
+        for (eya_usize_t i = 0; i < 256; ++i)
+            eya_base64_values[alphabet][i] = 0xFF;
+
+        for (eya_uchar_t i = 0; i < 64; ++i)
+            eya_base64_values[alphabet][(eya_uchar_t)eya_base64_chars[alphabet][i]] = i;
+    }
+
+    eya_base64_set_cpu_features(EYA_UINT_T_MAX);
+}
+
+void
+eya_base64_set_cpu_features(eya_uint_t features)
+{
+#if (EYA_BASE64_X86)
+    eya_base64_has_avx2 = (features & eya_cpu_get_features() & EYA_CPU_FEATURE_AVX2) != 0;
+#else
+    (void)features;
+#endif
+}
+
+/**
+ * @brief Encodes with the selected implementation
+ */
+static void
+eya_base64_encode_block(eya_uchar_t          *dst,
+                        const eya_uchar_t    *src,
+                        eya_usize_t           size,
+                        eya_base64_alphabet_t alphabet)
+{
+#if (EYA_BASE64_X86)
+    if (eya_base64_has_avx2)
+    {
+        eya_base64_encode_avx2(dst, src, size, alphabet);
+        return;
+    }
+#endif
+
+    eya_base64_encode_scalar(dst, src, size, alphabet);
+}
+
+/**
+ * @brief Decodes with the selected implementation
+ * @param[in] size Number of characters without the padding
+ */
+static void
+eya_base64_decode_block(eya_uchar_t          *dst,
+                        const eya_uchar_t    *src,
+                        eya_usize_t           size,
+                        eya_base64_alphabet_t alphabet)
+{
+#if (EYA_BASE64_X86)
+    if (eya_base64_has_avx2)
+    {
+        eya_base64_decode_avx2(dst, src, size, alphabet);
+        return;
+    }
+#endif
+
+    eya_base64_decode_scalar(dst, src, size, alphabet);
+}
+
+/**
+ * @brief Returns the number of characters of a text without its padding
+ *
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If a single character is left after the last group of four
+ */
+static eya_usize_t
+eya_base64_unpadded_size(const eya_uchar_t *src, eya_usize_t size)
+{
+    // Padding is only recognized where the padded form puts it.
+    if (size && !(size & 3) && src[size - 1] == '=')
+    {
+        --size;
+        if (src[size - 1] == '=')
+            --size;
+    }
+
+    eya_runtime_check((size & 3) != 1, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+    return size;
+}
+
+/**
+ * @brief Returns the number of bytes decoded from unpadded characters
+ */
+static eya_usize_t
+eya_base64_decoded_size(eya_usize_t size)
+{
+    return size / 4 * 3 + (size & 3 ? (size & 3) - 1 : 0);
+}
+
+/**
+ * @brief Makes room for bytes at the end of a byte array
+ * @return Pointer to the first byte after the elements of the array
+ */
+static eya_uchar_t *
+eya_base64_reserve(eya_array_t *array, eya_usize_t size)
+{
+    eya_usize_t element_size;
+
+    eya_runtime_check_ref(array);
+    eya_array_unpack(array, nullptr, nullptr, &element_size, nullptr);
+    eya_runtime_check(element_size == 1, EYA_RUNTIME_ERROR_DIFFERENT_ELEMENT_SIZE);
+
+    eya_array_reserve(array, size);
+    return (eya_uchar_t *)eya_array_get_begin(array) + eya_array_get_size(array);
+}
+
+eya_usize_t
+eya_base64_encode_size(eya_usize_t size, eya_base64_alphabet_t alphabet)
+{
+    eya_base64_check_alphabet(alphabet);
+
+    const eya_usize_t rest = size % 3;
+    const eya_usize_t tail = !rest ? 0 : alphabet == EYA_BASE64_ALPHABET_STANDARD ? 4 : rest + 1;
+    eya_usize_t       result;
+
+    eya_runtime_check_if(eya_checked_mul(size / 3, 4, &result) ||
+                             eya_checked_add(result, tail, &result),
+                         EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE);
+    return result;
+}
+
+eya_usize_t
+eya_base64_decode_size(const eya_memory_range_t *src)
+{
+    const eya_usize_t size = eya_memory_range_get_size(src);
+    return eya_base64_decoded_size(eya_base64_unpadded_size(eya_memory_range_get_begin(src), size));
+}
+
+eya_usize_t
+eya_base64_encode(const eya_memory_range_t *dst,
+                  const eya_memory_range_t *src,
+                  eya_base64_alphabet_t     alphabet)
+{
+    const eya_usize_t size   = eya_memory_range_get_size(src);
+    const eya_usize_t result = eya_base64_encode_size(size, alphabet);
+
+    eya_runtime_check(eya_memory_range_get_size(dst) >= result, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+    eya_base64_encode_block(
+        eya_memory_range_get_begin(dst), eya_memory_range_get_begin(src), size, alphabet);
+    return result;
+}
+
+eya_usize_t
+eya_base64_decode(const eya_memory_range_t *dst,
+                  const eya_memory_range_t *src,
+                  eya_base64_alphabet_t     alphabet)
+{
+    eya_base64_check_alphabet(alphabet);
+
+    const eya_uchar_t *begin  = eya_memory_range_get_begin(src);
+    const eya_usize_t  size   = eya_base64_unpadded_size(begin, eya_memory_range_get_size(src));
+    const eya_usize_t  result = eya_base64_decoded_size(size);
+
+    eya_runtime_check(eya_memory_range_get_size(dst) >= result, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+    eya_base64_decode_block(eya_memory_range_get_begin(dst), begin, size, alphabet);
+    return result;
+}
+
+eya_usize_t
+eya_base64_encode_append(eya_array_t              *dst,
+                         const eya_memory_range_t *src,
+                         eya_base64_alphabet_t     alphabet)
+{
+    const eya_usize_t size   = eya_memory_range_get_size(src);
+    const eya_usize_t result = eya_base64_encode_size(size, alphabet);
+
+    eya_base64_encode_block(
+        eya_base64_reserve(dst, result), eya_memory_range_get_begin(src), size, alphabet);
+    eya_array_resize(dst, eya_array_get_size(dst) + result);
+    return result;
+}
+
+eya_usize_t
+eya_base64_decode_append(eya_array_t              *dst,
+                         const eya_memory_range_t *src,
+                         eya_base64_alphabet_t     alphabet)
+{
+    eya_base64_check_alphabet(alphabet);
+
+    const eya_uchar_t *begin  = eya_memory_range_get_begin(src);
+    const eya_usize_t  size   = eya_base64_unpadded_size(begin, eya_memory_range_get_size(src));
+    const eya_usize_t  result = eya_base64_decoded_size(size);
+
+    // The bytes go to the reserved capacity first, so an error leaves the size unchanged.
+    eya_base64_decode_block(eya_base64_reserve(dst, result), begin, size, alphabet);
+    eya_array_resize(dst, eya_array_get_size(dst) + result);
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,838 @@
+#include <eya/bit_range.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/numeric_limits.h>
+#include <eya/runtime_check.h>
+#include <eya/nullptr.h>
+#include <eya/cpu.h>
+#include <eya/bool.h>
+
+#if ((EYA_COMPILER_GCC_LIKE) && defined(__x86_64__)) ||                                            \
+    ((EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && defined(_M_X64))
+#    include <immintrin.h>
+#    define EYA_BIT_RANGE_X86 1
+#endif
+
+/**
+ * @brief Operation applied by the binary kernels
+ */
+typedef enum eya_bit_range_op
+{
+    EYA_BIT_RANGE_OP_AND,
+    EYA_BIT_RANGE_OP_OR,
+    EYA_BIT_RANGE_OP_XOR,
+    EYA_BIT_RANGE_OP_ANDNOT
+} eya_bit_range_op_t;
+
+#if (EYA_BIT_RANGE_X86)
+static bool eya_bit_range_has_avx512;
+static bool eya_bit_range_has_avx2;
+static bool eya_bit_range_has_bmi2;
+#endif
+
+/**
+ * @brief Reads a little-endian 64-bit value
+ *
+ * Compilers merge the byte loads into a single load on little-endian targets.
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_ullong_t
+eya_bit_range_read64(const eya_uchar_t *p)
+{
+    return (eya_ullong_t)p[0] | (eya_ullong_t)p[1] << 8 | (eya_ullong_t)p[2] << 16 |
+           (eya_ullong_t)p[3] << 24 | (eya_ullong_t)p[4] << 32 | (eya_ullong_t)p[5] << 40 |
+           (eya_ullong_t)p[6] << 48 | (eya_ullong_t)p[7] << 56;
+}
+
+/**
+ * @brief Writes a little-endian 64-bit value
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) void
+eya_bit_range_write64(eya_uchar_t *p, eya_ullong_t value)
+{
+    p[0] = (eya_uchar_t)value;
+    p[1] = (eya_uchar_t)(value >> 8);
+    p[2] = (eya_uchar_t)(value >> 16);
+    p[3] = (eya_uchar_t)(value >> 24);
+    p[4] = (eya_uchar_t)(value >> 32);
+    p[5] = (eya_uchar_t)(value >> 40);
+    p[6] = (eya_uchar_t)(value >> 48);
+    p[7] = (eya_uchar_t)(value >> 56);
+}
+
+/**
+ * @brief Reads fewer than 8 bytes as a little-endian value padded with zeros
+ */
+static eya_ullong_t
+eya_bit_range_read_tail(const eya_uchar_t *p, eya_usize_t size)
+{
+    eya_ullong_t value = 0;
+
+    for (eya_usize_t i = 0; i < size; ++i)
+        value |= (eya_ullong_t)p[i] << (8 * i);
+
+    return value;
+}
+
+/**
+ * @brief Writes the low bytes of a little-endian value
+ */
+static void
+eya_bit_range_write_tail(eya_uchar_t *p, eya_ullong_t value, eya_usize_t size)
+{
+    for (eya_usize_t i = 0; i < size; ++i)
+        p[i] = (eya_uchar_t)(value >> (8 * i));
+}
+
+/**
+ * @brief Counts the set bits of a word with shifts and masks
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_usize_t
+eya_bit_range_popcount64(eya_ullong_t x)
+{
+    x = x - (x >> 1 & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + (x >> 2 & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (eya_usize_t)((x * 0x0101010101010101ull) >> 56);
+}
+
+/**
+ * @brief Applies a binary operation to two words
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_ullong_t
+eya_bit_range_apply64(eya_ullong_t a, eya_ullong_t b, eya_bit_range_op_t op)
+{
+    switch (op)
+    {
+    case EYA_BIT_RANGE_OP_AND:
+        return a & b;
+    case EYA_BIT_RANGE_OP_OR:
+        return a | b;
+    case EYA_BIT_RANGE_OP_XOR:
+        return a ^ b;
+    default:
+        return a & ~b;
+    }
+}
+
+/**
+ * @brief Carry-save adder, adds three bit vectors into a sum and a carry
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) void
+eya_bit_range_csa64(eya_ullong_t *high, eya_ullong_t *low, eya_ullong_t a, eya_ullong_t b,
+                    eya_ullong_t c)
+{
+    const eya_ullong_t u = a ^ b;
+
+    *high = (a & b) | (u & c);
+    *low  = u ^ c;
+}
+
+/**
+ * @brief Counts set bits with the Harley–Seal network over 64-bit words
+ *
+ * Sixteen words are reduced by carry-save adders to counters of weights
+ * 1, 2, 4 and 8 and one word of weight 16, so that only one word in
+ * sixteen goes through a full population count.
+ */
+static eya_usize_t
+eya_bit_range_popcount_scalar(const eya_uchar_t *p, eya_usize_t size)
+{
+    eya_ullong_t ones = 0, twos = 0, fours = 0, eights = 0;
+    eya_ullong_t twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+    eya_usize_t  total = 0;
+
+    for (; size >= 128; size -= 128, p += 128)
+    {
+        eya_bit_range_csa64(&twos_a, &ones, ones, eya_bit_range_read64(p),
+                            eya_bit_range_read64(p + 8));
+        eya_bit_range_csa64(&twos_b, &ones, ones, eya_bit_range_read64(p + 16),
+                            eya_bit_range_read64(p + 24));
+        eya_bit_range_csa64(&fours_a, &twos, twos, twos_a, twos_b);
+        eya_bit_range_csa64(&twos_a, &ones, ones, eya_bit_range_read64(p + 32),
+                            eya_bit_range_read64(p + 40));
+        eya_bit_range_csa64(&twos_b, &ones, ones, eya_bit_range_read64(p + 48),
+                            eya_bit_range_read64(p + 56));
+        eya_bit_range_csa64(&fours_b, &twos, twos, twos_a, twos_b);
+        eya_bit_range_csa64(&eights_a, &fours, fours, fours_a, fours_b);
+        eya_bit_range_csa64(&twos_a, &ones, ones, eya_bit_range_read64(p + 64),
+                            eya_bit_range_read64(p + 72));
+        eya_bit_range_csa64(&twos_b, &ones, ones, eya_bit_range_read64(p + 80),
+                            eya_bit_range_read64(p + 88));
+        eya_bit_range_csa64(&fours_a, &twos, twos, twos_a, twos_b);
+        eya_bit_range_csa64(&twos_a, &ones, ones, eya_bit_range_read64(p + 96),
+                            eya_bit_range_read64(p + 104));
+        eya_bit_range_csa64(&twos_b, &ones, ones, eya_bit_range_read64(p + 112),
+                            eya_bit_range_read64(p + 120));
+        eya_bit_range_csa64(&fours_b, &twos, twos, twos_a, twos_b);
+        eya_bit_range_csa64(&eights_b, &fours, fours, fours_a, fours_b);
+        eya_bit_range_csa64(&sixteens, &eights, eights, eights_a, eights_b);
+
+        total += eya_bit_range_popcount64(sixteens);
+    }
+
+    total = 16 * total + 8 * eya_bit_range_popcount64(eights) +
+            4 * eya_bit_range_popcount64(fours) + 2 * eya_bit_range_popcount64(twos) +
+            eya_bit_range_popcount64(ones);
+
+    for (; size >= 8; size -= 8, p += 8)
+        total += eya_bit_range_popcount64(eya_bit_range_read64(p));
+
+    return total + eya_bit_range_popcount64(eya_bit_range_read_tail(p, size));
+}
+
+/**
+ * @brief Applies a binary operation word by word and counts the result
+ */
+static eya_usize_t
+eya_bit_range_op_scalar(eya_uchar_t        *dst,
+                        const eya_uchar_t  *a,
+                        const eya_uchar_t  *b,
+                        eya_usize_t         size,
+                        eya_bit_range_op_t  op)
+{
+    eya_usize_t total = 0;
+
+    for (; size >= 8; size -= 8, dst += 8, a += 8, b += 8)
+    {
+        const eya_ullong_t r =
+            eya_bit_range_apply64(eya_bit_range_read64(a), eya_bit_range_read64(b), op);
+
+        eya_bit_range_write64(dst, r);
+        total += eya_bit_range_popcount64(r);
+    }
+
+    const eya_ullong_t r = eya_bit_range_apply64(eya_bit_range_read_tail(a, size),
+                                                 eya_bit_range_read_tail(b, size), op);
+
+    eya_bit_range_write_tail(dst, r, size);
+    return total + eya_bit_range_popcount64(r);
+}
+
+#if (EYA_BIT_RANGE_X86)
+/**
+ * @brief Counts the set bits of each 64-bit lane with nibble lookups
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static __m256i
+eya_bit_range_popcount256(__m256i v)
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+
+    const __m256i low  = _mm256_and_si256(v, low_mask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    const __m256i bytes =
+        _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+/**
+ * @brief Carry-save adder over 256-bit vectors
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static void
+eya_bit_range_csa256(__m256i *high, __m256i *low, __m256i a, __m256i b, __m256i c)
+{
+    const __m256i u = _mm256_xor_si256(a, b);
+
+    *high = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    *low  = _mm256_xor_si256(u, c);
+}
+
+/**
+ * @brief Sums the four 64-bit lanes of a vector
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static eya_usize_t
+eya_bit_range_sum256(__m256i v)
+{
+    const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+
+    return (eya_usize_t)(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+}
+
+/**
+ * @brief Loads the i-th 256-bit vector of a block
+ */
+#    define EYA_BIT_RANGE_LOAD256(p, i) _mm256_loadu_si256((const __m256i *)(p) + (i))
+
+/**
+ * @brief Counts set bits with the Harley–Seal network over 256-bit vectors
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static eya_usize_t
+eya_bit_range_popcount_avx2(const eya_uchar_t *p, eya_usize_t size)
+{
+    __m256i ones = _mm256_setzero_si256(), twos = ones, fours = ones, eights = ones;
+    __m256i twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+    __m256i total = _mm256_setzero_si256();
+
+    for (; size >= 512; size -= 512, p += 512)
+    {
+        eya_bit_range_csa256(
+            &twos_a, &ones, ones, EYA_BIT_RANGE_LOAD256(p, 0), EYA_BIT_RANGE_LOAD256(p, 1));
+        eya_bit_range_csa256(
+            &twos_b, &ones, ones, EYA_BIT_RANGE_LOAD256(p, 2), EYA_BIT_RANGE_LOAD256(p, 3));
+        eya_bit_range_csa256(&fours_a, &twos, twos, twos_a, twos_b);
+        eya_bit_range_csa256(
+            &twos_a, &ones, ones, EYA_BIT_RANGE_LOAD256(p, 4), EYA_BIT_RANGE_LOAD256(p, 5));
+        eya_bit_range_csa256(
+            &twos_b, &ones, ones, EYA_BIT_RANGE_LOAD256(p, 6), EYA_BIT_RANGE_LOAD256(p, 7));
+        eya_bit_range_csa256(&fours_b, &twos, twos, twos_a, twos_b);
+        eya_bit_range_csa256(&eights_a, &fours, fours, fours_a, fours_b);
+        eya_bit_range_csa256(
+            &twos_a, &ones, ones, EYA_BIT_RANGE_LOAD256(p, 8), EYA_BIT_RANGE_LOAD256(p, 9));
+        eya_bit_range_csa256(
+            &twos_b, &ones, ones, EYA_BIT_RANGE_LOAD256(p, 10), EYA_BIT_RANGE_LOAD256(p, 11));
+        eya_bit_range_csa256(&fours_a, &twos, twos, twos_a, twos_b);
+        eya_bit_range_csa256(
+            &twos_a, &ones, ones, EYA_BIT_RANGE_LOAD256(p, 12), EYA_BIT_RANGE_LOAD256(p, 13));
+        eya_bit_range_csa256(
+            &twos_b, &ones, ones, EYA_BIT_RANGE_LOAD256(p, 14), EYA_BIT_RANGE_LOAD256(p, 15));
+        eya_bit_range_csa256(&fours_b, &twos, twos, twos_a, twos_b);
+        eya_bit_range_csa256(&eights_b, &fours, fours, fours_a, fours_b);
+        eya_bit_range_csa256(&sixteens, &eights, eights, eights_a, eights_b);
+
+        total = _mm256_add_epi64(total, eya_bit_range_popcount256(sixteens));
+    }
+
+    total = _mm256_slli_epi64(total, 4);
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(eya_bit_range_popcount256(eights), 3));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(eya_bit_range_popcount256(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(eya_bit_range_popcount256(twos), 1));
+    total = _mm256_add_epi64(total, eya_bit_range_popcount256(ones));
+
+    for (; size >= 32; size -= 32, p += 32)
+        total = _mm256_add_epi64(total, eya_bit_range_popcount256(EYA_BIT_RANGE_LOAD256(p, 0)));
+
+    return eya_bit_range_sum256(total) + eya_bit_range_popcount_scalar(p, size);
+}
+
+/**
+ * @brief Applies a binary operation to 256-bit vectors
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static __m256i
+eya_bit_range_apply256(__m256i a, __m256i b, eya_bit_range_op_t op)
+{
+    switch (op)
+    {
+    case EYA_BIT_RANGE_OP_AND:
+        return _mm256_and_si256(a, b);
+    case EYA_BIT_RANGE_OP_OR:
+        return _mm256_or_si256(a, b);
+    case EYA_BIT_RANGE_OP_XOR:
+        return _mm256_xor_si256(a, b);
+    default:
+        return _mm256_andnot_si256(b, a);
+    }
+}
+
+/**
+ * @brief Applies a binary operation over 256-bit vectors and counts the result
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static eya_usize_t
+eya_bit_range_op_avx2(eya_uchar_t        *dst,
+                      const eya_uchar_t  *a,
+                      const eya_uchar_t  *b,
+                      eya_usize_t         size,
+                      eya_bit_range_op_t  op)
+{
+    __m256i total = _mm256_setzero_si256();
+
+    for (; size >= 32; size -= 32, dst += 32, a += 32, b += 32)
+    {
+        const __m256i r =
+            eya_bit_range_apply256(EYA_BIT_RANGE_LOAD256(a, 0), EYA_BIT_RANGE_LOAD256(b, 0), op);
+
+        _mm256_storeu_si256((__m256i *)dst, r);
+        total = _mm256_add_epi64(total, eya_bit_range_popcount256(r));
+    }
+
+    return eya_bit_range_sum256(total) + eya_bit_range_op_scalar(dst, a, b, size, op);
+}
+
+/**
+ * @brief Counts set bits with `vpopcntq`
+ *
+ * Four accumulators hide the latency of the instruction.
+ */
+EYA_ATTRIBUTE(TARGET("avx512f,avx512vpopcntdq"))
+static eya_usize_t
+eya_bit_range_popcount_avx512(const eya_uchar_t *p, eya_usize_t size)
+{
+    __m512i total0 = _mm512_setzero_si512(), total1 = total0, total2 = total0, total3 = total0;
+
+    for (; size >= 256; size -= 256, p += 256)
+    {
+        total0 = _mm512_add_epi64(total0, _mm512_popcnt_epi64(_mm512_loadu_si512(p)));
+        total1 = _mm512_add_epi64(total1, _mm512_popcnt_epi64(_mm512_loadu_si512(p + 64)));
+        total2 = _mm512_add_epi64(total2, _mm512_popcnt_epi64(_mm512_loadu_si512(p + 128)));
+        total3 = _mm512_add_epi64(total3, _mm512_popcnt_epi64(_mm512_loadu_si512(p + 192)));
+    }
+
+    for (; size >= 64; size -= 64, p += 64)
+        total0 = _mm512_add_epi64(total0, _mm512_popcnt_epi64(_mm512_loadu_si512(p)));
+
+    total0 = _mm512_add_epi64(_mm512_add_epi64(total0, total1), _mm512_add_epi64(total2, total3));
+
+    return (eya_usize_t)_mm512_reduce_add_epi64(total0) + eya_bit_range_popcount_scalar(p, size);
+}
+
+/**
+ * @brief Applies a binary operation to 512-bit vectors
+ */
+EYA_ATTRIBUTE(TARGET("avx512f"))
+static __m512i
+eya_bit_range_apply512(__m512i a, __m512i b, eya_bit_range_op_t op)
+{
+    switch (op)
+    {
+    case EYA_BIT_RANGE_OP_AND:
+        return _mm512_and_si512(a, b);
+    case EYA_BIT_RANGE_OP_OR:
+        return _mm512_or_si512(a, b);
+    case EYA_BIT_RANGE_OP_XOR:
+        return _mm512_xor_si512(a, b);
+    default:
+        return _mm512_andnot_si512(b, a);
+    }
+}
+
+/**
+ * @brief Applies a binary operation over 512-bit vectors and counts the result
+ */
+EYA_ATTRIBUTE(TARGET("avx512f,avx512vpopcntdq"))
+static eya_usize_t
+eya_bit_range_op_avx512(eya_uchar_t        *dst,
+                        const eya_uchar_t  *a,
+                        const eya_uchar_t  *b,
+                        eya_usize_t         size,
+                        eya_bit_range_op_t  op)
+{
+    __m512i total = _mm512_setzero_si512();
+
+    for (; size >= 64; size -= 64, dst += 64, a += 64, b += 64)
+    {
+        const __m512i r =
+            eya_bit_range_apply512(_mm512_loadu_si512(a), _mm512_loadu_si512(b), op);
+
+        _mm512_storeu_si512(dst, r);
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(r));
+    }
+
+    return (eya_usize_t)_mm512_reduce_add_epi64(total) +
+           eya_bit_range_op_scalar(dst, a, b, size, op);
+}
+#endif
+
+/**
+ * @brief Selects the kernel of a binary operation
+ */
+static eya_usize_t
+eya_bit_range_op(void *dst, const void *a, const void *b, eya_usize_t size, eya_bit_range_op_t op)
+{
+    eya_runtime_check((dst && a && b) || !size, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+#if (EYA_BIT_RANGE_X86)
+    if (eya_bit_range_has_avx512)
+        return eya_bit_range_op_avx512(dst, a, b, size, op);
+    if (eya_bit_range_has_avx2)
+        return eya_bit_range_op_avx2(dst, a, b, size, op);
+#endif
+
+    return eya_bit_range_op_scalar(dst, a, b, size, op);
+}
+
+/**
+ * @brief Extracts the bits of a value selected by a mask, one set bit at a time
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_ullong_t
+eya_bit_range_pext_soft(eya_ullong_t value, eya_ullong_t mask)
+{
+    eya_ullong_t result = 0;
+
+    for (eya_ullong_t bit = 1; mask; bit <<= 1, mask &= mask - 1)
+        if (value & mask & (0 - mask))
+            result |= bit;
+
+    return result;
+}
+
+/**
+ * @brief Deposits the low bits of a value at the set bits of a mask, one at a time
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_ullong_t
+eya_bit_range_pdep_soft(eya_ullong_t value, eya_ullong_t mask)
+{
+    eya_ullong_t result = 0;
+
+    for (eya_ullong_t bit = 1; mask; bit <<= 1, mask &= mask - 1)
+        if (value & bit)
+            result |= mask & (0 - mask);
+
+    return result;
+}
+
+/**
+ * @brief Returns a mask of the n lowest bits, n being at most 64
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_ullong_t
+eya_bit_range_low_bits(eya_usize_t n)
+{
+    return n < 64 ? ((eya_ullong_t)1 << n) - 1 : ~(eya_ullong_t)0;
+}
+
+/**
+ * @brief Appends bits to a stream, storing each completed word
+ */
+typedef struct eya_bit_range_writer
+{
+    eya_uchar_t *p;
+    eya_ullong_t acc;
+    eya_usize_t  fill;
+} eya_bit_range_writer_t;
+
+/**
+ * @brief Appends the n low bits of a value, n being at most 64
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) void
+eya_bit_range_writer_put(eya_bit_range_writer_t *w, eya_ullong_t value, eya_usize_t n)
+{
+    if (!n)
+        return;
+
+    w->acc |= value << w->fill;
+
+    if (w->fill + n < 64)
+    {
+        w->fill += n;
+        return;
+    }
+
+    eya_bit_range_write64(w->p, w->acc);
+    w->p += 8;
+    w->acc = w->fill ? value >> (64 - w->fill) : 0;
+    w->fill += n - 64;
+}
+
+/**
+ * @brief Stores the bytes of the last, incomplete word
+ */
+static void
+eya_bit_range_writer_flush(eya_bit_range_writer_t *w)
+{
+    eya_bit_range_write_tail(w->p, w->acc, (w->fill + 7) / 8);
+}
+
+/**
+ * @brief Takes bits from a stream without reading past its end
+ */
+typedef struct eya_bit_range_reader
+{
+    const eya_uchar_t *p;
+    const eya_uchar_t *end;
+    eya_ullong_t       acc;
+    eya_usize_t        avail;
+} eya_bit_range_reader_t;
+
+/**
+ * @brief Takes the next n bits, n being at most 64
+ *
+ * Past the end of the stream the bits read as zeros.
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_ullong_t
+eya_bit_range_reader_get(eya_bit_range_reader_t *r, eya_usize_t n)
+{
+    eya_ullong_t value = 0;
+
+    for (eya_usize_t got = 0; got < n;)
+    {
+        if (!r->avail)
+        {
+            const eya_usize_t left = (eya_usize_t)(r->end - r->p);
+
+            if (left >= 8)
+            {
+                r->acc = eya_bit_range_read64(r->p);
+                r->p += 8;
+                r->avail = 64;
+            }
+            else if (left)
+            {
+                r->acc   = eya_bit_range_read_tail(r->p, left);
+                r->p     = r->end;
+                r->avail = 8 * left;
+            }
+            else
+                return value;
+        }
+
+        const eya_usize_t take = n - got < r->avail ? n - got : r->avail;
+
+        value |= (r->acc & eya_bit_range_low_bits(take)) << got;
+        r->acc = take < 64 ? r->acc >> take : 0;
+        r->avail -= take;
+        got += take;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Gathers the selected bits word by word with the given extraction
+ */
+#define EYA_BIT_RANGE_GATHER(dst, src, mask, size, pext, popcount)                                 \
+    do                                                                                             \
+    {                                                                                              \
+        eya_bit_range_writer_t w = {dst, 0, 0};                                                    \
+        eya_usize_t            n = 0;                                                              \
+                                                                                                   \
+        for (; size >= 8; size -= 8, src += 8, mask += 8)                                          \
+        {                                                                                          \
+            const eya_ullong_t m = eya_bit_range_read64(mask);                                     \
+            const eya_usize_t  k = popcount(m);                                                    \
+                                                                                                   \
+            eya_bit_range_writer_put(&w, pext(eya_bit_range_read64(src), m), k);                   \
+            n += k;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        const eya_ullong_t m = eya_bit_range_read_tail(mask, size);                                \
+        const eya_usize_t  k = popcount(m);                                                        \
+                                                                                                   \
+        eya_bit_range_writer_put(&w, pext(eya_bit_range_read_tail(src, size), m), k);              \
+        eya_bit_range_writer_flush(&w);                                                            \
+        return n + k;                                                                              \
+    } while (0)
+
+/**
+ * @brief Scatters the stream bits word by word with the given deposit
+ */
+#define EYA_BIT_RANGE_SCATTER(dst, src, stream, mask, size, pdep, popcount)                        \
+    do                                                                                             \
+    {                                                                                              \
+        eya_bit_range_reader_t r = {src, src + (stream), 0, 0};                                    \
+        eya_usize_t            n = 0;                                                              \
+                                                                                                   \
+        for (; size >= 8; size -= 8, dst += 8, mask += 8)                                          \
+        {                                                                                          \
+            const eya_ullong_t m = eya_bit_range_read64(mask);                                     \
+            const eya_usize_t  k = popcount(m);                                                    \
+                                                                                                   \
+            eya_bit_range_write64(dst, pdep(eya_bit_range_reader_get(&r, k), m));                  \
+            n += k;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        const eya_ullong_t m = eya_bit_range_read_tail(mask, size);                                \
+        const eya_usize_t  k = popcount(m);                                                        \
+                                                                                                   \
+        eya_bit_range_write_tail(dst, pdep(eya_bit_range_reader_get(&r, k), m), size);             \
+        return n + k;                                                                              \
+    } while (0)
+
+/**
+ * @brief Gathers the selected bits with the software extraction
+ */
+static eya_usize_t
+eya_bit_range_gather_soft(eya_uchar_t       *dst,
+                          const eya_uchar_t *src,
+                          const eya_uchar_t *mask,
+                          eya_usize_t        size)
+{
+    EYA_BIT_RANGE_GATHER(
+        dst, src, mask, size, eya_bit_range_pext_soft, eya_bit_range_popcount64);
+}
+
+/**
+ * @brief Scatters the stream bits with the software deposit
+ * @param[in] stream Size of the source stream in bytes
+ */
+static eya_usize_t
+eya_bit_range_scatter_soft(eya_uchar_t       *dst,
+                           const eya_uchar_t *src,
+                           eya_usize_t        stream,
+                           const eya_uchar_t *mask,
+                           eya_usize_t        size)
+{
+    EYA_BIT_RANGE_SCATTER(
+        dst, src, stream, mask, size, eya_bit_range_pdep_soft, eya_bit_range_popcount64);
+}
+
+#if (EYA_BIT_RANGE_X86)
+/**
+ * @brief Counts the set bits of a word with `popcnt`
+ */
+EYA_ATTRIBUTE(TARGET("popcnt"))
+static eya_usize_t
+eya_bit_range_popcnt64(eya_ullong_t x)
+{
+    return (eya_usize_t)_mm_popcnt_u64(x);
+}
+
+/**
+ * @brief Extracts the bits of a value selected by a mask with `pext`
+ */
+EYA_ATTRIBUTE(TARGET("bmi2"))
+static eya_ullong_t
+eya_bit_range_pext_bmi2(eya_ullong_t value, eya_ullong_t mask)
+{
+    return _pext_u64(value, mask);
+}
+
+/**
+ * @brief Deposits the low bits of a value at the bits of a mask with `pdep`
+ */
+EYA_ATTRIBUTE(TARGET("bmi2"))
+static eya_ullong_t
+eya_bit_range_pdep_bmi2(eya_ullong_t value, eya_ullong_t mask)
+{
+    return _pdep_u64(value, mask);
+}
+
+/**
+ * @brief Gathers the selected bits with `pext`
+ */
+EYA_ATTRIBUTE(TARGET("bmi2,popcnt"))
+static eya_usize_t
+eya_bit_range_gather_bmi2(eya_uchar_t       *dst,
+                          const eya_uchar_t *src,
+                          const eya_uchar_t *mask,
+                          eya_usize_t        size)
+{
+    EYA_BIT_RANGE_GATHER(dst, src, mask, size, eya_bit_range_pext_bmi2, eya_bit_range_popcnt64);
+}
+
+/**
+ * @brief Scatters the stream bits with `pdep`
+ * @param[in] stream Size of the source stream in bytes
+ */
+EYA_ATTRIBUTE(TARGET("bmi2,popcnt"))
+static eya_usize_t
+eya_bit_range_scatter_bmi2(eya_uchar_t       *dst,
+                           const eya_uchar_t *src,
+                           eya_usize_t        stream,
+                           const eya_uchar_t *mask,
+                           eya_usize_t        size)
+{
+    EYA_BIT_RANGE_SCATTER(
+        dst, src, stream, mask, size, eya_bit_range_pdep_bmi2, eya_bit_range_popcnt64);
+}
+#endif
+
+/**
+ * @brief Selects the implementations when the library is loaded
+ */
+eya_compiler_constructor(eya_bit_range_init)
+{
+    eya_bit_range_set_cpu_features(EYA_UINT_T_MAX);
+}
+
+void
+eya_bit_range_set_cpu_features(eya_uint_t features)
+{
+#if (EYA_BIT_RANGE_X86)
+    const eya_uint_t avx512 = EYA_CPU_FEATURE_AVX512F | EYA_CPU_FEATURE_AVX512VPOPCNTDQ;
+    const eya_uint_t bmi2   = EYA_CPU_FEATURE_BMI2 | EYA_CPU_FEATURE_POPCNT;
+
+    features &= eya_cpu_get_features();
+
+    eya_bit_range_has_avx512 = (features & avx512) == avx512;
+    eya_bit_range_has_avx2   = (features & EYA_CPU_FEATURE_AVX2) != 0;
+    eya_bit_range_has_bmi2   = (features & bmi2) == bmi2;
+#else
+    (void)features;
+#endif
+}
+
+eya_usize_t
+eya_bit_range_popcount(const void *data, eya_usize_t size)
+{
+    eya_runtime_check(data || !size, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+#if (EYA_BIT_RANGE_X86)
+    if (eya_bit_range_has_avx512)
+        return eya_bit_range_popcount_avx512(data, size);
+    if (eya_bit_range_has_avx2)
+        return eya_bit_range_popcount_avx2(data, size);
+#endif
+
+    return eya_bit_range_popcount_scalar(data, size);
+}
+
+eya_usize_t
+eya_bit_range_and(void *dst, const void *a, const void *b, eya_usize_t size)
+{
+    return eya_bit_range_op(dst, a, b, size, EYA_BIT_RANGE_OP_AND);
+}
+
+eya_usize_t
+eya_bit_range_or(void *dst, const void *a, const void *b, eya_usize_t size)
+{
+    return eya_bit_range_op(dst, a, b, size, EYA_BIT_RANGE_OP_OR);
+}
+
+eya_usize_t
+eya_bit_range_xor(void *dst, const void *a, const void *b, eya_usize_t size)
+{
+    return eya_bit_range_op(dst, a, b, size, EYA_BIT_RANGE_OP_XOR);
+}
+
+eya_usize_t
+eya_bit_range_andnot(void *dst, const void *a, const void *b, eya_usize_t size)
+{
+    return eya_bit_range_op(dst, a, b, size, EYA_BIT_RANGE_OP_ANDNOT);
+}
+
+eya_ullong_t
+eya_bit_pext64(eya_ullong_t value, eya_ullong_t mask)
+{
+#if (EYA_BIT_RANGE_X86)
+    if (eya_bit_range_has_bmi2)
+        return eya_bit_range_pext_bmi2(value, mask);
+#endif
+
+    return eya_bit_range_pext_soft(value, mask);
+}
+
+eya_ullong_t
+eya_bit_pdep64(eya_ullong_t value, eya_ullong_t mask)
+{
+#if (EYA_BIT_RANGE_X86)
+    if (eya_bit_range_has_bmi2)
+        return eya_bit_range_pdep_bmi2(value, mask);
+#endif
+
+    return eya_bit_range_pdep_soft(value, mask);
+}
+
+eya_usize_t
+eya_bit_range_gather(void *dst, const void *src, const void *mask, eya_usize_t size)
+{
+    eya_runtime_check((dst && src && mask) || !size, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+#if (EYA_BIT_RANGE_X86)
+    if (eya_bit_range_has_bmi2)
+        return eya_bit_range_gather_bmi2(dst, src, mask, size);
+#endif
+
+    return eya_bit_range_gather_soft(dst, src, mask, size);
+}
+
+eya_usize_t
+eya_bit_range_scatter(void *dst, const void *src, const void *mask, eya_usize_t size)
+{
+    eya_runtime_check((dst && src && mask) || !size, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+    // The stream is read word by word, so its end must be known up front.
+    const eya_usize_t stream = (eya_bit_range_popcount(mask, size) + 7) / 8;
+
+#if (EYA_BIT_RANGE_X86)
+    if (eya_bit_range_has_bmi2)
+        return eya_bit_range_scatter_bmi2(dst, src, stream, mask, size);
+#endif
+
+    return eya_bit_range_scatter_soft(dst, src, stream, mask, size);
+}
\ No newline at end of file
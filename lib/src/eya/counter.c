@@ -0,0 +1,238 @@
+#include <eya/counter.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/nullptr.h>
+#include <eya/bool.h>
+
+#if (EYA_LIBRARY_OPTION_THREAD_LOCAL == EYA_LIBRARY_OPTION_ON)
+#    if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+#        include <windows.h>
+#    else
+#        include <pthread.h>
+#    endif
+
+/**
+ * @def EYA_COUNTER_SLOT_RELEASED
+ * @brief Value of `m_counter_slot` once the thread has given its slot back
+ *
+ * Updates made after that, by other thread-exit code, go to the overflow slot.
+ */
+#    define EYA_COUNTER_SLOT_RELEASED (EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT + 1)
+
+/**
+ * @var m_counter_owned
+ * @brief Nonzero for every slot index held by a running thread
+ */
+static eya_atomic_usize_t m_counter_owned[EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT];
+
+/**
+ * @var m_counter_slot
+ * @brief Slot index of the calling thread plus one, 0 until its first update
+ */
+EYA_ATTRIBUTE(THREAD_LOCAL)
+eya_usize_t m_counter_slot;
+
+/**
+ * @brief Gives the slot of an exiting thread back, so a later thread can own it
+ *
+ * The value in the slot stays, the next owner keeps adding to it. The release
+ * pairs with the acquire of the next owner, which then sees the last value stored.
+ */
+static void
+eya_counter_release(void)
+{
+    const eya_usize_t slot = m_counter_slot;
+
+    m_counter_slot = EYA_COUNTER_SLOT_RELEASED;
+    if (slot && slot <= EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT)
+        eya_atomic_store(&m_counter_owned[slot - 1], 0, EYA_ATOMIC_RELEASE);
+}
+
+#    if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+/**
+ * @var m_counter_once
+ * @brief Guards the creation of the thread exit callback
+ */
+static INIT_ONCE m_counter_once = INIT_ONCE_STATIC_INIT;
+
+/**
+ * @var m_counter_key
+ * @brief Fiber-local index whose callback releases the slot, `FLS_OUT_OF_INDEXES` if unavailable
+ */
+static DWORD m_counter_key = FLS_OUT_OF_INDEXES;
+
+static void WINAPI
+eya_counter_on_exit(void *value)
+{
+    if (value)
+        eya_counter_release();
+}
+
+static BOOL CALLBACK
+eya_counter_create_key(PINIT_ONCE once, void *param, void **context)
+{
+    (void)once;
+    (void)param;
+    (void)context;
+    m_counter_key = FlsAlloc(eya_counter_on_exit);
+    return TRUE;
+}
+
+/**
+ * @brief Arranges for the slot to be released when the calling thread exits
+ */
+static void
+eya_counter_watch_exit(void)
+{
+    InitOnceExecuteOnce(&m_counter_once, eya_counter_create_key, nullptr, nullptr);
+    if (m_counter_key != FLS_OUT_OF_INDEXES)
+        FlsSetValue(m_counter_key, (void *)1);
+}
+#    else
+/**
+ * @var m_counter_once
+ * @brief Guards the creation of the thread exit key
+ */
+static pthread_once_t m_counter_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @var m_counter_key
+ * @brief Key whose destructor releases the slot, valid if `m_counter_key_valid` is set
+ */
+static pthread_key_t m_counter_key;
+
+/**
+ * @var m_counter_key_valid
+ * @brief Tells whether `m_counter_key` was created
+ */
+static bool m_counter_key_valid;
+
+static void
+eya_counter_on_exit(void *value)
+{
+    (void)value;
+    eya_counter_release();
+}
+
+static void
+eya_counter_create_key(void)
+{
+    m_counter_key_valid = pthread_key_create(&m_counter_key, eya_counter_on_exit) == 0;
+}
+
+/**
+ * @brief Arranges for the slot to be released when the calling thread exits
+ */
+static void
+eya_counter_watch_exit(void)
+{
+    pthread_once(&m_counter_once, eya_counter_create_key);
+    if (m_counter_key_valid)
+        pthread_setspecific(m_counter_key, &m_counter_key_valid);
+}
+#    endif
+
+/**
+ * @brief Takes the first slot no running thread holds
+ * @return Slot index plus one, or @ref EYA_COUNTER_SLOT_RELEASED if all are held
+ */
+static eya_usize_t
+eya_counter_claim(void)
+{
+    for (eya_usize_t i = 0; i < EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT; ++i)
+    {
+        eya_usize_t expected = 0;
+
+        if (!eya_atomic_load(&m_counter_owned[i], EYA_ATOMIC_RELAXED) &&
+            eya_atomic_compare_exchange(
+                &m_counter_owned[i], &expected, 1, EYA_ATOMIC_ACQUIRE, EYA_ATOMIC_RELAXED))
+        {
+            eya_counter_watch_exit();
+            return i + 1;
+        }
+    }
+
+    return EYA_COUNTER_SLOT_RELEASED;
+}
+#endif
+
+/**
+ * @brief Returns the slot index of the calling thread
+ * @return Index of an owned slot, or a value past the slots for the overflow slot
+ *
+ * A thread that finds every slot held uses the overflow slot until it exits,
+ * rather than searching the slots again on every update.
+ */
+static eya_usize_t
+eya_counter_slot(void)
+{
+#if (EYA_LIBRARY_OPTION_THREAD_LOCAL == EYA_LIBRARY_OPTION_ON)
+    eya_usize_t slot = m_counter_slot;
+
+    if (!slot)
+    {
+        slot           = eya_counter_claim();
+        m_counter_slot = slot;
+    }
+
+    return slot - 1;
+#else
+    return EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT;
+#endif
+}
+
+void
+eya_counter_init(eya_counter_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    for (eya_usize_t i = 0; i < EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT; ++i)
+        eya_atomic_store(&self->slots[i].value, 0, EYA_ATOMIC_RELAXED);
+
+    eya_atomic_store(&self->overflow.value, 0, EYA_ATOMIC_RELAXED);
+}
+
+void
+eya_counter_add(eya_counter_t *self, eya_usize_t value)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_usize_t slot = eya_counter_slot();
+
+    if (slot < EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT)
+    {
+        // Only the owner writes the slot, readers just need an untorn value.
+        eya_atomic_usize_t *cell = &self->slots[slot].value;
+        const eya_usize_t   sum  = eya_atomic_load(cell, EYA_ATOMIC_RELAXED) + value;
+
+        eya_atomic_store(cell, sum, EYA_ATOMIC_RELAXED);
+    }
+    else
+    {
+        eya_atomic_fetch_add(&self->overflow.value, value, EYA_ATOMIC_RELAXED);
+    }
+}
+
+void
+eya_counter_sub(eya_counter_t *self, eya_usize_t value)
+{
+    eya_counter_add(self, (eya_usize_t)0 - value);
+}
+
+void
+eya_counter_increment(eya_counter_t *self)
+{
+    eya_counter_add(self, 1);
+}
+
+eya_usize_t
+eya_counter_get(const eya_counter_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    eya_usize_t sum = eya_atomic_load(&self->overflow.value, EYA_ATOMIC_RELAXED);
+    for (eya_usize_t i = 0; i < EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT; ++i)
+        sum += eya_atomic_load(&self->slots[i].value, EYA_ATOMIC_RELAXED);
+
+    return sum;
+}
\ No newline at end of file
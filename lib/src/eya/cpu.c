@@ -0,0 +1,106 @@
+#include <eya/cpu.h>
+
+#if ((EYA_COMPILER_GCC_LIKE) && defined(__x86_64__)) ||                                            \
+    ((EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && defined(_M_X64))
+#    if (EYA_COMPILER_GCC_LIKE)
+#        include <cpuid.h>
+#    else
+#        include <immintrin.h>
+#        include <intrin.h>
+#    endif
+#    define EYA_CPU_X86 1
+#endif
+
+#if (EYA_CPU_X86)
+/**
+ * @brief Executes `cpuid` for a leaf and subleaf
+ * @param[out] regs EAX, EBX, ECX and EDX
+ */
+static void
+eya_cpu_cpuid(eya_uint_t leaf, eya_uint_t subleaf, eya_uint_t *regs)
+{
+#    if (EYA_COMPILER_GCC_LIKE)
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#    else
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; ++i)
+        regs[i] = (eya_uint_t)info[i];
+#    endif
+}
+
+/**
+ * @brief Returns the register states the operating system saves (XCR0)
+ */
+static eya_ullong_t
+eya_cpu_xcr0(void)
+{
+#    if (EYA_COMPILER_GCC_LIKE)
+    eya_uint_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (eya_ullong_t)edx << 32 | eax;
+#    else
+    return _xgetbv(0);
+#    endif
+}
+#endif
+
+eya_uint_t
+eya_cpu_get_features(void)
+{
+    eya_uint_t features = 0;
+
+#if (EYA_CPU_X86)
+    eya_uint_t regs[4];
+
+    eya_cpu_cpuid(0, 0, regs);
+    const eya_uint_t max_leaf = regs[0];
+
+    eya_cpu_cpuid(1, 0, regs);
+    const eya_uint_t ecx1 = regs[2];
+
+    if (ecx1 >> 20 & 1)
+        features |= EYA_CPU_FEATURE_SSE4_2;
+    if (ecx1 >> 1 & 1)
+        features |= EYA_CPU_FEATURE_PCLMUL;
+    if (ecx1 >> 23 & 1)
+        features |= EYA_CPU_FEATURE_POPCNT;
+
+    // Vector extensions also need the operating system to save their registers.
+    const bool        osxsave = ecx1 >> 27 & 1;
+    const eya_ullong_t xcr0   = osxsave ? eya_cpu_xcr0() : 0;
+    const bool        avx     = (ecx1 >> 28 & 1) && (xcr0 & 0x06) == 0x06;
+    const bool        avx512  = avx && (xcr0 & 0xE0) == 0xE0;
+
+    if (max_leaf < 7)
+        return features;
+
+    eya_cpu_cpuid(7, 0, regs);
+    const eya_uint_t ebx7 = regs[1];
+    const eya_uint_t ecx7 = regs[2];
+
+    if (ebx7 >> 8 & 1)
+        features |= EYA_CPU_FEATURE_BMI2;
+    if (avx && (ebx7 >> 5 & 1))
+        features |= EYA_CPU_FEATURE_AVX2;
+
+    if (avx512 && (ebx7 >> 16 & 1))
+    {
+        features |= EYA_CPU_FEATURE_AVX512F;
+        if (ebx7 >> 30 & 1)
+            features |= EYA_CPU_FEATURE_AVX512BW;
+        if (ecx7 >> 14 & 1)
+            features |= EYA_CPU_FEATURE_AVX512VPOPCNTDQ;
+        if (ecx7 >> 1 & 1)
+            features |= EYA_CPU_FEATURE_AVX512VBMI;
+    }
+#endif
+
+    return features;
+}
+
+bool
+eya_cpu_has(eya_uint_t features)
+{
+    return (eya_cpu_get_features() & features) == features;
+}
\ No newline at end of file
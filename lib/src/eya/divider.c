@@ -0,0 +1,56 @@
+#include <eya/divider.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_check_ref.h>
+
+void
+eya_divider_init(eya_divider_t *self, eya_usize_t divisor)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(divisor, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    const eya_usize_t width = sizeof(eya_usize_t) * 8;
+    eya_usize_t       log2  = 0;
+
+    while (divisor >> log2 > 1)
+        ++log2;
+
+    self->divisor = divisor;
+    self->magic   = 0;
+    self->shift   = log2;
+    self->add     = false;
+
+    if (!(divisor & (divisor - 1)))
+        return;
+
+    // Long division of 2^(width + log2) by the divisor, one quotient bit per step.
+    eya_usize_t quotient  = 0;
+    eya_usize_t remainder = (eya_usize_t)1 << log2;
+
+    for (eya_usize_t i = 0; i < width; ++i)
+    {
+        const bool carry = remainder >> (width - 1);
+
+        remainder <<= 1;
+        quotient <<= 1;
+        if (carry || remainder >= divisor)
+        {
+            remainder -= divisor;
+            quotient |= 1;
+        }
+    }
+
+    // The multiplier is exact enough unless the rounding error reaches 2^log2,
+    // then it takes one more bit, which the add-and-halve step supplies.
+    if (divisor - remainder >= (eya_usize_t)1 << log2)
+    {
+        const eya_usize_t twice = remainder << 1;
+
+        quotient += quotient;
+        if (twice >= divisor || twice < remainder)
+            ++quotient;
+        self->add = true;
+    }
+
+    self->magic = quotient + 1;
+}
\ No newline at end of file
@@ -0,0 +1,339 @@
+#include <eya/ebr.h>
+
+#include <eya/runtime_allocator.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/addr_util.h>
+#include <eya/attribute.h>
+#include <eya/ptr_util.h>
+#include <eya/nullptr.h>
+
+/**
+ * @brief Low bit of a record state, set while a critical section uses the record
+ */
+#define EYA_EBR_ACTIVE 1
+
+/**
+ * @brief Batch of retired pointers
+ */
+typedef struct eya_ebr_batch
+{
+    struct eya_ebr_batch *next;  /**< Next closed batch of the record */
+    eya_usize_t           epoch; /**< Global epoch when the batch was closed */
+    eya_usize_t           size;  /**< Number of pointers */
+    void                 *ptrs[EYA_LIBRARY_OPTION_EBR_BATCH_SIZE]; /**< Retired pointers */
+} eya_ebr_batch_t;
+
+/**
+ * @brief Announcement and retire lists used by one critical section at a time
+ */
+typedef struct eya_ebr_record
+{
+    eya_atomic_usize_t     state;   /**< 0 when free, otherwise the epoch shifted left and active */
+    struct eya_ebr_record *next;    /**< Next record of the domain */
+    eya_ebr_t             *domain;  /**< Domain of the record */
+    eya_ebr_batch_t       *pending; /**< Batch being filled */
+    eya_ebr_batch_t       *head;    /**< Oldest closed batch */
+    eya_ebr_batch_t       *tail;    /**< Newest closed batch */
+    eya_ebr_batch_t       *spare;   /**< Empty batch kept for reuse */
+} eya_ebr_record_t;
+
+/**
+ * @var m_ebr_domain_count
+ * @brief Number of initialized domains, source of the domain ids
+ */
+static eya_atomic_usize_t m_ebr_domain_count;
+
+#if (EYA_LIBRARY_OPTION_THREAD_LOCAL == EYA_LIBRARY_OPTION_ON)
+/**
+ * @brief Record the calling thread used last
+ */
+typedef struct eya_ebr_hint
+{
+    const eya_ebr_t  *domain; /**< Domain of the record */
+    eya_usize_t       id;     /**< Id of the domain, tells a reused address apart */
+    eya_ebr_record_t *record; /**< Record to claim first */
+} eya_ebr_hint_t;
+
+/**
+ * @var m_ebr_hint
+ * @brief Record the calling thread claims first
+ *
+ * Without thread-local storage every thread would share the hint,
+ * so records are then always searched from the head of the list.
+ */
+EYA_ATTRIBUTE(THREAD_LOCAL)
+eya_ebr_hint_t m_ebr_hint;
+#endif
+
+/**
+ * @brief Claims a free record for a critical section that saw the given epoch
+ */
+static bool
+eya_ebr_record_claim(eya_ebr_record_t *record, eya_usize_t epoch)
+{
+    eya_usize_t expected = 0;
+    return eya_atomic_compare_exchange(&record->state,
+                                       &expected,
+                                       (epoch << 1) | EYA_EBR_ACTIVE,
+                                       EYA_ATOMIC_SEQ_CST,
+                                       EYA_ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Claims the first free record of a domain or adds a new one
+ */
+static eya_ebr_record_t *
+eya_ebr_record_acquire(eya_ebr_t *self, eya_usize_t epoch)
+{
+    eya_ebr_record_t *record = eya_atomic_load(&self->records, EYA_ATOMIC_ACQUIRE);
+
+    for (; record; record = record->next)
+    {
+        if (eya_ebr_record_claim(record, epoch))
+            return record;
+    }
+
+    // Records never leave the list, so a whole cache line keeps them apart.
+    record = eya_memory_allocator_alloc_aligned(
+        &self->allocator,
+        eya_addr_align_up(sizeof(eya_ebr_record_t), EYA_ATOMIC_CACHE_LINE_SIZE),
+        EYA_ATOMIC_CACHE_LINE_SIZE);
+
+    record->domain  = self;
+    record->pending = nullptr;
+    record->head    = nullptr;
+    record->tail    = nullptr;
+    record->spare   = nullptr;
+    eya_atomic_store(&record->state, (epoch << 1) | EYA_EBR_ACTIVE, EYA_ATOMIC_RELAXED);
+
+    eya_ebr_record_t *head = eya_atomic_load(&self->records, EYA_ATOMIC_RELAXED);
+    do
+    {
+        record->next = head;
+    } while (!eya_atomic_compare_exchange_weak(
+        &self->records, (void **)&head, record, EYA_ATOMIC_SEQ_CST, EYA_ATOMIC_RELAXED));
+
+    return record;
+}
+
+/**
+ * @brief Frees the pointers of a batch and keeps the batch as the spare one if possible
+ */
+static void
+eya_ebr_batch_release(eya_ebr_record_t *record, eya_ebr_batch_t *batch)
+{
+    const eya_memory_allocator_t *allocator = &record->domain->allocator;
+
+    for (eya_usize_t i = 0; i < batch->size; ++i)
+        eya_memory_allocator_free(allocator, batch->ptrs[i]);
+
+    if (record->spare)
+    {
+        eya_memory_allocator_free(allocator, batch);
+        return;
+    }
+
+    batch->size   = 0;
+    record->spare = batch;
+}
+
+/**
+ * @brief Moves the global epoch forward if every active section announced it
+ */
+static void
+eya_ebr_advance(eya_ebr_t *self)
+{
+    eya_usize_t epoch = eya_atomic_load(&self->epoch, EYA_ATOMIC_RELAXED);
+
+    // Pairs with the fence of eya_ebr_enter(): either the scan sees the announcement,
+    // or the section sees every unlink made before this advance.
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+
+    eya_ebr_record_t *record = eya_atomic_load(&self->records, EYA_ATOMIC_ACQUIRE);
+    for (; record; record = record->next)
+    {
+        const eya_usize_t state = eya_atomic_load(&record->state, EYA_ATOMIC_ACQUIRE);
+        eya_runtime_return_if((state & EYA_EBR_ACTIVE) && (state >> 1) != epoch);
+    }
+
+    eya_atomic_compare_exchange(
+        &self->epoch, &epoch, epoch + 1, EYA_ATOMIC_ACQ_REL, EYA_ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Appends the pending batch of a record to its closed batches
+ */
+static void
+eya_ebr_close(eya_ebr_record_t *record)
+{
+    eya_ebr_batch_t *batch = record->pending;
+    eya_runtime_return_ifn(batch && batch->size);
+
+    // The stamp is read after the pointers were unlinked, so every section
+    // that may still reach them announced this epoch or an older one.
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+    batch->epoch = eya_atomic_load(&record->domain->epoch, EYA_ATOMIC_RELAXED);
+    batch->next  = nullptr;
+
+    if (record->tail)
+        record->tail->next = batch;
+    else
+        record->head = batch;
+
+    record->tail    = batch;
+    record->pending = nullptr;
+}
+
+/**
+ * @brief Frees the closed batches of a record that expired by the given epoch
+ */
+static void
+eya_ebr_reclaim(eya_ebr_record_t *record, eya_usize_t epoch)
+{
+    while (record->head && record->head->epoch + 2 <= epoch)
+    {
+        eya_ebr_batch_t *batch = record->head;
+
+        record->head = batch->next;
+        if (!record->head)
+            record->tail = nullptr;
+
+        eya_ebr_batch_release(record, batch);
+    }
+}
+
+/**
+ * @brief Tries to advance the epoch and frees the expired batches of every record
+ *
+ * A thread that stops entering sections leaves its batches in its record,
+ * so the free records are claimed with the same compare-and-swap as a section
+ * and their batches closed and collected here, instead of waiting for the
+ * record to be used again or for the domain to be destroyed.
+ */
+static void
+eya_ebr_collect(eya_ebr_record_t *record)
+{
+    eya_ebr_advance(record->domain);
+
+    const eya_usize_t epoch = eya_atomic_load(&record->domain->epoch, EYA_ATOMIC_ACQUIRE);
+    eya_ebr_reclaim(record, epoch);
+
+    eya_ebr_record_t *other = eya_atomic_load(&record->domain->records, EYA_ATOMIC_ACQUIRE);
+    for (; other; other = other->next)
+    {
+        if (other == record || !eya_ebr_record_claim(other, epoch))
+            continue;
+
+        eya_ebr_close(other);
+        eya_ebr_reclaim(other, epoch);
+        eya_atomic_store(&other->state, 0, EYA_ATOMIC_RELEASE);
+    }
+}
+
+void
+eya_ebr_init(eya_ebr_t *self, const eya_memory_allocator_t *allocator)
+{
+    eya_runtime_check_ref(self);
+
+    self->allocator = allocator ? *allocator : *eya_runtime_allocator();
+    self->id        = eya_atomic_fetch_add(&m_ebr_domain_count, 1, EYA_ATOMIC_RELAXED) + 1;
+    eya_atomic_store(&self->records, nullptr, EYA_ATOMIC_RELAXED);
+    eya_atomic_store(&self->epoch, 0, EYA_ATOMIC_RELAXED);
+}
+
+void
+eya_ebr_destroy(eya_ebr_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    eya_ebr_record_t *record = eya_atomic_load(&self->records, EYA_ATOMIC_ACQUIRE);
+    while (record)
+    {
+        eya_ebr_record_t *next = record->next;
+
+        eya_ebr_close(record);
+        while (record->head)
+        {
+            eya_ebr_batch_t *batch = record->head;
+            record->head           = batch->next;
+            eya_ebr_batch_release(record, batch);
+        }
+
+        eya_memory_allocator_free(&self->allocator, record->pending);
+        eya_memory_allocator_free(&self->allocator, record->spare);
+        eya_memory_allocator_free_aligned(&self->allocator, record);
+        record = next;
+    }
+
+    eya_atomic_store(&self->records, nullptr, EYA_ATOMIC_RELAXED);
+}
+
+eya_ebr_guard_t *
+eya_ebr_enter(eya_ebr_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_usize_t epoch = eya_atomic_load(&self->epoch, EYA_ATOMIC_RELAXED);
+    eya_ebr_record_t *record;
+
+#if (EYA_LIBRARY_OPTION_THREAD_LOCAL == EYA_LIBRARY_OPTION_ON)
+    record = m_ebr_hint.record;
+
+    if (m_ebr_hint.domain != self || m_ebr_hint.id != self->id ||
+        !eya_ebr_record_claim(record, epoch))
+    {
+        record            = eya_ebr_record_acquire(self, epoch);
+        m_ebr_hint.domain = self;
+        m_ebr_hint.id     = self->id;
+        m_ebr_hint.record = record;
+    }
+#else
+    record = eya_ebr_record_acquire(self, epoch);
+#endif
+
+    // Orders the announcement before every load of the protected structure.
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+    return record;
+}
+
+void
+eya_ebr_exit(eya_ebr_guard_t *guard)
+{
+    eya_runtime_check_ref(guard);
+    eya_atomic_store(&guard->state, 0, EYA_ATOMIC_RELEASE);
+}
+
+void
+eya_ebr_retire(eya_ebr_guard_t *guard, void *ptr)
+{
+    eya_runtime_check_ref(guard);
+    eya_runtime_return_ifn(ptr);
+
+    eya_ebr_batch_t *batch = guard->pending;
+    if (!batch)
+    {
+        batch = guard->spare;
+        if (batch)
+            guard->spare = nullptr;
+        else
+            batch = eya_memory_allocator_alloc(&guard->domain->allocator, sizeof(eya_ebr_batch_t));
+
+        batch->size    = 0;
+        guard->pending = batch;
+    }
+
+    batch->ptrs[batch->size++] = ptr;
+
+    if (batch->size == EYA_LIBRARY_OPTION_EBR_BATCH_SIZE)
+        eya_ebr_flush(guard);
+}
+
+void
+eya_ebr_flush(eya_ebr_guard_t *guard)
+{
+    eya_runtime_check_ref(guard);
+
+    eya_ebr_close(guard);
+    eya_ebr_collect(guard);
+}
\ No newline at end of file
@@ -0,0 +1,804 @@
+#include <eya/hash.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/memory_std.h>
+#include <eya/nullptr.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define EYA_HASH_SSE2 1
+#elif (EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && (EYA_COMPILER_BIT_DEPTH == 64)
+#    include <intrin.h>
+#endif
+
+#define EYA_HASH_PRIME32_1 0x9E3779B1ull
+#define EYA_HASH_PRIME32_2 0x85EBCA77ull
+#define EYA_HASH_PRIME32_3 0xC2B2AE3Dull
+
+#define EYA_HASH_PRIME64_1 0x9E3779B185EBCA87ull
+#define EYA_HASH_PRIME64_2 0xC2B2AE3D27D4EB4Full
+#define EYA_HASH_PRIME64_3 0x165667B19E3779F9ull
+#define EYA_HASH_PRIME64_4 0x85EBCA77C2B2AE63ull
+#define EYA_HASH_PRIME64_5 0x27D4EB2F165667C5ull
+
+#define EYA_HASH_PRIME_MX1 0x165667919E3779F9ull
+#define EYA_HASH_PRIME_MX2 0x9FB21C651E98DF25ull
+
+/**
+ * @brief Size of a stripe, the unit of the accumulation of long inputs
+ */
+#define EYA_HASH_STRIPE_SIZE 64
+
+/**
+ * @brief Number of stripes accumulated before the lanes are scrambled
+ *
+ * Every stripe of a block uses the secret shifted by 8 more bytes.
+ */
+#define EYA_HASH_BLOCK_STRIPES ((EYA_HASH_SECRET_SIZE - EYA_HASH_STRIPE_SIZE) / 8)
+
+/**
+ * @brief Largest input hashed without the stripe accumulation
+ */
+#define EYA_HASH_SHORT_MAX 240
+
+/**
+ * @brief Default secret of XXH3, also the secret of seed 0
+ */
+static const eya_uchar_t eya_hash_default_secret[EYA_HASH_SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+/**
+ * @brief Reads a little-endian 32-bit value
+ *
+ * Compilers merge the byte loads into a single load on little-endian targets.
+ */
+static eya_ullong_t
+eya_hash_read32(const eya_uchar_t *p)
+{
+    return (eya_ullong_t)p[0] | (eya_ullong_t)p[1] << 8 | (eya_ullong_t)p[2] << 16 |
+           (eya_ullong_t)p[3] << 24;
+}
+
+/**
+ * @brief Reads a little-endian 64-bit value
+ */
+static eya_ullong_t
+eya_hash_read64(const eya_uchar_t *p)
+{
+    return eya_hash_read32(p) | eya_hash_read32(p + 4) << 32;
+}
+
+/**
+ * @brief Writes a 64-bit value in little-endian order
+ */
+static void
+eya_hash_write64(eya_uchar_t *p, eya_ullong_t value)
+{
+    for (eya_usize_t i = 0; i < 8; ++i)
+        p[i] = (eya_uchar_t)(value >> (i * 8));
+}
+
+static eya_ullong_t
+eya_hash_swap32(eya_ullong_t x)
+{
+    return (x & 0xFF) << 24 | (x & 0xFF00) << 8 | (x >> 8 & 0xFF00) | (x >> 24 & 0xFF);
+}
+
+static eya_ullong_t
+eya_hash_swap64(eya_ullong_t x)
+{
+    return eya_hash_swap32(x & 0xFFFFFFFF) << 32 | eya_hash_swap32(x >> 32);
+}
+
+/**
+ * @brief Returns the XOR of two adjacent 64-bit words of the default secret
+ */
+static eya_ullong_t
+eya_hash_key64(eya_usize_t offset)
+{
+    const eya_uchar_t *key = eya_hash_default_secret + offset;
+    return eya_hash_read64(key) ^ eya_hash_read64(key + 8);
+}
+
+/**
+ * @brief Returns the XOR of two adjacent 32-bit words of the default secret
+ */
+static eya_ullong_t
+eya_hash_key32(eya_usize_t offset)
+{
+    const eya_uchar_t *key = eya_hash_default_secret + offset;
+    return eya_hash_read32(key) ^ eya_hash_read32(key + 4);
+}
+
+/**
+ * @brief Returns the full 128-bit product of two 64-bit values
+ */
+static eya_hash128_t
+eya_hash_mul128(eya_ullong_t a, eya_ullong_t b)
+{
+    eya_hash128_t product;
+
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 wide = (unsigned __int128)a * b;
+
+    product.low  = (eya_ullong_t)wide;
+    product.high = (eya_ullong_t)(wide >> 64);
+#elif (EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && (EYA_COMPILER_BIT_DEPTH == 64)
+    product.low = _umul128(a, b, &product.high);
+#else
+    const eya_ullong_t lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+    const eya_ullong_t hi_lo = (a >> 32) * (b & 0xFFFFFFFF);
+    const eya_ullong_t lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+    const eya_ullong_t hi_hi = (a >> 32) * (b >> 32);
+    const eya_ullong_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+
+    product.high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    product.low  = cross << 32 | (lo_lo & 0xFFFFFFFF);
+#endif
+
+    return product;
+}
+
+/**
+ * @brief Folds the 128-bit product of two values into 64 bits
+ */
+static eya_ullong_t
+eya_hash_fold64(eya_ullong_t a, eya_ullong_t b)
+{
+    const eya_hash128_t product = eya_hash_mul128(a, b);
+    return product.low ^ product.high;
+}
+
+/**
+ * @brief Final mix of XXH64, used for inputs of up to 3 bytes
+ */
+static eya_ullong_t
+eya_hash_avalanche64(eya_ullong_t h)
+{
+    h ^= h >> 33;
+    h *= EYA_HASH_PRIME64_2;
+    h ^= h >> 29;
+    h *= EYA_HASH_PRIME64_3;
+    return h ^ h >> 32;
+}
+
+/**
+ * @brief Final mix of XXH3
+ */
+static eya_ullong_t
+eya_hash_avalanche(eya_ullong_t h)
+{
+    h ^= h >> 37;
+    h *= EYA_HASH_PRIME_MX1;
+    return h ^ h >> 32;
+}
+
+/**
+ * @brief Stronger final mix for inputs of 4 to 8 bytes
+ */
+static eya_ullong_t
+eya_hash_rrmxmx(eya_ullong_t h, eya_ullong_t size)
+{
+    h ^= (h << 49 | h >> 15) ^ (h << 24 | h >> 40);
+    h *= EYA_HASH_PRIME_MX2;
+    h ^= (h >> 35) + size;
+    h *= EYA_HASH_PRIME_MX2;
+    return h ^ h >> 28;
+}
+
+/**
+ * @brief Mixes 16 input bytes with 16 secret bytes
+ */
+static eya_ullong_t
+eya_hash_mix16(const eya_uchar_t *input, const eya_uchar_t *secret, eya_ullong_t seed)
+{
+    return eya_hash_fold64(eya_hash_read64(input) ^ (eya_hash_read64(secret) + seed),
+                           eya_hash_read64(input + 8) ^ (eya_hash_read64(secret + 8) - seed));
+}
+
+/**
+ * @brief Mixes two 16-byte pieces into both halves of a 128-bit accumulator
+ */
+static void
+eya_hash_mix32(eya_hash128_t     *acc,
+               const eya_uchar_t *a,
+               const eya_uchar_t *b,
+               const eya_uchar_t *secret,
+               eya_ullong_t       seed)
+{
+    acc->low += eya_hash_mix16(a, secret, seed);
+    acc->low ^= eya_hash_read64(b) + eya_hash_read64(b + 8);
+    acc->high += eya_hash_mix16(b, secret + 16, seed);
+    acc->high ^= eya_hash_read64(a) + eya_hash_read64(a + 8);
+}
+
+/**
+ * @brief Packs an input of 1 to 3 bytes and its size into 32 bits
+ */
+static eya_ullong_t
+eya_hash_combine(const eya_uchar_t *input, eya_usize_t size)
+{
+    return (eya_ullong_t)input[0] << 16 | (eya_ullong_t)input[size >> 1] << 24 |
+           (eya_ullong_t)input[size - 1] | (eya_ullong_t)size << 8;
+}
+
+/**
+ * @brief Computes the 64-bit hash of an input of up to 16 bytes
+ */
+static eya_ullong_t
+eya_hash64_upto16(const eya_uchar_t *input, eya_usize_t size, eya_ullong_t seed)
+{
+    if (size > 8)
+    {
+        const eya_ullong_t low  = eya_hash_read64(input) ^ (eya_hash_key64(24) + seed);
+        const eya_ullong_t high = eya_hash_read64(input + size - 8) ^ (eya_hash_key64(40) - seed);
+
+        return eya_hash_avalanche(size + eya_hash_swap64(low) + high + eya_hash_fold64(low, high));
+    }
+
+    if (size >= 4)
+    {
+        seed ^= eya_hash_swap32(seed & 0xFFFFFFFF) << 32;
+
+        const eya_ullong_t first   = eya_hash_read32(input);
+        const eya_ullong_t last    = eya_hash_read32(input + size - 4);
+        const eya_ullong_t bitflip = eya_hash_key64(8) - seed;
+
+        return eya_hash_rrmxmx((last + (first << 32)) ^ bitflip, size);
+    }
+
+    if (size)
+    {
+        return eya_hash_avalanche64(eya_hash_combine(input, size) ^ (eya_hash_key32(0) + seed));
+    }
+
+    return eya_hash_avalanche64(seed ^ eya_hash_key64(56));
+}
+
+/**
+ * @brief Computes the 64-bit hash of an input of up to 240 bytes
+ *
+ * Inputs above 16 bytes are covered from both ends by 16-byte pieces.
+ */
+static eya_ullong_t
+eya_hash64_short(const eya_uchar_t *input, eya_usize_t size, eya_ullong_t seed)
+{
+    const eya_uchar_t *secret = eya_hash_default_secret;
+    eya_ullong_t       acc    = size * EYA_HASH_PRIME64_1;
+
+    if (size <= 16)
+        return eya_hash64_upto16(input, size, seed);
+
+    if (size <= 128)
+    {
+        if (size > 32)
+        {
+            if (size > 64)
+            {
+                if (size > 96)
+                {
+                    acc += eya_hash_mix16(input + 48, secret + 96, seed);
+                    acc += eya_hash_mix16(input + size - 64, secret + 112, seed);
+                }
+                acc += eya_hash_mix16(input + 32, secret + 64, seed);
+                acc += eya_hash_mix16(input + size - 48, secret + 80, seed);
+            }
+            acc += eya_hash_mix16(input + 16, secret + 32, seed);
+            acc += eya_hash_mix16(input + size - 32, secret + 48, seed);
+        }
+        acc += eya_hash_mix16(input, secret, seed);
+        acc += eya_hash_mix16(input + size - 16, secret + 16, seed);
+
+        return eya_hash_avalanche(acc);
+    }
+
+    for (eya_usize_t i = 0; i < 8; ++i)
+        acc += eya_hash_mix16(input + 16 * i, secret + 16 * i, seed);
+    acc = eya_hash_avalanche(acc);
+
+    // The remaining pieces reuse the secret from offset 3, the last 16 bytes from offset 119.
+    eya_ullong_t acc_end = eya_hash_mix16(input + size - 16, secret + 119, seed);
+    for (eya_usize_t i = 8; i < size / 16; ++i)
+        acc_end += eya_hash_mix16(input + 16 * i, secret + 16 * (i - 8) + 3, seed);
+
+    return eya_hash_avalanche(acc + acc_end);
+}
+
+/**
+ * @brief Computes the 128-bit hash of an input of up to 16 bytes
+ */
+static eya_hash128_t
+eya_hash128_upto16(const eya_uchar_t *input, eya_usize_t size, eya_ullong_t seed)
+{
+    eya_hash128_t h;
+
+    if (size > 8)
+    {
+        const eya_ullong_t bitflip_low  = eya_hash_key64(32) - seed;
+        const eya_ullong_t bitflip_high = eya_hash_key64(48) + seed;
+        const eya_ullong_t low          = eya_hash_read64(input);
+        eya_ullong_t       high         = eya_hash_read64(input + size - 8);
+
+        eya_hash128_t m = eya_hash_mul128(low ^ high ^ bitflip_low, EYA_HASH_PRIME64_1);
+
+        m.low += (eya_ullong_t)(size - 1) << 54;
+        high ^= bitflip_high;
+        m.high += high + (high & 0xFFFFFFFF) * (EYA_HASH_PRIME32_2 - 1);
+        m.low ^= eya_hash_swap64(m.high);
+
+        h = eya_hash_mul128(m.low, EYA_HASH_PRIME64_2);
+        h.high += m.high * EYA_HASH_PRIME64_2;
+        h.low  = eya_hash_avalanche(h.low);
+        h.high = eya_hash_avalanche(h.high);
+        return h;
+    }
+
+    if (size >= 4)
+    {
+        seed ^= eya_hash_swap32(seed & 0xFFFFFFFF) << 32;
+
+        const eya_ullong_t first   = eya_hash_read32(input);
+        const eya_ullong_t last    = eya_hash_read32(input + size - 4);
+        const eya_ullong_t bitflip = eya_hash_key64(16) + seed;
+
+        h = eya_hash_mul128((first + (last << 32)) ^ bitflip, EYA_HASH_PRIME64_1 + (size << 2));
+        h.high += h.low << 1;
+        h.low ^= h.high >> 3;
+        h.low ^= h.low >> 35;
+        h.low *= EYA_HASH_PRIME_MX2;
+        h.low ^= h.low >> 28;
+        h.high = eya_hash_avalanche(h.high);
+        return h;
+    }
+
+    if (size)
+    {
+        const eya_ullong_t low  = eya_hash_combine(input, size);
+        const eya_ullong_t swap = eya_hash_swap32(low);
+        const eya_ullong_t high = (swap << 13 | swap >> 19) & 0xFFFFFFFF;
+
+        h.low  = eya_hash_avalanche64(low ^ (eya_hash_key32(0) + seed));
+        h.high = eya_hash_avalanche64(high ^ (eya_hash_key32(8) - seed));
+        return h;
+    }
+
+    h.low  = eya_hash_avalanche64(seed ^ eya_hash_key64(64));
+    h.high = eya_hash_avalanche64(seed ^ eya_hash_key64(80));
+    return h;
+}
+
+/**
+ * @brief Computes the 128-bit hash of an input of up to 240 bytes
+ */
+static eya_hash128_t
+eya_hash128_short(const eya_uchar_t *input, eya_usize_t size, eya_ullong_t seed)
+{
+    const eya_uchar_t *secret = eya_hash_default_secret;
+    eya_hash128_t      acc;
+
+    if (size <= 16)
+        return eya_hash128_upto16(input, size, seed);
+
+    acc.low  = size * EYA_HASH_PRIME64_1;
+    acc.high = 0;
+
+    if (size <= 128)
+    {
+        if (size > 32)
+        {
+            if (size > 64)
+            {
+                if (size > 96)
+                    eya_hash_mix32(&acc, input + 48, input + size - 64, secret + 96, seed);
+                eya_hash_mix32(&acc, input + 32, input + size - 48, secret + 64, seed);
+            }
+            eya_hash_mix32(&acc, input + 16, input + size - 32, secret + 32, seed);
+        }
+        eya_hash_mix32(&acc, input, input + size - 16, secret, seed);
+    }
+    else
+    {
+        for (eya_usize_t i = 32; i < 160; i += 32)
+            eya_hash_mix32(&acc, input + i - 32, input + i - 16, secret + i - 32, seed);
+
+        acc.low  = eya_hash_avalanche(acc.low);
+        acc.high = eya_hash_avalanche(acc.high);
+
+        // Same secret offsets as the 64-bit hash, the last 32 bytes with the negated seed.
+        for (eya_usize_t i = 160; i <= size; i += 32)
+            eya_hash_mix32(&acc, input + i - 32, input + i - 16, secret + 3 + i - 160, seed);
+
+        eya_hash_mix32(&acc, input + size - 16, input + size - 32, secret + 103, 0 - seed);
+    }
+
+    eya_hash128_t h;
+
+    h.low  = eya_hash_avalanche(acc.low + acc.high);
+    h.high = 0 - eya_hash_avalanche(acc.low * EYA_HASH_PRIME64_1 + acc.high * EYA_HASH_PRIME64_4 +
+                                     (size - seed) * EYA_HASH_PRIME64_2);
+    return h;
+}
+
+/**
+ * @brief Derives the secret of a seed from the default secret
+ */
+static void
+eya_hash_make_secret(eya_uchar_t *secret, eya_ullong_t seed)
+{
+    for (eya_usize_t i = 0; i < EYA_HASH_SECRET_SIZE; i += 16)
+    {
+        eya_hash_write64(secret + i, eya_hash_read64(eya_hash_default_secret + i) + seed);
+        eya_hash_write64(secret + i + 8, eya_hash_read64(eya_hash_default_secret + i + 8) - seed);
+    }
+}
+
+/**
+ * @brief Sets the accumulator lanes to their initial values
+ */
+static void
+eya_hash_reset_acc(eya_ullong_t *acc)
+{
+    acc[0] = EYA_HASH_PRIME32_3;
+    acc[1] = EYA_HASH_PRIME64_1;
+    acc[2] = EYA_HASH_PRIME64_2;
+    acc[3] = EYA_HASH_PRIME64_3;
+    acc[4] = EYA_HASH_PRIME64_4;
+    acc[5] = EYA_HASH_PRIME32_2;
+    acc[6] = EYA_HASH_PRIME64_5;
+    acc[7] = EYA_HASH_PRIME32_1;
+}
+
+/**
+ * @brief Accumulates one stripe into the lanes
+ *
+ * Every lane adds the product of the low and high halves of its keyed input
+ * and the unkeyed input of the neighbouring lane.
+ */
+static void
+eya_hash_accumulate_stripe(eya_ullong_t *acc, const eya_uchar_t *input, const eya_uchar_t *secret)
+{
+#if (EYA_HASH_SSE2)
+    for (eya_usize_t i = 0; i < 4; ++i)
+    {
+        const __m128i data    = _mm_loadu_si128((const __m128i *)(input + 16 * i));
+        const __m128i key     = _mm_loadu_si128((const __m128i *)(secret + 16 * i));
+        const __m128i keyed   = _mm_xor_si128(data, key);
+        const __m128i high    = _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1));
+        const __m128i product = _mm_mul_epu32(keyed, high);
+        const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        const __m128i lanes   = _mm_loadu_si128((const __m128i *)(acc + 2 * i));
+
+        _mm_storeu_si128((__m128i *)(acc + 2 * i),
+                         _mm_add_epi64(product, _mm_add_epi64(lanes, swapped)));
+    }
+#else
+    for (eya_usize_t i = 0; i < 8; ++i)
+    {
+        const eya_ullong_t data  = eya_hash_read64(input + 8 * i);
+        const eya_ullong_t keyed = data ^ eya_hash_read64(secret + 8 * i);
+
+        acc[i ^ 1] += data;
+        acc[i] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+    }
+#endif
+}
+
+/**
+ * @brief Scrambles the lanes at the end of a block
+ */
+static void
+eya_hash_scramble(eya_ullong_t *acc, const eya_uchar_t *secret)
+{
+#if (EYA_HASH_SSE2)
+    const __m128i prime = _mm_set1_epi32((int)EYA_HASH_PRIME32_1);
+
+    for (eya_usize_t i = 0; i < 4; ++i)
+    {
+        __m128i lanes = _mm_loadu_si128((const __m128i *)(acc + 2 * i));
+
+        lanes = _mm_xor_si128(lanes, _mm_srli_epi64(lanes, 47));
+        lanes = _mm_xor_si128(lanes, _mm_loadu_si128((const __m128i *)(secret + 16 * i)));
+
+        const __m128i high     = _mm_shuffle_epi32(lanes, _MM_SHUFFLE(0, 3, 0, 1));
+        const __m128i prod_low = _mm_mul_epu32(lanes, prime);
+        const __m128i prod_hi  = _mm_mul_epu32(high, prime);
+
+        _mm_storeu_si128((__m128i *)(acc + 2 * i),
+                         _mm_add_epi64(prod_low, _mm_slli_epi64(prod_hi, 32)));
+    }
+#else
+    for (eya_usize_t i = 0; i < 8; ++i)
+    {
+        eya_ullong_t lane = acc[i];
+
+        lane ^= lane >> 47;
+        lane ^= eya_hash_read64(secret + 8 * i);
+        acc[i] = lane * EYA_HASH_PRIME32_1;
+    }
+#endif
+}
+
+/**
+ * @brief Accumulates consecutive stripes, scrambling at every block boundary
+ * @param[in,out] acc Accumulator lanes
+ * @param[in,out] stripes Stripes already accumulated in the current block
+ * @param[in] input First stripe
+ * @param[in] count Number of stripes
+ * @param[in] secret Secret of the seed
+ */
+static void
+eya_hash_consume(eya_ullong_t      *acc,
+                 eya_usize_t       *stripes,
+                 const eya_uchar_t *input,
+                 eya_usize_t        count,
+                 const eya_uchar_t *secret)
+{
+    while (count)
+    {
+        eya_usize_t run = EYA_HASH_BLOCK_STRIPES - *stripes;
+
+        if (run > count)
+            run = count;
+
+        for (eya_usize_t i = 0; i < run; ++i)
+            eya_hash_accumulate_stripe(acc,
+                                       input + i * EYA_HASH_STRIPE_SIZE,
+                                       secret + (*stripes + i) * 8);
+
+        input += run * EYA_HASH_STRIPE_SIZE;
+        count -= run;
+        *stripes += run;
+
+        if (*stripes == EYA_HASH_BLOCK_STRIPES)
+        {
+            eya_hash_scramble(acc, secret + EYA_HASH_SECRET_SIZE - EYA_HASH_STRIPE_SIZE);
+            *stripes = 0;
+        }
+    }
+}
+
+/**
+ * @brief Accumulates the final stripe, which ends at the last input byte
+ */
+static void
+eya_hash_accumulate_last(eya_ullong_t *acc, const eya_uchar_t *stripe, const eya_uchar_t *secret)
+{
+    const eya_usize_t offset = EYA_HASH_SECRET_SIZE - EYA_HASH_STRIPE_SIZE - 7;
+    eya_hash_accumulate_stripe(acc, stripe, secret + offset);
+}
+
+/**
+ * @brief Accumulates an input of more than 240 bytes
+ */
+static void
+eya_hash_long(eya_ullong_t       *acc,
+              const eya_uchar_t *input,
+              eya_usize_t        size,
+              const eya_uchar_t *secret)
+{
+    eya_usize_t stripes = 0;
+
+    eya_hash_reset_acc(acc);
+    eya_hash_consume(acc, &stripes, input, (size - 1) / EYA_HASH_STRIPE_SIZE, secret);
+    eya_hash_accumulate_last(acc, input + size - EYA_HASH_STRIPE_SIZE, secret);
+}
+
+/**
+ * @brief Merges the lanes into one 64-bit value
+ */
+static eya_ullong_t
+eya_hash_merge(const eya_ullong_t *acc, const eya_uchar_t *secret, eya_ullong_t start)
+{
+    for (eya_usize_t i = 0; i < 4; ++i)
+        start += eya_hash_fold64(acc[2 * i] ^ eya_hash_read64(secret + 16 * i),
+                                 acc[2 * i + 1] ^ eya_hash_read64(secret + 16 * i + 8));
+
+    return eya_hash_avalanche(start);
+}
+
+static eya_ullong_t
+eya_hash_merge64(const eya_ullong_t *acc, const eya_uchar_t *secret, eya_ullong_t size)
+{
+    return eya_hash_merge(acc, secret + 11, size * EYA_HASH_PRIME64_1);
+}
+
+static eya_hash128_t
+eya_hash_merge128(const eya_ullong_t *acc, const eya_uchar_t *secret, eya_ullong_t size)
+{
+    eya_hash128_t h;
+
+    h.low  = eya_hash_merge64(acc, secret, size);
+    h.high = eya_hash_merge(acc,
+                            secret + EYA_HASH_SECRET_SIZE - EYA_HASH_STRIPE_SIZE - 11,
+                            ~(size * EYA_HASH_PRIME64_2));
+    return h;
+}
+
+eya_ullong_t
+eya_hash64(const void *data, eya_usize_t size, eya_ullong_t seed)
+{
+    eya_runtime_check(data || !size, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+    if (size <= EYA_HASH_SHORT_MAX)
+        return eya_hash64_short(data, size, seed);
+
+    eya_ullong_t acc[8];
+    eya_uchar_t  secret[EYA_HASH_SECRET_SIZE];
+
+    eya_hash_make_secret(secret, seed);
+    eya_hash_long(acc, data, size, secret);
+    return eya_hash_merge64(acc, secret, size);
+}
+
+eya_hash128_t
+eya_hash128(const void *data, eya_usize_t size, eya_ullong_t seed)
+{
+    eya_runtime_check(data || !size, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+    if (size <= EYA_HASH_SHORT_MAX)
+        return eya_hash128_short(data, size, seed);
+
+    eya_ullong_t acc[8];
+    eya_uchar_t  secret[EYA_HASH_SECRET_SIZE];
+
+    eya_hash_make_secret(secret, seed);
+    eya_hash_long(acc, data, size, secret);
+    return eya_hash_merge128(acc, secret, size);
+}
+
+eya_ullong_t
+eya_hash64_range(const eya_memory_range_t *range, eya_ullong_t seed)
+{
+    eya_runtime_check_ref(range);
+    return eya_hash64(eya_memory_range_get_begin(range), eya_memory_range_get_size(range), seed);
+}
+
+eya_hash128_t
+eya_hash128_range(const eya_memory_range_t *range, eya_ullong_t seed)
+{
+    eya_runtime_check_ref(range);
+    return eya_hash128(eya_memory_range_get_begin(range), eya_memory_range_get_size(range), seed);
+}
+
+void
+eya_hash_init(eya_hash_state_t *self, eya_ullong_t seed)
+{
+    eya_runtime_check_ref(self);
+
+    eya_hash_reset_acc(self->acc);
+    eya_hash_make_secret(self->secret, seed);
+
+    self->buffered = 0;
+    self->stripes  = 0;
+    self->total    = 0;
+    self->seed     = seed;
+}
+
+void
+eya_hash_update(eya_hash_state_t *self, const void *data, eya_usize_t size)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(data || !size, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+    const eya_uchar_t *input = data;
+    const eya_uchar_t *end   = input + size;
+
+    self->total += size;
+
+    if (size <= EYA_HASH_BUFFER_SIZE - self->buffered)
+    {
+        if (size)
+            eya_memory_std_copy(self->buffer + self->buffered, input, size);
+        self->buffered += size;
+        return;
+    }
+
+    // The buffer is only consumed once more input follows,
+    // so that the final stripe is always available to the digest.
+    if (self->buffered)
+    {
+        const eya_usize_t fill = EYA_HASH_BUFFER_SIZE - self->buffered;
+
+        eya_memory_std_copy(self->buffer + self->buffered, input, fill);
+        input += fill;
+
+        eya_hash_consume(self->acc,
+                         &self->stripes,
+                         self->buffer,
+                         EYA_HASH_BUFFER_SIZE / EYA_HASH_STRIPE_SIZE,
+                         self->secret);
+        self->buffered = 0;
+    }
+
+    if ((eya_usize_t)(end - input) > EYA_HASH_BUFFER_SIZE)
+    {
+        const eya_usize_t count = (eya_usize_t)(end - 1 - input) / EYA_HASH_STRIPE_SIZE;
+
+        eya_hash_consume(self->acc, &self->stripes, input, count, self->secret);
+        input += count * EYA_HASH_STRIPE_SIZE;
+
+        // Keeps the last consumed stripe for a digest that needs bytes before the buffered ones.
+        eya_memory_std_copy(self->buffer + EYA_HASH_BUFFER_SIZE - EYA_HASH_STRIPE_SIZE,
+                            input - EYA_HASH_STRIPE_SIZE,
+                            EYA_HASH_STRIPE_SIZE);
+    }
+
+    self->buffered = (eya_usize_t)(end - input);
+    eya_memory_std_copy(self->buffer, input, self->buffered);
+}
+
+/**
+ * @brief Accumulates the buffered bytes of a long stream into a copy of the lanes
+ */
+static void
+eya_hash_digest_long(const eya_hash_state_t *self, eya_ullong_t *acc)
+{
+    eya_uchar_t        last[EYA_HASH_STRIPE_SIZE];
+    const eya_uchar_t *stripe = last;
+
+    for (eya_usize_t i = 0; i < 8; ++i)
+        acc[i] = self->acc[i];
+
+    if (self->buffered >= EYA_HASH_STRIPE_SIZE)
+    {
+        eya_usize_t stripes = self->stripes;
+
+        eya_hash_consume(acc,
+                         &stripes,
+                         self->buffer,
+                         (self->buffered - 1) / EYA_HASH_STRIPE_SIZE,
+                         self->secret);
+        stripe = self->buffer + self->buffered - EYA_HASH_STRIPE_SIZE;
+    }
+    else
+    {
+        const eya_usize_t catchup = EYA_HASH_STRIPE_SIZE - self->buffered;
+
+        eya_memory_std_copy(last, self->buffer + EYA_HASH_BUFFER_SIZE - catchup, catchup);
+        if (self->buffered)
+            eya_memory_std_copy(last + catchup, self->buffer, self->buffered);
+    }
+
+    eya_hash_accumulate_last(acc, stripe, self->secret);
+}
+
+eya_ullong_t
+eya_hash_digest64(const eya_hash_state_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    if (self->total <= EYA_HASH_SHORT_MAX)
+        return eya_hash64_short(self->buffer, self->buffered, self->seed);
+
+    eya_ullong_t acc[8];
+
+    eya_hash_digest_long(self, acc);
+    return eya_hash_merge64(acc, self->secret, self->total);
+}
+
+eya_hash128_t
+eya_hash_digest128(const eya_hash_state_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    if (self->total <= EYA_HASH_SHORT_MAX)
+        return eya_hash128_short(self->buffer, self->buffered, self->seed);
+
+    eya_ullong_t acc[8];
+
+    eya_hash_digest_long(self, acc);
+    return eya_hash_merge128(acc, self->secret, self->total);
+}
\ No newline at end of file
@@ -0,0 +1,570 @@
+#include <eya/hash_map.h>
+
+#include <eya/runtime_exception_catch_stack.h>
+#include <eya/runtime_allocator.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/thread_seqlock.h>
+#include <eya/thread_lock.h>
+#include <eya/checked_math.h>
+#include <eya/runtime_try.h>
+#include <eya/memory_std.h>
+#include <eya/math_util.h>
+#include <eya/addr_util.h>
+#include <eya/ptr_util.h>
+#include <eya/nullptr.h>
+#include <eya/hash.h>
+#include <eya/ebr.h>
+
+#if (EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT < 1) ||                                             \
+    (EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT & (EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT - 1))
+#    error "EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT must be a power of two"
+#endif
+
+/**
+ * @brief Number of slots of the first table of a segment
+ */
+#define EYA_HASH_MAP_INITIAL_CAPACITY 8
+
+/**
+ * @brief Number of slots of the old table moved by every insert
+ *
+ * A new table is at most five eighths full once the old one is drained,
+ * so moving eight slots per insert ends the migration long before
+ * the new table has to grow in turn.
+ */
+#define EYA_HASH_MAP_MIGRATE_STEP 8
+
+/**
+ * @brief Slot tag of a slot that never held a key, it ends every probe
+ */
+#define EYA_HASH_MAP_TAG_EMPTY 0
+
+/**
+ * @brief Slot tag of a slot whose key was erased, probes continue past it
+ */
+#define EYA_HASH_MAP_TAG_ERASED 1
+
+/**
+ * @brief Open-addressing table of a segment
+ *
+ * Every slot holds `[tag][key][value]`, where the tag is the key's hash
+ * or one of the two reserved values.
+ */
+typedef struct eya_hash_map_table
+{
+    eya_usize_t mask; /**< Number of slots minus one */
+} eya_hash_map_table_t;
+
+/**
+ * @brief Independently locked part of the map
+ */
+typedef struct eya_hash_map_segment
+{
+    eya_thread_lock_t    lock;     /**< Serializes the writers of the segment */
+    eya_thread_seqlock_t seqlock;  /**< Lets readers detect concurrent writes */
+    eya_atomic_ptr_t     table;    /**< Current table, receives every new key */
+    eya_atomic_ptr_t     old;      /**< Table being drained into the current one, or nullptr */
+    eya_usize_t          migrated; /**< Slots of the old table already drained */
+    eya_atomic_usize_t   size;     /**< Number of keys in both tables */
+    eya_usize_t          used;     /**< Number of keys and erased slots of the current table */
+} eya_hash_map_segment_t;
+
+struct eya_hash_map
+{
+    eya_memory_allocator_t allocator;      /**< Source of all map memory */
+    eya_hash_map_hash_fn  *hash_fn;        /**< Hash function of the keys */
+    eya_usize_t            key_size;       /**< Size of every key */
+    eya_usize_t            value_size;     /**< Size of every value */
+    eya_usize_t            slot_size;      /**< Size of a table slot */
+    eya_uchar_t           *segments;       /**< Segments, one cache line apart */
+    eya_usize_t            segment_stride; /**< Distance between two segments */
+    eya_usize_t            segment_shift;  /**< Shift of a hash that leaves the segment index */
+
+    eya_ebr_t ebr; /**< Reclamation domain of the replaced tables */
+};
+
+/**
+ * @brief Returns the default hash of a key (64-bit XXH3)
+ */
+static eya_usize_t
+eya_hash_map_hash_default(const void *key, eya_usize_t size)
+{
+    return (eya_usize_t)eya_hash64(key, size, 0);
+}
+
+/**
+ * @brief Hashes a key and mixes the result, so that all bits depend on the whole key
+ *
+ * The high bits select the segment and the low bits the slot.
+ * The result is also the slot tag, so it never equals a reserved tag.
+ */
+static eya_usize_t
+eya_hash_map_hash(const eya_hash_map_t *self, const void *key)
+{
+    eya_ullong_t hash = self->hash_fn(key, self->key_size);
+
+    // Finalizer of MurmurHash3.
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+
+    // Folds the high half into the result on 32-bit targets.
+    const eya_usize_t result = (eya_usize_t)(hash ^ (hash >> 32 >> (sizeof(eya_usize_t) * 8 - 32)));
+    return result > EYA_HASH_MAP_TAG_ERASED ? result : result + 2;
+}
+
+/**
+ * @brief Returns the segment of a hash, selected by its high bits
+ */
+static eya_hash_map_segment_t *
+eya_hash_map_segment(const eya_hash_map_t *self, eya_usize_t hash)
+{
+    // Shifting in two steps keeps a single segment (shift of the full width) defined.
+    const eya_usize_t index = hash >> 1 >> (self->segment_shift - 1);
+    return eya_ptr_cast(eya_hash_map_segment_t, self->segments + index * self->segment_stride);
+}
+
+/**
+ * @brief Returns the tag of a slot, the key and the value follow it
+ */
+static eya_atomic_usize_t *
+eya_hash_map_slot(const eya_hash_map_t *self, eya_hash_map_table_t *table, eya_usize_t index)
+{
+    eya_uchar_t *slots = eya_ptr_cast(eya_uchar_t, table + 1);
+    return eya_ptr_cast(eya_atomic_usize_t, slots + (index & table->mask) * self->slot_size);
+}
+
+/**
+ * @brief Returns the key of a slot
+ */
+static eya_uchar_t *
+eya_hash_map_slot_key(eya_atomic_usize_t *slot)
+{
+    return eya_ptr_cast(eya_uchar_t, slot) + sizeof(eya_usize_t);
+}
+
+/**
+ * @brief Returns the value of a slot
+ */
+static eya_uchar_t *
+eya_hash_map_slot_value(const eya_hash_map_t *self, eya_atomic_usize_t *slot)
+{
+    return eya_hash_map_slot_key(slot) + self->key_size;
+}
+
+/**
+ * @brief Copies a value into a slot, values of sets have no storage
+ */
+static void
+eya_hash_map_slot_store(const eya_hash_map_t *self, eya_atomic_usize_t *slot, const void *value)
+{
+    eya_runtime_return_ifn(self->value_size);
+    eya_memory_std_copy(eya_hash_map_slot_value(self, slot), value, self->value_size);
+}
+
+/**
+ * @brief Probes a table for a key
+ * @return Slot holding the key, or nullptr
+ *
+ * Readers call it without the segment lock, so every slot may change
+ * while it is examined; the bound on the probe length keeps a reader
+ * that sees an inconsistent table from running forever.
+ */
+static eya_atomic_usize_t *
+eya_hash_map_lookup(const eya_hash_map_t *self,
+                    eya_hash_map_table_t *table,
+                    eya_usize_t           hash,
+                    const void           *key)
+{
+    for (eya_usize_t i = 0; i <= table->mask; ++i)
+    {
+        eya_atomic_usize_t *slot = eya_hash_map_slot(self, table, hash + i);
+        const eya_usize_t   seen = eya_atomic_load(slot, EYA_ATOMIC_RELAXED);
+
+        if (seen == EYA_HASH_MAP_TAG_EMPTY)
+            break;
+
+        if (seen == hash &&
+            !eya_memory_std_compare(eya_hash_map_slot_key(slot), key, self->key_size))
+        {
+            return slot;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Probes the current table of a segment, then the one being drained
+ * @return Slot holding the key, or nullptr
+ *
+ * Every key lives in exactly one of the two tables.
+ */
+static eya_atomic_usize_t *
+eya_hash_map_lookup_segment(const eya_hash_map_t   *self,
+                            eya_hash_map_segment_t *segment,
+                            eya_usize_t             hash,
+                            const void             *key,
+                            int                     order)
+{
+    eya_hash_map_table_t *table = eya_atomic_load(&segment->table, order);
+    eya_atomic_usize_t   *slot  = eya_hash_map_lookup(self, table, hash, key);
+    eya_runtime_return_if(slot, slot);
+
+    eya_hash_map_table_t *old = eya_atomic_load(&segment->old, order);
+    return old ? eya_hash_map_lookup(self, old, hash, key) : nullptr;
+}
+
+/**
+ * @brief Allocates a table with all slots empty
+ */
+static eya_hash_map_table_t *
+eya_hash_map_table_make(const eya_hash_map_t *self, eya_usize_t capacity)
+{
+    eya_usize_t size;
+    eya_usize_t total;
+
+    eya_runtime_check_if(eya_checked_mul(capacity, self->slot_size, &size) ||
+                             eya_checked_add(size, sizeof(eya_hash_map_table_t), &total),
+                         EYA_RUNTIME_ERROR_OVERFLOW);
+
+    eya_hash_map_table_t *table = eya_memory_allocator_alloc(&self->allocator, total);
+
+    table->mask = capacity - 1;
+    eya_memory_std_set(table + 1, 0, size);
+
+    return table;
+}
+
+// --------------------------------------------------------------------------------------------- //
+//                                            WRITERS                                            //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief Returns the first slot of a probe that does not hold a key
+ *
+ * Must be called with the segment lock held and a table that has a free slot.
+ */
+static eya_atomic_usize_t *
+eya_hash_map_vacancy(const eya_hash_map_t *self, eya_hash_map_table_t *table, eya_usize_t hash)
+{
+    for (eya_usize_t i = 0;; ++i)
+    {
+        eya_atomic_usize_t *slot = eya_hash_map_slot(self, table, hash + i);
+        if (eya_atomic_load(slot, EYA_ATOMIC_RELAXED) <= EYA_HASH_MAP_TAG_ERASED)
+            return slot;
+    }
+}
+
+/**
+ * @brief Moves up to `count` slots of the old table of a segment into the current one
+ *
+ * A key is copied and erased from the old table in the same write section,
+ * so readers find it in exactly one table. The old table is retired
+ * once it is drained. Must be called with the segment lock held.
+ */
+static void
+eya_hash_map_migrate(eya_hash_map_t *self, eya_hash_map_segment_t *segment, eya_usize_t count)
+{
+    eya_hash_map_table_t *old = eya_atomic_load(&segment->old, EYA_ATOMIC_RELAXED);
+    eya_runtime_return_ifn(old);
+
+    eya_hash_map_table_t *table = eya_atomic_load(&segment->table, EYA_ATOMIC_RELAXED);
+    const eya_usize_t     left  = old->mask + 1 - segment->migrated;
+    const eya_usize_t     end   = segment->migrated + eya_math_min(count, left);
+
+    eya_thread_seqlock_write_lock(&segment->seqlock);
+
+    for (; segment->migrated < end; segment->migrated++)
+    {
+        eya_atomic_usize_t *from = eya_hash_map_slot(self, old, segment->migrated);
+        const eya_usize_t   tag  = eya_atomic_load(from, EYA_ATOMIC_RELAXED);
+
+        if (tag <= EYA_HASH_MAP_TAG_ERASED)
+            continue;
+
+        eya_atomic_usize_t *to = eya_hash_map_vacancy(self, table, tag);
+        if (eya_atomic_load(to, EYA_ATOMIC_RELAXED) == EYA_HASH_MAP_TAG_EMPTY)
+            segment->used++;
+
+        eya_memory_std_copy(eya_hash_map_slot_key(to),
+                            eya_hash_map_slot_key(from),
+                            self->slot_size - sizeof(eya_usize_t));
+        eya_atomic_store(to, tag, EYA_ATOMIC_RELAXED);
+        eya_atomic_store(from, EYA_HASH_MAP_TAG_ERASED, EYA_ATOMIC_RELAXED);
+    }
+
+    const bool drained = segment->migrated > old->mask;
+    if (drained)
+        eya_atomic_store(&segment->old, nullptr, EYA_ATOMIC_RELAXED);
+
+    eya_thread_seqlock_write_unlock(&segment->seqlock);
+    eya_runtime_return_ifn(drained);
+
+    // Readers that loaded the old table keep probing it until they exit.
+    eya_ebr_guard_t *guard = eya_ebr_enter(&self->ebr);
+    eya_ebr_retire(guard, old);
+    eya_ebr_flush(guard);
+    eya_ebr_exit(guard);
+}
+
+/**
+ * @brief Gives a segment an empty table and starts draining the current one into it
+ *
+ * Only the allocation happens here: the keys move a few slots per insert,
+ * so no writer waits for a whole table to be copied. Readers probe both
+ * tables meanwhile. Must be called with the segment lock held.
+ */
+static eya_hash_map_table_t *
+eya_hash_map_rehash(eya_hash_map_t         *self,
+                    eya_hash_map_segment_t *segment,
+                    eya_hash_map_table_t   *table)
+{
+    // Keeps at most two tables, a previous migration normally ends long before.
+    eya_hash_map_migrate(self, segment, EYA_USIZE_T_MAX);
+
+    const eya_usize_t size     = eya_atomic_load(&segment->size, EYA_ATOMIC_RELAXED);
+    const eya_usize_t capacity = table->mask + 1;
+
+    // Doubles when keys fill half of the table, otherwise only drops the erased slots.
+    eya_hash_map_table_t *result =
+        eya_hash_map_table_make(self, (size + 1) * 2 > capacity ? capacity * 2 : capacity);
+
+    // The release store publishes the empty slots to readers that load the pointer.
+    eya_thread_seqlock_write_lock(&segment->seqlock);
+    eya_atomic_store(&segment->old, table, EYA_ATOMIC_RELAXED);
+    eya_atomic_store(&segment->table, result, EYA_ATOMIC_RELEASE);
+    eya_thread_seqlock_write_unlock(&segment->seqlock);
+
+    segment->migrated = 0;
+    segment->used     = 0;
+
+    return result;
+}
+
+/**
+ * @brief Inserts or replaces a key in a locked segment
+ */
+static bool
+eya_hash_map_insert_locked(eya_hash_map_t         *self,
+                           eya_hash_map_segment_t *segment,
+                           eya_usize_t             hash,
+                           const void             *key,
+                           const void             *value)
+{
+    eya_hash_map_table_t *table = eya_atomic_load(&segment->table, EYA_ATOMIC_RELAXED);
+    eya_atomic_usize_t   *slot =
+        eya_hash_map_lookup_segment(self, segment, hash, key, EYA_ATOMIC_RELAXED);
+
+    if (slot)
+    {
+        eya_thread_seqlock_write_lock(&segment->seqlock);
+        eya_hash_map_slot_store(self, slot, value);
+        eya_thread_seqlock_write_unlock(&segment->seqlock);
+        return false;
+    }
+
+    // Keeps at least a quarter of the slots empty, so probes stay short and terminate.
+    if ((segment->used + 1) * 4 > (table->mask + 1) * 3)
+        table = eya_hash_map_rehash(self, segment, table);
+
+    slot = eya_hash_map_vacancy(self, table, hash);
+    if (eya_atomic_load(slot, EYA_ATOMIC_RELAXED) == EYA_HASH_MAP_TAG_EMPTY)
+        segment->used++;
+
+    eya_thread_seqlock_write_lock(&segment->seqlock);
+    eya_memory_std_copy(eya_hash_map_slot_key(slot), key, self->key_size);
+    eya_hash_map_slot_store(self, slot, value);
+    eya_atomic_store(slot, hash, EYA_ATOMIC_RELAXED);
+    eya_thread_seqlock_write_unlock(&segment->seqlock);
+
+    eya_atomic_fetch_add(&segment->size, 1, EYA_ATOMIC_RELAXED);
+
+    eya_hash_map_migrate(self, segment, EYA_HASH_MAP_MIGRATE_STEP);
+    return true;
+}
+
+// --------------------------------------------------------------------------------------------- //
+//                                              API                                              //
+// --------------------------------------------------------------------------------------------- //
+
+eya_hash_map_t *
+eya_hash_map_make(eya_usize_t                   key_size,
+                  eya_usize_t                   value_size,
+                  eya_hash_map_hash_fn         *hash_fn,
+                  const eya_memory_allocator_t *allocator)
+{
+    eya_runtime_check(key_size, EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE);
+    eya_runtime_check(key_size <= EYA_USIZE_T_MAX / 2 - sizeof(eya_usize_t) &&
+                          value_size <= EYA_USIZE_T_MAX / 2 - sizeof(eya_usize_t) - key_size,
+                      EYA_RUNTIME_ERROR_OVERFLOW);
+
+    const eya_memory_allocator_t source = allocator ? *allocator : *eya_runtime_allocator();
+    eya_hash_map_t *self = eya_memory_allocator_alloc(&source, sizeof(eya_hash_map_t));
+
+    self->allocator  = source;
+    self->hash_fn    = hash_fn ? hash_fn : eya_hash_map_hash_default;
+    self->key_size   = key_size;
+    self->value_size = value_size;
+    self->slot_size =
+        eya_addr_align_up(sizeof(eya_usize_t) + key_size + value_size, sizeof(eya_usize_t));
+    self->segment_stride =
+        eya_addr_align_up(sizeof(eya_hash_map_segment_t), EYA_ATOMIC_CACHE_LINE_SIZE);
+    self->segment_shift = sizeof(eya_usize_t) * 8;
+    self->segments      = nullptr;
+    eya_ebr_init(&self->ebr, &source);
+
+    for (eya_usize_t n = EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT; n > 1; n >>= 1)
+        self->segment_shift--;
+
+    eya_runtime_try(e)
+    {
+        self->segments = eya_memory_allocator_alloc_aligned(
+            &self->allocator,
+            self->segment_stride * EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT,
+            EYA_ATOMIC_CACHE_LINE_SIZE);
+        eya_memory_std_set(
+            self->segments, 0, self->segment_stride * EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT);
+
+        for (eya_usize_t i = 0; i < EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT; ++i)
+        {
+            eya_hash_map_segment_t *segment =
+                eya_ptr_cast(eya_hash_map_segment_t, self->segments + i * self->segment_stride);
+
+            eya_thread_lock_init(&segment->lock);
+            eya_thread_seqlock_init(&segment->seqlock);
+            segment->table = eya_hash_map_table_make(self, EYA_HASH_MAP_INITIAL_CAPACITY);
+        }
+
+        eya_runtime_try_return(self);
+    }
+    eya_runtime_catch
+    {
+        eya_hash_map_free(self);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+}
+
+void
+eya_hash_map_free(eya_hash_map_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_memory_allocator_t allocator = self->allocator;
+
+    if (self->segments)
+    {
+        for (eya_usize_t i = 0; i < EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT; ++i)
+        {
+            eya_hash_map_segment_t *segment =
+                eya_ptr_cast(eya_hash_map_segment_t, self->segments + i * self->segment_stride);
+            eya_memory_allocator_free(&allocator, segment->table);
+            eya_memory_allocator_free(&allocator, segment->old);
+        }
+        eya_memory_allocator_free_aligned(&allocator, self->segments);
+    }
+
+    eya_ebr_destroy(&self->ebr);
+    eya_memory_allocator_free(&allocator, self);
+}
+
+eya_usize_t
+eya_hash_map_get_size(const eya_hash_map_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    eya_usize_t size = 0;
+    for (eya_usize_t i = 0; i < EYA_LIBRARY_OPTION_HASH_MAP_SEGMENT_COUNT; ++i)
+    {
+        eya_hash_map_segment_t *segment =
+            eya_ptr_cast(eya_hash_map_segment_t, self->segments + i * self->segment_stride);
+        size += eya_atomic_load(&segment->size, EYA_ATOMIC_RELAXED);
+    }
+
+    return size;
+}
+
+bool
+eya_hash_map_find(eya_hash_map_t *self, const void *key, void *value)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(key);
+
+    const eya_usize_t       hash    = eya_hash_map_hash(self, key);
+    eya_hash_map_segment_t *segment = eya_hash_map_segment(self, hash);
+    eya_ebr_guard_t        *guard   = eya_ebr_enter(&self->ebr);
+    bool                    found;
+
+    for (;;)
+    {
+        const eya_uint_t    sequence = eya_thread_seqlock_read_begin(&segment->seqlock);
+        eya_atomic_usize_t *slot =
+            eya_hash_map_lookup_segment(self, segment, hash, key, EYA_ATOMIC_ACQUIRE);
+
+        found = slot != nullptr;
+        if (found && value && self->value_size)
+            eya_memory_std_copy(value, eya_hash_map_slot_value(self, slot), self->value_size);
+
+        if (!eya_thread_seqlock_read_retry(&segment->seqlock, sequence))
+            break;
+    }
+
+    eya_ebr_exit(guard);
+    return found;
+}
+
+bool
+eya_hash_map_insert(eya_hash_map_t *self, const void *key, const void *value)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(key);
+    eya_runtime_check(value || !self->value_size, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+    const eya_usize_t       hash    = eya_hash_map_hash(self, key);
+    eya_hash_map_segment_t *segment = eya_hash_map_segment(self, hash);
+
+    eya_thread_lock_lock(&segment->lock);
+
+    eya_runtime_try(e)
+    {
+        const bool inserted = eya_hash_map_insert_locked(self, segment, hash, key, value);
+
+        eya_thread_lock_unlock(&segment->lock);
+        eya_runtime_try_return(inserted);
+    }
+    eya_runtime_catch
+    {
+        eya_thread_lock_unlock(&segment->lock);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+}
+
+bool
+eya_hash_map_erase(eya_hash_map_t *self, const void *key)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(key);
+
+    const eya_usize_t       hash    = eya_hash_map_hash(self, key);
+    eya_hash_map_segment_t *segment = eya_hash_map_segment(self, hash);
+
+    eya_thread_lock_lock(&segment->lock);
+
+    eya_atomic_usize_t *slot =
+        eya_hash_map_lookup_segment(self, segment, hash, key, EYA_ATOMIC_RELAXED);
+
+    if (slot)
+    {
+        eya_thread_seqlock_write_lock(&segment->seqlock);
+        eya_atomic_store(slot, EYA_HASH_MAP_TAG_ERASED, EYA_ATOMIC_RELAXED);
+        eya_thread_seqlock_write_unlock(&segment->seqlock);
+
+        eya_atomic_fetch_sub(&segment->size, 1, EYA_ATOMIC_RELAXED);
+    }
+
+    eya_thread_lock_unlock(&segment->lock);
+    return slot != nullptr;
+}
\ No newline at end of file
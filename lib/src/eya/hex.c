@@ -0,0 +1,285 @@
+#include <eya/hex.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/numeric_limits.h>
+#include <eya/checked_math.h>
+#include <eya/nullptr.h>
+#include <eya/cpu.h>
+
+#if ((EYA_COMPILER_GCC_LIKE) && defined(__x86_64__)) ||                                            \
+    ((EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && defined(_M_X64))
+#    include <immintrin.h>
+#    define EYA_HEX_X86 1
+#endif
+
+/**
+ * @brief Digits of the encoding
+ */
+static const char eya_hex_digits[16] = "0123456789abcdef";
+
+/**
+ * @brief Value of each character, 0xFF for characters that are not digits
+ */
+static eya_uchar_t eya_hex_values[256];
+
+#if (EYA_HEX_X86)
+static bool eya_hex_has_avx2;
+#endif
+
+/**
+ * @brief Encodes bytes one at a time
+ */
+static void
+eya_hex_encode_scalar(eya_uchar_t *dst, const eya_uchar_t *src, eya_usize_t size)
+{
+    for (; size; --size, ++src, dst += 2)
+    {
+        dst[0] = (eya_uchar_t)eya_hex_digits[*src >> 4];
+        dst[1] = (eya_uchar_t)eya_hex_digits[*src & 0x0F];
+    }
+}
+
+/**
+ * @brief Decodes pairs of digits one at a time
+ * @param[in] size Number of digits, which is even
+ */
+static void
+eya_hex_decode_scalar(eya_uchar_t *dst, const eya_uchar_t *src, eya_usize_t size)
+{
+    for (; size; size -= 2, src += 2, ++dst)
+    {
+        const eya_uchar_t high = eya_hex_values[src[0]];
+        const eya_uchar_t low  = eya_hex_values[src[1]];
+
+        eya_runtime_check(!((high | low) & 0xF0), EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+        *dst = (eya_uchar_t)(high << 4 | low);
+    }
+}
+
+#if (EYA_HEX_X86)
+/**
+ * @brief Encodes 32 bytes per step, looking the digits of both nibbles up with `vpshufb`
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static void
+eya_hex_encode_avx2(eya_uchar_t *dst, const eya_uchar_t *src, eya_usize_t size)
+{
+    const __m256i digits =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)eya_hex_digits));
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+
+    for (; size >= 32; size -= 32, src += 32, dst += 64)
+    {
+        const __m256i in   = _mm256_loadu_si256((const __m256i *)src);
+        const __m256i high = _mm256_shuffle_epi8(
+            digits, _mm256_and_si256(_mm256_srli_epi16(in, 4), low_mask));
+        const __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(in, low_mask));
+
+        // The unpacks interleave within 128-bit lanes, the permutes put the lanes in order.
+        const __m256i first  = _mm256_unpacklo_epi8(high, low);
+        const __m256i second = _mm256_unpackhi_epi8(high, low);
+
+        _mm256_storeu_si256((__m256i *)dst, _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+
+    eya_hex_encode_scalar(dst, src, size);
+}
+
+/**
+ * @brief Converts 32 characters to nibble values
+ * @param[out] valid All ones in the bytes that hold a digit
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static __m256i
+eya_hex_values256(__m256i in, __m256i *valid)
+{
+    const __m256i digit = _mm256_sub_epi8(in, _mm256_set1_epi8('0'));
+    const __m256i alpha =
+        _mm256_sub_epi8(_mm256_or_si256(in, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+
+    // Unsigned x <= n is min(x, n) == x.
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+    *valid = _mm256_or_si256(is_digit, is_alpha);
+    return _mm256_blendv_epi8(_mm256_add_epi8(alpha, _mm256_set1_epi8(10)), digit, is_digit);
+}
+
+/**
+ * @brief Decodes 64 digits per step
+ *
+ * Blocks holding an invalid character are left to the scalar loop,
+ * which reports the error.
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static void
+eya_hex_decode_avx2(eya_uchar_t *dst, const eya_uchar_t *src, eya_usize_t size)
+{
+    // Multiplies the first nibble of each pair by 16 and adds the second.
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+
+    for (; size >= 64; size -= 64, src += 64, dst += 32)
+    {
+        __m256i       valid0, valid1;
+        const __m256i values0 =
+            eya_hex_values256(_mm256_loadu_si256((const __m256i *)src), &valid0);
+        const __m256i values1 =
+            eya_hex_values256(_mm256_loadu_si256((const __m256i *)(src + 32)), &valid1);
+
+        if (_mm256_movemask_epi8(_mm256_and_si256(valid0, valid1)) != -1)
+            break;
+
+        const __m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(values0, weights),
+                                                  _mm256_maddubs_epi16(values1, weights));
+
+        _mm256_storeu_si256((__m256i *)dst, _mm256_permute4x64_epi64(bytes, 0xD8));
+    }
+
+    eya_hex_decode_scalar(dst, src, size);
+}
+#endif
+
+/**
+ * @brief Fills the table and selects the implementation when the library is loaded
+ */
+eya_compiler_constructor(eya_hex_init)
+{
+    for (eya_usize_t i = 0; i < 256; ++i)
+        eya_hex_values[i] = 0xFF;
+
+    for (eya_uchar_t i = 0; i < 16; ++i)
+    {
+        eya_hex_values[(eya_uchar_t)eya_hex_digits[i]] = i;
+        if (i >= 10)
+            eya_hex_values['A' + i - 10] = i;
+    }
+
+    eya_hex_set_cpu_features(EYA_UINT_T_MAX);
+}
+
+void
+eya_hex_set_cpu_features(eya_uint_t features)
+{
+#if (EYA_HEX_X86)
+    eya_hex_has_avx2 = (features & eya_cpu_get_features() & EYA_CPU_FEATURE_AVX2) != 0;
+#else
+    (void)features;
+#endif
+}
+
+/**
+ * @brief Encodes with the selected implementation
+ */
+static void
+eya_hex_encode_block(eya_uchar_t *dst, const eya_uchar_t *src, eya_usize_t size)
+{
+#if (EYA_HEX_X86)
+    if (eya_hex_has_avx2)
+    {
+        eya_hex_encode_avx2(dst, src, size);
+        return;
+    }
+#endif
+
+    eya_hex_encode_scalar(dst, src, size);
+}
+
+/**
+ * @brief Decodes with the selected implementation
+ */
+static void
+eya_hex_decode_block(eya_uchar_t *dst, const eya_uchar_t *src, eya_usize_t size)
+{
+#if (EYA_HEX_X86)
+    if (eya_hex_has_avx2)
+    {
+        eya_hex_decode_avx2(dst, src, size);
+        return;
+    }
+#endif
+
+    eya_hex_decode_scalar(dst, src, size);
+}
+
+/**
+ * @brief Makes room for bytes at the end of a byte array
+ * @return Pointer to the first byte after the elements of the array
+ */
+static eya_uchar_t *
+eya_hex_reserve(eya_array_t *array, eya_usize_t size)
+{
+    eya_usize_t element_size;
+
+    eya_runtime_check_ref(array);
+    eya_array_unpack(array, nullptr, nullptr, &element_size, nullptr);
+    eya_runtime_check(element_size == 1, EYA_RUNTIME_ERROR_DIFFERENT_ELEMENT_SIZE);
+
+    eya_array_reserve(array, size);
+    return (eya_uchar_t *)eya_array_get_begin(array) + eya_array_get_size(array);
+}
+
+eya_usize_t
+eya_hex_encode_size(eya_usize_t size)
+{
+    eya_usize_t result;
+
+    eya_runtime_check_if(eya_checked_mul(size, 2, &result), EYA_RUNTIME_ERROR_EXCEEDS_MAX_SIZE);
+    return result;
+}
+
+eya_usize_t
+eya_hex_decode_size(eya_usize_t size)
+{
+    eya_runtime_check(!(size & 1), EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+    return size / 2;
+}
+
+eya_usize_t
+eya_hex_encode(const eya_memory_range_t *dst, const eya_memory_range_t *src)
+{
+    const eya_usize_t size   = eya_memory_range_get_size(src);
+    const eya_usize_t result = eya_hex_encode_size(size);
+
+    eya_runtime_check(eya_memory_range_get_size(dst) >= result, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+    eya_hex_encode_block(eya_memory_range_get_begin(dst), eya_memory_range_get_begin(src), size);
+    return result;
+}
+
+eya_usize_t
+eya_hex_decode(const eya_memory_range_t *dst, const eya_memory_range_t *src)
+{
+    const eya_usize_t size   = eya_memory_range_get_size(src);
+    const eya_usize_t result = eya_hex_decode_size(size);
+
+    eya_runtime_check(eya_memory_range_get_size(dst) >= result, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+    eya_hex_decode_block(eya_memory_range_get_begin(dst), eya_memory_range_get_begin(src), size);
+    return result;
+}
+
+eya_usize_t
+eya_hex_encode_append(eya_array_t *dst, const eya_memory_range_t *src)
+{
+    const eya_usize_t size   = eya_memory_range_get_size(src);
+    const eya_usize_t result = eya_hex_encode_size(size);
+
+    eya_hex_encode_block(eya_hex_reserve(dst, result), eya_memory_range_get_begin(src), size);
+    eya_array_resize(dst, eya_array_get_size(dst) + result);
+    return result;
+}
+
+eya_usize_t
+eya_hex_decode_append(eya_array_t *dst, const eya_memory_range_t *src)
+{
+    const eya_usize_t size   = eya_memory_range_get_size(src);
+    const eya_usize_t result = eya_hex_decode_size(size);
+
+    // The bytes go to the reserved capacity first, so an error leaves the size unchanged.
+    eya_hex_decode_block(eya_hex_reserve(dst, result), eya_memory_range_get_begin(src), size);
+    eya_array_resize(dst, eya_array_get_size(dst) + result);
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,913 @@
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE // pread(), pwrite() and syscall() under strict ISO C modes
+#endif
+
+#include <eya/io_async.h>
+
+#include <eya/runtime_exception_catch_stack.h>
+#include <eya/runtime_allocator.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/thread_mutex.h>
+#include <eya/thread_cond.h>
+#include <eya/runtime_try.h>
+#include <eya/math_util.h>
+#include <eya/ptr_util.h>
+#include <eya/nullptr.h>
+#include <eya/atomic.h>
+#include <eya/memory.h>
+#include <eya/thread.h>
+
+#include <errno.h>
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <windows.h>
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+#    include <linux/io_uring.h>
+#    include <sys/syscall.h>
+#    include <sys/mman.h>
+#    include <sys/uio.h>
+#endif
+
+/**
+ * @brief Largest transfer issued by a single request
+ *
+ * Matches the Linux `MAX_RW_COUNT` limit, so longer ranges
+ * complete with a short transfer instead of an error.
+ */
+#define EYA_IO_ASYNC_MAX_TRANSFER 0x7FFFF000
+
+/**
+ * @brief Largest submission ring requested from the kernel
+ *
+ * Matches the Linux `IORING_MAX_ENTRIES` limit, which is not exported to user space.
+ */
+#define EYA_IO_ASYNC_RING_MAX_ENTRIES 32768
+
+/**
+ * @brief Kind of a queued request
+ */
+typedef enum eya_io_async_op
+{
+    EYA_IO_ASYNC_OP_READ, /**< Read from the file into memory */
+    EYA_IO_ASYNC_OP_WRITE /**< Write memory into the file */
+} eya_io_async_op_t;
+
+/**
+ * @brief Request record used by the thread pool backend
+ */
+typedef struct eya_io_async_request
+{
+    eya_io_async_op_t op;        /**< Kind of transfer */
+    int               fd;        /**< Target file descriptor */
+    eya_uoffset_t     offset;    /**< Position in the file */
+    void             *data;      /**< First byte of the memory range */
+    eya_usize_t       size;      /**< Number of bytes to transfer */
+    void             *user_data; /**< Value reported in the completion */
+} eya_io_async_request_t;
+
+/**
+ * @brief State of the thread pool backend
+ *
+ * Requests and completions are kept in rings of `depth` slots indexed by
+ * free-running counters. The owner writes requests at `queued` without locking,
+ * `published` makes them visible to the workers under the mutex.
+ */
+typedef struct eya_io_async_pool
+{
+    eya_thread_mutex_t         mutex;        /**< Protects the counters below */
+    eya_thread_cond_t          work;         /**< Signaled when requests are published */
+    eya_thread_cond_t          done;         /**< Signaled when a completion is stored */
+    eya_io_async_request_t    *requests;     /**< Ring of requests */
+    eya_usize_t                taken;        /**< Requests picked up by workers */
+    eya_usize_t                published;    /**< Requests visible to workers */
+    eya_usize_t                queued;       /**< Requests written by the owner */
+    eya_io_async_completion_t *completions;  /**< Ring of completions */
+    eya_usize_t                reaped;       /**< Completions returned to the owner */
+    eya_usize_t                completed;    /**< Completions stored by workers */
+    eya_thread_t              *threads;      /**< Worker threads */
+    eya_usize_t                thread_count; /**< Number of started workers */
+    eya_usize_t                depth;        /**< Number of ring slots */
+    bool                       stop;         /**< Asks the workers to exit */
+    bool                       ready;        /**< Synchronization objects are initialized */
+} eya_io_async_pool_t;
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+/**
+ * @brief Memory-mapped io_uring instance
+ */
+typedef struct eya_io_async_ring
+{
+    int                  fd;        /**< Ring file descriptor or -1 */
+    void                *sq_ptr;    /**< Mapping of the submission ring */
+    eya_usize_t          sq_size;   /**< Size of the submission ring mapping */
+    void                *cq_ptr;    /**< Mapping of the completion ring */
+    eya_usize_t          cq_size;   /**< Size of the completion ring mapping */
+    struct io_uring_sqe *sqes;      /**< Mapping of the submission entries */
+    eya_usize_t          sqes_size; /**< Size of the submission entries mapping */
+    eya_atomic_uint_t   *sq_tail;   /**< Kernel-visible submission tail */
+    unsigned            *sq_array;  /**< Submission index array */
+    unsigned             sq_mask;   /**< Submission ring mask */
+    unsigned             tail;      /**< Local submission tail */
+    eya_atomic_uint_t   *cq_head;   /**< Kernel-visible completion head */
+    eya_atomic_uint_t   *cq_tail;   /**< Kernel-visible completion tail */
+    unsigned             cq_mask;   /**< Completion ring mask */
+    struct io_uring_cqe *cqes;      /**< Completion entries */
+} eya_io_async_ring_t;
+#endif
+
+struct eya_io_async
+{
+    eya_io_async_backend_t backend;      /**< Selected backend */
+    eya_usize_t            depth;        /**< Maximum number of unreaped operations */
+    eya_usize_t            inflight;     /**< Operations not reaped yet */
+    eya_usize_t            pending;      /**< Operations not accepted by the backend yet */
+    eya_allocated_range_t *buffers;      /**< Registered buffers */
+    eya_usize_t            buffer_count; /**< Number of registered buffers */
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    eya_io_async_ring_t ring; /**< io_uring backend state */
+#endif
+    eya_io_async_pool_t pool; /**< Thread pool backend state */
+};
+
+/**
+ * @brief Allocates zero-filled memory with the runtime allocator
+ * @param[in] size Number of bytes
+ * @return Pointer to the memory
+ */
+static void *
+eya_io_async_alloc(eya_usize_t size)
+{
+    void *ptr = eya_memory_allocator_alloc(eya_runtime_allocator(), size);
+    eya_memory_set(ptr, size, 0);
+    return ptr;
+}
+
+/**
+ * @brief Releases memory obtained with `eya_io_async_alloc()`
+ * @param[in] ptr Pointer to the memory (nullptr is ignored)
+ */
+static void
+eya_io_async_dealloc(void *ptr)
+{
+    eya_memory_allocator_free(eya_runtime_allocator(), ptr);
+}
+
+// --------------------------------------------------------------------------------------------- //
+//                                          THREAD POOL                                          //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief Performs one positional transfer synchronously
+ * @param[in] request Request to execute
+ * @return Transferred bytes or negated error number
+ */
+static eya_ssize_t
+eya_io_async_transfer(const eya_io_async_request_t *request)
+{
+    const eya_usize_t size = eya_math_min(request->size, EYA_IO_ASYNC_MAX_TRANSFER);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    HANDLE     handle = (HANDLE)_get_osfhandle(request->fd);
+    OVERLAPPED ov     = {0};
+    DWORD      count  = 0;
+    BOOL       ok;
+
+    ov.Offset     = (DWORD)(request->offset & 0xFFFFFFFF);
+    ov.OffsetHigh = (DWORD)((eya_ullong_t)request->offset >> 32);
+
+    if (request->op == EYA_IO_ASYNC_OP_READ)
+        ok = ReadFile(handle, request->data, (DWORD)size, &count, &ov);
+    else
+        ok = WriteFile(handle, request->data, (DWORD)size, &count, &ov);
+
+    if (!ok && GetLastError() != ERROR_HANDLE_EOF)
+        return -EIO;
+
+    return (eya_ssize_t)count;
+#else
+    ssize_t ret;
+    do
+    {
+        if (request->op == EYA_IO_ASYNC_OP_READ)
+            ret = pread(request->fd, request->data, size, (off_t)request->offset);
+        else
+            ret = pwrite(request->fd, request->data, size, (off_t)request->offset);
+    } while (ret < 0 && errno == EINTR);
+
+    return ret < 0 ? -(eya_ssize_t)errno : (eya_ssize_t)ret;
+#endif
+}
+
+/**
+ * @brief Worker loop of the thread pool backend
+ * @param[in] arg Pointer to the pool state
+ */
+static void
+eya_io_async_pool_worker(void *arg)
+{
+    eya_io_async_pool_t   *pool = eya_ptr_cast(eya_io_async_pool_t, arg);
+    eya_io_async_request_t request;
+
+    for (;;)
+    {
+        eya_thread_mutex_lock(&pool->mutex);
+        while (!pool->stop && pool->taken == pool->published)
+        {
+            eya_thread_cond_wait(&pool->work, &pool->mutex);
+        }
+
+        if (pool->taken == pool->published)
+        {
+            eya_thread_mutex_unlock(&pool->mutex);
+            break;
+        }
+
+        request = pool->requests[pool->taken % pool->depth];
+        pool->taken++;
+        eya_thread_mutex_unlock(&pool->mutex);
+
+        const eya_ssize_t result = eya_io_async_transfer(&request);
+
+        eya_thread_mutex_lock(&pool->mutex);
+        eya_io_async_completion_t *completion =
+            &pool->completions[pool->completed % pool->depth];
+        completion->user_data = request.user_data;
+        completion->result    = result;
+        pool->completed++;
+        eya_thread_cond_signal(&pool->done);
+        eya_thread_mutex_unlock(&pool->mutex);
+    }
+}
+
+/**
+ * @brief Initializes the thread pool backend and starts its workers
+ * @param[in,out] pool Zero-filled pool state
+ * @param[in] depth Number of ring slots
+ */
+static void
+eya_io_async_pool_start(eya_io_async_pool_t *pool, eya_usize_t depth)
+{
+    const eya_usize_t thread_count =
+        eya_math_min(depth, (eya_usize_t)EYA_LIBRARY_OPTION_IO_ASYNC_FALLBACK_THREADS);
+
+    pool->depth       = depth;
+    pool->requests    = eya_io_async_alloc(depth * sizeof(eya_io_async_request_t));
+    pool->completions = eya_io_async_alloc(depth * sizeof(eya_io_async_completion_t));
+    pool->threads     = eya_io_async_alloc(thread_count * sizeof(eya_thread_t));
+
+    eya_thread_mutex_init(&pool->mutex);
+    eya_thread_cond_init(&pool->work);
+    eya_thread_cond_init(&pool->done);
+    pool->ready = true;
+
+    while (pool->thread_count < thread_count)
+    {
+        eya_thread_create(&pool->threads[pool->thread_count], eya_io_async_pool_worker, pool);
+        pool->thread_count++;
+    }
+}
+
+/**
+ * @brief Stops the workers and releases the thread pool backend
+ * @param[in,out] pool Pool state, possibly partially initialized
+ */
+static void
+eya_io_async_pool_stop(eya_io_async_pool_t *pool)
+{
+    if (pool->ready)
+    {
+        eya_thread_mutex_lock(&pool->mutex);
+        pool->stop = true;
+        eya_thread_cond_broadcast(&pool->work);
+        eya_thread_mutex_unlock(&pool->mutex);
+
+        for (eya_usize_t i = 0; i < pool->thread_count; ++i)
+        {
+            eya_thread_join(&pool->threads[i]);
+        }
+
+        eya_thread_cond_destroy(&pool->done);
+        eya_thread_cond_destroy(&pool->work);
+        eya_thread_mutex_destroy(&pool->mutex);
+    }
+
+    eya_io_async_dealloc(pool->threads);
+    eya_io_async_dealloc(pool->completions);
+    eya_io_async_dealloc(pool->requests);
+}
+
+/**
+ * @brief Stores a request in the pool ring without publishing it
+ */
+static void
+eya_io_async_pool_queue(eya_io_async_pool_t          *pool,
+                        const eya_io_async_request_t *request)
+{
+    pool->requests[pool->queued % pool->depth] = *request;
+    pool->queued++;
+}
+
+/**
+ * @brief Makes all queued requests visible to the workers
+ * @return Number of published requests
+ */
+static eya_usize_t
+eya_io_async_pool_submit(eya_io_async_pool_t *pool)
+{
+    eya_thread_mutex_lock(&pool->mutex);
+    const eya_usize_t count = pool->queued - pool->published;
+    pool->published         = pool->queued;
+    eya_thread_mutex_unlock(&pool->mutex);
+
+    if (count)
+    {
+        eya_thread_cond_broadcast(&pool->work);
+    }
+    return count;
+}
+
+/**
+ * @brief Moves finished completions out of the pool, waiting for at least `min`
+ * @return Number of copied completions
+ */
+static eya_usize_t
+eya_io_async_pool_reap(eya_io_async_pool_t       *pool,
+                       eya_io_async_completion_t *completions,
+                       eya_usize_t                max,
+                       eya_usize_t                min)
+{
+    eya_usize_t count = 0;
+
+    eya_thread_mutex_lock(&pool->mutex);
+    while (pool->completed - pool->reaped < min)
+    {
+        eya_thread_cond_wait(&pool->done, &pool->mutex);
+    }
+
+    while (count < max && pool->reaped != pool->completed)
+    {
+        completions[count++] = pool->completions[pool->reaped % pool->depth];
+        pool->reaped++;
+    }
+    eya_thread_mutex_unlock(&pool->mutex);
+
+    return count;
+}
+
+// --------------------------------------------------------------------------------------------- //
+//                                           IO_URING                                            //
+// --------------------------------------------------------------------------------------------- //
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+/**
+ * @brief Calls `io_uring_enter()`, restarting it when interrupted by a signal
+ * @return Number of consumed submissions or negated error number
+ */
+static int
+eya_io_async_ring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    long ret;
+    do
+    {
+        ret = syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+    } while (ret < 0 && errno == EINTR);
+
+    return ret < 0 ? -errno : (int)ret;
+}
+
+/**
+ * @brief Unmaps the rings and closes the ring descriptor
+ * @param[in,out] ring Ring state, possibly partially initialized
+ */
+static void
+eya_io_async_ring_close(eya_io_async_ring_t *ring)
+{
+    if (ring->sqes)
+    {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_ptr && ring->cq_ptr != ring->sq_ptr)
+    {
+        munmap(ring->cq_ptr, ring->cq_size);
+    }
+    if (ring->sq_ptr)
+    {
+        munmap(ring->sq_ptr, ring->sq_size);
+    }
+    if (ring->fd >= 0)
+    {
+        close(ring->fd);
+    }
+    ring->fd = -1;
+}
+
+/**
+ * @brief Maps a region of the ring descriptor
+ * @return Mapped address or nullptr on failure
+ */
+static void *
+eya_io_async_ring_map(int fd, eya_usize_t size, off_t offset)
+{
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+/**
+ * @brief Creates an io_uring instance able to hold `*depth` operations
+ * @param[in,out] ring Ring state
+ * @param[in,out] depth Requested depth, lowered to what the kernel granted
+ * @return true on success, false if io_uring is unavailable
+ */
+static bool
+eya_io_async_ring_open(eya_io_async_ring_t *ring, eya_usize_t *depth)
+{
+    struct io_uring_params params;
+    eya_memory_set(&params, sizeof(params), 0);
+    params.flags = IORING_SETUP_CLAMP;
+
+    const unsigned entries = (unsigned)eya_math_min(*depth, (eya_usize_t)EYA_IO_ASYNC_RING_MAX_ENTRIES);
+    ring->fd               = (int)syscall(__NR_io_uring_setup, entries, &params);
+    eya_runtime_return_if(ring->fd < 0, false);
+
+    ring->sq_size   = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_size   = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        ring->sq_size = ring->cq_size = eya_math_max(ring->sq_size, ring->cq_size);
+    }
+
+    ring->sq_ptr = eya_io_async_ring_map(ring->fd, ring->sq_size, IORING_OFF_SQ_RING);
+    ring->cq_ptr = (params.features & IORING_FEAT_SINGLE_MMAP)
+                       ? ring->sq_ptr
+                       : eya_io_async_ring_map(ring->fd, ring->cq_size, IORING_OFF_CQ_RING);
+    ring->sqes   = eya_io_async_ring_map(ring->fd, ring->sqes_size, IORING_OFF_SQES);
+
+    if (!ring->sq_ptr || !ring->cq_ptr || !ring->sqes)
+    {
+        eya_io_async_ring_close(ring);
+        return false;
+    }
+
+    ring->sq_tail =
+        eya_ptr_add_by_offset_unsafe(eya_atomic_uint_t, ring->sq_ptr, params.sq_off.tail);
+    ring->sq_array = eya_ptr_add_by_offset_unsafe(unsigned, ring->sq_ptr, params.sq_off.array);
+    ring->sq_mask =
+        *eya_ptr_add_by_offset_unsafe(unsigned, ring->sq_ptr, params.sq_off.ring_mask);
+    ring->tail = *ring->sq_tail;
+
+    ring->cq_head =
+        eya_ptr_add_by_offset_unsafe(eya_atomic_uint_t, ring->cq_ptr, params.cq_off.head);
+    ring->cq_tail =
+        eya_ptr_add_by_offset_unsafe(eya_atomic_uint_t, ring->cq_ptr, params.cq_off.tail);
+    ring->cq_mask =
+        *eya_ptr_add_by_offset_unsafe(unsigned, ring->cq_ptr, params.cq_off.ring_mask);
+    ring->cqes =
+        eya_ptr_add_by_offset_unsafe(struct io_uring_cqe, ring->cq_ptr, params.cq_off.cqes);
+
+    *depth = eya_math_min(*depth, (eya_usize_t)params.sq_entries);
+    return true;
+}
+
+/**
+ * @brief Fills the next submission entry without publishing it
+ */
+static void
+eya_io_async_ring_queue(eya_io_async_ring_t *ring,
+                        eya_io_async_op_t    op,
+                        int                  fd,
+                        eya_uoffset_t        offset,
+                        void                *data,
+                        eya_usize_t          size,
+                        void                *user_data,
+                        eya_ssize_t          buffer_index)
+{
+    const unsigned       index = ring->tail & ring->sq_mask;
+    struct io_uring_sqe *sqe   = &ring->sqes[index];
+
+    eya_memory_set(sqe, sizeof(*sqe), 0);
+    if (buffer_index >= 0)
+    {
+        sqe->opcode    = op == EYA_IO_ASYNC_OP_READ ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+        sqe->buf_index = (__u16)buffer_index;
+    }
+    else
+    {
+        sqe->opcode = op == EYA_IO_ASYNC_OP_READ ? IORING_OP_READ : IORING_OP_WRITE;
+    }
+    sqe->fd        = fd;
+    sqe->off       = (__u64)offset;
+    sqe->addr      = (__u64)eya_ptr_to_uaddr(data);
+    sqe->len       = (__u32)eya_math_min(size, EYA_IO_ASYNC_MAX_TRANSFER);
+    sqe->user_data = (__u64)eya_ptr_to_uaddr(user_data);
+
+    ring->sq_array[index] = index;
+    ring->tail++;
+}
+
+/**
+ * @brief Publishes the local submission tail and enters the kernel
+ * @return Number of consumed submissions
+ */
+static eya_usize_t
+eya_io_async_ring_submit(eya_io_async_ring_t *ring,
+                         eya_usize_t          pending,
+                         unsigned             min_complete)
+{
+    eya_atomic_store(ring->sq_tail, ring->tail, EYA_ATOMIC_RELEASE);
+
+    const unsigned flags = min_complete ? IORING_ENTER_GETEVENTS : 0;
+    eya_runtime_return_if(!pending && !flags, 0);
+
+    const int ret = eya_io_async_ring_enter(ring->fd, (unsigned)pending, min_complete, flags);
+    eya_runtime_return_if(ret == -EAGAIN || ret == -EBUSY, 0);
+    eya_runtime_check(ret >= 0, EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+
+    return (eya_usize_t)ret;
+}
+
+/**
+ * @brief Copies available completion entries and releases their slots
+ * @return Number of copied completions
+ */
+static eya_usize_t
+eya_io_async_ring_reap(eya_io_async_ring_t       *ring,
+                       eya_io_async_completion_t *completions,
+                       eya_usize_t                max)
+{
+    eya_usize_t    count = 0;
+    unsigned       head  = *ring->cq_head;
+    const unsigned tail  = eya_atomic_load(ring->cq_tail, EYA_ATOMIC_ACQUIRE);
+
+    while (count < max && head != tail)
+    {
+        const struct io_uring_cqe *cqe = &ring->cqes[head & ring->cq_mask];
+        completions[count].user_data   = eya_reinterpret_cast(void *, (eya_uaddr_t)cqe->user_data);
+        completions[count].result      = cqe->res;
+        count++;
+        head++;
+    }
+
+    eya_atomic_store(ring->cq_head, head, EYA_ATOMIC_RELEASE);
+    return count;
+}
+
+/**
+ * @brief Submits the pending entries and waits for every operation in flight
+ *
+ * The kernel keeps writing into the caller's buffers until an operation
+ * completes, so the rings must not be released before. Errors of the
+ * system call stop the wait, as nothing is left to do about them.
+ */
+static void
+eya_io_async_ring_drain(eya_io_async_ring_t *ring, eya_usize_t pending, eya_usize_t inflight)
+{
+    eya_io_async_completion_t completions[16];
+
+    eya_atomic_store(ring->sq_tail, ring->tail, EYA_ATOMIC_RELEASE);
+
+    while (inflight)
+    {
+        const int ret =
+            eya_io_async_ring_enter(ring->fd, (unsigned)pending, 1, IORING_ENTER_GETEVENTS);
+        eya_runtime_return_if(ret < 0 && ret != -EAGAIN && ret != -EBUSY);
+
+        pending -= ret > 0 ? (eya_usize_t)ret : 0;
+        inflight -= eya_io_async_ring_reap(ring, completions, eya_math_min(inflight, 16));
+    }
+}
+
+/**
+ * @brief Registers buffers with the kernel, replacing previous ones
+ * @return true on success
+ */
+static bool
+eya_io_async_ring_register(eya_io_async_ring_t         *ring,
+                           const eya_allocated_range_t *ranges,
+                           eya_usize_t                  count)
+{
+    struct iovec *iov = eya_io_async_alloc(count * sizeof(struct iovec));
+    for (eya_usize_t i = 0; i < count; ++i)
+    {
+        iov[i].iov_base = eya_memory_range_get_begin(&ranges[i]);
+        iov[i].iov_len  = eya_memory_range_get_size(&ranges[i]);
+    }
+
+    const long ret =
+        syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS, iov, (unsigned)count);
+    eya_io_async_dealloc(iov);
+
+    return ret == 0;
+}
+
+/**
+ * @brief Drops the buffers registered with the kernel
+ */
+static void
+eya_io_async_ring_unregister(eya_io_async_ring_t *ring)
+{
+    syscall(__NR_io_uring_register, ring->fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+}
+#endif
+
+// --------------------------------------------------------------------------------------------- //
+//                                            ENGINE                                             //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief Selects and initializes a backend for a zero-filled engine
+ */
+static void
+eya_io_async_open(eya_io_async_t *self, eya_io_async_backend_t backend)
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    self->ring.fd = -1;
+
+    if (backend != EYA_IO_ASYNC_BACKEND_THREAD_POOL)
+    {
+        if (eya_io_async_ring_open(&self->ring, &self->depth))
+        {
+            self->backend = EYA_IO_ASYNC_BACKEND_IO_URING;
+            return;
+        }
+        eya_runtime_check(backend == EYA_IO_ASYNC_BACKEND_AUTO, EYA_RUNTIME_ERROR_NOT_SUPPORTED);
+    }
+#else
+    eya_runtime_check(backend != EYA_IO_ASYNC_BACKEND_IO_URING, EYA_RUNTIME_ERROR_NOT_SUPPORTED);
+#endif
+
+    self->backend = EYA_IO_ASYNC_BACKEND_THREAD_POOL;
+    eya_io_async_pool_start(&self->pool, self->depth);
+}
+
+/**
+ * @brief Releases the backend of an engine, possibly partially initialized
+ */
+static void
+eya_io_async_close(eya_io_async_t *self)
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    if (self->backend == EYA_IO_ASYNC_BACKEND_IO_URING)
+    {
+        eya_io_async_ring_drain(&self->ring, self->pending, self->inflight);
+    }
+    eya_io_async_ring_close(&self->ring);
+#endif
+    if (self->pool.ready)
+    {
+        eya_io_async_pool_submit(&self->pool);
+    }
+    eya_io_async_pool_stop(&self->pool);
+    eya_io_async_dealloc(self->buffers);
+    eya_io_async_dealloc(self);
+}
+
+eya_io_async_t *
+eya_io_async_make(eya_usize_t depth, eya_io_async_backend_t backend)
+{
+    eya_runtime_check(depth, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    eya_io_async_t *self = eya_io_async_alloc(sizeof(eya_io_async_t));
+    self->depth          = depth;
+
+    eya_runtime_try(e)
+    {
+        eya_io_async_open(self, backend);
+        eya_runtime_try_return(self);
+    }
+    eya_runtime_catch
+    {
+        eya_io_async_close(self);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+}
+
+void
+eya_io_async_free(eya_io_async_t *self)
+{
+    eya_runtime_return_ifn(self);
+    eya_io_async_close(self);
+}
+
+eya_io_async_backend_t
+eya_io_async_get_backend(const eya_io_async_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->backend;
+}
+
+eya_usize_t
+eya_io_async_get_depth(const eya_io_async_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->depth;
+}
+
+eya_usize_t
+eya_io_async_get_inflight(const eya_io_async_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->inflight;
+}
+
+void
+eya_io_async_unregister_buffers(eya_io_async_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(self->inflight == 0, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+    eya_runtime_return_ifn(self->buffers);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    if (self->backend == EYA_IO_ASYNC_BACKEND_IO_URING)
+    {
+        eya_io_async_ring_unregister(&self->ring);
+    }
+#endif
+
+    eya_io_async_dealloc(self->buffers);
+    self->buffers      = nullptr;
+    self->buffer_count = 0;
+}
+
+void
+eya_io_async_register_buffers(eya_io_async_t              *self,
+                              const eya_allocated_range_t *ranges,
+                              eya_usize_t                  count)
+{
+    eya_runtime_check_ref(ranges);
+    eya_runtime_check(count, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    for (eya_usize_t i = 0; i < count; ++i)
+    {
+        eya_runtime_check(eya_memory_range_has_data(&ranges[i]),
+                          EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE);
+    }
+
+    eya_io_async_unregister_buffers(self);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    if (self->backend == EYA_IO_ASYNC_BACKEND_IO_URING)
+    {
+        eya_runtime_check(eya_io_async_ring_register(&self->ring, ranges, count),
+                          EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+    }
+#endif
+
+    self->buffers = eya_io_async_alloc(count * sizeof(eya_allocated_range_t));
+    eya_memory_copy(self->buffers,
+                    count * sizeof(eya_allocated_range_t),
+                    ranges,
+                    count * sizeof(eya_allocated_range_t));
+    self->buffer_count = count;
+}
+
+/**
+ * @brief Returns the index of the registered buffer containing the range or -1
+ */
+static eya_ssize_t
+eya_io_async_find_buffer(const eya_io_async_t *self, const eya_allocated_range_t *range)
+{
+    for (eya_usize_t i = 0; i < self->buffer_count; ++i)
+    {
+        if (eya_memory_range_contains(&self->buffers[i], range))
+        {
+            return (eya_ssize_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Queues a request on the selected backend
+ * @return true if the request was queued, false if the engine is full
+ */
+static bool
+eya_io_async_queue(eya_io_async_t              *self,
+                   eya_io_async_op_t            op,
+                   int                          fd,
+                   eya_uoffset_t                offset,
+                   const eya_allocated_range_t *range,
+                   void                        *user_data)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(eya_memory_range_has_data(range), EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE);
+    eya_runtime_return_if(self->inflight == self->depth, false);
+
+    void             *data = eya_memory_range_get_begin(range);
+    const eya_usize_t size = eya_memory_range_get_size(range);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    if (self->backend == EYA_IO_ASYNC_BACKEND_IO_URING)
+    {
+        eya_io_async_ring_queue(&self->ring,
+                                op,
+                                fd,
+                                offset,
+                                data,
+                                size,
+                                user_data,
+                                eya_io_async_find_buffer(self, range));
+    }
+    else
+#endif
+    {
+        const eya_io_async_request_t request = {op, fd, offset, data, size, user_data};
+        eya_io_async_pool_queue(&self->pool, &request);
+    }
+
+    self->pending++;
+    self->inflight++;
+    return true;
+}
+
+bool
+eya_io_async_read(eya_io_async_t        *self,
+                  int                    fd,
+                  eya_uoffset_t          offset,
+                  eya_allocated_range_t *range,
+                  void                  *user_data)
+{
+    return eya_io_async_queue(self, EYA_IO_ASYNC_OP_READ, fd, offset, range, user_data);
+}
+
+bool
+eya_io_async_write(eya_io_async_t              *self,
+                   int                          fd,
+                   eya_uoffset_t                offset,
+                   const eya_allocated_range_t *range,
+                   void                        *user_data)
+{
+    return eya_io_async_queue(self, EYA_IO_ASYNC_OP_WRITE, fd, offset, range, user_data);
+}
+
+eya_usize_t
+eya_io_async_submit(eya_io_async_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    eya_usize_t count;
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    if (self->backend == EYA_IO_ASYNC_BACKEND_IO_URING)
+        count = eya_io_async_ring_submit(&self->ring, self->pending, 0);
+    else
+#endif
+        count = eya_io_async_pool_submit(&self->pool);
+
+    self->pending -= count;
+    return count;
+}
+
+eya_usize_t
+eya_io_async_poll(eya_io_async_t *self, eya_io_async_completion_t *completions, eya_usize_t max)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(completions);
+
+    eya_usize_t count;
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    if (self->backend == EYA_IO_ASYNC_BACKEND_IO_URING)
+        count = eya_io_async_ring_reap(&self->ring, completions, max);
+    else
+#endif
+        count = eya_io_async_pool_reap(&self->pool, completions, max, 0);
+
+    self->inflight -= count;
+    return count;
+}
+
+eya_usize_t
+eya_io_async_wait(eya_io_async_t            *self,
+                  eya_io_async_completion_t *completions,
+                  eya_usize_t                max,
+                  eya_usize_t                min)
+{
+    eya_io_async_submit(self);
+    eya_runtime_check_ref(completions);
+
+    const eya_usize_t want = eya_math_min(eya_math_min(min, max), self->inflight);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    if (self->backend == EYA_IO_ASYNC_BACKEND_IO_URING)
+    {
+        eya_usize_t count = eya_io_async_poll(self, completions, max);
+        while (count < want)
+        {
+            self->pending -= eya_io_async_ring_submit(
+                &self->ring, self->pending, (unsigned)(want - count));
+            count += eya_io_async_poll(self, completions + count, max - count);
+        }
+        return count;
+    }
+#endif
+
+    const eya_usize_t count = eya_io_async_pool_reap(&self->pool, completions, max, want);
+    self->inflight -= count;
+    return count;
+}
\ No newline at end of file
@@ -0,0 +1,423 @@
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE // copy_file_range(), splice() and pipe2() under strict ISO C modes
+#endif
+
+#include <eya/io_copy.h>
+
+#include <eya/runtime_exception_catch_stack.h>
+#include <eya/runtime_throw_with_code.h>
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_allocator.h>
+#include <eya/runtime_return_if.h>
+#include <eya/runtime_check.h>
+#include <eya/runtime_try.h>
+#include <eya/optional_param.h>
+#include <eya/math_util.h>
+#include <eya/nullptr.h>
+#include <eya/bool.h>
+
+#include <errno.h>
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+#    include <sys/sendfile.h>
+#    include <fcntl.h>
+#endif
+
+/**
+ * @brief Largest chunk moved by a single system call
+ *
+ * Matches the Linux `MAX_RW_COUNT` limit.
+ */
+#define EYA_IO_COPY_MAX_CHUNK 0x7FFFF000
+
+/**
+ * @brief Largest chunk moved through the internal pipe at once
+ *
+ * Matches the default pipe capacity, so that filling the pipe never blocks.
+ */
+#define EYA_IO_COPY_PIPE_CHUNK 65536
+
+/**
+ * @brief Tells whether a failure means "mechanism not applicable" rather than an I/O error
+ * @param[in] error Value of errno after the failed call
+ */
+static bool
+eya_io_copy_is_unsupported(int error)
+{
+    return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP ||
+           error == ENOTSUP || error == EBADF || error == ESPIPE;
+}
+
+/**
+ * @brief Reads into the bounce buffer from an explicit or the current position
+ */
+static eya_ssize_t
+eya_io_copy_read(int fd, eya_uoffset_t offset, void *buffer, eya_usize_t size)
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    if (offset != EYA_IO_COPY_OFFSET_CURRENT && _lseeki64(fd, (long long)offset, SEEK_SET) < 0)
+        return -1;
+    return _read(fd, buffer, (unsigned)size);
+#else
+    if (offset != EYA_IO_COPY_OFFSET_CURRENT)
+        return pread(fd, buffer, size, (off_t)offset);
+    return read(fd, buffer, size);
+#endif
+}
+
+/**
+ * @brief Writes from the bounce buffer to an explicit or the current position
+ */
+static eya_ssize_t
+eya_io_copy_write(int fd, eya_uoffset_t offset, const void *buffer, eya_usize_t size)
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    if (offset != EYA_IO_COPY_OFFSET_CURRENT && _lseeki64(fd, (long long)offset, SEEK_SET) < 0)
+        return -1;
+    return _write(fd, buffer, (unsigned)size);
+#else
+    if (offset != EYA_IO_COPY_OFFSET_CURRENT)
+        return pwrite(fd, buffer, size, (off_t)offset);
+    return write(fd, buffer, size);
+#endif
+}
+
+/**
+ * @brief Copies through a given bounce buffer
+ * @return Copied bytes
+ */
+static eya_usize_t
+eya_io_copy_bounce(int           fd_in,
+                   eya_uoffset_t off_in,
+                   int           fd_out,
+                   eya_uoffset_t off_out,
+                   eya_usize_t   size,
+                   eya_uchar_t  *buffer,
+                   eya_usize_t   capacity)
+{
+    eya_usize_t total = 0;
+
+    while (total < size)
+    {
+        const eya_usize_t chunk = eya_math_min(size - total, capacity);
+        const eya_ssize_t got   = eya_io_copy_read(fd_in, off_in, buffer, chunk);
+
+        if (got == 0)
+            break;
+
+        if (got < 0)
+        {
+            eya_runtime_check(errno == EINTR, EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+            continue;
+        }
+
+        for (eya_ssize_t put = 0; put < got;)
+        {
+            const eya_ssize_t ret =
+                eya_io_copy_write(fd_out, off_out, buffer + put, (eya_usize_t)(got - put));
+            if (ret < 0)
+            {
+                eya_runtime_check(errno == EINTR, EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+                continue;
+            }
+
+            put += ret;
+            if (off_out != EYA_IO_COPY_OFFSET_CURRENT)
+                off_out += (eya_uoffset_t)ret;
+        }
+
+        total += (eya_usize_t)got;
+        if (off_in != EYA_IO_COPY_OFFSET_CURRENT)
+            off_in += (eya_uoffset_t)got;
+    }
+
+    return total;
+}
+
+/**
+ * @brief Copies through a bounce buffer allocated for the call
+ * @return Copied bytes
+ *
+ * The buffer comes from the runtime allocator and is no larger than the copy,
+ * so threads that never fall back to user space do not pay for it.
+ */
+static eya_usize_t
+eya_io_copy_buffer(int           fd_in,
+                   eya_uoffset_t off_in,
+                   int           fd_out,
+                   eya_uoffset_t off_out,
+                   eya_usize_t   size)
+{
+    eya_runtime_return_ifn(size, 0);
+
+    const eya_usize_t capacity = eya_math_min(size, EYA_LIBRARY_OPTION_IO_COPY_BUFFER_SIZE);
+    eya_uchar_t      *buffer   = eya_memory_allocator_alloc(eya_runtime_allocator(), capacity);
+
+    eya_runtime_try(e)
+    {
+        const eya_usize_t total =
+            eya_io_copy_bounce(fd_in, off_in, fd_out, off_out, size, buffer, capacity);
+
+        eya_memory_allocator_free(eya_runtime_allocator(), buffer);
+        eya_runtime_try_return(total);
+    }
+    eya_runtime_catch
+    {
+        eya_memory_allocator_free(eya_runtime_allocator(), buffer);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+}
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+/**
+ * @brief Copies with `copy_file_range()`
+ * @return Copied bytes, or -1 if the mechanism is not applicable
+ */
+static eya_ssize_t
+eya_io_copy_file_range(int fd_in, loff_t *off_in, int fd_out, loff_t *off_out, eya_usize_t size)
+{
+    eya_usize_t total = 0;
+
+    while (total < size)
+    {
+        const eya_usize_t chunk = eya_math_min(size - total, EYA_IO_COPY_MAX_CHUNK);
+        const ssize_t     ret   = copy_file_range(fd_in, off_in, fd_out, off_out, chunk, 0);
+
+        if (ret > 0)
+            total += (eya_usize_t)ret;
+        else if (ret == 0)
+            break;
+        else if (errno == EINTR)
+            continue;
+        else if (total == 0 && eya_io_copy_is_unsupported(errno))
+            return -1;
+        else
+            eya_runtime_throw_with_code(EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+    }
+
+    return (eya_ssize_t)total;
+}
+
+/**
+ * @brief Copies with `sendfile()` to the current position of the output
+ * @return Copied bytes, or -1 if the mechanism is not applicable
+ */
+static eya_ssize_t
+eya_io_copy_sendfile(int fd_in, loff_t *off_in, int fd_out, eya_usize_t size)
+{
+    eya_usize_t total  = 0;
+    off_t       offset = 0;
+
+    if (off_in)
+        offset = (off_t)*off_in;
+
+    while (total < size)
+    {
+        const eya_usize_t chunk = eya_math_min(size - total, EYA_IO_COPY_MAX_CHUNK);
+        const ssize_t     ret   = sendfile(fd_out, fd_in, off_in ? &offset : nullptr, chunk);
+
+        if (ret > 0)
+            total += (eya_usize_t)ret;
+        else if (ret == 0)
+            break;
+        else if (errno == EINTR)
+            continue;
+        else if (total == 0 && eya_io_copy_is_unsupported(errno))
+            return -1;
+        else
+            eya_runtime_throw_with_code(EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+    }
+
+    return (eya_ssize_t)total;
+}
+
+/**
+ * @brief Moves bytes out of the pipe until it is empty
+ * @return Number of bytes left in the pipe, nonzero on error
+ */
+static eya_usize_t
+eya_io_copy_splice_drain(int pipe_out, int fd_out, loff_t *off_out, eya_usize_t size)
+{
+    while (size)
+    {
+        const ssize_t ret =
+            splice(pipe_out, nullptr, fd_out, off_out, size, SPLICE_F_MOVE | SPLICE_F_MORE);
+
+        if (ret > 0)
+            size -= (eya_usize_t)ret;
+        else if (ret < 0 && errno == EINTR)
+            continue;
+        else
+            break;
+    }
+    return size;
+}
+
+/**
+ * @brief Moves bytes left in the pipe to the output through a bounce buffer
+ * @return Number of bytes moved
+ *
+ * Closes the pipe before rethrowing if the copy fails.
+ */
+static eya_usize_t
+eya_io_copy_splice_flush(const int pipe_fds[2], int fd_out, loff_t *off_out, eya_usize_t size)
+{
+    const eya_uoffset_t position = off_out ? (eya_uoffset_t)*off_out : EYA_IO_COPY_OFFSET_CURRENT;
+
+    eya_runtime_try(e)
+    {
+        const eya_usize_t flushed =
+            eya_io_copy_buffer(pipe_fds[0], EYA_IO_COPY_OFFSET_CURRENT, fd_out, position, size);
+
+        if (off_out)
+            *off_out += (loff_t)flushed;
+        eya_runtime_try_return(flushed);
+    }
+    eya_runtime_catch
+    {
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+}
+
+/**
+ * @brief Copies with `splice()` through a private pipe
+ * @param[out] finished Cleared if the output stopped accepting splices part way,
+ *                      in which case the rest must be copied through a bounce buffer
+ * @return Copied bytes, or -1 if the mechanism is not applicable
+ *
+ * Bytes spliced into the pipe are already consumed from the input,
+ * so if the output refuses them they are moved on through a bounce buffer
+ * rather than dropped. Any other failure after that point is an I/O error.
+ */
+static eya_ssize_t
+eya_io_copy_splice(int         fd_in,
+                   loff_t     *off_in,
+                   int         fd_out,
+                   loff_t     *off_out,
+                   eya_usize_t size,
+                   bool       *finished)
+{
+    int pipe_fds[2];
+    eya_runtime_return_if(pipe2(pipe_fds, O_CLOEXEC) != 0, -1);
+
+    eya_usize_t total    = 0;
+    eya_usize_t stranded = 0;
+    int         error    = 0;
+
+    while (total < size)
+    {
+        const eya_usize_t chunk = eya_math_min(size - total, EYA_IO_COPY_PIPE_CHUNK);
+        const ssize_t     ret =
+            splice(fd_in, off_in, pipe_fds[1], nullptr, chunk, SPLICE_F_MOVE | SPLICE_F_MORE);
+
+        if (ret == 0)
+            break;
+
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            error = errno;
+            break;
+        }
+
+        stranded = eya_io_copy_splice_drain(pipe_fds[0], fd_out, off_out, (eya_usize_t)ret);
+        total += (eya_usize_t)ret - stranded;
+        if (stranded)
+        {
+            error = errno ? errno : EIO;
+            break;
+        }
+    }
+
+    if (stranded && eya_io_copy_is_unsupported(error))
+    {
+        *finished = false;
+        error     = 0;
+
+        total += eya_io_copy_splice_flush(pipe_fds, fd_out, off_out, stranded);
+    }
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+
+    if (error)
+    {
+        eya_runtime_return_if(total == 0 && eya_io_copy_is_unsupported(error), -1);
+        eya_runtime_throw_with_code(EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+    }
+
+    return (eya_ssize_t)total;
+}
+#endif
+
+eya_usize_t
+eya_io_copy_range(int                 fd_in,
+                  eya_uoffset_t       off_in,
+                  int                 fd_out,
+                  eya_uoffset_t       off_out,
+                  eya_usize_t         size,
+                  eya_io_copy_path_t *path)
+{
+    eya_optional_param(eya_io_copy_path_t, path, EYA_IO_COPY_PATH_NONE);
+
+    *path = EYA_IO_COPY_PATH_NONE;
+    eya_runtime_return_ifn(size, 0);
+
+    eya_usize_t copied = 0;
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    loff_t  in_pos  = (loff_t)off_in;
+    loff_t  out_pos = (loff_t)off_out;
+    loff_t *in_ptr  = off_in == EYA_IO_COPY_OFFSET_CURRENT ? nullptr : &in_pos;
+    loff_t *out_ptr = off_out == EYA_IO_COPY_OFFSET_CURRENT ? nullptr : &out_pos;
+
+    eya_ssize_t ret = eya_io_copy_file_range(fd_in, in_ptr, fd_out, out_ptr, size);
+    if (ret >= 0)
+    {
+        *path = EYA_IO_COPY_PATH_COPY_FILE_RANGE;
+        return (eya_usize_t)ret;
+    }
+
+    if (!out_ptr)
+    {
+        ret = eya_io_copy_sendfile(fd_in, in_ptr, fd_out, size);
+        if (ret >= 0)
+        {
+            *path = EYA_IO_COPY_PATH_SENDFILE;
+            return (eya_usize_t)ret;
+        }
+    }
+
+    bool finished = true;
+
+    ret = eya_io_copy_splice(fd_in, in_ptr, fd_out, out_ptr, size, &finished);
+    if (ret >= 0 && finished)
+    {
+        *path = EYA_IO_COPY_PATH_SPLICE;
+        return (eya_usize_t)ret;
+    }
+
+    // The output refused splices after some input was consumed: continue in user space.
+    if (ret > 0)
+    {
+        copied = (eya_usize_t)ret;
+        size -= copied;
+        if (in_ptr)
+            off_in = (eya_uoffset_t)in_pos;
+        if (out_ptr)
+            off_out = (eya_uoffset_t)out_pos;
+    }
+#endif
+
+    *path = EYA_IO_COPY_PATH_BUFFER;
+    return copied + eya_io_copy_buffer(fd_in, off_in, fd_out, off_out, size);
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE // pread() under strict ISO C modes
+#endif
+
+#include <eya/io_direct.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_return_if.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/checked_math.h>
+#include <eya/memory_range.h>
+#include <eya/memory_std.h>
+#include <eya/math_util.h>
+#include <eya/addr_util.h>
+#include <eya/ptr_util.h>
+#include <eya/nullptr.h>
+
+#include <errno.h>
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+/**
+ * @brief Largest chunk read by a single system call
+ *
+ * Matches the Linux `MAX_RW_COUNT` limit, which is page aligned;
+ * reads round it down to the alignment of the pool.
+ */
+#define EYA_IO_DIRECT_MAX_CHUNK 0x7FFFF000
+
+/**
+ * @brief Reads from a file position, retrying interrupted calls
+ * @return Number of bytes read, less than size only at end of file
+ */
+static eya_usize_t
+eya_io_direct_pread(int fd, void *buffer, eya_usize_t size, eya_uoffset_t offset)
+{
+    for (;;)
+    {
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+        eya_runtime_check(_lseeki64(fd, (long long)offset, SEEK_SET) >= 0,
+                          EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+        const eya_ssize_t ret = _read(fd, buffer, (unsigned)size);
+#else
+        const eya_ssize_t ret = pread(fd, buffer, size, (off_t)offset);
+#endif
+        eya_runtime_return_if(ret >= 0, (eya_usize_t)ret);
+        eya_runtime_check(errno == EINTR, EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+    }
+}
+
+void
+eya_io_direct_pool_init(eya_io_direct_pool_t *self,
+                        eya_usize_t           buffer_size,
+                        eya_usize_t           buffer_count,
+                        eya_usize_t           align)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(eya_math_is_power_of_two(align), EYA_RUNTIME_ERROR_NOT_POWER_OF_TWO);
+    eya_runtime_check(align >= sizeof(void *), EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+    eya_runtime_check(buffer_size && buffer_count, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+    eya_runtime_check(eya_addr_is_aligned(buffer_size, align), EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    eya_usize_t size;
+    eya_runtime_check_if(eya_checked_mul(buffer_count, buffer_size, &size),
+                         EYA_RUNTIME_ERROR_OVERFLOW);
+
+    self->slab         = eya_allocated_range_make_aligned(size, align);
+    self->free_head    = nullptr;
+    self->free_count   = buffer_count;
+    self->buffer_size  = buffer_size;
+    self->buffer_count = buffer_count;
+    self->align        = align;
+
+    eya_uchar_t *begin = eya_memory_range_get_begin(&self->slab);
+
+    for (eya_usize_t i = buffer_count; i > 0; --i)
+    {
+        void *buffer                  = begin + (i - 1) * buffer_size;
+        eya_ptr_deref(void *, buffer) = self->free_head;
+        self->free_head               = buffer;
+    }
+}
+
+void
+eya_io_direct_pool_destroy(eya_io_direct_pool_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    eya_allocated_range_clear_aligned(&self->slab);
+    self->free_head  = nullptr;
+    self->free_count = 0;
+}
+
+eya_usize_t
+eya_io_direct_pool_get_available(const eya_io_direct_pool_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->free_count;
+}
+
+bool
+eya_io_direct_pool_acquire(eya_io_direct_pool_t *self, eya_allocated_range_t *buffer)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(buffer);
+    eya_runtime_return_ifn(self->free_head, false);
+
+    void *ptr       = self->free_head;
+    self->free_head = eya_ptr_deref(void *, ptr);
+    --self->free_count;
+
+    eya_memory_range_reset_s(buffer, ptr, self->buffer_size);
+    return true;
+}
+
+void
+eya_io_direct_pool_release(eya_io_direct_pool_t *self, eya_allocated_range_t *buffer)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(buffer);
+
+    void        *begin = eya_memory_range_get_begin(buffer);
+    eya_uchar_t *base  = eya_memory_range_get_begin(&self->slab);
+
+    // The slab size is a multiple of the buffer size,
+    // so a buffer-sized range starting on a buffer boundary lies inside the slab.
+    eya_runtime_check(eya_memory_range_get_size(buffer) == self->buffer_size &&
+                          eya_memory_range_contains_ptr(&self->slab, begin) &&
+                          eya_addr_is_aligned(eya_ptr_udiff(begin, base), self->buffer_size),
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    eya_ptr_deref(void *, begin) = self->free_head;
+    self->free_head              = begin;
+    ++self->free_count;
+
+    eya_memory_range_clear(buffer);
+}
+
+void
+eya_io_direct_reader_init(eya_io_direct_reader_t *self, int fd, eya_io_direct_pool_t *pool)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(pool);
+    eya_runtime_check(eya_io_direct_pool_acquire(pool, &self->superblock),
+                      EYA_RUNTIME_ERROR_RESOURCE_EXHAUSTED);
+
+    self->fd   = fd;
+    self->pool = pool;
+}
+
+void
+eya_io_direct_reader_destroy(eya_io_direct_reader_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    eya_io_direct_pool_release(self->pool, &self->superblock);
+    self->pool = nullptr;
+}
+
+eya_usize_t
+eya_io_direct_reader_read(eya_io_direct_reader_t *self,
+                          eya_uoffset_t           offset,
+                          eya_memory_range_t     *range)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(range);
+
+    eya_uchar_t      *dst   = eya_memory_range_get_begin(range);
+    const eya_usize_t size  = eya_memory_range_get_size(range);
+    const eya_usize_t align = self->pool->align;
+    const eya_usize_t block = self->pool->buffer_size;
+
+    eya_uchar_t *bounce = eya_memory_range_get_begin(&self->superblock);
+    eya_usize_t  total  = 0;
+
+    while (total < size)
+    {
+        const eya_uoffset_t pos  = offset + total;
+        const eya_usize_t   want = size - total;
+        eya_memory_range_t  rest;
+
+        eya_memory_range_reset_s(&rest, dst + total, want);
+
+        if (eya_addr_is_aligned(pos, align) && eya_memory_range_is_aligned(&rest, align) &&
+            want >= align)
+        {
+            const eya_usize_t limit = eya_addr_align_down(EYA_IO_DIRECT_MAX_CHUNK, align);
+            const eya_usize_t chunk = eya_math_min(eya_addr_align_down(want, align), limit);
+            const eya_usize_t got   = eya_io_direct_pread(self->fd, dst + total, chunk, pos);
+
+            total += got;
+            if (got < chunk)
+                break;
+            continue;
+        }
+
+        const eya_uoffset_t base = eya_addr_align_down(pos, align);
+        const eya_usize_t   head = pos - base;
+        const eya_usize_t   got  = eya_io_direct_pread(self->fd, bounce, block, base);
+
+        if (got <= head)
+            break;
+
+        const eya_usize_t count = eya_math_min(got - head, want);
+        eya_memory_std_copy(dst + total, bounce + head, count);
+
+        total += count;
+        if (got < block)
+            break;
+    }
+
+    return total;
+}
\ No newline at end of file
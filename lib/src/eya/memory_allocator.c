@@ -2,6 +2,8 @@
 
 #include <eya/runtime_check_ref.h>
 #include <eya/runtime_return_if.h>
+#include <eya/math_util.h>
+#include <eya/ptr_util.h>
 #include <eya/nullptr.h>
 #include <eya/memory.h>
 
@@ -68,4 +70,29 @@ eya_memory_allocator_realloc(const eya_memory_allocator_t *self,
     eya_memory_allocator_free(self, old_ptr);
 
     return new_ptr;
+}
+
+void *
+eya_memory_allocator_alloc_aligned(const eya_memory_allocator_t *self,
+                                   eya_usize_t                   size,
+                                   eya_usize_t                   align)
+{
+    eya_runtime_check(size, EYA_RUNTIME_ERROR_ZERO_MEMORY_ALLOCATE);
+    eya_runtime_check(eya_math_is_power_of_two(align), EYA_RUNTIME_ERROR_NOT_POWER_OF_TWO);
+
+    const eya_usize_t padding = align - 1 + sizeof(void *);
+    eya_runtime_check(size <= EYA_USIZE_T_MAX - padding, EYA_RUNTIME_ERROR_OVERFLOW);
+
+    void *raw = eya_memory_allocator_alloc(self, size + padding);
+    void *ptr = eya_ptr_align_up(void, eya_ptr_add_by_offset_unsafe(void, raw, sizeof(void *)), align);
+
+    eya_ptr_cast(void *, ptr)[-1] = raw;
+    return ptr;
+}
+
+void
+eya_memory_allocator_free_aligned(const eya_memory_allocator_t *self, void *ptr)
+{
+    eya_runtime_return_ifn(ptr);
+    eya_memory_allocator_free(self, eya_ptr_cast(void *, ptr)[-1]);
 }
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include <eya/memory_crc32c.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_check.h>
+#include <eya/nullptr.h>
+#include <eya/cpu.h>
+#include <eya/bool.h>
+
+#if ((EYA_COMPILER_GCC_LIKE) && defined(__x86_64__)) ||                                            \
+    ((EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && defined(_M_X64))
+#    include <nmmintrin.h>
+#    include <wmmintrin.h>
+#    define EYA_MEMORY_CRC32C_X86 1
+#endif
+
+/**
+ * @brief Reflected CRC-32C polynomial
+ */
+#define EYA_MEMORY_CRC32C_POLY 0x82F63B78u
+
+/**
+ * @brief Size of each of the three streams of one round of the `crc32` loop
+ */
+#define EYA_MEMORY_CRC32C_STREAM 256
+
+/**
+ * @brief Smallest block folded with carry-less multiplications
+ */
+#define EYA_MEMORY_CRC32C_FOLD_MIN 1024
+
+/**
+ * @brief Slicing-by-8 tables, row k advances a byte by k more zero bytes
+ */
+static eya_uint_t eya_memory_crc32c_table[8][256];
+
+/**
+ * @brief `x^(8 * 2^k) mod P` for every bit k of a length in bytes
+ */
+static eya_uint_t eya_memory_crc32c_x2n[64];
+
+#if (EYA_MEMORY_CRC32C_X86)
+/**
+ * @brief Tables appending @ref EYA_MEMORY_CRC32C_STREAM zero bytes, one per byte of a CRC
+ */
+static eya_uint_t eya_memory_crc32c_shift[4][256];
+
+/**
+ * @brief Folding constants for distances of 512 and 128 bits
+ */
+static eya_ullong_t eya_memory_crc32c_fold512[2];
+static eya_ullong_t eya_memory_crc32c_fold128[2];
+
+static bool eya_memory_crc32c_has_sse42;
+static bool eya_memory_crc32c_has_pclmul;
+#endif
+
+/**
+ * @brief Multiplies two polynomials modulo P
+ *
+ * Both are reflected, so that bit 31 holds the coefficient of x^0.
+ */
+static eya_uint_t
+eya_memory_crc32c_mul(eya_uint_t a, eya_uint_t b)
+{
+    eya_uint_t product = 0;
+
+    for (eya_uint_t mask = 0x80000000u; mask; mask >>= 1)
+    {
+        if (a & mask)
+            product ^= b;
+        b = b & 1 ? (b >> 1) ^ EYA_MEMORY_CRC32C_POLY : b >> 1;
+    }
+
+    return product;
+}
+
+/**
+ * @brief Returns `x^n mod P`
+ */
+static eya_uint_t
+eya_memory_crc32c_xn(eya_ullong_t n)
+{
+    eya_uint_t result = 0x80000000u;
+    eya_uint_t square = 0x40000000u;
+
+    for (; n; n >>= 1)
+    {
+        if (n & 1)
+            result = eya_memory_crc32c_mul(square, result);
+        square = eya_memory_crc32c_mul(square, square);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Reads a little-endian 64-bit value
+ *
+ * Compilers merge the byte loads into a single load on little-endian targets.
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_ullong_t
+eya_memory_crc32c_read64(const eya_uchar_t *p)
+{
+    return (eya_ullong_t)p[0] | (eya_ullong_t)p[1] << 8 | (eya_ullong_t)p[2] << 16 |
+           (eya_ullong_t)p[3] << 24 | (eya_ullong_t)p[4] << 32 | (eya_ullong_t)p[5] << 40 |
+           (eya_ullong_t)p[6] << 48 | (eya_ullong_t)p[7] << 56;
+}
+
+/**
+ * @brief Updates a raw CRC with slicing-by-8 tables
+ */
+static eya_uint_t
+eya_memory_crc32c_slice8(eya_uint_t crc, const eya_uchar_t *p, eya_usize_t size)
+{
+    eya_uint_t(*t)[256] = eya_memory_crc32c_table;
+
+    for (; size >= 8; size -= 8, p += 8)
+    {
+        const eya_ullong_t word = eya_memory_crc32c_read64(p) ^ crc;
+        const eya_uint_t   low  = (eya_uint_t)word;
+        const eya_uint_t   high = (eya_uint_t)(word >> 32);
+
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^
+              t[4][low >> 24] ^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^
+              t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+    }
+
+    for (; size; --size, ++p)
+        crc = t[0][(crc ^ *p) & 0xFF] ^ crc >> 8;
+
+    return crc;
+}
+
+#if (EYA_MEMORY_CRC32C_X86)
+/**
+ * @brief Appends @ref EYA_MEMORY_CRC32C_STREAM zero bytes to a raw CRC
+ */
+static eya_uint_t
+eya_memory_crc32c_skip(eya_uint_t crc)
+{
+    eya_uint_t(*t)[256] = eya_memory_crc32c_shift;
+
+    return t[0][crc & 0xFF] ^ t[1][(crc >> 8) & 0xFF] ^ t[2][(crc >> 16) & 0xFF] ^
+           t[3][crc >> 24];
+}
+
+/**
+ * @brief Updates a raw CRC with the `crc32` instruction
+ *
+ * The instruction has a latency of three cycles and a throughput of one,
+ * so three independent streams keep it busy. The streams start from zero
+ * and are merged by appending the length of the following ones to each.
+ */
+EYA_ATTRIBUTE(TARGET("sse4.2"))
+static eya_uint_t
+eya_memory_crc32c_sse42(eya_uint_t crc, const eya_uchar_t *p, eya_usize_t size)
+{
+    eya_ullong_t crc0 = crc;
+
+    for (; size >= 3 * EYA_MEMORY_CRC32C_STREAM; size -= 3 * EYA_MEMORY_CRC32C_STREAM)
+    {
+        const eya_uchar_t *end  = p + EYA_MEMORY_CRC32C_STREAM;
+        eya_ullong_t       crc1 = 0;
+        eya_ullong_t       crc2 = 0;
+
+        for (; p < end; p += 8)
+        {
+            crc0 = _mm_crc32_u64(crc0, eya_memory_crc32c_read64(p));
+            crc1 = _mm_crc32_u64(crc1, eya_memory_crc32c_read64(p + EYA_MEMORY_CRC32C_STREAM));
+            crc2 = _mm_crc32_u64(crc2, eya_memory_crc32c_read64(p + 2 * EYA_MEMORY_CRC32C_STREAM));
+        }
+
+        crc0 = eya_memory_crc32c_skip((eya_uint_t)crc0) ^ crc1;
+        crc0 = eya_memory_crc32c_skip((eya_uint_t)crc0) ^ crc2;
+        p += 2 * EYA_MEMORY_CRC32C_STREAM;
+    }
+
+    for (; size >= 8; size -= 8, p += 8)
+        crc0 = _mm_crc32_u64(crc0, eya_memory_crc32c_read64(p));
+
+    crc = (eya_uint_t)crc0;
+    for (; size; --size, ++p)
+        crc = _mm_crc32_u8(crc, *p);
+
+    return crc;
+}
+
+/**
+ * @brief Multiplies both halves of a 128-bit polynomial by the constants of a fold distance
+ */
+EYA_ATTRIBUTE(TARGET("sse4.2,pclmul"))
+static __m128i
+eya_memory_crc32c_fold(__m128i value, __m128i constants)
+{
+    return _mm_xor_si128(_mm_clmulepi64_si128(value, constants, 0x00),
+                         _mm_clmulepi64_si128(value, constants, 0x11));
+}
+
+/**
+ * @brief Updates a raw CRC with carry-less multiplications
+ *
+ * Four 128-bit lanes are folded forward over the input, then into one lane,
+ * whose two halves are reduced with the `crc32` instruction.
+ * The block must hold at least 64 bytes.
+ */
+EYA_ATTRIBUTE(TARGET("sse4.2,pclmul"))
+static eya_uint_t
+eya_memory_crc32c_pclmul(eya_uint_t crc, const eya_uchar_t *p, eya_usize_t size)
+{
+    const __m128i k512 = _mm_loadu_si128((const __m128i *)eya_memory_crc32c_fold512);
+    const __m128i k128 = _mm_loadu_si128((const __m128i *)eya_memory_crc32c_fold128);
+
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), _mm_cvtsi32_si128((int)crc));
+    __m128i x1 = _mm_loadu_si128((const __m128i *)(p + 16));
+    __m128i x2 = _mm_loadu_si128((const __m128i *)(p + 32));
+    __m128i x3 = _mm_loadu_si128((const __m128i *)(p + 48));
+
+    for (p += 64, size -= 64; size >= 64; p += 64, size -= 64)
+    {
+        x0 = _mm_xor_si128(eya_memory_crc32c_fold(x0, k512), _mm_loadu_si128((const __m128i *)p));
+        x1 = _mm_xor_si128(eya_memory_crc32c_fold(x1, k512),
+                           _mm_loadu_si128((const __m128i *)(p + 16)));
+        x2 = _mm_xor_si128(eya_memory_crc32c_fold(x2, k512),
+                           _mm_loadu_si128((const __m128i *)(p + 32)));
+        x3 = _mm_xor_si128(eya_memory_crc32c_fold(x3, k512),
+                           _mm_loadu_si128((const __m128i *)(p + 48)));
+    }
+
+    x1 = _mm_xor_si128(eya_memory_crc32c_fold(x0, k128), x1);
+    x2 = _mm_xor_si128(eya_memory_crc32c_fold(x1, k128), x2);
+    x3 = _mm_xor_si128(eya_memory_crc32c_fold(x2, k128), x3);
+
+    for (; size >= 16; p += 16, size -= 16)
+        x3 = _mm_xor_si128(eya_memory_crc32c_fold(x3, k128), _mm_loadu_si128((const __m128i *)p));
+
+    // The CRC of the lane is its value times x^32, which is what
+    // the instruction computes for each 64-bit half.
+    eya_ullong_t halves[2];
+    _mm_storeu_si128((__m128i *)halves, x3);
+
+    crc = (eya_uint_t)_mm_crc32_u64(_mm_crc32_u64(0, halves[0]), halves[1]);
+    return eya_memory_crc32c_sse42(crc, p, size);
+}
+
+/**
+ * @brief Returns the folding constants of a distance in bits
+ *
+ * The lower half multiplies the earlier 64 bits of a lane, the upper half the
+ * later ones. A carry-less product of reflected values carries one extra
+ * factor x, which the exponents take back.
+ */
+static void
+eya_memory_crc32c_make_fold(eya_ullong_t *constants, eya_ullong_t distance)
+{
+    constants[0] = (eya_ullong_t)eya_memory_crc32c_xn(distance + 63) << 32;
+    constants[1] = (eya_ullong_t)eya_memory_crc32c_xn(distance - 1) << 32;
+}
+#endif
+
+/**
+ * @brief Fills the tables and selects the implementation when the library is loaded
+ */
+eya_compiler_constructor(eya_memory_crc32c_init)
+{
+    for (eya_uint_t i = 0; i < 256; ++i)
+    {
+        eya_uint_t crc = i;
+
+        for (eya_usize_t bit = 0; bit < 8; ++bit)
+            crc = crc & 1 ? (crc >> 1) ^ EYA_MEMORY_CRC32C_POLY : crc >> 1;
+        eya_memory_crc32c_table[0][i] = crc;
+    }
+
+    for (eya_usize_t k = 1; k < 8; ++k)
+        for (eya_usize_t i = 0; i < 256; ++i)
+        {
+            const eya_uint_t crc = eya_memory_crc32c_table[k - 1][i];
+            eya_memory_crc32c_table[k][i] = eya_memory_crc32c_table[0][crc & 0xFF] ^ crc >> 8;
+        }
+
+    eya_uint_t x2n = eya_memory_crc32c_xn(8);
+    for (eya_usize_t k = 0; k < 64; ++k)
+    {
+        eya_memory_crc32c_x2n[k] = x2n;
+        x2n                      = eya_memory_crc32c_mul(x2n, x2n);
+    }
+
+#if (EYA_MEMORY_CRC32C_X86)
+    const eya_uint_t skip = eya_memory_crc32c_xn(8 * EYA_MEMORY_CRC32C_STREAM);
+
+    for (eya_usize_t k = 0; k < 4; ++k)
+        for (eya_uint_t i = 0; i < 256; ++i)
+            eya_memory_crc32c_shift[k][i] = eya_memory_crc32c_mul(skip, i << (8 * k));
+
+    eya_memory_crc32c_make_fold(eya_memory_crc32c_fold512, 512);
+    eya_memory_crc32c_make_fold(eya_memory_crc32c_fold128, 128);
+    eya_memory_crc32c_has_sse42  = eya_cpu_has(EYA_CPU_FEATURE_SSE4_2);
+    eya_memory_crc32c_has_pclmul = eya_cpu_has(EYA_CPU_FEATURE_SSE4_2 | EYA_CPU_FEATURE_PCLMUL);
+#endif
+}
+
+eya_uint_t
+eya_memory_crc32c(eya_uint_t crc, const void *data, eya_usize_t size)
+{
+    eya_runtime_check(data || !size, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+    const eya_uchar_t *p = data;
+
+    crc = ~crc;
+
+#if (EYA_MEMORY_CRC32C_X86)
+    if (eya_memory_crc32c_has_pclmul && size >= EYA_MEMORY_CRC32C_FOLD_MIN)
+        return ~eya_memory_crc32c_pclmul(crc, p, size);
+
+    if (eya_memory_crc32c_has_sse42)
+        return ~eya_memory_crc32c_sse42(crc, p, size);
+#endif
+
+    return ~eya_memory_crc32c_slice8(crc, p, size);
+}
+
+eya_uint_t
+eya_memory_crc32c_combine(eya_uint_t crc1, eya_uint_t crc2, eya_ullong_t size2)
+{
+    eya_uint_t shift = 0x80000000u;
+
+    for (eya_usize_t k = 0; size2; ++k, size2 >>= 1)
+        if (size2 & 1)
+            shift = eya_memory_crc32c_mul(eya_memory_crc32c_x2n[k], shift);
+
+    return eya_memory_crc32c_mul(shift, crc1) ^ crc2;
+}
+
+const char *
+eya_memory_crc32c_get_impl(void)
+{
+#if (EYA_MEMORY_CRC32C_X86)
+    if (eya_memory_crc32c_has_pclmul)
+        return "pclmul";
+    if (eya_memory_crc32c_has_sse42)
+        return "sse4.2";
+#endif
+    return "slice8";
+}
\ No newline at end of file
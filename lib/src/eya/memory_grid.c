@@ -0,0 +1,240 @@
+#include <eya/memory_grid.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/memory_std.h>
+#include <eya/math_util.h>
+#include <eya/ptr_util.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define EYA_MEMORY_GRID_SSE2 1
+#endif
+
+/**
+ * @brief Number of bytes of one row of a transpose tile
+ *
+ * A tile of `tile * tile` elements keeps one cache line of every
+ * source and destination row it touches resident while it is transposed.
+ */
+#define EYA_MEMORY_GRID_TILE_BYTES 128
+
+/**
+ * @brief Returns the side of a transpose tile in elements
+ *
+ * The result is a multiple of 4, so register blocks fit into full tiles.
+ */
+static eya_usize_t
+eya_memory_grid_tile(eya_usize_t element_size)
+{
+    const eya_usize_t tile = EYA_MEMORY_GRID_TILE_BYTES / element_size;
+    return eya_math_max(tile, 4) & ~(eya_usize_t)3;
+}
+
+/**
+ * @brief Returns the address of an element without bounds checking
+ */
+static eya_uchar_t *
+eya_memory_grid_at_unsafe(const eya_memory_grid_t *self, eya_usize_t row, eya_usize_t col)
+{
+    return eya_ptr_cast(eya_uchar_t, self->base) + row * self->row_pitch + col * self->element_size;
+}
+
+/**
+ * @brief Transposes a rectangle element by element
+ *
+ * Every source row segment becomes a destination column segment.
+ */
+static void
+eya_memory_grid_transpose_rect(const eya_memory_grid_t *dst,
+                               const eya_memory_grid_t *src,
+                               eya_usize_t              r0,
+                               eya_usize_t              r1,
+                               eya_usize_t              c0,
+                               eya_usize_t              c1)
+{
+    if (c0 >= c1)
+        return;
+
+    for (eya_usize_t r = r0; r < r1; ++r)
+    {
+        const eya_memory_strided_t from = {
+            eya_memory_grid_at_unsafe(src, r, c0), src->element_size, src->element_size, c1 - c0};
+        const eya_memory_strided_t to = {
+            eya_memory_grid_at_unsafe(dst, c0, r), dst->element_size, dst->row_pitch, c1 - c0};
+
+        eya_memory_strided_copy(&to, &from);
+    }
+}
+
+#if (EYA_MEMORY_GRID_SSE2)
+/**
+ * @brief Transposes a 4x4 block of 4-byte elements in registers
+ */
+static void
+eya_memory_grid_transpose_4x4(eya_uchar_t       *dst,
+                              eya_usize_t        dst_pitch,
+                              const eya_uchar_t *src,
+                              eya_usize_t        src_pitch)
+{
+    const __m128i a = _mm_loadu_si128((const __m128i *)(src));
+    const __m128i b = _mm_loadu_si128((const __m128i *)(src + src_pitch));
+    const __m128i c = _mm_loadu_si128((const __m128i *)(src + 2 * src_pitch));
+    const __m128i d = _mm_loadu_si128((const __m128i *)(src + 3 * src_pitch));
+
+    const __m128i ab_lo = _mm_unpacklo_epi32(a, b);
+    const __m128i cd_lo = _mm_unpacklo_epi32(c, d);
+    const __m128i ab_hi = _mm_unpackhi_epi32(a, b);
+    const __m128i cd_hi = _mm_unpackhi_epi32(c, d);
+
+    _mm_storeu_si128((__m128i *)(dst), _mm_unpacklo_epi64(ab_lo, cd_lo));
+    _mm_storeu_si128((__m128i *)(dst + dst_pitch), _mm_unpackhi_epi64(ab_lo, cd_lo));
+    _mm_storeu_si128((__m128i *)(dst + 2 * dst_pitch), _mm_unpacklo_epi64(ab_hi, cd_hi));
+    _mm_storeu_si128((__m128i *)(dst + 3 * dst_pitch), _mm_unpackhi_epi64(ab_hi, cd_hi));
+}
+
+/**
+ * @brief Transposes a 2x2 block of 8-byte elements in registers
+ */
+static void
+eya_memory_grid_transpose_2x2(eya_uchar_t       *dst,
+                              eya_usize_t        dst_pitch,
+                              const eya_uchar_t *src,
+                              eya_usize_t        src_pitch)
+{
+    const __m128i a = _mm_loadu_si128((const __m128i *)(src));
+    const __m128i b = _mm_loadu_si128((const __m128i *)(src + src_pitch));
+
+    _mm_storeu_si128((__m128i *)(dst), _mm_unpacklo_epi64(a, b));
+    _mm_storeu_si128((__m128i *)(dst + dst_pitch), _mm_unpackhi_epi64(a, b));
+}
+#endif
+
+/**
+ * @brief Transposes one tile, using register blocks where the element size allows it
+ */
+static void
+eya_memory_grid_transpose_tile(const eya_memory_grid_t *dst,
+                               const eya_memory_grid_t *src,
+                               eya_usize_t              r0,
+                               eya_usize_t              r1,
+                               eya_usize_t              c0,
+                               eya_usize_t              c1)
+{
+#if (EYA_MEMORY_GRID_SSE2)
+    const eya_usize_t block = src->element_size == 4 ? 4 : src->element_size == 8 ? 2 : 0;
+
+    if (block)
+    {
+        const eya_usize_t r_end = r0 + (r1 - r0) / block * block;
+        const eya_usize_t c_end = c0 + (c1 - c0) / block * block;
+
+        for (eya_usize_t r = r0; r < r_end; r += block)
+        {
+            for (eya_usize_t c = c0; c < c_end; c += block)
+            {
+                eya_uchar_t       *to   = eya_memory_grid_at_unsafe(dst, c, r);
+                const eya_uchar_t *from = eya_memory_grid_at_unsafe(src, r, c);
+
+                if (block == 4)
+                    eya_memory_grid_transpose_4x4(to, dst->row_pitch, from, src->row_pitch);
+                else
+                    eya_memory_grid_transpose_2x2(to, dst->row_pitch, from, src->row_pitch);
+            }
+        }
+
+        eya_memory_grid_transpose_rect(dst, src, r0, r_end, c_end, c1);
+        eya_memory_grid_transpose_rect(dst, src, r_end, r1, c0, c1);
+        return;
+    }
+#endif
+
+    eya_memory_grid_transpose_rect(dst, src, r0, r1, c0, c1);
+}
+
+eya_memory_grid_t
+eya_memory_grid_make(void       *base,
+                     eya_usize_t element_size,
+                     eya_usize_t rows,
+                     eya_usize_t cols,
+                     eya_usize_t row_pitch)
+{
+    eya_runtime_check_ref(base);
+    eya_runtime_check(element_size, EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE);
+    eya_runtime_check(cols <= EYA_USIZE_T_MAX / element_size, EYA_RUNTIME_ERROR_OVERFLOW);
+    eya_runtime_check(row_pitch >= cols * element_size, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+    eya_runtime_check(rows <= 1 || !row_pitch ||
+                          rows - 1 <= (EYA_USIZE_T_MAX - cols * element_size) / row_pitch,
+                      EYA_RUNTIME_ERROR_OVERFLOW);
+
+    const eya_memory_grid_t result = {base, element_size, rows, cols, row_pitch};
+    return result;
+}
+
+void *
+eya_memory_grid_at(const eya_memory_grid_t *self, eya_usize_t row, eya_usize_t col)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(row < self->rows && col < self->cols, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+    return eya_memory_grid_at_unsafe(self, row, col);
+}
+
+eya_memory_strided_t
+eya_memory_grid_row(const eya_memory_grid_t *self, eya_usize_t row)
+{
+    void *base = eya_memory_grid_at(self, row, 0);
+    return eya_memory_strided_make(base, self->element_size, self->element_size, self->cols);
+}
+
+eya_memory_strided_t
+eya_memory_grid_column(const eya_memory_grid_t *self, eya_usize_t col)
+{
+    void *base = eya_memory_grid_at(self, 0, col);
+    return eya_memory_strided_make(base, self->element_size, self->row_pitch, self->rows);
+}
+
+void
+eya_memory_grid_copy(const eya_memory_grid_t *self, const eya_memory_grid_t *other)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(other);
+    eya_runtime_check(self->element_size == other->element_size && self->rows == other->rows &&
+                          self->cols == other->cols,
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    const eya_usize_t row_size = self->cols * self->element_size;
+
+    // Rows without padding form one contiguous block.
+    const bool        packed = self->row_pitch == row_size && other->row_pitch == row_size;
+    const eya_usize_t rows   = packed ? 1 : self->rows;
+    const eya_usize_t size   = packed ? row_size * self->rows : row_size;
+
+    for (eya_usize_t r = 0; r < rows; ++r)
+    {
+        eya_memory_std_copy(
+            eya_memory_grid_at_unsafe(self, r, 0), eya_memory_grid_at_unsafe(other, r, 0), size);
+    }
+}
+
+void
+eya_memory_grid_transpose(const eya_memory_grid_t *self, const eya_memory_grid_t *other)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(other);
+    eya_runtime_check(self->element_size == other->element_size && self->rows == other->cols &&
+                          self->cols == other->rows,
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    const eya_usize_t tile = eya_memory_grid_tile(other->element_size);
+
+    for (eya_usize_t r = 0; r < other->rows; r += tile)
+    {
+        const eya_usize_t r_end = eya_math_min(r + tile, other->rows);
+
+        for (eya_usize_t c = 0; c < other->cols; c += tile)
+        {
+            const eya_usize_t c_end = eya_math_min(c + tile, other->cols);
+            eya_memory_grid_transpose_tile(self, other, r, r_end, c, c_end);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include <eya/memory_parallel.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/memory_std.h>
+#include <eya/math_util.h>
+#include <eya/addr_util.h>
+#include <eya/ptr_util.h>
+#include <eya/nullptr.h>
+#include <eya/atomic.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define EYA_MEMORY_PARALLEL_SSE2 1
+#endif
+
+/**
+ * @brief Page size that chunk boundaries are aligned to
+ */
+#define EYA_MEMORY_PARALLEL_PAGE_SIZE 4096
+
+#if (EYA_LIBRARY_OPTION_MEMORY_PARALLEL_CHUNK_SIZE % EYA_MEMORY_PARALLEL_PAGE_SIZE)
+#    error "EYA_LIBRARY_OPTION_MEMORY_PARALLEL_CHUNK_SIZE must be a multiple of 4096"
+#endif
+
+/**
+ * @brief Arguments shared by the chunks of one operation
+ */
+typedef struct eya_memory_parallel_job
+{
+    eya_uchar_t       *dst;   /**< Destination, or the first buffer of a comparison */
+    const eya_uchar_t *src;   /**< Source, or the second buffer of a comparison */
+    eya_usize_t        size;  /**< Number of bytes */
+    eya_usize_t        skew;  /**< Offset of `dst` within its page */
+    eya_uchar_t        val;   /**< Byte of a fill */
+    eya_atomic_usize_t first; /**< Offset of the first difference found so far */
+} eya_memory_parallel_job_t;
+
+/**
+ * @brief Returns the number of chunks of a job
+ */
+static eya_usize_t
+eya_memory_parallel_count(const eya_memory_parallel_job_t *job)
+{
+    const eya_usize_t span = job->skew + job->size;
+    return span / EYA_LIBRARY_OPTION_MEMORY_PARALLEL_CHUNK_SIZE +
+           (span % EYA_LIBRARY_OPTION_MEMORY_PARALLEL_CHUNK_SIZE != 0);
+}
+
+/**
+ * @brief Returns the offset of a chunk boundary, the chunks start on page boundaries of `dst`
+ */
+static eya_usize_t
+eya_memory_parallel_bound(const eya_memory_parallel_job_t *job, eya_usize_t index)
+{
+    const eya_usize_t offset = index * EYA_LIBRARY_OPTION_MEMORY_PARALLEL_CHUNK_SIZE;
+    return offset <= job->skew ? 0 : eya_math_min(offset - job->skew, job->size);
+}
+
+#if (EYA_MEMORY_PARALLEL_SSE2)
+/**
+ * @brief Returns the number of bytes before the next 16-byte boundary, at most `n`
+ */
+static eya_usize_t
+eya_memory_parallel_head(const eya_uchar_t *dst, eya_usize_t n)
+{
+    const eya_usize_t offset = eya_addr_align_by_offset(eya_ptr_to_uaddr(dst), 16);
+    return eya_math_min(offset ? 16 - offset : 0, n);
+}
+#endif
+
+/**
+ * @brief Copies a chunk with non-temporal stores where available
+ */
+static void
+eya_memory_parallel_stream_copy(eya_uchar_t *dst, const eya_uchar_t *src, eya_usize_t n)
+{
+#if (EYA_MEMORY_PARALLEL_SSE2)
+    const eya_usize_t head = eya_memory_parallel_head(dst, n);
+
+    eya_memory_std_copy(dst, src, head);
+    dst += head;
+    src += head;
+    n -= head;
+
+    for (; n >= 64; n -= 64, dst += 64, src += 64)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i *)(src));
+        const __m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+        const __m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+
+        _mm_stream_si128((__m128i *)(dst), a);
+        _mm_stream_si128((__m128i *)(dst + 16), b);
+        _mm_stream_si128((__m128i *)(dst + 32), c);
+        _mm_stream_si128((__m128i *)(dst + 48), d);
+    }
+
+    // Streaming stores are weakly ordered, the fence makes them visible before the join.
+    _mm_sfence();
+#endif
+    eya_memory_std_copy(dst, src, n);
+}
+
+/**
+ * @brief Fills a chunk with non-temporal stores where available
+ */
+static void
+eya_memory_parallel_stream_set(eya_uchar_t *dst, eya_uchar_t val, eya_usize_t n)
+{
+#if (EYA_MEMORY_PARALLEL_SSE2)
+    const eya_usize_t head  = eya_memory_parallel_head(dst, n);
+    const __m128i     value = _mm_set1_epi8((char)val);
+
+    eya_memory_std_set(dst, val, head);
+    dst += head;
+    n -= head;
+
+    for (; n >= 64; n -= 64, dst += 64)
+    {
+        _mm_stream_si128((__m128i *)(dst), value);
+        _mm_stream_si128((__m128i *)(dst + 16), value);
+        _mm_stream_si128((__m128i *)(dst + 32), value);
+        _mm_stream_si128((__m128i *)(dst + 48), value);
+    }
+
+    _mm_sfence();
+#endif
+    eya_memory_std_set(dst, val, n);
+}
+
+/**
+ * @brief Loop body of a parallel copy
+ */
+static void
+eya_memory_parallel_copy_range(void *context, eya_usize_t begin, eya_usize_t end)
+{
+    const eya_memory_parallel_job_t *job   = context;
+    const eya_usize_t                first = eya_memory_parallel_bound(job, begin);
+    const eya_usize_t                last  = eya_memory_parallel_bound(job, end);
+
+    eya_memory_parallel_stream_copy(job->dst + first, job->src + first, last - first);
+}
+
+/**
+ * @brief Loop body of a parallel fill
+ */
+static void
+eya_memory_parallel_set_range(void *context, eya_usize_t begin, eya_usize_t end)
+{
+    const eya_memory_parallel_job_t *job   = context;
+    const eya_usize_t                first = eya_memory_parallel_bound(job, begin);
+    const eya_usize_t                last  = eya_memory_parallel_bound(job, end);
+
+    eya_memory_parallel_stream_set(job->dst + first, job->val, last - first);
+}
+
+/**
+ * @brief Loop body of a parallel comparison
+ *
+ * Keeps the smallest offset of a difference, chunks past it are skipped.
+ */
+static void
+eya_memory_parallel_compare_range(void *context, eya_usize_t begin, eya_usize_t end)
+{
+    eya_memory_parallel_job_t *job   = context;
+    const eya_usize_t          first = eya_memory_parallel_bound(job, begin);
+    const eya_usize_t          last  = eya_memory_parallel_bound(job, end);
+    eya_usize_t                found = eya_atomic_load(&job->first, EYA_ATOMIC_RELAXED);
+
+    eya_runtime_return_if(first >= found);
+
+    const eya_uchar_t *diff =
+        eya_memory_std_compare(job->dst + first, job->src + first, last - first);
+    eya_runtime_return_ifn(diff);
+
+    const eya_usize_t offset = (eya_usize_t)(diff - job->dst);
+    while (offset < found)
+    {
+        if (eya_atomic_compare_exchange_weak(
+                &job->first, &found, offset, EYA_ATOMIC_RELAXED, EYA_ATOMIC_RELAXED))
+            break;
+    }
+}
+
+/**
+ * @brief Prepares a job over `n` bytes at `dst`
+ */
+static void
+eya_memory_parallel_job_init(eya_memory_parallel_job_t *job,
+                             const void                *dst,
+                             const void                *src,
+                             eya_usize_t                n)
+{
+    job->dst  = eya_ptr_cast(eya_uchar_t, dst);
+    job->src  = src;
+    job->size = n;
+    job->skew = eya_addr_align_by_offset(eya_ptr_to_uaddr(dst), EYA_MEMORY_PARALLEL_PAGE_SIZE);
+    job->val  = 0;
+    eya_atomic_store(&job->first, n, EYA_ATOMIC_RELAXED);
+}
+
+void *
+eya_memory_parallel_copy(eya_thread_pool_t *pool, void *dst, const void *src, eya_usize_t n)
+{
+    eya_runtime_check_ref(pool);
+    eya_runtime_return_if(n < EYA_LIBRARY_OPTION_MEMORY_PARALLEL_THRESHOLD,
+                          eya_memory_std_copy(dst, src, n));
+    eya_runtime_check_ref(dst);
+    eya_runtime_check_ref(src);
+
+    eya_memory_parallel_job_t job;
+    eya_memory_parallel_job_init(&job, dst, src, n);
+    eya_thread_pool_parallel_for(
+        pool, 0, eya_memory_parallel_count(&job), 1, eya_memory_parallel_copy_range, &job);
+
+    return job.dst + n;
+}
+
+void *
+eya_memory_parallel_set(eya_thread_pool_t *pool, void *dst, eya_uchar_t val, eya_usize_t n)
+{
+    eya_runtime_check_ref(pool);
+    eya_runtime_return_if(n < EYA_LIBRARY_OPTION_MEMORY_PARALLEL_THRESHOLD,
+                          eya_memory_std_set(dst, val, n));
+    eya_runtime_check_ref(dst);
+
+    eya_memory_parallel_job_t job;
+    eya_memory_parallel_job_init(&job, dst, nullptr, n);
+    job.val = val;
+    eya_thread_pool_parallel_for(
+        pool, 0, eya_memory_parallel_count(&job), 1, eya_memory_parallel_set_range, &job);
+
+    return job.dst + n;
+}
+
+const void *
+eya_memory_parallel_compare(eya_thread_pool_t *pool,
+                            const void        *lhs,
+                            const void        *rhs,
+                            eya_usize_t        n)
+{
+    eya_runtime_check_ref(pool);
+    eya_runtime_return_if(n < EYA_LIBRARY_OPTION_MEMORY_PARALLEL_THRESHOLD,
+                          eya_memory_std_compare(lhs, rhs, n));
+    eya_runtime_check_ref(lhs);
+    eya_runtime_check_ref(rhs);
+
+    eya_memory_parallel_job_t job;
+    eya_memory_parallel_job_init(&job, lhs, rhs, n);
+    eya_thread_pool_parallel_for(
+        pool, 0, eya_memory_parallel_count(&job), 1, eya_memory_parallel_compare_range, &job);
+
+    const eya_usize_t first = eya_atomic_load(&job.first, EYA_ATOMIC_RELAXED);
+    return first < n ? job.dst + first : nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include <eya/memory_strided.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/algorithm_util.h>
+#include <eya/memory_std.h>
+#include <eya/ptr_util.h>
+
+/**
+ * @brief Copies `count` elements of a constant size between two strided layouts
+ *
+ * The size is a compile-time constant, so the inner copy becomes plain moves.
+ */
+#define eya_memory_strided_copy_loop(N, dst, dst_stride, src, src_stride, count)                   \
+    do                                                                                             \
+    {                                                                                              \
+        for (eya_usize_t i = 0; i < (count); ++i)                                                  \
+        {                                                                                          \
+            eya_usize_t n = (N);                                                                   \
+                                                                                                   \
+            eya_algorithm_copy(                                                                    \
+                eya_uchar_t, (dst) + i * (dst_stride), (src) + i * (src_stride), n);               \
+        }                                                                                          \
+    } while (0)
+
+/**
+ * @brief Copies elements between two strided layouts of the same element size
+ */
+static void
+eya_memory_strided_copy_elements(eya_uchar_t       *dst,
+                                 eya_usize_t        dst_stride,
+                                 const eya_uchar_t *src,
+                                 eya_usize_t        src_stride,
+                                 eya_usize_t        element_size,
+                                 eya_usize_t        count)
+{
+    if (dst_stride == element_size && src_stride == element_size)
+    {
+        eya_memory_std_copy(dst, src, element_size * count);
+        return;
+    }
+
+    switch (element_size)
+    {
+    case 1:
+        eya_memory_strided_copy_loop(1, dst, dst_stride, src, src_stride, count);
+        break;
+    case 2:
+        eya_memory_strided_copy_loop(2, dst, dst_stride, src, src_stride, count);
+        break;
+    case 4:
+        eya_memory_strided_copy_loop(4, dst, dst_stride, src, src_stride, count);
+        break;
+    case 8:
+        eya_memory_strided_copy_loop(8, dst, dst_stride, src, src_stride, count);
+        break;
+    case 16:
+        eya_memory_strided_copy_loop(16, dst, dst_stride, src, src_stride, count);
+        break;
+    default:
+        for (eya_usize_t i = 0; i < count; ++i)
+            eya_memory_std_copy(dst + i * dst_stride, src + i * src_stride, element_size);
+        break;
+    }
+}
+
+/**
+ * @brief Returns the begin of a dense range after checking it can hold the packed elements
+ */
+static void *
+eya_memory_strided_check_dense(const eya_memory_strided_t *self, const eya_memory_range_t *range)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(eya_memory_range_get_size(range) >= eya_memory_strided_get_packed_size(self),
+                      EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+    return eya_memory_range_get_begin(range);
+}
+
+eya_memory_strided_t
+eya_memory_strided_make(void *base, eya_usize_t element_size, eya_usize_t stride, eya_usize_t count)
+{
+    eya_runtime_check_ref(base);
+    eya_runtime_check(element_size, EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE);
+    eya_runtime_check(stride >= element_size, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+    eya_runtime_check(count <= 1 || count - 1 <= (EYA_USIZE_T_MAX - element_size) / stride,
+                      EYA_RUNTIME_ERROR_OVERFLOW);
+
+    const eya_memory_strided_t result = {base, element_size, stride, count};
+    return result;
+}
+
+eya_memory_strided_t
+eya_memory_strided_make_dense(const eya_memory_range_t *range, eya_usize_t element_size)
+{
+    eya_runtime_check(eya_memory_range_has_data(range), EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE);
+    eya_runtime_check(element_size, EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE);
+
+    const eya_usize_t size = eya_memory_range_get_size(range);
+    eya_runtime_check(size % element_size == 0, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    return eya_memory_strided_make(
+        eya_memory_range_get_begin(range), element_size, element_size, size / element_size);
+}
+
+bool
+eya_memory_strided_is_dense(const eya_memory_strided_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->stride == self->element_size;
+}
+
+eya_usize_t
+eya_memory_strided_get_packed_size(const eya_memory_strided_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->count * self->element_size;
+}
+
+void *
+eya_memory_strided_at(const eya_memory_strided_t *self, eya_usize_t index)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(index < self->count, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+    return eya_ptr_cast(eya_uchar_t, self->base) + index * self->stride;
+}
+
+void
+eya_memory_strided_gather(const eya_memory_strided_t *self, eya_memory_range_t *dst)
+{
+    eya_uchar_t *out = eya_memory_strided_check_dense(self, dst);
+
+    eya_memory_strided_copy_elements(out,
+                                     self->element_size,
+                                     eya_ptr_cast(eya_uchar_t, self->base),
+                                     self->stride,
+                                     self->element_size,
+                                     self->count);
+}
+
+void
+eya_memory_strided_scatter(const eya_memory_strided_t *self, const eya_memory_range_t *src)
+{
+    const eya_uchar_t *in = eya_memory_strided_check_dense(self, src);
+
+    eya_memory_strided_copy_elements(eya_ptr_cast(eya_uchar_t, self->base),
+                                     self->stride,
+                                     in,
+                                     self->element_size,
+                                     self->element_size,
+                                     self->count);
+}
+
+void
+eya_memory_strided_copy(const eya_memory_strided_t *self, const eya_memory_strided_t *other)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(other);
+    eya_runtime_check(self->element_size == other->element_size && self->count == other->count,
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    eya_memory_strided_copy_elements(eya_ptr_cast(eya_uchar_t, self->base),
+                                     self->stride,
+                                     eya_ptr_cast(eya_uchar_t, other->base),
+                                     other->stride,
+                                     self->element_size,
+                                     self->count);
+}
\ No newline at end of file
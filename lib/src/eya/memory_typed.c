@@ -41,25 +41,55 @@ eya_memory_typed_get_element_size(const eya_memory_typed_t *self)
     return element_size;
 }
 
-bool
-eya_memory_typed_is_valid(const eya_memory_typed_t *self)
+void
+eya_memory_typed_update_divider(eya_memory_typed_t *self)
 {
     const eya_usize_t element_size = eya_memory_typed_get_element_size(self);
-    return eya_memory_range_is_multiple_of_size(eya_ptr_rcast(const eya_memory_range_t, self),
-                                                element_size);
+
+    if (element_size && self->element_divider.divisor != element_size)
+    {
+        eya_divider_init(&self->element_divider, element_size);
+    }
 }
 
-eya_usize_t
-eya_memory_typed_get_size(const eya_memory_typed_t *self)
+/**
+ * @brief Splits the byte size of a typed range into whole elements
+ * @param[in] self Pointer to typed memory range structure
+ * @param[out] count Number of whole elements
+ * @return true if the byte size is a multiple of the element size
+ *
+ * Uses the precomputed reciprocal when it matches the element size.
+ */
+static bool
+eya_memory_typed_divide(const eya_memory_typed_t *self, eya_usize_t *count)
 {
-    eya_runtime_check(eya_memory_typed_is_valid(self),
-                      EYA_RUNTIME_ERROR_SIZE_NOT_MULTIPLE_OF_ELEMENT_SIZE);
-
     const eya_usize_t size =
         eya_memory_range_get_size(eya_ptr_rcast(const eya_memory_range_t, self));
 
     const eya_usize_t element_size = eya_memory_typed_get_element_size(self);
-    return size / element_size;
+    eya_runtime_check(element_size, EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE);
+
+    *count = self->element_divider.divisor == element_size
+                 ? eya_divider_div(&self->element_divider, size)
+                 : size / element_size;
+
+    return *count * element_size == size;
+}
+
+bool
+eya_memory_typed_is_valid(const eya_memory_typed_t *self)
+{
+    eya_usize_t count;
+    return eya_memory_typed_divide(self, &count);
+}
+
+eya_usize_t
+eya_memory_typed_get_size(const eya_memory_typed_t *self)
+{
+    eya_usize_t count;
+    eya_runtime_check(eya_memory_typed_divide(self, &count),
+                      EYA_RUNTIME_ERROR_SIZE_NOT_MULTIPLE_OF_ELEMENT_SIZE);
+    return count;
 }
 
 bool
@@ -163,5 +193,6 @@ eya_memory_typed_make(void *begin, void *end, eya_usize_t element_size)
 {
     eya_memory_typed_t self = eya_memory_typed_empty_initializer(element_size);
     eya_memory_range_reset(eya_ptr_rcast(eya_memory_range_t, &self), begin, end);
+    eya_memory_typed_update_divider(&self);
     return self;
 }
\ No newline at end of file
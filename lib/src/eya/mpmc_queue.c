@@ -0,0 +1,305 @@
+#include <eya/mpmc_queue.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/checked_math.h>
+#include <eya/thread_futex.h>
+#include <eya/memory_std.h>
+#include <eya/math_util.h>
+#include <eya/addr_util.h>
+#include <eya/ptr_util.h>
+
+/**
+ * @brief Returns the sequence number of the cell of a free-running position
+ *
+ * The element is stored right after the sequence number.
+ */
+static eya_atomic_usize_t *
+eya_mpmc_queue_cell(const eya_mpmc_queue_t *self, eya_usize_t pos)
+{
+    eya_uchar_t *cells = eya_memory_range_get_begin(&self->cells);
+    return eya_ptr_cast(eya_atomic_usize_t, cells + (pos & self->mask) * self->cell_size);
+}
+
+/**
+ * @brief Returns the element storage of a cell
+ */
+static eya_uchar_t *
+eya_mpmc_queue_data(eya_atomic_usize_t *cell)
+{
+    return eya_ptr_cast(eya_uchar_t, cell) + sizeof(eya_usize_t);
+}
+
+/**
+ * @brief Claims consecutive positions whose cells are ready for the claiming side
+ *
+ * A cell is ready for the producer of position `pos` when its sequence number is `pos`,
+ * and for the consumer of `pos` when it is `pos + 1`.
+ *
+ * @param[in] self Pointer to the queue
+ * @param[in,out] counter Position counter of the claiming side
+ * @param[in] lag 0 for producers, 1 for consumers
+ * @param[in] count Largest number of positions to claim
+ * @param[out] first First claimed position
+ * @return Number of claimed positions, 0 if the next cell is not ready
+ */
+static eya_usize_t
+eya_mpmc_queue_claim(eya_mpmc_queue_t   *self,
+                     eya_atomic_usize_t *counter,
+                     eya_usize_t         lag,
+                     eya_usize_t         count,
+                     eya_usize_t        *first)
+{
+    const eya_usize_t limit = eya_math_min(count, self->mask + 1);
+    eya_usize_t       pos   = eya_atomic_load(counter, EYA_ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        const eya_usize_t seq =
+            eya_atomic_load(eya_mpmc_queue_cell(self, pos), EYA_ATOMIC_ACQUIRE);
+        const eya_ssize_t diff = (eya_ssize_t)(seq - (pos + lag));
+
+        if (diff < 0)
+            return 0; // full for producers, empty for consumers
+
+        if (diff > 0)
+        {
+            // Another thread claimed the position after it was read.
+            pos = eya_atomic_load(counter, EYA_ATOMIC_RELAXED);
+            continue;
+        }
+
+        eya_usize_t n = 1;
+        while (n < limit && eya_atomic_load(eya_mpmc_queue_cell(self, pos + n),
+                                            EYA_ATOMIC_ACQUIRE) == pos + n + lag)
+        {
+            ++n;
+        }
+
+        if (eya_atomic_compare_exchange(
+                counter, &pos, pos + n, EYA_ATOMIC_RELAXED, EYA_ATOMIC_RELAXED))
+        {
+            *first = pos;
+            return n;
+        }
+    }
+}
+
+/**
+ * @brief Wakes threads sleeping on a futex word if there are any
+ *
+ * The fence pairs with the one in the blocking operations:
+ * either the sleeper sees the change made before this call,
+ * or this call sees the sleeper and bumps the word it sleeps on.
+ */
+static void
+eya_mpmc_queue_notify(eya_atomic_uint_t *word, eya_atomic_uint_t *waiters, eya_usize_t count)
+{
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+    eya_runtime_return_ifn(eya_atomic_load(waiters, EYA_ATOMIC_RELAXED));
+
+    eya_atomic_fetch_add(word, 1, EYA_ATOMIC_RELEASE);
+    if (count == 1)
+        eya_thread_futex_wake_one(word);
+    else
+        eya_thread_futex_wake_all(word);
+}
+
+void
+eya_mpmc_queue_init(eya_mpmc_queue_t *self, eya_usize_t capacity, eya_usize_t element_size)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(eya_math_is_power_of_two(capacity), EYA_RUNTIME_ERROR_NOT_POWER_OF_TWO);
+    eya_runtime_check(capacity >= 2, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+    eya_runtime_check(element_size, EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE);
+    eya_runtime_check(element_size <= EYA_USIZE_T_MAX - 2 * sizeof(eya_usize_t),
+                      EYA_RUNTIME_ERROR_OVERFLOW);
+
+    const eya_usize_t cell_size =
+        eya_addr_align_up(sizeof(eya_usize_t) + element_size, sizeof(eya_usize_t));
+
+    eya_usize_t size;
+    eya_runtime_check_if(eya_checked_mul(capacity, cell_size, &size), EYA_RUNTIME_ERROR_OVERFLOW);
+
+    self->cells        = eya_allocated_range_make_aligned(size, EYA_ATOMIC_CACHE_LINE_SIZE);
+    self->mask         = capacity - 1;
+    self->cell_size    = cell_size;
+    self->element_size = element_size;
+    self->enqueue_pos  = 0;
+    self->dequeue_pos  = 0;
+    self->not_full     = 0;
+    self->not_empty    = 0;
+    self->push_waiters = 0;
+    self->pop_waiters  = 0;
+
+    for (eya_usize_t i = 0; i < capacity; ++i)
+    {
+        eya_atomic_store(eya_mpmc_queue_cell(self, i), i, EYA_ATOMIC_RELAXED);
+    }
+}
+
+void
+eya_mpmc_queue_destroy(eya_mpmc_queue_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_allocated_range_clear_aligned(&self->cells);
+}
+
+eya_usize_t
+eya_mpmc_queue_get_capacity(const eya_mpmc_queue_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->mask + 1;
+}
+
+eya_usize_t
+eya_mpmc_queue_get_size(const eya_mpmc_queue_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_usize_t head = eya_atomic_load(&self->dequeue_pos, EYA_ATOMIC_ACQUIRE);
+    const eya_usize_t tail = eya_atomic_load(&self->enqueue_pos, EYA_ATOMIC_ACQUIRE);
+    const eya_ssize_t size = (eya_ssize_t)(tail - head);
+
+    return size < 0 ? 0 : eya_math_min((eya_usize_t)size, self->mask + 1);
+}
+
+eya_usize_t
+eya_mpmc_queue_try_push_batch(eya_mpmc_queue_t *self, const void *elements, eya_usize_t count)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(elements || !count, EYA_RUNTIME_ERROR_NULL_POINTER);
+    eya_runtime_return_ifn(count, 0);
+
+    eya_usize_t       first = 0;
+    const eya_usize_t n     = eya_mpmc_queue_claim(self, &self->enqueue_pos, 0, count, &first);
+
+    for (eya_usize_t i = 0; i < n; ++i)
+    {
+        eya_atomic_usize_t *cell = eya_mpmc_queue_cell(self, first + i);
+
+        eya_memory_std_copy(eya_mpmc_queue_data(cell),
+                            eya_ptr_cast(const eya_uchar_t, elements) + i * self->element_size,
+                            self->element_size);
+        eya_atomic_store(cell, first + i + 1, EYA_ATOMIC_RELEASE);
+    }
+
+    if (n)
+        eya_mpmc_queue_notify(&self->not_empty, &self->pop_waiters, n);
+
+    return n;
+}
+
+eya_usize_t
+eya_mpmc_queue_try_pop_batch(eya_mpmc_queue_t *self, void *elements, eya_usize_t count)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(elements || !count, EYA_RUNTIME_ERROR_NULL_POINTER);
+    eya_runtime_return_ifn(count, 0);
+
+    eya_usize_t       first = 0;
+    const eya_usize_t n     = eya_mpmc_queue_claim(self, &self->dequeue_pos, 1, count, &first);
+
+    for (eya_usize_t i = 0; i < n; ++i)
+    {
+        eya_atomic_usize_t *cell = eya_mpmc_queue_cell(self, first + i);
+
+        eya_memory_std_copy(eya_ptr_cast(eya_uchar_t, elements) + i * self->element_size,
+                            eya_mpmc_queue_data(cell),
+                            self->element_size);
+        eya_atomic_store(cell, first + i + self->mask + 1, EYA_ATOMIC_RELEASE);
+    }
+
+    if (n)
+        eya_mpmc_queue_notify(&self->not_full, &self->push_waiters, n);
+
+    return n;
+}
+
+bool
+eya_mpmc_queue_try_push(eya_mpmc_queue_t *self, const void *element)
+{
+    eya_runtime_check_ref(element);
+    return eya_mpmc_queue_try_push_batch(self, element, 1) == 1;
+}
+
+bool
+eya_mpmc_queue_try_pop(eya_mpmc_queue_t *self, void *element)
+{
+    eya_runtime_check_ref(element);
+    return eya_mpmc_queue_try_pop_batch(self, element, 1) == 1;
+}
+
+void
+eya_mpmc_queue_push_batch(eya_mpmc_queue_t *self, const void *elements, eya_usize_t count)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_uchar_t *data = elements;
+
+    while (count)
+    {
+        eya_usize_t n = eya_mpmc_queue_try_push_batch(self, data, count);
+        if (!n)
+        {
+            // Announce the sleeper, then retry once: a consumer that frees a cell
+            // after the retry sees the announcement and bumps `not_full`.
+            const eya_uint_t seen = eya_atomic_load(&self->not_full, EYA_ATOMIC_ACQUIRE);
+
+            eya_atomic_fetch_add(&self->push_waiters, 1, EYA_ATOMIC_SEQ_CST);
+            eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+
+            n = eya_mpmc_queue_try_push_batch(self, data, count);
+            if (!n)
+                eya_thread_futex_wait(&self->not_full, seen);
+
+            eya_atomic_fetch_sub(&self->push_waiters, 1, EYA_ATOMIC_RELAXED);
+        }
+
+        data += n * self->element_size;
+        count -= n;
+    }
+}
+
+eya_usize_t
+eya_mpmc_queue_pop_batch(eya_mpmc_queue_t *self, void *elements, eya_usize_t count)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(count, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    for (;;)
+    {
+        eya_usize_t n = eya_mpmc_queue_try_pop_batch(self, elements, count);
+        if (n)
+            return n;
+
+        const eya_uint_t seen = eya_atomic_load(&self->not_empty, EYA_ATOMIC_ACQUIRE);
+
+        eya_atomic_fetch_add(&self->pop_waiters, 1, EYA_ATOMIC_SEQ_CST);
+        eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+
+        n = eya_mpmc_queue_try_pop_batch(self, elements, count);
+        if (!n)
+            eya_thread_futex_wait(&self->not_empty, seen);
+
+        eya_atomic_fetch_sub(&self->pop_waiters, 1, EYA_ATOMIC_RELAXED);
+
+        if (n)
+            return n;
+    }
+}
+
+void
+eya_mpmc_queue_push(eya_mpmc_queue_t *self, const void *element)
+{
+    eya_runtime_check_ref(element);
+    eya_mpmc_queue_push_batch(self, element, 1);
+}
+
+void
+eya_mpmc_queue_pop(eya_mpmc_queue_t *self, void *element)
+{
+    eya_runtime_check_ref(element);
+    eya_mpmc_queue_pop_batch(self, element, 1);
+}
\ No newline at end of file
@@ -86,11 +86,17 @@ eya_runtime_exception_catch_stack_push(eya_exception_catch_t *e)
     return nullptr;
 }
 
-eya_compiler_constructor(eya_runtime_exception_catch_stack_init)
+void
+eya_runtime_exception_catch_stack_reset(void)
 {
     m_runtime_exception = m_runtime_exceptions;
 }
 
+eya_compiler_constructor(eya_runtime_exception_catch_stack_init)
+{
+    eya_runtime_exception_catch_stack_reset();
+}
+
 eya_compiler_destructor(eya_runtime_exception_catch_stack_deinit)
 {
     m_runtime_exception = nullptr;
@@ -0,0 +1,169 @@
+#include <eya/shared_range.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_return_if.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_allocator.h>
+#include <eya/memory_std.h>
+#include <eya/addr_util.h>
+#include <eya/ptr_util.h>
+#include <eya/nullptr.h>
+#include <eya/atomic.h>
+
+/**
+ * @struct eya_shared_range_block
+ * @brief Header placed in front of the shared bytes
+ */
+struct eya_shared_range_block
+{
+    eya_atomic_usize_t     refs;      /**< Number of handles referencing the block */
+    eya_memory_allocator_t allocator; /**< Allocator that owns the block */
+};
+
+/**
+ * @brief Distance from the block header to the first byte
+ *
+ * Keeps the data aligned for any fundamental type.
+ */
+#define EYA_SHARED_RANGE_DATA_OFFSET                                                               \
+    eya_addr_align_up(sizeof(struct eya_shared_range_block), 2 * sizeof(void *))
+
+/**
+ * @brief Returns the first byte stored in a block
+ */
+static void *
+eya_shared_range_block_data(struct eya_shared_range_block *block)
+{
+    return eya_ptr_add_by_offset_unsafe(void, block, EYA_SHARED_RANGE_DATA_OFFSET);
+}
+
+/**
+ * @brief Returns the referenced block, throwing if the handle was released
+ */
+static struct eya_shared_range_block *
+eya_shared_range_get_block(const eya_shared_range_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(self->block);
+    return self->block;
+}
+
+eya_shared_range_t
+eya_shared_range_make(eya_usize_t size)
+{
+    eya_runtime_check(size, EYA_RUNTIME_ERROR_ZERO_MEMORY_ALLOCATE);
+    eya_runtime_check(size <= EYA_USIZE_T_MAX - EYA_SHARED_RANGE_DATA_OFFSET,
+                      EYA_RUNTIME_ERROR_OVERFLOW);
+
+    const eya_memory_allocator_t  *allocator = eya_runtime_allocator();
+    struct eya_shared_range_block *block =
+        eya_memory_allocator_alloc(allocator, EYA_SHARED_RANGE_DATA_OFFSET + size);
+
+    block->allocator = *allocator;
+    eya_atomic_store(&block->refs, 1, EYA_ATOMIC_RELAXED);
+
+    eya_shared_range_t result = {block, {nullptr, nullptr}};
+    eya_memory_range_reset_s(&result.range, eya_shared_range_block_data(block), size);
+    return result;
+}
+
+eya_shared_range_t
+eya_shared_range_make_copy(const eya_memory_range_t *source)
+{
+    eya_runtime_check(eya_memory_range_has_data(source), EYA_RUNTIME_ERROR_INVALID_MEMORY_RANGE);
+
+    const eya_usize_t  size   = eya_memory_range_get_size(source);
+    eya_shared_range_t result = eya_shared_range_make(size);
+
+    eya_memory_std_copy(
+        eya_memory_range_get_begin(&result.range), eya_memory_range_get_begin(source), size);
+    return result;
+}
+
+eya_shared_range_t
+eya_shared_range_share(const eya_shared_range_t *self)
+{
+    struct eya_shared_range_block *block = eya_shared_range_get_block(self);
+
+    // A new owner can only come from an existing one, so no ordering is needed.
+    eya_atomic_fetch_add(&block->refs, 1, EYA_ATOMIC_RELAXED);
+    return *self;
+}
+
+eya_shared_range_t
+eya_shared_range_slice(const eya_shared_range_t *self, eya_uoffset_t offset, eya_usize_t size)
+{
+    eya_shared_range_get_block(self);
+
+    const eya_usize_t view = eya_memory_range_get_size(&self->range);
+    eya_runtime_check(size && offset <= view && size <= view - offset,
+                      EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+    eya_shared_range_t result = eya_shared_range_share(self);
+    eya_uchar_t       *begin  = eya_memory_range_get_begin(&self->range);
+
+    eya_memory_range_reset_s(&result.range, begin + offset, size);
+    return result;
+}
+
+void
+eya_shared_range_release(eya_shared_range_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_return_ifn(self->block);
+
+    struct eya_shared_range_block *block = self->block;
+
+    self->block = nullptr;
+    eya_memory_range_clear(&self->range);
+
+    // The last owner must observe every write made through the others before freeing.
+    // It may run on another thread, so the block goes back to the allocator that made it.
+    if (eya_atomic_fetch_sub(&block->refs, 1, EYA_ATOMIC_ACQ_REL) == 1)
+    {
+        const eya_memory_allocator_t allocator = block->allocator;
+        eya_memory_allocator_free(&allocator, block);
+    }
+}
+
+const eya_memory_range_t *
+eya_shared_range_get_range(const eya_shared_range_t *self)
+{
+    eya_runtime_check_ref(self);
+    return &self->range;
+}
+
+eya_usize_t
+eya_shared_range_get_size(const eya_shared_range_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_return_ifn(self->block, 0);
+    return eya_memory_range_get_size(&self->range);
+}
+
+eya_usize_t
+eya_shared_range_get_use_count(const eya_shared_range_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_return_ifn(self->block, 0);
+    return eya_atomic_load(&self->block->refs, EYA_ATOMIC_ACQUIRE);
+}
+
+bool
+eya_shared_range_is_unique(const eya_shared_range_t *self)
+{
+    return eya_shared_range_get_use_count(self) == 1;
+}
+
+eya_memory_range_t *
+eya_shared_range_make_writable(eya_shared_range_t *self)
+{
+    eya_shared_range_get_block(self);
+    eya_runtime_return_if(eya_shared_range_is_unique(self), &self->range);
+
+    eya_shared_range_t copy = eya_shared_range_make_copy(&self->range);
+    eya_shared_range_release(self);
+
+    *self = copy;
+    return &self->range;
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <eya/spsc_queue.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/checked_math.h>
+#include <eya/memory_std.h>
+#include <eya/math_util.h>
+#include <eya/ptr_util.h>
+
+/**
+ * @brief Returns the first byte of the ring
+ */
+static eya_uchar_t *
+eya_spsc_queue_slots(const eya_spsc_queue_t *self)
+{
+    return eya_memory_range_get_begin(&self->buffer.range);
+}
+
+/**
+ * @brief Copies packed elements into the ring starting at a free-running index
+ *
+ * The copy is split in two when it crosses the end of the ring.
+ */
+static void
+eya_spsc_queue_write(eya_spsc_queue_t *self,
+                     eya_usize_t       index,
+                     const void       *elements,
+                     eya_usize_t       count)
+{
+    const eya_usize_t esize = self->buffer.element_size;
+    const eya_usize_t slot  = index & self->mask;
+    const eya_usize_t first = eya_math_min(count, self->mask + 1 - slot);
+    eya_uchar_t      *ring  = eya_spsc_queue_slots(self);
+
+    eya_memory_std_copy(ring + slot * esize, elements, first * esize);
+    if (first < count)
+    {
+        eya_memory_std_copy(ring,
+                            eya_ptr_cast(const eya_uchar_t, elements) + first * esize,
+                            (count - first) * esize);
+    }
+}
+
+/**
+ * @brief Copies elements out of the ring starting at a free-running index
+ */
+static void
+eya_spsc_queue_read(const eya_spsc_queue_t *self,
+                    eya_usize_t             index,
+                    void                   *elements,
+                    eya_usize_t             count)
+{
+    const eya_usize_t  esize = self->buffer.element_size;
+    const eya_usize_t  slot  = index & self->mask;
+    const eya_usize_t  first = eya_math_min(count, self->mask + 1 - slot);
+    const eya_uchar_t *ring  = eya_spsc_queue_slots(self);
+
+    eya_memory_std_copy(elements, ring + slot * esize, first * esize);
+    if (first < count)
+    {
+        eya_memory_std_copy(
+            eya_ptr_cast(eya_uchar_t, elements) + first * esize, ring, (count - first) * esize);
+    }
+}
+
+void
+eya_spsc_queue_init(eya_spsc_queue_t *self, eya_usize_t capacity, eya_usize_t element_size)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(eya_math_is_power_of_two(capacity), EYA_RUNTIME_ERROR_NOT_POWER_OF_TWO);
+    eya_runtime_check(element_size, EYA_RUNTIME_ERROR_ZERO_ELEMENT_SIZE);
+
+    eya_usize_t size;
+    eya_runtime_check_if(eya_checked_mul(capacity, element_size, &size),
+                         EYA_RUNTIME_ERROR_OVERFLOW);
+
+    self->buffer.range        = eya_allocated_range_make_aligned(size, EYA_ATOMIC_CACHE_LINE_SIZE);
+    self->buffer.element_size = element_size;
+    self->mask                = capacity - 1;
+    self->tail                = 0;
+    self->head_cache          = 0;
+    self->head                = 0;
+    self->tail_cache          = 0;
+}
+
+void
+eya_spsc_queue_destroy(eya_spsc_queue_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_allocated_range_clear_aligned(&self->buffer.range);
+}
+
+eya_usize_t
+eya_spsc_queue_get_capacity(const eya_spsc_queue_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->mask + 1;
+}
+
+eya_usize_t
+eya_spsc_queue_get_size(const eya_spsc_queue_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_usize_t head = eya_atomic_load(&self->head, EYA_ATOMIC_ACQUIRE);
+    const eya_usize_t tail = eya_atomic_load(&self->tail, EYA_ATOMIC_ACQUIRE);
+    return tail - head;
+}
+
+bool
+eya_spsc_queue_try_push(eya_spsc_queue_t *self, const void *element)
+{
+    eya_runtime_check_ref(element);
+    return eya_spsc_queue_push_bulk(self, element, 1) == 1;
+}
+
+bool
+eya_spsc_queue_try_pop(eya_spsc_queue_t *self, void *element)
+{
+    eya_runtime_check_ref(element);
+    return eya_spsc_queue_pop_bulk(self, element, 1) == 1;
+}
+
+eya_usize_t
+eya_spsc_queue_push_bulk(eya_spsc_queue_t *self, const void *elements, eya_usize_t count)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(elements || !count, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+    const eya_usize_t capacity = self->mask + 1;
+    const eya_usize_t tail     = eya_atomic_load(&self->tail, EYA_ATOMIC_RELAXED);
+
+    // The shared head is read only when the cached one leaves too little room.
+    eya_usize_t free = capacity - (tail - self->head_cache);
+    if (free < count)
+    {
+        self->head_cache = eya_atomic_load(&self->head, EYA_ATOMIC_ACQUIRE);
+        free             = capacity - (tail - self->head_cache);
+    }
+
+    const eya_usize_t n = eya_math_min(count, free);
+    if (n)
+    {
+        eya_spsc_queue_write(self, tail, elements, n);
+        eya_atomic_store(&self->tail, tail + n, EYA_ATOMIC_RELEASE);
+    }
+    return n;
+}
+
+eya_usize_t
+eya_spsc_queue_pop_bulk(eya_spsc_queue_t *self, void *elements, eya_usize_t count)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(elements || !count, EYA_RUNTIME_ERROR_NULL_POINTER);
+
+    const eya_usize_t head = eya_atomic_load(&self->head, EYA_ATOMIC_RELAXED);
+
+    // The shared tail is read only when the cached one shows too few elements.
+    eya_usize_t available = self->tail_cache - head;
+    if (available < count)
+    {
+        self->tail_cache = eya_atomic_load(&self->tail, EYA_ATOMIC_ACQUIRE);
+        available        = self->tail_cache - head;
+    }
+
+    const eya_usize_t n = eya_math_min(count, available);
+    if (n)
+    {
+        eya_spsc_queue_read(self, head, elements, n);
+        eya_atomic_store(&self->head, head + n, EYA_ATOMIC_RELEASE);
+    }
+    return n;
+}
\ No newline at end of file
@@ -0,0 +1,526 @@
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE // clock_gettime() under strict ISO C modes
+#endif
+
+#include <eya/task_graph.h>
+
+#include <eya/runtime_exception_catch_stack.h>
+#include <eya/runtime_allocator.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/runtime_check.h>
+#include <eya/checked_math.h>
+#include <eya/thread_lock.h>
+#include <eya/runtime_try.h>
+#include <eya/math_util.h>
+#include <eya/nullptr.h>
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <windows.h>
+#else
+#    include <time.h>
+#endif
+
+/**
+ * @brief Number of elements allocated by the first growth of a graph array
+ */
+#define EYA_TASK_GRAPH_INITIAL_CAPACITY 8
+
+/**
+ * @brief Node of a graph with its statistics
+ */
+typedef struct eya_task_graph_node
+{
+    eya_task_graph_node_fn *fn;      /**< Function called for every chunk */
+    void                   *context; /**< User pointer passed to `fn` */
+    bool                    serial;  /**< Chunks are processed in order, one at a time */
+    eya_atomic_usize_t      time;    /**< Nanoseconds spent in `fn` during the last run */
+    eya_atomic_usize_t      runs;    /**< Calls of `fn` during the last run */
+} eya_task_graph_node_t;
+
+/**
+ * @brief Dependency between two nodes
+ */
+typedef struct eya_task_graph_edge
+{
+    eya_usize_t dependency; /**< Node that finishes a chunk first */
+    eya_usize_t node;       /**< Node that waits for it */
+} eya_task_graph_edge_t;
+
+struct eya_task_graph
+{
+    eya_memory_allocator_t allocator;     /**< Source of all graph memory */
+    eya_task_graph_node_t *nodes;         /**< Nodes in the order they were added */
+    eya_usize_t            node_count;    /**< Number of nodes */
+    eya_usize_t            node_capacity; /**< Number of allocated nodes */
+    eya_task_graph_edge_t *edges;         /**< Dependencies in the order they were added */
+    eya_usize_t            edge_count;    /**< Number of dependencies */
+    eya_usize_t            edge_capacity; /**< Number of allocated dependencies */
+};
+
+/**
+ * @brief State of one run of a graph
+ *
+ * Every started chunk occupies a slot; an instance of a node
+ * is the node applied to the chunk of a slot, numbered `slot * node_count + node`.
+ * All arrays are allocated in one block and protected by the lock.
+ */
+typedef struct eya_task_graph_run
+{
+    eya_task_graph_t       *graph;       /**< Graph being run */
+    eya_thread_pool_group_t group;       /**< Spawned node instances */
+    eya_thread_lock_t       lock;        /**< Protects the fields below */
+    eya_atomic_usize_t      failed;      /**< Nonzero once a node has thrown */
+    eya_usize_t             chunk_count; /**< Number of chunks of the batch */
+    eya_usize_t             slot_count;  /**< Largest number of started chunks */
+    eya_usize_t             next_chunk;  /**< Next chunk to start */
+    eya_usize_t             ready_size;  /**< Number of instances waiting to be spawned */
+    eya_usize_t            *offsets;     /**< Start of the successors of every node */
+    eya_usize_t            *targets;     /**< Successors of all nodes */
+    eya_usize_t            *indegree;    /**< Number of dependencies of every node */
+    eya_usize_t            *serial_next; /**< Chunk a serial node processes next */
+    eya_usize_t            *counts;      /**< Unfinished dependencies of every instance */
+    eya_usize_t            *left;        /**< Unfinished instances of the chunk of every slot */
+    eya_usize_t            *chunk_of;    /**< Chunk occupying every slot */
+    eya_usize_t            *ready;       /**< Instances waiting to be spawned */
+} eya_task_graph_run_t;
+
+/**
+ * @brief Closure of a spawned node instance
+ */
+typedef struct eya_task_graph_job
+{
+    eya_task_graph_run_t *run;   /**< Run the instance belongs to */
+    eya_usize_t           node;  /**< Index of the node */
+    eya_usize_t           slot;  /**< Slot of the chunk */
+    eya_usize_t           chunk; /**< Index of the chunk */
+} eya_task_graph_job_t;
+
+/**
+ * @brief Returns a monotonic time in nanoseconds
+ */
+static eya_usize_t
+eya_task_graph_now(void)
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+
+    const eya_ullong_t ticks = (eya_ullong_t)counter.QuadPart;
+    const eya_ullong_t hz    = (eya_ullong_t)frequency.QuadPart;
+    return (eya_usize_t)(ticks / hz * 1000000000ull + ticks % hz * 1000000000ull / hz);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (eya_usize_t)ts.tv_sec * 1000000000u + (eya_usize_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Makes room for one more element of a graph array
+ */
+static void *
+eya_task_graph_grow(const eya_task_graph_t *self,
+                    void                   *data,
+                    eya_usize_t            *capacity,
+                    eya_usize_t             count,
+                    eya_usize_t             element_size)
+{
+    eya_runtime_return_if(count < *capacity, data);
+
+    eya_usize_t grown = EYA_TASK_GRAPH_INITIAL_CAPACITY;
+    eya_usize_t size;
+
+    eya_runtime_check_if(*capacity && eya_checked_shl(*capacity, 1, &grown),
+                         EYA_RUNTIME_ERROR_OVERFLOW);
+    eya_runtime_check_if(eya_checked_mul(grown, element_size, &size), EYA_RUNTIME_ERROR_OVERFLOW);
+
+    data      = eya_memory_allocator_realloc(
+        &self->allocator, data, *capacity * element_size, size);
+    *capacity = grown;
+    return data;
+}
+
+/**
+ * @brief Checks that an index names a node of a graph
+ */
+static void
+eya_task_graph_check_node(const eya_task_graph_t *self, eya_usize_t node)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(node < self->node_count, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+}
+
+/**
+ * @brief Queues an instance whose dependencies are done, the lock must be held
+ */
+static void
+eya_task_graph_release(eya_task_graph_run_t *run, eya_usize_t instance)
+{
+    if (--run->counts[instance] == 0)
+        run->ready[run->ready_size++] = instance;
+}
+
+/**
+ * @brief Starts a chunk in a free slot, the lock must be held
+ */
+static void
+eya_task_graph_start(eya_task_graph_run_t *run, eya_usize_t slot, eya_usize_t chunk)
+{
+    const eya_task_graph_t *graph = run->graph;
+    const eya_usize_t       base  = slot * graph->node_count;
+
+    run->chunk_of[slot] = chunk;
+    run->left[slot]     = graph->node_count;
+
+    for (eya_usize_t i = 0; i < graph->node_count; ++i)
+    {
+        // One extra count holds a serial node until its previous chunk is done.
+        const bool waits = graph->nodes[i].serial && run->serial_next[i] != chunk;
+
+        run->counts[base + i] = run->indegree[i] + waits + 1;
+        eya_task_graph_release(run, base + i);
+    }
+}
+
+/**
+ * @brief Updates the run after an instance has finished, the lock must be held
+ */
+static void
+eya_task_graph_finish(eya_task_graph_run_t *run, const eya_task_graph_job_t *job)
+{
+    const eya_task_graph_t *graph = run->graph;
+    const eya_usize_t       base  = job->slot * graph->node_count;
+
+    for (eya_usize_t i = run->offsets[job->node]; i < run->offsets[job->node + 1]; ++i)
+        eya_task_graph_release(run, base + run->targets[i]);
+
+    if (graph->nodes[job->node].serial)
+    {
+        run->serial_next[job->node] = job->chunk + 1;
+
+        // The next chunk may already wait in another slot.
+        for (eya_usize_t slot = 0; job->chunk + 1 < run->next_chunk && slot < run->slot_count;
+             ++slot)
+        {
+            if (run->chunk_of[slot] == job->chunk + 1)
+            {
+                eya_task_graph_release(run, slot * graph->node_count + job->node);
+                break;
+            }
+        }
+    }
+
+    if (--run->left[job->slot] == 0 && run->next_chunk < run->chunk_count &&
+        !eya_atomic_load(&run->failed, EYA_ATOMIC_RELAXED))
+        eya_task_graph_start(run, job->slot, run->next_chunk++);
+}
+
+static void
+eya_task_graph_execute(void *closure);
+
+/**
+ * @brief Spawns queued instances until none are left
+ *
+ * Spawning may run the instance in the calling thread,
+ * so the lock is only held to take an instance off the queue.
+ */
+static void
+eya_task_graph_dispatch(eya_task_graph_run_t *run)
+{
+    const eya_usize_t node_count = run->graph->node_count;
+
+    for (;;)
+    {
+        eya_task_graph_job_t job = {run, 0, 0, 0};
+
+        eya_thread_lock_lock(&run->lock);
+        const bool found = run->ready_size != 0;
+        if (found)
+        {
+            const eya_usize_t instance = run->ready[--run->ready_size];
+
+            job.node  = instance % node_count;
+            job.slot  = instance / node_count;
+            job.chunk = run->chunk_of[job.slot];
+        }
+        eya_thread_lock_unlock(&run->lock);
+
+        eya_runtime_return_ifn(found);
+        eya_thread_pool_spawn(&run->group, eya_task_graph_execute, &job, sizeof(job));
+    }
+}
+
+/**
+ * @brief Completes an instance and spawns the instances it made ready
+ */
+static void
+eya_task_graph_complete(eya_task_graph_run_t *run, const eya_task_graph_job_t *job)
+{
+    eya_thread_lock_lock(&run->lock);
+    eya_task_graph_finish(run, job);
+    eya_thread_lock_unlock(&run->lock);
+
+    eya_task_graph_dispatch(run);
+}
+
+/**
+ * @brief Task running one node instance
+ *
+ * An exception is rethrown only after the instance has been completed,
+ * so the group records it while the rest of the run drains.
+ */
+static void
+eya_task_graph_execute(void *closure)
+{
+    const eya_task_graph_job_t *job  = closure;
+    eya_task_graph_run_t       *run  = job->run;
+    eya_task_graph_node_t      *node = &run->graph->nodes[job->node];
+
+    eya_runtime_try(e)
+    {
+        if (!eya_atomic_load(&run->failed, EYA_ATOMIC_RELAXED))
+        {
+            const eya_usize_t start = eya_task_graph_now();
+
+            node->fn(node->context, job->chunk);
+
+            eya_atomic_fetch_add(&node->time, eya_task_graph_now() - start, EYA_ATOMIC_RELAXED);
+            eya_atomic_fetch_add(&node->runs, 1, EYA_ATOMIC_RELAXED);
+        }
+        eya_runtime_try_finalize();
+    }
+    eya_runtime_catch
+    {
+        eya_atomic_store(&run->failed, 1, EYA_ATOMIC_RELAXED);
+        eya_task_graph_complete(run, job);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+
+    eya_task_graph_complete(run, job);
+}
+
+/**
+ * @brief Builds the successor lists and checks that the graph has no cycle
+ *
+ * Uses the instance counts of the first slot and the ready queue as scratch space.
+ */
+static void
+eya_task_graph_prepare(eya_task_graph_run_t *run)
+{
+    const eya_task_graph_t *graph = run->graph;
+    const eya_usize_t       n     = graph->node_count;
+
+    for (eya_usize_t i = 0; i <= n; ++i)
+        run->offsets[i] = 0;
+    for (eya_usize_t i = 0; i < n; ++i)
+        run->indegree[i] = 0;
+
+    for (eya_usize_t i = 0; i < graph->edge_count; ++i)
+    {
+        run->offsets[graph->edges[i].dependency + 1]++;
+        run->indegree[graph->edges[i].node]++;
+    }
+    for (eya_usize_t i = 0; i < n; ++i)
+        run->offsets[i + 1] += run->offsets[i];
+
+    // Filled from the back, so the successors keep the order of the edges.
+    for (eya_usize_t i = 0; i < n; ++i)
+        run->counts[i] = run->offsets[i + 1];
+    for (eya_usize_t i = graph->edge_count; i-- > 0;)
+        run->targets[--run->counts[graph->edges[i].dependency]] = graph->edges[i].node;
+
+    eya_usize_t visited = 0;
+    eya_usize_t size    = 0;
+    for (eya_usize_t i = 0; i < n; ++i)
+    {
+        run->counts[i] = run->indegree[i];
+        if (!run->counts[i])
+            run->ready[size++] = i;
+    }
+
+    while (size)
+    {
+        const eya_usize_t node = run->ready[--size];
+
+        visited++;
+        for (eya_usize_t i = run->offsets[node]; i < run->offsets[node + 1]; ++i)
+        {
+            if (--run->counts[run->targets[i]] == 0)
+                run->ready[size++] = run->targets[i];
+        }
+    }
+
+    eya_runtime_check(visited == n, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+eya_task_graph_t *
+eya_task_graph_make(const eya_memory_allocator_t *allocator)
+{
+    const eya_memory_allocator_t source = allocator ? *allocator : *eya_runtime_allocator();
+    eya_task_graph_t *self = eya_memory_allocator_alloc(&source, sizeof(eya_task_graph_t));
+
+    self->allocator     = source;
+    self->nodes         = nullptr;
+    self->node_count    = 0;
+    self->node_capacity = 0;
+    self->edges         = nullptr;
+    self->edge_count    = 0;
+    self->edge_capacity = 0;
+
+    return self;
+}
+
+void
+eya_task_graph_free(eya_task_graph_t *self)
+{
+    eya_runtime_return_ifn(self);
+
+    const eya_memory_allocator_t allocator = self->allocator;
+
+    eya_memory_allocator_free(&allocator, self->nodes);
+    eya_memory_allocator_free(&allocator, self->edges);
+    eya_memory_allocator_free(&allocator, self);
+}
+
+eya_usize_t
+eya_task_graph_add(eya_task_graph_t *self, eya_task_graph_node_fn *fn, void *context)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(fn);
+
+    self->nodes = eya_task_graph_grow(self,
+                                      self->nodes,
+                                      &self->node_capacity,
+                                      self->node_count,
+                                      sizeof(eya_task_graph_node_t));
+
+    eya_task_graph_node_t *node = &self->nodes[self->node_count];
+
+    node->fn      = fn;
+    node->context = context;
+    node->serial  = false;
+    eya_atomic_store(&node->time, 0, EYA_ATOMIC_RELAXED);
+    eya_atomic_store(&node->runs, 0, EYA_ATOMIC_RELAXED);
+
+    return self->node_count++;
+}
+
+void
+eya_task_graph_depend(eya_task_graph_t *self, eya_usize_t node, eya_usize_t dependency)
+{
+    eya_task_graph_check_node(self, node);
+    eya_task_graph_check_node(self, dependency);
+    eya_runtime_check(node != dependency, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    self->edges = eya_task_graph_grow(self,
+                                      self->edges,
+                                      &self->edge_capacity,
+                                      self->edge_count,
+                                      sizeof(eya_task_graph_edge_t));
+
+    self->edges[self->edge_count].dependency = dependency;
+    self->edges[self->edge_count].node       = node;
+    self->edge_count++;
+}
+
+void
+eya_task_graph_set_serial(eya_task_graph_t *self, eya_usize_t node)
+{
+    eya_task_graph_check_node(self, node);
+    self->nodes[node].serial = true;
+}
+
+void
+eya_task_graph_run(eya_task_graph_t  *self,
+                   eya_thread_pool_t *pool,
+                   eya_usize_t        chunk_count,
+                   eya_usize_t        in_flight)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(pool);
+    eya_runtime_check(in_flight, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    const eya_usize_t n = self->node_count;
+
+    for (eya_usize_t i = 0; i < n; ++i)
+    {
+        eya_atomic_store(&self->nodes[i].time, 0, EYA_ATOMIC_RELAXED);
+        eya_atomic_store(&self->nodes[i].runs, 0, EYA_ATOMIC_RELAXED);
+    }
+
+    eya_runtime_return_if(!n);
+
+    const eya_usize_t slots = eya_math_max(eya_math_min(in_flight, chunk_count), 1);
+    eya_runtime_check(slots <= EYA_USIZE_T_MAX / sizeof(eya_usize_t) / 4 / n,
+                      EYA_RUNTIME_ERROR_OVERFLOW);
+
+    const eya_usize_t instances = slots * n;
+    const eya_usize_t total     = (n + 1) + self->edge_count + 2 * n + 2 * instances + 2 * slots;
+
+    eya_usize_t *block =
+        eya_memory_allocator_alloc(&self->allocator, total * sizeof(eya_usize_t));
+
+    eya_task_graph_run_t run;
+    run.graph       = self;
+    run.chunk_count = chunk_count;
+    run.slot_count  = slots;
+    run.next_chunk  = 0;
+    run.ready_size  = 0;
+    run.offsets     = block;
+    run.targets     = run.offsets + (n + 1);
+    run.indegree    = run.targets + self->edge_count;
+    run.serial_next = run.indegree + n;
+    run.counts      = run.serial_next + n;
+    run.ready       = run.counts + instances;
+    run.left        = run.ready + instances;
+    run.chunk_of    = run.left + slots;
+    eya_thread_lock_init(&run.lock);
+    eya_atomic_store(&run.failed, 0, EYA_ATOMIC_RELAXED);
+
+    eya_runtime_try(e)
+    {
+        // A graph with a cycle is rejected even for an empty batch.
+        eya_task_graph_prepare(&run);
+
+        for (eya_usize_t i = 0; i < n; ++i)
+            run.serial_next[i] = 0;
+
+        eya_thread_pool_group_init(&run.group, pool);
+
+        // Nothing runs until the first chunks are started, so the lock is not needed yet.
+        for (; run.next_chunk < slots && run.next_chunk < chunk_count; ++run.next_chunk)
+            eya_task_graph_start(&run, run.next_chunk, run.next_chunk);
+
+        eya_task_graph_dispatch(&run);
+        eya_thread_pool_sync(&run.group);
+
+        eya_runtime_try_finalize();
+    }
+    eya_runtime_catch
+    {
+        eya_memory_allocator_free(&self->allocator, block);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+
+    eya_memory_allocator_free(&self->allocator, block);
+}
+
+eya_usize_t
+eya_task_graph_get_node_time(const eya_task_graph_t *self, eya_usize_t node)
+{
+    eya_task_graph_check_node(self, node);
+    return eya_atomic_load(&self->nodes[node].time, EYA_ATOMIC_RELAXED);
+}
+
+eya_usize_t
+eya_task_graph_get_node_runs(const eya_task_graph_t *self, eya_usize_t node)
+{
+    eya_task_graph_check_node(self, node);
+    return eya_atomic_load(&self->nodes[node].runs, EYA_ATOMIC_RELAXED);
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE // pthread_setaffinity_np() under strict ISO C modes
+#endif
+
+#include <eya/thread.h>
+
+#include <eya/runtime_exception_catch_stack.h>
+#include <eya/runtime_throw_with_code.h>
+#include <eya/runtime_allocator.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/ptr_util.h>
+#include <eya/nullptr.h>
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <windows.h>
+#    include <process.h>
+#else
+#    include <sched.h>
+#    include <unistd.h>
+#endif
+
+/**
+ * @brief Prepares the runtime of the calling thread and runs the user function
+ * @param[in] self Thread object passed to the native entry point
+ */
+static void
+eya_thread_run(eya_thread_t *self)
+{
+    eya_runtime_exception_catch_stack_reset();
+    *eya_runtime_allocator() = self->allocator;
+    self->fn(self->arg);
+}
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+static unsigned __stdcall eya_thread_start(void *arg)
+{
+    eya_thread_run(eya_ptr_cast(eya_thread_t, arg));
+    return 0;
+}
+#else
+static void *
+eya_thread_start(void *arg)
+{
+    eya_thread_run(eya_ptr_cast(eya_thread_t, arg));
+    return nullptr;
+}
+#endif
+
+void
+eya_thread_create(eya_thread_t *self, eya_thread_fn *fn, void *arg)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(fn);
+
+    self->fn        = fn;
+    self->arg       = arg;
+    self->allocator = *eya_runtime_allocator();
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    self->handle = (void *)_beginthreadex(nullptr, 0, eya_thread_start, self, 0, nullptr);
+    eya_runtime_check(self->handle, EYA_RUNTIME_ERROR_THREAD_NOT_CREATED);
+#else
+    eya_runtime_check(pthread_create(&self->handle, nullptr, eya_thread_start, self) == 0,
+                      EYA_RUNTIME_ERROR_THREAD_NOT_CREATED);
+#endif
+}
+
+void
+eya_thread_join(eya_thread_t *self)
+{
+    eya_runtime_check_ref(self);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    eya_runtime_check(WaitForSingleObject(self->handle, INFINITE) == WAIT_OBJECT_0,
+                      EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+    CloseHandle(self->handle);
+#else
+    eya_runtime_check(pthread_join(self->handle, nullptr) == 0,
+                      EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+#endif
+}
+
+void
+eya_thread_yield(void)
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+eya_usize_t
+eya_thread_hardware_concurrency(void)
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const long count = (long)info.dwNumberOfProcessors;
+#else
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return count > 0 ? eya_type_cast(eya_usize_t, count) : 1;
+}
+
+void
+eya_thread_set_affinity(eya_usize_t cpu)
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    eya_runtime_check(cpu < sizeof(DWORD_PTR) * 8, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+    eya_runtime_check(SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu),
+                      EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+#elif (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    eya_runtime_check(cpu < CPU_SETSIZE, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    eya_runtime_check(pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0,
+                      EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+#else
+    (void)cpu;
+    eya_runtime_throw_with_code(EYA_RUNTIME_ERROR_NOT_SUPPORTED);
+#endif
+}
\ No newline at end of file
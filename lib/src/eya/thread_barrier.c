@@ -0,0 +1,55 @@
+#include <eya/thread_barrier.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/runtime_check.h>
+#include <eya/thread_futex.h>
+
+void
+eya_thread_barrier_init(eya_thread_barrier_t *self, eya_uint_t count)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(count, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    self->count = count;
+    eya_atomic_store(&self->left, count, EYA_ATOMIC_RELAXED);
+    eya_atomic_store(&self->generation, 0, EYA_ATOMIC_RELAXED);
+    eya_atomic_store(&self->sleepers, 0, EYA_ATOMIC_RELAXED);
+}
+
+bool
+eya_thread_barrier_wait(eya_thread_barrier_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_uint_t generation = eya_atomic_load(&self->generation, EYA_ATOMIC_ACQUIRE);
+
+    if (eya_atomic_fetch_sub(&self->left, 1, EYA_ATOMIC_ACQ_REL) == 1)
+    {
+        // Nobody touches the counter until the generation moves, so it is reset first.
+        eya_atomic_store(&self->left, self->count, EYA_ATOMIC_RELAXED);
+        eya_atomic_store(&self->generation, generation + 1, EYA_ATOMIC_RELEASE);
+
+        eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+        if (eya_atomic_load(&self->sleepers, EYA_ATOMIC_RELAXED))
+            eya_thread_futex_wake_all(&self->generation);
+
+        return true;
+    }
+
+    for (eya_uint_t spin = 0; spin < EYA_LIBRARY_OPTION_THREAD_WAIT_SPIN_COUNT; ++spin)
+    {
+        eya_runtime_return_if(
+            eya_atomic_load(&self->generation, EYA_ATOMIC_ACQUIRE) != generation, false);
+        eya_atomic_pause();
+    }
+
+    eya_atomic_fetch_add(&self->sleepers, 1, EYA_ATOMIC_SEQ_CST);
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+
+    while (eya_atomic_load(&self->generation, EYA_ATOMIC_ACQUIRE) == generation)
+        eya_thread_futex_wait(&self->generation, generation);
+
+    eya_atomic_fetch_sub(&self->sleepers, 1, EYA_ATOMIC_RELAXED);
+    return false;
+}
\ No newline at end of file
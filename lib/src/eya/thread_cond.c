@@ -0,0 +1,69 @@
+#include <eya/thread_cond.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/nullptr.h>
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <windows.h>
+#endif
+
+void
+eya_thread_cond_init(eya_thread_cond_t *self)
+{
+    eya_runtime_check_ref(self);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    InitializeConditionVariable((PCONDITION_VARIABLE)&self->handle);
+#else
+    eya_runtime_check(pthread_cond_init(&self->handle, nullptr) == 0,
+                      EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+#endif
+}
+
+void
+eya_thread_cond_destroy(eya_thread_cond_t *self)
+{
+    eya_runtime_check_ref(self);
+
+#if (EYA_COMPILER_OS_TYPE != EYA_COMPILER_OS_TYPE_WINDOWS)
+    pthread_cond_destroy(&self->handle);
+#endif
+}
+
+void
+eya_thread_cond_wait(eya_thread_cond_t *self, eya_thread_mutex_t *mutex)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(mutex);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    SleepConditionVariableSRW(
+        (PCONDITION_VARIABLE)&self->handle, (PSRWLOCK)&mutex->handle, INFINITE, 0);
+#else
+    pthread_cond_wait(&self->handle, &mutex->handle);
+#endif
+}
+
+void
+eya_thread_cond_signal(eya_thread_cond_t *self)
+{
+    eya_runtime_check_ref(self);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    WakeConditionVariable((PCONDITION_VARIABLE)&self->handle);
+#else
+    pthread_cond_signal(&self->handle);
+#endif
+}
+
+void
+eya_thread_cond_broadcast(eya_thread_cond_t *self)
+{
+    eya_runtime_check_ref(self);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    WakeAllConditionVariable((PCONDITION_VARIABLE)&self->handle);
+#else
+    pthread_cond_broadcast(&self->handle);
+#endif
+}
\ No newline at end of file
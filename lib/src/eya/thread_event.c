@@ -0,0 +1,76 @@
+#include <eya/thread_event.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/thread_futex.h>
+
+/**
+ * @brief Event state: not set, no thread sleeps on the word
+ */
+#define EYA_THREAD_EVENT_UNSET 0
+
+/**
+ * @brief Event state: set
+ */
+#define EYA_THREAD_EVENT_SET 1
+
+/**
+ * @brief Event state: not set, threads may sleep on the word
+ */
+#define EYA_THREAD_EVENT_WAITED 2
+
+void
+eya_thread_event_init(eya_thread_event_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_atomic_store(&self->state, EYA_THREAD_EVENT_UNSET, EYA_ATOMIC_RELAXED);
+}
+
+void
+eya_thread_event_set(eya_thread_event_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    if (eya_atomic_exchange(&self->state, EYA_THREAD_EVENT_SET, EYA_ATOMIC_RELEASE) ==
+        EYA_THREAD_EVENT_WAITED)
+    {
+        eya_thread_futex_wake_all(&self->state);
+    }
+}
+
+bool
+eya_thread_event_is_set(eya_thread_event_t *self)
+{
+    eya_runtime_check_ref(self);
+    return eya_atomic_load(&self->state, EYA_ATOMIC_ACQUIRE) == EYA_THREAD_EVENT_SET;
+}
+
+void
+eya_thread_event_wait(eya_thread_event_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    for (eya_uint_t spin = 0; spin < EYA_LIBRARY_OPTION_THREAD_WAIT_SPIN_COUNT; ++spin)
+    {
+        eya_runtime_return_if(eya_atomic_load(&self->state, EYA_ATOMIC_ACQUIRE) ==
+                              EYA_THREAD_EVENT_SET);
+        eya_atomic_pause();
+    }
+
+    eya_uint_t state = EYA_THREAD_EVENT_UNSET;
+    while (!eya_atomic_compare_exchange(&self->state,
+                                        &state,
+                                        EYA_THREAD_EVENT_WAITED,
+                                        EYA_ATOMIC_ACQUIRE,
+                                        EYA_ATOMIC_ACQUIRE))
+    {
+        eya_runtime_return_if(state == EYA_THREAD_EVENT_SET);
+
+        // Another waiter has marked the word already.
+        if (state == EYA_THREAD_EVENT_WAITED)
+            break;
+    }
+
+    while (eya_atomic_load(&self->state, EYA_ATOMIC_ACQUIRE) != EYA_THREAD_EVENT_SET)
+        eya_thread_futex_wait(&self->state, EYA_THREAD_EVENT_WAITED);
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE // syscall() under strict ISO C modes
+#endif
+
+#include <eya/thread_futex.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/nullptr.h>
+#include <eya/thread.h>
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <windows.h>
+#    pragma comment(lib, "Synchronization.lib")
+#elif (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+void
+eya_thread_futex_wait(eya_atomic_uint_t *word, eya_uint_t expected)
+{
+    eya_runtime_check_ref(word);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    WaitOnAddress((volatile VOID *)word, &expected, sizeof(expected), INFINITE);
+#elif (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    // EAGAIN (value changed) and EINTR are both plain returns for the caller.
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    if (eya_atomic_load(word, EYA_ATOMIC_ACQUIRE) == expected)
+        eya_thread_yield();
+#endif
+}
+
+void
+eya_thread_futex_wake_one(eya_atomic_uint_t *word)
+{
+    eya_runtime_check_ref(word);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    WakeByAddressSingle((PVOID)word);
+#elif (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+}
+
+void
+eya_thread_futex_wake_all(eya_atomic_uint_t *word)
+{
+    eya_runtime_check_ref(word);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    WakeByAddressAll((PVOID)word);
+#elif (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_LINUX)
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 0x7FFFFFFF, nullptr, nullptr, 0);
+#endif
+}
\ No newline at end of file
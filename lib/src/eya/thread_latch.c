@@ -0,0 +1,62 @@
+#include <eya/thread_latch.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/runtime_check.h>
+#include <eya/thread_futex.h>
+
+void
+eya_thread_latch_init(eya_thread_latch_t *self, eya_uint_t count)
+{
+    eya_runtime_check_ref(self);
+
+    eya_atomic_store(&self->count, count, EYA_ATOMIC_RELAXED);
+    eya_atomic_store(&self->sleepers, 0, EYA_ATOMIC_RELAXED);
+}
+
+void
+eya_thread_latch_count_down(eya_thread_latch_t *self, eya_uint_t n)
+{
+    eya_runtime_check_ref(self);
+
+    eya_uint_t count = eya_atomic_load(&self->count, EYA_ATOMIC_RELAXED);
+    do
+    {
+        eya_runtime_check(n <= count, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+    } while (!eya_atomic_compare_exchange_weak(
+        &self->count, &count, count - n, EYA_ATOMIC_RELEASE, EYA_ATOMIC_RELAXED));
+
+    eya_runtime_return_if(count != n || !n);
+
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+    if (eya_atomic_load(&self->sleepers, EYA_ATOMIC_RELAXED))
+        eya_thread_futex_wake_all(&self->count);
+}
+
+bool
+eya_thread_latch_try_wait(eya_thread_latch_t *self)
+{
+    eya_runtime_check_ref(self);
+    return eya_atomic_load(&self->count, EYA_ATOMIC_ACQUIRE) == 0;
+}
+
+void
+eya_thread_latch_wait(eya_thread_latch_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    for (eya_uint_t spin = 0; spin < EYA_LIBRARY_OPTION_THREAD_WAIT_SPIN_COUNT; ++spin)
+    {
+        eya_runtime_return_if(eya_atomic_load(&self->count, EYA_ATOMIC_ACQUIRE) == 0);
+        eya_atomic_pause();
+    }
+
+    eya_atomic_fetch_add(&self->sleepers, 1, EYA_ATOMIC_SEQ_CST);
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+
+    // Every count down changes the word, so a sleeper may wake early and sleep again.
+    for (eya_uint_t count; (count = eya_atomic_load(&self->count, EYA_ATOMIC_ACQUIRE)) != 0;)
+        eya_thread_futex_wait(&self->count, count);
+
+    eya_atomic_fetch_sub(&self->sleepers, 1, EYA_ATOMIC_RELAXED);
+}
\ No newline at end of file
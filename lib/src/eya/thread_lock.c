@@ -0,0 +1,78 @@
+#include <eya/thread_lock.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/thread_futex.h>
+
+/**
+ * @brief Lock state: nobody holds the lock
+ */
+#define EYA_THREAD_LOCK_FREE 0
+
+/**
+ * @brief Lock state: held, no thread sleeps on the word
+ */
+#define EYA_THREAD_LOCK_HELD 1
+
+/**
+ * @brief Lock state: held, threads may sleep on the word
+ */
+#define EYA_THREAD_LOCK_CONTENDED 2
+
+void
+eya_thread_lock_init(eya_thread_lock_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_atomic_store(&self->state, EYA_THREAD_LOCK_FREE, EYA_ATOMIC_RELAXED);
+}
+
+bool
+eya_thread_lock_try_lock(eya_thread_lock_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    eya_uint_t expected = EYA_THREAD_LOCK_FREE;
+    return eya_atomic_compare_exchange(&self->state,
+                                       &expected,
+                                       EYA_THREAD_LOCK_HELD,
+                                       EYA_ATOMIC_ACQUIRE,
+                                       EYA_ATOMIC_RELAXED);
+}
+
+void
+eya_thread_lock_lock(eya_thread_lock_t *self)
+{
+    eya_runtime_return_if(eya_thread_lock_try_lock(self));
+
+    // Spinning only reads the word, so the holder's line is not stolen on every iteration.
+    for (eya_uint_t spin = 0; spin < EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT; ++spin)
+    {
+        eya_atomic_pause();
+
+        if (eya_atomic_load(&self->state, EYA_ATOMIC_RELAXED) == EYA_THREAD_LOCK_FREE &&
+            eya_thread_lock_try_lock(self))
+        {
+            return;
+        }
+    }
+
+    // From here on the lock is taken as contended, since other sleepers may
+    // still be waiting after this thread gets it.
+    while (eya_atomic_exchange(&self->state, EYA_THREAD_LOCK_CONTENDED, EYA_ATOMIC_ACQUIRE) !=
+           EYA_THREAD_LOCK_FREE)
+    {
+        eya_thread_futex_wait(&self->state, EYA_THREAD_LOCK_CONTENDED);
+    }
+}
+
+void
+eya_thread_lock_unlock(eya_thread_lock_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    if (eya_atomic_exchange(&self->state, EYA_THREAD_LOCK_FREE, EYA_ATOMIC_RELEASE) ==
+        EYA_THREAD_LOCK_CONTENDED)
+    {
+        eya_thread_futex_wake_one(&self->state);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <eya/thread_mutex.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/nullptr.h>
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <windows.h>
+#endif
+
+void
+eya_thread_mutex_init(eya_thread_mutex_t *self)
+{
+    eya_runtime_check_ref(self);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    InitializeSRWLock((PSRWLOCK)&self->handle);
+#else
+    eya_runtime_check(pthread_mutex_init(&self->handle, nullptr) == 0,
+                      EYA_RUNTIME_ERROR_SYSTEM_CALL_FAILED);
+#endif
+}
+
+void
+eya_thread_mutex_destroy(eya_thread_mutex_t *self)
+{
+    eya_runtime_check_ref(self);
+
+#if (EYA_COMPILER_OS_TYPE != EYA_COMPILER_OS_TYPE_WINDOWS)
+    pthread_mutex_destroy(&self->handle);
+#endif
+}
+
+void
+eya_thread_mutex_lock(eya_thread_mutex_t *self)
+{
+    eya_runtime_check_ref(self);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    AcquireSRWLockExclusive((PSRWLOCK)&self->handle);
+#else
+    pthread_mutex_lock(&self->handle);
+#endif
+}
+
+void
+eya_thread_mutex_unlock(eya_thread_mutex_t *self)
+{
+    eya_runtime_check_ref(self);
+
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    ReleaseSRWLockExclusive((PSRWLOCK)&self->handle);
+#else
+    pthread_mutex_unlock(&self->handle);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,1039 @@
+#include <eya/thread_pool.h>
+
+#include <eya/runtime_exception_catch_stack.h>
+#include <eya/runtime_allocator.h>
+#include <eya/thread_topology.h>
+#include <eya/thread_barrier.h>
+#include <eya/thread_latch.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/static_assert.h>
+#include <eya/thread_mutex.h>
+#include <eya/thread_cond.h>
+#include <eya/runtime_try.h>
+#include <eya/memory_std.h>
+#include <eya/exception.h>
+#include <eya/math_util.h>
+#include <eya/ptr_util.h>
+#include <eya/nullptr.h>
+#include <eya/memory.h>
+#include <eya/thread.h>
+
+#if (EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY < 2) ||                                         \
+    (EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY &                                               \
+     (EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY - 1))
+#    error "EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY must be a power of two"
+#endif
+
+eya_static_assert(sizeof(eya_exception_t) <= EYA_THREAD_POOL_CLOSURE_SIZE,
+                  "The record of a failed task must be able to hold its exception.");
+
+/**
+ * @brief Number of failed attempts to find work before an idle worker goes to sleep
+ */
+#define EYA_THREAD_POOL_SPIN_COUNT 64
+
+/**
+ * @brief Storage of a task closure, aligned for any fundamental type
+ */
+typedef union eya_thread_pool_closure
+{
+    eya_uchar_t     bytes[EYA_THREAD_POOL_CLOSURE_SIZE]; /**< Copied closure */
+    void           *ptr;                                 /**< Alignment of pointers */
+    eya_ullong_t    ull;                                 /**< Alignment of 64-bit integers */
+    long double     ld;                                  /**< Alignment of floating point values */
+    eya_exception_t exception;                           /**< Exception of a failed task */
+} eya_thread_pool_closure_t;
+
+/**
+ * @brief Spawned task record
+ */
+typedef struct eya_thread_pool_task
+{
+    eya_thread_pool_task_fn     *fn;      /**< Task function */
+    eya_thread_pool_group_t     *group;   /**< Group the task belongs to */
+    struct eya_thread_pool_task *next;    /**< Link in the injection queue or the record cache */
+    eya_thread_pool_closure_t    closure; /**< Copy of the closure passed to the function */
+} eya_thread_pool_task_t;
+
+/**
+ * @brief Chase–Lev deque of a worker with a fixed number of slots
+ *
+ * The owner pushes and pops at `bottom`, thieves take from `top`.
+ * Both indices grow without wrapping; slots are addressed modulo the capacity.
+ */
+typedef struct eya_thread_pool_deque
+{
+    eya_atomic_ssize_t top;                                                 /**< Next to steal */
+    eya_uchar_t        top_pad[EYA_ATOMIC_CACHE_LINE_SIZE - sizeof(eya_ssize_t)];
+    eya_atomic_ssize_t bottom;                                              /**< Next to push */
+    eya_uchar_t        bottom_pad[EYA_ATOMIC_CACHE_LINE_SIZE - sizeof(eya_ssize_t)];
+    eya_atomic_ptr_t   slots[EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY]; /**< Task records */
+} eya_thread_pool_deque_t;
+
+/**
+ * @brief State of one worker thread
+ *
+ * Allocated on its own cache line, so neighbouring workers do not share lines.
+ * The worker allocates and clears it itself, after it has been pinned,
+ * so first-touch placement puts its pages on the node of its CPU.
+ */
+typedef struct eya_thread_pool_worker
+{
+    eya_thread_pool_deque_t deque;      /**< Tasks spawned by this worker */
+    eya_thread_pool_t      *pool;       /**< Owning pool */
+    eya_usize_t             index;      /**< Index in the pool */
+    eya_ullong_t            seed;       /**< State of the victim selection generator */
+    eya_thread_pool_task_t *cache;      /**< Finished records kept for reuse */
+    eya_usize_t             cache_size; /**< Number of records in the cache */
+} eya_thread_pool_worker_t;
+
+/**
+ * @brief Thread of a worker and where it runs, owned by the creating thread
+ */
+typedef struct eya_thread_pool_seat
+{
+    eya_thread_t       thread; /**< Worker thread */
+    eya_thread_pool_t *pool;   /**< Owning pool */
+    eya_usize_t        index;  /**< Index of the worker */
+    eya_usize_t        cpu;    /**< CPU the worker is bound to, or `EYA_USIZE_T_MAX` */
+} eya_thread_pool_seat_t;
+
+struct eya_thread_pool
+{
+    eya_memory_allocator_t     allocator;    /**< Allocator of the pool and the workers */
+    eya_thread_pool_worker_t **workers;      /**< Worker states */
+    eya_thread_pool_seat_t    *seats;        /**< Worker threads */
+    eya_usize_t                worker_count; /**< Number of workers */
+    eya_usize_t                started;      /**< Number of running worker threads */
+    eya_thread_latch_t         arrived;      /**< Opens when every worker has its state */
+    eya_atomic_usize_t         failed;       /**< Nonzero if a worker state was not allocated */
+    eya_thread_mutex_t         mutex;        /**< Protects the injection queue and sleeping */
+    eya_thread_cond_t          wake;         /**< Signaled when work is spawned for sleepers */
+    eya_thread_cond_t          done;         /**< Signaled when a group becomes empty */
+    eya_thread_pool_task_t    *inject_head;  /**< Oldest task spawned from outside */
+    eya_thread_pool_task_t    *inject_tail;  /**< Newest task spawned from outside */
+    eya_atomic_usize_t         injected;     /**< Number of tasks in the injection queue */
+    eya_atomic_usize_t         sleepers;     /**< Number of workers waiting on `wake` */
+    eya_atomic_usize_t         waiters;      /**< Number of threads waiting on `done` */
+    eya_atomic_usize_t         stop;         /**< Nonzero when the workers must exit */
+    eya_atomic_usize_t         team;         /**< Nonzero while a phase team runs */
+    bool                       ready;        /**< The mutex and conditions are initialized */
+};
+
+/**
+ * @var m_thread_pool_worker
+ * @brief Worker state of the calling thread, nullptr outside of pool workers
+ */
+EYA_ATTRIBUTE(THREAD_LOCAL)
+eya_thread_pool_worker_t *m_thread_pool_worker;
+
+// --------------------------------------------------------------------------------------------- //
+//                                             DEQUE                                             //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief Pushes a task at the bottom of the owner's deque
+ * @return false if the deque is full
+ */
+static bool
+eya_thread_pool_deque_push(eya_thread_pool_deque_t *self, eya_thread_pool_task_t *task)
+{
+    const eya_ssize_t b = eya_atomic_load(&self->bottom, EYA_ATOMIC_RELAXED);
+    const eya_ssize_t t = eya_atomic_load(&self->top, EYA_ATOMIC_ACQUIRE);
+
+    if (b - t >= EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY)
+        return false;
+
+    eya_atomic_store(&self->slots[b & (EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY - 1)],
+                     task,
+                     EYA_ATOMIC_RELAXED);
+    eya_atomic_store(&self->bottom, b + 1, EYA_ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Pops the newest task from the bottom of the owner's deque
+ * @return Task or nullptr if the deque is empty or the last task was stolen
+ */
+static eya_thread_pool_task_t *
+eya_thread_pool_deque_pop(eya_thread_pool_deque_t *self)
+{
+    const eya_ssize_t b = eya_atomic_load(&self->bottom, EYA_ATOMIC_RELAXED) - 1;
+
+    eya_atomic_store(&self->bottom, b, EYA_ATOMIC_RELAXED);
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+
+    eya_ssize_t t = eya_atomic_load(&self->top, EYA_ATOMIC_RELAXED);
+    if (t > b)
+    {
+        eya_atomic_store(&self->bottom, b + 1, EYA_ATOMIC_RELAXED);
+        return nullptr;
+    }
+
+    eya_thread_pool_task_t *task = eya_atomic_load(
+        &self->slots[b & (EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY - 1)], EYA_ATOMIC_RELAXED);
+
+    if (t == b)
+    {
+        // The last task: race the thieves for it through `top`.
+        if (!eya_atomic_compare_exchange(
+                &self->top, &t, t + 1, EYA_ATOMIC_SEQ_CST, EYA_ATOMIC_RELAXED))
+            task = nullptr;
+
+        eya_atomic_store(&self->bottom, b + 1, EYA_ATOMIC_RELAXED);
+    }
+    return task;
+}
+
+/**
+ * @brief Steals the oldest task from the top of another worker's deque
+ * @return Task or nullptr if the deque is empty or another thief won
+ */
+static eya_thread_pool_task_t *
+eya_thread_pool_deque_steal(eya_thread_pool_deque_t *self)
+{
+    eya_ssize_t t = eya_atomic_load(&self->top, EYA_ATOMIC_ACQUIRE);
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+    const eya_ssize_t b = eya_atomic_load(&self->bottom, EYA_ATOMIC_ACQUIRE);
+
+    if (t >= b)
+        return nullptr;
+
+    eya_thread_pool_task_t *task = eya_atomic_load(
+        &self->slots[t & (EYA_LIBRARY_OPTION_THREAD_POOL_DEQUE_CAPACITY - 1)], EYA_ATOMIC_RELAXED);
+
+    if (!eya_atomic_compare_exchange(&self->top, &t, t + 1, EYA_ATOMIC_SEQ_CST, EYA_ATOMIC_RELAXED))
+        return nullptr;
+
+    return task;
+}
+
+/**
+ * @brief Tells whether a deque seems to hold tasks
+ */
+static bool
+eya_thread_pool_deque_has_tasks(const eya_thread_pool_deque_t *self)
+{
+    return eya_atomic_load(&self->bottom, EYA_ATOMIC_RELAXED) >
+           eya_atomic_load(&self->top, EYA_ATOMIC_RELAXED);
+}
+
+// --------------------------------------------------------------------------------------------- //
+//                                           SCHEDULING                                          //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief Returns the worker state of the calling thread if it belongs to the pool
+ */
+static eya_thread_pool_worker_t *
+eya_thread_pool_current(const eya_thread_pool_t *pool)
+{
+    eya_thread_pool_worker_t *worker = m_thread_pool_worker;
+    return worker && worker->pool == pool ? worker : nullptr;
+}
+
+/**
+ * @brief Takes a task record from the worker's cache or allocates a new one
+ */
+static eya_thread_pool_task_t *
+eya_thread_pool_task_alloc(eya_thread_pool_t *pool, eya_thread_pool_worker_t *worker)
+{
+    if (worker && worker->cache)
+    {
+        eya_thread_pool_task_t *task = worker->cache;
+        worker->cache                = task->next;
+        worker->cache_size--;
+        return task;
+    }
+    return eya_memory_allocator_alloc(&pool->allocator, sizeof(eya_thread_pool_task_t));
+}
+
+/**
+ * @brief Returns a task record to the worker's cache or releases it
+ */
+static void
+eya_thread_pool_task_free(eya_thread_pool_t        *pool,
+                          eya_thread_pool_worker_t *worker,
+                          eya_thread_pool_task_t   *task)
+{
+    if (worker && worker->cache_size < EYA_LIBRARY_OPTION_THREAD_POOL_TASK_CACHE)
+    {
+        task->next    = worker->cache;
+        worker->cache = task;
+        worker->cache_size++;
+        return;
+    }
+    eya_memory_allocator_free(&pool->allocator, task);
+}
+
+/**
+ * @brief Wakes one sleeping worker if there is any
+ *
+ * The fence pairs with the one in `eya_thread_pool_sleep()`:
+ * either the sleeper sees the new task, or this thread sees the sleeper.
+ */
+static void
+eya_thread_pool_notify(eya_thread_pool_t *pool)
+{
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+    eya_runtime_return_ifn(eya_atomic_load(&pool->sleepers, EYA_ATOMIC_RELAXED));
+
+    eya_thread_mutex_lock(&pool->mutex);
+    eya_thread_cond_signal(&pool->wake);
+    eya_thread_mutex_unlock(&pool->mutex);
+}
+
+/**
+ * @brief Tells whether any deque or the injection queue seems to hold tasks
+ */
+static bool
+eya_thread_pool_has_tasks(const eya_thread_pool_t *pool)
+{
+    if (eya_atomic_load(&pool->injected, EYA_ATOMIC_RELAXED))
+        return true;
+
+    for (eya_usize_t i = 0; i < pool->worker_count; ++i)
+    {
+        if (eya_thread_pool_deque_has_tasks(&pool->workers[i]->deque))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Takes the oldest task spawned from outside the pool
+ */
+static eya_thread_pool_task_t *
+eya_thread_pool_take_injected(eya_thread_pool_t *pool)
+{
+    if (!eya_atomic_load(&pool->injected, EYA_ATOMIC_ACQUIRE))
+        return nullptr;
+
+    eya_thread_mutex_lock(&pool->mutex);
+    eya_thread_pool_task_t *task = pool->inject_head;
+    if (task)
+    {
+        pool->inject_head = task->next;
+        if (!pool->inject_head)
+            pool->inject_tail = nullptr;
+
+        eya_atomic_fetch_sub(&pool->injected, 1, EYA_ATOMIC_RELAXED);
+    }
+    eya_thread_mutex_unlock(&pool->mutex);
+    return task;
+}
+
+/**
+ * @brief Steals a task from the workers, starting at a random victim
+ */
+static eya_thread_pool_task_t *
+eya_thread_pool_steal(eya_thread_pool_t *pool, eya_thread_pool_worker_t *thief)
+{
+    // xorshift64: cheap and good enough to spread the victims.
+    thief->seed ^= thief->seed << 13;
+    thief->seed ^= thief->seed >> 7;
+    thief->seed ^= thief->seed << 17;
+
+    const eya_usize_t start = (eya_usize_t)(thief->seed % pool->worker_count);
+
+    for (eya_usize_t i = 0; i < pool->worker_count; ++i)
+    {
+        eya_thread_pool_worker_t *victim = pool->workers[(start + i) % pool->worker_count];
+        if (victim == thief)
+            continue;
+
+        eya_thread_pool_task_t *task = eya_thread_pool_deque_steal(&victim->deque);
+        if (task)
+            return task;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Finds a task for the calling thread
+ * @param[in] pool Pool to search
+ * @param[in] worker Worker state of the calling thread
+ */
+static eya_thread_pool_task_t *
+eya_thread_pool_find(eya_thread_pool_t *pool, eya_thread_pool_worker_t *worker)
+{
+    eya_thread_pool_task_t *task = eya_thread_pool_deque_pop(&worker->deque);
+
+    if (!task)
+        task = eya_thread_pool_take_injected(pool);
+
+    if (!task)
+        task = eya_thread_pool_steal(pool, worker);
+
+    return task;
+}
+
+/**
+ * @brief Runs a task, records its exception and completes it in its group
+ *
+ * The record of the first task of a group to throw is not released:
+ * the exception is moved into its closure and the group points to it
+ * until `eya_thread_pool_sync()` rethrows it.
+ * The group is not accessed after its pending count is decremented,
+ * since the thread waiting in `eya_thread_pool_sync()` may release it right away.
+ */
+static void
+eya_thread_pool_run(eya_thread_pool_t        *pool,
+                    eya_thread_pool_worker_t *worker,
+                    eya_thread_pool_task_t   *task)
+{
+    eya_thread_pool_group_t *group = task->group;
+
+    eya_runtime_try(e)
+    {
+        task->fn(&task->closure);
+        eya_runtime_try_finalize();
+    }
+    eya_runtime_catch
+    {
+        eya_usize_t expected = 0;
+        if (eya_atomic_compare_exchange(
+                &group->failed, &expected, 1, EYA_ATOMIC_ACQ_REL, EYA_ATOMIC_RELAXED))
+        {
+            task->closure.exception = e.exception;
+            group->failure          = task;
+            task                    = nullptr;
+        }
+    }
+
+    if (task)
+        eya_thread_pool_task_free(pool, worker, task);
+
+    if (eya_atomic_fetch_sub(&group->pending, 1, EYA_ATOMIC_ACQ_REL) == 1)
+    {
+        eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+        if (eya_atomic_load(&pool->waiters, EYA_ATOMIC_RELAXED))
+        {
+            eya_thread_mutex_lock(&pool->mutex);
+            eya_thread_cond_broadcast(&pool->done);
+            eya_thread_mutex_unlock(&pool->mutex);
+        }
+    }
+}
+
+/**
+ * @brief Puts an idle worker to sleep until work is spawned or the pool stops
+ */
+static void
+eya_thread_pool_sleep(eya_thread_pool_t *pool)
+{
+    eya_thread_mutex_lock(&pool->mutex);
+    eya_atomic_fetch_add(&pool->sleepers, 1, EYA_ATOMIC_SEQ_CST);
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+
+    if (!eya_atomic_load(&pool->stop, EYA_ATOMIC_RELAXED) && !eya_thread_pool_has_tasks(pool))
+        eya_thread_cond_wait(&pool->wake, &pool->mutex);
+
+    eya_atomic_fetch_sub(&pool->sleepers, 1, EYA_ATOMIC_RELAXED);
+    eya_thread_mutex_unlock(&pool->mutex);
+}
+
+/**
+ * @brief Blocks a thread outside the pool until a group may have become empty
+ */
+static void
+eya_thread_pool_wait_done(eya_thread_pool_t *pool, eya_thread_pool_group_t *group)
+{
+    eya_thread_mutex_lock(&pool->mutex);
+    eya_atomic_fetch_add(&pool->waiters, 1, EYA_ATOMIC_SEQ_CST);
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+
+    if (eya_atomic_load(&group->pending, EYA_ATOMIC_RELAXED))
+        eya_thread_cond_wait(&pool->done, &pool->mutex);
+
+    eya_atomic_fetch_sub(&pool->waiters, 1, EYA_ATOMIC_RELAXED);
+    eya_thread_mutex_unlock(&pool->mutex);
+}
+
+/**
+ * @brief Pins a worker thread if requested and allocates its state
+ * @param[in,out] seat Seat of the worker
+ * @return Worker state, or nullptr if it could not be allocated
+ *
+ * A failed binding is not an error: the CPU may be outside the set allowed
+ * to the process, and the worker then runs wherever the system puts it.
+ */
+static eya_thread_pool_worker_t *
+eya_thread_pool_worker_make(eya_thread_pool_seat_t *seat)
+{
+    eya_thread_pool_t *pool = seat->pool;
+
+    if (seat->cpu != EYA_USIZE_T_MAX)
+    {
+        eya_runtime_try(e)
+        {
+            eya_thread_set_affinity(seat->cpu);
+            eya_runtime_try_finalize();
+        }
+        eya_runtime_catch
+        {
+            seat->cpu = EYA_USIZE_T_MAX;
+        }
+    }
+
+    eya_runtime_try(e)
+    {
+        eya_thread_pool_worker_t *worker = eya_memory_allocator_alloc_aligned(
+            &pool->allocator, sizeof(eya_thread_pool_worker_t), EYA_ATOMIC_CACHE_LINE_SIZE);
+
+        eya_memory_set(worker, sizeof(eya_thread_pool_worker_t), 0);
+        worker->pool  = pool;
+        worker->index = seat->index;
+        worker->seed  = 0x9E3779B97F4A7C15ULL * (seat->index + 1);
+
+        eya_runtime_try_return(worker);
+    }
+    eya_runtime_catch
+    {
+        eya_atomic_store(&pool->failed, 1, EYA_ATOMIC_RELAXED);
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Entry point of a worker thread
+ * @param[in] arg Pointer to the seat of the worker
+ */
+static void
+eya_thread_pool_worker_main(void *arg)
+{
+    eya_thread_pool_seat_t *seat = eya_ptr_cast(eya_thread_pool_seat_t, arg);
+    eya_thread_pool_t      *pool = seat->pool;
+    eya_usize_t             idle = 0;
+
+    *eya_runtime_allocator() = pool->allocator;
+
+    eya_thread_pool_worker_t *worker = eya_thread_pool_worker_make(seat);
+    pool->workers[seat->index]       = worker;
+
+    // Thieves pick any worker, so none may start before all states exist.
+    eya_thread_latch_count_down(&pool->arrived, 1);
+    eya_thread_latch_wait(&pool->arrived);
+    eya_runtime_return_if(eya_atomic_load(&pool->failed, EYA_ATOMIC_RELAXED));
+
+    m_thread_pool_worker = worker;
+
+    while (!eya_atomic_load(&pool->stop, EYA_ATOMIC_ACQUIRE))
+    {
+        eya_thread_pool_task_t *task = eya_thread_pool_find(pool, worker);
+        if (task)
+        {
+            eya_thread_pool_run(pool, worker, task);
+            idle = 0;
+        }
+        else if (++idle < EYA_THREAD_POOL_SPIN_COUNT)
+        {
+            eya_thread_yield();
+        }
+        else
+        {
+            eya_thread_pool_sleep(pool);
+            idle = 0;
+        }
+    }
+
+    m_thread_pool_worker = nullptr;
+}
+
+// --------------------------------------------------------------------------------------------- //
+//                                           LIFETIME                                            //
+// --------------------------------------------------------------------------------------------- //
+
+/**
+ * @brief Starts the worker threads and waits until they have allocated their states
+ * @param[in,out] self Zero-filled pool state
+ * @param[in] worker_count Number of workers
+ * @param[in] topology CPUs to pin the workers to in placement order (nullptr to not pin)
+ */
+static void
+eya_thread_pool_start(eya_thread_pool_t           *self,
+                      eya_usize_t                  worker_count,
+                      const eya_thread_topology_t *topology)
+{
+    const eya_usize_t size = worker_count * sizeof(eya_thread_pool_worker_t *);
+
+    self->workers = eya_memory_allocator_alloc(&self->allocator, size);
+    eya_memory_set(self->workers, size, 0);
+    self->seats = eya_memory_allocator_alloc(&self->allocator,
+                                             worker_count * sizeof(eya_thread_pool_seat_t));
+    self->worker_count = worker_count;
+
+    for (eya_usize_t i = 0; i < worker_count; ++i)
+    {
+        eya_thread_pool_seat_t *seat = &self->seats[i];
+
+        seat->pool  = self;
+        seat->index = i;
+        seat->cpu   = EYA_USIZE_T_MAX;
+
+        if (topology)
+        {
+            const eya_usize_t cpu_count = eya_thread_topology_get_cpu_count(topology);
+            seat->cpu = eya_thread_topology_get_cpu(topology, i % cpu_count)->id;
+        }
+    }
+
+    eya_thread_mutex_init(&self->mutex);
+    eya_thread_cond_init(&self->wake);
+    eya_thread_cond_init(&self->done);
+    eya_thread_latch_init(&self->arrived, (eya_uint_t)worker_count);
+    self->ready = true;
+
+    while (self->started < worker_count)
+    {
+        eya_thread_pool_seat_t *seat = &self->seats[self->started];
+        eya_thread_create(&seat->thread, eya_thread_pool_worker_main, seat);
+        self->started++;
+    }
+
+    eya_thread_latch_wait(&self->arrived);
+    eya_runtime_check(!eya_atomic_load(&self->failed, EYA_ATOMIC_RELAXED),
+                      EYA_RUNTIME_ERROR_MEMORY_NOT_ALLOCATED);
+}
+
+/**
+ * @brief Stops the workers and releases the pool state
+ * @param[in] self Pool state, possibly partially initialized
+ */
+static void
+eya_thread_pool_stop(eya_thread_pool_t *self)
+{
+    const eya_memory_allocator_t allocator = self->allocator;
+
+    if (self->ready)
+    {
+        eya_thread_mutex_lock(&self->mutex);
+        eya_atomic_store(&self->stop, 1, EYA_ATOMIC_RELEASE);
+        eya_thread_cond_broadcast(&self->wake);
+        eya_thread_mutex_unlock(&self->mutex);
+
+        // Threads that never started will not arrive, release the ones waiting for them.
+        if (self->started < self->worker_count)
+        {
+            eya_atomic_store(&self->failed, 1, EYA_ATOMIC_RELAXED);
+            eya_thread_latch_count_down(&self->arrived,
+                                        (eya_uint_t)(self->worker_count - self->started));
+        }
+
+        for (eya_usize_t i = 0; i < self->started; ++i)
+        {
+            eya_thread_join(&self->seats[i].thread);
+        }
+
+        eya_thread_cond_destroy(&self->done);
+        eya_thread_cond_destroy(&self->wake);
+        eya_thread_mutex_destroy(&self->mutex);
+    }
+
+    for (eya_usize_t i = 0; self->workers && i < self->worker_count; ++i)
+    {
+        eya_thread_pool_worker_t *worker = self->workers[i];
+        if (!worker)
+            continue;
+
+        while (worker->cache)
+        {
+            eya_thread_pool_task_t *task = worker->cache;
+            worker->cache                = task->next;
+            eya_memory_allocator_free(&allocator, task);
+        }
+        eya_memory_allocator_free_aligned(&allocator, worker);
+    }
+
+    if (self->workers)
+        eya_memory_allocator_free(&allocator, self->workers);
+
+    if (self->seats)
+        eya_memory_allocator_free(&allocator, self->seats);
+
+    eya_memory_allocator_free(&allocator, self);
+}
+
+/**
+ * @brief Creates a pool whose workers are optionally pinned
+ * @param[in] worker_count Number of workers, nonzero
+ * @param[in] topology CPUs to pin the workers to (nullptr to not pin)
+ * @param[in] allocator Runtime allocator of the workers (nullptr for the calling thread's one)
+ */
+static eya_thread_pool_t *
+eya_thread_pool_create(eya_usize_t                   worker_count,
+                       const eya_thread_topology_t  *topology,
+                       const eya_memory_allocator_t *allocator)
+{
+    const eya_memory_allocator_t source = allocator ? *allocator : *eya_runtime_allocator();
+
+    eya_thread_pool_t *self = eya_memory_allocator_alloc(&source, sizeof(eya_thread_pool_t));
+    eya_memory_set(self, sizeof(eya_thread_pool_t), 0);
+    self->allocator = source;
+
+    eya_runtime_try(e)
+    {
+        eya_thread_pool_start(self, worker_count, topology);
+        eya_runtime_try_return(self);
+    }
+    eya_runtime_catch
+    {
+        eya_thread_pool_stop(self);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+}
+
+eya_thread_pool_t *
+eya_thread_pool_make(eya_usize_t worker_count, const eya_memory_allocator_t *allocator)
+{
+    if (!worker_count)
+        worker_count = eya_thread_hardware_concurrency();
+
+    return eya_thread_pool_create(worker_count, nullptr, allocator);
+}
+
+eya_thread_pool_t *
+eya_thread_pool_make_pinned(eya_usize_t                   worker_count,
+                            const eya_thread_topology_t  *topology,
+                            const eya_memory_allocator_t *allocator)
+{
+    eya_runtime_return_if(
+        topology,
+        eya_thread_pool_create(
+            worker_count ? worker_count : eya_thread_topology_get_cpu_count(topology),
+            topology,
+            allocator));
+
+    eya_thread_topology_t *system = eya_thread_topology_make(nullptr, allocator);
+
+    eya_runtime_try(e)
+    {
+        eya_thread_pool_t *self = eya_thread_pool_create(
+            worker_count ? worker_count : eya_thread_topology_get_cpu_count(system),
+            system,
+            allocator);
+
+        eya_thread_topology_free(system);
+        eya_runtime_try_return(self);
+    }
+    eya_runtime_catch
+    {
+        eya_thread_topology_free(system);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+}
+
+void
+eya_thread_pool_free(eya_thread_pool_t *self)
+{
+    eya_runtime_return_ifn(self);
+    eya_thread_pool_stop(self);
+}
+
+eya_usize_t
+eya_thread_pool_get_worker_count(const eya_thread_pool_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->worker_count;
+}
+
+eya_usize_t
+eya_thread_pool_get_worker_cpu(const eya_thread_pool_t *self, eya_usize_t index)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(index < self->worker_count, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+    return self->seats[index].cpu;
+}
+
+eya_usize_t
+eya_thread_pool_get_worker_index(const eya_thread_pool_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_thread_pool_worker_t *worker = eya_thread_pool_current(self);
+    return worker ? worker->index : EYA_USIZE_T_MAX;
+}
+
+// --------------------------------------------------------------------------------------------- //
+//                                             TASKS                                             //
+// --------------------------------------------------------------------------------------------- //
+
+void
+eya_thread_pool_group_init(eya_thread_pool_group_t *group, eya_thread_pool_t *pool)
+{
+    eya_runtime_check_ref(group);
+    eya_runtime_check_ref(pool);
+
+    eya_memory_set(group, sizeof(eya_thread_pool_group_t), 0);
+    group->pool = pool;
+}
+
+void
+eya_thread_pool_spawn(eya_thread_pool_group_t *group,
+                      eya_thread_pool_task_fn *fn,
+                      const void              *closure,
+                      eya_usize_t              closure_size)
+{
+    eya_runtime_check_ref(group);
+    eya_runtime_check_ref(fn);
+    eya_runtime_check(closure || !closure_size, EYA_RUNTIME_ERROR_NULL_POINTER);
+    eya_runtime_check(closure_size <= EYA_THREAD_POOL_CLOSURE_SIZE,
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    eya_thread_pool_t        *pool   = group->pool;
+    eya_thread_pool_worker_t *worker = eya_thread_pool_current(pool);
+    eya_thread_pool_task_t   *task   = eya_thread_pool_task_alloc(pool, worker);
+
+    task->fn    = fn;
+    task->group = group;
+    task->next  = nullptr;
+
+    if (closure_size)
+        eya_memory_std_copy(task->closure.bytes, closure, closure_size);
+
+    eya_atomic_fetch_add(&group->pending, 1, EYA_ATOMIC_RELAXED);
+
+    if (worker)
+    {
+        if (!eya_thread_pool_deque_push(&worker->deque, task))
+        {
+            eya_thread_pool_run(pool, worker, task);
+            return;
+        }
+    }
+    else
+    {
+        eya_thread_mutex_lock(&pool->mutex);
+        if (pool->inject_tail)
+            pool->inject_tail->next = task;
+        else
+            pool->inject_head = task;
+
+        pool->inject_tail = task;
+        eya_atomic_fetch_add(&pool->injected, 1, EYA_ATOMIC_RELAXED);
+        eya_thread_mutex_unlock(&pool->mutex);
+    }
+
+    eya_thread_pool_notify(pool);
+}
+
+void
+eya_thread_pool_sync(eya_thread_pool_group_t *group)
+{
+    eya_runtime_check_ref(group);
+
+    eya_thread_pool_t        *pool   = group->pool;
+    eya_thread_pool_worker_t *worker = eya_thread_pool_current(pool);
+
+    while (eya_atomic_load(&group->pending, EYA_ATOMIC_ACQUIRE))
+    {
+        // Tasks run only on workers, so they always see the pool's runtime allocator.
+        if (!worker)
+        {
+            eya_thread_pool_wait_done(pool, group);
+            continue;
+        }
+
+        eya_thread_pool_task_t *task = eya_thread_pool_find(pool, worker);
+        if (task)
+            eya_thread_pool_run(pool, worker, task);
+        else
+            eya_thread_yield();
+    }
+
+    if (eya_atomic_load(&group->failed, EYA_ATOMIC_ACQUIRE))
+    {
+        eya_thread_pool_task_t *failure   = group->failure;
+        const eya_exception_t   exception = failure->closure.exception;
+
+        eya_thread_pool_task_free(pool, worker, failure);
+        group->failure = nullptr;
+        eya_atomic_store(&group->failed, 0, EYA_ATOMIC_RELAXED);
+        eya_runtime_exception_catch_stack_throw(&exception);
+    }
+}
+
+/**
+ * @brief Closure of a parallel loop task
+ */
+typedef struct eya_thread_pool_range
+{
+    eya_thread_pool_range_fn *fn;      /**< Loop body */
+    void                     *context; /**< User pointer passed to the body */
+    eya_thread_pool_group_t  *group;   /**< Group of the loop */
+    eya_usize_t               begin;   /**< First index of the part */
+    eya_usize_t               end;     /**< Index past the last one of the part */
+    eya_usize_t               grain;   /**< Largest chunk passed to the body */
+} eya_thread_pool_range_t;
+
+/**
+ * @brief Splits a part of a loop, spawning the right halves, and runs the leftmost chunk
+ */
+static void
+eya_thread_pool_range_task(void *closure)
+{
+    eya_thread_pool_range_t range = *eya_ptr_cast(eya_thread_pool_range_t, closure);
+
+    while (range.end - range.begin > range.grain)
+    {
+        eya_thread_pool_range_t right = range;
+        right.begin                   = range.begin + (range.end - range.begin) / 2;
+
+        eya_thread_pool_spawn(range.group, eya_thread_pool_range_task, &right, sizeof(right));
+        range.end = right.begin;
+    }
+
+    range.fn(range.context, range.begin, range.end);
+}
+
+void
+eya_thread_pool_parallel_for(eya_thread_pool_t        *self,
+                             eya_usize_t               begin,
+                             eya_usize_t               end,
+                             eya_usize_t               grain,
+                             eya_thread_pool_range_fn *fn,
+                             void                     *context)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(fn);
+    eya_runtime_return_if(begin >= end);
+
+    // About eight chunks per worker leave room for stealing to even out the load.
+    if (!grain)
+        grain = eya_math_max((end - begin) / (self->worker_count * 8), (eya_usize_t)1);
+
+    eya_thread_pool_group_t group;
+    eya_thread_pool_group_init(&group, self);
+
+    const eya_thread_pool_range_t range = {fn, context, &group, begin, end, grain};
+
+    // The root is spawned rather than run, so an exception never leaves
+    // this frame while other chunks still refer to the group.
+    eya_thread_pool_spawn(&group, eya_thread_pool_range_task, &range, sizeof(range));
+    eya_thread_pool_sync(&group);
+}
+
+/**
+ * @brief Closure of a member of a phase team
+ */
+typedef struct eya_thread_pool_team
+{
+    eya_thread_pool_phase_fn *fn;           /**< Phase body */
+    void                     *context;      /**< User pointer passed to the body */
+    eya_thread_barrier_t     *barrier;      /**< Barrier between the phases */
+    eya_atomic_usize_t       *failed;       /**< Nonzero once a member has thrown */
+    eya_usize_t               phase_count;  /**< Number of phases */
+    eya_usize_t               member;       /**< Index of the member */
+    eya_usize_t               member_count; /**< Number of members */
+} eya_thread_pool_team_t;
+
+/**
+ * @brief Runs one member of a phase team
+ *
+ * Members first wait for each other, so no phase body runs before every member
+ * holds a worker of its own: a body that syncs could otherwise take a sibling
+ * that has not started yet onto its stack, where it would wait for the body forever.
+ * A member that throws keeps arriving at the barrier until the last phase,
+ * so the other members never wait for it forever.
+ */
+static void
+eya_thread_pool_team_task(void *closure)
+{
+    const eya_thread_pool_team_t *team = closure;
+
+    eya_exception_t exception;
+    bool            thrown = false;
+
+    eya_thread_barrier_wait(team->barrier);
+
+    for (eya_usize_t phase = 0; phase < team->phase_count; ++phase)
+    {
+        // Set before the thrower reaches the barrier, so every member skips the next phases.
+        if (!eya_atomic_load(team->failed, EYA_ATOMIC_RELAXED))
+        {
+            eya_runtime_try(e)
+            {
+                team->fn(team->context, phase, team->member, team->member_count);
+                eya_runtime_try_finalize();
+            }
+            eya_runtime_catch
+            {
+                exception = e.exception;
+                thrown    = true;
+                eya_atomic_store(team->failed, 1, EYA_ATOMIC_RELAXED);
+            }
+        }
+
+        eya_thread_barrier_wait(team->barrier);
+    }
+
+    if (thrown)
+        eya_runtime_exception_catch_stack_throw(&exception);
+}
+
+/**
+ * @brief Spawns the members of a team and waits for them
+ */
+static void
+eya_thread_pool_team_run(eya_thread_pool_t        *self,
+                         eya_usize_t               member_count,
+                         eya_usize_t               phase_count,
+                         eya_thread_pool_phase_fn *fn,
+                         void                     *context)
+{
+    eya_thread_barrier_t barrier;
+    eya_atomic_usize_t   failed;
+    eya_thread_barrier_init(&barrier, (eya_uint_t)member_count);
+    eya_atomic_store(&failed, 0, EYA_ATOMIC_RELAXED);
+
+    eya_thread_pool_group_t group;
+    eya_thread_pool_group_init(&group, self);
+
+    for (eya_usize_t member = 0; member < member_count; ++member)
+    {
+        const eya_thread_pool_team_t team = {
+            fn, context, &barrier, &failed, phase_count, member, member_count};
+
+        eya_thread_pool_spawn(&group, eya_thread_pool_team_task, &team, sizeof(team));
+    }
+
+    eya_thread_pool_sync(&group);
+}
+
+void
+eya_thread_pool_parallel_phases(eya_thread_pool_t        *self,
+                                eya_usize_t               member_count,
+                                eya_usize_t               phase_count,
+                                eya_thread_pool_phase_fn *fn,
+                                void                     *context)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check_ref(fn);
+    eya_runtime_check(member_count <= self->worker_count, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+    eya_runtime_return_if(!phase_count);
+
+    if (!member_count)
+        member_count = self->worker_count;
+
+    // Members hold their workers until the last phase, so a second team could only get
+    // the workers the first one leaves, and a team started from a phase body would wait
+    // for the member running it. Both are refused instead.
+    eya_usize_t idle     = 0;
+    const bool  acquired =
+        eya_atomic_compare_exchange(&self->team, &idle, 1, EYA_ATOMIC_ACQUIRE, EYA_ATOMIC_RELAXED);
+    eya_runtime_check(acquired, EYA_RUNTIME_ERROR_RESOURCE_EXHAUSTED);
+
+    eya_runtime_try(e)
+    {
+        eya_thread_pool_team_run(self, member_count, phase_count, fn, context);
+        eya_runtime_try_finalize();
+    }
+    eya_runtime_catch
+    {
+        eya_atomic_store(&self->team, 0, EYA_ATOMIC_RELEASE);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+
+    eya_atomic_store(&self->team, 0, EYA_ATOMIC_RELEASE);
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include <eya/thread_rwlock.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/thread_futex.h>
+
+/**
+ * @brief Bits of the state counting the readers
+ */
+#define EYA_THREAD_RWLOCK_READERS 0x3FFFFFFFu
+
+/**
+ * @brief Bit of the state set while a writer holds the lock
+ */
+#define EYA_THREAD_RWLOCK_WRITER 0x40000000u
+
+/**
+ * @brief Bit of the state set while threads may sleep on the word
+ *
+ * Whoever clears the bit wakes all sleepers, the ones that still
+ * can not enter set it again before going back to sleep.
+ */
+#define EYA_THREAD_RWLOCK_SLEEPERS 0x80000000u
+
+/**
+ * @brief Adds `add` to the state if none of the `blocked` bits are set
+ * @return true if the lock was acquired
+ */
+static bool
+eya_thread_rwlock_try_acquire(eya_thread_rwlock_t *self, eya_uint_t blocked, eya_uint_t add)
+{
+    eya_uint_t state = eya_atomic_load(&self->state, EYA_ATOMIC_RELAXED);
+
+    while (!(state & blocked))
+    {
+        if (eya_atomic_compare_exchange(
+                &self->state, &state, state + add, EYA_ATOMIC_ACQUIRE, EYA_ATOMIC_RELAXED))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Spins and then sleeps until the state allows adding `add`
+ */
+static void
+eya_thread_rwlock_acquire(eya_thread_rwlock_t *self, eya_uint_t blocked, eya_uint_t add)
+{
+    eya_runtime_return_if(eya_thread_rwlock_try_acquire(self, blocked, add));
+
+    for (eya_uint_t spin = 0; spin < EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT; ++spin)
+    {
+        eya_atomic_pause();
+
+        if (!(eya_atomic_load(&self->state, EYA_ATOMIC_RELAXED) & blocked) &&
+            eya_thread_rwlock_try_acquire(self, blocked, add))
+        {
+            return;
+        }
+    }
+
+    for (;;)
+    {
+        eya_uint_t state = eya_atomic_load(&self->state, EYA_ATOMIC_RELAXED);
+
+        if (!(state & blocked))
+        {
+            if (eya_atomic_compare_exchange(
+                    &self->state, &state, state + add, EYA_ATOMIC_ACQUIRE, EYA_ATOMIC_RELAXED))
+            {
+                return;
+            }
+            continue;
+        }
+
+        // Announce the sleeper first, so the thread releasing the lock knows to wake it.
+        if (!(state & EYA_THREAD_RWLOCK_SLEEPERS) &&
+            !eya_atomic_compare_exchange(&self->state,
+                                         &state,
+                                         state | EYA_THREAD_RWLOCK_SLEEPERS,
+                                         EYA_ATOMIC_RELAXED,
+                                         EYA_ATOMIC_RELAXED))
+        {
+            continue;
+        }
+
+        eya_thread_futex_wait(&self->state, state | EYA_THREAD_RWLOCK_SLEEPERS);
+    }
+}
+
+void
+eya_thread_rwlock_init(eya_thread_rwlock_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_atomic_store(&self->state, 0, EYA_ATOMIC_RELAXED);
+}
+
+void
+eya_thread_rwlock_read_lock(eya_thread_rwlock_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_thread_rwlock_acquire(self, EYA_THREAD_RWLOCK_WRITER, 1);
+}
+
+bool
+eya_thread_rwlock_try_read_lock(eya_thread_rwlock_t *self)
+{
+    eya_runtime_check_ref(self);
+    return eya_thread_rwlock_try_acquire(self, EYA_THREAD_RWLOCK_WRITER, 1);
+}
+
+void
+eya_thread_rwlock_read_unlock(eya_thread_rwlock_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_uint_t state = eya_atomic_fetch_sub(&self->state, 1, EYA_ATOMIC_RELEASE);
+
+    // Only writers sleep while readers hold the lock, and they wait for the last one.
+    if ((state & EYA_THREAD_RWLOCK_READERS) == 1 && (state & EYA_THREAD_RWLOCK_SLEEPERS))
+    {
+        eya_atomic_fetch_and(&self->state, ~EYA_THREAD_RWLOCK_SLEEPERS, EYA_ATOMIC_RELAXED);
+        eya_thread_futex_wake_all(&self->state);
+    }
+}
+
+void
+eya_thread_rwlock_write_lock(eya_thread_rwlock_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_thread_rwlock_acquire(
+        self, EYA_THREAD_RWLOCK_WRITER | EYA_THREAD_RWLOCK_READERS, EYA_THREAD_RWLOCK_WRITER);
+}
+
+bool
+eya_thread_rwlock_try_write_lock(eya_thread_rwlock_t *self)
+{
+    eya_runtime_check_ref(self);
+    return eya_thread_rwlock_try_acquire(
+        self, EYA_THREAD_RWLOCK_WRITER | EYA_THREAD_RWLOCK_READERS, EYA_THREAD_RWLOCK_WRITER);
+}
+
+void
+eya_thread_rwlock_write_unlock(eya_thread_rwlock_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_uint_t state = eya_atomic_fetch_and(
+        &self->state, ~(EYA_THREAD_RWLOCK_WRITER | EYA_THREAD_RWLOCK_SLEEPERS), EYA_ATOMIC_RELEASE);
+
+    if (state & EYA_THREAD_RWLOCK_SLEEPERS)
+        eya_thread_futex_wake_all(&self->state);
+}
\ No newline at end of file
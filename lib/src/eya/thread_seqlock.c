@@ -0,0 +1,102 @@
+#include <eya/thread_seqlock.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/memory_std.h>
+#include <eya/thread.h>
+
+void
+eya_thread_seqlock_init(eya_thread_seqlock_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_atomic_store(&self->sequence, 0, EYA_ATOMIC_RELAXED);
+}
+
+eya_uint_t
+eya_thread_seqlock_read_begin(eya_thread_seqlock_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    for (eya_uint_t spin = 0;; ++spin)
+    {
+        const eya_uint_t sequence = eya_atomic_load(&self->sequence, EYA_ATOMIC_ACQUIRE);
+        if (!(sequence & 1))
+            return sequence;
+
+        if (spin < EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT)
+            eya_atomic_pause();
+        else
+            eya_thread_yield(); // the writer may have been preempted
+    }
+}
+
+bool
+eya_thread_seqlock_read_retry(eya_thread_seqlock_t *self, eya_uint_t sequence)
+{
+    eya_runtime_check_ref(self);
+
+    // Keeps the data reads of the caller before the second load of the sequence.
+    eya_atomic_thread_fence(EYA_ATOMIC_ACQUIRE);
+    return eya_atomic_load(&self->sequence, EYA_ATOMIC_RELAXED) != sequence;
+}
+
+void
+eya_thread_seqlock_write_lock(eya_thread_seqlock_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    for (eya_uint_t spin = 0;; ++spin)
+    {
+        eya_uint_t sequence = eya_atomic_load(&self->sequence, EYA_ATOMIC_RELAXED);
+
+        if (!(sequence & 1) && eya_atomic_compare_exchange(&self->sequence,
+                                                           &sequence,
+                                                           sequence + 1,
+                                                           EYA_ATOMIC_ACQUIRE,
+                                                           EYA_ATOMIC_RELAXED))
+        {
+            break;
+        }
+
+        if (spin < EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT)
+            eya_atomic_pause();
+        else
+            eya_thread_yield();
+    }
+
+    // Keeps the data writes of the caller after the odd sequence becomes visible.
+    eya_atomic_thread_fence(EYA_ATOMIC_RELEASE);
+}
+
+void
+eya_thread_seqlock_write_unlock(eya_thread_seqlock_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_uint_t sequence = eya_atomic_load(&self->sequence, EYA_ATOMIC_RELAXED);
+    eya_atomic_store(&self->sequence, sequence + 1, EYA_ATOMIC_RELEASE);
+}
+
+void
+eya_thread_seqlock_read(eya_thread_seqlock_t *self, void *dst, const void *src, eya_usize_t size)
+{
+    eya_runtime_check_ref(dst);
+    eya_runtime_check_ref(src);
+
+    eya_uint_t sequence;
+    do
+    {
+        sequence = eya_thread_seqlock_read_begin(self);
+        eya_memory_std_copy(dst, src, size);
+    } while (eya_thread_seqlock_read_retry(self, sequence));
+}
+
+void
+eya_thread_seqlock_write(eya_thread_seqlock_t *self, void *dst, const void *src, eya_usize_t size)
+{
+    eya_runtime_check_ref(dst);
+    eya_runtime_check_ref(src);
+
+    eya_thread_seqlock_write_lock(self);
+    eya_memory_std_copy(dst, src, size);
+    eya_thread_seqlock_write_unlock(self);
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <eya/thread_spinlock.h>
+
+#include <eya/runtime_check_ref.h>
+#include <eya/thread.h>
+
+void
+eya_thread_spinlock_init(eya_thread_spinlock_t *self)
+{
+    eya_runtime_check_ref(self);
+    eya_atomic_store(&self->next, 0, EYA_ATOMIC_RELAXED);
+    eya_atomic_store(&self->owner, 0, EYA_ATOMIC_RELAXED);
+}
+
+void
+eya_thread_spinlock_lock(eya_thread_spinlock_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    const eya_uint_t ticket = eya_atomic_fetch_add(&self->next, 1, EYA_ATOMIC_RELAXED);
+
+    for (eya_uint_t spin = 0;; ++spin)
+    {
+        const eya_uint_t owner = eya_atomic_load(&self->owner, EYA_ATOMIC_ACQUIRE);
+        if (owner == ticket)
+            break;
+
+        // A holder or a waiter ahead that lost its processor can only continue if this
+        // thread gives its own away, so the wait stops being a pure spin after a while.
+        if (spin >= EYA_LIBRARY_OPTION_THREAD_LOCK_SPIN_COUNT)
+        {
+            eya_thread_yield();
+            continue;
+        }
+
+        // Back off in proportion to the queue length ahead of this ticket,
+        // so waiters far back do not keep hitting the owner's line.
+        for (eya_uint_t i = ticket - owner; i; --i)
+            eya_atomic_pause();
+    }
+}
+
+bool
+eya_thread_spinlock_try_lock(eya_thread_spinlock_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    // The lock is free when the next ticket is the one being served.
+    // The acquire load pairs with the release in the last unlock.
+    eya_uint_t owner = eya_atomic_load(&self->owner, EYA_ATOMIC_ACQUIRE);
+    return eya_atomic_compare_exchange(
+        &self->next, &owner, owner + 1, EYA_ATOMIC_RELAXED, EYA_ATOMIC_RELAXED);
+}
+
+void
+eya_thread_spinlock_unlock(eya_thread_spinlock_t *self)
+{
+    eya_runtime_check_ref(self);
+
+    // Only the holder writes `owner`, so a plain increment is enough.
+    const eya_uint_t owner = eya_atomic_load(&self->owner, EYA_ATOMIC_RELAXED);
+    eya_atomic_store(&self->owner, owner + 1, EYA_ATOMIC_RELEASE);
+}
\ No newline at end of file
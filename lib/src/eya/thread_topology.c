@@ -0,0 +1,452 @@
+#include <eya/thread_topology.h>
+
+#include <eya/runtime_exception_catch_stack.h>
+#include <eya/runtime_allocator.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/runtime_return_if.h>
+#include <eya/runtime_check.h>
+#include <eya/checked_math.h>
+#include <eya/runtime_try.h>
+#include <eya/nullptr.h>
+#include <eya/thread.h>
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#if (EYA_COMPILER_OS_TYPE != EYA_COMPILER_OS_TYPE_WINDOWS)
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+/**
+ * @brief Size of the buffer holding a sysfs path
+ */
+#define EYA_THREAD_TOPOLOGY_PATH_SIZE 512
+
+/**
+ * @brief Size of the buffer holding the contents of a sysfs file
+ */
+#define EYA_THREAD_TOPOLOGY_TEXT_SIZE 4096
+
+/**
+ * @brief Longest range accepted in a CPU list, longer ones are taken as malformed
+ */
+#define EYA_THREAD_TOPOLOGY_RANGE_MAX 65536
+
+/**
+ * @brief Default root of the sysfs trees
+ */
+#define EYA_THREAD_TOPOLOGY_ROOT "/sys/devices/system"
+
+/**
+ * @brief Logical CPU with its rank among the hardware threads of its core
+ */
+typedef struct eya_thread_topology_entry
+{
+    eya_thread_topology_cpu_t cpu;  /**< Position of the CPU */
+    eya_usize_t               rank; /**< Number of CPUs of the same core with a lower id */
+} eya_thread_topology_entry_t;
+
+struct eya_thread_topology
+{
+    eya_memory_allocator_t       allocator;     /**< Source of the topology memory */
+    eya_thread_topology_entry_t *entries;       /**< CPUs in placement order */
+    eya_usize_t                  cpu_count;     /**< Number of CPUs */
+    eya_usize_t                  core_count;    /**< Number of distinct cores */
+    eya_usize_t                  package_count; /**< Number of distinct packages */
+    eya_usize_t                  node_count;    /**< Number of distinct nodes */
+};
+
+/**
+ * @brief Formats a path below the root, the arguments follow the format
+ */
+#define eya_thread_topology_path(buffer, format, ...)                                              \
+    eya_runtime_check(snprintf(buffer, EYA_THREAD_TOPOLOGY_PATH_SIZE, format, __VA_ARGS__) <       \
+                          EYA_THREAD_TOPOLOGY_PATH_SIZE,                                           \
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT)
+
+/**
+ * @brief Reads a small text file into a zero-terminated buffer
+ * @return false if the file could not be read
+ */
+static bool
+eya_thread_topology_read(const char *path, char *text)
+{
+#if (EYA_COMPILER_OS_TYPE == EYA_COMPILER_OS_TYPE_WINDOWS)
+    (void)path;
+    (void)text;
+    return false;
+#else
+    const int fd = open(path, O_RDONLY);
+    eya_runtime_return_if(fd < 0, false);
+
+    const ssize_t size = read(fd, text, EYA_THREAD_TOPOLOGY_TEXT_SIZE - 1);
+    close(fd);
+
+    eya_runtime_return_if(size <= 0, false);
+    text[size] = '\0';
+    return true;
+#endif
+}
+
+/**
+ * @brief Parses a decimal number, advancing the cursor past it
+ * @return false if the cursor is not at a digit
+ */
+static bool
+eya_thread_topology_parse_number(const char **cursor, eya_usize_t *value)
+{
+    const char *p = *cursor;
+    eya_runtime_return_if(*p < '0' || *p > '9', false);
+
+    for (*value = 0; *p >= '0' && *p <= '9'; ++p)
+        *value = *value * 10 + (eya_usize_t)(*p - '0');
+
+    *cursor = p;
+    return true;
+}
+
+/**
+ * @brief Function called for every CPU of a parsed list
+ */
+typedef void(eya_thread_topology_visit_fn)(void *context, eya_usize_t id);
+
+/**
+ * @brief Parses a CPU list such as `0-3,8,10-11`
+ *
+ * Parsing stops at the first malformed entry.
+ *
+ * @param[in] text List to parse
+ * @param[in] visit Function called for every listed CPU in order
+ * @param[in] context User pointer passed to `visit`
+ */
+static void
+eya_thread_topology_parse_list(const char                   *text,
+                               eya_thread_topology_visit_fn *visit,
+                               void                         *context)
+{
+    eya_usize_t first = 0;
+    eya_usize_t last  = 0;
+
+    while (eya_thread_topology_parse_number(&text, &first))
+    {
+        last = first;
+        if (*text == '-')
+        {
+            ++text;
+            if (!eya_thread_topology_parse_number(&text, &last) || last < first ||
+                last - first >= EYA_THREAD_TOPOLOGY_RANGE_MAX)
+            {
+                break;
+            }
+        }
+
+        for (eya_usize_t id = first; id <= last; ++id)
+            visit(context, id);
+
+        if (*text != ',')
+            break;
+        ++text;
+    }
+}
+
+/**
+ * @brief Reads a number from a file, returning the fallback value if it cannot be read
+ */
+static eya_usize_t
+eya_thread_topology_read_number(const char *path, char *text, eya_usize_t fallback)
+{
+    const char *cursor = text;
+    eya_usize_t value  = fallback;
+
+    if (!eya_thread_topology_read(path, text) ||
+        !eya_thread_topology_parse_number(&cursor, &value))
+    {
+        value = fallback;
+    }
+    return value;
+}
+
+/**
+ * @brief Orders CPUs by package, core and id
+ */
+static int
+eya_thread_topology_compare_core(const void *lhs, const void *rhs)
+{
+    const eya_thread_topology_cpu_t *a = &((const eya_thread_topology_entry_t *)lhs)->cpu;
+    const eya_thread_topology_cpu_t *b = &((const eya_thread_topology_entry_t *)rhs)->cpu;
+
+    if (a->package != b->package)
+        return a->package < b->package ? -1 : 1;
+    if (a->core != b->core)
+        return a->core < b->core ? -1 : 1;
+    return a->id < b->id ? -1 : a->id > b->id;
+}
+
+/**
+ * @brief Orders CPUs for placement: rank, node, package, core, id
+ */
+static int
+eya_thread_topology_compare_placement(const void *lhs, const void *rhs)
+{
+    const eya_thread_topology_entry_t *a = lhs;
+    const eya_thread_topology_entry_t *b = rhs;
+
+    if (a->rank != b->rank)
+        return a->rank < b->rank ? -1 : 1;
+    if (a->cpu.node != b->cpu.node)
+        return a->cpu.node < b->cpu.node ? -1 : 1;
+    return eya_thread_topology_compare_core(lhs, rhs);
+}
+
+/**
+ * @brief Allocates the entries of a topology
+ * @param[in,out] self Topology without entries
+ * @param[in] count Number of CPUs
+ */
+static void
+eya_thread_topology_alloc(eya_thread_topology_t *self, eya_usize_t count)
+{
+    eya_usize_t size;
+    eya_runtime_check_if(eya_checked_mul(count, sizeof(eya_thread_topology_entry_t), &size),
+                         EYA_RUNTIME_ERROR_OVERFLOW);
+
+    self->entries = eya_memory_allocator_alloc(&self->allocator, size);
+}
+
+/**
+ * @brief Counts the CPUs of a list
+ */
+static void
+eya_thread_topology_visit_count(void *context, eya_usize_t id)
+{
+    (void)id;
+    ++*(eya_usize_t *)context;
+}
+
+/**
+ * @brief Appends a CPU of the online list to a topology
+ */
+static void
+eya_thread_topology_visit_cpu(void *context, eya_usize_t id)
+{
+    eya_thread_topology_t       *self  = context;
+    eya_thread_topology_entry_t *entry = &self->entries[self->cpu_count++];
+
+    entry->cpu.id      = id;
+    entry->cpu.core    = id;
+    entry->cpu.package = 0;
+    entry->cpu.node    = 0;
+    entry->rank        = 0;
+}
+
+/**
+ * @brief State of the node assignment
+ */
+typedef struct eya_thread_topology_nodes
+{
+    eya_thread_topology_t *self; /**< Topology being read */
+    const char            *root; /**< Root of the sysfs trees */
+    eya_usize_t            node; /**< Node whose CPU list is parsed */
+} eya_thread_topology_nodes_t;
+
+/**
+ * @brief Assigns a CPU to the node being parsed
+ */
+static void
+eya_thread_topology_visit_node_cpu(void *context, eya_usize_t id)
+{
+    const eya_thread_topology_nodes_t *nodes = context;
+
+    for (eya_usize_t i = 0; i < nodes->self->cpu_count; ++i)
+    {
+        if (nodes->self->entries[i].cpu.id == id)
+            nodes->self->entries[i].cpu.node = nodes->node;
+    }
+}
+
+/**
+ * @brief Reads the CPU list of a node of the online node list
+ */
+static void
+eya_thread_topology_visit_node(void *context, eya_usize_t node)
+{
+    eya_thread_topology_nodes_t *nodes = context;
+
+    char path[EYA_THREAD_TOPOLOGY_PATH_SIZE];
+    char text[EYA_THREAD_TOPOLOGY_TEXT_SIZE];
+
+    eya_thread_topology_path(path, "%s/node/node%zu/cpulist", nodes->root, (size_t)node);
+    eya_runtime_return_ifn(eya_thread_topology_read(path, text));
+
+    nodes->node = node;
+    eya_thread_topology_parse_list(text, eya_thread_topology_visit_node_cpu, nodes);
+}
+
+/**
+ * @brief Fills a topology from the sysfs trees below the root
+ * @return false if the CPU list could not be read
+ */
+static bool
+eya_thread_topology_read_tree(eya_thread_topology_t *self, const char *root)
+{
+    char        path[EYA_THREAD_TOPOLOGY_PATH_SIZE];
+    char        text[EYA_THREAD_TOPOLOGY_TEXT_SIZE];
+    eya_usize_t count = 0;
+
+    eya_thread_topology_path(path, "%s/cpu/online", root);
+    eya_runtime_return_ifn(eya_thread_topology_read(path, text), false);
+
+    eya_thread_topology_parse_list(text, eya_thread_topology_visit_count, &count);
+    eya_runtime_return_ifn(count, false);
+
+    eya_thread_topology_alloc(self, count);
+    self->cpu_count = 0;
+    eya_thread_topology_parse_list(text, eya_thread_topology_visit_cpu, self);
+
+    for (eya_usize_t i = 0; i < self->cpu_count; ++i)
+    {
+        eya_thread_topology_cpu_t *cpu = &self->entries[i].cpu;
+        const size_t               id  = (size_t)cpu->id;
+
+        eya_thread_topology_path(path, "%s/cpu/cpu%zu/topology/core_id", root, id);
+        cpu->core = eya_thread_topology_read_number(path, text, cpu->id);
+
+        eya_thread_topology_path(path, "%s/cpu/cpu%zu/topology/physical_package_id", root, id);
+        cpu->package = eya_thread_topology_read_number(path, text, 0);
+    }
+
+    eya_thread_topology_nodes_t nodes = {self, root, 0};
+
+    eya_thread_topology_path(path, "%s/node/online", root);
+    if (eya_thread_topology_read(path, text))
+        eya_thread_topology_parse_list(text, eya_thread_topology_visit_node, &nodes);
+
+    return true;
+}
+
+/**
+ * @brief Fills a topology with one single-core CPU per hardware thread
+ */
+static void
+eya_thread_topology_read_flat(eya_thread_topology_t *self)
+{
+    const eya_usize_t count = eya_thread_hardware_concurrency();
+
+    eya_thread_topology_alloc(self, count);
+    self->cpu_count = 0;
+
+    for (eya_usize_t i = 0; i < count; ++i)
+        eya_thread_topology_visit_cpu(self, i);
+}
+
+/**
+ * @brief Ranks the hardware threads of every core, counts the cores, packages and nodes
+ *        and puts the CPUs in placement order
+ */
+static void
+eya_thread_topology_order(eya_thread_topology_t *self)
+{
+    eya_thread_topology_entry_t *entries = self->entries;
+    const eya_usize_t            count   = self->cpu_count;
+
+    qsort(entries, count, sizeof(*entries), eya_thread_topology_compare_core);
+
+    self->core_count    = 0;
+    self->package_count = 0;
+    self->node_count    = 0;
+
+    for (eya_usize_t i = 0; i < count; ++i)
+    {
+        const eya_thread_topology_cpu_t *cpu  = &entries[i].cpu;
+        const eya_thread_topology_cpu_t *prev = i ? &entries[i - 1].cpu : nullptr;
+
+        const bool new_package = !prev || prev->package != cpu->package;
+        const bool new_core    = new_package || prev->core != cpu->core;
+
+        entries[i].rank = new_core ? 0 : entries[i - 1].rank + 1;
+        self->core_count += new_core;
+        self->package_count += new_package;
+
+        bool new_node = true;
+        for (eya_usize_t j = 0; j < i && new_node; ++j)
+            new_node = entries[j].cpu.node != cpu->node;
+        self->node_count += new_node;
+    }
+
+    qsort(entries, count, sizeof(*entries), eya_thread_topology_compare_placement);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+eya_thread_topology_t *
+eya_thread_topology_make(const char *root, const eya_memory_allocator_t *allocator)
+{
+    const eya_memory_allocator_t source = allocator ? *allocator : *eya_runtime_allocator();
+    eya_thread_topology_t *self = eya_memory_allocator_alloc(&source, sizeof(*self));
+
+    self->allocator = source;
+    self->entries   = nullptr;
+    self->cpu_count = 0;
+
+    eya_runtime_try(e)
+    {
+        if (!eya_thread_topology_read_tree(self, root ? root : EYA_THREAD_TOPOLOGY_ROOT))
+            eya_thread_topology_read_flat(self);
+
+        eya_thread_topology_order(self);
+        eya_runtime_try_return(self);
+    }
+    eya_runtime_catch
+    {
+        eya_thread_topology_free(self);
+        eya_runtime_exception_catch_stack_throw(&e.exception);
+    }
+}
+
+void
+eya_thread_topology_free(eya_thread_topology_t *self)
+{
+    eya_runtime_return_ifn(self);
+
+    const eya_memory_allocator_t allocator = self->allocator;
+
+    eya_memory_allocator_free(&allocator, self->entries);
+    eya_memory_allocator_free(&allocator, self);
+}
+
+eya_usize_t
+eya_thread_topology_get_cpu_count(const eya_thread_topology_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->cpu_count;
+}
+
+const eya_thread_topology_cpu_t *
+eya_thread_topology_get_cpu(const eya_thread_topology_t *self, eya_usize_t index)
+{
+    eya_runtime_check_ref(self);
+    eya_runtime_check(index < self->cpu_count, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+    return &self->entries[index].cpu;
+}
+
+eya_usize_t
+eya_thread_topology_get_core_count(const eya_thread_topology_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->core_count;
+}
+
+eya_usize_t
+eya_thread_topology_get_package_count(const eya_thread_topology_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->package_count;
+}
+
+eya_usize_t
+eya_thread_topology_get_node_count(const eya_thread_topology_t *self)
+{
+    eya_runtime_check_ref(self);
+    return self->node_count;
+}
\ No newline at end of file
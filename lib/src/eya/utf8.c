@@ -0,0 +1,1357 @@
+#include <eya/utf8.h>
+
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_check_ref.h>
+#include <eya/numeric_limits.h>
+#include <eya/bit_util.h>
+#include <eya/cpu.h>
+
+#if ((EYA_COMPILER_GCC_LIKE) && defined(__x86_64__)) ||                                            \
+    ((EYA_COMPILER_TYPE == EYA_COMPILER_MSVC) && defined(_M_X64))
+#    include <immintrin.h>
+#    define EYA_UTF8_X86 1
+#endif
+
+#if (EYA_UTF8_X86)
+static bool eya_utf8_has_avx2;
+#endif
+
+/**
+ * @brief Word with the high bit of each byte set
+ */
+#define EYA_UTF8_HIGH_BITS 0x8080808080808080ULL
+
+/**
+ * @brief Reads 8 bytes as a little-endian word
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_ullong_t
+eya_utf8_read64(const eya_uchar_t *p)
+{
+    return (eya_ullong_t)p[0] | (eya_ullong_t)p[1] << 8 | (eya_ullong_t)p[2] << 16 |
+           (eya_ullong_t)p[3] << 24 | (eya_ullong_t)p[4] << 32 | (eya_ullong_t)p[5] << 40 |
+           (eya_ullong_t)p[6] << 48 | (eya_ullong_t)p[7] << 56;
+}
+
+/**
+ * @brief Decodes the character at the start of a range
+ * @param[out] code_point Decoded code point
+ * @return Length of the sequence, 0 if it is not valid UTF-8
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_usize_t
+eya_utf8_decode(const eya_uchar_t *p, eya_usize_t size, eya_uint_t *code_point)
+{
+    const eya_uint_t lead = p[0];
+
+    if (lead < 0x80)
+    {
+        *code_point = lead;
+        return 1;
+    }
+
+    // 0x80 to 0xBF are continuation bytes, 0xC0 and 0xC1 only start overlong forms.
+    if (lead < 0xC2)
+        return 0;
+
+    if (lead < 0xE0)
+    {
+        if (size < 2 || (p[1] & 0xC0) != 0x80)
+            return 0;
+
+        *code_point = (lead & 0x1F) << 6 | (p[1] & 0x3F);
+        return 2;
+    }
+
+    if (lead < 0xF0)
+    {
+        if (size < 3 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80)
+            return 0;
+
+        const eya_uint_t value = (lead & 0x0F) << 12 | (p[1] & 0x3F) << 6 | (p[2] & 0x3F);
+        if (value < 0x800 || (value >= 0xD800 && value <= 0xDFFF))
+            return 0;
+
+        *code_point = value;
+        return 3;
+    }
+
+    if (lead < 0xF5)
+    {
+        if (size < 4 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80 ||
+            (p[3] & 0xC0) != 0x80)
+            return 0;
+
+        const eya_uint_t value =
+            (lead & 0x07) << 18 | (p[1] & 0x3F) << 12 | (p[2] & 0x3F) << 6 | (p[3] & 0x3F);
+        if (value < 0x10000 || value > 0x10FFFF)
+            return 0;
+
+        *code_point = value;
+        return 4;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Encodes a scalar value
+ * @param[in] capacity Number of bytes available at dst
+ * @return Length of the sequence
+ *
+ * @throws EYA_RUNTIME_ERROR_OUT_OF_RANGE
+ *         If the sequence does not fit
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_usize_t
+eya_utf8_encode(eya_uchar_t *dst, eya_usize_t capacity, eya_uint_t code_point)
+{
+    if (code_point < 0x80)
+    {
+        eya_runtime_check(capacity >= 1, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+        dst[0] = (eya_uchar_t)code_point;
+        return 1;
+    }
+
+    if (code_point < 0x800)
+    {
+        eya_runtime_check(capacity >= 2, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+        dst[0] = (eya_uchar_t)(0xC0 | code_point >> 6);
+        dst[1] = (eya_uchar_t)(0x80 | (code_point & 0x3F));
+        return 2;
+    }
+
+    if (code_point < 0x10000)
+    {
+        eya_runtime_check(capacity >= 3, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+        dst[0] = (eya_uchar_t)(0xE0 | code_point >> 12);
+        dst[1] = (eya_uchar_t)(0x80 | (code_point >> 6 & 0x3F));
+        dst[2] = (eya_uchar_t)(0x80 | (code_point & 0x3F));
+        return 3;
+    }
+
+    eya_runtime_check(capacity >= 4, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+    dst[0] = (eya_uchar_t)(0xF0 | code_point >> 18);
+    dst[1] = (eya_uchar_t)(0x80 | (code_point >> 12 & 0x3F));
+    dst[2] = (eya_uchar_t)(0x80 | (code_point >> 6 & 0x3F));
+    dst[3] = (eya_uchar_t)(0x80 | (code_point & 0x3F));
+    return 4;
+}
+
+/**
+ * @brief Writes a scalar value as one unit or a surrogate pair
+ * @return Number of units written
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_usize_t
+eya_utf16_encode(eya_ushort_t *dst, eya_uint_t code_point)
+{
+    if (code_point < 0x10000)
+    {
+        dst[0] = (eya_ushort_t)code_point;
+        return 1;
+    }
+
+    code_point -= 0x10000;
+    dst[0] = (eya_ushort_t)(0xD800 | code_point >> 10);
+    dst[1] = (eya_ushort_t)(0xDC00 | (code_point & 0x3FF));
+    return 2;
+}
+
+/**
+ * @brief Decodes the code point at the start of UTF-16
+ * @param[out] code_point Decoded code point
+ * @return Number of units read
+ *
+ * @throws EYA_RUNTIME_ERROR_INVALID_ARGUMENT
+ *         If the first unit is an unpaired surrogate
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) eya_usize_t
+eya_utf16_decode(const eya_ushort_t *src, eya_usize_t count, eya_uint_t *code_point)
+{
+    const eya_uint_t unit = src[0];
+
+    if ((unit & 0xF800) != 0xD800)
+    {
+        *code_point = unit;
+        return 1;
+    }
+
+    // A high surrogate must be followed by a low one.
+    eya_runtime_check(unit < 0xDC00 && count >= 2 && (src[1] & 0xFC00) == 0xDC00,
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    *code_point = 0x10000 + ((unit - 0xD800) << 10) + (src[1] - 0xDC00u);
+    return 2;
+}
+
+/**
+ * @brief Checks that a UTF-32 unit is neither a surrogate nor above U+10FFFF
+ */
+static EYA_ATTRIBUTE(FORCE_INLINE) bool
+eya_utf32_is_scalar(eya_uint_t unit)
+{
+    return unit <= 0x10FFFF && (unit & 0xFFFFF800) != 0xD800;
+}
+
+/**
+ * @brief Validates one character at a time, skipping words of ASCII
+ */
+static bool
+eya_utf8_is_valid_scalar(const eya_uchar_t *src, eya_usize_t size)
+{
+    while (size)
+    {
+        if (size >= 8 && !(eya_utf8_read64(src) & EYA_UTF8_HIGH_BITS))
+        {
+            src += 8;
+            size -= 8;
+            continue;
+        }
+
+        eya_uint_t        code_point;
+        const eya_usize_t length = eya_utf8_decode(src, size, &code_point);
+
+        if (!length)
+            return false;
+
+        src += length;
+        size -= length;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks a word at a time for a byte with the high bit set
+ */
+static bool
+eya_utf8_is_ascii_scalar(const eya_uchar_t *src, eya_usize_t size)
+{
+    eya_ullong_t bits = 0;
+
+    for (; size >= 8; size -= 8, src += 8)
+        bits |= eya_utf8_read64(src);
+
+    for (; size; --size, ++src)
+        bits |= *src;
+
+    return !(bits & EYA_UTF8_HIGH_BITS);
+}
+
+/**
+ * @brief Counts the characters of valid UTF-8 a word at a time
+ * @param[out] long_count Number of four-byte characters
+ * @return Number of characters
+ */
+static eya_usize_t
+eya_utf8_count_scalar(const eya_uchar_t *src, eya_usize_t size, eya_usize_t *long_count)
+{
+    eya_usize_t continuations = 0;
+    eya_usize_t longs         = 0;
+    eya_usize_t total         = size;
+
+    for (; size >= 8; size -= 8, src += 8)
+    {
+        const eya_ullong_t word = eya_utf8_read64(src);
+
+        // Continuation bytes are 10xxxxxx, four-byte leads 11110xxx; the shifts line
+        // bits 6 to 4 of each byte up with its bit 7.
+        const eya_ullong_t continuation = word & ~(word << 1) & EYA_UTF8_HIGH_BITS;
+        const eya_ullong_t lead =
+            word & word << 1 & word << 2 & word << 3 & EYA_UTF8_HIGH_BITS;
+
+        // Moving the flags to bit 0 and multiplying sums the bytes into the top byte.
+        continuations += (eya_usize_t)(((continuation >> 7) * 0x0101010101010101ULL) >> 56);
+        longs += (eya_usize_t)(((lead >> 7) * 0x0101010101010101ULL) >> 56);
+    }
+
+    for (; size; --size, ++src)
+    {
+        continuations += (*src & 0xC0) == 0x80;
+        longs += *src >= 0xF0;
+    }
+
+    *long_count = longs;
+    return total - continuations;
+}
+
+/**
+ * @brief Widens a run of ASCII to UTF-16 one byte at a time
+ * @return Number of bytes converted, which stops at the first other byte
+ */
+static eya_usize_t
+eya_utf8_widen16_scalar(eya_ushort_t *dst, const eya_uchar_t *src, eya_usize_t size)
+{
+    eya_usize_t i = 0;
+
+    for (; i < size && src[i] < 0x80; ++i)
+        dst[i] = src[i];
+
+    return i;
+}
+
+/**
+ * @brief Widens a run of ASCII to UTF-32 one byte at a time
+ * @return Number of bytes converted, which stops at the first other byte
+ */
+static eya_usize_t
+eya_utf8_widen32_scalar(eya_uint_t *dst, const eya_uchar_t *src, eya_usize_t size)
+{
+    eya_usize_t i = 0;
+
+    for (; i < size && src[i] < 0x80; ++i)
+        dst[i] = src[i];
+
+    return i;
+}
+
+/**
+ * @brief Narrows a run of ASCII from UTF-16 one unit at a time
+ * @return Number of units converted, which stops at the first other unit
+ */
+static eya_usize_t
+eya_utf16_narrow_scalar(eya_uchar_t *dst, const eya_ushort_t *src, eya_usize_t size)
+{
+    eya_usize_t i = 0;
+
+    for (; i < size && src[i] < 0x80; ++i)
+        dst[i] = (eya_uchar_t)src[i];
+
+    return i;
+}
+
+/**
+ * @brief Narrows a run of ASCII from UTF-32 one unit at a time
+ * @return Number of units converted, which stops at the first other unit
+ */
+static eya_usize_t
+eya_utf32_narrow_scalar(eya_uchar_t *dst, const eya_uint_t *src, eya_usize_t size)
+{
+    eya_usize_t i = 0;
+
+    for (; i < size && src[i] < 0x80; ++i)
+        dst[i] = (eya_uchar_t)src[i];
+
+    return i;
+}
+
+#if (EYA_UTF8_X86)
+/**
+ * @brief Error flags of the lookup tables
+ *
+ * A flag set in all three lookups of a byte marks an invalid pattern made
+ * by the byte and the one before it.
+ */
+enum
+{
+    EYA_UTF8_TOO_SHORT      = 1 << 0, // Lead followed by a lead or ASCII
+    EYA_UTF8_TOO_LONG       = 1 << 1, // ASCII followed by a continuation
+    EYA_UTF8_OVERLONG_3     = 1 << 2, // E0 followed by 80..9F
+    EYA_UTF8_TOO_LARGE      = 1 << 3, // F4 followed by 90..BF
+    EYA_UTF8_SURROGATE      = 1 << 4, // ED followed by A0..BF
+    EYA_UTF8_OVERLONG_2     = 1 << 5, // C0 or C1
+    EYA_UTF8_TOO_LARGE_1000 = 1 << 6, // F5..FF
+    EYA_UTF8_OVERLONG_4     = 1 << 6, // F0 followed by 80..8F
+    EYA_UTF8_TWO_CONTS      = 1 << 7, // Two continuations, valid only inside a sequence
+    EYA_UTF8_CARRY          = EYA_UTF8_TOO_SHORT | EYA_UTF8_TOO_LONG | EYA_UTF8_TWO_CONTS
+};
+
+/**
+ * @brief Flags by the high nibble of the previous byte
+ */
+static const eya_uchar_t eya_utf8_byte_1_high[16] = {
+    EYA_UTF8_TOO_LONG,
+    EYA_UTF8_TOO_LONG,
+    EYA_UTF8_TOO_LONG,
+    EYA_UTF8_TOO_LONG,
+    EYA_UTF8_TOO_LONG,
+    EYA_UTF8_TOO_LONG,
+    EYA_UTF8_TOO_LONG,
+    EYA_UTF8_TOO_LONG,
+    EYA_UTF8_TWO_CONTS,
+    EYA_UTF8_TWO_CONTS,
+    EYA_UTF8_TWO_CONTS,
+    EYA_UTF8_TWO_CONTS,
+    EYA_UTF8_TOO_SHORT | EYA_UTF8_OVERLONG_2,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT | EYA_UTF8_OVERLONG_3 | EYA_UTF8_SURROGATE,
+    EYA_UTF8_TOO_SHORT | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000 | EYA_UTF8_OVERLONG_4,
+};
+
+/**
+ * @brief Flags by the low nibble of the previous byte
+ */
+static const eya_uchar_t eya_utf8_byte_1_low[16] = {
+    EYA_UTF8_CARRY | EYA_UTF8_OVERLONG_3 | EYA_UTF8_OVERLONG_2 | EYA_UTF8_OVERLONG_4,
+    EYA_UTF8_CARRY | EYA_UTF8_OVERLONG_2,
+    EYA_UTF8_CARRY,
+    EYA_UTF8_CARRY,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000 | EYA_UTF8_SURROGATE,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000,
+    EYA_UTF8_CARRY | EYA_UTF8_TOO_LARGE | EYA_UTF8_TOO_LARGE_1000,
+};
+
+/**
+ * @brief Flags by the high nibble of the current byte
+ */
+static const eya_uchar_t eya_utf8_byte_2_high[16] = {
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_LONG | EYA_UTF8_OVERLONG_2 | EYA_UTF8_TWO_CONTS | EYA_UTF8_OVERLONG_3 |
+        EYA_UTF8_TOO_LARGE_1000 | EYA_UTF8_OVERLONG_4,
+    EYA_UTF8_TOO_LONG | EYA_UTF8_OVERLONG_2 | EYA_UTF8_TWO_CONTS | EYA_UTF8_OVERLONG_3 |
+        EYA_UTF8_TOO_LARGE,
+    EYA_UTF8_TOO_LONG | EYA_UTF8_OVERLONG_2 | EYA_UTF8_TWO_CONTS | EYA_UTF8_SURROGATE |
+        EYA_UTF8_TOO_LARGE,
+    EYA_UTF8_TOO_LONG | EYA_UTF8_OVERLONG_2 | EYA_UTF8_TWO_CONTS | EYA_UTF8_SURROGATE |
+        EYA_UTF8_TOO_LARGE,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT,
+    EYA_UTF8_TOO_SHORT,
+};
+
+/**
+ * @brief Largest value of each byte at the end of a block that does not start
+ *        a sequence continuing into the next block
+ */
+static const eya_uchar_t eya_utf8_incomplete_max[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+};
+
+/**
+ * @brief Shuffles moving the bytes selected by a mask of 8 bits to the front
+ */
+static eya_uchar_t eya_utf8_pack8[256][8];
+
+/**
+ * @brief Shuffles moving the 16-bit lanes selected by a mask of 8 bits to the front
+ */
+static eya_uchar_t eya_utf8_pack16[256][16];
+
+/**
+ * @brief Number of bits set in each byte
+ */
+static eya_uchar_t eya_utf8_bit_count[256];
+
+/**
+ * @brief Shifts the bytes of a block n places up, filling in the last bytes
+ *        of the previous block
+ */
+#    define EYA_UTF8_PREV(input, prev, n)                                                          \
+        _mm256_alignr_epi8((input), _mm256_permute2x128_si256((prev), (input), 0x21), 16 - (n))
+
+/**
+ * @brief State carried from one block of the validation to the next
+ */
+typedef struct eya_utf8_checker
+{
+    __m256i error;      ///< Flags of all errors found so far
+    __m256i prev;       ///< Previous block
+    __m256i incomplete; ///< Bytes of the previous block starting a sequence left open
+} eya_utf8_checker_t;
+
+/**
+ * @brief Loads a 16-entry table into both lanes
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static __m256i
+eya_utf8_table256(const eya_uchar_t *table)
+{
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)table));
+}
+
+/**
+ * @brief Checks a block holding a byte with the high bit set
+ * @return Non-zero bytes where the block is invalid
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static __m256i
+eya_utf8_check256(__m256i input, __m256i prev)
+{
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    const __m256i prev1    = EYA_UTF8_PREV(input, prev, 1);
+
+    const __m256i byte_1_high = _mm256_shuffle_epi8(
+        eya_utf8_table256(eya_utf8_byte_1_high),
+        _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_mask));
+    const __m256i byte_1_low = _mm256_shuffle_epi8(eya_utf8_table256(eya_utf8_byte_1_low),
+                                                   _mm256_and_si256(prev1, low_mask));
+    const __m256i byte_2_high = _mm256_shuffle_epi8(
+        eya_utf8_table256(eya_utf8_byte_2_high),
+        _mm256_and_si256(_mm256_srli_epi16(input, 4), low_mask));
+
+    const __m256i special =
+        _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // A continuation two or three bytes after a lead of a three- or four-byte sequence
+    // is expected; everywhere else two continuations in a row are an error.
+    const __m256i prev2  = EYA_UTF8_PREV(input, prev, 2);
+    const __m256i prev3  = EYA_UTF8_PREV(input, prev, 3);
+    const __m256i third  = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+    const __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80));
+    const __m256i must23 = _mm256_or_si256(third, fourth);
+
+    return _mm256_xor_si256(_mm256_and_si256(must23, _mm256_set1_epi8((char)0x80)), special);
+}
+
+/**
+ * @brief Checks the next block of 32 bytes
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static void
+eya_utf8_check_next256(eya_utf8_checker_t *checker, __m256i input)
+{
+    if (_mm256_movemask_epi8(input))
+    {
+        checker->error = _mm256_or_si256(checker->error, eya_utf8_check256(input, checker->prev));
+        checker->incomplete = _mm256_subs_epu8(
+            input, _mm256_loadu_si256((const __m256i *)eya_utf8_incomplete_max));
+    }
+    else
+    {
+        // A block of ASCII cannot finish a sequence started before it.
+        checker->error      = _mm256_or_si256(checker->error, checker->incomplete);
+        checker->incomplete = _mm256_setzero_si256();
+    }
+
+    checker->prev = input;
+}
+
+/**
+ * @brief Validates 32 bytes per step with the lookup algorithm
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static bool
+eya_utf8_is_valid_avx2(const eya_uchar_t *src, eya_usize_t size)
+{
+    eya_utf8_checker_t checker;
+
+    checker.error      = _mm256_setzero_si256();
+    checker.prev       = _mm256_setzero_si256();
+    checker.incomplete = _mm256_setzero_si256();
+
+    for (; size >= 32; size -= 32, src += 32)
+        eya_utf8_check_next256(&checker, _mm256_loadu_si256((const __m256i *)src));
+
+    if (size)
+    {
+        // Zeros after the tail are ASCII, which no sequence may be left open before.
+        eya_uchar_t block[32] = {0};
+
+        for (eya_usize_t i = 0; i < size; ++i)
+            block[i] = src[i];
+
+        eya_utf8_check_next256(&checker, _mm256_loadu_si256((const __m256i *)block));
+    }
+
+    checker.error = _mm256_or_si256(checker.error, checker.incomplete);
+    return _mm256_testz_si256(checker.error, checker.error);
+}
+
+/**
+ * @brief Checks 128 bytes per step for a byte with the high bit set
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static bool
+eya_utf8_is_ascii_avx2(const eya_uchar_t *src, eya_usize_t size)
+{
+    __m256i bits = _mm256_setzero_si256();
+
+    for (; size >= 128; size -= 128, src += 128)
+    {
+        const __m256i first  = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)src),
+                                              _mm256_loadu_si256((const __m256i *)(src + 32)));
+        const __m256i second = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(src + 64)),
+                                               _mm256_loadu_si256((const __m256i *)(src + 96)));
+
+        bits = _mm256_or_si256(bits, _mm256_or_si256(first, second));
+    }
+
+    return !_mm256_movemask_epi8(bits) && eya_utf8_is_ascii_scalar(src, size);
+}
+
+/**
+ * @brief Counts the characters of valid UTF-8 32 bytes per step
+ * @param[out] long_count Number of four-byte characters
+ * @return Number of characters
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static eya_usize_t
+eya_utf8_count_avx2(const eya_uchar_t *src, eya_usize_t size, eya_usize_t *long_count)
+{
+    const __m256i zero          = _mm256_setzero_si256();
+    const __m256i last_continue = _mm256_set1_epi8(-65);
+    const __m256i first_long    = _mm256_set1_epi8((char)0xF0);
+
+    __m256i chars = zero;
+    __m256i longs = zero;
+
+    while (size >= 32)
+    {
+        // The byte counters take at most 255 blocks before they are summed.
+        eya_usize_t blocks = size / 32 < 255 ? size / 32 : 255;
+        __m256i     chars8 = zero;
+        __m256i     longs8 = zero;
+
+        for (size -= 32 * blocks; blocks; --blocks, src += 32)
+        {
+            const __m256i in = _mm256_loadu_si256((const __m256i *)src);
+
+            // As signed bytes, continuations are -128 to -65 and four-byte leads the
+            // bytes left unchanged by an unsigned maximum with 0xF0.
+            chars8 = _mm256_sub_epi8(chars8, _mm256_cmpgt_epi8(in, last_continue));
+            longs8 = _mm256_sub_epi8(longs8,
+                                     _mm256_cmpeq_epi8(_mm256_max_epu8(in, first_long), in));
+        }
+
+        chars = _mm256_add_epi64(chars, _mm256_sad_epu8(chars8, zero));
+        longs = _mm256_add_epi64(longs, _mm256_sad_epu8(longs8, zero));
+    }
+
+    eya_usize_t       tail_longs;
+    const eya_usize_t tail_chars = eya_utf8_count_scalar(src, size, &tail_longs);
+
+    *long_count = tail_longs + (eya_usize_t)_mm256_extract_epi64(longs, 0) +
+                  (eya_usize_t)_mm256_extract_epi64(longs, 1) +
+                  (eya_usize_t)_mm256_extract_epi64(longs, 2) +
+                  (eya_usize_t)_mm256_extract_epi64(longs, 3);
+
+    return tail_chars + (eya_usize_t)_mm256_extract_epi64(chars, 0) +
+           (eya_usize_t)_mm256_extract_epi64(chars, 1) +
+           (eya_usize_t)_mm256_extract_epi64(chars, 2) +
+           (eya_usize_t)_mm256_extract_epi64(chars, 3);
+}
+
+/**
+ * @brief Shifts the 16-bit lanes of a vector n places up, filling in zeros
+ */
+#    define EYA_UTF8_SHIFT16(x, n) EYA_UTF8_PREV((x), _mm256_setzero_si256(), 2 * (n))
+
+/**
+ * @brief Decodes the characters of up to three bytes ending in the first 15
+ *        bytes of a block of valid UTF-8
+ * @param[out] ends Bit j set where a character ends at byte j
+ * @return Code point of the character ending at each byte, in 16-bit lanes
+ *
+ * The block must start at a character. Decoding stops before the first
+ * four-byte character, so @p ends is 0 if the block starts with one.
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static __m256i
+eya_utf8_decode256(__m128i bytes, eya_uint_t *ends)
+{
+    const __m256i high_bits = _mm256_set1_epi16(0xC0);
+    const __m256i in        = _mm256_cvtepu8_epi16(bytes);
+    const __m256i non_ascii = _mm256_cmpgt_epi16(in, _mm256_set1_epi16(0x7F));
+    const __m256i continues =
+        _mm256_cmpeq_epi16(_mm256_and_si256(in, high_bits), _mm256_set1_epi16(0x80));
+
+    // Clearing the two high bits of all but ASCII leaves the payload of each byte; the lead
+    // of a three-byte character keeps bit 5, which the shift by 12 pushes out of the lane.
+    const __m256i payload = _mm256_andnot_si256(_mm256_and_si256(non_ascii, high_bits), in);
+
+    // A continuation takes in the payload before it, a second one the payload before that.
+    const __m256i second = _mm256_and_si256(
+        continues, _mm256_slli_epi16(EYA_UTF8_SHIFT16(payload, 1), 6));
+    const __m256i third = _mm256_and_si256(
+        _mm256_and_si256(continues, EYA_UTF8_SHIFT16(continues, 1)),
+        _mm256_slli_epi16(EYA_UTF8_SHIFT16(payload, 2), 12));
+
+    // As signed bytes, continuations are below -64.
+    const eya_uint_t continuations =
+        (eya_uint_t)_mm_movemask_epi8(_mm_cmplt_epi8(bytes, _mm_set1_epi8(-64)));
+    const eya_uint_t longs = (eya_uint_t)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_max_epu8(bytes, _mm_set1_epi8((char)0xF0)), bytes));
+
+    // A character ends before a byte that does not continue it.
+    *ends = ~(continuations >> 1) & 0x7FFF;
+    if (longs)
+        *ends &= (longs & (0u - longs)) - 1;
+
+    return _mm256_or_si256(_mm256_or_si256(payload, second), third);
+}
+
+/**
+ * @brief Converts valid UTF-8 to UTF-16, 32 bytes of ASCII or up to 16 bytes
+ *        of other characters per step
+ * @param[out] written Number of units written
+ * @return Number of bytes converted
+ *
+ * The vector steps store whole registers past the characters they convert.
+ * Stopping with 32 bytes of source and 32 units of room left makes sure
+ * the characters that follow overwrite them and none leave the destination.
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static eya_usize_t
+eya_utf8_to_utf16_avx2(eya_ushort_t      *dst,
+                       eya_usize_t        capacity,
+                       const eya_uchar_t *src,
+                       eya_usize_t        size,
+                       eya_usize_t       *written)
+{
+    eya_usize_t i = 0;
+    eya_usize_t w = 0;
+
+    while (size - i >= 48 && capacity - w >= 32)
+    {
+        const __m256i in = _mm256_loadu_si256((const __m256i *)(src + i));
+
+        if (!_mm256_movemask_epi8(in))
+        {
+            _mm256_storeu_si256((__m256i *)(dst + w),
+                                _mm256_cvtepu8_epi16(_mm256_castsi256_si128(in)));
+            _mm256_storeu_si256((__m256i *)(dst + w + 16),
+                                _mm256_cvtepu8_epi16(_mm256_extracti128_si256(in, 1)));
+            i += 32;
+            w += 32;
+            continue;
+        }
+
+        eya_uint_t    ends;
+        const __m256i values = eya_utf8_decode256(_mm256_castsi256_si128(in), &ends);
+
+        if (!ends)
+        {
+            eya_uint_t code_point;
+
+            i += eya_utf8_decode(src + i, size - i, &code_point);
+            w += eya_utf16_encode(dst + w, code_point);
+            continue;
+        }
+
+        const eya_uint_t low  = ends & 0xFF;
+        const eya_uint_t high = ends >> 8;
+        unsigned long    last;
+
+        _mm_storeu_si128((__m128i *)(dst + w),
+                         _mm_shuffle_epi8(_mm256_castsi256_si128(values),
+                                          _mm_loadu_si128((const __m128i *)eya_utf8_pack16[low])));
+        w += eya_utf8_bit_count[low];
+
+        _mm_storeu_si128((__m128i *)(dst + w),
+                         _mm_shuffle_epi8(_mm256_extracti128_si256(values, 1),
+                                          _mm_loadu_si128((const __m128i *)eya_utf8_pack16[high])));
+        w += eya_utf8_bit_count[high];
+
+        eya_bit_scan_reverse32(&last, ends);
+        i += (eya_usize_t)last + 1;
+    }
+
+    *written = w;
+    return i;
+}
+
+/**
+ * @brief Converts valid UTF-8 to UTF-32, 32 bytes of ASCII or up to 16 bytes
+ *        of other characters per step
+ * @param[out] written Number of units written
+ * @return Number of bytes converted
+ *
+ * Stops early for the same reason as @ref eya_utf8_to_utf16_avx2().
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static eya_usize_t
+eya_utf8_to_utf32_avx2(eya_uint_t        *dst,
+                       eya_usize_t        capacity,
+                       const eya_uchar_t *src,
+                       eya_usize_t        size,
+                       eya_usize_t       *written)
+{
+    eya_usize_t i = 0;
+    eya_usize_t w = 0;
+
+    while (size - i >= 48 && capacity - w >= 32)
+    {
+        const __m256i in = _mm256_loadu_si256((const __m256i *)(src + i));
+
+        if (!_mm256_movemask_epi8(in))
+        {
+            const __m128i low  = _mm256_castsi256_si128(in);
+            const __m128i high = _mm256_extracti128_si256(in, 1);
+
+            _mm256_storeu_si256((__m256i *)(dst + w), _mm256_cvtepu8_epi32(low));
+            _mm256_storeu_si256((__m256i *)(dst + w + 8),
+                                _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+            _mm256_storeu_si256((__m256i *)(dst + w + 16), _mm256_cvtepu8_epi32(high));
+            _mm256_storeu_si256((__m256i *)(dst + w + 24),
+                                _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+            i += 32;
+            w += 32;
+            continue;
+        }
+
+        eya_uint_t    ends;
+        const __m256i values = eya_utf8_decode256(_mm256_castsi256_si128(in), &ends);
+
+        if (!ends)
+        {
+            i += eya_utf8_decode(src + i, size - i, dst + w);
+            ++w;
+            continue;
+        }
+
+        const eya_uint_t low  = ends & 0xFF;
+        const eya_uint_t high = ends >> 8;
+        unsigned long    last;
+
+        _mm256_storeu_si256(
+            (__m256i *)(dst + w),
+            _mm256_cvtepu16_epi32(_mm_shuffle_epi8(
+                _mm256_castsi256_si128(values),
+                _mm_loadu_si128((const __m128i *)eya_utf8_pack16[low]))));
+        w += eya_utf8_bit_count[low];
+
+        _mm256_storeu_si256(
+            (__m256i *)(dst + w),
+            _mm256_cvtepu16_epi32(_mm_shuffle_epi8(
+                _mm256_extracti128_si256(values, 1),
+                _mm_loadu_si128((const __m128i *)eya_utf8_pack16[high]))));
+        w += eya_utf8_bit_count[high];
+
+        eya_bit_scan_reverse32(&last, ends);
+        i += (eya_usize_t)last + 1;
+    }
+
+    *written = w;
+    return i;
+}
+
+/**
+ * @brief Encodes up to 16 code points below U+0800, stopping at the first other one
+ * @param[in] units Code points in 16-bit lanes
+ * @param[out] consumed Number of code points encoded
+ * @return Number of bytes written; up to 32 bytes are stored
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static eya_usize_t
+eya_utf8_encode256(eya_uchar_t *dst, __m256i units, eya_usize_t *consumed)
+{
+    const __m256i ascii =
+        _mm256_cmpeq_epi16(_mm256_min_epu16(units, _mm256_set1_epi16(0x7F)), units);
+    const __m256i two_bytes =
+        _mm256_cmpeq_epi16(_mm256_min_epu16(units, _mm256_set1_epi16(0x7FF)), units);
+
+    // The lead in the low byte and the continuation in the high byte, or the ASCII byte alone.
+    const __m256i pairs = _mm256_or_si256(
+        _mm256_or_si256(_mm256_srli_epi16(units, 6),
+                        _mm256_slli_epi16(_mm256_and_si256(units, _mm256_set1_epi16(0x3F)), 8)),
+        _mm256_set1_epi16((short)0x80C0));
+    const __m256i bytes = _mm256_blendv_epi8(pairs, units, ascii);
+
+    // Two mask bits per code point: the first byte is always kept, the second one for
+    // a two-byte sequence, and nothing from the first code point of three bytes or more.
+    const eya_uint_t longs = ~(eya_uint_t)_mm256_movemask_epi8(two_bytes);
+    eya_uint_t       keep  = ~((eya_uint_t)_mm256_movemask_epi8(ascii) & 0xAAAAAAAAu);
+    unsigned long    first;
+
+    if (longs)
+    {
+        keep &= (longs & (0u - longs)) - 1;
+        eya_bit_scan_forward32(&first, longs);
+        *consumed = (eya_usize_t)first / 2;
+    }
+    else
+        *consumed = 16;
+
+    const __m128i low   = _mm256_castsi256_si128(bytes);
+    const __m128i high  = _mm256_extracti128_si256(bytes, 1);
+    const __m128i parts[4] = {low, _mm_srli_si128(low, 8), high, _mm_srli_si128(high, 8)};
+    eya_usize_t   n        = 0;
+
+    for (eya_usize_t part = 0; part < 4; ++part, keep >>= 8)
+    {
+        const eya_uint_t mask = keep & 0xFF;
+
+        _mm_storel_epi64((__m128i *)(dst + n),
+                         _mm_shuffle_epi8(parts[part],
+                                          _mm_loadl_epi64((const __m128i *)eya_utf8_pack8[mask])));
+        n += eya_utf8_bit_count[mask];
+    }
+
+    return n;
+}
+
+/**
+ * @brief Stores 32 ASCII code points given in the 16-bit lanes of two vectors
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static void
+eya_utf8_store_ascii256(eya_uchar_t *dst, __m256i first, __m256i second)
+{
+    _mm256_storeu_si256((__m256i *)dst,
+                        _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xD8));
+}
+
+/**
+ * @brief Converts UTF-16 to UTF-8, 32 units of ASCII or up to 16 units below
+ *        U+0800 per step
+ * @param[out] written Number of bytes written
+ * @return Number of units converted
+ *
+ * Stops early for the same reason as @ref eya_utf8_to_utf16_avx2().
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static eya_usize_t
+eya_utf16_to_utf8_avx2(eya_uchar_t        *dst,
+                       eya_usize_t         capacity,
+                       const eya_ushort_t *src,
+                       eya_usize_t         count,
+                       eya_usize_t        *written)
+{
+    const __m256i non_ascii = _mm256_set1_epi16((short)0xFF80);
+    eya_usize_t   i         = 0;
+    eya_usize_t   w         = 0;
+
+    while (count - i >= 32 && capacity - w >= 32)
+    {
+        if (src[i] >= 0x800)
+        {
+            eya_uint_t code_point;
+
+            i += eya_utf16_decode(src + i, count - i, &code_point);
+            w += eya_utf8_encode(dst + w, capacity - w, code_point);
+            continue;
+        }
+
+        const __m256i first  = _mm256_loadu_si256((const __m256i *)(src + i));
+        const __m256i second = _mm256_loadu_si256((const __m256i *)(src + i + 16));
+
+        if (_mm256_testz_si256(_mm256_or_si256(first, second), non_ascii))
+        {
+            eya_utf8_store_ascii256(dst + w, first, second);
+            i += 32;
+            w += 32;
+            continue;
+        }
+
+        eya_usize_t consumed;
+        w += eya_utf8_encode256(dst + w, first, &consumed);
+        i += consumed;
+    }
+
+    *written = w;
+    return i;
+}
+
+/**
+ * @brief Converts UTF-32 to UTF-8, 32 units of ASCII or up to 16 units below
+ *        U+0800 per step
+ * @param[out] written Number of bytes written
+ * @return Number of units converted
+ *
+ * Stops early for the same reason as @ref eya_utf8_to_utf16_avx2().
+ */
+EYA_ATTRIBUTE(TARGET("avx2"))
+static eya_usize_t
+eya_utf32_to_utf8_avx2(eya_uchar_t      *dst,
+                       eya_usize_t       capacity,
+                       const eya_uint_t *src,
+                       eya_usize_t       count,
+                       eya_usize_t      *written)
+{
+    const __m256i max       = _mm256_set1_epi32(0xFFFF);
+    const __m256i non_ascii = _mm256_set1_epi16((short)0xFF80);
+    eya_usize_t   i         = 0;
+    eya_usize_t   w         = 0;
+
+    while (count - i >= 32 && capacity - w >= 32)
+    {
+        if (src[i] >= 0x800)
+        {
+            eya_runtime_check(eya_utf32_is_scalar(src[i]), EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+            w += eya_utf8_encode(dst + w, capacity - w, src[i++]);
+            continue;
+        }
+
+        // Clamping to 0xFFFF keeps the signed packs exact and every large unit at
+        // U+0800 or above, where encoding stops.
+        __m256i units[4];
+        for (eya_usize_t part = 0; part < 4; ++part)
+            units[part] = _mm256_min_epu32(
+                _mm256_loadu_si256((const __m256i *)(src + i + 8 * part)), max);
+
+        const __m256i first =
+            _mm256_permute4x64_epi64(_mm256_packus_epi32(units[0], units[1]), 0xD8);
+        const __m256i second =
+            _mm256_permute4x64_epi64(_mm256_packus_epi32(units[2], units[3]), 0xD8);
+
+        if (_mm256_testz_si256(_mm256_or_si256(first, second), non_ascii))
+        {
+            eya_utf8_store_ascii256(dst + w, first, second);
+            i += 32;
+            w += 32;
+            continue;
+        }
+
+        eya_usize_t consumed;
+        w += eya_utf8_encode256(dst + w, first, &consumed);
+        i += consumed;
+    }
+
+    *written = w;
+    return i;
+}
+#endif
+
+/**
+ * @brief Builds the tables and selects the implementation when the library is loaded
+ */
+eya_compiler_constructor(eya_utf8_init)
+{
+#if (EYA_UTF8_X86)
+    for (eya_uint_t mask = 0; mask < 256; ++mask)
+    {
+        eya_uchar_t count = 0;
+
+        for (eya_uchar_t bit = 0; bit < 8; ++bit)
+        {
+            if (!(mask >> bit & 1))
+                continue;
+
+            eya_utf8_pack8[mask][count]          = bit;
+            eya_utf8_pack16[mask][2 * count]     = (eya_uchar_t)(2 * bit);
+            eya_utf8_pack16[mask][2 * count + 1] = (eya_uchar_t)(2 * bit + 1);
+            ++count;
+        }
+
+        eya_utf8_bit_count[mask] = count;
+    }
+#endif
+
+    eya_utf8_set_cpu_features(EYA_UINT_T_MAX);
+}
+
+void
+eya_utf8_set_cpu_features(eya_uint_t features)
+{
+#if (EYA_UTF8_X86)
+    eya_utf8_has_avx2 = (features & eya_cpu_get_features() & EYA_CPU_FEATURE_AVX2) != 0;
+#else
+    (void)features;
+#endif
+}
+
+/**
+ * @brief Validates with the selected implementation
+ */
+static bool
+eya_utf8_is_valid_block(const eya_uchar_t *src, eya_usize_t size)
+{
+#if (EYA_UTF8_X86)
+    if (eya_utf8_has_avx2)
+        return eya_utf8_is_valid_avx2(src, size);
+#endif
+
+    return eya_utf8_is_valid_scalar(src, size);
+}
+
+/**
+ * @brief Checks for ASCII with the selected implementation
+ */
+static bool
+eya_utf8_is_ascii_block(const eya_uchar_t *src, eya_usize_t size)
+{
+#if (EYA_UTF8_X86)
+    if (eya_utf8_has_avx2)
+        return eya_utf8_is_ascii_avx2(src, size);
+#endif
+
+    return eya_utf8_is_ascii_scalar(src, size);
+}
+
+/**
+ * @brief Counts characters with the selected implementation
+ */
+static eya_usize_t
+eya_utf8_count_block(const eya_uchar_t *src, eya_usize_t size, eya_usize_t *long_count)
+{
+#if (EYA_UTF8_X86)
+    if (eya_utf8_has_avx2)
+        return eya_utf8_count_avx2(src, size, long_count);
+#endif
+
+    return eya_utf8_count_scalar(src, size, long_count);
+}
+
+/**
+ * @brief Returns the number of units of a UTF-16 or UTF-32 range
+ *
+ * @throws EYA_RUNTIME_ERROR_SIZE_NOT_MULTIPLE_OF_ELEMENT_SIZE
+ *         If the size of the range is not a multiple of the unit size
+ */
+static eya_usize_t
+eya_utf8_unit_count(const eya_memory_range_t *range, eya_usize_t unit_size)
+{
+    const eya_usize_t size = eya_memory_range_get_size(range);
+
+    eya_runtime_check(!(size % unit_size), EYA_RUNTIME_ERROR_SIZE_NOT_MULTIPLE_OF_ELEMENT_SIZE);
+    return size / unit_size;
+}
+
+bool
+eya_utf8_is_valid(const eya_memory_range_t *src)
+{
+    return eya_utf8_is_valid_block(eya_memory_range_get_begin(src),
+                                   eya_memory_range_get_size(src));
+}
+
+bool
+eya_utf8_is_ascii(const eya_memory_range_t *src)
+{
+    return eya_utf8_is_ascii_block(eya_memory_range_get_begin(src),
+                                   eya_memory_range_get_size(src));
+}
+
+eya_usize_t
+eya_utf8_utf16_size(const eya_memory_range_t *src)
+{
+    eya_usize_t       long_count;
+    const eya_usize_t count = eya_utf8_count_block(
+        eya_memory_range_get_begin(src), eya_memory_range_get_size(src), &long_count);
+
+    // Characters above U+FFFF take a surrogate pair.
+    return count + long_count;
+}
+
+eya_usize_t
+eya_utf8_utf32_size(const eya_memory_range_t *src)
+{
+    eya_usize_t long_count;
+    return eya_utf8_count_block(
+        eya_memory_range_get_begin(src), eya_memory_range_get_size(src), &long_count);
+}
+
+eya_usize_t
+eya_utf8_to_utf16(const eya_memory_range_t *dst, const eya_memory_range_t *src)
+{
+    const eya_uchar_t *in   = eya_memory_range_get_begin(src);
+    eya_usize_t        size = eya_memory_range_get_size(src);
+
+    eya_runtime_check(eya_memory_range_is_aligned(dst, sizeof(eya_ushort_t)),
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    eya_ushort_t     *out      = eya_memory_range_get_begin(dst);
+    const eya_usize_t capacity = eya_memory_range_get_size(dst) / sizeof(eya_ushort_t);
+    eya_usize_t       written  = 0;
+
+#if (EYA_UTF8_X86)
+    if (eya_utf8_has_avx2)
+    {
+        // The vector loop decodes without checks.
+        eya_runtime_check(eya_utf8_is_valid_avx2(in, size), EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+        const eya_usize_t consumed = eya_utf8_to_utf16_avx2(out, capacity, in, size, &written);
+        in += consumed;
+        size -= consumed;
+    }
+#endif
+
+    while (size)
+    {
+        if (*in < 0x80)
+        {
+            const eya_usize_t room = capacity - written;
+            eya_runtime_check(room, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+            const eya_usize_t ascii =
+                eya_utf8_widen16_scalar(out + written, in, size < room ? size : room);
+            in += ascii;
+            size -= ascii;
+            written += ascii;
+            continue;
+        }
+
+        eya_uint_t        code_point;
+        const eya_usize_t length = eya_utf8_decode(in, size, &code_point);
+
+        eya_runtime_check(length, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+        eya_runtime_check(capacity - written >= 1u + (code_point >= 0x10000),
+                          EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+        in += length;
+        size -= length;
+        written += eya_utf16_encode(out + written, code_point);
+    }
+
+    return written;
+}
+
+eya_usize_t
+eya_utf8_to_utf32(const eya_memory_range_t *dst, const eya_memory_range_t *src)
+{
+    const eya_uchar_t *in   = eya_memory_range_get_begin(src);
+    eya_usize_t        size = eya_memory_range_get_size(src);
+
+    eya_runtime_check(eya_memory_range_is_aligned(dst, sizeof(eya_uint_t)),
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    eya_uint_t       *out      = eya_memory_range_get_begin(dst);
+    const eya_usize_t capacity = eya_memory_range_get_size(dst) / sizeof(eya_uint_t);
+    eya_usize_t       written  = 0;
+
+#if (EYA_UTF8_X86)
+    if (eya_utf8_has_avx2)
+    {
+        // The vector loop decodes without checks.
+        eya_runtime_check(eya_utf8_is_valid_avx2(in, size), EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+        const eya_usize_t consumed = eya_utf8_to_utf32_avx2(out, capacity, in, size, &written);
+        in += consumed;
+        size -= consumed;
+    }
+#endif
+
+    while (size)
+    {
+        if (*in < 0x80)
+        {
+            const eya_usize_t room = capacity - written;
+            eya_runtime_check(room, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+            const eya_usize_t ascii =
+                eya_utf8_widen32_scalar(out + written, in, size < room ? size : room);
+            in += ascii;
+            size -= ascii;
+            written += ascii;
+            continue;
+        }
+
+        eya_uint_t        code_point;
+        const eya_usize_t length = eya_utf8_decode(in, size, &code_point);
+
+        eya_runtime_check(length, EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+        eya_runtime_check(written < capacity, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+        in += length;
+        size -= length;
+        out[written++] = code_point;
+    }
+
+    return written;
+}
+
+eya_usize_t
+eya_utf16_utf8_size(const eya_memory_range_t *src)
+{
+    const eya_ushort_t *in    = eya_memory_range_get_begin(src);
+    const eya_usize_t   count = eya_utf8_unit_count(src, sizeof(eya_ushort_t));
+    eya_usize_t         size  = count;
+
+    // Each surrogate of a pair counts two bytes, four for the pair.
+    for (eya_usize_t i = 0; i < count; ++i)
+        size += (in[i] >= 0x80) + (in[i] >= 0x800) - ((in[i] & 0xF800) == 0xD800);
+
+    return size;
+}
+
+eya_usize_t
+eya_utf16_to_utf8(const eya_memory_range_t *dst, const eya_memory_range_t *src)
+{
+    const eya_usize_t count = eya_utf8_unit_count(src, sizeof(eya_ushort_t));
+
+    eya_runtime_check(eya_memory_range_is_aligned(src, sizeof(eya_ushort_t)),
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    const eya_ushort_t *in       = eya_memory_range_get_begin(src);
+    eya_uchar_t        *out      = eya_memory_range_get_begin(dst);
+    const eya_usize_t   capacity = eya_memory_range_get_size(dst);
+    eya_usize_t         written  = 0;
+    eya_usize_t         i        = 0;
+
+#if (EYA_UTF8_X86)
+    if (eya_utf8_has_avx2)
+        i = eya_utf16_to_utf8_avx2(out, capacity, in, count, &written);
+#endif
+
+    while (i < count)
+    {
+        if (in[i] < 0x80)
+        {
+            const eya_usize_t room = capacity - written;
+            const eya_usize_t left = count - i;
+            eya_runtime_check(room, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+            const eya_usize_t ascii =
+                eya_utf16_narrow_scalar(out + written, in + i, left < room ? left : room);
+            i += ascii;
+            written += ascii;
+            continue;
+        }
+
+        eya_uint_t code_point;
+
+        i += eya_utf16_decode(in + i, count - i, &code_point);
+        written += eya_utf8_encode(out + written, capacity - written, code_point);
+    }
+
+    return written;
+}
+
+eya_usize_t
+eya_utf32_utf8_size(const eya_memory_range_t *src)
+{
+    const eya_uint_t *in    = eya_memory_range_get_begin(src);
+    const eya_usize_t count = eya_utf8_unit_count(src, sizeof(eya_uint_t));
+    eya_usize_t       size  = count;
+
+    for (eya_usize_t i = 0; i < count; ++i)
+        size += (in[i] >= 0x80) + (in[i] >= 0x800) + (in[i] >= 0x10000);
+
+    return size;
+}
+
+eya_usize_t
+eya_utf32_to_utf8(const eya_memory_range_t *dst, const eya_memory_range_t *src)
+{
+    const eya_usize_t count = eya_utf8_unit_count(src, sizeof(eya_uint_t));
+
+    eya_runtime_check(eya_memory_range_is_aligned(src, sizeof(eya_uint_t)),
+                      EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+
+    const eya_uint_t *in       = eya_memory_range_get_begin(src);
+    eya_uchar_t      *out      = eya_memory_range_get_begin(dst);
+    const eya_usize_t capacity = eya_memory_range_get_size(dst);
+    eya_usize_t       written  = 0;
+    eya_usize_t       i        = 0;
+
+#if (EYA_UTF8_X86)
+    if (eya_utf8_has_avx2)
+        i = eya_utf32_to_utf8_avx2(out, capacity, in, count, &written);
+#endif
+
+    while (i < count)
+    {
+        if (in[i] < 0x80)
+        {
+            const eya_usize_t room = capacity - written;
+            const eya_usize_t left = count - i;
+            eya_runtime_check(room, EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+            const eya_usize_t ascii =
+                eya_utf32_narrow_scalar(out + written, in + i, left < room ? left : room);
+            i += ascii;
+            written += ascii;
+            continue;
+        }
+
+        eya_runtime_check(eya_utf32_is_scalar(in[i]), EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+        written += eya_utf8_encode(out + written, capacity - written, in[i++]);
+    }
+
+    return written;
+}
\ No newline at end of file
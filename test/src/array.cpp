@@ -104,6 +104,17 @@ TEST(eya_array_reserve, should_increase_capacity_without_changing_size)
     EXPECT_EQ(size, array.size);
 }
 
+TEST(eya_array_reserve, rejects_sizes_that_wrap_around)
+{
+    eya_array_t array = eya_array_make(sizeof(int), 10);
+
+    EXPECT_DEATH(eya_array_reserve(&array, EYA_USIZE_T_MAX - 5), ".*");
+    EXPECT_DEATH(eya_array_reserve(&array, EYA_USIZE_T_MAX / sizeof(int)), ".*");
+    EXPECT_DEATH(eya_array_resize(&array, EYA_USIZE_T_MAX / 2), ".*");
+
+    eya_array_free(&array);
+}
+
 TEST(eya_array_is_full, returns_true_when_size_equals_capacity)
 {
     eya_array_t array = eya_array_make(sizeof(int), 10);
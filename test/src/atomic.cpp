@@ -0,0 +1,95 @@
+#include <eya/atomic.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+struct atomic_counter
+{
+    eya_atomic_usize_t value;
+    eya_atomic_uint_t  flags;
+};
+
+static void
+atomic_increment(void *arg)
+{
+    auto *counter = static_cast<atomic_counter *>(arg);
+    for (int i = 0; i < 10000; ++i)
+    {
+        eya_atomic_fetch_add(&counter->value, 1, EYA_ATOMIC_RELAXED);
+
+        // A weak compare-exchange loop sets one more bit of the flags each time.
+        eya_uint_t flags = eya_atomic_load(&counter->flags, EYA_ATOMIC_RELAXED);
+        const eya_uint_t bit = 1u << (i % 32);
+        while (!eya_atomic_compare_exchange_weak(
+            &counter->flags, &flags, flags | bit, EYA_ATOMIC_ACQ_REL, EYA_ATOMIC_RELAXED))
+            eya_atomic_pause();
+    }
+}
+
+TEST(eya_atomic, provides_cache_line_size)
+{
+    EXPECT_GE(EYA_ATOMIC_CACHE_LINE_SIZE, 64);
+    EXPECT_EQ(EYA_ATOMIC_CACHE_LINE_SIZE & (EYA_ATOMIC_CACHE_LINE_SIZE - 1), 0);
+}
+
+TEST(eya_atomic, operates_on_size_wide_integers)
+{
+    eya_atomic_usize_t value    = 0;
+    eya_usize_t        expected = 1;
+
+    eya_atomic_store(&value, 10, EYA_ATOMIC_RELEASE);
+    EXPECT_EQ(eya_atomic_load(&value, EYA_ATOMIC_ACQUIRE), 10u);
+    EXPECT_EQ(eya_atomic_fetch_add(&value, 5, EYA_ATOMIC_SEQ_CST), 10u);
+    EXPECT_EQ(eya_atomic_fetch_sub(&value, 3, EYA_ATOMIC_SEQ_CST), 15u);
+    EXPECT_EQ(eya_atomic_exchange(&value, EYA_USIZE_T_MAX, EYA_ATOMIC_ACQ_REL), 12u);
+
+    EXPECT_FALSE(eya_atomic_compare_exchange(
+        &value, &expected, 2, EYA_ATOMIC_SEQ_CST, EYA_ATOMIC_RELAXED));
+    EXPECT_EQ(expected, EYA_USIZE_T_MAX);
+    EXPECT_TRUE(eya_atomic_compare_exchange(
+        &value, &expected, 2, EYA_ATOMIC_SEQ_CST, EYA_ATOMIC_RELAXED));
+    EXPECT_EQ(eya_atomic_load(&value, EYA_ATOMIC_RELAXED), 2u);
+}
+
+TEST(eya_atomic, operates_on_32_bit_words)
+{
+    eya_atomic_uint_t word     = 0xF0u;
+    eya_uint_t        expected = 0;
+
+    EXPECT_EQ(eya_atomic_fetch_or(&word, 0x0Fu, EYA_ATOMIC_RELAXED), 0xF0u);
+    EXPECT_EQ(eya_atomic_fetch_and(&word, 0x3Cu, EYA_ATOMIC_RELAXED), 0xFFu);
+    EXPECT_EQ(eya_atomic_fetch_sub(&word, 0x3Du, EYA_ATOMIC_RELAXED), 0x3Cu);
+    EXPECT_EQ(eya_atomic_load(&word, EYA_ATOMIC_RELAXED), 0xFFFFFFFFu);
+
+    EXPECT_FALSE(eya_atomic_compare_exchange(
+        &word, &expected, 1u, EYA_ATOMIC_SEQ_CST, EYA_ATOMIC_RELAXED));
+    EXPECT_EQ(expected, 0xFFFFFFFFu);
+}
+
+TEST(eya_atomic, operates_on_pointers)
+{
+    int              a   = 0;
+    int              b   = 0;
+    eya_atomic_ptr_t ptr = &a;
+
+    EXPECT_EQ(eya_atomic_exchange(&ptr, &b, EYA_ATOMIC_ACQ_REL), &a);
+    EXPECT_EQ(eya_atomic_load(&ptr, EYA_ATOMIC_ACQUIRE), &b);
+
+    eya_atomic_thread_fence(EYA_ATOMIC_SEQ_CST);
+    eya_atomic_signal_fence(EYA_ATOMIC_ACQ_REL);
+}
+
+TEST(eya_atomic, keeps_concurrent_updates)
+{
+    atomic_counter            counter = {0, 0};
+    std::vector<eya_thread_t> threads(4);
+
+    for (auto &thread : threads)
+        eya_thread_create(&thread, atomic_increment, &counter);
+    for (auto &thread : threads)
+        eya_thread_join(&thread);
+
+    EXPECT_EQ(eya_atomic_load(&counter.value, EYA_ATOMIC_RELAXED), 40000u);
+    EXPECT_EQ(eya_atomic_load(&counter.flags, EYA_ATOMIC_RELAXED), 0xFFFFFFFFu);
+}
@@ -0,0 +1,222 @@
+#include <eya/numeric_limits.h>
+#include <eya/base64.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+static std::vector<eya_uchar_t>
+base64_random(eya_usize_t size)
+{
+    std::mt19937             random(12);
+    std::vector<eya_uchar_t> bytes(size);
+
+    for (eya_uchar_t &byte : bytes)
+        byte = static_cast<eya_uchar_t>(random());
+    return bytes;
+}
+
+static eya_memory_range_t
+base64_range(const void *data, eya_usize_t size)
+{
+    eya_uchar_t *begin = static_cast<eya_uchar_t *>(const_cast<void *>(data));
+    return {begin, begin + size};
+}
+
+static std::string
+base64_encode(const void *data, eya_usize_t size, eya_base64_alphabet_t alphabet)
+{
+    std::string              text(eya_base64_encode_size(size, alphabet) + 1, '#');
+    const eya_memory_range_t src = base64_range(data, size);
+    const eya_memory_range_t dst = base64_range(&text[0], text.size());
+
+    EXPECT_EQ(eya_base64_encode(&dst, &src, alphabet), text.size() - 1);
+    EXPECT_EQ(text.back(), '#');
+    text.pop_back();
+    return text;
+}
+
+/**
+ * Decodes into a buffer of the right size, returning the number of bytes.
+ */
+static eya_usize_t
+base64_decode(const std::string &text, eya_base64_alphabet_t alphabet)
+{
+    std::vector<eya_uchar_t> bytes(text.size() + 1);
+    const eya_memory_range_t dst = base64_range(bytes.data(), bytes.size());
+    const eya_memory_range_t src = base64_range(text.data(), text.size());
+
+    return eya_base64_decode(&dst, &src, alphabet);
+}
+
+/**
+ * Straightforward encoder the vector paths must match.
+ */
+static std::string
+base64_reference(const eya_uchar_t *p, eya_usize_t size, eya_base64_alphabet_t alphabet)
+{
+    const char *chars = alphabet == EYA_BASE64_ALPHABET_URL
+                            ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+                            : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string text;
+    eya_uint_t  bits  = 0;
+    int         count = 0;
+
+    for (eya_usize_t i = 0; i < size; ++i)
+    {
+        bits = bits << 8 | p[i];
+        for (count += 8; count >= 6; count -= 6)
+            text += chars[bits >> (count - 6) & 63];
+    }
+    if (count)
+        text += chars[bits << (6 - count) & 63];
+    while (alphabet == EYA_BASE64_ALPHABET_STANDARD && text.size() % 4)
+        text += '=';
+    return text;
+}
+
+// Runs every test with the scalar loop and with the vector code where the CPU has it.
+class base64_test : public ::testing::TestWithParam<eya_uint_t>
+{
+protected:
+    void
+    SetUp() override
+    {
+        eya_base64_set_cpu_features(GetParam());
+    }
+
+    void
+    TearDown() override
+    {
+        eya_base64_set_cpu_features(EYA_UINT_T_MAX);
+    }
+};
+
+TEST_P(base64_test, encode_matches_rfc_4648_vectors)
+{
+    const char *inputs[]   = {"", "f", "fo", "foo", "foob", "fooba", "foobar"};
+    const char *standard[] = {"", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"};
+    const char *url[]      = {"", "Zg", "Zm8", "Zm9v", "Zm9vYg", "Zm9vYmE", "Zm9vYmFy"};
+
+    for (eya_usize_t i = 0; i < 7; ++i)
+    {
+        EXPECT_EQ(base64_encode(inputs[i], i, EYA_BASE64_ALPHABET_STANDARD), standard[i]);
+        EXPECT_EQ(base64_encode(inputs[i], i, EYA_BASE64_ALPHABET_URL), url[i]);
+    }
+
+    const eya_uchar_t high[] = {0xFB, 0xFF, 0xBF};
+    EXPECT_EQ(base64_encode(high, 3, EYA_BASE64_ALPHABET_STANDARD), "+/+/");
+    EXPECT_EQ(base64_encode(high, 3, EYA_BASE64_ALPHABET_URL), "-_-_");
+}
+
+TEST_P(base64_test, encode_round_trips_all_sizes_and_alignments)
+{
+    const std::vector<eya_uchar_t> bytes = base64_random(400);
+
+    for (eya_base64_alphabet_t alphabet : {EYA_BASE64_ALPHABET_STANDARD, EYA_BASE64_ALPHABET_URL})
+        for (eya_usize_t size = 0; size <= 300; ++size)
+            for (eya_usize_t offset = 0; offset < 2; ++offset)
+            {
+                const eya_uchar_t *p    = bytes.data() + offset;
+                const std::string  text = base64_encode(p, size, alphabet);
+
+                ASSERT_EQ(text, base64_reference(p, size, alphabet)) << size;
+
+                std::vector<eya_uchar_t> decoded(size + 1, 0xA5);
+                const eya_memory_range_t src = base64_range(text.data(), text.size());
+                const eya_memory_range_t dst = base64_range(decoded.data(), decoded.size());
+
+                ASSERT_EQ(eya_base64_decode_size(&src), size);
+                ASSERT_EQ(eya_base64_decode(&dst, &src, alphabet), size);
+                ASSERT_TRUE(std::equal(decoded.begin(), decoded.end() - 1, p)) << size;
+                ASSERT_EQ(decoded.back(), 0xA5);
+            }
+}
+
+TEST_P(base64_test, decode_accepts_both_padding_forms)
+{
+    for (eya_base64_alphabet_t alphabet : {EYA_BASE64_ALPHABET_STANDARD, EYA_BASE64_ALPHABET_URL})
+    {
+        EXPECT_EQ(base64_decode("Zm9vYg==", alphabet), 4u);
+        EXPECT_EQ(base64_decode("Zm9vYg", alphabet), 4u);
+        EXPECT_EQ(base64_decode("Zm9vYmE=", alphabet), 5u);
+        EXPECT_EQ(base64_decode("Zm9vYmE", alphabet), 5u);
+    }
+}
+
+TEST_P(base64_test, decode_rejects_invalid_text)
+{
+    const std::string valid(160, 'A');
+
+    for (const char *text : {"Z", "Zm9vY", "Zm9v=", "Zm9v====", "Zg=A", "Z===", "=AAA", "Zh==",
+                             "Zm9=", "Zm8 ", "Zm9v\n"})
+        EXPECT_DEATH(base64_decode(text, EYA_BASE64_ALPHABET_STANDARD), ".*") << text;
+
+    for (char c : {'=', '-', '_', '.', ' ', '\0', '\x80', '\xff', '@', '[', '`', '{'})
+        for (eya_usize_t position : {0u, 5u, 31u, 32u, 100u, 159u})
+        {
+            std::string text = valid;
+            text[position]   = c;
+
+            // A final '=' is padding, the URL characters belong to their alphabet.
+            const bool padding  = c == '=' && position == valid.size() - 1;
+            const bool url_char = c == '-' || c == '_';
+
+            if (padding)
+                EXPECT_EQ(base64_decode(text, EYA_BASE64_ALPHABET_STANDARD), 119u);
+            else
+                EXPECT_DEATH(base64_decode(text, EYA_BASE64_ALPHABET_STANDARD), ".*")
+                    << static_cast<int>(c) << " " << position;
+
+            if (padding || url_char)
+                EXPECT_EQ(base64_decode(text, EYA_BASE64_ALPHABET_URL), padding ? 119u : 120u);
+            else
+                EXPECT_DEATH(base64_decode(text, EYA_BASE64_ALPHABET_URL), ".*")
+                    << static_cast<int>(c) << " " << position;
+        }
+
+    EXPECT_DEATH(base64_decode("AAAA", static_cast<eya_base64_alphabet_t>(2)), ".*");
+}
+
+TEST(eya_base64_size, reports_exact_sizes)
+{
+    EXPECT_EQ(eya_base64_encode_size(0, EYA_BASE64_ALPHABET_STANDARD), 0u);
+    EXPECT_EQ(eya_base64_encode_size(4, EYA_BASE64_ALPHABET_STANDARD), 8u);
+    EXPECT_EQ(eya_base64_encode_size(4, EYA_BASE64_ALPHABET_URL), 6u);
+    EXPECT_EQ(eya_base64_encode_size(5, EYA_BASE64_ALPHABET_URL), 7u);
+    EXPECT_EQ(eya_base64_encode_size(6, EYA_BASE64_ALPHABET_URL), 8u);
+    EXPECT_DEATH(eya_base64_encode_size(static_cast<eya_usize_t>(-1), EYA_BASE64_ALPHABET_URL),
+                 ".*");
+
+    const std::string        text  = "Zm9vYg==";
+    const eya_memory_range_t range = base64_range(text.data(), text.size());
+    EXPECT_EQ(eya_base64_decode_size(&range), 4u);
+}
+
+TEST_P(base64_test, append_grows_a_byte_array)
+{
+    const std::vector<eya_uchar_t> bytes = base64_random(100);
+    const eya_memory_range_t       src   = base64_range(bytes.data(), bytes.size());
+    eya_array_t                    text  = eya_array_make(1, 0);
+    eya_array_t                    back  = eya_array_make(1, 0);
+
+    EXPECT_EQ(eya_base64_encode_append(&text, &src, EYA_BASE64_ALPHABET_URL), 134u);
+    ASSERT_EQ(eya_array_get_size(&text), 134u);
+
+    const eya_memory_range_t encoded = base64_range(eya_array_get_begin(&text), 134);
+    EXPECT_EQ(eya_base64_decode_append(&back, &encoded, EYA_BASE64_ALPHABET_URL), 100u);
+    ASSERT_EQ(eya_array_get_size(&back), 100u);
+    EXPECT_TRUE(std::equal(bytes.begin(), bytes.end(),
+                           static_cast<const eya_uchar_t *>(eya_array_get_begin(&back))));
+
+    static_cast<char *>(eya_array_get_begin(&text))[120] = '*';
+    EXPECT_DEATH(eya_base64_decode_append(&back, &encoded, EYA_BASE64_ALPHABET_URL), ".*");
+
+    eya_array_free(&back);
+    eya_array_free(&text);
+}
+
+INSTANTIATE_TEST_SUITE_P(eya_base64,
+                         base64_test,
+                         ::testing::Values(0u, EYA_UINT_T_MAX));
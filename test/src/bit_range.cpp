@@ -0,0 +1,210 @@
+#include <eya/numeric_limits.h>
+#include <eya/cpu_feature.h>
+#include <eya/bit_range.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+static std::vector<eya_uchar_t>
+bit_range_random(eya_usize_t size, unsigned seed)
+{
+    std::mt19937             random(seed);
+    std::vector<eya_uchar_t> bytes(size);
+
+    for (eya_uchar_t &byte : bytes)
+        byte = static_cast<eya_uchar_t>(random());
+    return bytes;
+}
+
+static bool
+bit_range_get(const eya_uchar_t *p, eya_usize_t i)
+{
+    return p[i / 8] >> (i % 8) & 1;
+}
+
+static eya_usize_t
+bit_range_popcount_reference(const eya_uchar_t *p, eya_usize_t size)
+{
+    eya_usize_t count = 0;
+
+    for (eya_usize_t i = 0; i < 8 * size; ++i)
+        count += bit_range_get(p, i);
+    return count;
+}
+
+// Runs every test with each implementation the CPU supports.
+class bit_range_test : public ::testing::TestWithParam<eya_uint_t>
+{
+protected:
+    void
+    SetUp() override
+    {
+        eya_bit_range_set_cpu_features(GetParam());
+    }
+
+    void
+    TearDown() override
+    {
+        eya_bit_range_set_cpu_features(EYA_UINT_T_MAX);
+    }
+};
+
+TEST_P(bit_range_test, popcount_matches_reference_for_all_sizes_and_alignments)
+{
+    const std::vector<eya_uchar_t> bytes = bit_range_random(5000, 1);
+
+    for (eya_usize_t size = 0; size <= 4000; size += size < 1100 ? 1 : 61)
+        for (eya_usize_t offset = 0; offset < 3; ++offset)
+            ASSERT_EQ(eya_bit_range_popcount(bytes.data() + offset, size),
+                      bit_range_popcount_reference(bytes.data() + offset, size))
+                << size << " " << offset;
+
+    const std::vector<eya_uchar_t> ones(4096, 0xFF);
+    EXPECT_EQ(eya_bit_range_popcount(ones.data(), ones.size()), 8u * ones.size());
+    EXPECT_EQ(eya_bit_range_popcount(nullptr, 0), 0u);
+    EXPECT_DEATH(eya_bit_range_popcount(nullptr, 1), ".*");
+}
+
+TEST_P(bit_range_test, and_stores_the_result_and_counts_it)
+{
+    const std::vector<eya_uchar_t> a = bit_range_random(3000, 2);
+    const std::vector<eya_uchar_t> b = bit_range_random(3000, 3);
+
+    for (eya_usize_t size = 0; size <= 2900; size += size < 300 ? 1 : 37)
+    {
+        std::vector<eya_uchar_t> dst(size + 1, 0xA5);
+        std::vector<eya_uchar_t> expected(size);
+
+        for (eya_usize_t i = 0; i < size; ++i)
+            expected[i] = a[i + 1] & b[i];
+
+        ASSERT_EQ(eya_bit_range_and(dst.data(), a.data() + 1, b.data(), size),
+                  bit_range_popcount_reference(expected.data(), size))
+            << size;
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), dst.begin())) << size;
+        ASSERT_EQ(dst[size], 0xA5) << size;
+    }
+
+    EXPECT_EQ(eya_bit_range_and(nullptr, nullptr, nullptr, 0), 0u);
+    EXPECT_DEATH(eya_bit_range_and(nullptr, a.data(), b.data(), 1), ".*");
+}
+
+TEST_P(bit_range_test, xor_supports_every_operation_in_place)
+{
+    const std::vector<eya_uchar_t> a = bit_range_random(777, 4);
+    const std::vector<eya_uchar_t> b = bit_range_random(777, 5);
+
+    const struct
+    {
+        eya_usize_t (*apply)(void *, const void *, const void *, eya_usize_t);
+        eya_uchar_t (*expected)(eya_uchar_t, eya_uchar_t);
+    } operations[] = {
+        {eya_bit_range_or, [](eya_uchar_t x, eya_uchar_t y) { return eya_uchar_t(x | y); }},
+        {eya_bit_range_xor, [](eya_uchar_t x, eya_uchar_t y) { return eya_uchar_t(x ^ y); }},
+        {eya_bit_range_andnot, [](eya_uchar_t x, eya_uchar_t y) { return eya_uchar_t(x & ~y); }},
+    };
+
+    for (const auto &operation : operations)
+    {
+        std::vector<eya_uchar_t> dst = a;
+        std::vector<eya_uchar_t> expected(a.size());
+
+        for (eya_usize_t i = 0; i < a.size(); ++i)
+            expected[i] = operation.expected(a[i], b[i]);
+
+        EXPECT_EQ(operation.apply(dst.data(), dst.data(), b.data(), dst.size()),
+                  bit_range_popcount_reference(expected.data(), expected.size()));
+        EXPECT_EQ(dst, expected);
+    }
+}
+
+TEST_P(bit_range_test, pext64_extracts_the_selected_bits)
+{
+    EXPECT_EQ(eya_bit_pext64(0xF0F0ull, 0xFF00ull), 0xF0ull);
+    EXPECT_EQ(eya_bit_pext64(0x12345678ull, 0ull), 0ull);
+    EXPECT_EQ(eya_bit_pext64(0x8000000000000001ull, 0x8000000000000001ull), 3ull);
+    EXPECT_EQ(eya_bit_pext64(0xDEADBEEFull, ~0ull), 0xDEADBEEFull);
+
+    std::mt19937_64 random(6);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const eya_ullong_t value = random(), mask = random();
+
+        EXPECT_EQ(eya_bit_pdep64(eya_bit_pext64(value, mask), mask), value & mask);
+    }
+}
+
+TEST_P(bit_range_test, pdep64_deposits_the_low_bits)
+{
+    EXPECT_EQ(eya_bit_pdep64(0xF0ull, 0xFF00ull), 0xF000ull);
+    EXPECT_EQ(eya_bit_pdep64(3ull, 0x8000000000000001ull), 0x8000000000000001ull);
+    EXPECT_EQ(eya_bit_pdep64(~0ull, 0x0F0Full), 0x0F0Full);
+    EXPECT_EQ(eya_bit_pdep64(~0ull, 0ull), 0ull);
+}
+
+TEST_P(bit_range_test, gather_packs_the_selected_bits)
+{
+    const std::vector<eya_uchar_t> src = bit_range_random(600, 7);
+    const std::vector<eya_uchar_t> mask = bit_range_random(600, 8);
+
+    for (eya_usize_t size = 0; size <= src.size(); size += size < 100 ? 1 : 23)
+    {
+        std::vector<eya_uchar_t> expected(size + 1, 0);
+        eya_usize_t              bits = 0;
+
+        for (eya_usize_t i = 0; i < 8 * size; ++i)
+            if (bit_range_get(mask.data(), i))
+            {
+                expected[bits / 8] |= eya_uchar_t(bit_range_get(src.data(), i) << (bits % 8));
+                ++bits;
+            }
+
+        std::vector<eya_uchar_t> dst((bits + 7) / 8 + 1, 0xA5);
+        expected.resize((bits + 7) / 8);
+        expected.push_back(0xA5);
+
+        ASSERT_EQ(eya_bit_range_gather(dst.data(), src.data(), mask.data(), size), bits) << size;
+        ASSERT_EQ(dst, expected) << size;
+    }
+
+    EXPECT_EQ(eya_bit_range_gather(nullptr, nullptr, nullptr, 0), 0u);
+    EXPECT_DEATH(eya_bit_range_gather(nullptr, src.data(), mask.data(), 1), ".*");
+}
+
+TEST_P(bit_range_test, scatter_restores_gathered_bits)
+{
+    const std::vector<eya_uchar_t> src = bit_range_random(600, 9);
+
+    for (eya_uchar_t fill : {0x00, 0x01, 0x5A, 0xFF})
+        for (eya_usize_t size = 0; size <= src.size(); size += size < 100 ? 1 : 23)
+        {
+            std::vector<eya_uchar_t> mask = bit_range_random(size, 10);
+            if (fill != 0x5A)
+                mask.assign(size, fill);
+
+            // The stream is exactly as long as the mask requires, but never empty,
+            // since the source may only be nullptr for an empty mask buffer.
+            const eya_usize_t        bits = bit_range_popcount_reference(mask.data(), size);
+            std::vector<eya_uchar_t> stream(std::max<eya_usize_t>((bits + 7) / 8, 1));
+            std::vector<eya_uchar_t> dst(size + 1, 0xA5);
+
+            ASSERT_EQ(eya_bit_range_gather(stream.data(), src.data(), mask.data(), size), bits);
+            ASSERT_EQ(eya_bit_range_scatter(dst.data(), stream.data(), mask.data(), size), bits);
+
+            for (eya_usize_t i = 0; i < size; ++i)
+                ASSERT_EQ(dst[i], src[i] & mask[i]) << size << " " << i;
+            ASSERT_EQ(dst[size], 0xA5) << size;
+        }
+
+    EXPECT_EQ(eya_bit_range_scatter(nullptr, nullptr, nullptr, 0), 0u);
+    EXPECT_DEATH(eya_bit_range_scatter(nullptr, src.data(), src.data(), 1), ".*");
+}
+
+INSTANTIATE_TEST_SUITE_P(eya_bit_range,
+                         bit_range_test,
+                         ::testing::Values(0u,
+                                           EYA_CPU_FEATURE_AVX2,
+                                           EYA_CPU_FEATURE_BMI2 | EYA_CPU_FEATURE_POPCNT,
+                                           EYA_UINT_T_MAX));
@@ -0,0 +1,51 @@
+#include <eya/checked_math.h>
+#include <gtest/gtest.h>
+
+TEST(eya_checked_add, detects_wraparound)
+{
+    eya_usize_t result;
+
+    EXPECT_FALSE(eya_checked_add(2, 3, &result));
+    EXPECT_EQ(result, 5u);
+
+    EXPECT_FALSE(eya_checked_add(EYA_USIZE_T_MAX - 1, 1, &result));
+    EXPECT_EQ(result, EYA_USIZE_T_MAX);
+
+    EXPECT_TRUE(eya_checked_add(EYA_USIZE_T_MAX, 1, &result));
+    EXPECT_TRUE(eya_checked_add(EYA_USIZE_T_MAX / 2 + 1, EYA_USIZE_T_MAX / 2 + 1, &result));
+}
+
+TEST(eya_checked_mul, detects_wraparound)
+{
+    const eya_usize_t half = static_cast<eya_usize_t>(1) << (sizeof(eya_usize_t) * 4);
+    eya_usize_t       result;
+
+    EXPECT_FALSE(eya_checked_mul(0, EYA_USIZE_T_MAX, &result));
+    EXPECT_EQ(result, 0u);
+
+    EXPECT_FALSE(eya_checked_mul(EYA_USIZE_T_MAX, 1, &result));
+    EXPECT_EQ(result, EYA_USIZE_T_MAX);
+
+    EXPECT_FALSE(eya_checked_mul(half - 1, half + 1, &result));
+    EXPECT_EQ(result, EYA_USIZE_T_MAX);
+
+    EXPECT_TRUE(eya_checked_mul(half, half, &result));
+    EXPECT_TRUE(eya_checked_mul(EYA_USIZE_T_MAX / 3 + 1, 3, &result));
+    EXPECT_FALSE(eya_checked_mul(EYA_USIZE_T_MAX / 3, 3, &result));
+}
+
+TEST(eya_checked_shl, detects_lost_bits)
+{
+    const eya_usize_t bits = sizeof(eya_usize_t) * 8;
+    eya_usize_t       result;
+
+    EXPECT_FALSE(eya_checked_shl(1, bits - 1, &result));
+    EXPECT_EQ(result, static_cast<eya_usize_t>(1) << (bits - 1));
+
+    EXPECT_FALSE(eya_checked_shl(0, bits + 10, &result));
+    EXPECT_EQ(result, 0u);
+
+    EXPECT_TRUE(eya_checked_shl(2, bits - 1, &result));
+    EXPECT_TRUE(eya_checked_shl(1, bits, &result));
+    EXPECT_TRUE(eya_checked_shl(EYA_USIZE_T_MAX, 1, &result));
+}
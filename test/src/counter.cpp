@@ -0,0 +1,99 @@
+#include <eya/counter.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+static eya_counter_t counter_static = EYA_COUNTER_INITIALIZER;
+
+static void
+counter_bump(void *arg)
+{
+    auto *counter = static_cast<eya_counter_t *>(arg);
+
+    for (int i = 0; i < 10000; ++i)
+        eya_counter_increment(counter);
+    eya_counter_sub(counter, 500);
+}
+
+TEST(eya_counter_init, starts_from_zero)
+{
+    EXPECT_EQ(eya_counter_get(&counter_static), 0u);
+
+    eya_counter_t counter;
+    eya_counter_init(&counter);
+    EXPECT_EQ(eya_counter_get(&counter), 0u);
+
+    eya_counter_add(&counter, 7);
+    eya_counter_init(&counter);
+    EXPECT_EQ(eya_counter_get(&counter), 0u);
+
+    EXPECT_DEATH(eya_counter_init(nullptr), ".*");
+    EXPECT_DEATH(eya_counter_get(nullptr), ".*");
+}
+
+TEST(eya_counter_add, tracks_values_going_up_and_down)
+{
+    eya_counter_t counter;
+    eya_counter_init(&counter);
+
+    eya_counter_add(&counter, 40);
+    eya_counter_increment(&counter);
+    eya_counter_increment(&counter);
+    EXPECT_EQ(eya_counter_get(&counter), 42u);
+
+    eya_counter_sub(&counter, 50);
+    EXPECT_EQ(eya_counter_get(&counter), (eya_usize_t)-8);
+
+    eya_counter_add(&counter, 8);
+    EXPECT_EQ(eya_counter_get(&counter), 0u);
+
+    EXPECT_DEATH(eya_counter_add(nullptr, 1), ".*");
+    EXPECT_DEATH(eya_counter_increment(nullptr), ".*");
+}
+
+TEST(eya_counter_add, sums_updates_of_many_threads)
+{
+    // More threads than slots, so some of them share the overflow slot.
+    constexpr int threads = EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT + 8;
+
+    eya_counter_t counter;
+    eya_counter_init(&counter);
+
+    std::vector<eya_thread_t> handles(threads);
+    for (auto &handle : handles)
+        eya_thread_create(&handle, counter_bump, &counter);
+    for (auto &handle : handles)
+        eya_thread_join(&handle);
+
+    EXPECT_EQ(eya_counter_get(&counter), threads * 9500u);
+}
+
+static void
+counter_bump_once(void *arg)
+{
+    eya_counter_increment(static_cast<eya_counter_t *>(arg));
+}
+
+TEST(eya_counter_add, reuses_slots_of_exited_threads)
+{
+    eya_counter_t probe;
+    eya_counter_init(&probe);
+    eya_counter_increment(&probe);
+    if (eya_atomic_load(&probe.overflow.value, EYA_ATOMIC_RELAXED))
+        GTEST_SKIP() << "threads do not own slots in this build";
+
+    // Many more threads than slots come and go, each giving its slot back.
+    eya_counter_t counter;
+    eya_counter_init(&counter);
+
+    for (int i = 0; i < 4 * EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT; ++i)
+    {
+        eya_thread_t handle;
+        eya_thread_create(&handle, counter_bump_once, &counter);
+        eya_thread_join(&handle);
+    }
+
+    EXPECT_EQ(eya_counter_get(&counter), 4u * EYA_LIBRARY_OPTION_COUNTER_SLOT_COUNT);
+    EXPECT_EQ(eya_atomic_load(&counter.overflow.value, EYA_ATOMIC_RELAXED), 0u);
+}
@@ -0,0 +1,28 @@
+#include <eya/cpu.h>
+#include <gtest/gtest.h>
+
+TEST(eya_cpu_get_features, is_stable_and_consistent)
+{
+    const eya_uint_t features = eya_cpu_get_features();
+
+    EXPECT_EQ(eya_cpu_get_features(), features);
+
+    // The 512-bit extensions are only reported together with their foundation.
+    if (features & (EYA_CPU_FEATURE_AVX512BW | EYA_CPU_FEATURE_AVX512VPOPCNTDQ |
+                    EYA_CPU_FEATURE_AVX512VBMI))
+        EXPECT_TRUE(features & EYA_CPU_FEATURE_AVX512F);
+}
+
+TEST(eya_cpu_has, requires_every_feature)
+{
+    const eya_uint_t features = eya_cpu_get_features();
+
+    EXPECT_TRUE(eya_cpu_has(0));
+    EXPECT_TRUE(eya_cpu_has(features));
+
+    for (eya_uint_t flag = 1; flag <= EYA_CPU_FEATURE_AVX512VBMI; flag <<= 1)
+    {
+        EXPECT_EQ(eya_cpu_has(flag), (features & flag) != 0) << flag;
+        EXPECT_EQ(eya_cpu_has(features | flag), (features & flag) != 0) << flag;
+    }
+}
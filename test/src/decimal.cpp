@@ -0,0 +1,352 @@
+#include <eya/decimal.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+static eya_memory_range_t
+decimal_range(const void *data, eya_usize_t size)
+{
+    eya_uchar_t *begin = static_cast<eya_uchar_t *>(const_cast<void *>(data));
+    return {begin, begin + size};
+}
+
+static std::string
+decimal_format(double value)
+{
+    char                     text[EYA_DECIMAL_DOUBLE_MAX_SIZE];
+    const eya_memory_range_t dst = decimal_range(text, sizeof(text));
+
+    return std::string(text, eya_decimal_format_double(&dst, value));
+}
+
+/**
+ * Parses the whole text as a double.
+ */
+static double
+decimal_parse(const std::string &text)
+{
+    const eya_memory_range_t src = decimal_range(text.data(), text.size());
+    double                   value;
+
+    EXPECT_EQ(eya_decimal_parse_double(&src, &value), text.size()) << text;
+    return value;
+}
+
+static eya_ullong_t
+decimal_bits(double value)
+{
+    eya_ullong_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static double
+decimal_random_double(std::mt19937_64 &random)
+{
+    double value;
+
+    do
+    {
+        const eya_ullong_t bits = random();
+        std::memcpy(&value, &bits, sizeof(value));
+    } while (!std::isfinite(value));
+
+    return value;
+}
+
+TEST(eya_decimal_size, counts_digits)
+{
+    EXPECT_EQ(eya_decimal_ullong_size(0), 1u);
+    EXPECT_EQ(eya_decimal_ullong_size(std::numeric_limits<eya_ullong_t>::max()), 20u);
+
+    eya_ullong_t power = 1;
+    for (eya_usize_t digits = 1; digits < 20; ++digits, power *= 10)
+    {
+        EXPECT_EQ(eya_decimal_ullong_size(power), digits);
+        EXPECT_EQ(eya_decimal_ullong_size(power * 10 - 1), digits);
+    }
+
+    EXPECT_EQ(eya_decimal_sllong_size(0), 1u);
+    EXPECT_EQ(eya_decimal_sllong_size(-1), 2u);
+    EXPECT_EQ(eya_decimal_sllong_size(std::numeric_limits<eya_sllong_t>::min()), 20u);
+    EXPECT_EQ(eya_decimal_sllong_size(std::numeric_limits<eya_sllong_t>::max()), 19u);
+}
+
+TEST(eya_decimal_parse_ullong, reads_a_prefix)
+{
+    std::mt19937_64 random(3);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const eya_ullong_t       expected = random() >> (random() % 64);
+        const std::string        text     = std::to_string(expected) + ",";
+        const eya_memory_range_t src      = decimal_range(text.data(), text.size());
+        eya_ullong_t             value;
+
+        ASSERT_EQ(eya_decimal_parse_ullong(&src, &value), text.size() - 1);
+        ASSERT_EQ(value, expected);
+    }
+
+    const std::string        zeros = "00000000000000000000000000042x";
+    const eya_memory_range_t src   = decimal_range(zeros.data(), zeros.size());
+    eya_ullong_t             value;
+
+    EXPECT_EQ(eya_decimal_parse_ullong(&src, &value), zeros.size() - 1);
+    EXPECT_EQ(value, 42u);
+}
+
+TEST(eya_decimal_parse_ullong, reports_overflow_and_bad_text)
+{
+    const auto parse = [](const std::string &text) {
+        const eya_memory_range_t src = decimal_range(text.data(), text.size());
+        eya_ullong_t             value;
+        eya_decimal_parse_ullong(&src, &value);
+        return value;
+    };
+
+    EXPECT_EQ(parse("18446744073709551615"), std::numeric_limits<eya_ullong_t>::max());
+    EXPECT_EQ(parse("018446744073709551615"), std::numeric_limits<eya_ullong_t>::max());
+    EXPECT_DEATH(parse("18446744073709551616"), ".*");
+    EXPECT_DEATH(parse("99999999999999999999"), ".*");
+    EXPECT_DEATH(parse("100000000000000000000"), ".*");
+    EXPECT_DEATH(parse(""), ".*");
+    EXPECT_DEATH(parse("-1"), ".*");
+    EXPECT_DEATH(parse("+1"), ".*");
+    EXPECT_DEATH(parse(" 1"), ".*");
+}
+
+TEST(eya_decimal_parse_sllong, covers_the_limits)
+{
+    const auto parse = [](const std::string &text, eya_sllong_t *value) {
+        const eya_memory_range_t src = decimal_range(text.data(), text.size());
+        return eya_decimal_parse_sllong(&src, value);
+    };
+    eya_sllong_t value;
+
+    EXPECT_EQ(parse("-9223372036854775808", &value), 20u);
+    EXPECT_EQ(value, std::numeric_limits<eya_sllong_t>::min());
+    EXPECT_EQ(parse("9223372036854775807", &value), 19u);
+    EXPECT_EQ(value, std::numeric_limits<eya_sllong_t>::max());
+    EXPECT_EQ(parse("-0", &value), 2u);
+    EXPECT_EQ(value, 0);
+    EXPECT_EQ(parse("-17", &value), 3u);
+    EXPECT_EQ(value, -17);
+
+    EXPECT_DEATH(parse("-9223372036854775809", &value), ".*");
+    EXPECT_DEATH(parse("9223372036854775808", &value), ".*");
+    EXPECT_DEATH(parse("-", &value), ".*");
+    EXPECT_DEATH(parse("--1", &value), ".*");
+}
+
+TEST(eya_decimal_format, writes_integers)
+{
+    std::mt19937_64 random(5);
+    char            text[EYA_DECIMAL_SLLONG_MAX_SIZE];
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const eya_ullong_t       bits = random() >> (random() % 64);
+        const eya_memory_range_t dst  = decimal_range(text, sizeof(text));
+
+        const std::string unsigned_text = std::to_string(bits);
+        ASSERT_EQ(eya_decimal_format_ullong(&dst, bits), unsigned_text.size());
+        ASSERT_EQ(std::string(text, unsigned_text.size()), unsigned_text);
+
+        const eya_sllong_t signed_value = static_cast<eya_sllong_t>(bits) * (i & 1 ? -1 : 1);
+        const std::string  signed_text  = std::to_string(signed_value);
+        ASSERT_EQ(eya_decimal_format_sllong(&dst, signed_value), signed_text.size());
+        ASSERT_EQ(std::string(text, signed_text.size()), signed_text);
+    }
+
+    const eya_memory_range_t dst = decimal_range(text, sizeof(text));
+    ASSERT_EQ(eya_decimal_format_sllong(&dst, std::numeric_limits<eya_sllong_t>::min()), 20u);
+    EXPECT_EQ(std::string(text, 20), "-9223372036854775808");
+
+    const eya_memory_range_t small = decimal_range(text, 3);
+    EXPECT_EQ(eya_decimal_format_ullong(&small, 999), 3u);
+    EXPECT_DEATH(eya_decimal_format_ullong(&small, 1000), ".*");
+    EXPECT_DEATH(eya_decimal_format_sllong(&small, -100), ".*");
+}
+
+TEST(eya_decimal_format_double, chooses_the_notation)
+{
+    EXPECT_EQ(decimal_format(0.0), "0");
+    EXPECT_EQ(decimal_format(-0.0), "-0");
+    EXPECT_EQ(decimal_format(1.0), "1");
+    EXPECT_EQ(decimal_format(-1.5), "-1.5");
+    EXPECT_EQ(decimal_format(0.1), "0.1");
+    EXPECT_EQ(decimal_format(0.3), "0.3");
+    EXPECT_EQ(decimal_format(0.1 + 0.2), "0.30000000000000004");
+    EXPECT_EQ(decimal_format(100.0), "100");
+    EXPECT_EQ(decimal_format(123456.789), "123456.789");
+    EXPECT_EQ(decimal_format(1e20), "100000000000000000000");
+    EXPECT_EQ(decimal_format(1e21), "1e21");
+    EXPECT_EQ(decimal_format(1.5e22), "1.5e22");
+    EXPECT_EQ(decimal_format(0.000001), "0.000001");
+    EXPECT_EQ(decimal_format(0.0000012345), "0.0000012345");
+    EXPECT_EQ(decimal_format(1e-7), "1e-7");
+    EXPECT_EQ(decimal_format(9007199254740993.0), "9007199254740992");
+    EXPECT_EQ(decimal_format(std::numeric_limits<double>::max()), "1.7976931348623157e308");
+    EXPECT_EQ(decimal_format(std::numeric_limits<double>::min()), "2.2250738585072014e-308");
+    EXPECT_EQ(decimal_format(std::numeric_limits<double>::denorm_min()), "5e-324");
+    EXPECT_EQ(decimal_format(-std::numeric_limits<double>::denorm_min() * 2), "-1e-323");
+    EXPECT_EQ(decimal_format(std::numeric_limits<double>::infinity()), "inf");
+    EXPECT_EQ(decimal_format(-std::numeric_limits<double>::infinity()), "-inf");
+    EXPECT_EQ(decimal_format(std::numeric_limits<double>::quiet_NaN()), "nan");
+    EXPECT_EQ(decimal_format(-0.0000012345678901234567), "-0.0000012345678901234567");
+
+    char                     text[4];
+    const eya_memory_range_t small = decimal_range(text, sizeof(text));
+    EXPECT_DEATH(eya_decimal_format_double(&small, 0.125), ".*");
+}
+
+TEST(eya_decimal_format_double, writes_the_shortest_round_trip)
+{
+    std::mt19937_64 random(7);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        const double      value = decimal_random_double(random);
+        const std::string text  = decimal_format(value);
+
+        ASSERT_EQ(decimal_bits(std::strtod(text.c_str(), nullptr)), decimal_bits(value)) << text;
+
+        // The fewest digits that round-trip through printf bound the length.
+        int  precision = 1;
+        char shortest[32];
+        for (;; ++precision)
+        {
+            std::snprintf(shortest, sizeof(shortest), "%.*e", precision - 1, value);
+            if (std::strtod(shortest, nullptr) == value)
+                break;
+        }
+
+        // Zeros before the first nonzero digit and after the last are not significant.
+        std::string digits;
+        for (const char c : text.substr(0, text.find('e')))
+            if (c >= '0' && c <= '9')
+                digits += c;
+        digits = digits.substr(digits.find_first_not_of('0'));
+        digits = digits.substr(0, digits.find_last_not_of('0') + 1);
+
+        ASSERT_LE(static_cast<int>(digits.size()), precision) << text;
+    }
+}
+
+TEST(eya_decimal_parse_double, rounds_to_nearest)
+{
+    std::mt19937_64 random(9);
+    char            text[64];
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        const double value = decimal_random_double(random);
+
+        std::snprintf(text, sizeof(text), "%.*e", static_cast<int>(random() % 20), value);
+        ASSERT_EQ(decimal_bits(decimal_parse(text)), decimal_bits(std::strtod(text, nullptr)))
+            << text;
+
+        ASSERT_EQ(decimal_bits(decimal_parse(decimal_format(value))), decimal_bits(value));
+    }
+
+    // Long mantissas, which may need the exact conversion.
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string digits(1 + random() % 40, '0');
+        for (char &c : digits)
+            c = static_cast<char>('0' + random() % 10);
+
+        const std::string exponent = std::to_string(static_cast<int>(random() % 700) - 350);
+        const std::string number   = digits.substr(0, 1) + "." + digits.substr(1) + "e" + exponent;
+
+        ASSERT_EQ(decimal_bits(decimal_parse(number)),
+                  decimal_bits(std::strtod(number.c_str(), nullptr)))
+            << number;
+    }
+}
+
+TEST(eya_decimal_parse_double, handles_hard_cases)
+{
+    const char *const cases[] = {
+        "9007199254740993",
+        "9007199254740993.0000000000000000000000000001",
+        "9007199254740992.9999999999999999999999999999",
+        "2.4703282292062327e-324",
+        "2.4703282292062328e-324",
+        "2.2250738585072011e-308",
+        "2.2250738585072012e-308",
+        "1.7976931348623158e308",
+        "1.7976931348623159e308",
+        "4.9406564584124654417656879286822137236505980e-324",
+        "0.000000000000000000000000000000000000000000001e-280",
+        "179769313486231580793728971405303415079934132710037826936173778980444968292764750946649"
+        "017977587207096330286416692887910946555547851940402630657488671505820681908902000708383"
+        "676273854845817711531764475730270069855571366959622842914819860834936475292719074168444"
+        "3655",
+        "7.2057594037927933e16",
+        "1e23",
+        "8.98846567431158e307",
+        "123456789012345678901234567890e-10",
+        "0.1e1000",
+        "1e-1000",
+    };
+
+    for (const char *number : cases)
+        EXPECT_EQ(decimal_bits(decimal_parse(number)), decimal_bits(std::strtod(number, nullptr)))
+            << number;
+
+    // A halfway case decided by a nonzero digit far past the first 800.
+    std::string halfway = "9007199254740993." + std::string(1000, '0');
+    EXPECT_EQ(decimal_parse(halfway), 9007199254740992.0);
+    halfway += "1";
+    EXPECT_EQ(decimal_parse(halfway), 9007199254740994.0);
+}
+
+TEST(eya_decimal_parse_double, reads_special_values_and_prefixes)
+{
+    EXPECT_TRUE(std::isnan(decimal_parse("nan")));
+    EXPECT_EQ(decimal_parse("inf"), std::numeric_limits<double>::infinity());
+    EXPECT_EQ(decimal_parse("-Infinity"), -std::numeric_limits<double>::infinity());
+    EXPECT_EQ(decimal_bits(decimal_parse("-0")), decimal_bits(-0.0));
+    EXPECT_EQ(decimal_parse(".5"), 0.5);
+    EXPECT_EQ(decimal_parse("5."), 5.0);
+    EXPECT_EQ(decimal_parse("1E+2"), 100.0);
+
+    const auto used = [](const std::string &text) {
+        const eya_memory_range_t src = decimal_range(text.data(), text.size());
+        double                   value;
+        return eya_decimal_parse_double(&src, &value);
+    };
+
+    EXPECT_EQ(used("1.25,"), 4u);
+    EXPECT_EQ(used("1e"), 1u);
+    EXPECT_EQ(used("1e+x"), 1u);
+    EXPECT_EQ(used("infx"), 3u);
+    EXPECT_EQ(used("infinit"), 3u);
+
+    for (const char *text : {"", "-", ".", "-.e1", "e5", "+1", "in"})
+        EXPECT_DEATH(used(text), ".*") << text;
+}
+
+TEST(eya_decimal_append, grows_a_byte_array)
+{
+    eya_array_t text = eya_array_make(1, 0);
+
+    EXPECT_EQ(eya_decimal_format_ullong_append(&text, 42), 2u);
+    EXPECT_EQ(eya_decimal_format_sllong_append(&text, -7), 2u);
+    EXPECT_EQ(eya_decimal_format_double_append(&text, 0.25), 4u);
+    ASSERT_EQ(eya_array_get_size(&text), 8u);
+    EXPECT_EQ(std::string(static_cast<const char *>(eya_array_get_begin(&text)), 8), "42-70.25");
+
+    eya_array_t wide = eya_array_make(4, 0);
+    EXPECT_DEATH(eya_decimal_format_double_append(&wide, 1.0), ".*");
+
+    eya_array_free(&wide);
+    eya_array_free(&text);
+}
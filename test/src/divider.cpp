@@ -0,0 +1,84 @@
+#include <eya/memory_typed.h>
+#include <eya/divider.h>
+#include <eya/array.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+static void
+divider_expect_exact(eya_usize_t divisor, const std::vector<eya_usize_t> &numerators)
+{
+    eya_divider_t divider;
+    eya_divider_init(&divider, divisor);
+
+    EXPECT_EQ(divider.divisor, divisor);
+    for (eya_usize_t numerator : numerators)
+        ASSERT_EQ(eya_divider_div(&divider, numerator), numerator / divisor)
+            << numerator << " / " << divisor;
+}
+
+TEST(eya_divider_div, matches_hardware_division)
+{
+    std::mt19937_64          random(42);
+    std::vector<eya_usize_t> numerators = {0, 1, 2, 3, 7, 1000, EYA_USIZE_T_MAX,
+                                           EYA_USIZE_T_MAX - 1, EYA_USIZE_T_MAX / 2,
+                                           EYA_USIZE_T_MAX / 2 + 1};
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        const eya_usize_t value = static_cast<eya_usize_t>(random());
+        numerators.push_back(value);
+        numerators.push_back(value >> (i % (sizeof(eya_usize_t) * 8)));
+    }
+
+    // Small divisors cover every element size in practice, including the ones
+    // that need the add-and-halve step, such as 7.
+    for (eya_usize_t divisor = 1; divisor <= 1024; ++divisor)
+        divider_expect_exact(divisor, numerators);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        const eya_usize_t divisor = static_cast<eya_usize_t>(random()) >> (i % 60);
+        if (divisor)
+            divider_expect_exact(divisor, numerators);
+    }
+
+    divider_expect_exact(EYA_USIZE_T_MAX, numerators);
+    divider_expect_exact(EYA_USIZE_T_MAX / 2 + 1, numerators);
+    divider_expect_exact(EYA_USIZE_T_MAX / 2 + 2, numerators);
+}
+
+TEST(eya_divider_init, rejects_zero_divisor)
+{
+    eya_divider_t divider;
+
+    EXPECT_DEATH(eya_divider_init(&divider, 0), ".*");
+    EXPECT_DEATH(eya_divider_init(nullptr, 3), ".*");
+}
+
+TEST(eya_memory_typed_update_divider, counts_elements_of_odd_size)
+{
+    unsigned char bytes[12 * 10];
+
+    eya_memory_typed_t typed = eya_memory_typed_make(bytes, bytes + sizeof(bytes), 12);
+    EXPECT_EQ(typed.element_divider.divisor, 12u);
+    EXPECT_EQ(eya_memory_typed_get_size(&typed), 10u);
+
+    // A directly assigned element size falls back to a division.
+    typed.element_size = 24;
+    EXPECT_EQ(eya_memory_typed_get_size(&typed), 5u);
+
+    typed.element_size = 7;
+    EXPECT_FALSE(eya_memory_typed_is_valid(&typed));
+
+    eya_memory_typed_update_divider(&typed);
+    EXPECT_EQ(typed.element_divider.divisor, 7u);
+    EXPECT_FALSE(eya_memory_typed_is_valid(&typed));
+
+    eya_array_t array = eya_array_make(24, 100);
+    EXPECT_EQ(eya_array_capacity(&array), 100u);
+    eya_array_reserve(&array, 50);
+    EXPECT_GE(eya_array_capacity(&array), 150u);
+    eya_array_free(&array);
+}
@@ -0,0 +1,269 @@
+#include <eya/memory_allocator.h>
+#include <eya/thread.h>
+#include <eya/ebr.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static constexpr std::uint64_t ebr_magic = 0x0123456789ABCDEFull;
+
+static std::atomic<long> ebr_allocations{0};
+
+static void *
+ebr_test_alloc(eya_usize_t size)
+{
+    // The size is kept in front of the block, so freed blocks can be poisoned.
+    auto *block = static_cast<std::uint64_t *>(malloc(size + 16));
+    block[0]    = size;
+    ebr_allocations.fetch_add(1);
+    return block + 2;
+}
+
+static void
+ebr_test_free(void *ptr)
+{
+    if (!ptr)
+        return;
+
+    auto *block = static_cast<std::uint64_t *>(ptr) - 2;
+    std::memset(ptr, 0xDD, block[0]);
+    ebr_allocations.fetch_sub(1);
+    free(block);
+}
+
+static const eya_memory_allocator_t ebr_allocator = {ebr_test_alloc, ebr_test_free};
+
+static std::uint64_t *
+ebr_node_make(void)
+{
+    auto *node = static_cast<std::uint64_t *>(ebr_test_alloc(sizeof(std::uint64_t)));
+    *node      = ebr_magic;
+    return node;
+}
+
+static void
+ebr_pass(eya_ebr_t *ebr)
+{
+    eya_ebr_guard_t *guard = eya_ebr_enter(ebr);
+    eya_ebr_flush(guard);
+    eya_ebr_exit(guard);
+}
+
+struct ebr_reader
+{
+    eya_ebr_t        *ebr;
+    std::atomic<int> *state;
+};
+
+static void
+ebr_hold_section(void *arg)
+{
+    auto            *reader = static_cast<ebr_reader *>(arg);
+    eya_ebr_guard_t *guard  = eya_ebr_enter(reader->ebr);
+
+    reader->state->store(1);
+    while (reader->state->load() != 2)
+        eya_thread_yield();
+
+    eya_ebr_exit(guard);
+}
+
+static void
+ebr_retire_once(void *arg)
+{
+    auto            *ebr   = static_cast<eya_ebr_t *>(arg);
+    eya_ebr_guard_t *guard = eya_ebr_enter(ebr);
+
+    eya_ebr_retire(guard, ebr_node_make());
+    eya_ebr_exit(guard);
+}
+
+struct ebr_shared
+{
+    eya_ebr_t                   ebr;
+    std::atomic<std::uint64_t *> node;
+    std::atomic<int>             writers;
+    std::atomic<int>             errors;
+};
+
+static void
+ebr_replace_nodes(void *arg)
+{
+    auto *shared = static_cast<ebr_shared *>(arg);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        eya_ebr_guard_t *guard = eya_ebr_enter(&shared->ebr);
+        eya_ebr_retire(guard, shared->node.exchange(ebr_node_make()));
+        eya_ebr_exit(guard);
+    }
+    shared->writers.fetch_sub(1);
+}
+
+static void
+ebr_read_nodes(void *arg)
+{
+    auto *shared = static_cast<ebr_shared *>(arg);
+
+    while (shared->writers.load())
+    {
+        eya_ebr_guard_t *guard = eya_ebr_enter(&shared->ebr);
+        if (*shared->node.load() != ebr_magic)
+            shared->errors.fetch_add(1);
+        eya_ebr_exit(guard);
+    }
+}
+
+TEST(eya_ebr_enter, reuses_record_of_calling_thread)
+{
+    eya_ebr_t ebr;
+    eya_ebr_init(&ebr, &ebr_allocator);
+
+    eya_ebr_guard_t *outer = eya_ebr_enter(&ebr);
+    eya_ebr_guard_t *inner = eya_ebr_enter(&ebr);
+    EXPECT_NE(outer, inner);
+    eya_ebr_exit(inner);
+    eya_ebr_exit(outer);
+
+    eya_ebr_guard_t *again = eya_ebr_enter(&ebr);
+    EXPECT_TRUE(again == outer || again == inner);
+    eya_ebr_exit(again);
+
+    eya_ebr_destroy(&ebr);
+    EXPECT_EQ(ebr_allocations.load(), 0);
+}
+
+TEST(eya_ebr_enter, handles_invalid_arguments)
+{
+    EXPECT_DEATH(eya_ebr_init(nullptr, nullptr), ".*");
+    EXPECT_DEATH(eya_ebr_destroy(nullptr), ".*");
+    EXPECT_DEATH(eya_ebr_enter(nullptr), ".*");
+    EXPECT_DEATH(eya_ebr_exit(nullptr), ".*");
+    EXPECT_DEATH(eya_ebr_retire(nullptr, nullptr), ".*");
+    EXPECT_DEATH(eya_ebr_flush(nullptr), ".*");
+}
+
+TEST(eya_ebr_retire, frees_after_two_epochs)
+{
+    eya_ebr_t ebr;
+    eya_ebr_init(&ebr, &ebr_allocator);
+
+    eya_ebr_guard_t *guard = eya_ebr_enter(&ebr);
+    eya_ebr_retire(guard, ebr_node_make());
+    eya_ebr_retire(guard, nullptr);
+    eya_ebr_flush(guard);
+    eya_ebr_exit(guard);
+
+    const long pending = ebr_allocations.load();
+    EXPECT_GT(pending, 1);
+
+    // The retiring section itself keeps the node until the next one.
+    ebr_pass(&ebr);
+    EXPECT_EQ(ebr_allocations.load(), pending - 1);
+
+    eya_ebr_destroy(&ebr);
+    EXPECT_EQ(ebr_allocations.load(), 0);
+}
+
+TEST(eya_ebr_retire, waits_for_active_sections)
+{
+    eya_ebr_t        ebr;
+    std::atomic<int> state{0};
+    ebr_reader       reader{&ebr, &state};
+    eya_thread_t     thread;
+
+    eya_ebr_init(&ebr, &ebr_allocator);
+    eya_thread_create(&thread, ebr_hold_section, &reader);
+    while (state.load() != 1)
+        eya_thread_yield();
+
+    eya_ebr_guard_t *guard = eya_ebr_enter(&ebr);
+    eya_ebr_retire(guard, ebr_node_make());
+    eya_ebr_exit(guard);
+
+    const long pending = ebr_allocations.load();
+    for (int i = 0; i < 10; ++i)
+        ebr_pass(&ebr);
+    EXPECT_EQ(ebr_allocations.load(), pending);
+
+    state.store(2);
+    eya_thread_join(&thread);
+
+    ebr_pass(&ebr);
+    ebr_pass(&ebr);
+    EXPECT_LT(ebr_allocations.load(), pending);
+
+    eya_ebr_destroy(&ebr);
+    EXPECT_EQ(ebr_allocations.load(), 0);
+}
+
+TEST(eya_ebr_flush, frees_batches_of_idle_records)
+{
+    eya_ebr_t    ebr;
+    eya_thread_t thread;
+
+    eya_ebr_init(&ebr, &ebr_allocator);
+
+    // The open section makes the other thread retire into a record of its own.
+    eya_ebr_guard_t *guard = eya_ebr_enter(&ebr);
+    eya_thread_create(&thread, ebr_retire_once, &ebr);
+    eya_thread_join(&thread);
+    eya_ebr_exit(guard);
+
+    const long pending = ebr_allocations.load();
+    for (int i = 0; i < 3; ++i)
+        ebr_pass(&ebr);
+    EXPECT_EQ(ebr_allocations.load(), pending - 1);
+
+    eya_ebr_destroy(&ebr);
+    EXPECT_EQ(ebr_allocations.load(), 0);
+}
+
+TEST(eya_ebr_retire, collects_full_batches)
+{
+    eya_ebr_t ebr;
+    eya_ebr_init(&ebr, &ebr_allocator);
+
+    for (int i = 0; i < 4 * EYA_LIBRARY_OPTION_EBR_BATCH_SIZE; ++i)
+    {
+        eya_ebr_guard_t *guard = eya_ebr_enter(&ebr);
+        eya_ebr_retire(guard, ebr_node_make());
+        eya_ebr_exit(guard);
+    }
+
+    // Without any flush, only the batches closed by the last retires may remain.
+    EXPECT_LE(ebr_allocations.load(), 3 * EYA_LIBRARY_OPTION_EBR_BATCH_SIZE);
+
+    eya_ebr_destroy(&ebr);
+    EXPECT_EQ(ebr_allocations.load(), 0);
+}
+
+TEST(eya_ebr_retire, protects_nodes_loaded_by_readers)
+{
+    constexpr int writers = 2;
+    constexpr int readers = 2;
+
+    ebr_shared shared;
+    eya_ebr_init(&shared.ebr, &ebr_allocator);
+    shared.node    = ebr_node_make();
+    shared.writers = writers;
+    shared.errors  = 0;
+
+    std::vector<eya_thread_t> handles(writers + readers);
+    for (int i = 0; i < readers; ++i)
+        eya_thread_create(&handles[i], ebr_read_nodes, &shared);
+    for (int i = 0; i < writers; ++i)
+        eya_thread_create(&handles[readers + i], ebr_replace_nodes, &shared);
+    for (auto &handle : handles)
+        eya_thread_join(&handle);
+
+    EXPECT_EQ(shared.errors.load(), 0);
+
+    ebr_test_free(shared.node.load());
+    eya_ebr_destroy(&shared.ebr);
+    EXPECT_EQ(ebr_allocations.load(), 0);
+}
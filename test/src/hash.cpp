@@ -0,0 +1,164 @@
+#include <eya/hash.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+/**
+ * Reference values of XXH3_64bits_withSeed() and XXH3_128bits_withSeed()
+ * from xxHash 0.8, over the bytes `(i * 7 + 3) & 0xFF`.
+ */
+struct hash_reference
+{
+    eya_usize_t  size;
+    eya_ullong_t seed;
+    eya_ullong_t hash64;
+    eya_ullong_t low;
+    eya_ullong_t high;
+};
+
+static const hash_reference hash_references[] = {
+    {0, 0x0ull, 0x2D06800538D394C2ull, 0x6001C324468D497Full, 0x99AA06D3014798D8ull},
+    {0, 0x9E3779B97F4A7C15ull, 0x602B0E2CD6662C8Bull, 0x4CA5176998171787ull, 0xD142977A2CCA554Bull},
+    {1, 0x0ull, 0x13E608BC156DEFEDull, 0x13E608BC156DEFEDull, 0x22BBB76B211A39BAull},
+    {1, 0x9E3779B97F4A7C15ull, 0x1B4C466098160569ull, 0x1B4C466098160569ull, 0x8B0BDE64EBB5391Aull},
+    {3, 0x0ull, 0xA9088DDA485B481Cull, 0xA9088DDA485B481Cull, 0xCE31763CBF8245A5ull},
+    {3, 0x9E3779B97F4A7C15ull, 0xA8BACD847619199Eull, 0xA8BACD847619199Eull, 0xA6C5358DFF93AF85ull},
+    {4, 0x0ull, 0x6D9253B16C8B1ED3ull, 0x788A609154B0FE20ull, 0x47197970590746B1ull},
+    {4, 0x9E3779B97F4A7C15ull, 0xE1C585329CF1878Eull, 0x94C1979D995C4870ull, 0x7FBDADE8669A4AB0ull},
+    {8, 0x0ull, 0x60539DB630471163ull, 0x3CD024E3D63A1588ull, 0xE3BC8A5F46171555ull},
+    {8, 0x9E3779B97F4A7C15ull, 0xBC53D62E02F670A4ull, 0xDE775C059292F841ull, 0xD63852876FE8A157ull},
+    {9, 0x0ull, 0xFEFF668361D723A8ull, 0xEAFAB1C7F123109Full, 0xC72C88247A9A56D7ull},
+    {9, 0x9E3779B97F4A7C15ull, 0xD4FB426F424E6E62ull, 0x51E1392707D4BBB9ull, 0x0B38A113B694FCAEull},
+    {16, 0x0ull, 0xB8C859B0F030B585ull, 0x60D75C5E47D40A24ull, 0xCE0B9647AB24F884ull},
+    {16, 0x9E3779B97F4A7C15ull, 0x7775D23337D796B5ull, 0x525DA27D50E50D60ull, 0x4F914088F379A471ull},
+    {17, 0x0ull, 0x714A04408E79B80Full, 0xEEED7654312A26D7ull, 0xBFD327EDCC2FBD12ull},
+    {17, 0x9E3779B97F4A7C15ull, 0x7D1872B1361C0FA6ull, 0x3445A39302223BAFull, 0xA61A1CA6A6CBA50Bull},
+    {128, 0x0ull, 0x67425A03650261BFull, 0xC580008B6C92AC53ull, 0x1B1962A096BAC78Bull},
+    {128, 0x9E3779B97F4A7C15ull, 0xE9E239440DAC1B3Cull, 0x11B625103E3F16E8ull, 0x0E547FAD963E783Eull},
+    {129, 0x0ull, 0xC664BF3311C6ABC4ull, 0xBD91CE7ACE4D385Bull, 0x293E4968C4619023ull},
+    {129, 0x9E3779B97F4A7C15ull, 0xB11455AB08C506D4ull, 0xFB2FDD6E76E6384Full, 0xB29AA6B7F2BDB673ull},
+    {240, 0x0ull, 0x64556DC6B462A6CFull, 0x04E0B5F034BEE80Bull, 0xAD46C1021B076BC7ull},
+    {240, 0x9E3779B97F4A7C15ull, 0x6EA73B2BE19B57C5ull, 0xECAE892A3FAC66C3ull, 0x9BD1B9F5F322C628ull},
+    {241, 0x0ull, 0x8BEADD3A8874FE17ull, 0x8BEADD3A8874FE17ull, 0xAC6C3492C3D6B45Dull},
+    {241, 0x9E3779B97F4A7C15ull, 0xA0462D397650B282ull, 0xA0462D397650B282ull, 0x44BD02453C9C891Cull},
+    {1024, 0x0ull, 0x9B81661C641C72B1ull, 0x9B81661C641C72B1ull, 0x18BC0EACA9A33636ull},
+    {1024, 0x9E3779B97F4A7C15ull, 0xE955D0AFE88A0F51ull, 0xE955D0AFE88A0F51ull, 0x3C6F1311239E88B0ull},
+    {1025, 0x0ull, 0x806C2072ED713576ull, 0x806C2072ED713576ull, 0xBF447251CFA98D7Cull},
+    {1025, 0x9E3779B97F4A7C15ull, 0xCBDB289911B2614Bull, 0xCBDB289911B2614Bull, 0xD89D1BD7F4FD6811ull},
+    {5000, 0x0ull, 0x799AADDD7339581Dull, 0x799AADDD7339581Dull, 0xC98AE385D09887CCull},
+    {5000, 0x9E3779B97F4A7C15ull, 0x4EAE2D7F035DB6BBull, 0x4EAE2D7F035DB6BBull, 0x97456F98EC4C2DF0ull},
+};
+
+static std::vector<eya_uchar_t>
+hash_pattern(eya_usize_t size)
+{
+    std::vector<eya_uchar_t> bytes(size);
+    for (eya_usize_t i = 0; i < size; ++i)
+        bytes[i] = static_cast<eya_uchar_t>(i * 7 + 3);
+    return bytes;
+}
+
+TEST(eya_hash64, matches_reference_values)
+{
+    const std::vector<eya_uchar_t> bytes = hash_pattern(5000);
+
+    for (const hash_reference &ref : hash_references)
+    {
+        EXPECT_EQ(eya_hash64(bytes.data(), ref.size, ref.seed), ref.hash64) << ref.size;
+
+        const eya_hash128_t hash = eya_hash128(bytes.data(), ref.size, ref.seed);
+        EXPECT_EQ(hash.low, ref.low) << ref.size;
+        EXPECT_EQ(hash.high, ref.high) << ref.size;
+    }
+
+    EXPECT_EQ(eya_hash64(nullptr, 0, 0), hash_references[0].hash64);
+    EXPECT_DEATH(eya_hash64(nullptr, 1, 0), ".*");
+    EXPECT_DEATH(eya_hash128(nullptr, 1, 0), ".*");
+}
+
+TEST(eya_hash64, depends_on_every_byte_and_the_seed)
+{
+    std::vector<eya_uchar_t> bytes = hash_pattern(3000);
+
+    for (eya_usize_t size : {1u, 5u, 12u, 40u, 200u, 1500u, 3000u})
+    {
+        const eya_ullong_t hash = eya_hash64(bytes.data(), size, 0);
+
+        EXPECT_NE(eya_hash64(bytes.data(), size, 1), hash);
+        for (eya_usize_t i : {eya_usize_t(0), size / 2, size - 1})
+        {
+            bytes[i] ^= 1;
+            EXPECT_NE(eya_hash64(bytes.data(), size, 0), hash) << size << " " << i;
+            bytes[i] ^= 1;
+        }
+    }
+}
+
+TEST(eya_hash64_range, hashes_the_bytes_of_the_range)
+{
+    std::vector<eya_uchar_t> bytes = hash_pattern(300);
+    eya_memory_range_t       range = {bytes.data(), bytes.data() + bytes.size()};
+
+    EXPECT_EQ(eya_hash64_range(&range, 5), eya_hash64(bytes.data(), bytes.size(), 5));
+
+    const eya_hash128_t expected = eya_hash128(bytes.data(), bytes.size(), 5);
+    const eya_hash128_t actual   = eya_hash128_range(&range, 5);
+    EXPECT_EQ(actual.low, expected.low);
+    EXPECT_EQ(actual.high, expected.high);
+
+    EXPECT_DEATH(eya_hash64_range(nullptr, 0), ".*");
+    EXPECT_DEATH(eya_hash128_range(nullptr, 0), ".*");
+}
+
+TEST(eya_hash_update, matches_one_shot_for_any_split)
+{
+    const std::vector<eya_uchar_t> bytes = hash_pattern(2100);
+    std::mt19937                   random(42);
+
+    for (eya_usize_t size = 0; size <= bytes.size(); size += size < 600 ? 1 : 13)
+    {
+        const eya_ullong_t seed = size * 0x9E3779B97F4A7C15ull;
+
+        eya_hash_state_t state;
+        eya_hash_init(&state, seed);
+
+        for (eya_usize_t offset = 0; offset < size;)
+        {
+            eya_usize_t chunk = random() % 300;
+            if (chunk > size - offset)
+                chunk = size - offset;
+
+            eya_hash_update(&state, bytes.data() + offset, chunk);
+            offset += chunk;
+        }
+
+        ASSERT_EQ(eya_hash_digest64(&state), eya_hash64(bytes.data(), size, seed)) << size;
+
+        const eya_hash128_t expected = eya_hash128(bytes.data(), size, seed);
+        const eya_hash128_t actual   = eya_hash_digest128(&state);
+        ASSERT_EQ(actual.low, expected.low) << size;
+        ASSERT_EQ(actual.high, expected.high) << size;
+    }
+}
+
+TEST(eya_hash_update, continues_after_a_digest)
+{
+    const std::vector<eya_uchar_t> bytes = hash_pattern(5000);
+
+    eya_hash_state_t state;
+    eya_hash_init(&state, 0);
+    eya_hash_update(&state, nullptr, 0);
+
+    for (eya_usize_t offset = 0; offset < bytes.size(); offset += 1000)
+    {
+        eya_hash_update(&state, bytes.data() + offset, 1000);
+        EXPECT_EQ(eya_hash_digest64(&state), eya_hash64(bytes.data(), offset + 1000, 0));
+    }
+
+    EXPECT_DEATH(eya_hash_init(nullptr, 0), ".*");
+    EXPECT_DEATH(eya_hash_update(nullptr, bytes.data(), 1), ".*");
+    EXPECT_DEATH(eya_hash_update(&state, nullptr, 1), ".*");
+    EXPECT_DEATH(eya_hash_digest64(nullptr), ".*");
+    EXPECT_DEATH(eya_hash_digest128(nullptr), ".*");
+}
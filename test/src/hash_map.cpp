@@ -0,0 +1,284 @@
+#include <eya/hash_map.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+struct hash_map_key
+{
+    std::uint32_t id;
+    std::uint8_t  kind[12];
+};
+
+struct hash_map_worker
+{
+    eya_hash_map_t    *map;
+    std::uint64_t      first;
+    std::uint64_t      count;
+    std::atomic<bool> *done;
+    std::atomic<int>  *errors;
+};
+
+static eya_usize_t
+hash_map_constant_hash(const void *, eya_usize_t)
+{
+    return 42;
+}
+
+static std::atomic<int> hash_map_allocations{0};
+
+static void *
+hash_map_test_alloc(eya_usize_t size)
+{
+    hash_map_allocations.fetch_add(1);
+    return malloc(size);
+}
+
+static void
+hash_map_test_free(void *ptr)
+{
+    if (ptr)
+        hash_map_allocations.fetch_sub(1);
+    free(ptr);
+}
+
+static void
+hash_map_write(void *arg)
+{
+    auto *worker = static_cast<hash_map_worker *>(arg);
+
+    for (std::uint64_t i = worker->first; i < worker->first + worker->count; ++i)
+    {
+        const std::uint64_t value = i * 3;
+        eya_hash_map_insert(worker->map, &i, &value);
+        if (i % 2)
+            eya_hash_map_erase(worker->map, &i);
+    }
+}
+
+static void
+hash_map_read(void *arg)
+{
+    auto *worker = static_cast<hash_map_worker *>(arg);
+
+    while (!worker->done->load())
+    {
+        // Keys inserted before the writers started stay visible during every resize.
+        for (std::uint64_t i = 0; i < worker->count; ++i)
+        {
+            std::uint64_t value = 0;
+            if (!eya_hash_map_find(worker->map, &i, &value) || value != i * 3)
+                worker->errors->fetch_add(1);
+        }
+        eya_thread_yield();
+    }
+}
+
+TEST(eya_hash_map_make, creates_empty_map)
+{
+    eya_hash_map_t *map = eya_hash_map_make(sizeof(int), sizeof(int), nullptr, nullptr);
+    const int       key = 1;
+
+    EXPECT_EQ(eya_hash_map_get_size(map), 0u);
+    EXPECT_FALSE(eya_hash_map_find(map, &key, nullptr));
+    EXPECT_FALSE(eya_hash_map_erase(map, &key));
+
+    eya_hash_map_free(map);
+}
+
+TEST(eya_hash_map_make, handles_invalid_arguments)
+{
+    EXPECT_DEATH(eya_hash_map_make(0, 4, nullptr, nullptr), ".*");
+    EXPECT_DEATH(eya_hash_map_make(EYA_USIZE_T_MAX, 4, nullptr, nullptr), ".*");
+    EXPECT_DEATH(eya_hash_map_make(4, EYA_USIZE_T_MAX - 4, nullptr, nullptr), ".*");
+    EXPECT_DEATH(eya_hash_map_free(nullptr), ".*");
+}
+
+TEST(eya_hash_map_make, takes_memory_from_allocator)
+{
+    const eya_memory_allocator_t allocator = {hash_map_test_alloc, hash_map_test_free};
+    eya_hash_map_t *map = eya_hash_map_make(sizeof(int), sizeof(int), nullptr, &allocator);
+
+    for (int i = 0; i < 5000; ++i)
+        eya_hash_map_insert(map, &i, &i);
+
+    EXPECT_GT(hash_map_allocations.load(), 0);
+    eya_hash_map_free(map);
+    EXPECT_EQ(hash_map_allocations.load(), 0);
+}
+
+TEST(eya_hash_map_insert, replaces_value_of_present_key)
+{
+    eya_hash_map_t *map = eya_hash_map_make(sizeof(hash_map_key), sizeof(int), nullptr, nullptr);
+    hash_map_key    key{7, {}};
+    int             value = 1;
+
+    key.kind[11] = 5;
+    EXPECT_TRUE(eya_hash_map_insert(map, &key, &value));
+
+    value = 2;
+    EXPECT_FALSE(eya_hash_map_insert(map, &key, &value));
+    EXPECT_EQ(eya_hash_map_get_size(map), 1u);
+
+    value = 0;
+    EXPECT_TRUE(eya_hash_map_find(map, &key, &value));
+    EXPECT_EQ(value, 2);
+
+    // Keys differing only in the last byte are distinct.
+    key.kind[11] = 6;
+    EXPECT_FALSE(eya_hash_map_find(map, &key, &value));
+
+    EXPECT_DEATH(eya_hash_map_insert(map, &key, nullptr), ".*");
+    EXPECT_DEATH(eya_hash_map_insert(map, nullptr, &value), ".*");
+    EXPECT_DEATH(eya_hash_map_find(nullptr, &key, &value), ".*");
+
+    eya_hash_map_free(map);
+}
+
+TEST(eya_hash_map_insert, grows_segments_past_many_keys)
+{
+    eya_hash_map_t *map = eya_hash_map_make(sizeof(std::uint64_t), 0, nullptr, nullptr);
+
+    for (std::uint64_t i = 0; i < 100000; ++i)
+        ASSERT_TRUE(eya_hash_map_insert(map, &i, nullptr));
+    EXPECT_EQ(eya_hash_map_get_size(map), 100000u);
+
+    for (std::uint64_t i = 0; i < 100000; ++i)
+        ASSERT_TRUE(eya_hash_map_find(map, &i, nullptr));
+
+    const std::uint64_t absent = 100000;
+    EXPECT_FALSE(eya_hash_map_find(map, &absent, nullptr));
+
+    eya_hash_map_free(map);
+}
+
+TEST(eya_hash_map_insert, uses_custom_hash_function)
+{
+    // Every key collides, so all of them share one segment and one probe sequence.
+    eya_hash_map_t *map =
+        eya_hash_map_make(sizeof(int), sizeof(int), hash_map_constant_hash, nullptr);
+
+    for (int i = 0; i < 200; ++i)
+        ASSERT_TRUE(eya_hash_map_insert(map, &i, &i));
+
+    for (int i = 0; i < 200; ++i)
+    {
+        int value = -1;
+        ASSERT_TRUE(eya_hash_map_find(map, &i, &value));
+        EXPECT_EQ(value, i);
+    }
+
+    eya_hash_map_free(map);
+}
+
+TEST(eya_hash_map_insert, keeps_every_key_while_a_segment_drains)
+{
+    // A single probe sequence makes every insert interleave with a partial migration.
+    eya_hash_map_t *map =
+        eya_hash_map_make(sizeof(int), sizeof(int), hash_map_constant_hash, nullptr);
+
+    for (int i = 0; i < 300; ++i)
+    {
+        ASSERT_TRUE(eya_hash_map_insert(map, &i, &i));
+
+        const int first = 0;
+        const int value = -i;
+        if (i % 3 == 1)
+            EXPECT_FALSE(eya_hash_map_insert(map, &first, &value));
+        if (i % 5 == 4)
+            ASSERT_TRUE(eya_hash_map_erase(map, &i));
+
+        for (int j = 1; j <= i; ++j)
+        {
+            int found = -1;
+            EXPECT_EQ(eya_hash_map_find(map, &j, &found), j % 5 != 4);
+            if (j % 5 != 4)
+                EXPECT_EQ(found, j);
+        }
+    }
+
+    const int first = 0;
+    int       found = 0;
+    ASSERT_TRUE(eya_hash_map_find(map, &first, &found));
+    EXPECT_EQ(found, -298);
+    EXPECT_EQ(eya_hash_map_get_size(map), 240u);
+
+    eya_hash_map_free(map);
+}
+
+TEST(eya_hash_map_erase, reuses_erased_slots)
+{
+    eya_hash_map_t *map = eya_hash_map_make(sizeof(int), sizeof(int), nullptr, nullptr);
+
+    for (int round = 0; round < 50; ++round)
+    {
+        for (int i = 0; i < 1000; ++i)
+            ASSERT_TRUE(eya_hash_map_insert(map, &i, &round));
+        for (int i = 0; i < 1000; i += 2)
+            ASSERT_TRUE(eya_hash_map_erase(map, &i));
+        for (int i = 1; i < 1000; i += 2)
+            ASSERT_TRUE(eya_hash_map_erase(map, &i));
+    }
+
+    EXPECT_EQ(eya_hash_map_get_size(map), 0u);
+    const int key = 3;
+    EXPECT_FALSE(eya_hash_map_find(map, &key, nullptr));
+    EXPECT_DEATH(eya_hash_map_erase(map, nullptr), ".*");
+
+    eya_hash_map_free(map);
+}
+
+TEST(eya_hash_map_find, sees_stable_keys_while_writers_resize)
+{
+    constexpr int           writers = 2;
+    constexpr int           readers = 2;
+    constexpr std::uint64_t stable  = 256;
+    constexpr std::uint64_t count   = 20000;
+
+    eya_hash_map_t   *map =
+        eya_hash_map_make(sizeof(std::uint64_t), sizeof(std::uint64_t), nullptr, nullptr);
+    std::atomic<bool> done{false};
+    std::atomic<int>  errors{0};
+
+    for (std::uint64_t i = 0; i < stable; ++i)
+    {
+        const std::uint64_t value = i * 3;
+        eya_hash_map_insert(map, &i, &value);
+    }
+
+    std::vector<hash_map_worker> workers(writers + readers);
+    std::vector<eya_thread_t>    handles(writers + readers);
+
+    for (int i = 0; i < readers; ++i)
+    {
+        workers[i] = {map, 0, stable, &done, &errors};
+        eya_thread_create(&handles[i], hash_map_read, &workers[i]);
+    }
+    for (int i = 0; i < writers; ++i)
+    {
+        workers[readers + i] = {map, stable + i * count, count, &done, &errors};
+        eya_thread_create(&handles[readers + i], hash_map_write, &workers[readers + i]);
+    }
+
+    for (int i = 0; i < writers; ++i)
+        eya_thread_join(&handles[readers + i]);
+    done = true;
+    for (int i = 0; i < readers; ++i)
+        eya_thread_join(&handles[i]);
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(eya_hash_map_get_size(map), stable + writers * count / 2);
+
+    for (std::uint64_t i = stable; i < stable + writers * count; ++i)
+    {
+        std::uint64_t value = 0;
+        ASSERT_EQ(eya_hash_map_find(map, &i, &value), i % 2 == 0);
+        if (i % 2 == 0)
+            ASSERT_EQ(value, i * 3);
+    }
+
+    eya_hash_map_free(map);
+}
@@ -0,0 +1,163 @@
+#include <eya/numeric_limits.h>
+#include <eya/hex.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+static std::vector<eya_uchar_t>
+hex_random(eya_usize_t size)
+{
+    std::mt19937             random(11);
+    std::vector<eya_uchar_t> bytes(size);
+
+    for (eya_uchar_t &byte : bytes)
+        byte = static_cast<eya_uchar_t>(random());
+    return bytes;
+}
+
+static eya_memory_range_t
+hex_range(const void *data, eya_usize_t size)
+{
+    eya_uchar_t *begin = static_cast<eya_uchar_t *>(const_cast<void *>(data));
+    return {begin, begin + size};
+}
+
+/**
+ * Decodes into a buffer of the right size, returning the number of bytes.
+ */
+static eya_usize_t
+hex_decode(const std::string &text)
+{
+    std::vector<eya_uchar_t> bytes(text.size() / 2 + 1);
+    const eya_memory_range_t dst = hex_range(bytes.data(), bytes.size());
+    const eya_memory_range_t src = hex_range(text.data(), text.size());
+
+    return eya_hex_decode(&dst, &src);
+}
+
+// Runs every test with the scalar loop and with the vector code where the CPU has it.
+class hex_test : public ::testing::TestWithParam<eya_uint_t>
+{
+protected:
+    void
+    SetUp() override
+    {
+        eya_hex_set_cpu_features(GetParam());
+    }
+
+    void
+    TearDown() override
+    {
+        eya_hex_set_cpu_features(EYA_UINT_T_MAX);
+    }
+};
+
+TEST_P(hex_test, encode_writes_lowercase_digits)
+{
+    const eya_uchar_t        bytes[] = {0x00, 0x01, 0x7F, 0xAB, 0xFF};
+    char                     text[11] = {};
+    const eya_memory_range_t dst      = hex_range(text, 10);
+    const eya_memory_range_t src      = hex_range(bytes, sizeof(bytes));
+
+    EXPECT_EQ(eya_hex_encode(&dst, &src), 10u);
+    EXPECT_STREQ(text, "00017fabff");
+
+    const eya_memory_range_t small = hex_range(text, 9);
+    EXPECT_DEATH(eya_hex_encode(&small, &src), ".*");
+    EXPECT_DEATH(eya_hex_encode(nullptr, &src), ".*");
+}
+
+TEST_P(hex_test, encode_round_trips_all_sizes_and_alignments)
+{
+    const std::vector<eya_uchar_t> bytes = hex_random(400);
+
+    for (eya_usize_t size = 0; size <= 300; ++size)
+        for (eya_usize_t offset = 0; offset < 2; ++offset)
+        {
+            std::string expected;
+            char        pair[3];
+            for (eya_usize_t i = 0; i < size; ++i)
+            {
+                std::snprintf(pair, sizeof(pair), "%02x", bytes[offset + i]);
+                expected += pair;
+            }
+
+            std::string              text(2 * size + 1, '#');
+            const eya_memory_range_t src = hex_range(bytes.data() + offset, size);
+            const eya_memory_range_t dst = hex_range(&text[0], text.size());
+
+            ASSERT_EQ(eya_hex_encode(&dst, &src), 2 * size);
+            ASSERT_EQ(text.substr(0, 2 * size), expected) << size;
+            ASSERT_EQ(text.back(), '#');
+
+            // Upper case digits decode to the same bytes.
+            for (char &c : expected)
+                c = static_cast<char>(std::toupper(c));
+
+            std::vector<eya_uchar_t> decoded(size + 1, 0xA5);
+            const eya_memory_range_t digits = hex_range(expected.data(), expected.size());
+            const eya_memory_range_t out    = hex_range(decoded.data(), decoded.size());
+
+            ASSERT_EQ(eya_hex_decode(&out, &digits), size);
+            ASSERT_TRUE(std::equal(decoded.begin(), decoded.end() - 1, bytes.begin() + offset));
+            ASSERT_EQ(decoded.back(), 0xA5);
+        }
+}
+
+TEST_P(hex_test, decode_rejects_invalid_digits)
+{
+    const std::string valid(200, 'a');
+
+    EXPECT_EQ(hex_decode(valid), 100u);
+    EXPECT_DEATH(hex_decode("abc"), ".*");
+
+    for (char c : {'g', 'G', '/', ':', '@', '`', ' ', '\0', '\x80', '\xe1'})
+        for (eya_usize_t position : {0u, 1u, 63u, 64u, 127u, 150u, 199u})
+        {
+            std::string text = valid;
+            text[position]   = c;
+            EXPECT_DEATH(hex_decode(text), ".*") << static_cast<int>(c) << " " << position;
+        }
+}
+
+TEST(eya_hex_size, reports_exact_sizes)
+{
+    EXPECT_EQ(eya_hex_encode_size(0), 0u);
+    EXPECT_EQ(eya_hex_encode_size(7), 14u);
+    EXPECT_EQ(eya_hex_decode_size(14), 7u);
+    EXPECT_DEATH(eya_hex_decode_size(3), ".*");
+    EXPECT_DEATH(eya_hex_encode_size(static_cast<eya_usize_t>(-1) / 2 + 1), ".*");
+}
+
+TEST_P(hex_test, append_grows_a_byte_array)
+{
+    const std::vector<eya_uchar_t> bytes = hex_random(100);
+    const eya_memory_range_t       src   = hex_range(bytes.data(), bytes.size());
+    eya_array_t                    text  = eya_array_make(1, 0);
+    eya_array_t                    back  = eya_array_make(1, 0);
+
+    EXPECT_EQ(eya_hex_encode_append(&text, &src), 200u);
+    EXPECT_EQ(eya_hex_encode_append(&text, &src), 200u);
+    ASSERT_EQ(eya_array_get_size(&text), 400u);
+
+    const eya_memory_range_t digits = hex_range(eya_array_get_begin(&text), 400);
+    EXPECT_EQ(eya_hex_decode_append(&back, &digits), 200u);
+    ASSERT_EQ(eya_array_get_size(&back), 200u);
+
+    const eya_uchar_t *decoded = static_cast<const eya_uchar_t *>(eya_array_get_begin(&back));
+    EXPECT_TRUE(std::equal(bytes.begin(), bytes.end(), decoded));
+    EXPECT_TRUE(std::equal(bytes.begin(), bytes.end(), decoded + 100));
+
+    eya_array_t wide = eya_array_make(4, 0);
+    EXPECT_DEATH(eya_hex_encode_append(&wide, &src), ".*");
+
+    eya_array_free(&wide);
+    eya_array_free(&back);
+    eya_array_free(&text);
+}
+
+INSTANTIATE_TEST_SUITE_P(eya_hex,
+                         hex_test,
+                         ::testing::Values(0u, EYA_UINT_T_MAX));
@@ -0,0 +1,197 @@
+#include <eya/runtime_allocator.h>
+#include <eya/io_async.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <vector>
+
+#if defined(_WIN32)
+#    include <io.h>
+#    define fileno _fileno
+#endif
+
+class io_async_test : public ::testing::TestWithParam<eya_io_async_backend_t>
+{
+protected:
+    void
+    SetUp() override
+    {
+        file = std::tmpfile();
+        ASSERT_NE(file, nullptr);
+        fd = fileno(file);
+        io = eya_io_async_make(8, GetParam());
+    }
+
+    void
+    TearDown() override
+    {
+        eya_io_async_free(io);
+        std::fclose(file);
+    }
+
+    std::FILE      *file = nullptr;
+    int             fd   = -1;
+    eya_io_async_t *io   = nullptr;
+};
+
+static eya_allocated_range_t
+make_range(std::vector<unsigned char> &data)
+{
+    return eya_memory_range_make(data.data(), data.data() + data.size());
+}
+
+TEST_P(io_async_test, writes_then_reads_back_blocks)
+{
+    if (GetParam() != EYA_IO_ASYNC_BACKEND_AUTO)
+    {
+        EXPECT_EQ(eya_io_async_get_backend(io), GetParam());
+    }
+
+    std::vector<unsigned char> out[4];
+    eya_allocated_range_t      out_ranges[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        out[i].assign(4096, static_cast<unsigned char>('a' + i));
+        out_ranges[i] = make_range(out[i]);
+        ASSERT_TRUE(eya_io_async_write(io, fd, i * 4096, &out_ranges[i], &out[i]));
+    }
+    EXPECT_EQ(eya_io_async_get_inflight(io), 4u);
+
+    eya_io_async_completion_t done[8];
+    eya_usize_t               count = 0;
+    while (count < 4)
+        count += eya_io_async_wait(io, done + count, 8 - count, 4 - count);
+
+    EXPECT_EQ(eya_io_async_get_inflight(io), 0u);
+    for (eya_usize_t i = 0; i < count; ++i)
+        EXPECT_EQ(done[i].result, 4096);
+
+    std::vector<unsigned char> in(4 * 4096);
+    eya_allocated_range_t      in_range = make_range(in);
+    ASSERT_TRUE(eya_io_async_read(io, fd, 0, &in_range, nullptr));
+    EXPECT_EQ(eya_io_async_submit(io), 1u);
+    ASSERT_EQ(eya_io_async_wait(io, done, 8, 1), 1u);
+
+    EXPECT_EQ(done[0].user_data, nullptr);
+    EXPECT_EQ(done[0].result, 4 * 4096);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(in[i * 4096 + 17], 'a' + i);
+}
+
+TEST_P(io_async_test, reports_user_data_and_short_reads)
+{
+    std::vector<unsigned char> out(100, 'x');
+    eya_allocated_range_t      out_range = make_range(out);
+    ASSERT_TRUE(eya_io_async_write(io, fd, 0, &out_range, nullptr));
+
+    eya_io_async_completion_t done[1];
+    ASSERT_EQ(eya_io_async_wait(io, done, 1, 1), 1u);
+
+    std::vector<unsigned char> in(1000);
+    eya_allocated_range_t      in_range = make_range(in);
+    int                        tag      = 42;
+    ASSERT_TRUE(eya_io_async_read(io, fd, 50, &in_range, &tag));
+    ASSERT_EQ(eya_io_async_wait(io, done, 1, 1), 1u);
+
+    EXPECT_EQ(done[0].user_data, &tag);
+    EXPECT_EQ(done[0].result, 50);
+}
+
+TEST_P(io_async_test, refuses_requests_beyond_depth)
+{
+    std::vector<unsigned char> data(16);
+    eya_allocated_range_t      range = make_range(data);
+
+    const eya_usize_t depth = eya_io_async_get_depth(io);
+    for (eya_usize_t i = 0; i < depth; ++i)
+        ASSERT_TRUE(eya_io_async_read(io, fd, 0, &range, nullptr));
+    EXPECT_FALSE(eya_io_async_read(io, fd, 0, &range, nullptr));
+
+    std::vector<eya_io_async_completion_t> done(depth);
+    eya_usize_t                            count = 0;
+    while (count < depth)
+        count += eya_io_async_wait(io, done.data() + count, depth - count, depth - count);
+
+    EXPECT_TRUE(eya_io_async_read(io, fd, 0, &range, nullptr));
+    EXPECT_EQ(eya_io_async_wait(io, done.data(), depth, 1), 1u);
+}
+
+TEST_P(io_async_test, reads_into_registered_buffer)
+{
+    std::vector<unsigned char> out(8192, 'r');
+    eya_allocated_range_t      out_range = make_range(out);
+    ASSERT_TRUE(eya_io_async_write(io, fd, 0, &out_range, nullptr));
+
+    eya_io_async_completion_t done[1];
+    ASSERT_EQ(eya_io_async_wait(io, done, 1, 1), 1u);
+
+    std::vector<unsigned char> pool(8192);
+    eya_allocated_range_t      pool_range = make_range(pool);
+    eya_io_async_register_buffers(io, &pool_range, 1);
+
+    eya_allocated_range_t slice = eya_memory_range_slice(&pool_range, 2048, 4096);
+    ASSERT_TRUE(eya_io_async_read(io, fd, 0, &slice, nullptr));
+    ASSERT_EQ(eya_io_async_wait(io, done, 1, 1), 1u);
+
+    EXPECT_EQ(done[0].result, 4096);
+    EXPECT_EQ(pool[2048], 'r');
+    EXPECT_EQ(pool[6143], 'r');
+    EXPECT_EQ(pool[0], 0);
+
+    eya_io_async_unregister_buffers(io);
+}
+
+TEST_P(io_async_test, poll_does_not_block_when_idle)
+{
+    eya_io_async_completion_t done[1];
+    EXPECT_EQ(eya_io_async_poll(io, done, 1), 0u);
+    EXPECT_EQ(eya_io_async_wait(io, done, 1, 1), 0u);
+}
+
+TEST_P(io_async_test, finishes_operations_before_free)
+{
+    std::vector<unsigned char> out[4];
+    eya_allocated_range_t      out_ranges[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        out[i].assign(4096, static_cast<unsigned char>('a' + i));
+        out_ranges[i] = make_range(out[i]);
+        ASSERT_TRUE(eya_io_async_write(io, fd, i * 4096, &out_ranges[i], nullptr));
+    }
+    EXPECT_EQ(eya_io_async_submit(io), 4u);
+
+    std::vector<unsigned char> tail(4096, 'e');
+    eya_allocated_range_t      tail_range = make_range(tail);
+    ASSERT_TRUE(eya_io_async_write(io, fd, 4 * 4096, &tail_range, nullptr));
+
+    eya_io_async_free(io);
+    io = eya_io_async_make(8, GetParam());
+
+    std::vector<unsigned char> in(5 * 4096);
+    std::rewind(file);
+    ASSERT_EQ(std::fread(in.data(), 1, in.size(), file), in.size());
+    for (int i = 0; i < 5; ++i)
+        EXPECT_EQ(in[i * 4096 + 17], 'a' + i);
+}
+
+INSTANTIATE_TEST_SUITE_P(eya_io_async,
+                         io_async_test,
+                         ::testing::Values(EYA_IO_ASYNC_BACKEND_AUTO,
+                                           EYA_IO_ASYNC_BACKEND_THREAD_POOL));
+
+TEST(eya_io_async_make, handles_zero_depth)
+{
+    EXPECT_DEATH(eya_io_async_make(0, EYA_IO_ASYNC_BACKEND_AUTO), ".*");
+}
+
+TEST(eya_io_async_read, handles_invalid_arguments)
+{
+    eya_io_async_t       *io    = eya_io_async_make(1, EYA_IO_ASYNC_BACKEND_THREAD_POOL);
+    eya_allocated_range_t empty = {nullptr, nullptr};
+
+    EXPECT_DEATH(eya_io_async_read(nullptr, 0, 0, &empty, nullptr), ".*");
+    EXPECT_DEATH(eya_io_async_read(io, 0, 0, &empty, nullptr), ".*");
+    EXPECT_DEATH(eya_io_async_read(io, 0, 0, nullptr, nullptr), ".*");
+
+    eya_io_async_free(io);
+}
@@ -0,0 +1,150 @@
+#include <eya/io_copy.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <vector>
+
+#if !defined(_WIN32)
+#    include <unistd.h>
+#    include <fcntl.h>
+
+static int
+make_file(std::FILE *&file, const std::vector<unsigned char> &data)
+{
+    file = std::tmpfile();
+    const int fd = fileno(file);
+    if (!data.empty())
+        EXPECT_EQ(pwrite(fd, data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+    return fd;
+}
+
+static std::vector<unsigned char>
+make_pattern(size_t size)
+{
+    std::vector<unsigned char> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<unsigned char>(i * 31 + 7);
+    return data;
+}
+
+TEST(eya_io_copy_range, copies_between_regular_files)
+{
+    const auto src = make_pattern(300000);
+    std::FILE *in_file, *out_file;
+    const int  in  = make_file(in_file, src);
+    const int  out = make_file(out_file, {});
+
+    eya_io_copy_path_t path;
+    EXPECT_EQ(eya_io_copy_range(in, 1000, out, 10, 200000, &path), 200000u);
+    EXPECT_NE(path, EYA_IO_COPY_PATH_NONE);
+
+    std::vector<unsigned char> dst(200000);
+    ASSERT_EQ(pread(out, dst.data(), dst.size(), 10), 200000);
+    EXPECT_TRUE(std::equal(dst.begin(), dst.end(), src.begin() + 1000));
+    EXPECT_EQ(lseek(in, 0, SEEK_CUR), 0) << "explicit offsets must not move the position";
+
+    std::fclose(in_file);
+    std::fclose(out_file);
+}
+
+TEST(eya_io_copy_range, stops_at_end_of_input)
+{
+    const auto src = make_pattern(100);
+    std::FILE *in_file, *out_file;
+    const int  in  = make_file(in_file, src);
+    const int  out = make_file(out_file, {});
+
+    EXPECT_EQ(eya_io_copy_range(in, 60, out, 0, 1000, nullptr), 40u);
+
+    std::fclose(in_file);
+    std::fclose(out_file);
+}
+
+TEST(eya_io_copy_range, sends_file_into_pipe)
+{
+    const auto src = make_pattern(4096);
+    std::FILE *in_file;
+    const int  in = make_file(in_file, src);
+
+    int pipe_fds[2];
+    ASSERT_EQ(pipe(pipe_fds), 0);
+
+    eya_io_copy_path_t path;
+    EXPECT_EQ(eya_io_copy_range(in, 0, pipe_fds[1], EYA_IO_COPY_OFFSET_CURRENT, 4096, &path),
+              4096u);
+    EXPECT_TRUE(path == EYA_IO_COPY_PATH_SENDFILE || path == EYA_IO_COPY_PATH_SPLICE ||
+                path == EYA_IO_COPY_PATH_BUFFER);
+
+    std::vector<unsigned char> dst(4096);
+    ASSERT_EQ(read(pipe_fds[0], dst.data(), dst.size()), 4096);
+    EXPECT_EQ(dst, src);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    std::fclose(in_file);
+}
+
+TEST(eya_io_copy_range, copies_pipe_into_file)
+{
+    const auto src = make_pattern(4096);
+
+    int pipe_fds[2];
+    ASSERT_EQ(pipe(pipe_fds), 0);
+    ASSERT_EQ(write(pipe_fds[1], src.data(), src.size()), 4096);
+    close(pipe_fds[1]);
+
+    std::FILE *out_file;
+    const int  out = make_file(out_file, {});
+
+    eya_io_copy_path_t path;
+    EXPECT_EQ(eya_io_copy_range(pipe_fds[0], EYA_IO_COPY_OFFSET_CURRENT, out, 100, 8192, &path),
+              4096u);
+    EXPECT_TRUE(path == EYA_IO_COPY_PATH_SPLICE || path == EYA_IO_COPY_PATH_BUFFER);
+
+    std::vector<unsigned char> dst(4096);
+    ASSERT_EQ(pread(out, dst.data(), dst.size(), 100), 4096);
+    EXPECT_EQ(dst, src);
+
+    close(pipe_fds[0]);
+    std::fclose(out_file);
+}
+
+TEST(eya_io_copy_range, keeps_piped_input_when_the_output_refuses_splice)
+{
+    const auto src = make_pattern(60000);
+
+    int pipe_fds[2];
+    ASSERT_EQ(pipe(pipe_fds), 0);
+    ASSERT_EQ(write(pipe_fds[1], src.data(), src.size()), 60000);
+    close(pipe_fds[1]);
+
+    // Splicing into a file opened for appending fails once the input is consumed.
+    std::FILE *out_file;
+    const int  out = make_file(out_file, {});
+    ASSERT_EQ(fcntl(out, F_SETFL, O_APPEND), 0);
+
+    EXPECT_EQ(eya_io_copy_range(
+                  pipe_fds[0], EYA_IO_COPY_OFFSET_CURRENT, out, EYA_IO_COPY_OFFSET_CURRENT,
+                  100000, nullptr),
+              60000u);
+
+    std::vector<unsigned char> dst(60000);
+    ASSERT_EQ(pread(out, dst.data(), dst.size(), 0), 60000);
+    EXPECT_EQ(dst, src);
+
+    close(pipe_fds[0]);
+    std::fclose(out_file);
+}
+
+TEST(eya_io_copy_range, reports_none_for_empty_request)
+{
+    eya_io_copy_path_t path = EYA_IO_COPY_PATH_BUFFER;
+    EXPECT_EQ(eya_io_copy_range(-1, 0, -1, 0, 0, &path), 0u);
+    EXPECT_EQ(path, EYA_IO_COPY_PATH_NONE);
+}
+
+TEST(eya_io_copy_range, handles_invalid_descriptors)
+{
+    EXPECT_DEATH(eya_io_copy_range(-1, 0, -1, 0, 16, nullptr), ".*");
+}
+#endif
@@ -0,0 +1,211 @@
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_try.h>
+#include <eya/io_direct.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#if !defined(_WIN32)
+#    include <fcntl.h>
+#    include <unistd.h>
+
+static std::vector<unsigned char>
+make_pattern(size_t size)
+{
+    std::vector<unsigned char> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<unsigned char>(i * 13 + 5);
+    return data;
+}
+
+/**
+ * Writes the data to a temporary file and reopens it with O_DIRECT
+ * when the file system supports it, or with plain buffered I/O otherwise.
+ */
+static int
+make_direct_file(const std::vector<unsigned char> &data)
+{
+    char path[] = "/tmp/eya_io_direct_XXXXXX";
+    int  fd     = mkstemp(path);
+    EXPECT_GE(fd, 0);
+    EXPECT_EQ(pwrite(fd, data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+    close(fd);
+
+#    ifdef O_DIRECT
+    fd = open(path, O_RDONLY | O_DIRECT);
+    if (fd < 0)
+#    endif
+        fd = open(path, O_RDONLY);
+
+    unlink(path);
+    return fd;
+}
+
+static int
+reader_init_error(eya_io_direct_pool_t *pool)
+{
+    eya_runtime_try(e)
+    {
+        eya_io_direct_reader_t reader;
+        eya_io_direct_reader_init(&reader, -1, pool);
+        eya_io_direct_reader_destroy(&reader);
+        eya_runtime_try_return(0);
+    }
+    eya_runtime_catch
+    {
+        return eya_error_get_code(reinterpret_cast<eya_error_t *>(&e.exception));
+    }
+}
+
+TEST(eya_io_direct_pool, acquires_aligned_buffers_until_exhausted)
+{
+    eya_io_direct_pool_t pool;
+    eya_io_direct_pool_init(&pool, 8192, 3, EYA_IO_DIRECT_DEFAULT_ALIGNMENT);
+    EXPECT_EQ(eya_io_direct_pool_get_available(&pool), 3u);
+
+    eya_allocated_range_t buffers[4];
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(eya_io_direct_pool_acquire(&pool, &buffers[i]));
+        EXPECT_TRUE(eya_memory_range_is_aligned(&buffers[i], EYA_IO_DIRECT_DEFAULT_ALIGNMENT));
+        EXPECT_EQ(eya_memory_range_get_size(&buffers[i]), 8192u);
+    }
+
+    EXPECT_EQ(eya_io_direct_pool_get_available(&pool), 0u);
+    EXPECT_FALSE(eya_io_direct_pool_acquire(&pool, &buffers[3]));
+
+    eya_io_direct_pool_release(&pool, &buffers[1]);
+    EXPECT_EQ(eya_io_direct_pool_get_available(&pool), 1u);
+    ASSERT_TRUE(eya_io_direct_pool_acquire(&pool, &buffers[3]));
+
+    eya_io_direct_pool_release(&pool, &buffers[0]);
+    eya_io_direct_pool_release(&pool, &buffers[2]);
+    eya_io_direct_pool_release(&pool, &buffers[3]);
+    EXPECT_EQ(eya_io_direct_pool_get_available(&pool), 3u);
+
+    eya_io_direct_pool_destroy(&pool);
+}
+
+TEST(eya_io_direct_pool, rejects_invalid_geometry)
+{
+    eya_io_direct_pool_t pool;
+    EXPECT_DEATH(eya_io_direct_pool_init(&pool, 4096, 1, 3000), ".*");
+    EXPECT_DEATH(eya_io_direct_pool_init(&pool, 5000, 1, 4096), ".*");
+    EXPECT_DEATH(eya_io_direct_pool_init(&pool, 4096, 0, 4096), ".*");
+}
+
+TEST(eya_io_direct_pool, rejects_foreign_buffer)
+{
+    eya_io_direct_pool_t pool;
+    eya_io_direct_pool_init(&pool, 4096, 2, 4096);
+
+    eya_allocated_range_t buffer;
+    ASSERT_TRUE(eya_io_direct_pool_acquire(&pool, &buffer));
+
+    eya_allocated_range_t shifted = eya_memory_range_slice(&buffer, 16, 1024);
+    EXPECT_DEATH(eya_io_direct_pool_release(&pool, &shifted), ".*");
+
+    eya_io_direct_pool_release(&pool, &buffer);
+    eya_io_direct_pool_destroy(&pool);
+}
+
+TEST(eya_io_direct_reader_init, throws_when_pool_is_empty)
+{
+    eya_io_direct_pool_t pool;
+    eya_io_direct_pool_init(&pool, 4096, 1, 4096);
+
+    eya_io_direct_reader_t first;
+    eya_io_direct_reader_init(&first, -1, &pool);
+
+    EXPECT_EQ(reader_init_error(&pool), EYA_RUNTIME_ERROR_RESOURCE_EXHAUSTED);
+
+    eya_io_direct_reader_destroy(&first);
+    eya_io_direct_pool_destroy(&pool);
+}
+
+TEST(eya_io_direct_reader_read, reads_unaligned_regions)
+{
+    const auto data = make_pattern(3 * 65536 + 1234);
+    const int  fd   = make_direct_file(data);
+    ASSERT_GE(fd, 0);
+
+    eya_io_direct_pool_t pool;
+    eya_io_direct_pool_init(&pool, 16384, 2, EYA_IO_DIRECT_DEFAULT_ALIGNMENT);
+
+    eya_io_direct_reader_t reader;
+    eya_io_direct_reader_init(&reader, fd, &pool);
+
+    const struct
+    {
+        size_t offset;
+        size_t size;
+    } cases[] = {{0, 1}, {1, 100}, {4095, 2}, {4096, 4096}, {100, 70000}, {65536, 65536}};
+
+    for (const auto &c : cases)
+    {
+        std::vector<unsigned char> dst(c.size + 1);
+        eya_memory_range_t         range;
+        eya_memory_range_reset_s(&range, dst.data() + 1, c.size);
+
+        EXPECT_EQ(eya_io_direct_reader_read(&reader, c.offset, &range), c.size)
+            << "offset " << c.offset;
+        EXPECT_TRUE(std::equal(dst.begin() + 1, dst.end(), data.begin() + c.offset))
+            << "offset " << c.offset;
+    }
+
+    eya_io_direct_reader_destroy(&reader);
+    eya_io_direct_pool_destroy(&pool);
+    close(fd);
+}
+
+TEST(eya_io_direct_reader_read, reads_aligned_regions_directly)
+{
+    const auto data = make_pattern(8 * 4096);
+    const int  fd   = make_direct_file(data);
+    ASSERT_GE(fd, 0);
+
+    eya_io_direct_pool_t pool;
+    eya_io_direct_pool_init(&pool, 4096, 1, 4096);
+
+    eya_io_direct_reader_t reader;
+    eya_io_direct_reader_init(&reader, fd, &pool);
+
+    eya_allocated_range_t dst = eya_allocated_range_make_aligned(5 * 4096, 4096);
+    EXPECT_EQ(eya_io_direct_reader_read(&reader, 4096, &dst), 5u * 4096);
+    EXPECT_TRUE(std::equal(static_cast<unsigned char *>(eya_memory_range_get_begin(&dst)),
+                           static_cast<unsigned char *>(eya_memory_range_get_end(&dst)),
+                           data.begin() + 4096));
+
+    eya_allocated_range_clear_aligned(&dst);
+    eya_io_direct_reader_destroy(&reader);
+    eya_io_direct_pool_destroy(&pool);
+    close(fd);
+}
+
+TEST(eya_io_direct_reader_read, stops_at_end_of_file)
+{
+    const auto data = make_pattern(10000);
+    const int  fd   = make_direct_file(data);
+    ASSERT_GE(fd, 0);
+
+    eya_io_direct_pool_t pool;
+    eya_io_direct_pool_init(&pool, 4096, 1, 4096);
+
+    eya_io_direct_reader_t reader;
+    eya_io_direct_reader_init(&reader, fd, &pool);
+
+    std::vector<unsigned char> dst(5000);
+    eya_memory_range_t         range;
+    eya_memory_range_reset_s(&range, dst.data(), dst.size());
+
+    EXPECT_EQ(eya_io_direct_reader_read(&reader, 7000, &range), 3000u);
+    EXPECT_TRUE(std::equal(dst.begin(), dst.begin() + 3000, data.begin() + 7000));
+    EXPECT_EQ(eya_io_direct_reader_read(&reader, 20000, &range), 0u);
+
+    eya_io_direct_reader_destroy(&reader);
+    eya_io_direct_pool_destroy(&pool);
+    close(fd);
+}
+#endif
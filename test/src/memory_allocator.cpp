@@ -185,4 +185,37 @@ TEST(eya_memory_allocator_realloc, copies_data_correctly)
     }
 
     eya_memory_allocator_free(&allocator, new_ptr);
+}
+
+TEST(eya_memory_allocator_alloc_aligned, returns_aligned_pointer)
+{
+    eya_memory_allocator_t allocator = {malloc, free};
+
+    for (eya_usize_t align = 1; align <= 8192; align <<= 1)
+    {
+        void *ptr = eya_memory_allocator_alloc_aligned(&allocator, 100, align);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % align, 0u) << "align " << align;
+
+        memset(ptr, 0xAB, 100);
+        eya_memory_allocator_free_aligned(&allocator, ptr);
+    }
+}
+
+TEST(eya_memory_allocator_alloc_aligned, rejects_bad_arguments)
+{
+    eya_memory_allocator_t allocator = {malloc, free};
+
+    EXPECT_DEATH(eya_memory_allocator_alloc_aligned(&allocator, 0, 16), ".*")
+        << "Should fail on zero size";
+    EXPECT_DEATH(eya_memory_allocator_alloc_aligned(&allocator, 16, 24), ".*")
+        << "Should fail when alignment is not a power of two";
+    EXPECT_DEATH(eya_memory_allocator_alloc_aligned(&allocator, EYA_USIZE_T_MAX, 16), ".*")
+        << "Should fail when padding overflows";
+}
+
+TEST(eya_memory_allocator_free_aligned, ignores_nullptr)
+{
+    eya_memory_allocator_t allocator = {malloc, free};
+    EXPECT_NO_FATAL_FAILURE(eya_memory_allocator_free_aligned(&allocator, nullptr));
 }
\ No newline at end of file
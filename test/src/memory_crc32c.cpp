@@ -0,0 +1,113 @@
+#include <eya/memory_crc32c.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Bit-at-a-time CRC-32C, the definition the fast paths must match.
+ */
+static eya_uint_t
+memory_crc32c_reference(eya_uint_t crc, const eya_uchar_t *p, eya_usize_t size)
+{
+    crc = ~crc;
+    while (size--)
+    {
+        crc ^= *p++;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = crc & 1 ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+    }
+    return ~crc;
+}
+
+static std::vector<eya_uchar_t>
+memory_crc32c_random(eya_usize_t size)
+{
+    std::mt19937             random(7);
+    std::vector<eya_uchar_t> bytes(size);
+
+    for (eya_uchar_t &byte : bytes)
+        byte = static_cast<eya_uchar_t>(random());
+    return bytes;
+}
+
+TEST(eya_memory_crc32c, matches_known_vectors)
+{
+    // RFC 3720, appendix B.4.
+    std::vector<eya_uchar_t> bytes(32, 0x00);
+    EXPECT_EQ(eya_memory_crc32c(0, bytes.data(), bytes.size()), 0x8A9136AAu);
+
+    bytes.assign(32, 0xFF);
+    EXPECT_EQ(eya_memory_crc32c(0, bytes.data(), bytes.size()), 0x62A8AB43u);
+
+    for (eya_usize_t i = 0; i < 32; ++i)
+        bytes[i] = static_cast<eya_uchar_t>(i);
+    EXPECT_EQ(eya_memory_crc32c(0, bytes.data(), bytes.size()), 0x46DD794Eu);
+
+    for (eya_usize_t i = 0; i < 32; ++i)
+        bytes[i] = static_cast<eya_uchar_t>(31 - i);
+    EXPECT_EQ(eya_memory_crc32c(0, bytes.data(), bytes.size()), 0x113FDB5Cu);
+
+    EXPECT_EQ(eya_memory_crc32c(0, "123456789", 9), 0xE3069283u);
+    EXPECT_EQ(eya_memory_crc32c(0, nullptr, 0), 0u);
+    EXPECT_EQ(eya_memory_crc32c(0x12345678u, nullptr, 0), 0x12345678u);
+    EXPECT_DEATH(eya_memory_crc32c(0, nullptr, 1), ".*");
+}
+
+TEST(eya_memory_crc32c, matches_reference_for_all_sizes_and_alignments)
+{
+    const std::vector<eya_uchar_t> bytes = memory_crc32c_random(20000);
+
+    const std::string impl = eya_memory_crc32c_get_impl();
+    EXPECT_TRUE(impl == "pclmul" || impl == "sse4.2" || impl == "slice8");
+
+    for (eya_usize_t size = 0; size <= 19000; size += size < 3000 ? 1 : 97)
+        for (eya_usize_t offset = 0; offset < 3; ++offset)
+        {
+            const eya_uint_t  crc = static_cast<eya_uint_t>(size * 2654435761u);
+            const eya_uchar_t *p  = bytes.data() + offset;
+
+            ASSERT_EQ(eya_memory_crc32c(crc, p, size), memory_crc32c_reference(crc, p, size))
+                << size << " " << offset;
+        }
+}
+
+TEST(eya_memory_crc32c, extends_a_previous_checksum)
+{
+    const std::vector<eya_uchar_t> bytes = memory_crc32c_random(10000);
+    const eya_uint_t expected = eya_memory_crc32c(0, bytes.data(), bytes.size());
+
+    eya_uint_t crc = 0;
+    for (eya_usize_t offset = 0, chunk = 1; offset < bytes.size(); offset += chunk, chunk *= 2)
+    {
+        if (chunk > bytes.size() - offset)
+            chunk = bytes.size() - offset;
+        crc = eya_memory_crc32c(crc, bytes.data() + offset, chunk);
+    }
+
+    EXPECT_EQ(crc, expected);
+}
+
+TEST(eya_memory_crc32c_combine, joins_checksums_of_adjacent_blocks)
+{
+    const std::vector<eya_uchar_t> bytes = memory_crc32c_random(5000);
+
+    for (eya_usize_t split : {0u, 1u, 7u, 64u, 1000u, 2500u, 4999u, 5000u})
+    {
+        const eya_uint_t crc1 = eya_memory_crc32c(0, bytes.data(), split);
+        const eya_uint_t crc2 = eya_memory_crc32c(0, bytes.data() + split, bytes.size() - split);
+
+        EXPECT_EQ(eya_memory_crc32c_combine(crc1, crc2, bytes.size() - split),
+                  eya_memory_crc32c(0, bytes.data(), bytes.size()))
+            << split;
+    }
+
+    // Appending zeros through the combination matches hashing them.
+    const std::vector<eya_uchar_t> zeros(1 << 16, 0);
+    const eya_uint_t               crc = eya_memory_crc32c(0, bytes.data(), 100);
+
+    EXPECT_EQ(eya_memory_crc32c_combine(crc, eya_memory_crc32c(0, zeros.data(), zeros.size()),
+                                        zeros.size()),
+              eya_memory_crc32c(crc, zeros.data(), zeros.size()));
+}
@@ -0,0 +1,125 @@
+#include <eya/memory_grid.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+template <typename T>
+static void
+check_transpose(size_t rows, size_t cols, size_t src_pad, size_t dst_pad)
+{
+    const size_t   src_pitch = cols + src_pad;
+    const size_t   dst_pitch = rows + dst_pad;
+    std::vector<T> src(rows * src_pitch);
+    std::vector<T> dst(cols * dst_pitch, T(0));
+
+    for (size_t r = 0; r < rows; ++r)
+        for (size_t c = 0; c < cols; ++c)
+            src[r * src_pitch + c] = static_cast<T>(r * 1000 + c + 1);
+
+    auto from = eya_memory_grid_make(src.data(), sizeof(T), rows, cols, src_pitch * sizeof(T));
+    auto to   = eya_memory_grid_make(dst.data(), sizeof(T), cols, rows, dst_pitch * sizeof(T));
+    eya_memory_grid_transpose(&to, &from);
+
+    for (size_t r = 0; r < rows; ++r)
+        for (size_t c = 0; c < cols; ++c)
+            ASSERT_EQ(dst[c * dst_pitch + r], src[r * src_pitch + c])
+                << "element (" << r << ", " << c << ") of " << rows << "x" << cols;
+
+    for (size_t c = 0; c < cols; ++c)
+        for (size_t p = rows; p < dst_pitch; ++p)
+            ASSERT_EQ(dst[c * dst_pitch + p], T(0)) << "padding must stay untouched";
+}
+
+struct triple
+{
+    uint8_t v[3];
+
+    triple() = default;
+    explicit triple(size_t x)
+        : v{static_cast<uint8_t>(x), static_cast<uint8_t>(x >> 8), static_cast<uint8_t>(x >> 16)}
+    {
+    }
+
+    bool operator==(const triple &other) const
+    {
+        return v[0] == other.v[0] && v[1] == other.v[1] && v[2] == other.v[2];
+    }
+};
+
+static std::ostream &
+operator<<(std::ostream &out, const triple &value)
+{
+    return out << int(value.v[0]) << "," << int(value.v[1]) << "," << int(value.v[2]);
+}
+
+TEST(eya_memory_grid_transpose, transposes_four_byte_elements)
+{
+    check_transpose<uint32_t>(1, 1, 0, 0);
+    check_transpose<uint32_t>(4, 4, 0, 0);
+    check_transpose<uint32_t>(37, 70, 3, 1);
+    check_transpose<uint32_t>(128, 33, 0, 5);
+}
+
+TEST(eya_memory_grid_transpose, transposes_eight_byte_elements)
+{
+    check_transpose<uint64_t>(2, 2, 0, 0);
+    check_transpose<uint64_t>(35, 19, 1, 2);
+    check_transpose<double>(64, 64, 0, 0);
+}
+
+TEST(eya_memory_grid_transpose, transposes_other_element_sizes)
+{
+    check_transpose<uint8_t>(129, 67, 2, 0);
+    check_transpose<uint16_t>(50, 3, 0, 7);
+    check_transpose<triple>(41, 29, 1, 1);
+}
+
+TEST(eya_memory_grid_transpose, rejects_mismatched_shape)
+{
+    uint32_t a[12], b[12];
+    auto     from = eya_memory_grid_make(a, 4, 3, 4, 16);
+    auto     to   = eya_memory_grid_make(b, 4, 3, 4, 16);
+
+    EXPECT_DEATH(eya_memory_grid_transpose(&to, &from), ".*");
+}
+
+TEST(eya_memory_grid_make, rejects_short_pitch)
+{
+    uint32_t data[16];
+    EXPECT_DEATH(eya_memory_grid_make(data, 4, 4, 4, 12), ".*");
+}
+
+TEST(eya_memory_grid_column, views_a_column_with_pitch_stride)
+{
+    uint16_t data[3][5];
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 5; ++c)
+            data[r][c] = static_cast<uint16_t>(r * 10 + c);
+
+    auto grid   = eya_memory_grid_make(data, 2, 3, 4, sizeof(data[0]));
+    auto column = eya_memory_grid_column(&grid, 2);
+    auto row    = eya_memory_grid_row(&grid, 1);
+
+    EXPECT_EQ(column.count, 3u);
+    EXPECT_EQ(*static_cast<uint16_t *>(eya_memory_strided_at(&column, 2)), 22);
+    EXPECT_TRUE(eya_memory_strided_is_dense(&row));
+    EXPECT_EQ(*static_cast<uint16_t *>(eya_memory_strided_at(&row, 3)), 13);
+    EXPECT_DEATH(eya_memory_grid_column(&grid, 4), ".*");
+}
+
+TEST(eya_memory_grid_copy, copies_rows_between_pitches)
+{
+    uint8_t src[4][7], dst[4][5] = {};
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 7; ++c)
+            src[r][c] = static_cast<uint8_t>(r * 7 + c);
+
+    auto from = eya_memory_grid_make(src, 1, 4, 5, 7);
+    auto to   = eya_memory_grid_make(dst, 1, 4, 5, 5);
+    eya_memory_grid_copy(&to, &from);
+
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 5; ++c)
+            EXPECT_EQ(dst[r][c], src[r][c]);
+}
@@ -0,0 +1,95 @@
+#include <eya/memory_parallel.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+static constexpr size_t memory_parallel_size = EYA_LIBRARY_OPTION_MEMORY_PARALLEL_THRESHOLD + 12345;
+
+static std::vector<std::uint8_t>
+memory_parallel_pattern(size_t size)
+{
+    std::vector<std::uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<std::uint8_t>(i * 131 + (i >> 12));
+    return data;
+}
+
+TEST(eya_memory_parallel_copy, copies_unaligned_huge_buffer)
+{
+    eya_thread_pool_t *pool = eya_thread_pool_make(4, nullptr);
+    const auto         src  = memory_parallel_pattern(memory_parallel_size + 3);
+
+    std::vector<std::uint8_t> dst(memory_parallel_size + 8, 0xEE);
+
+    // Offsets that break the page and vector alignment of both buffers.
+    void *end =
+        eya_memory_parallel_copy(pool, dst.data() + 5, src.data() + 3, memory_parallel_size);
+
+    EXPECT_EQ(end, dst.data() + 5 + memory_parallel_size);
+    EXPECT_EQ(dst[4], 0xEE);
+    EXPECT_EQ(dst[5 + memory_parallel_size], 0xEE);
+    EXPECT_EQ(std::memcmp(dst.data() + 5, src.data() + 3, memory_parallel_size), 0);
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_memory_parallel_copy, copies_small_buffer_on_calling_thread)
+{
+    eya_thread_pool_t *pool = eya_thread_pool_make(2, nullptr);
+    const auto         src  = memory_parallel_pattern(1000);
+
+    std::vector<std::uint8_t> dst(1000);
+    eya_memory_parallel_copy(pool, dst.data(), src.data(), src.size());
+    EXPECT_EQ(dst, src);
+
+    EXPECT_DEATH(eya_memory_parallel_copy(nullptr, dst.data(), src.data(), 1), ".*");
+    EXPECT_DEATH(eya_memory_parallel_copy(pool, nullptr, src.data(), 1), ".*");
+    EXPECT_DEATH(
+        eya_memory_parallel_copy(pool, dst.data(), nullptr, memory_parallel_size), ".*");
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_memory_parallel_set, fills_huge_buffer)
+{
+    eya_thread_pool_t        *pool = eya_thread_pool_make(4, nullptr);
+    std::vector<std::uint8_t> dst(memory_parallel_size + 2, 0x11);
+
+    void *end = eya_memory_parallel_set(pool, dst.data() + 1, 0xA5, memory_parallel_size);
+
+    EXPECT_EQ(end, dst.data() + 1 + memory_parallel_size);
+    EXPECT_EQ(dst.front(), 0x11);
+    EXPECT_EQ(dst.back(), 0x11);
+    EXPECT_EQ(std::count(dst.begin() + 1, dst.end() - 1, 0xA5), memory_parallel_size);
+
+    EXPECT_DEATH(eya_memory_parallel_set(pool, nullptr, 0, memory_parallel_size), ".*");
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_memory_parallel_compare, finds_first_difference)
+{
+    eya_thread_pool_t *pool = eya_thread_pool_make(4, nullptr);
+    const auto         lhs  = memory_parallel_pattern(memory_parallel_size);
+    auto               rhs  = lhs;
+
+    EXPECT_EQ(eya_memory_parallel_compare(pool, lhs.data(), rhs.data(), lhs.size()), nullptr);
+
+    // A difference in the last chunk only.
+    rhs[memory_parallel_size - 2] ^= 1;
+    EXPECT_EQ(eya_memory_parallel_compare(pool, lhs.data(), rhs.data(), lhs.size()),
+              lhs.data() + memory_parallel_size - 2);
+
+    // The earliest of several differences wins, whichever chunk finishes first.
+    rhs[memory_parallel_size / 2] ^= 1;
+    rhs[7] ^= 1;
+    EXPECT_EQ(eya_memory_parallel_compare(pool, lhs.data(), rhs.data(), lhs.size()),
+              lhs.data() + 7);
+
+    EXPECT_DEATH(eya_memory_parallel_compare(pool, nullptr, rhs.data(), lhs.size()), ".*");
+
+    eya_thread_pool_free(pool);
+}
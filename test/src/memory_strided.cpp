@@ -0,0 +1,120 @@
+#include <eya/memory_strided.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+struct record
+{
+    uint32_t id;
+    uint8_t  flag;
+    double   value;
+};
+
+TEST(eya_memory_strided_make, rejects_invalid_layout)
+{
+    int data[4];
+
+    EXPECT_DEATH(eya_memory_strided_make(nullptr, 4, 4, 1), ".*");
+    EXPECT_DEATH(eya_memory_strided_make(data, 0, 4, 1), ".*");
+    EXPECT_DEATH(eya_memory_strided_make(data, 8, 4, 1), ".*");
+    EXPECT_DEATH(eya_memory_strided_make(data, 4, SIZE_MAX / 2, 4), ".*");
+}
+
+TEST(eya_memory_strided_at, addresses_elements_by_stride)
+{
+    record records[3] = {};
+    auto   view = eya_memory_strided_make(&records[0].value, sizeof(double), sizeof(record), 3);
+
+    EXPECT_EQ(eya_memory_strided_at(&view, 2), &records[2].value);
+    EXPECT_FALSE(eya_memory_strided_is_dense(&view));
+    EXPECT_EQ(eya_memory_strided_get_packed_size(&view), 3 * sizeof(double));
+    EXPECT_DEATH(eya_memory_strided_at(&view, 3), ".*");
+}
+
+TEST(eya_memory_strided_gather, packs_one_field_of_records)
+{
+    std::vector<record> records(100);
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        records[i].id    = static_cast<uint32_t>(i * 3);
+        records[i].value = static_cast<double>(i) / 2;
+    }
+
+    std::vector<uint32_t> ids(records.size());
+    eya_memory_range_t    dst;
+    eya_memory_range_reset_s(&dst, ids.data(), ids.size() * sizeof(uint32_t));
+
+    auto view = eya_memory_strided_make(
+        &records[0].id, sizeof(uint32_t), sizeof(record), records.size());
+    eya_memory_strided_gather(&view, &dst);
+
+    for (size_t i = 0; i < ids.size(); ++i)
+        EXPECT_EQ(ids[i], i * 3);
+}
+
+TEST(eya_memory_strided_gather, rejects_small_destination)
+{
+    uint16_t           src[8] = {};
+    uint16_t           out[3];
+    eya_memory_range_t dst;
+    eya_memory_range_reset_s(&dst, out, sizeof(out));
+
+    auto view = eya_memory_strided_make(src, sizeof(uint16_t), 2 * sizeof(uint16_t), 4);
+    EXPECT_DEATH(eya_memory_strided_gather(&view, &dst), ".*");
+}
+
+TEST(eya_memory_strided_scatter, unpacks_into_records)
+{
+    std::vector<record> records(10);
+    std::vector<double> values(records.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<double>(i) * 1.5;
+
+    eya_memory_range_t src;
+    eya_memory_range_reset_s(&src, values.data(), values.size() * sizeof(double));
+
+    auto view = eya_memory_strided_make(
+        &records[0].value, sizeof(double), sizeof(record), records.size());
+    eya_memory_strided_scatter(&view, &src);
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        EXPECT_EQ(records[i].value, values[i]);
+        EXPECT_EQ(records[i].id, 0u) << "neighbouring fields must stay untouched";
+    }
+}
+
+TEST(eya_memory_strided_copy, copies_between_strides_of_any_element_size)
+{
+    for (size_t element_size : {1, 2, 3, 4, 8, 16, 24})
+    {
+        const size_t               count = 17;
+        std::vector<unsigned char> src(count * element_size * 3);
+        std::vector<unsigned char> dst(count * element_size * 2, 0);
+        for (size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<unsigned char>(i);
+
+        auto from = eya_memory_strided_make(src.data(), element_size, 3 * element_size, count);
+        auto to   = eya_memory_strided_make(dst.data(), element_size, 2 * element_size, count);
+        eya_memory_strided_copy(&to, &from);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(0,
+                      memcmp(eya_memory_strided_at(&to, i),
+                             eya_memory_strided_at(&from, i),
+                             element_size))
+                << "element size " << element_size << ", index " << i;
+        }
+    }
+}
+
+TEST(eya_memory_strided_copy, rejects_mismatched_views)
+{
+    int  a[4], b[4];
+    auto to   = eya_memory_strided_make(a, 4, 4, 4);
+    auto from = eya_memory_strided_make(b, 4, 4, 3);
+
+    EXPECT_DEATH(eya_memory_strided_copy(&to, &from), ".*");
+}
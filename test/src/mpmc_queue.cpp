@@ -0,0 +1,163 @@
+#include <eya/mpmc_queue.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+struct mpmc_queue_record
+{
+    std::uint32_t id;
+    std::uint8_t  tag[13];
+};
+
+struct mpmc_queue_stream
+{
+    eya_mpmc_queue_t          *queue;
+    std::uint64_t              first;
+    std::uint64_t              count;
+    std::atomic<std::uint64_t> sum;
+};
+
+static void
+mpmc_queue_produce(void *arg)
+{
+    auto *stream = static_cast<mpmc_queue_stream *>(arg);
+    for (std::uint64_t i = 0; i < stream->count; i += 4)
+    {
+        std::uint64_t batch[4];
+        for (std::uint64_t j = 0; j < 4; ++j)
+            batch[j] = stream->first + i + j + 1;
+        eya_mpmc_queue_push_batch(stream->queue, batch, 4);
+    }
+}
+
+static void
+mpmc_queue_consume(void *arg)
+{
+    auto         *stream = static_cast<mpmc_queue_stream *>(arg);
+    std::uint64_t sum    = 0;
+
+    for (std::uint64_t taken = 0; taken < stream->count;)
+    {
+        std::uint64_t     batch[3];
+        const eya_usize_t want = stream->count - taken < 3 ? stream->count - taken : 3;
+        const eya_usize_t n    = eya_mpmc_queue_pop_batch(stream->queue, batch, want);
+        for (eya_usize_t i = 0; i < n; ++i)
+            sum += batch[i];
+        taken += n;
+    }
+    stream->sum += sum;
+}
+
+TEST(eya_mpmc_queue_init, creates_empty_queue)
+{
+    eya_mpmc_queue_t queue;
+    eya_mpmc_queue_init(&queue, 8, sizeof(mpmc_queue_record));
+
+    EXPECT_EQ(eya_mpmc_queue_get_capacity(&queue), 8u);
+    EXPECT_EQ(eya_mpmc_queue_get_size(&queue), 0u);
+
+    eya_mpmc_queue_destroy(&queue);
+}
+
+TEST(eya_mpmc_queue_init, handles_invalid_arguments)
+{
+    eya_mpmc_queue_t queue;
+    EXPECT_DEATH(eya_mpmc_queue_init(nullptr, 8, 4), ".*");
+    EXPECT_DEATH(eya_mpmc_queue_init(&queue, 6, 4), ".*");
+    EXPECT_DEATH(eya_mpmc_queue_init(&queue, 1, 4), ".*");
+    EXPECT_DEATH(eya_mpmc_queue_init(&queue, 8, 0), ".*");
+}
+
+TEST(eya_mpmc_queue_try_push, stores_elements_inline_in_fifo_order)
+{
+    eya_mpmc_queue_t queue;
+    eya_mpmc_queue_init(&queue, 4, sizeof(mpmc_queue_record));
+
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        mpmc_queue_record record{i, {}};
+        record.tag[12] = static_cast<std::uint8_t>(i + 100);
+        EXPECT_TRUE(eya_mpmc_queue_try_push(&queue, &record));
+    }
+
+    mpmc_queue_record record{};
+    EXPECT_FALSE(eya_mpmc_queue_try_push(&queue, &record));
+    EXPECT_EQ(eya_mpmc_queue_get_size(&queue), 4u);
+
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(eya_mpmc_queue_try_pop(&queue, &record));
+        EXPECT_EQ(record.id, i);
+        EXPECT_EQ(record.tag[12], i + 100);
+    }
+    EXPECT_FALSE(eya_mpmc_queue_try_pop(&queue, &record));
+
+    eya_mpmc_queue_destroy(&queue);
+}
+
+TEST(eya_mpmc_queue_try_push_batch, claims_consecutive_cells)
+{
+    eya_mpmc_queue_t queue;
+    eya_mpmc_queue_init(&queue, 8, sizeof(int));
+
+    const int in[10]  = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int       out[10] = {};
+
+    EXPECT_EQ(eya_mpmc_queue_try_push_batch(&queue, in, 5), 5u);
+    EXPECT_EQ(eya_mpmc_queue_try_pop_batch(&queue, out, 3), 3u);
+    EXPECT_EQ(eya_mpmc_queue_try_push_batch(&queue, in + 5, 5), 5u);
+    EXPECT_EQ(eya_mpmc_queue_try_push_batch(&queue, in, 10), 1u);
+
+    EXPECT_EQ(eya_mpmc_queue_try_pop_batch(&queue, out, 10), 8u);
+    for (int i = 0; i < 7; ++i)
+        EXPECT_EQ(out[i], i + 3);
+    EXPECT_EQ(out[7], 0);
+
+    EXPECT_EQ(eya_mpmc_queue_try_pop_batch(&queue, out, 10), 0u);
+    EXPECT_EQ(eya_mpmc_queue_try_push_batch(&queue, nullptr, 0), 0u);
+    EXPECT_DEATH(eya_mpmc_queue_try_pop_batch(&queue, nullptr, 1), ".*");
+    EXPECT_DEATH(eya_mpmc_queue_pop_batch(&queue, out, 0), ".*");
+
+    eya_mpmc_queue_destroy(&queue);
+}
+
+TEST(eya_mpmc_queue_push, blocks_until_consumers_make_room)
+{
+    constexpr int           threads = 3;
+    constexpr std::uint64_t count   = 20000;
+
+    eya_mpmc_queue_t queue;
+    eya_mpmc_queue_init(&queue, 8, sizeof(std::uint64_t));
+
+    std::vector<mpmc_queue_stream> producers(threads);
+    std::vector<mpmc_queue_stream> consumers(threads);
+    std::vector<eya_thread_t>      handles(2 * threads);
+
+    for (int i = 0; i < threads; ++i)
+    {
+        producers[i].queue = &queue;
+        producers[i].first = i * count;
+        producers[i].count = count;
+        consumers[i].queue = &queue;
+        consumers[i].count = count;
+        consumers[i].sum   = 0;
+        eya_thread_create(&handles[i], mpmc_queue_consume, &consumers[i]);
+    }
+    for (int i = 0; i < threads; ++i)
+        eya_thread_create(&handles[threads + i], mpmc_queue_produce, &producers[i]);
+    for (auto &handle : handles)
+        eya_thread_join(&handle);
+
+    std::uint64_t sum = 0;
+    for (auto &consumer : consumers)
+        sum += consumer.sum;
+
+    const std::uint64_t total = threads * count;
+    EXPECT_EQ(sum, total * (total + 1) / 2);
+    EXPECT_EQ(eya_mpmc_queue_get_size(&queue), 0u);
+
+    eya_mpmc_queue_destroy(&queue);
+}
@@ -0,0 +1,173 @@
+#include <eya/runtime_allocator.h>
+#include <eya/shared_range.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+
+static eya_shared_range_t
+make_text(const char *text)
+{
+    eya_memory_range_t source;
+    eya_memory_range_reset_s(&source, const_cast<char *>(text), std::strlen(text));
+    return eya_shared_range_make_copy(&source);
+}
+
+static const char *
+data_of(const eya_shared_range_t *range)
+{
+    return static_cast<const char *>(eya_memory_range_get_begin(eya_shared_range_get_range(range)));
+}
+
+TEST(eya_shared_range_make_copy, owns_a_copy_of_the_source)
+{
+    char               text[] = "payload";
+    eya_memory_range_t source;
+    eya_memory_range_reset_s(&source, text, 7);
+
+    eya_shared_range_t range = eya_shared_range_make_copy(&source);
+    text[0]                  = 'X';
+
+    EXPECT_EQ(eya_shared_range_get_size(&range), 7u);
+    EXPECT_EQ(std::memcmp(data_of(&range), "payload", 7), 0);
+    EXPECT_TRUE(eya_shared_range_is_unique(&range));
+
+    eya_shared_range_release(&range);
+    EXPECT_EQ(eya_shared_range_get_use_count(&range), 0u);
+}
+
+TEST(eya_shared_range_make, rejects_zero_size)
+{
+    EXPECT_DEATH(eya_shared_range_make(0), ".*");
+}
+
+TEST(eya_shared_range_share, shares_the_same_bytes)
+{
+    eya_shared_range_t first  = make_text("abcdef");
+    eya_shared_range_t second = eya_shared_range_share(&first);
+
+    EXPECT_EQ(data_of(&first), data_of(&second));
+    EXPECT_EQ(eya_shared_range_get_use_count(&first), 2u);
+    EXPECT_FALSE(eya_shared_range_is_unique(&second));
+
+    eya_shared_range_release(&first);
+    EXPECT_TRUE(eya_shared_range_is_unique(&second));
+    EXPECT_EQ(std::memcmp(data_of(&second), "abcdef", 6), 0);
+
+    eya_shared_range_release(&second);
+}
+
+TEST(eya_shared_range_slice, views_the_parent_buffer)
+{
+    eya_shared_range_t parent = make_text("0123456789");
+    eya_shared_range_t tail   = eya_shared_range_slice(&parent, 6, 4);
+    eya_shared_range_t inner  = eya_shared_range_slice(&tail, 1, 2);
+
+    EXPECT_EQ(data_of(&tail), data_of(&parent) + 6) << "slicing must not copy";
+    EXPECT_EQ(data_of(&inner), data_of(&parent) + 7);
+    EXPECT_EQ(eya_shared_range_get_size(&inner), 2u);
+    EXPECT_EQ(eya_shared_range_get_use_count(&parent), 3u);
+
+    eya_shared_range_release(&parent);
+    eya_shared_range_release(&tail);
+    EXPECT_EQ(std::memcmp(data_of(&inner), "78", 2), 0) << "slice keeps the block alive";
+
+    eya_shared_range_release(&inner);
+}
+
+TEST(eya_shared_range_slice, rejects_out_of_range)
+{
+    eya_shared_range_t parent = make_text("0123456789");
+
+    EXPECT_DEATH(eya_shared_range_slice(&parent, 8, 3), ".*");
+    EXPECT_DEATH(eya_shared_range_slice(&parent, 11, 1), ".*");
+    EXPECT_DEATH(eya_shared_range_slice(&parent, 0, 0), ".*");
+
+    eya_shared_range_release(&parent);
+}
+
+TEST(eya_shared_range_make_writable, copies_only_when_shared)
+{
+    eya_shared_range_t reader = make_text("shared");
+    eya_shared_range_t writer = eya_shared_range_share(&reader);
+
+    eya_memory_range_t *dst = eya_shared_range_make_writable(&writer);
+    static_cast<char *>(eya_memory_range_get_begin(dst))[0] = 'S';
+
+    EXPECT_NE(data_of(&reader), data_of(&writer));
+    EXPECT_EQ(std::memcmp(data_of(&reader), "shared", 6), 0) << "readers keep the old bytes";
+    EXPECT_EQ(std::memcmp(data_of(&writer), "Shared", 6), 0);
+    EXPECT_TRUE(eya_shared_range_is_unique(&reader));
+    EXPECT_TRUE(eya_shared_range_is_unique(&writer));
+
+    const char *before = data_of(&writer);
+    eya_shared_range_make_writable(&writer);
+    EXPECT_EQ(data_of(&writer), before) << "a unique owner writes in place";
+
+    eya_shared_range_release(&reader);
+    eya_shared_range_release(&writer);
+}
+
+TEST(eya_shared_range_make_writable, detaches_only_the_slice)
+{
+    eya_shared_range_t parent = make_text("0123456789");
+    eya_shared_range_t slice  = eya_shared_range_slice(&parent, 2, 3);
+
+    eya_memory_range_t *dst = eya_shared_range_make_writable(&slice);
+    EXPECT_EQ(eya_memory_range_get_size(dst), 3u);
+    EXPECT_EQ(std::memcmp(eya_memory_range_get_begin(dst), "234", 3), 0);
+    EXPECT_TRUE(eya_shared_range_is_unique(&parent));
+
+    eya_shared_range_release(&slice);
+    eya_shared_range_release(&parent);
+}
+
+static void
+share_and_release(void *arg)
+{
+    auto *range = static_cast<eya_shared_range_t *>(arg);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        eya_shared_range_t copy = eya_shared_range_share(range);
+        eya_shared_range_release(&copy);
+    }
+}
+
+TEST(eya_shared_range_share, counts_concurrent_owners)
+{
+    eya_shared_range_t range = make_text("concurrent");
+    eya_thread_t       threads[4];
+
+    for (auto &thread : threads)
+        eya_thread_create(&thread, share_and_release, &range);
+    for (auto &thread : threads)
+        eya_thread_join(&thread);
+
+    EXPECT_TRUE(eya_shared_range_is_unique(&range));
+    eya_shared_range_release(&range);
+}
+
+static int shared_range_frees = 0;
+
+static void
+counting_free(void *ptr)
+{
+    shared_range_frees++;
+    std::free(ptr);
+}
+
+TEST(eya_shared_range_release, frees_with_the_allocator_that_made_the_block)
+{
+    eya_memory_allocator_t *runtime  = eya_runtime_allocator();
+    const auto              original = *runtime;
+
+    runtime->alloc_fn   = std::malloc;
+    runtime->dealloc_fn = counting_free;
+    eya_shared_range_t range = make_text("owned");
+    *runtime                 = original;
+
+    eya_shared_range_release(&range);
+    EXPECT_EQ(shared_range_frees, 1);
+}
@@ -0,0 +1,129 @@
+#include <eya/spsc_queue.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+struct spsc_queue_transfer
+{
+    eya_spsc_queue_t *queue;
+    std::uint32_t     count;
+};
+
+static void
+spsc_queue_produce(void *arg)
+{
+    auto         *transfer = static_cast<spsc_queue_transfer *>(arg);
+    std::uint32_t batch[7];
+    std::uint32_t next = 0;
+
+    while (next < transfer->count)
+    {
+        std::uint32_t n = 0;
+        while (n < 7 && next + n < transfer->count)
+        {
+            batch[n] = next + n;
+            ++n;
+        }
+        next += static_cast<std::uint32_t>(eya_spsc_queue_push_bulk(transfer->queue, batch, n));
+    }
+}
+
+TEST(eya_spsc_queue_init, creates_empty_aligned_ring)
+{
+    eya_spsc_queue_t queue;
+    eya_spsc_queue_init(&queue, 16, sizeof(int));
+
+    EXPECT_EQ(eya_spsc_queue_get_capacity(&queue), 16u);
+    EXPECT_EQ(eya_spsc_queue_get_size(&queue), 0u);
+    EXPECT_TRUE(eya_memory_range_is_aligned(&queue.buffer.range, EYA_ATOMIC_CACHE_LINE_SIZE));
+
+    eya_spsc_queue_destroy(&queue);
+}
+
+TEST(eya_spsc_queue_init, handles_invalid_arguments)
+{
+    eya_spsc_queue_t queue;
+    EXPECT_DEATH(eya_spsc_queue_init(nullptr, 16, 4), ".*");
+    EXPECT_DEATH(eya_spsc_queue_init(&queue, 12, 4), ".*");
+    EXPECT_DEATH(eya_spsc_queue_init(&queue, 0, 4), ".*");
+    EXPECT_DEATH(eya_spsc_queue_init(&queue, 16, 0), ".*");
+}
+
+TEST(eya_spsc_queue_try_push, keeps_fifo_order_until_full)
+{
+    eya_spsc_queue_t queue;
+    eya_spsc_queue_init(&queue, 4, sizeof(int));
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(eya_spsc_queue_try_push(&queue, &i));
+
+    int extra = 99;
+    EXPECT_FALSE(eya_spsc_queue_try_push(&queue, &extra));
+    EXPECT_EQ(eya_spsc_queue_get_size(&queue), 4u);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int value = -1;
+        EXPECT_TRUE(eya_spsc_queue_try_pop(&queue, &value));
+        EXPECT_EQ(value, i);
+    }
+
+    int value = -1;
+    EXPECT_FALSE(eya_spsc_queue_try_pop(&queue, &value));
+    EXPECT_EQ(value, -1);
+
+    eya_spsc_queue_destroy(&queue);
+}
+
+TEST(eya_spsc_queue_push_bulk, wraps_around_the_ring)
+{
+    eya_spsc_queue_t queue;
+    eya_spsc_queue_init(&queue, 8, sizeof(short));
+
+    const short first[6] = {1, 2, 3, 4, 5, 6};
+    short       out[8]   = {};
+
+    EXPECT_EQ(eya_spsc_queue_push_bulk(&queue, first, 6), 6u);
+    EXPECT_EQ(eya_spsc_queue_pop_bulk(&queue, out, 5), 5u);
+
+    const short second[8] = {7, 8, 9, 10, 11, 12, 13, 14};
+    EXPECT_EQ(eya_spsc_queue_push_bulk(&queue, second, 8), 7u);
+    EXPECT_EQ(eya_spsc_queue_get_size(&queue), 8u);
+
+    EXPECT_EQ(eya_spsc_queue_pop_bulk(&queue, out, 8), 8u);
+    for (short i = 0; i < 8; ++i)
+        EXPECT_EQ(out[i], i + 6);
+
+    EXPECT_EQ(eya_spsc_queue_pop_bulk(&queue, out, 8), 0u);
+    EXPECT_EQ(eya_spsc_queue_push_bulk(&queue, nullptr, 0), 0u);
+    EXPECT_DEATH(eya_spsc_queue_push_bulk(&queue, nullptr, 1), ".*");
+
+    eya_spsc_queue_destroy(&queue);
+}
+
+TEST(eya_spsc_queue_pop_bulk, transfers_between_threads_in_order)
+{
+    eya_spsc_queue_t queue;
+    eya_spsc_queue_init(&queue, 64, sizeof(std::uint32_t));
+
+    spsc_queue_transfer transfer{&queue, 200000};
+    eya_thread_t        producer;
+    eya_thread_create(&producer, spsc_queue_produce, &transfer);
+
+    std::uint32_t expected = 0;
+    bool          ordered  = true;
+    while (expected < transfer.count)
+    {
+        std::uint32_t     batch[16];
+        const eya_usize_t n = eya_spsc_queue_pop_bulk(&queue, batch, 16);
+        for (eya_usize_t i = 0; i < n; ++i)
+            ordered = ordered && batch[i] == expected++;
+    }
+
+    eya_thread_join(&producer);
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(eya_spsc_queue_get_size(&queue), 0u);
+
+    eya_spsc_queue_destroy(&queue);
+}
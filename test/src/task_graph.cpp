@@ -0,0 +1,252 @@
+#include <eya/runtime_throw_with_code.h>
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_try.h>
+#include <eya/task_graph.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+static constexpr eya_usize_t task_graph_chunks = 64;
+
+struct task_graph_batch
+{
+    std::atomic<int>         stage[task_graph_chunks]; // bit per node done on the chunk
+    std::atomic<int>         active;                   // chunks between the first and last node
+    std::atomic<int>         peak;                     // largest value of active
+    std::atomic<int>         errors;                   // nodes run before their dependencies
+    std::vector<eya_usize_t> order;                    // chunks in the order of the serial node
+};
+
+static void
+task_graph_mark(task_graph_batch *batch, eya_usize_t chunk, int bit, int needed)
+{
+    if ((batch->stage[chunk].load() & needed) != needed)
+        batch->errors.fetch_add(1);
+    batch->stage[chunk].fetch_or(bit);
+}
+
+static void
+task_graph_parse(void *context, eya_usize_t chunk)
+{
+    auto     *batch  = static_cast<task_graph_batch *>(context);
+    const int active = batch->active.fetch_add(1) + 1;
+
+    for (int peak = batch->peak.load(); active > peak;)
+        batch->peak.compare_exchange_weak(peak, active);
+    task_graph_mark(batch, chunk, 1, 0);
+}
+
+static void
+task_graph_left(void *context, eya_usize_t chunk)
+{
+    task_graph_mark(static_cast<task_graph_batch *>(context), chunk, 2, 1);
+}
+
+static void
+task_graph_right(void *context, eya_usize_t chunk)
+{
+    task_graph_mark(static_cast<task_graph_batch *>(context), chunk, 4, 1);
+}
+
+static void
+task_graph_aggregate(void *context, eya_usize_t chunk)
+{
+    auto *batch = static_cast<task_graph_batch *>(context);
+
+    task_graph_mark(batch, chunk, 8, 6);
+    batch->order.push_back(chunk);
+    batch->active.fetch_sub(1);
+}
+
+static void
+task_graph_nothing(void *, eya_usize_t)
+{
+}
+
+static void
+task_graph_fail(void *context, eya_usize_t chunk)
+{
+    static_cast<std::atomic<int> *>(context)->fetch_add(1);
+    if (chunk == 3)
+        eya_runtime_throw_with_code(EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+}
+
+static int
+task_graph_run_error(eya_task_graph_t *graph, eya_thread_pool_t *pool)
+{
+    eya_runtime_try(e)
+    {
+        eya_task_graph_run(graph, pool, task_graph_chunks, 2);
+        eya_runtime_try_return(0);
+    }
+    eya_runtime_catch
+    {
+        return eya_error_get_code(reinterpret_cast<eya_error_t *>(&e.exception));
+    }
+}
+
+TEST(eya_task_graph_add, numbers_nodes_in_order)
+{
+    eya_task_graph_t *graph = eya_task_graph_make(nullptr);
+
+    for (eya_usize_t i = 0; i < 20; ++i)
+        EXPECT_EQ(eya_task_graph_add(graph, task_graph_nothing, nullptr), i);
+
+    EXPECT_DEATH(eya_task_graph_add(nullptr, task_graph_nothing, nullptr), ".*");
+    EXPECT_DEATH(eya_task_graph_add(graph, nullptr, nullptr), ".*");
+    EXPECT_DEATH(eya_task_graph_depend(graph, 0, 0), ".*");
+    EXPECT_DEATH(eya_task_graph_depend(graph, 0, 20), ".*");
+    EXPECT_DEATH(eya_task_graph_set_serial(graph, 20), ".*");
+    EXPECT_DEATH(eya_task_graph_get_node_runs(graph, 20), ".*");
+
+    eya_task_graph_free(graph);
+    eya_task_graph_free(nullptr);
+}
+
+TEST(eya_task_graph_run, pipelines_diamond_over_chunks)
+{
+    eya_thread_pool_t *pool  = eya_thread_pool_make(4, nullptr);
+    eya_task_graph_t  *graph = eya_task_graph_make(nullptr);
+    auto              *batch = new task_graph_batch();
+
+    // parse → (left, right) → aggregate, where aggregate keeps the chunk order.
+    const eya_usize_t parse     = eya_task_graph_add(graph, task_graph_parse, batch);
+    const eya_usize_t left      = eya_task_graph_add(graph, task_graph_left, batch);
+    const eya_usize_t right     = eya_task_graph_add(graph, task_graph_right, batch);
+    const eya_usize_t aggregate = eya_task_graph_add(graph, task_graph_aggregate, batch);
+
+    eya_task_graph_depend(graph, left, parse);
+    eya_task_graph_depend(graph, right, parse);
+    eya_task_graph_depend(graph, aggregate, left);
+    eya_task_graph_depend(graph, aggregate, right);
+    eya_task_graph_set_serial(graph, aggregate);
+
+    eya_task_graph_run(graph, pool, task_graph_chunks, 3);
+
+    EXPECT_EQ(batch->errors.load(), 0);
+    EXPECT_LE(batch->peak.load(), 3);
+    EXPECT_EQ(batch->active.load(), 0);
+    ASSERT_EQ(batch->order.size(), task_graph_chunks);
+    for (eya_usize_t i = 0; i < task_graph_chunks; ++i)
+    {
+        EXPECT_EQ(batch->order[i], i);
+        EXPECT_EQ(batch->stage[i].load(), 15);
+    }
+
+    for (eya_usize_t node = 0; node < 4; ++node)
+        EXPECT_EQ(eya_task_graph_get_node_runs(graph, node), task_graph_chunks);
+
+    delete batch;
+    eya_task_graph_free(graph);
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_task_graph_run, runs_one_chunk_at_a_time)
+{
+    eya_thread_pool_t *pool  = eya_thread_pool_make(2, nullptr);
+    eya_task_graph_t  *graph = eya_task_graph_make(nullptr);
+    auto              *batch = new task_graph_batch();
+
+    const eya_usize_t parse     = eya_task_graph_add(graph, task_graph_parse, batch);
+    const eya_usize_t left      = eya_task_graph_add(graph, task_graph_left, batch);
+    const eya_usize_t right     = eya_task_graph_add(graph, task_graph_right, batch);
+    const eya_usize_t aggregate = eya_task_graph_add(graph, task_graph_aggregate, batch);
+
+    eya_task_graph_depend(graph, aggregate, right);
+    eya_task_graph_depend(graph, aggregate, left);
+    eya_task_graph_depend(graph, right, parse);
+    eya_task_graph_depend(graph, left, parse);
+
+    // More slots than chunks are never used.
+    eya_task_graph_run(graph, pool, 1, 8);
+    EXPECT_EQ(batch->peak.load(), 1);
+    EXPECT_EQ(batch->stage[0].load(), 15);
+
+    batch->order.clear();
+    eya_task_graph_run(graph, pool, task_graph_chunks, 1);
+
+    EXPECT_EQ(batch->errors.load(), 0);
+    EXPECT_EQ(batch->peak.load(), 1);
+    ASSERT_EQ(batch->order.size(), task_graph_chunks);
+    for (eya_usize_t i = 0; i < task_graph_chunks; ++i)
+        EXPECT_EQ(batch->order[i], i);
+
+    delete batch;
+    eya_task_graph_free(graph);
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_task_graph_run, reports_node_statistics)
+{
+    eya_thread_pool_t *pool  = eya_thread_pool_make(2, nullptr);
+    eya_task_graph_t  *graph = eya_task_graph_make(nullptr);
+    auto              *batch = new task_graph_batch();
+
+    const eya_usize_t parse = eya_task_graph_add(graph, task_graph_parse, batch);
+    const eya_usize_t idle  = eya_task_graph_add(graph, task_graph_nothing, nullptr);
+
+    eya_task_graph_run(graph, pool, task_graph_chunks, 4);
+    EXPECT_EQ(eya_task_graph_get_node_runs(graph, parse), task_graph_chunks);
+    EXPECT_EQ(eya_task_graph_get_node_runs(graph, idle), task_graph_chunks);
+    EXPECT_GT(eya_task_graph_get_node_time(graph, parse), 0u);
+
+    // Statistics cover the last run only.
+    eya_task_graph_run(graph, pool, 5, 4);
+    EXPECT_EQ(eya_task_graph_get_node_runs(graph, parse), 5u);
+
+    eya_task_graph_run(graph, pool, 0, 4);
+    EXPECT_EQ(eya_task_graph_get_node_runs(graph, parse), 0u);
+    EXPECT_EQ(eya_task_graph_get_node_time(graph, parse), 0u);
+
+    EXPECT_DEATH(eya_task_graph_run(nullptr, pool, 1, 1), ".*");
+    EXPECT_DEATH(eya_task_graph_run(graph, nullptr, 1, 1), ".*");
+    EXPECT_DEATH(eya_task_graph_run(graph, pool, 1, 0), ".*");
+
+    delete batch;
+    eya_task_graph_free(graph);
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_task_graph_run, rejects_cycles)
+{
+    eya_thread_pool_t *pool  = eya_thread_pool_make(2, nullptr);
+    eya_task_graph_t  *graph = eya_task_graph_make(nullptr);
+
+    const eya_usize_t a = eya_task_graph_add(graph, task_graph_nothing, nullptr);
+    const eya_usize_t b = eya_task_graph_add(graph, task_graph_nothing, nullptr);
+    const eya_usize_t c = eya_task_graph_add(graph, task_graph_nothing, nullptr);
+
+    eya_task_graph_depend(graph, b, a);
+    eya_task_graph_depend(graph, c, b);
+    eya_task_graph_run(graph, pool, 4, 2);
+
+    eya_task_graph_depend(graph, a, c);
+    EXPECT_DEATH(eya_task_graph_run(graph, pool, 4, 2), ".*");
+    EXPECT_DEATH(eya_task_graph_run(graph, pool, 0, 2), ".*");
+
+    eya_task_graph_free(graph);
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_task_graph_run, rethrows_node_exception)
+{
+    eya_thread_pool_t *pool  = eya_thread_pool_make(2, nullptr);
+    eya_task_graph_t  *graph = eya_task_graph_make(nullptr);
+    std::atomic<int>   calls{0};
+
+    const eya_usize_t fail = eya_task_graph_add(graph, task_graph_fail, &calls);
+    const eya_usize_t next = eya_task_graph_add(graph, task_graph_nothing, nullptr);
+
+    eya_task_graph_depend(graph, next, fail);
+    eya_task_graph_set_serial(graph, fail);
+
+    EXPECT_EQ(task_graph_run_error(graph, pool), EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+
+    // Chunks after the failing one are not processed.
+    EXPECT_EQ(calls.load(), 4);
+    EXPECT_LE(eya_task_graph_get_node_runs(graph, next), 3u);
+
+    eya_task_graph_free(graph);
+    eya_thread_pool_free(pool);
+}
@@ -0,0 +1,121 @@
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_allocator.h>
+#include <eya/thread_mutex.h>
+#include <eya/thread_cond.h>
+#include <eya/runtime_try.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+struct thread_counter
+{
+    eya_thread_mutex_t mutex;
+    eya_thread_cond_t  cond;
+    int                value;
+};
+
+static void
+thread_increment(void *arg)
+{
+    auto *counter = static_cast<thread_counter *>(arg);
+    for (int i = 0; i < 1000; ++i)
+    {
+        eya_thread_mutex_lock(&counter->mutex);
+        counter->value++;
+        eya_thread_cond_signal(&counter->cond);
+        eya_thread_mutex_unlock(&counter->mutex);
+    }
+}
+
+static void
+thread_catch_error(void *arg)
+{
+    auto *code = static_cast<int *>(arg);
+
+    eya_runtime_try(e)
+    {
+        eya_thread_join(nullptr);
+        eya_runtime_try_return();
+    }
+    eya_runtime_catch
+    {
+        *code = eya_error_get_code(reinterpret_cast<eya_error_t *>(&e.exception));
+    }
+}
+
+static void
+thread_read_allocator(void *arg)
+{
+    *static_cast<eya_memory_allocator_t *>(arg) = *eya_runtime_allocator();
+}
+
+TEST(eya_thread_create, runs_function_with_argument)
+{
+    thread_counter counter{};
+    eya_thread_mutex_init(&counter.mutex);
+    eya_thread_cond_init(&counter.cond);
+
+    eya_thread_t threads[4];
+    for (auto &thread : threads)
+        eya_thread_create(&thread, thread_increment, &counter);
+    for (auto &thread : threads)
+        eya_thread_join(&thread);
+
+    EXPECT_EQ(counter.value, 4000);
+
+    eya_thread_cond_destroy(&counter.cond);
+    eya_thread_mutex_destroy(&counter.mutex);
+}
+
+TEST(eya_thread_create, resets_exception_stack_of_new_thread)
+{
+    int          code = 0;
+    eya_thread_t thread;
+    eya_thread_create(&thread, thread_catch_error, &code);
+    eya_thread_join(&thread);
+
+    EXPECT_EQ(code, EYA_RUNTIME_ERROR_NULL_POINTER);
+}
+
+TEST(eya_thread_create, inherits_runtime_allocator)
+{
+    eya_memory_allocator_t allocator{};
+    eya_thread_t           thread;
+    eya_thread_create(&thread, thread_read_allocator, &allocator);
+    eya_thread_join(&thread);
+
+    EXPECT_EQ(allocator.alloc_fn, eya_runtime_allocator()->alloc_fn);
+    EXPECT_EQ(allocator.dealloc_fn, eya_runtime_allocator()->dealloc_fn);
+}
+
+TEST(eya_thread_create, handles_null_pointer)
+{
+    eya_thread_t thread;
+    EXPECT_DEATH(eya_thread_create(nullptr, thread_increment, nullptr), ".*");
+    EXPECT_DEATH(eya_thread_create(&thread, nullptr, nullptr), ".*");
+}
+
+TEST(eya_thread_cond_wait, wakes_up_when_signaled)
+{
+    thread_counter counter{};
+    eya_thread_mutex_init(&counter.mutex);
+    eya_thread_cond_init(&counter.cond);
+
+    eya_thread_t thread;
+    eya_thread_create(&thread, thread_increment, &counter);
+
+    eya_thread_mutex_lock(&counter.mutex);
+    while (counter.value < 1000)
+        eya_thread_cond_wait(&counter.cond, &counter.mutex);
+    eya_thread_mutex_unlock(&counter.mutex);
+
+    eya_thread_join(&thread);
+    EXPECT_EQ(counter.value, 1000);
+
+    eya_thread_cond_destroy(&counter.cond);
+    eya_thread_mutex_destroy(&counter.mutex);
+}
+
+TEST(eya_thread_hardware_concurrency, returns_at_least_one)
+{
+    EXPECT_GE(eya_thread_hardware_concurrency(), 1u);
+}
@@ -0,0 +1,86 @@
+#include <eya/thread_barrier.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+struct thread_barrier_team
+{
+    eya_thread_barrier_t     barrier;
+    std::vector<int>         marks;  // round last written by every thread
+    std::atomic<int>         serial; // calls that returned true
+    std::atomic<int>         errors; // marks of other threads seen behind
+    std::atomic<eya_usize_t> next;   // index handed to the next thread
+    int                      rounds;
+};
+
+static void
+thread_barrier_member(void *arg)
+{
+    auto             *team  = static_cast<thread_barrier_team *>(arg);
+    const eya_usize_t index = team->next.fetch_add(1);
+
+    for (int round = 1; round <= team->rounds; ++round)
+    {
+        team->marks[index] = round;
+        if (eya_thread_barrier_wait(&team->barrier))
+            team->serial.fetch_add(1);
+
+        for (int mark : team->marks)
+        {
+            if (mark != round)
+                team->errors.fetch_add(1);
+        }
+
+        // The second wait keeps the next round's writes away from the reads above.
+        if (eya_thread_barrier_wait(&team->barrier))
+            team->serial.fetch_add(1);
+    }
+}
+
+static void
+thread_barrier_run(eya_usize_t threads, int rounds)
+{
+    thread_barrier_team team;
+    team.marks.assign(threads, 0);
+    team.serial = 0;
+    team.errors = 0;
+    team.next   = 0;
+    team.rounds = rounds;
+    eya_thread_barrier_init(&team.barrier, static_cast<eya_uint_t>(threads));
+
+    std::vector<eya_thread_t> handles(threads);
+    for (auto &handle : handles)
+        eya_thread_create(&handle, thread_barrier_member, &team);
+    for (auto &handle : handles)
+        eya_thread_join(&handle);
+
+    EXPECT_EQ(team.errors.load(), 0) << threads << " threads";
+    EXPECT_EQ(team.serial.load(), 2 * rounds) << threads << " threads";
+}
+
+TEST(eya_thread_barrier_wait, returns_true_once_per_phase)
+{
+    eya_thread_barrier_t barrier;
+    eya_thread_barrier_init(&barrier, 1);
+
+    EXPECT_EQ(sizeof(barrier.left) + sizeof(barrier.count) + sizeof(barrier.left_pad),
+              static_cast<size_t>(EYA_ATOMIC_CACHE_LINE_SIZE));
+    for (int i = 0; i < 3; ++i)
+        EXPECT_TRUE(eya_thread_barrier_wait(&barrier));
+
+    EXPECT_DEATH(eya_thread_barrier_init(nullptr, 1), ".*");
+    EXPECT_DEATH(eya_thread_barrier_init(&barrier, 0), ".*");
+    EXPECT_DEATH(eya_thread_barrier_wait(nullptr), ".*");
+}
+
+// Contention benchmark: 2 to 128 threads cross the barrier in lock step,
+// so both the spinning and the sleeping paths are taken.
+TEST(eya_thread_barrier_wait, separates_phases_of_many_threads)
+{
+    thread_barrier_run(2, 500);
+    thread_barrier_run(8, 200);
+    thread_barrier_run(32, 50);
+    thread_barrier_run(128, 10);
+}
@@ -0,0 +1,68 @@
+#include <eya/thread_event.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+struct thread_event_result
+{
+    eya_thread_event_t ready;
+    int                value;  // published before the event is set
+    std::atomic<int>   errors; // waiters that saw the value unpublished
+};
+
+static void
+thread_event_waiter(void *arg)
+{
+    auto *result = static_cast<thread_event_result *>(arg);
+
+    eya_thread_event_wait(&result->ready);
+    if (result->value != 42)
+        result->errors.fetch_add(1);
+}
+
+TEST(eya_thread_event_set, stays_set)
+{
+    eya_thread_event_t event = EYA_THREAD_EVENT_INITIALIZER;
+
+    EXPECT_EQ(sizeof(event), 4u);
+    EXPECT_FALSE(eya_thread_event_is_set(&event));
+    eya_thread_event_set(&event);
+    EXPECT_TRUE(eya_thread_event_is_set(&event));
+    eya_thread_event_set(&event);
+    eya_thread_event_wait(&event);
+    EXPECT_TRUE(eya_thread_event_is_set(&event));
+
+    eya_thread_event_init(&event);
+    EXPECT_FALSE(eya_thread_event_is_set(&event));
+
+    EXPECT_DEATH(eya_thread_event_init(nullptr), ".*");
+    EXPECT_DEATH(eya_thread_event_set(nullptr), ".*");
+    EXPECT_DEATH(eya_thread_event_wait(nullptr), ".*");
+}
+
+// Contention benchmark: 128 threads wait for one published value,
+// most of them go to sleep before it arrives.
+TEST(eya_thread_event_wait, releases_all_waiters)
+{
+    thread_event_result result;
+    result.value  = 0;
+    result.errors = 0;
+    eya_thread_event_init(&result.ready);
+
+    std::vector<eya_thread_t> waiters(128);
+    for (auto &waiter : waiters)
+        eya_thread_create(&waiter, thread_event_waiter, &result);
+
+    for (int i = 0; i < 100; ++i)
+        eya_thread_yield();
+
+    result.value = 42;
+    eya_thread_event_set(&result.ready);
+
+    for (auto &waiter : waiters)
+        eya_thread_join(&waiter);
+
+    EXPECT_EQ(result.errors.load(), 0);
+}
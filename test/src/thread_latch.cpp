@@ -0,0 +1,82 @@
+#include <eya/thread_latch.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+struct thread_latch_work
+{
+    eya_thread_latch_t latch;
+    std::atomic<int>   done;   // count downs made
+    std::atomic<int>   errors; // waiters released before all count downs
+};
+
+static void
+thread_latch_worker(void *arg)
+{
+    auto *work = static_cast<thread_latch_work *>(arg);
+
+    work->done.fetch_add(1);
+    eya_thread_latch_count_down(&work->latch, 1);
+}
+
+static void
+thread_latch_waiter(void *arg)
+{
+    auto *work = static_cast<thread_latch_work *>(arg);
+
+    eya_thread_latch_wait(&work->latch);
+    if (work->done.load() != 64)
+        work->errors.fetch_add(1);
+}
+
+TEST(eya_thread_latch_count_down, opens_at_zero)
+{
+    eya_thread_latch_t latch;
+
+    eya_thread_latch_init(&latch, 0);
+    EXPECT_TRUE(eya_thread_latch_try_wait(&latch));
+    eya_thread_latch_wait(&latch);
+
+    eya_thread_latch_init(&latch, 5);
+    EXPECT_FALSE(eya_thread_latch_try_wait(&latch));
+    eya_thread_latch_count_down(&latch, 3);
+    EXPECT_FALSE(eya_thread_latch_try_wait(&latch));
+    eya_thread_latch_count_down(&latch, 0);
+    EXPECT_DEATH(eya_thread_latch_count_down(&latch, 3), ".*");
+    eya_thread_latch_count_down(&latch, 2);
+    EXPECT_TRUE(eya_thread_latch_try_wait(&latch));
+    eya_thread_latch_wait(&latch);
+
+    EXPECT_DEATH(eya_thread_latch_init(nullptr, 1), ".*");
+    EXPECT_DEATH(eya_thread_latch_count_down(nullptr, 1), ".*");
+    EXPECT_DEATH(eya_thread_latch_wait(nullptr), ".*");
+}
+
+// Contention benchmark: 64 threads count down while 64 others wait.
+TEST(eya_thread_latch_wait, releases_waiters_after_last_count_down)
+{
+    thread_latch_work work;
+    work.done   = 0;
+    work.errors = 0;
+    eya_thread_latch_init(&work.latch, 64);
+
+    std::vector<eya_thread_t> waiters(64);
+    std::vector<eya_thread_t> workers(64);
+
+    for (auto &waiter : waiters)
+        eya_thread_create(&waiter, thread_latch_waiter, &work);
+    for (auto &worker : workers)
+        eya_thread_create(&worker, thread_latch_worker, &work);
+
+    eya_thread_latch_wait(&work.latch);
+    EXPECT_EQ(work.done.load(), 64);
+
+    for (auto &worker : workers)
+        eya_thread_join(&worker);
+    for (auto &waiter : waiters)
+        eya_thread_join(&waiter);
+
+    EXPECT_EQ(work.errors.load(), 0);
+}
@@ -0,0 +1,61 @@
+#include <eya/thread_lock.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+struct thread_lock_counter
+{
+    eya_thread_lock_t lock;
+    long              value;
+};
+
+static void
+thread_lock_increment(void *arg)
+{
+    auto *counter = static_cast<thread_lock_counter *>(arg);
+    for (int i = 0; i < 20000; ++i)
+    {
+        eya_thread_lock_lock(&counter->lock);
+        counter->value++;
+        eya_thread_lock_unlock(&counter->lock);
+    }
+}
+
+TEST(eya_thread_lock_try_lock, fails_while_held)
+{
+    eya_thread_lock_t lock = EYA_THREAD_LOCK_INITIALIZER;
+
+    EXPECT_EQ(sizeof(lock), 4u);
+    EXPECT_TRUE(eya_thread_lock_try_lock(&lock));
+    EXPECT_FALSE(eya_thread_lock_try_lock(&lock));
+    eya_thread_lock_unlock(&lock);
+    EXPECT_TRUE(eya_thread_lock_try_lock(&lock));
+    eya_thread_lock_unlock(&lock);
+}
+
+TEST(eya_thread_lock_lock, handles_invalid_arguments)
+{
+    EXPECT_DEATH(eya_thread_lock_init(nullptr), ".*");
+    EXPECT_DEATH(eya_thread_lock_lock(nullptr), ".*");
+    EXPECT_DEATH(eya_thread_lock_unlock(nullptr), ".*");
+}
+
+// Contention benchmark: eight threads increment one counter under the lock,
+// so most acquisitions go through the spin and sleep paths.
+TEST(eya_thread_lock_lock, excludes_contending_threads)
+{
+    thread_lock_counter       counter;
+    std::vector<eya_thread_t> threads(8);
+
+    eya_thread_lock_init(&counter.lock);
+    counter.value = 0;
+
+    for (auto &thread : threads)
+        eya_thread_create(&thread, thread_lock_increment, &counter);
+    for (auto &thread : threads)
+        eya_thread_join(&thread);
+
+    EXPECT_EQ(counter.value, 8 * 20000);
+    EXPECT_TRUE(eya_thread_lock_try_lock(&counter.lock));
+}
@@ -0,0 +1,417 @@
+#include <eya/runtime_throw_with_code.h>
+#include <eya/runtime_error_code.h>
+#include <eya/runtime_allocator.h>
+#include <eya/runtime_try.h>
+#include <eya/thread_pool.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+struct thread_pool_fib
+{
+    eya_thread_pool_t *pool;
+    int                n;
+    long              *out;
+};
+
+static void
+thread_pool_fib_task(void *closure)
+{
+    auto *args = static_cast<thread_pool_fib *>(closure);
+    if (args->n < 2)
+    {
+        *args->out = args->n;
+        return;
+    }
+
+    long                    a = 0;
+    long                    b = 0;
+    thread_pool_fib         left{args->pool, args->n - 1, &a};
+    thread_pool_fib         right{args->pool, args->n - 2, &b};
+    eya_thread_pool_group_t group;
+
+    eya_thread_pool_group_init(&group, args->pool);
+    eya_thread_pool_spawn(&group, thread_pool_fib_task, &left, sizeof(left));
+    eya_thread_pool_spawn(&group, thread_pool_fib_task, &right, sizeof(right));
+    eya_thread_pool_sync(&group);
+
+    *args->out = a + b;
+}
+
+static void
+thread_pool_increment(void *closure)
+{
+    (*static_cast<std::atomic<int> **>(closure))->fetch_add(1);
+}
+
+static void
+thread_pool_fail(void *)
+{
+    eya_runtime_throw_with_code(EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+}
+
+static void
+thread_pool_mark(void *context, eya_usize_t begin, eya_usize_t end)
+{
+    auto *marks = static_cast<std::atomic<int> *>(context);
+    for (eya_usize_t i = begin; i < end; ++i)
+        marks[i].fetch_add(1);
+}
+
+static void
+thread_pool_fail_range(void *, eya_usize_t begin, eya_usize_t)
+{
+    if (begin == 0)
+        eya_runtime_throw_with_code(EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+}
+
+static int
+thread_pool_sync_error(eya_thread_pool_group_t *group)
+{
+    eya_runtime_try(e)
+    {
+        eya_thread_pool_sync(group);
+        eya_runtime_try_return(0);
+    }
+    eya_runtime_catch
+    {
+        return eya_error_get_code(reinterpret_cast<eya_error_t *>(&e.exception));
+    }
+}
+
+static int
+thread_pool_parallel_for_error(eya_thread_pool_t *pool)
+{
+    eya_runtime_try(e)
+    {
+        eya_thread_pool_parallel_for(pool, 0, 1000, 10, thread_pool_fail_range, nullptr);
+        eya_runtime_try_return(0);
+    }
+    eya_runtime_catch
+    {
+        return eya_error_get_code(reinterpret_cast<eya_error_t *>(&e.exception));
+    }
+}
+
+struct thread_pool_phases
+{
+    std::vector<long> cells[2]; // written in even and odd phases
+    std::atomic<int>  errors;   // cells of the previous phase seen unwritten
+    std::atomic<long> last;     // largest phase started
+};
+
+static void
+thread_pool_phase(void *context, eya_usize_t phase, eya_usize_t member, eya_usize_t count)
+{
+    auto       *phases   = static_cast<thread_pool_phases *>(context);
+    const long  current  = static_cast<long>(phase);
+    const auto &previous = phases->cells[(phase + 1) % 2];
+
+    for (eya_usize_t i = 0; i < count; ++i)
+    {
+        if (previous[i] != current - 1)
+            phases->errors.fetch_add(1);
+    }
+
+    phases->cells[phase % 2][member] = current;
+    for (long last = phases->last.load(); current > last;)
+        phases->last.compare_exchange_weak(last, current);
+
+    if (phase == 2 && member == 1 && phases->cells[0].size() == 3)
+        eya_runtime_throw_with_code(EYA_RUNTIME_ERROR_OVERFLOW);
+}
+
+struct thread_pool_team
+{
+    eya_thread_pool_t *pool;
+    std::atomic<long>  done; // tasks run by the phase bodies
+};
+
+static void
+thread_pool_count_task(void *closure)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+    (*static_cast<std::atomic<long> **>(closure))->fetch_add(1);
+}
+
+/**
+ * Forks and joins from inside a phase, while siblings may still be queued.
+ */
+static void
+thread_pool_fork_phase(void *context, eya_usize_t, eya_usize_t, eya_usize_t)
+{
+    auto              *team = static_cast<thread_pool_team *>(context);
+    std::atomic<long> *done = &team->done;
+
+    eya_thread_pool_group_t group;
+    eya_thread_pool_group_init(&group, team->pool);
+    for (int i = 0; i < 50; ++i)
+        eya_thread_pool_spawn(&group, thread_pool_count_task, &done, sizeof(done));
+    eya_thread_pool_sync(&group);
+}
+
+/**
+ * Starts a team from a worker, so the members wait in its deque until stolen.
+ */
+static void
+thread_pool_team_task(void *closure)
+{
+    thread_pool_team *team = *static_cast<thread_pool_team **>(closure);
+    eya_thread_pool_parallel_phases(team->pool, 8, 4, thread_pool_fork_phase, team);
+}
+
+static void
+thread_pool_nested_phase(void *context, eya_usize_t, eya_usize_t member, eya_usize_t)
+{
+    auto *team = static_cast<thread_pool_team *>(context);
+    if (member == 0)
+        eya_thread_pool_parallel_phases(team->pool, 1, 1, thread_pool_fork_phase, team);
+}
+
+static int
+thread_pool_parallel_phases_error(eya_thread_pool_t        *pool,
+                                  eya_usize_t               member_count,
+                                  eya_thread_pool_phase_fn *fn,
+                                  void                     *context)
+{
+    eya_runtime_try(e)
+    {
+        eya_thread_pool_parallel_phases(pool, member_count, 10, fn, context);
+        eya_runtime_try_return(0);
+    }
+    eya_runtime_catch
+    {
+        return eya_error_get_code(reinterpret_cast<eya_error_t *>(&e.exception));
+    }
+}
+
+struct thread_pool_probe
+{
+    eya_thread_pool_t             *pool;
+    eya_usize_t                   *index;
+    eya_memory_allocator_alloc_fn **alloc_fn;
+};
+
+static void
+thread_pool_read_worker(void *closure)
+{
+    auto *probe      = static_cast<thread_pool_probe *>(closure);
+    *probe->index    = eya_thread_pool_get_worker_index(probe->pool);
+    *probe->alloc_fn = eya_runtime_allocator()->alloc_fn;
+}
+
+static void *
+thread_pool_test_alloc(eya_usize_t size)
+{
+    return malloc(size);
+}
+
+TEST(eya_thread_pool_make, starts_requested_workers)
+{
+    eya_thread_pool_t *pool = eya_thread_pool_make(3, nullptr);
+    EXPECT_EQ(eya_thread_pool_get_worker_count(pool), 3u);
+    eya_thread_pool_free(pool);
+
+    pool = eya_thread_pool_make(0, nullptr);
+    EXPECT_EQ(eya_thread_pool_get_worker_count(pool), eya_thread_hardware_concurrency());
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_make, installs_allocator_in_workers)
+{
+    const eya_memory_allocator_t   allocator = {thread_pool_test_alloc, free};
+    eya_thread_pool_t             *pool      = eya_thread_pool_make(2, &allocator);
+    eya_usize_t                    index     = 0;
+    eya_memory_allocator_alloc_fn *alloc_fn  = nullptr;
+    thread_pool_probe              probe{pool, &index, &alloc_fn};
+    eya_thread_pool_group_t        group;
+
+    eya_thread_pool_group_init(&group, pool);
+    eya_thread_pool_spawn(&group, thread_pool_read_worker, &probe, sizeof(probe));
+    eya_thread_pool_sync(&group);
+
+    EXPECT_LT(index, 2u);
+    EXPECT_EQ(alloc_fn, thread_pool_test_alloc);
+    EXPECT_EQ(eya_thread_pool_get_worker_index(pool), EYA_USIZE_T_MAX);
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_spawn, runs_every_task_before_sync_returns)
+{
+    eya_thread_pool_t      *pool = eya_thread_pool_make(4, nullptr);
+    std::atomic<int>        counter{0};
+    std::atomic<int>       *ptr = &counter;
+    eya_thread_pool_group_t group;
+
+    eya_thread_pool_group_init(&group, pool);
+    for (int i = 0; i < 1000; ++i)
+        eya_thread_pool_spawn(&group, thread_pool_increment, &ptr, sizeof(ptr));
+    eya_thread_pool_sync(&group);
+
+    EXPECT_EQ(counter.load(), 1000);
+
+    // The group is reusable after a sync.
+    eya_thread_pool_spawn(&group, thread_pool_increment, &ptr, sizeof(ptr));
+    eya_thread_pool_sync(&group);
+    EXPECT_EQ(counter.load(), 1001);
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_spawn, supports_nested_fork_join)
+{
+    eya_thread_pool_t      *pool   = eya_thread_pool_make(4, nullptr);
+    long                    result = 0;
+    thread_pool_fib         root{pool, 20, &result};
+    eya_thread_pool_group_t group;
+
+    eya_thread_pool_group_init(&group, pool);
+    eya_thread_pool_spawn(&group, thread_pool_fib_task, &root, sizeof(root));
+    eya_thread_pool_sync(&group);
+
+    EXPECT_EQ(result, 6765);
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_spawn, handles_invalid_arguments)
+{
+    eya_thread_pool_t      *pool = eya_thread_pool_make(1, nullptr);
+    eya_thread_pool_group_t group;
+    char                    big[EYA_THREAD_POOL_CLOSURE_SIZE + 1] = {};
+
+    eya_thread_pool_group_init(&group, pool);
+    EXPECT_DEATH(eya_thread_pool_spawn(&group, thread_pool_fail, big, sizeof(big)), ".*");
+    EXPECT_DEATH(eya_thread_pool_spawn(&group, nullptr, nullptr, 0), ".*");
+    EXPECT_DEATH(eya_thread_pool_spawn(nullptr, thread_pool_fail, nullptr, 0), ".*");
+    EXPECT_DEATH(eya_thread_pool_spawn(&group, thread_pool_fail, nullptr, 4), ".*");
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_sync, rethrows_task_exception)
+{
+    eya_thread_pool_t      *pool = eya_thread_pool_make(2, nullptr);
+    std::atomic<int>        counter{0};
+    std::atomic<int>       *ptr = &counter;
+    eya_thread_pool_group_t group;
+
+    eya_thread_pool_group_init(&group, pool);
+    for (int i = 0; i < 10; ++i)
+        eya_thread_pool_spawn(&group, thread_pool_increment, &ptr, sizeof(ptr));
+    eya_thread_pool_spawn(&group, thread_pool_fail, nullptr, 0);
+
+    EXPECT_EQ(thread_pool_sync_error(&group), EYA_RUNTIME_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(counter.load(), 10);
+
+    // The error is cleared by the sync that reported it.
+    EXPECT_EQ(thread_pool_sync_error(&group), 0);
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_parallel_for, visits_every_index_once)
+{
+    eya_thread_pool_t            *pool = eya_thread_pool_make(4, nullptr);
+    std::vector<std::atomic<int>> marks(10007);
+
+    eya_thread_pool_parallel_for(pool, 0, marks.size(), 0, thread_pool_mark, marks.data());
+    for (auto &mark : marks)
+        ASSERT_EQ(mark.load(), 1);
+
+    eya_thread_pool_parallel_for(pool, 5, 5, 1, thread_pool_mark, marks.data());
+    EXPECT_EQ(marks[5].load(), 1);
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_parallel_for, rethrows_body_exception)
+{
+    eya_thread_pool_t *pool = eya_thread_pool_make(3, nullptr);
+    EXPECT_EQ(thread_pool_parallel_for_error(pool), EYA_RUNTIME_ERROR_OUT_OF_RANGE);
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_parallel_phases, finishes_every_phase_before_the_next)
+{
+    eya_thread_pool_t *pool = eya_thread_pool_make(4, nullptr);
+    thread_pool_phases phases;
+
+    phases.cells[0].assign(4, -2);
+    phases.cells[1].assign(4, -1);
+    phases.errors = 0;
+    phases.last   = -1;
+
+    eya_thread_pool_parallel_phases(pool, 0, 100, thread_pool_phase, &phases);
+    EXPECT_EQ(phases.errors.load(), 0);
+    EXPECT_EQ(phases.last.load(), 99);
+
+    eya_thread_pool_parallel_phases(pool, 2, 0, thread_pool_phase, &phases);
+    EXPECT_EQ(phases.last.load(), 99);
+
+    EXPECT_DEATH(eya_thread_pool_parallel_phases(nullptr, 1, 1, thread_pool_phase, nullptr), ".*");
+    EXPECT_DEATH(eya_thread_pool_parallel_phases(pool, 1, 1, nullptr, nullptr), ".*");
+    EXPECT_DEATH(eya_thread_pool_parallel_phases(pool, 5, 1, thread_pool_phase, nullptr), ".*");
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_parallel_phases, rethrows_body_exception)
+{
+    eya_thread_pool_t *pool = eya_thread_pool_make(4, nullptr);
+    thread_pool_phases phases;
+
+    phases.cells[0].assign(3, -2);
+    phases.cells[1].assign(3, -1);
+    phases.errors = 0;
+    phases.last   = -1;
+
+    // Member 1 throws in phase 2, nobody starts phase 3.
+    EXPECT_EQ(thread_pool_parallel_phases_error(pool, 3, thread_pool_phase, &phases),
+              EYA_RUNTIME_ERROR_OVERFLOW);
+    EXPECT_EQ(phases.errors.load(), 0);
+    EXPECT_EQ(phases.last.load(), 2);
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_parallel_phases, lets_phase_bodies_fork_and_join)
+{
+    eya_thread_pool_t *pool = eya_thread_pool_make(8, nullptr);
+
+    for (int round = 0; round < 100; ++round)
+    {
+        thread_pool_team        team = {pool, {0}};
+        thread_pool_team       *arg  = &team;
+        eya_thread_pool_group_t group;
+
+        eya_thread_pool_group_init(&group, pool);
+        eya_thread_pool_spawn(&group, thread_pool_team_task, &arg, sizeof(arg));
+        eya_thread_pool_sync(&group);
+
+        ASSERT_EQ(team.done.load(), 8 * 4 * 50);
+    }
+
+    eya_thread_pool_free(pool);
+}
+
+TEST(eya_thread_pool_parallel_phases, rejects_a_team_inside_a_team)
+{
+    eya_thread_pool_t *pool = eya_thread_pool_make(4, nullptr);
+    thread_pool_team   team = {pool, {0}};
+
+    EXPECT_EQ(thread_pool_parallel_phases_error(pool, 2, thread_pool_nested_phase, &team),
+              EYA_RUNTIME_ERROR_RESOURCE_EXHAUSTED);
+    EXPECT_EQ(team.done.load(), 0);
+
+    // The pool takes a new team once the rejected one has returned.
+    eya_thread_pool_parallel_phases(pool, 0, 2, thread_pool_fork_phase, &team);
+    EXPECT_EQ(team.done.load(), 2 * 4 * 50);
+
+    eya_thread_pool_free(pool);
+}
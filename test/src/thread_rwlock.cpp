@@ -0,0 +1,107 @@
+#include <eya/thread_rwlock.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+struct thread_rwlock_table
+{
+    eya_thread_rwlock_t lock;
+    long                cells[16];
+    std::atomic<long>   torn_reads;
+    std::atomic<int>    readers_inside;
+    std::atomic<int>    max_readers_inside;
+};
+
+static void
+thread_rwlock_write(void *arg)
+{
+    auto *table = static_cast<thread_rwlock_table *>(arg);
+    for (int i = 0; i < 2000; ++i)
+    {
+        eya_thread_rwlock_write_lock(&table->lock);
+        for (auto &cell : table->cells)
+            cell++;
+        eya_thread_rwlock_write_unlock(&table->lock);
+    }
+}
+
+static void
+thread_rwlock_read(void *arg)
+{
+    auto *table = static_cast<thread_rwlock_table *>(arg);
+    for (int i = 0; i < 20000; ++i)
+    {
+        eya_thread_rwlock_read_lock(&table->lock);
+
+        const int inside = ++table->readers_inside;
+        int       max    = table->max_readers_inside.load();
+        while (inside > max && !table->max_readers_inside.compare_exchange_weak(max, inside))
+        {
+        }
+
+        for (auto cell : table->cells)
+        {
+            if (cell != table->cells[0])
+                table->torn_reads++;
+        }
+
+        --table->readers_inside;
+        eya_thread_rwlock_read_unlock(&table->lock);
+    }
+}
+
+TEST(eya_thread_rwlock_try_read_lock, shares_with_readers_only)
+{
+    eya_thread_rwlock_t lock = EYA_THREAD_RWLOCK_INITIALIZER;
+
+    EXPECT_TRUE(eya_thread_rwlock_try_read_lock(&lock));
+    EXPECT_TRUE(eya_thread_rwlock_try_read_lock(&lock));
+    EXPECT_FALSE(eya_thread_rwlock_try_write_lock(&lock));
+    eya_thread_rwlock_read_unlock(&lock);
+    eya_thread_rwlock_read_unlock(&lock);
+
+    EXPECT_TRUE(eya_thread_rwlock_try_write_lock(&lock));
+    EXPECT_FALSE(eya_thread_rwlock_try_read_lock(&lock));
+    EXPECT_FALSE(eya_thread_rwlock_try_write_lock(&lock));
+    eya_thread_rwlock_write_unlock(&lock);
+
+    eya_thread_rwlock_read_lock(&lock);
+    eya_thread_rwlock_read_unlock(&lock);
+    EXPECT_TRUE(eya_thread_rwlock_try_write_lock(&lock));
+    eya_thread_rwlock_write_unlock(&lock);
+}
+
+TEST(eya_thread_rwlock_read_lock, handles_invalid_arguments)
+{
+    EXPECT_DEATH(eya_thread_rwlock_init(nullptr), ".*");
+    EXPECT_DEATH(eya_thread_rwlock_read_lock(nullptr), ".*");
+    EXPECT_DEATH(eya_thread_rwlock_write_lock(nullptr), ".*");
+}
+
+// Contention benchmark: a read-mostly mix of six readers and two writers.
+TEST(eya_thread_rwlock_write_lock, excludes_readers_and_writers)
+{
+    thread_rwlock_table       table;
+    std::vector<eya_thread_t> threads(8);
+
+    eya_thread_rwlock_init(&table.lock);
+    for (auto &cell : table.cells)
+        cell = 0;
+    table.torn_reads         = 0;
+    table.readers_inside     = 0;
+    table.max_readers_inside = 0;
+
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        eya_thread_create(&threads[i], i < 2 ? thread_rwlock_write : thread_rwlock_read, &table);
+    }
+    for (auto &thread : threads)
+        eya_thread_join(&thread);
+
+    EXPECT_EQ(table.torn_reads.load(), 0);
+    for (auto cell : table.cells)
+        EXPECT_EQ(cell, 2 * 2000);
+    EXPECT_GE(table.max_readers_inside.load(), 1);
+}
@@ -0,0 +1,96 @@
+#include <eya/thread_seqlock.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+struct thread_seqlock_point
+{
+    long x;
+    long y;
+    long z;
+};
+
+struct thread_seqlock_shared
+{
+    eya_thread_seqlock_t lock;
+    thread_seqlock_point point;
+    std::atomic<long>    torn_reads;
+};
+
+static void
+thread_seqlock_write(void *arg)
+{
+    auto *shared = static_cast<thread_seqlock_shared *>(arg);
+    for (long i = 1; i <= 20000; ++i)
+    {
+        eya_thread_seqlock_write_lock(&shared->lock);
+        shared->point.x++;
+        shared->point.y = shared->point.x * 2;
+        shared->point.z = shared->point.x * 3;
+        eya_thread_seqlock_write_unlock(&shared->lock);
+    }
+}
+
+static void
+thread_seqlock_read(void *arg)
+{
+    auto *shared = static_cast<thread_seqlock_shared *>(arg);
+    for (int i = 0; i < 20000; ++i)
+    {
+        thread_seqlock_point copy;
+        eya_thread_seqlock_read(&shared->lock, &copy, &shared->point, sizeof(copy));
+
+        if (copy.y != copy.x * 2 || copy.z != copy.x * 3)
+            shared->torn_reads++;
+    }
+}
+
+TEST(eya_thread_seqlock_read_begin, detects_concurrent_write)
+{
+    eya_thread_seqlock_t lock = EYA_THREAD_SEQLOCK_INITIALIZER;
+
+    const eya_uint_t sequence = eya_thread_seqlock_read_begin(&lock);
+    EXPECT_FALSE(eya_thread_seqlock_read_retry(&lock, sequence));
+
+    eya_thread_seqlock_write_lock(&lock);
+    eya_thread_seqlock_write_unlock(&lock);
+
+    EXPECT_TRUE(eya_thread_seqlock_read_retry(&lock, sequence));
+    EXPECT_EQ(eya_thread_seqlock_read_begin(&lock), sequence + 2);
+}
+
+TEST(eya_thread_seqlock_read, handles_invalid_arguments)
+{
+    eya_thread_seqlock_t lock  = EYA_THREAD_SEQLOCK_INITIALIZER;
+    long                 value = 0;
+
+    EXPECT_DEATH(eya_thread_seqlock_init(nullptr), ".*");
+    EXPECT_DEATH(eya_thread_seqlock_read(nullptr, &value, &value, sizeof(value)), ".*");
+    EXPECT_DEATH(eya_thread_seqlock_read(&lock, nullptr, &value, sizeof(value)), ".*");
+    EXPECT_DEATH(eya_thread_seqlock_write(&lock, &value, nullptr, sizeof(value)), ".*");
+}
+
+// Contention benchmark: two writers and four readers on a three-field structure.
+TEST(eya_thread_seqlock_read, returns_consistent_snapshots)
+{
+    thread_seqlock_shared     shared;
+    std::vector<eya_thread_t> threads(6);
+
+    eya_thread_seqlock_init(&shared.lock);
+    shared.point      = {0, 0, 0};
+    shared.torn_reads = 0;
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        eya_thread_create(&threads[i], i < 2 ? thread_seqlock_write : thread_seqlock_read, &shared);
+    for (auto &thread : threads)
+        eya_thread_join(&thread);
+
+    thread_seqlock_point last;
+    eya_thread_seqlock_read(&shared.lock, &last, &shared.point, sizeof(last));
+
+    EXPECT_EQ(shared.torn_reads.load(), 0);
+    EXPECT_EQ(last.x, 2 * 20000);
+    EXPECT_EQ(last.z, 3 * 2 * 20000);
+}
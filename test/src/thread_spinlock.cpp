@@ -0,0 +1,85 @@
+#include <eya/thread_spinlock.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+struct thread_spinlock_log
+{
+    eya_thread_spinlock_t lock;
+    long                  value;
+    long                  owner_changes;
+    int                   last_owner;
+};
+
+struct thread_spinlock_worker
+{
+    thread_spinlock_log *log;
+    int                  id;
+};
+
+static void
+thread_spinlock_append(void *arg)
+{
+    auto *worker = static_cast<thread_spinlock_worker *>(arg);
+    auto *log    = worker->log;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        eya_thread_spinlock_lock(&log->lock);
+        log->value++;
+        if (log->last_owner != worker->id)
+        {
+            log->last_owner = worker->id;
+            log->owner_changes++;
+        }
+        eya_thread_spinlock_unlock(&log->lock);
+    }
+}
+
+TEST(eya_thread_spinlock_try_lock, fails_while_held)
+{
+    eya_thread_spinlock_t lock = EYA_THREAD_SPINLOCK_INITIALIZER;
+
+    EXPECT_TRUE(eya_thread_spinlock_try_lock(&lock));
+    EXPECT_FALSE(eya_thread_spinlock_try_lock(&lock));
+    eya_thread_spinlock_unlock(&lock);
+
+    eya_thread_spinlock_lock(&lock);
+    EXPECT_FALSE(eya_thread_spinlock_try_lock(&lock));
+    eya_thread_spinlock_unlock(&lock);
+    EXPECT_TRUE(eya_thread_spinlock_try_lock(&lock));
+    eya_thread_spinlock_unlock(&lock);
+}
+
+TEST(eya_thread_spinlock_lock, handles_invalid_arguments)
+{
+    EXPECT_DEATH(eya_thread_spinlock_init(nullptr), ".*");
+    EXPECT_DEATH(eya_thread_spinlock_lock(nullptr), ".*");
+    EXPECT_DEATH(eya_thread_spinlock_try_lock(nullptr), ".*");
+    EXPECT_DEATH(eya_thread_spinlock_unlock(nullptr), ".*");
+}
+
+// Contention benchmark: four threads append to one log under the spinlock.
+TEST(eya_thread_spinlock_lock, excludes_contending_threads)
+{
+    thread_spinlock_log                 log;
+    std::vector<thread_spinlock_worker> workers(4);
+    std::vector<eya_thread_t>           threads(workers.size());
+
+    eya_thread_spinlock_init(&log.lock);
+    log.value         = 0;
+    log.owner_changes = 0;
+    log.last_owner    = -1;
+
+    for (size_t i = 0; i < workers.size(); ++i)
+    {
+        workers[i] = {&log, static_cast<int>(i)};
+        eya_thread_create(&threads[i], thread_spinlock_append, &workers[i]);
+    }
+    for (auto &thread : threads)
+        eya_thread_join(&thread);
+
+    EXPECT_EQ(log.value, 4 * 20000);
+    EXPECT_GE(log.owner_changes, 4);
+}
@@ -0,0 +1,214 @@
+#include <eya/thread_topology.h>
+#include <eya/thread_pool.h>
+#include <eya/thread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+/**
+ * Directory standing in for /sys/devices/system, removed with the fixture.
+ */
+class thread_topology_tree
+{
+public:
+    explicit thread_topology_tree(const char *name)
+        : m_root(fs::temp_directory_path() / name)
+    {
+        fs::remove_all(m_root);
+        fs::create_directories(m_root);
+    }
+
+    ~thread_topology_tree()
+    {
+        fs::remove_all(m_root);
+    }
+
+    void
+    write(const std::string &path, const std::string &text) const
+    {
+        const fs::path file = m_root / path;
+        fs::create_directories(file.parent_path());
+        std::ofstream(file) << text << '\n';
+    }
+
+    void
+    write_cpu(int id, int core, int package) const
+    {
+        const std::string dir = "cpu/cpu" + std::to_string(id) + "/topology/";
+        write(dir + "core_id", std::to_string(core));
+        write(dir + "physical_package_id", std::to_string(package));
+    }
+
+    std::string
+    root() const
+    {
+        return m_root.string();
+    }
+
+private:
+    fs::path m_root;
+};
+
+TEST(eya_thread_topology_make, reads_packages_cores_and_nodes)
+{
+    thread_topology_tree tree("eya_thread_topology_smt");
+
+    // 2 packages × 2 cores × 2 hardware threads, numbered like Linux does:
+    // CPUs 0-3 are the first threads of the cores, 4-7 their siblings.
+    tree.write("cpu/online", "0-7");
+    for (int id = 0; id < 8; ++id)
+        tree.write_cpu(id, id % 2, (id / 2) % 2);
+
+    tree.write("node/online", "0-1");
+    tree.write("node/node0/cpulist", "0-1,4-5");
+    tree.write("node/node1/cpulist", "2-3,6-7");
+
+    eya_thread_topology_t *topology = eya_thread_topology_make(tree.root().c_str(), nullptr);
+
+    EXPECT_EQ(eya_thread_topology_get_cpu_count(topology), 8u);
+    EXPECT_EQ(eya_thread_topology_get_core_count(topology), 4u);
+    EXPECT_EQ(eya_thread_topology_get_package_count(topology), 2u);
+    EXPECT_EQ(eya_thread_topology_get_node_count(topology), 2u);
+
+    // One thread of every core first, node by node, then the siblings.
+    const eya_usize_t order[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    for (eya_usize_t i = 0; i < 8; ++i)
+    {
+        const eya_thread_topology_cpu_t *cpu = eya_thread_topology_get_cpu(topology, i);
+
+        EXPECT_EQ(cpu->id, order[i]);
+        EXPECT_EQ(cpu->core, order[i] % 2);
+        EXPECT_EQ(cpu->package, (order[i] / 2) % 2);
+        EXPECT_EQ(cpu->node, cpu->package);
+    }
+
+    EXPECT_DEATH(eya_thread_topology_get_cpu(topology, 8), ".*");
+    EXPECT_DEATH(eya_thread_topology_get_cpu(nullptr, 0), ".*");
+    EXPECT_DEATH(eya_thread_topology_get_cpu_count(nullptr), ".*");
+
+    eya_thread_topology_free(topology);
+    eya_thread_topology_free(nullptr);
+}
+
+TEST(eya_thread_topology_make, spreads_adjacent_siblings_over_cores)
+{
+    thread_topology_tree tree("eya_thread_topology_adjacent");
+
+    // Siblings numbered next to each other: (0,1) share core 0, (2,3) core 1.
+    tree.write("cpu/online", "0-3");
+    for (int id = 0; id < 4; ++id)
+        tree.write_cpu(id, id / 2, 0);
+
+    eya_thread_topology_t *topology = eya_thread_topology_make(tree.root().c_str(), nullptr);
+
+    EXPECT_EQ(eya_thread_topology_get_core_count(topology), 2u);
+    EXPECT_EQ(eya_thread_topology_get_node_count(topology), 1u);
+    EXPECT_EQ(eya_thread_topology_get_cpu(topology, 0)->id, 0u);
+    EXPECT_EQ(eya_thread_topology_get_cpu(topology, 1)->id, 2u);
+    EXPECT_EQ(eya_thread_topology_get_cpu(topology, 2)->id, 1u);
+    EXPECT_EQ(eya_thread_topology_get_cpu(topology, 3)->id, 3u);
+
+    eya_thread_topology_free(topology);
+}
+
+TEST(eya_thread_topology_make, tolerates_missing_and_malformed_files)
+{
+    thread_topology_tree tree("eya_thread_topology_partial");
+
+    // The list stops at the malformed range; CPU 5 has no topology files.
+    tree.write("cpu/online", "1,5,7-3,9");
+    tree.write("cpu/cpu1/topology/core_id", "x");
+    tree.write("node/online", "0");
+
+    eya_thread_topology_t *topology = eya_thread_topology_make(tree.root().c_str(), nullptr);
+
+    ASSERT_EQ(eya_thread_topology_get_cpu_count(topology), 2u);
+    EXPECT_EQ(eya_thread_topology_get_core_count(topology), 2u);
+    EXPECT_EQ(eya_thread_topology_get_package_count(topology), 1u);
+    EXPECT_EQ(eya_thread_topology_get_node_count(topology), 1u);
+    EXPECT_EQ(eya_thread_topology_get_cpu(topology, 0)->id, 1u);
+    EXPECT_EQ(eya_thread_topology_get_cpu(topology, 0)->core, 1u);
+    EXPECT_EQ(eya_thread_topology_get_cpu(topology, 1)->id, 5u);
+
+    eya_thread_topology_free(topology);
+}
+
+TEST(eya_thread_topology_make, falls_back_without_sysfs)
+{
+    thread_topology_tree tree("eya_thread_topology_empty");
+
+    eya_thread_topology_t *topology = eya_thread_topology_make(tree.root().c_str(), nullptr);
+    const eya_usize_t      count    = eya_thread_hardware_concurrency();
+
+    EXPECT_EQ(eya_thread_topology_get_cpu_count(topology), count);
+    EXPECT_EQ(eya_thread_topology_get_core_count(topology), count);
+    EXPECT_EQ(eya_thread_topology_get_package_count(topology), 1u);
+    EXPECT_EQ(eya_thread_topology_get_node_count(topology), 1u);
+
+    eya_thread_topology_free(topology);
+
+    const std::string long_root(1000, 'a');
+    EXPECT_DEATH(eya_thread_topology_make(long_root.c_str(), nullptr), ".*");
+}
+
+TEST(eya_thread_topology_make, reads_system_topology)
+{
+    eya_thread_topology_t *topology = eya_thread_topology_make(nullptr, nullptr);
+
+    EXPECT_GE(eya_thread_topology_get_cpu_count(topology), 1u);
+    EXPECT_GE(eya_thread_topology_get_core_count(topology), 1u);
+    EXPECT_LE(eya_thread_topology_get_core_count(topology),
+              eya_thread_topology_get_cpu_count(topology));
+
+    eya_thread_topology_free(topology);
+}
+
+static void
+thread_topology_add(void *closure)
+{
+    (*static_cast<std::atomic<int> **>(closure))->fetch_add(1);
+}
+
+TEST(eya_thread_pool_make_pinned, places_workers_in_topology_order)
+{
+    eya_thread_topology_t *topology = eya_thread_topology_make(nullptr, nullptr);
+    const eya_usize_t      first    = eya_thread_topology_get_cpu(topology, 0)->id;
+
+    // More workers than CPUs wrap around the placement order.
+    const eya_usize_t  worker_count = eya_thread_topology_get_cpu_count(topology) + 1;
+    eya_thread_pool_t *pool         = eya_thread_pool_make_pinned(worker_count, topology, nullptr);
+
+    EXPECT_EQ(eya_thread_pool_get_worker_count(pool), worker_count);
+
+    const eya_usize_t cpu = eya_thread_pool_get_worker_cpu(pool, worker_count - 1);
+    EXPECT_TRUE(cpu == first || cpu == EYA_USIZE_T_MAX);
+    EXPECT_DEATH(eya_thread_pool_get_worker_cpu(pool, worker_count), ".*");
+
+    std::atomic<int>        calls{0};
+    std::atomic<int>       *ptr = &calls;
+    eya_thread_pool_group_t group;
+
+    eya_thread_pool_group_init(&group, pool);
+    for (int i = 0; i < 100; ++i)
+        eya_thread_pool_spawn(&group, thread_topology_add, &ptr, sizeof(ptr));
+    eya_thread_pool_sync(&group);
+    EXPECT_EQ(calls.load(), 100);
+
+    eya_thread_pool_free(pool);
+    eya_thread_topology_free(topology);
+
+    // Reads the system topology itself and starts one worker per CPU.
+    pool = eya_thread_pool_make_pinned(0, nullptr, nullptr);
+    EXPECT_EQ(eya_thread_pool_get_worker_count(pool), worker_count - 1);
+    eya_thread_pool_free(pool);
+
+    // Unpinned pools report no CPU.
+    pool = eya_thread_pool_make(1, nullptr);
+    EXPECT_EQ(eya_thread_pool_get_worker_cpu(pool, 0), EYA_USIZE_T_MAX);
+    eya_thread_pool_free(pool);
+}
@@ -0,0 +1,413 @@
+#include <eya/numeric_limits.h>
+#include <eya/utf8.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+static eya_memory_range_t
+utf8_range(const void *data, eya_usize_t size)
+{
+    eya_uchar_t *begin = static_cast<eya_uchar_t *>(const_cast<void *>(data));
+    return {begin, begin + size};
+}
+
+/**
+ * Validator following the table of well-formed byte sequences in the Unicode standard.
+ */
+static bool
+utf8_reference_valid(const std::string &text)
+{
+    const auto byte = [&](eya_usize_t i) { return static_cast<eya_uchar_t>(text[i]); };
+
+    for (eya_usize_t i = 0; i < text.size();)
+    {
+        const eya_uchar_t lead = byte(i);
+        eya_usize_t       length;
+        eya_uchar_t       low  = 0x80;
+        eya_uchar_t       high = 0xBF;
+
+        if (lead <= 0x7F)
+            length = 1;
+        else if (lead >= 0xC2 && lead <= 0xDF)
+            length = 2;
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            length = 3;
+            low    = lead == 0xE0 ? 0xA0 : 0x80;
+            high   = lead == 0xED ? 0x9F : 0xBF;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            length = 4;
+            low    = lead == 0xF0 ? 0x90 : 0x80;
+            high   = lead == 0xF4 ? 0x8F : 0xBF;
+        }
+        else
+            return false;
+
+        if (text.size() - i < length)
+            return false;
+        if (length > 1 && (byte(i + 1) < low || byte(i + 1) > high))
+            return false;
+        for (eya_usize_t j = 2; j < length; ++j)
+            if (byte(i + j) < 0x80 || byte(i + j) > 0xBF)
+                return false;
+
+        i += length;
+    }
+
+    return true;
+}
+
+static std::string
+utf8_reference_encode(const std::vector<eya_uint_t> &code_points)
+{
+    std::string text;
+
+    for (eya_uint_t c : code_points)
+    {
+        if (c < 0x80)
+            text += static_cast<char>(c);
+        else if (c < 0x800)
+        {
+            text += static_cast<char>(0xC0 | c >> 6);
+            text += static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000)
+        {
+            text += static_cast<char>(0xE0 | c >> 12);
+            text += static_cast<char>(0x80 | (c >> 6 & 0x3F));
+            text += static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else
+        {
+            text += static_cast<char>(0xF0 | c >> 18);
+            text += static_cast<char>(0x80 | (c >> 12 & 0x3F));
+            text += static_cast<char>(0x80 | (c >> 6 & 0x3F));
+            text += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+
+    return text;
+}
+
+static std::vector<eya_ushort_t>
+utf16_reference_encode(const std::vector<eya_uint_t> &code_points)
+{
+    std::vector<eya_ushort_t> units;
+
+    for (eya_uint_t c : code_points)
+    {
+        if (c < 0x10000)
+            units.push_back(static_cast<eya_ushort_t>(c));
+        else
+        {
+            units.push_back(static_cast<eya_ushort_t>(0xD800 | (c - 0x10000) >> 10));
+            units.push_back(static_cast<eya_ushort_t>(0xDC00 | (c & 0x3FF)));
+        }
+    }
+
+    return units;
+}
+
+/**
+ * Random text alternating runs of ASCII, long enough for the vector paths,
+ * with characters of every length.
+ */
+static std::vector<eya_uint_t>
+utf8_random_code_points(std::mt19937 &random, eya_usize_t count)
+{
+    std::vector<eya_uint_t> code_points;
+
+    while (code_points.size() < count)
+    {
+        if (random() % 2)
+        {
+            for (eya_usize_t run = random() % 80; run; --run)
+                code_points.push_back(random() % 0x80);
+            continue;
+        }
+
+        eya_uint_t c;
+        switch (random() % 4)
+        {
+            case 0:
+                c = random() % 0x80;
+                break;
+            case 1:
+                c = 0x80 + random() % (0x800 - 0x80);
+                break;
+            case 2:
+                do
+                    c = 0x800 + random() % (0x10000 - 0x800);
+                while (c >= 0xD800 && c <= 0xDFFF);
+                break;
+            default:
+                c = 0x10000 + random() % (0x110000 - 0x10000);
+                break;
+        }
+        code_points.push_back(c);
+    }
+
+    return code_points;
+}
+
+// Runs every test with the scalar loops and with the vector code where the CPU has it.
+class utf8_test : public ::testing::TestWithParam<eya_uint_t>
+{
+protected:
+    void
+    SetUp() override
+    {
+        eya_utf8_set_cpu_features(GetParam());
+    }
+
+    void
+    TearDown() override
+    {
+        eya_utf8_set_cpu_features(EYA_UINT_T_MAX);
+    }
+};
+
+TEST_P(utf8_test, is_valid_matches_boundary_cases_at_every_position)
+{
+    const char *valid[] = {"\x7F", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF",
+                           "\xEE\x80\x80", "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF"};
+    const char *invalid[] = {"\x80",         "\xBF",         "\xC0\x80",         "\xC1\xBF",
+                             "\xC2",         "\xC2\x7F",     "\xC2\xC0",         "\xE0\x9F\xBF",
+                             "\xED\xA0\x80", "\xED\xBF\xBF", "\xE1\x80",         "\xE1\x80\xC0",
+                             "\xF1\x80\x80", "\xFF",         "\xC2\x80\x80",     "\xE1\x80\x80\x80",
+                             "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80"};
+
+    for (bool expected : {true, false})
+        for (const char *sequence : expected ? std::vector<const char *>(valid, valid + 9)
+                                             : std::vector<const char *>(invalid, invalid + 19))
+            for (eya_usize_t position = 0; position < 70; ++position)
+            {
+                std::string text(position, 'a');
+                text += sequence;
+                text += std::string(position % 3 ? 100 - position : 0, 'b');
+
+                const eya_memory_range_t range = utf8_range(text.data(), text.size());
+                ASSERT_EQ(eya_utf8_is_valid(&range), expected) << position;
+                ASSERT_EQ(utf8_reference_valid(text), expected) << position;
+            }
+}
+
+TEST_P(utf8_test, is_valid_matches_the_reference_on_mutated_text)
+{
+    std::mt19937 random(99);
+
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::string text = utf8_reference_encode(utf8_random_code_points(random, random() % 200));
+        const eya_memory_range_t original = utf8_range(text.data(), text.size());
+
+        ASSERT_TRUE(eya_utf8_is_valid(&original));
+
+        for (eya_usize_t changes = random() % 3; changes && !text.empty(); --changes)
+            text[random() % text.size()] = static_cast<char>(random());
+        if (random() % 4 == 0 && !text.empty())
+            text.resize(random() % text.size());
+
+        const eya_memory_range_t range = utf8_range(text.data(), text.size());
+        ASSERT_EQ(eya_utf8_is_valid(&range), utf8_reference_valid(text)) << round;
+    }
+}
+
+TEST_P(utf8_test, is_ascii_finds_a_high_bit_anywhere)
+{
+    std::string              text(300, 'x');
+    const eya_memory_range_t range = utf8_range(text.data(), text.size());
+
+    EXPECT_TRUE(eya_utf8_is_ascii(&range));
+    for (eya_usize_t position = 0; position < text.size(); ++position)
+    {
+        text[position] = '\x80';
+        ASSERT_FALSE(eya_utf8_is_ascii(&range)) << position;
+        text[position] = 'x';
+    }
+
+    const eya_memory_range_t empty = utf8_range(text.data(), 0);
+    EXPECT_TRUE(eya_utf8_is_ascii(&empty));
+    EXPECT_TRUE(eya_utf8_is_valid(&empty));
+}
+
+TEST_P(utf8_test, to_utf16_round_trips_random_text)
+{
+    std::mt19937 random(7);
+
+    for (int round = 0; round < 300; ++round)
+    {
+        const std::vector<eya_uint_t>   code_points = utf8_random_code_points(random, round * 3);
+        const std::string               text        = utf8_reference_encode(code_points);
+        const std::vector<eya_ushort_t> expected    = utf16_reference_encode(code_points);
+        const eya_memory_range_t        src         = utf8_range(text.data(), text.size());
+
+        ASSERT_EQ(eya_utf8_utf16_size(&src), expected.size());
+
+        std::vector<eya_ushort_t> units(expected.size() + 1, 0xA5A5);
+        const eya_memory_range_t  dst = utf8_range(units.data(), units.size() * 2);
+
+        ASSERT_EQ(eya_utf8_to_utf16(&dst, &src), expected.size());
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), units.begin())) << round;
+        ASSERT_EQ(units.back(), 0xA5A5);
+
+        const eya_memory_range_t back_src = utf8_range(units.data(), expected.size() * 2);
+        std::string              back(text.size() + 1, '#');
+        const eya_memory_range_t back_dst = utf8_range(&back[0], back.size());
+
+        ASSERT_EQ(eya_utf16_utf8_size(&back_src), text.size());
+        ASSERT_EQ(eya_utf16_to_utf8(&back_dst, &back_src), text.size());
+        ASSERT_EQ(back, text + '#') << round;
+    }
+}
+
+TEST_P(utf8_test, to_utf32_round_trips_random_text)
+{
+    std::mt19937 random(8);
+
+    for (int round = 0; round < 300; ++round)
+    {
+        const std::vector<eya_uint_t> code_points = utf8_random_code_points(random, round * 3);
+        const std::string             text        = utf8_reference_encode(code_points);
+        const eya_memory_range_t      src         = utf8_range(text.data(), text.size());
+
+        ASSERT_EQ(eya_utf8_utf32_size(&src), code_points.size());
+
+        std::vector<eya_uint_t>  units(code_points.size() + 1, 0xA5A5A5A5);
+        const eya_memory_range_t dst = utf8_range(units.data(), units.size() * 4);
+
+        ASSERT_EQ(eya_utf8_to_utf32(&dst, &src), code_points.size());
+        ASSERT_TRUE(std::equal(code_points.begin(), code_points.end(), units.begin())) << round;
+        ASSERT_EQ(units.back(), 0xA5A5A5A5);
+
+        const eya_memory_range_t back_src = utf8_range(units.data(), code_points.size() * 4);
+        std::string              back(text.size() + 1, '#');
+        const eya_memory_range_t back_dst = utf8_range(&back[0], back.size());
+
+        ASSERT_EQ(eya_utf32_utf8_size(&back_src), text.size());
+        ASSERT_EQ(eya_utf32_to_utf8(&back_dst, &back_src), text.size());
+        ASSERT_EQ(back, text + '#') << round;
+    }
+}
+
+TEST_P(utf8_test, to_utf16_converts_text_without_ascii)
+{
+    std::mt19937 random(9);
+
+    // Code points of two, three and four bytes.
+    const eya_uint_t bounds[] = {0x80, 0x800, 0x10000, 0x110000};
+
+    for (eya_usize_t length = 0; length < 3; ++length)
+    {
+        const eya_uint_t        low  = bounds[length];
+        const eya_uint_t        high = bounds[length + 1];
+        std::vector<eya_uint_t> code_points;
+
+        while (code_points.size() < 200)
+        {
+            const eya_uint_t c = low + random() % (high - low);
+            if (c < 0xD800 || c > 0xDFFF)
+                code_points.push_back(c);
+        }
+
+        const std::string               text     = utf8_reference_encode(code_points);
+        const std::vector<eya_ushort_t> expected = utf16_reference_encode(code_points);
+        const eya_memory_range_t        src      = utf8_range(text.data(), text.size());
+
+        std::vector<eya_ushort_t> units(expected.size());
+        const eya_memory_range_t  dst16 = utf8_range(units.data(), units.size() * 2);
+        ASSERT_EQ(eya_utf8_to_utf16(&dst16, &src), expected.size());
+        EXPECT_EQ(units, expected) << low;
+
+        std::vector<eya_uint_t>  scalars(code_points.size());
+        const eya_memory_range_t dst32 = utf8_range(scalars.data(), scalars.size() * 4);
+        ASSERT_EQ(eya_utf8_to_utf32(&dst32, &src), code_points.size());
+        EXPECT_EQ(scalars, code_points) << low;
+
+        std::string              back(text.size(), '#');
+        const eya_memory_range_t back_dst = utf8_range(&back[0], back.size());
+        ASSERT_EQ(eya_utf16_to_utf8(&back_dst, &dst16), text.size());
+        EXPECT_EQ(back, text) << low;
+        ASSERT_EQ(eya_utf32_to_utf8(&back_dst, &dst32), text.size());
+        EXPECT_EQ(back, text) << low;
+    }
+}
+
+TEST_P(utf8_test, to_utf16_rejects_invalid_text_and_small_destinations)
+{
+    std::string              text = std::string(40, 'a') + "\xF0\x9F\x98\x80";
+    std::vector<eya_ushort_t> units(64);
+    const eya_memory_range_t src   = utf8_range(text.data(), text.size());
+    const eya_memory_range_t exact = utf8_range(units.data(), 42 * 2);
+    const eya_memory_range_t small = utf8_range(units.data(), 41 * 2);
+    const eya_memory_range_t odd   = utf8_range(reinterpret_cast<char *>(units.data()) + 1, 64);
+
+    EXPECT_EQ(eya_utf8_to_utf16(&exact, &src), 42u);
+    EXPECT_DEATH(eya_utf8_to_utf16(&small, &src), ".*");
+    EXPECT_DEATH(eya_utf8_to_utf16(&odd, &src), ".*");
+
+    std::vector<eya_uint_t>  code_points(64);
+    const eya_memory_range_t short32 = utf8_range(code_points.data(), 40 * 4);
+    EXPECT_DEATH(eya_utf8_to_utf32(&short32, &src), ".*");
+
+    text[41] = 'a';
+    EXPECT_DEATH(eya_utf8_to_utf16(&exact, &src), ".*");
+}
+
+TEST_P(utf8_test, from_utf16_rejects_unpaired_surrogates)
+{
+    std::string              text(200, '#');
+    const eya_memory_range_t dst = utf8_range(&text[0], text.size());
+
+    const std::vector<std::vector<eya_ushort_t>> invalid = {
+        {0xD800}, {0xDC00}, {0xDBFF, 0x0041}, {0x0041, 0xDFFF, 0xD800}, {0xD800, 0xD800}};
+
+    for (const std::vector<eya_ushort_t> &units : invalid)
+    {
+        std::vector<eya_ushort_t> padded(33, 'a');
+        padded.insert(padded.end(), units.begin(), units.end());
+
+        const eya_memory_range_t src = utf8_range(padded.data(), padded.size() * 2);
+        EXPECT_DEATH(eya_utf16_to_utf8(&dst, &src), ".*");
+    }
+
+    const eya_ushort_t       pair[] = {0xD83D, 0xDE00};
+    const eya_memory_range_t src    = utf8_range(pair, 4);
+    const eya_memory_range_t small  = utf8_range(&text[0], 3);
+    EXPECT_DEATH(eya_utf16_to_utf8(&small, &src), ".*");
+    EXPECT_EQ(eya_utf16_to_utf8(&dst, &src), 4u);
+    EXPECT_EQ(text.substr(0, 4), "\xF0\x9F\x98\x80");
+
+    const eya_memory_range_t odd = utf8_range(pair, 3);
+    EXPECT_DEATH(eya_utf16_utf8_size(&odd), ".*");
+}
+
+TEST_P(utf8_test, from_utf32_rejects_values_that_are_not_scalar_values)
+{
+    std::string              text(200, '#');
+    const eya_memory_range_t dst = utf8_range(&text[0], text.size());
+
+    for (eya_uint_t value : {0xD800u, 0xDFFFu, 0x110000u, 0x80000000u, 0xFFFFFFFFu})
+        for (eya_usize_t position : {0u, 5u, 31u, 32u, 40u})
+        {
+            std::vector<eya_uint_t> units(41, 'a');
+            units[position] = value;
+
+            const eya_memory_range_t src = utf8_range(units.data(), units.size() * 4);
+            EXPECT_DEATH(eya_utf32_to_utf8(&dst, &src), ".*") << value << " " << position;
+        }
+
+    const eya_uint_t         units[] = {0x10FFFF, 0xE9};
+    const eya_memory_range_t src     = utf8_range(units, 8);
+    EXPECT_EQ(eya_utf32_to_utf8(&dst, &src), 6u);
+    EXPECT_EQ(text.substr(0, 6), "\xF4\x8F\xBF\xBF\xC3\xA9");
+
+    const eya_memory_range_t odd = utf8_range(units, 6);
+    EXPECT_DEATH(eya_utf32_utf8_size(&odd), ".*");
+}
+
+INSTANTIATE_TEST_SUITE_P(eya_utf8, utf8_test, ::testing::Values(0u, EYA_UINT_T_MAX));